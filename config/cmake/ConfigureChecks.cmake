@@ -437,9 +437,13 @@ CHECK_FUNCTION_EXISTS (fork              ${HDF_PREFIX}_HAVE_FORK)
 
 CHECK_FUNCTION_EXISTS (gethostname       ${HDF_PREFIX}_HAVE_GETHOSTNAME)
 CHECK_FUNCTION_EXISTS (getrusage         ${HDF_PREFIX}_HAVE_GETRUSAGE)
+CHECK_FUNCTION_EXISTS (madvise           ${HDF_PREFIX}_HAVE_MADVISE)
+CHECK_FUNCTION_EXISTS (mmap              ${HDF_PREFIX}_HAVE_MMAP)
 
 CHECK_FUNCTION_EXISTS (pread             ${HDF_PREFIX}_HAVE_PREAD)
+CHECK_FUNCTION_EXISTS (preadv            ${HDF_PREFIX}_HAVE_PREADV)
 CHECK_FUNCTION_EXISTS (pwrite            ${HDF_PREFIX}_HAVE_PWRITE)
+CHECK_FUNCTION_EXISTS (pwritev           ${HDF_PREFIX}_HAVE_PWRITEV)
 CHECK_FUNCTION_EXISTS (rand_r            ${HDF_PREFIX}_HAVE_RAND_R)
 CHECK_FUNCTION_EXISTS (random            ${HDF_PREFIX}_HAVE_RANDOM)
 CHECK_FUNCTION_EXISTS (setsysinfo        ${HDF_PREFIX}_HAVE_SETSYSINFO)
@@ -720,6 +724,20 @@ option (HDF5_ENABLE_ROS3_VFD "Build the ROS3 Virtual File Driver" OFF)
     endif ()
 endif ()
 
+# ----------------------------------------------------------------------
+# Check whether we can build the io_uring VFD
+# ----------------------------------------------------------------------
+option (HDF5_ENABLE_IOURING_VFD "Build the Linux io_uring Virtual File Driver" OFF)
+if (HDF5_ENABLE_IOURING_VFD)
+  CHECK_INCLUDE_FILE_CONCAT ("linux/io_uring.h" ${HDF_PREFIX}_HAVE_LINUX_IO_URING_H)
+  CHECK_SYMBOL_EXISTS (__NR_io_uring_setup "sys/syscall.h" ${HDF_PREFIX}_HAVE_IO_URING_SYSCALLS)
+  if (${HDF_PREFIX}_HAVE_LINUX_IO_URING_H AND ${HDF_PREFIX}_HAVE_IO_URING_SYSCALLS)
+      set (${HDF_PREFIX}_HAVE_IOURING_VFD 1)
+  else()
+    message(WARNING "The io_uring VFD was requested but cannot be built. System prerequisites are not met.")
+  endif()
+endif()
+
 # ----------------------------------------------------------------------
 # Check whether we can build the Mirror VFD
 # ----------------------------------------------------------------------
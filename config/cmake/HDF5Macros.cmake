@@ -81,6 +81,9 @@ macro (H5_SET_VFD_LIST)
     # MPI I/O VFD is currently incompatible with too many tests in the VFD test set
     # list (APPEND VFD_LIST mpio)
   endif ()
+  if (H5_HAVE_IOURING_VFD)
+    list (APPEND VFD_LIST iouring)
+  endif ()
   if (H5_HAVE_MIRROR_VFD)
     list (APPEND VFD_LIST mirror)
   endif ()
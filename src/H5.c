@@ -31,6 +31,7 @@
 #include "H5PLprivate.h" /* Plugins                                  */
 #include "H5SLprivate.h" /* Skip lists                               */
 #include "H5Tprivate.h"  /* Datatypes                                */
+#include "H5Zprivate.h"  /* Data filters                             */
 
 #include "H5FDsec2.h" /* for H5FD_sec2_init() */
 
@@ -573,6 +574,8 @@ H5garbage_collect(void)
     /* Call the garbage collection routines in the library */
     if (H5FL_garbage_coll() < 0)
         HGOTO_ERROR(H5E_RESOURCE, H5E_CANTGC, FAIL, "can't garbage collect objects")
+    if (H5Z_buf_garbage_coll() < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTGC, FAIL, "can't garbage collect filter buffers")
 
 done:
     FUNC_LEAVE_API(ret_value)
@@ -252,6 +252,10 @@ typedef struct H5CX_t {
     hbool_t                 selection_io_mode_valid; /* Whether selection I/O mode is valid */
     hbool_t                 modify_write_buf;        /* Whether the library can modify write buffers */
     hbool_t                 modify_write_buf_valid;  /* Whether the modify_write_buf field is valid */
+    unsigned                filter_nthreads;         /* # of filter threads (H5D_XFER_FILTER_NTHREADS_NAME) */
+    hbool_t                 filter_nthreads_valid;   /* Whether the filter_nthreads field is valid */
+    size_t                  vector_read_gap;         /* Max. read gap (H5D_XFER_VECTOR_READ_GAP_NAME) */
+    hbool_t                 vector_read_gap_valid;   /* Whether the vector_read_gap field is valid */
 
     /* Return-only DXPL properties to return to application */
 #ifdef H5_HAVE_PARALLEL
@@ -387,6 +391,8 @@ typedef struct H5CX_dxpl_cache_t {
     uint32_t                no_selection_io_cause; /* Reasons for not performing selection I/O
                                                             (H5D_XFER_NO_SELECTION_IO_CAUSE_NAME) */
     hbool_t modify_write_buf;                      /* Whether the library can modify write buffers */
+    unsigned filter_nthreads;                      /* # of filter threads (H5D_XFER_FILTER_NTHREADS_NAME) */
+    size_t   vector_read_gap;                      /* Max. read gap (H5D_XFER_VECTOR_READ_GAP_NAME) */
 } H5CX_dxpl_cache_t;
 
 /* Typedef for cached default link creation property list information */
@@ -587,6 +593,14 @@ H5CX_init(void)
     if (H5P_get(dx_plist, H5D_XFER_MODIFY_WRITE_BUF_NAME, &H5CX_def_dxpl_cache.modify_write_buf) < 0)
         HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve modify write buffer property")
 
+    /* Get the number of threads for filtering chunks */
+    if (H5P_get(dx_plist, H5D_XFER_FILTER_NTHREADS_NAME, &H5CX_def_dxpl_cache.filter_nthreads) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve number of filter threads")
+
+    /* Get the maximum gap for merging vector reads */
+    if (H5P_get(dx_plist, H5D_XFER_VECTOR_READ_GAP_NAME, &H5CX_def_dxpl_cache.vector_read_gap) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve vector read gap")
+
     /* Reset the "default LCPL cache" information */
     HDmemset(&H5CX_def_lcpl_cache, 0, sizeof(H5CX_lcpl_cache_t));
 
@@ -2499,8 +2513,9 @@ done:
 herr_t
 H5CX_get_vlen_alloc_info(H5T_vlen_alloc_info_t *vl_alloc_info)
 {
-    H5CX_node_t **head      = NULL;    /* Pointer to head of API context list */
-    herr_t        ret_value = SUCCEED; /* Return value */
+    H5CX_node_t     **head      = NULL;    /* Pointer to head of API context list */
+    H5T_vlen_arena_t *arena     = NULL;    /* Arena for VL data */
+    herr_t            ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_NOAPI(FAIL)
 
@@ -2536,6 +2551,16 @@ H5CX_get_vlen_alloc_info(H5T_vlen_alloc_info_t *vl_alloc_info)
             if (H5P_get((*head)->ctx.dxpl, H5D_XFER_VLEN_FREE_INFO_NAME,
                         &(*head)->ctx.vl_alloc_info.free_info) < 0)
                 HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve VL datatype alloc info")
+
+            /* An arena for the VL data takes precedence over the memory manager */
+            if (H5P_peek((*head)->ctx.dxpl, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+                HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve VL data arena")
+            if (arena) {
+                (*head)->ctx.vl_alloc_info.alloc_func = H5T_vlen_arena_alloc;
+                (*head)->ctx.vl_alloc_info.alloc_info = arena;
+                (*head)->ctx.vl_alloc_info.free_func  = H5T_vlen_arena_free;
+                (*head)->ctx.vl_alloc_info.free_info  = arena;
+            } /* end if */
         } /* end else */
 
         /* Mark the value as valid */
@@ -2689,6 +2714,75 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5CX_get_selection_io_mode() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_filter_nthreads
+ *
+ * Purpose:     Retrieves the number of threads to use for running the
+ *              filter pipeline on chunks for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_filter_nthreads(unsigned *filter_nthreads)
+{
+    H5CX_node_t **head      = NULL;    /* Pointer to head of API context list */
+    herr_t        ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(filter_nthreads);
+    head = H5CX_get_my_context(); /* Get the pointer to the head of the API context, for this thread */
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_FILTER_NTHREADS_NAME,
+                             filter_nthreads)
+
+    /* Get the value */
+    *filter_nthreads = (*head)->ctx.filter_nthreads;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_filter_nthreads() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_vector_read_gap
+ *
+ * Purpose:     Retrieves the largest gap that may be read through when
+ *              merging the pieces of a vector read for the current API call
+ *              context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_vector_read_gap(size_t *vector_read_gap)
+{
+    H5CX_node_t **head      = NULL;    /* Pointer to head of API context list */
+    herr_t        ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(vector_read_gap);
+    head = H5CX_get_my_context(); /* Get the pointer to the head of the API context, for this thread */
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_VECTOR_READ_GAP_NAME,
+                             vector_read_gap)
+
+    /* Get the value */
+    *vector_read_gap = (*head)->ctx.vector_read_gap;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_vector_read_gap() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5CX_get_encoding
  *
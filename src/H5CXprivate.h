@@ -118,6 +118,8 @@ H5_DLL herr_t H5CX_get_dt_conv_cb(H5T_conv_cb_t *cb_struct);
 H5_DLL herr_t H5CX_get_selection_io_mode(H5D_selection_io_mode_t *selection_io_mode);
 H5_DLL herr_t H5CX_get_no_selection_io_cause(uint32_t *no_selection_io_cause);
 H5_DLL herr_t H5CX_get_modify_write_buf(hbool_t *modify_write_buf);
+H5_DLL herr_t H5CX_get_filter_nthreads(unsigned *filter_nthreads);
+H5_DLL herr_t H5CX_get_vector_read_gap(size_t *vector_read_gap);
 
 /* "Getter" routines for LCPL properties cached in API context */
 H5_DLL herr_t H5CX_get_encoding(H5T_cset_t *encoding);
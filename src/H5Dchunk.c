@@ -56,6 +56,7 @@
 #include "H5MMprivate.h" /* Memory management            */
 #include "H5MFprivate.h" /* File memory management               */
 #include "H5PBprivate.h" /* Page Buffer	                         */
+#include "H5TSprivate.h" /* Threadsafety                         */
 #include "H5VMprivate.h" /* Vector and array functions        */
 
 /****************/
@@ -113,6 +114,39 @@
 
 /*#define H5D_CHUNK_DEBUG */
 
+/* Number of chunks per filter thread to read and filter ahead of the chunk
+ * read loop at a time.  This bounds the amount of memory held by filtered
+ * chunks that have not been scattered into the application buffer yet. */
+#define H5D_CHUNK_FILTER_BATCH_FACTOR 2
+
+/* Number of chunks to read and filter ahead of the chunk read loop at a time
+ * when the filter pipeline is run on a single thread, but the application has
+ * set a vector read gap so that neighboring chunks can be read together */
+#define H5D_CHUNK_READ_BATCH_JOBS 16
+
+/* Smallest number of chunks an I/O operation must select, and the fraction
+ * (1/N) of the dataset's chunks they must make up, for their addresses to be
+ * found in one pass over a B-tree chunk index rather than one at a time */
+#define H5D_CHUNK_LOOKUP_BATCH_MIN   16
+#define H5D_CHUNK_LOOKUP_BATCH_RATIO 8
+
+/* Size of the blocks of the arena that VL data written to a dataset storing
+ * it inline in its chunks is copied to, until the chunks gather it */
+#define H5D_CHUNK_VLEN_ARENA_BLOCK_SIZE (64 * 1024)
+
+/* Largest number of chunks a hyperslab I/O can select for its chunk
+ * selections to be kept, to be reused by the next I/O on the dataset */
+#define H5D_CHUNK_SEL_PLAN_MAX_PIECES 1024
+
+/* Number of slots in each set of the chunk cache's hash table.  A chunk can
+ * be cached in any slot of the set it hashes to, so chunks only evict each
+ * other through the hash table once all the slots of their set are in use. */
+#define H5D_CHUNK_CACHE_NWAYS 8
+
+/* Largest number of slots the chunk cache's hash table is sized to on its
+ * own, to hold twice as many chunks as fit in the cache's byte limit */
+#define H5D_CHUNK_CACHE_MAX_AUTO_SLOTS (1024 * 1024)
+
 /* Flags for the "edge_chunk_state" field below */
 #define H5D_RDCC_DISABLE_FILTERS 0x01U /* Disable filters on this chunk */
 #define H5D_RDCC_NEWLY_DISABLED_FILTERS                                                                      \
@@ -128,6 +162,7 @@ typedef struct H5D_rdcc_ent_t {
     hbool_t                locked;                   /*entry is locked in cache        */
     hbool_t                dirty;                    /*needs to be written to disk?        */
     hbool_t                deleted;                  /*chunk about to be deleted        */
+    hbool_t                prefetched;               /*chunk was read ahead and not accessed yet */
     unsigned               edge_chunk_state;         /*states related to edge chunks (see above) */
     hsize_t                scaled[H5O_LAYOUT_NDIMS]; /*scaled chunk 'name' (coordinates) */
     uint32_t               rd_count;                 /*bytes remaining to be read        */
@@ -135,11 +170,16 @@ typedef struct H5D_rdcc_ent_t {
     H5F_block_t            chunk_block;              /*offset/length of chunk in file        */
     hsize_t                chunk_idx;                /*index of chunk in dataset             */
     uint8_t               *chunk;                    /*the unfiltered chunk data        */
+    size_t                 buf_size;                 /*size of the chunk data, charged to the cache */
     unsigned               idx;                      /*index in hash table            */
+    uint64_t               last_use;                 /*cache's use clock when last accessed */
     struct H5D_rdcc_ent_t *next;                     /*next item in doubly-linked list    */
     struct H5D_rdcc_ent_t *prev;                     /*previous item in doubly-linked list    */
     struct H5D_rdcc_ent_t *tmp_next;                 /*next item in temporary doubly-linked list */
     struct H5D_rdcc_ent_t *tmp_prev;                 /*previous item in temporary doubly-linked list */
+    H5D_shared_t          *shared;                   /*dataset the chunk belongs to        */
+    struct H5D_rdcc_ent_t *file_next;                /*next item in the file's doubly-linked list */
+    struct H5D_rdcc_ent_t *file_prev;                /*previous item in the file's doubly-linked list */
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
@@ -218,6 +258,13 @@ typedef struct H5D_chunk_it_ud5_t {
     hsize_t            *dset_dims;    /* Dataset dimensions */
 } H5D_chunk_it_ud5_t;
 
+/* Callback info for iteration to look up the chunks selected for I/O */
+typedef struct H5D_chunk_it_ud6_t {
+    const H5O_layout_chunk_t *layout;     /* Chunk layout description */
+    H5SL_t                   *sel_pieces; /* Skip list of the chunks selected */
+    size_t                    nleft;      /* Number of selected chunks not found yet */
+} H5D_chunk_it_ud6_t;
+
 /* Callback info for nonexistent readvv operation */
 typedef struct H5D_chunk_readvv_ud_t {
     unsigned char *rbuf; /* Read buffer to initialize */
@@ -255,6 +302,47 @@ typedef struct H5D_chunk_iter_ud_t {
     H5O_layout_chunk_t *chunk;   /* Chunk layout */
 } H5D_chunk_iter_ud_t;
 
+/* Information for running the filter pipeline on one chunk */
+typedef struct H5D_chunk_filter_job_t {
+    H5D_piece_info_t *piece_info; /* Chunk selected for I/O */
+    H5D_chunk_ud_t    udata;      /* Chunk index info, valid until the chunk is operated on */
+    void             *buf;        /* Chunk buffer, or NULL if the chunk is not filtered ahead */
+    size_t            nbytes;     /* Number of valid bytes in buffer */
+    size_t            buf_alloc;  /* Allocated size of buffer */
+    herr_t            status;     /* Result of running the filter pipeline */
+    hbool_t           retry;      /* Whether the pipeline failed on a worker thread, without the
+                                   * application's filter callback, and must be run again */
+} H5D_chunk_filter_job_t;
+
+/* Shared information for running the filter pipeline on a set of chunks */
+typedef struct H5D_chunk_filter_work_t {
+    const H5O_pline_t      *pline;      /* I/O pipeline info */
+    unsigned                flags;      /* Pipeline invocation flags */
+    H5Z_EDC_t               err_detect; /* Error detection info */
+    H5Z_cb_t                filter_cb;  /* I/O filter callback function */
+    H5D_chunk_filter_job_t *jobs;       /* Array of jobs */
+    size_t                  njobs;      /* Number of jobs */
+    size_t                  nthreads;   /* Number of threads sharing the jobs */
+} H5D_chunk_filter_work_t;
+
+/* Per-thread information for running the filter pipeline on a set of chunks */
+typedef struct H5D_chunk_filter_thread_t {
+    H5D_chunk_filter_work_t *work;      /* Shared information */
+    size_t                   first;     /* Index of first job for this thread */
+    H5Z_cb_t                 filter_cb; /* I/O filter callback function for this thread */
+    H5E_t                   *estack;    /* Errors raised on a worker thread */
+} H5D_chunk_filter_thread_t;
+
+/* Chunks read and filtered ahead of the chunk read loop */
+typedef struct H5D_chunk_filter_batch_t {
+    unsigned                nthreads; /* Number of threads to filter with (0 to disable batching) */
+    H5D_chunk_filter_job_t *jobs;     /* Jobs for chunks in the batch */
+    size_t                  njobs;    /* Number of jobs in the batch */
+    size_t                  max_jobs; /* Allocated number of jobs */
+    size_t                  next;     /* Next job to hand to the read loop */
+    H5SL_node_t            *end;      /* First chunk node after the batch */
+} H5D_chunk_filter_batch_t;
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -264,6 +352,10 @@ static herr_t H5D__chunk_construct(H5F_t *f, H5D_t *dset);
 static herr_t H5D__chunk_init(H5F_t *f, const H5D_t *dset, hid_t dapl_id);
 static herr_t H5D__chunk_io_init(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo);
 static herr_t H5D__chunk_io_init_selections(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo);
+static herr_t H5D__chunk_lookup_batch(const H5D_io_info_t *io_info, const H5D_dset_io_info_t *dinfo);
+static int    H5D__chunk_lookup_batch_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_lookup_piece(const H5D_t *dset, const H5D_piece_info_t *piece_info,
+                                      H5D_chunk_ud_t *udata);
 static herr_t H5D__chunk_mdio_init(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo);
 static herr_t H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo);
 static herr_t H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo);
@@ -297,19 +389,42 @@ static herr_t   H5D__create_piece_file_map_all(H5D_dset_io_info_t *di, H5D_io_in
 static herr_t   H5D__create_piece_file_map_hyper(H5D_dset_io_info_t *di, H5D_io_info_t *io_info);
 static herr_t   H5D__create_piece_mem_map_1d(const H5D_dset_io_info_t *di);
 static herr_t   H5D__create_piece_mem_map_hyper(const H5D_dset_io_info_t *di);
+static htri_t   H5D__chunk_sel_plan_apply(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo);
+static herr_t   H5D__chunk_sel_plan_build(H5D_dset_io_info_t *dinfo);
 static herr_t   H5D__piece_file_cb(void *elem, const H5T_t *type, unsigned ndims, const hsize_t *coords,
                                    void *_opdata);
 static herr_t   H5D__piece_mem_cb(void *elem, const H5T_t *type, unsigned ndims, const hsize_t *coords,
                                   void *_opdata);
 static herr_t   H5D__chunk_may_use_select_io(H5D_io_info_t *io_info, const H5D_dset_io_info_t *dset_info);
+static void     H5D__chunk_filter_jobs_retry(const H5O_pline_t *pline, H5D_chunk_filter_job_t *jobs,
+                                             size_t njobs);
+static herr_t   H5D__chunk_filter_jobs(const H5O_pline_t *pline, unsigned flags, H5D_chunk_filter_job_t *jobs,
+                                       size_t njobs, unsigned nthreads);
+static herr_t   H5D__chunk_filter_jobs_read(const H5D_t *dset, H5D_chunk_filter_job_t *jobs, size_t njobs);
+static herr_t   H5D__chunk_filter_batch_init(const H5D_dset_io_info_t *dset_info,
+                                             H5D_chunk_filter_batch_t *batch);
+static herr_t   H5D__chunk_filter_batch_fill(const H5D_dset_io_info_t *dset_info,
+                                             H5D_chunk_filter_batch_t *batch, H5SL_node_t *chunk_node);
+static herr_t   H5D__chunk_filter_batch_reset(const H5D_t *dset, H5D_chunk_filter_batch_t *batch);
+static herr_t   H5D__chunk_prefetch(const H5D_io_info_t *io_info, const H5D_dset_io_info_t *dset_info);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
-static herr_t   H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset);
+static unsigned H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *scaled);
+static unsigned H5D__chunk_cache_hint(const H5D_shared_t *shared, const hsize_t *scaled, unsigned idx_hint);
+static herr_t   H5D__chunk_cache_slot(const H5D_t *dset, const hsize_t *scaled, unsigned *idx);
+static herr_t   H5D__chunk_cache_grow(const H5D_t *dset);
+static herr_t   H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset,
+                                       H5D_chunk_filter_job_t *job);
+static herr_t   H5D__chunk_flush_entries(const H5D_t *dset, H5D_rdcc_ent_t **ents, size_t nents,
+                                         hbool_t evict, unsigned nthreads);
 static herr_t   H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush);
 static void    *H5D__chunk_lock(const H5D_io_info_t *io_info, const H5D_dset_io_info_t *dset_info,
-                                H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk);
+                                H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk,
+                                void *loaded_chunk, size_t loaded_nbytes);
 static herr_t   H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_dset_io_info_t *dset_info,
                                   const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk, uint32_t naccessed);
 static herr_t   H5D__chunk_cache_prune(const H5D_t *dset, size_t size);
+static herr_t   H5D__chunk_file_cache_prune(const H5D_t *dset, size_t size);
+static herr_t   H5D__chunk_file_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent);
 static herr_t   H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset, H5D_chunk_coll_fill_info_t *chunk_fill_info,
@@ -355,12 +470,21 @@ H5FL_SEQ_DEFINE_STATIC(H5D_rdcc_ent_ptr_t);
 /* Declare a free list to manage H5D_rdcc_ent_t objects */
 H5FL_DEFINE_STATIC(H5D_rdcc_ent_t);
 
+/* Declare a free list to manage H5D_rdcc_file_t objects */
+H5FL_DEFINE_STATIC(H5D_rdcc_file_t);
+
 /* Declare a free list to manage the H5D_chunk_info_t struct */
 H5FL_DEFINE_STATIC(H5D_chunk_map_t);
 
 /* Declare a free list to manage the H5D_piece_info_t struct */
 H5FL_DEFINE(H5D_piece_info_t);
 
+/* Declare a free list to manage H5D_sel_plan_t objects */
+H5FL_DEFINE_STATIC(H5D_sel_plan_t);
+
+/* Declare a free list to manage the H5D_sel_plan_piece_t sequence information */
+H5FL_SEQ_DEFINE_STATIC(H5D_sel_plan_piece_t);
+
 /* Declare a free list to manage the chunk sequence information */
 H5FL_BLK_DEFINE_STATIC(chunk);
 
@@ -534,7 +658,7 @@ H5D__chunk_direct_read(const H5D_t *dset, hsize_t *offset, uint32_t *filters, vo
         hbool_t         flush;
 
         /* Sanity checks  */
-        HDassert(udata.idx_hint < rdcc->nslots);
+        HDassert(udata.idx_hint < rdcc->nsets * H5D_CHUNK_CACHE_NWAYS);
         HDassert(rdcc->slot[udata.idx_hint]);
 
         flush = (ent->dirty == TRUE) ? TRUE : FALSE;
@@ -630,7 +754,7 @@ H5D__get_chunk_storage_size(H5D_t *dset, const hsize_t *offset, hsize_t *storage
             H5D_rdcc_ent_t *ent = rdcc->slot[udata.idx_hint];
 
             /* Sanity checks  */
-            HDassert(udata.idx_hint < rdcc->nslots);
+            HDassert(udata.idx_hint < rdcc->nsets * H5D_CHUNK_CACHE_NWAYS);
             HDassert(rdcc->slot[udata.idx_hint]);
 
             /* If the cached chunk is dirty, it must be flushed to get accurate size */
@@ -900,8 +1024,9 @@ H5D__chunk_init(H5F_t *f, const H5D_t *const dset, hid_t dapl_id)
     H5D_chk_idx_info_t idx_info;                            /* Chunked index info */
     H5D_rdcc_t        *rdcc = &(dset->shared->cache.chunk); /* Convenience pointer to dataset's chunk cache */
     H5P_genplist_t    *dapl;                                /* Data access property list object pointer */
-    H5O_storage_chunk_t *sc        = &(dset->shared->layout.storage.u.chunk);
-    herr_t               ret_value = SUCCEED; /* Return value */
+    H5O_storage_chunk_t *sc          = &(dset->shared->layout.storage.u.chunk);
+    size_t               file_nbytes = 0;       /* Size of the file-wide chunk cache */
+    herr_t               ret_value   = SUCCEED; /* Return value */
 
     FUNC_ENTER_PACKAGE
 
@@ -919,21 +1044,48 @@ H5D__chunk_init(H5F_t *f, const H5D_t *const dset, hid_t dapl_id)
     if (rdcc->nslots == H5D_CHUNK_CACHE_NSLOTS_DEFAULT)
         rdcc->nslots = H5F_RDCC_NSLOTS(f);
 
+    /* Datasets of a file with a file-wide chunk cache may use all of it,
+     * unless their own cache size is set */
+    if (H5F_RDCC_FILE_NBYTES(f) > 0 && !H5F_HAS_FEATURE(f, H5FD_FEAT_HAS_MPI))
+        file_nbytes = H5F_RDCC_FILE_NBYTES(f);
+
     if (H5P_get(dapl, H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME, &rdcc->nbytes_max) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get data cache byte size")
     if (rdcc->nbytes_max == H5D_CHUNK_CACHE_NBYTES_DEFAULT)
-        rdcc->nbytes_max = H5F_RDCC_NBYTES(f);
+        rdcc->nbytes_max = file_nbytes ? file_nbytes : H5F_RDCC_NBYTES(f);
+    else if (file_nbytes)
+        rdcc->nbytes_max = MIN(rdcc->nbytes_max, file_nbytes);
 
     if (H5P_get(dapl, H5D_ACS_PREEMPT_READ_CHUNKS_NAME, &rdcc->w0) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get preempt read chunks")
     if (rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    /* Read-ahead starts without an access pattern */
+    if (H5P_get(dapl, H5D_ACS_CHUNK_PREFETCH_NAME, &rdcc->prefetch_depth) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk read-ahead depth")
+    rdcc->prefetch_last   = HSIZE_UNDEF;
+    rdcc->prefetch_stride = 0;
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
     if (!rdcc->nbytes_max || !rdcc->nslots)
         rdcc->nbytes_max = rdcc->nslots = 0;
     else {
-        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nslots);
+        size_t nslots = rdcc->nslots; /* Number of slots the hash table can grow to */
+
+        /* The hash table starts with the number of slots requested, and may
+         * grow as chunks are cached until it has room for twice as many
+         * chunks as fit in the cache, so that chunks seldom evict each other
+         * through the hash table before the cache is full */
+        rdcc->nsets = (rdcc->nslots + H5D_CHUNK_CACHE_NWAYS - 1) / H5D_CHUNK_CACHE_NWAYS;
+        if (dset->shared->layout.u.chunk.size > 0) {
+            size_t max_chunks = rdcc->nbytes_max / dset->shared->layout.u.chunk.size;
+
+            nslots = MAX(nslots, MIN(2 * max_chunks, H5D_CHUNK_CACHE_MAX_AUTO_SLOTS));
+        } /* end if */
+        rdcc->nsets_max = (nslots + H5D_CHUNK_CACHE_NWAYS - 1) / H5D_CHUNK_CACHE_NWAYS;
+
+        rdcc->slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, rdcc->nsets * H5D_CHUNK_CACHE_NWAYS);
         if (NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
 
@@ -967,6 +1119,22 @@ H5D__chunk_init(H5F_t *f, const H5D_t *const dset, hid_t dapl_id)
         } /* end for */
     }     /* end if */
 
+    /* Access the VL data inline in the chunks, if the filters store it there */
+    if (H5Z_filter_in_pline(&dset->shared->dcpl_cache.pline, H5Z_FILTER_VLEN) > 0) {
+        const H5Z_filter_info_t *filter; /* Parameters of the inline VL data filter */
+
+        if (NULL == (filter = H5Z_filter_info(&dset->shared->dcpl_cache.pline, H5Z_FILTER_VLEN)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get inline VL data filter parameters")
+        if (filter->cd_nelmts != H5Z_VLEN_TOTAL_NPARMS ||
+            filter->cd_values[H5Z_VLEN_PARM_ELEM_SIZE] != H5T_get_size(dset->shared->type) ||
+            (hsize_t)filter->cd_values[H5Z_VLEN_PARM_ELEM_SIZE] * filter->cd_values[H5Z_VLEN_PARM_NELMTS] !=
+                dset->shared->layout.u.chunk.size)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL,
+                        "inline VL data filter parameters don't match the dataset")
+        if (H5T_set_vlen_inline(dset->shared->type) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't access VL data inline in chunks")
+    } /* end if */
+
     /* Compose chunked index info struct */
     idx_info.f       = f;
     idx_info.pline   = &dset->shared->dcpl_cache.pline;
@@ -981,6 +1149,27 @@ H5D__chunk_init(H5F_t *f, const H5D_t *const dset, hid_t dapl_id)
     if (H5D__chunk_set_info(dset) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to set # of chunks for dataset")
 
+    /* Take the cache's space from the file-wide chunk cache */
+    if (file_nbytes && rdcc->nslots) {
+        /* Other datasets flush this dataset's chunks through a dataset
+         * object that holds the file open as long as the cache exists */
+        if (NULL == (rdcc->owner = (H5D_t *)H5MM_calloc(sizeof(H5D_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+        H5O_loc_copy_deep(&rdcc->owner->oloc, &dset->oloc);
+        if (H5O_loc_hold_file(&rdcc->owner->oloc) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTOPENFILE, FAIL, "can't hold file open")
+        H5G_name_reset(&rdcc->owner->path);
+        rdcc->owner->shared = dset->shared;
+
+        if (NULL == (rdcc->file = H5F_RDCC_FILE(f))) {
+            if (NULL == (rdcc->file = H5FL_CALLOC(H5D_rdcc_file_t)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+            rdcc->file->nbytes_max = file_nbytes;
+            H5F_SET_RDCC_FILE(f, rdcc->file);
+        } /* end if */
+        rdcc->file->nrefs++;
+    } /* end if */
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_init() */
@@ -1108,6 +1297,10 @@ H5D__chunk_io_init(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo)
     if (H5D__chunk_io_init_selections(io_info, dinfo) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create file and memory chunk selections")
 
+    /* Look up the addresses of many selected chunks together */
+    if (H5D__chunk_lookup_batch(io_info, dinfo) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to look up selected chunks")
+
     /* Check if we're performing selection I/O and save the result if it hasn't
      * been disabled already */
     if (io_info->use_select_io != H5D_SELECTION_IO_MODE_OFF)
@@ -1241,6 +1434,21 @@ H5D__chunk_io_init_selections(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo)
         if ((fm->msel_type = H5S_GET_SELECT_TYPE(dinfo->mem_space)) < H5S_SEL_NONE)
             HGOTO_ERROR(H5E_DATASET, H5E_BADSELECT, FAIL, "unable to get type of selection")
 
+        /* Reuse the chunk selections of the last hyperslab I/O on the dataset,
+         * if this is the same selection moved by a whole number of chunks */
+        if (H5S_SEL_HYPERSLABS == fm->fsel_type
+#ifdef H5_HAVE_PARALLEL
+            && !(io_info->using_mpi_vfd)
+#endif /* H5_HAVE_PARALLEL */
+        ) {
+            htri_t plan_used; /* Whether the selection plan was reused */
+
+            if ((plan_used = H5D__chunk_sel_plan_apply(io_info, dinfo)) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to reuse chunk selections")
+            if (plan_used)
+                HGOTO_DONE(SUCCEED)
+        } /* end if */
+
         /* If the selection is NONE or POINTS, set the flag to FALSE */
         if (fm->fsel_type == H5S_SEL_POINTS || fm->fsel_type == H5S_SEL_NONE)
             sel_hyper_flag = FALSE;
@@ -1337,7 +1545,16 @@ H5D__chunk_io_init_selections(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo)
             if (H5S_select_iterate(&bogus, file_type, dinfo->file_space, &iter_op, &io_info_wrap) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to create memory chunk selections")
         } /* end else */
-    }     /* end else */
+
+        /* Keep the chunk selections of a hyperslab I/O for the next one */
+        if (H5S_SEL_HYPERSLABS == fm->fsel_type
+#ifdef H5_HAVE_PARALLEL
+            && !(io_info->using_mpi_vfd)
+#endif /* H5_HAVE_PARALLEL */
+        )
+            if (H5D__chunk_sel_plan_build(dinfo) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "unable to keep chunk selections")
+    } /* end else */
 
 done:
     /* Release the [potentially partially built] chunk mapping information if an error occurs */
@@ -1363,7 +1580,7 @@ done:
  *
  * Purpose:    Allocate space for a chunk in memory.  This routine allocates
  *              memory space for non-filtered chunks from a block free list
- *              and uses malloc()/free() for filtered chunks.
+ *              and from the pool of filter buffers for filtered chunks.
  *
  * Return:    Pointer to memory for chunk on success/NULL on failure
  *
@@ -1383,7 +1600,7 @@ H5D__chunk_mem_alloc(size_t size, void *pline)
     HDassert(size);
 
     if (_pline && _pline->nused)
-        ret_value = H5MM_malloc(size);
+        ret_value = H5Z_buf_malloc(size);
     else
         ret_value = H5FL_BLK_MALLOC(chunk, size);
 
@@ -1395,7 +1612,9 @@ H5D__chunk_mem_alloc(size_t size, void *pline)
  *
  * Purpose:    Free space for a chunk in memory.  This routine releases
  *              memory space for non-filtered chunks from a block free list
- *              and uses malloc()/free() for filtered chunks.
+ *              and to the pool of filter buffers for filtered chunks,
+ *              which keeps them if SIZE, the number of bytes the buffer
+ *              is known to hold (0 if unknown), is worth it.
  *
  * Return:    NULL (never fails)
  *
@@ -1405,7 +1624,7 @@ H5D__chunk_mem_alloc(size_t size, void *pline)
  *-------------------------------------------------------------------------
  */
 void *
-H5D__chunk_mem_xfree(void *chk, const void *pline)
+H5D__chunk_mem_xfree(void *chk, size_t size, const void *pline)
 {
     const H5O_pline_t *_pline = (const H5O_pline_t *)pline;
 
@@ -1413,7 +1632,7 @@ H5D__chunk_mem_xfree(void *chk, const void *pline)
 
     if (chk) {
         if (_pline && _pline->nused)
-            H5MM_xfree(chk);
+            H5Z_buf_free(chk, size);
         else
             chk = H5FL_BLK_FREE(chunk, chk);
     } /* end if */
@@ -1431,7 +1650,7 @@ H5D__chunk_mem_xfree(void *chk, const void *pline)
 void
 H5D__chunk_mem_free(void *chk, void *pline)
 {
-    (void)H5D__chunk_mem_xfree(chk, pline);
+    (void)H5D__chunk_mem_xfree(chk, (size_t)0, pline);
 }
 
 /*-------------------------------------------------------------------------
@@ -1565,6 +1784,7 @@ H5D__create_piece_map_single(H5D_dset_io_info_t *di, H5D_io_info_t *io_info)
     /* Calculate the index of this chunk */
     piece_info->index =
         H5VM_array_offset_pre(fm->f_ndims, di->layout->u.chunk.down_chunks, piece_info->scaled);
+    piece_info->index_valid = FALSE;
 
     /* Copy selection for file's dataspace into chunk dataspace */
     if (H5S_select_copy(fm->single_space, di->file_space, FALSE) < 0)
@@ -1695,7 +1915,8 @@ H5D__create_piece_file_map_all(H5D_dset_io_info_t *di, H5D_io_info_t *io_info)
         /* Initialize the chunk information */
 
         /* Set the chunk index */
-        new_piece_info->index = chunk_index;
+        new_piece_info->index       = chunk_index;
+        new_piece_info->index_valid = FALSE;
 
         /* Set the file chunk dataspace */
         if (NULL == (new_piece_info->fspace = H5S_copy(tmp_fchunk, TRUE, FALSE)))
@@ -1901,7 +2122,8 @@ H5D__create_piece_file_map_hyper(H5D_dset_io_info_t *dinfo, H5D_io_info_t *io_in
             /* Initialize the chunk information */
 
             /* Set the chunk index */
-            new_piece_info->index = chunk_index;
+            new_piece_info->index       = chunk_index;
+            new_piece_info->index_valid = FALSE;
 
             /* Set the file chunk dataspace */
             new_piece_info->fspace        = tmp_fchunk;
@@ -2211,6 +2433,260 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__create_piece_mem_map_1d() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_plan_apply
+ *
+ * Purpose:     Create the chunk selections of a hyperslab I/O from the
+ *              dataset's selection plan, if the file selection is the one
+ *              the plan was built for, moved by a whole number of chunks,
+ *              and the memory selection is the same.  The pieces' file and
+ *              memory selections are shared with the plan, and only their
+ *              chunk coordinates are moved.
+ *
+ * Return:      TRUE if the plan was used, FALSE if it doesn't match, or
+ *              negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_sel_plan_apply(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo)
+{
+    H5D_rdcc_t     *rdcc = &(dinfo->dset->shared->cache.chunk); /* Dataset's chunk cache */
+    H5D_sel_plan_t *plan = rdcc->sel_plan;                      /* Selection plan */
+    H5D_chunk_map_t *fm  = dinfo->layout_io_info.chunk_map;     /* Convenience pointer to chunk map */
+    hsize_t          sel_start[H5O_LAYOUT_NDIMS];               /* Offset of low bound of file selection */
+    hsize_t          sel_end[H5O_LAYOUT_NDIMS];                 /* Offset of high bound of file selection */
+    hsize_t          mem_start[H5S_MAX_RANK];                   /* Offset of low bound of memory selection */
+    hsize_t          mem_end[H5S_MAX_RANK];                     /* Offset of high bound of memory selection */
+    hsize_t          base[H5O_LAYOUT_NDIMS];                    /* Scaled coordinates of first chunk */
+    hsize_t          mem_dims[H5S_MAX_RANK];                    /* Dimensions of memory dataspace */
+    hsize_t          plan_mem_dims[H5S_MAX_RANK];               /* Dimensions of plan's memory dataspace */
+    int              mem_ndims;                                 /* Rank of memory dataspace */
+    int              plan_mem_ndims;                            /* Rank of plan's memory dataspace */
+    htri_t           same;                                      /* Whether the selections are the same */
+    size_t           v;                                         /* Local index variable */
+    unsigned         u;                                         /* Local index variable */
+    htri_t           ret_value = TRUE;                          /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check for a plan built for this number of elements */
+    if (NULL == plan || H5S_GET_SELECT_NPOINTS(dinfo->file_space) != H5S_GET_SELECT_NPOINTS(plan->file_space))
+        HGOTO_DONE(FALSE)
+
+    /* Check that the file selection starts at the same place in its first chunk */
+    if (H5S_SELECT_BOUNDS(dinfo->file_space, sel_start, sel_end) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get file selection bound info")
+    for (u = 0; u < fm->f_ndims; u++) {
+        base[u] = sel_start[u] / fm->chunk_dim[u];
+        if (sel_start[u] - base[u] * fm->chunk_dim[u] != plan->start[u] - plan->base[u] * fm->chunk_dim[u])
+            HGOTO_DONE(FALSE)
+    } /* end for */
+
+    /* Check that the memory selection is the same.  (Only the current
+     * dimensions of the memory dataspaces need to match, not the maximum
+     * ones compared by H5S_extent_equal.)
+     */
+    if ((mem_ndims = H5S_get_simple_extent_dims(dinfo->mem_space, mem_dims, NULL)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "unable to get memory dimensions")
+    if ((plan_mem_ndims = H5S_get_simple_extent_dims(plan->mem_space, plan_mem_dims, NULL)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "unable to get memory dimensions")
+    if (mem_ndims != plan_mem_ndims || HDmemcmp(mem_dims, plan_mem_dims, (size_t)mem_ndims * sizeof(hsize_t)) != 0)
+        HGOTO_DONE(FALSE)
+    if (H5S_SELECT_BOUNDS(dinfo->mem_space, mem_start, mem_end) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get memory selection bound info")
+    if (HDmemcmp(mem_start, plan->mem_start, fm->m_ndims * sizeof(hsize_t)) != 0)
+        HGOTO_DONE(FALSE)
+    if ((same = H5S_SELECT_SHAPE_SAME(dinfo->mem_space, plan->mem_space)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOMPARE, FAIL, "can't compare memory selections")
+    if (!same)
+        HGOTO_DONE(FALSE)
+
+    /* Check that the file selection has the same shape */
+    if ((same = H5S_SELECT_SHAPE_SAME(dinfo->file_space, plan->file_space)) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOMPARE, FAIL, "can't compare file selections")
+    if (!same)
+        HGOTO_DONE(FALSE)
+
+    /* Create the pieces, moved to the chunks of this selection */
+    for (v = 0; v < plan->npieces; v++) {
+        const H5D_sel_plan_piece_t *plan_piece = &plan->pieces[v]; /* Piece of the plan */
+        H5D_piece_info_t           *new_piece_info;                /* Piece information to insert */
+
+        /* Allocate the file & memory chunk information */
+        if (NULL == (new_piece_info = H5FL_MALLOC(H5D_piece_info_t)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate chunk info")
+
+        /* Set the chunk's scaled coordinates & index */
+        for (u = 0; u < fm->f_ndims; u++)
+            new_piece_info->scaled[u] = base[u] + plan_piece->scaled[u];
+        new_piece_info->scaled[fm->f_ndims] = 0;
+        new_piece_info->index =
+            H5VM_array_offset_pre(fm->f_ndims, dinfo->layout->u.chunk.down_chunks, new_piece_info->scaled);
+        new_piece_info->index_valid = FALSE;
+
+        /* Share the file & memory selections with the plan */
+        new_piece_info->fspace_shared = FALSE;
+        new_piece_info->mspace        = NULL;
+        new_piece_info->mspace_shared = FALSE;
+        if (NULL == (new_piece_info->fspace = H5S_copy(plan_piece->fspace, TRUE, FALSE))) {
+            new_piece_info = H5FL_FREE(H5D_piece_info_t, new_piece_info);
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy chunk dataspace")
+        } /* end if */
+        if (plan_piece->mspace) {
+            if (NULL == (new_piece_info->mspace = H5S_copy(plan_piece->mspace, TRUE, FALSE))) {
+                H5D__free_piece_info(new_piece_info, NULL, NULL);
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy memory space")
+            } /* end if */
+        }     /* end if */
+        else {
+            new_piece_info->mspace        = dinfo->mem_space;
+            new_piece_info->mspace_shared = TRUE;
+        } /* end else */
+        new_piece_info->piece_points = plan_piece->piece_points;
+
+        /* make connection to related dset info from this piece_info */
+        new_piece_info->dset_info = dinfo;
+
+        /* Initialize in-place type conversion info. Start with it disabled. */
+        new_piece_info->in_place_tconv = FALSE;
+        new_piece_info->buf_off        = 0;
+
+        /* Insert the new piece into the skip list */
+        if (H5SL_insert(fm->dset_sel_pieces, new_piece_info, &new_piece_info->index) < 0) {
+            H5D__free_piece_info(new_piece_info, NULL, NULL);
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert piece into skip list")
+        } /* end if */
+
+        /* Add piece to global piece_count */
+        io_info->piece_count++;
+    } /* end for */
+
+    rdcc->stats.nplan_hits++;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_plan_apply() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_plan_build
+ *
+ * Purpose:     Replace the dataset's selection plan with the chunk
+ *              selections just built for a hyperslab I/O, unless it
+ *              selects too many chunks.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_sel_plan_build(H5D_dset_io_info_t *dinfo)
+{
+    H5D_rdcc_t      *rdcc = &(dinfo->dset->shared->cache.chunk); /* Dataset's chunk cache */
+    H5D_chunk_map_t *fm   = dinfo->layout_io_info.chunk_map;     /* Convenience pointer to chunk map */
+    H5D_sel_plan_t  *plan = NULL;                                /* New selection plan */
+    H5SL_node_t     *curr_node;                                  /* Current node in skip list */
+    hsize_t          sel_end[H5O_LAYOUT_NDIMS];                  /* Offset of high bound of file selection */
+    hsize_t          mem_end[H5S_MAX_RANK];                      /* Offset of high bound of memory selection */
+    size_t           npieces;                                    /* Number of pieces selected */
+    unsigned         u;                                          /* Local index variable */
+    herr_t           ret_value = SUCCEED;                        /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Release the previous plan */
+    if (rdcc->sel_plan)
+        rdcc->sel_plan = H5D__chunk_sel_plan_free(rdcc->sel_plan);
+
+    /* Don't keep the selections of I/O on many chunks */
+    npieces = H5SL_count(fm->dset_sel_pieces);
+    if (0 == npieces || npieces > H5D_CHUNK_SEL_PLAN_MAX_PIECES)
+        HGOTO_DONE(SUCCEED)
+
+    /* Allocate the plan */
+    if (NULL == (plan = H5FL_CALLOC(H5D_sel_plan_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate selection plan")
+    if (NULL == (plan->pieces = H5FL_SEQ_CALLOC(H5D_sel_plan_piece_t, npieces)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't allocate selection plan pieces")
+
+    /* Keep the selections the plan is for */
+    if (NULL == (plan->file_space = H5S_copy(dinfo->file_space, TRUE, FALSE)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy file space")
+    if (NULL == (plan->mem_space = H5S_copy(dinfo->mem_space, TRUE, FALSE)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy memory space")
+    if (H5S_SELECT_BOUNDS(dinfo->file_space, plan->start, sel_end) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get file selection bound info")
+    if (H5S_SELECT_BOUNDS(dinfo->mem_space, plan->mem_start, mem_end) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get memory selection bound info")
+    for (u = 0; u < fm->f_ndims; u++)
+        plan->base[u] = plan->start[u] / fm->chunk_dim[u];
+
+    /* Share the selections of each piece, with coordinates from the first chunk */
+    curr_node = H5SL_first(fm->dset_sel_pieces);
+    while (curr_node) {
+        const H5D_piece_info_t *piece_info = (const H5D_piece_info_t *)H5SL_item(curr_node);
+        H5D_sel_plan_piece_t   *plan_piece = &plan->pieces[plan->npieces];
+
+        for (u = 0; u < fm->f_ndims; u++) {
+            HDassert(piece_info->scaled[u] >= plan->base[u]);
+            plan_piece->scaled[u] = piece_info->scaled[u] - plan->base[u];
+        } /* end for */
+        plan_piece->piece_points = piece_info->piece_points;
+        if (NULL == (plan_piece->fspace = H5S_copy(piece_info->fspace, TRUE, FALSE)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy chunk dataspace")
+        plan->npieces++;
+        if (!piece_info->mspace_shared)
+            if (NULL == (plan_piece->mspace = H5S_copy(piece_info->mspace, TRUE, FALSE)))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to copy memory space")
+
+        curr_node = H5SL_next(curr_node);
+    } /* end while */
+    HDassert(plan->npieces == npieces);
+
+    rdcc->sel_plan = plan;
+    plan           = NULL;
+
+done:
+    if (plan)
+        plan = H5D__chunk_sel_plan_free(plan);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_plan_build() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_plan_free
+ *
+ * Purpose:     Free a dataset's selection plan.
+ *
+ * Return:      NULL (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5D_sel_plan_t *
+H5D__chunk_sel_plan_free(H5D_sel_plan_t *plan)
+{
+    size_t v; /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(plan);
+
+    for (v = 0; v < plan->npieces; v++) {
+        (void)H5S_close(plan->pieces[v].fspace);
+        if (plan->pieces[v].mspace)
+            (void)H5S_close(plan->pieces[v].mspace);
+    } /* end for */
+    if (plan->pieces)
+        plan->pieces = H5FL_SEQ_FREE(H5D_sel_plan_piece_t, plan->pieces);
+    if (plan->file_space)
+        (void)H5S_close(plan->file_space);
+    if (plan->mem_space)
+        (void)H5S_close(plan->mem_space);
+    plan = H5FL_FREE(H5D_sel_plan_t, plan);
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* end H5D__chunk_sel_plan_free() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__piece_file_cb
  *
@@ -2268,7 +2744,8 @@ H5D__piece_file_cb(void H5_ATTR_UNUSED *elem, const H5T_t H5_ATTR_UNUSED *type,
             /* Initialize the chunk information */
 
             /* Set the chunk index */
-            piece_info->index = chunk_index;
+            piece_info->index       = chunk_index;
+            piece_info->index_valid = FALSE;
 
             /* Create a dataspace for the chunk */
             if ((fspace = H5S_create_simple(fm->f_ndims, fm->chunk_dim, NULL)) == NULL) {
@@ -2450,7 +2927,7 @@ H5D__chunk_mdio_init(H5D_io_info_t *io_info, H5D_dset_io_info_t *dinfo)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "couldn't get piece info from list")
 
         /* Get the info for the chunk in the file */
-        if (H5D__chunk_lookup(dinfo->dset, piece_info->scaled, &udata) < 0)
+        if (H5D__chunk_lookup_piece(dinfo->dset, piece_info, &udata) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
         /* Save chunk file address */
@@ -2637,128 +3114,727 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_may_use_select_io() */
 
+#ifdef H5_HAVE_THREADSAFE
 /*-------------------------------------------------------------------------
- * Function:    H5D__chunk_read
- *
- * Purpose:    Read from a chunked dataset.
+ * Function:    H5D__chunk_filter_thread
  *
- * Return:    Non-negative on success/Negative on failure
+ * Purpose:     Thread entry point that runs the filter pipeline on every
+ *              NTHREADS-th job, starting with the thread's first job.
+ *              Errors are recorded in each job's status, to be reported
+ *              by the thread that started the work.  A worker thread
+ *              moves the errors on its error stack to its thread info,
+ *              for that thread to append to its own error stack.
  *
- * Programmer:    Raymond Lu
- *        Thursday, April 10, 2003
+ * Return:      NULL
  *
  *-------------------------------------------------------------------------
  */
-static herr_t
-H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
+static void *
+H5D__chunk_filter_thread(void *_thread_info)
 {
-    H5SL_node_t       *chunk_node;                  /* Current node in chunk skip list */
-    H5D_io_info_t      nonexistent_io_info;         /* "nonexistent" I/O info object */
-    H5D_dset_io_info_t nonexistent_dset_info;       /* "nonexistent" I/O dset info object */
-    H5D_dset_io_info_t ctg_dset_info;               /* Contiguous I/O dset info object */
-    H5D_dset_io_info_t cpt_dset_info;               /* Compact I/O dset info object */
-    uint32_t           src_accessed_bytes  = 0;     /* Total accessed size in a chunk */
-    hbool_t            skip_missing_chunks = FALSE; /* Whether to skip missing chunks */
-    H5S_t            **chunk_mem_spaces    = NULL;  /* Array of chunk memory spaces */
-    H5S_t             *chunk_mem_spaces_local[8];   /* Local buffer for chunk_mem_spaces */
-    H5S_t            **chunk_file_spaces = NULL;    /* Array of chunk file spaces */
-    H5S_t             *chunk_file_spaces_local[8];  /* Local buffer for chunk_file_spaces */
-    haddr_t           *chunk_addrs = NULL;          /* Array of chunk addresses */
-    haddr_t            chunk_addrs_local[8];        /* Local buffer for chunk_addrs */
-    herr_t             ret_value = SUCCEED;         /*return value        */
-
-    FUNC_ENTER_PACKAGE
+    H5D_chunk_filter_thread_t *thread_info = (H5D_chunk_filter_thread_t *)_thread_info;
+    H5D_chunk_filter_work_t   *work        = thread_info->work;
+    size_t                     u;
 
-    /* Sanity check */
-    HDassert(io_info);
-    HDassert(dset_info);
-    HDassert(dset_info->buf.vp);
+    FUNC_ENTER_PACKAGE_NOERR
 
-    /* Set up "nonexistent" I/O info object */
-    H5MM_memcpy(&nonexistent_io_info, io_info, sizeof(nonexistent_io_info));
-    H5MM_memcpy(&nonexistent_dset_info, dset_info, sizeof(nonexistent_dset_info));
-    nonexistent_dset_info.layout_ops = *H5D_LOPS_NONEXISTENT;
-    nonexistent_io_info.dsets_info   = &nonexistent_dset_info;
-    nonexistent_io_info.count        = 1;
+    for (u = thread_info->first; u < work->njobs; u += work->nthreads) {
+        H5D_chunk_filter_job_t *job = &work->jobs[u];
 
-    {
-        const H5O_fill_t *fill = &(dset_info->dset->shared->dcpl_cache.fill); /* Fill value info */
-        H5D_fill_value_t  fill_status;                                        /* Fill value status */
+        if (job->buf)
+            job->status = H5Z_pipeline(work->pline, work->flags, &job->udata.filter_mask, work->err_detect,
+                                       thread_info->filter_cb, &job->nbytes, &job->buf_alloc, &job->buf);
+    } /* end for */
 
-        /* Check the fill value status */
-        if (H5P_is_fill_value_defined(fill, &fill_status) < 0)
-            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+    if (thread_info->first > 0)
+        thread_info->estack = H5E_detach_stack();
 
-        /* If we are never to return fill values, or if we would return them
-         * but they aren't set, set the flag to skip missing chunks.
-         */
-        if (fill->fill_time == H5D_FILL_TIME_NEVER ||
-            (fill->fill_time == H5D_FILL_TIME_IFSET && fill_status != H5D_FILL_VALUE_USER_DEFINED &&
-             fill_status != H5D_FILL_VALUE_DEFAULT))
-            skip_missing_chunks = TRUE;
-    }
+    FUNC_LEAVE_NOAPI(NULL)
+} /* end H5D__chunk_filter_thread() */
+#endif /* H5_HAVE_THREADSAFE */
 
-    /* Different blocks depending on whether we're using selection I/O */
-    if (io_info->use_select_io == H5D_SELECTION_IO_MODE_ON) {
-        size_t num_chunks       = 0;
-        size_t element_sizes[2] = {dset_info->type_info.src_type_size, 0};
-        void  *bufs[2]          = {dset_info->buf.vp, NULL};
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_jobs
+ *
+ * Purpose:     Runs the filter pipeline on the buffers of a set of chunk
+ *              jobs, using up to NTHREADS threads (including the calling
+ *              thread).  Jobs without a buffer are skipped.
+ *
+ *              Threads are only used in thread-safe builds, where each
+ *              thread has its own error stack, and only when every filter
+ *              in the pipeline is built into the library.  Otherwise the
+ *              jobs are run on the calling thread.
+ *
+ *              The calling thread holds the library's lock while it waits
+ *              for the worker threads, so the application's filter
+ *              callback (see H5Pset_filter_callback()) is only called on
+ *              the calling thread.  The worker threads run the pipeline
+ *              without it, and when the application has set one, the jobs
+ *              that failed on them are marked for the caller to run again
+ *              on the calling thread.  The errors raised on the worker
+ *              threads are appended to the calling thread's error stack.
+ *
+ *              The result of each pipeline is left in the job's status for
+ *              the caller to check.  This routine only fails before any
+ *              pipeline has been run.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_jobs(const H5O_pline_t *pline, unsigned flags, H5D_chunk_filter_job_t *jobs, size_t njobs,
+                       unsigned nthreads)
+{
+    H5D_chunk_filter_work_t work;                /* Information shared by all threads */
+    size_t                  u;                   /* Local index variable */
+    herr_t                  ret_value = SUCCEED; /* Return value */
 
-        /* Only create selection I/O arrays if not performing multi dataset I/O,
-         * otherwise the higher level will handle it */
-        if (H5D_LAYOUT_CB_PERFORM_IO(io_info)) {
-            /* Cache number of chunks */
-            num_chunks = H5D_CHUNK_GET_NODE_COUNT(dset_info);
+    FUNC_ENTER_PACKAGE
 
-            /* Allocate arrays of dataspaces and offsets for use with selection I/O,
-             * or point to local buffers */
-            HDassert(sizeof(chunk_mem_spaces_local) / sizeof(chunk_mem_spaces_local[0]) ==
-                     sizeof(chunk_file_spaces_local) / sizeof(chunk_file_spaces_local[0]));
-            HDassert(sizeof(chunk_mem_spaces_local) / sizeof(chunk_mem_spaces_local[0]) ==
-                     sizeof(chunk_addrs_local) / sizeof(chunk_addrs_local[0]));
-            if (num_chunks > (sizeof(chunk_mem_spaces_local) / sizeof(chunk_mem_spaces_local[0]))) {
-                if (NULL == (chunk_mem_spaces = H5MM_malloc(num_chunks * sizeof(H5S_t *))))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                "memory allocation failed for memory space list")
-                if (NULL == (chunk_file_spaces = H5MM_malloc(num_chunks * sizeof(H5S_t *))))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                "memory allocation failed for file space list")
-                if (NULL == (chunk_addrs = H5MM_malloc(num_chunks * sizeof(haddr_t))))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                "memory allocation failed for chunk address list")
-            } /* end if */
-            else {
-                chunk_mem_spaces  = chunk_mem_spaces_local;
-                chunk_file_spaces = chunk_file_spaces_local;
-                chunk_addrs       = chunk_addrs_local;
-            } /* end else */
+    /* Sanity checks */
+    HDassert(pline);
+    HDassert(jobs || njobs == 0);
+
+    /* Retrieve filter settings from API context */
+    if (H5CX_get_err_detect(&work.err_detect) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+    if (H5CX_get_filter_cb(&work.filter_cb) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+    work.pline    = pline;
+    work.flags    = flags;
+    work.jobs     = jobs;
+    work.njobs    = njobs;
+    work.nthreads = MIN(MAX(nthreads, 1), njobs);
+    for (u = 0; u < njobs; u++) {
+        jobs[u].status = SUCCEED;
+        jobs[u].retry  = FALSE;
+    } /* end for */
 
-            /* Reset num_chunks */
-            num_chunks = 0;
+    /* Only run the filters on several threads if they are known to be safe for it */
+    if (work.nthreads > 1 && !H5Z_pipeline_thread_safe(pline))
+        work.nthreads = 1;
+
+#ifdef H5_HAVE_THREADSAFE
+    if (work.nthreads > 1) {
+        H5D_chunk_filter_thread_t *thread_info = NULL; /* Per-thread information */
+        H5TS_thread_t             *threads     = NULL; /* Worker threads */
+
+        if (NULL == (thread_info = (H5D_chunk_filter_thread_t *)H5MM_malloc(
+                         work.nthreads * sizeof(H5D_chunk_filter_thread_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for thread info")
+        if (NULL == (threads = (H5TS_thread_t *)H5MM_malloc(work.nthreads * sizeof(H5TS_thread_t)))) {
+            H5MM_xfree(thread_info);
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for threads")
         } /* end if */
 
-        /* Iterate through nodes in chunk skip list */
-        chunk_node = H5D_CHUNK_GET_FIRST_NODE(dset_info);
-        while (chunk_node) {
-            H5D_piece_info_t *chunk_info; /* Chunk information */
-            H5D_chunk_ud_t    udata;      /* Chunk index pass-through    */
+        /* Start the worker threads, the calling thread takes the first share.
+         * Only the calling thread may call the application's filter callback. */
+        for (u = 0; u < work.nthreads; u++) {
+            thread_info[u].work   = &work;
+            thread_info[u].first  = u;
+            thread_info[u].estack = NULL;
+            if (u > 0) {
+                thread_info[u].filter_cb.func    = NULL;
+                thread_info[u].filter_cb.op_data = NULL;
+                threads[u] = H5TS_create_thread(H5D__chunk_filter_thread, NULL, &thread_info[u]);
+            } /* end if */
+            else
+                thread_info[u].filter_cb = work.filter_cb;
+        } /* end for */
+        H5D__chunk_filter_thread(&thread_info[0]);
+
+        /* Wait for the worker threads to finish */
+        for (u = 1; u < work.nthreads; u++)
+            H5TS_wait_for_thread(threads[u]);
+
+        /* Report the errors raised on the worker threads */
+        for (u = 1; u < work.nthreads; u++)
+            if (thread_info[u].estack)
+                if (H5E_attach_stack(thread_info[u].estack) < 0)
+                    HDONE_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't append worker thread's errors")
+
+        /* The jobs that failed on the worker threads haven't been through the
+         * application's filter callback */
+        if (work.filter_cb.func)
+            for (u = 0; u < njobs; u++)
+                if (jobs[u].status < 0 && (u % work.nthreads) != 0)
+                    jobs[u].retry = TRUE;
+
+        H5MM_xfree(threads);
+        H5MM_xfree(thread_info);
+    } /* end if */
+    else
+#endif /* H5_HAVE_THREADSAFE */
+        for (u = 0; u < njobs; u++)
+            if (jobs[u].buf)
+                jobs[u].status = H5Z_pipeline(pline, flags, &jobs[u].udata.filter_mask, work.err_detect,
+                                              work.filter_cb, &jobs[u].nbytes, &jobs[u].buf_alloc,
+                                              &jobs[u].buf);
 
-            /* Get the actual chunk information from the skip list node */
-            chunk_info = H5D_CHUNK_GET_NODE_INFO(dset_info, chunk_node);
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_jobs() */
 
-            /* Get the info for the chunk in the file */
-            if (H5D__chunk_lookup(dset_info->dset, chunk_info->scaled, &udata) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_jobs_retry
+ *
+ * Purpose:     Releases the buffers of the jobs in JOBS that failed on a
+ *              worker thread without the application's filter callback,
+ *              so their chunks go through the filter pipeline again on
+ *              the calling thread, the same way as chunks that weren't
+ *              filtered ahead.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_filter_jobs_retry(const H5O_pline_t *pline, H5D_chunk_filter_job_t *jobs, size_t njobs)
+{
+    size_t u; /* Local index variable */
 
-            /* There should be no chunks cached */
-            HDassert(UINT_MAX == udata.idx_hint);
+    FUNC_ENTER_PACKAGE_NOERR
 
-            /* Sanity check */
-            HDassert((H5_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) ||
-                     (!H5_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
+    for (u = 0; u < njobs; u++)
+        if (jobs[u].retry) {
+            jobs[u].buf    = H5D__chunk_mem_xfree(jobs[u].buf, jobs[u].buf_alloc, pline);
+            jobs[u].status = SUCCEED;
+            jobs[u].retry  = FALSE;
+        } /* end if */
 
-            /* Check for non-existent chunk & skip it if appropriate */
-            if (H5_addr_defined(udata.chunk_block.offset)) {
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_filter_jobs_retry() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_jobs_read
+ *
+ * Purpose:     Reads the stored bytes of the chunks in JOBS that have a
+ *              buffer allocated.  The reads are issued as one vector read,
+ *              so chunks that are neighbors in the file are read together
+ *              (see H5Pset_vector_read_gap()).  Each chunk is read on its
+ *              own when the page buffer is enabled, since vector reads
+ *              bypass it, and for MPI file drivers.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_jobs_read(const H5D_t *dset, H5D_chunk_filter_job_t *jobs, size_t njobs)
+{
+    H5F_shared_t *f_sh      = H5F_SHARED(dset->oloc.file);
+    H5FD_mem_t    types[2]  = {H5FD_MEM_DRAW, H5FD_MEM_NOLIST};
+    haddr_t      *addrs     = NULL;    /* Addresses of chunks to read */
+    size_t       *sizes     = NULL;    /* Sizes of chunks to read */
+    void        **bufs      = NULL;    /* Buffers for chunks to read */
+    uint32_t      nreads    = 0;       /* Number of chunks to read */
+    hbool_t       page_buf  = FALSE;   /* Whether the page buffer is enabled */
+    size_t        u;                   /* Local index variable */
+    herr_t        ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(jobs || njobs == 0);
+
+    if (H5PB_enabled(f_sh, H5FD_MEM_DRAW, &page_buf) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check if page buffer is enabled")
+
+    /* Read the chunks one at a time, if they can't be read together */
+    if (page_buf || H5F_HAS_FEATURE(dset->oloc.file, H5FD_FEAT_HAS_MPI)) {
+        for (u = 0; u < njobs; u++)
+            if (jobs[u].buf)
+                if (H5F_shared_block_read(f_sh, H5FD_MEM_DRAW, jobs[u].udata.chunk_block.offset,
+                                          jobs[u].nbytes, jobs[u].buf) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Build the vector of reads */
+    if (NULL == (addrs = (haddr_t *)H5MM_malloc(njobs * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for address list")
+    if (NULL == (sizes = (size_t *)H5MM_malloc(njobs * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for size list")
+    if (NULL == (bufs = (void **)H5MM_malloc(njobs * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for buffer list")
+    for (u = 0; u < njobs; u++)
+        if (jobs[u].buf) {
+            addrs[nreads] = jobs[u].udata.chunk_block.offset;
+            sizes[nreads] = jobs[u].nbytes;
+            bufs[nreads]  = jobs[u].buf;
+            nreads++;
+        } /* end if */
+
+    if (nreads > 0) {
+        uint32_t no_selection_io_cause; /* Reasons for not performing selection I/O */
+
+        /* The vector read is not selection I/O for the dataset, so don't let
+         * the file driver report why it couldn't do one */
+        if (H5CX_get_no_selection_io_cause(&no_selection_io_cause) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get no selection I/O cause")
+
+        if (H5F_shared_vector_read(f_sh, nreads, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+        H5CX_set_no_selection_io_cause(no_selection_io_cause);
+    } /* end if */
+
+done:
+    H5MM_xfree(addrs);
+    H5MM_xfree(sizes);
+    H5MM_xfree(bufs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_jobs_read() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_batch_init
+ *
+ * Purpose:     Sets up reading and filtering chunks in batches ahead of
+ *              the chunk read loop, if the read touches more than one
+ *              chunk of a filtered dataset and the application has asked
+ *              for the filter pipeline to be run on more than one thread,
+ *              or has set a vector read gap so neighboring chunks can be
+ *              read together.  Batching is left disabled (nthreads == 0)
+ *              otherwise.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_batch_init(const H5D_dset_io_info_t *dset_info, H5D_chunk_filter_batch_t *batch)
+{
+    unsigned nthreads  = 1;       /* Number of filter threads requested */
+    size_t   gap       = 0;       /* Vector read gap requested */
+    size_t   max_jobs;            /* Number of chunks per batch */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset_info);
+    HDassert(batch);
+
+    HDmemset(batch, 0, sizeof(*batch));
+
+    if (dset_info->dset->shared->dcpl_cache.pline.nused == 0 || H5D_CHUNK_GET_NODE_COUNT(dset_info) < 2)
+        HGOTO_DONE(SUCCEED)
+
+    if (H5CX_get_filter_nthreads(&nthreads) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of filter threads")
+    if (H5CX_get_vector_read_gap(&gap) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get vector read gap")
+    if (nthreads < 2 && gap == 0)
+        HGOTO_DONE(SUCCEED)
+
+    max_jobs = (size_t)nthreads * H5D_CHUNK_FILTER_BATCH_FACTOR;
+    if (gap > 0)
+        max_jobs = MAX(max_jobs, H5D_CHUNK_READ_BATCH_JOBS);
+    batch->max_jobs = MIN(max_jobs, H5D_CHUNK_GET_NODE_COUNT(dset_info));
+    if (NULL == (batch->jobs = (H5D_chunk_filter_job_t *)H5MM_malloc(batch->max_jobs *
+                                                                        sizeof(H5D_chunk_filter_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk filter jobs")
+    batch->nthreads = nthreads;
+    batch->end      = H5D_CHUNK_GET_FIRST_NODE(dset_info);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_batch_init() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_batch_fill
+ *
+ * Purpose:     Looks up the next batch of chunks in the selection, starting
+ *              at CHUNK_NODE.  The stored bytes of the chunks that exist in
+ *              the file, aren't in the chunk cache and have filters enabled
+ *              are read first, with a single vector read, then the filter
+ *              pipeline is run on all of them at once.  The chunk read loop then picks the filtered
+ *              chunks up in order with H5D__chunk_lock().
+ *
+ *              The lookup information for chunks that are not in the chunk
+ *              cache is kept in the batch as well, since it can't change
+ *              until the read loop reaches those chunks.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_batch_fill(const H5D_dset_io_info_t *dset_info, H5D_chunk_filter_batch_t *batch,
+                             H5SL_node_t *chunk_node)
+{
+    const H5D_t        *dset      = dset_info->dset;
+    const H5O_layout_t *layout    = &(dset->shared->layout);
+    H5O_pline_t        *pline     = &(dset->shared->dcpl_cache.pline);
+    size_t              u;                   /* Local index variable */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(batch);
+    HDassert(batch->nthreads > 0);
+    HDassert(chunk_node);
+
+    /* Release anything left over from the previous batch */
+    if (H5D__chunk_filter_batch_reset(dset, batch) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunk filter batch")
+
+    /* Look up chunks until the batch is full */
+    while (chunk_node && batch->njobs < batch->max_jobs) {
+        H5D_piece_info_t       *chunk_info = H5D_CHUNK_GET_NODE_INFO(dset_info, chunk_node);
+        H5D_chunk_filter_job_t *job        = &batch->jobs[batch->njobs];
+
+        if (H5D__chunk_lookup_piece(dset, chunk_info, &job->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Chunks in the cache are looked up again by the read loop, since
+         * reading earlier chunks can evict them */
+        if (UINT_MAX == job->udata.idx_hint) {
+            job->piece_info = chunk_info;
+            job->buf        = NULL;
+            job->nbytes     = 0;
+            job->buf_alloc  = 0;
+
+            /* Only filter ahead the chunks that H5D__chunk_lock() would read
+             * from the file and pass through the filter pipeline */
+            if (H5_addr_defined(job->udata.chunk_block.offset) &&
+                !((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS) &&
+                  H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->u.chunk.dim,
+                                                   chunk_info->scaled, dset->shared->curr_dims))) {
+                H5_CHECKED_ASSIGN(job->nbytes, size_t, job->udata.chunk_block.length, hsize_t);
+                job->buf_alloc = job->nbytes;
+                if (NULL == (job->buf = H5D__chunk_mem_alloc(job->nbytes, pline)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                                "memory allocation failed for raw data chunk")
+            } /* end if */
+
+            batch->njobs++;
+        } /* end if */
+
+        chunk_node = H5D_CHUNK_GET_NEXT_NODE(dset_info, chunk_node);
+    } /* end while */
+    batch->end = chunk_node;
+
+    /* Read the stored bytes for the chunks to filter */
+    if (H5D__chunk_filter_jobs_read(dset, batch->jobs, batch->njobs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+    /* Run the filter pipeline on all of them */
+    if (H5D__chunk_filter_jobs(pline, H5Z_FLAG_REVERSE, batch->jobs, batch->njobs, batch->nthreads) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+    H5D__chunk_filter_jobs_retry(pline, batch->jobs, batch->njobs);
+    for (u = 0; u < batch->njobs; u++)
+        if (batch->jobs[u].status < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_batch_fill() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_batch_reset
+ *
+ * Purpose:     Releases the chunk buffers in a batch that have not been
+ *              handed to the read loop and empties the batch.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_batch_reset(const H5D_t *dset, H5D_chunk_filter_batch_t *batch)
+{
+    size_t u; /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity check */
+    HDassert(batch);
+
+    for (u = 0; u < batch->njobs; u++)
+        if (batch->jobs[u].buf)
+            batch->jobs[u].buf = H5D__chunk_mem_xfree(batch->jobs[u].buf, batch->jobs[u].nbytes,
+                                                      &(dset->shared->dcpl_cache.pline));
+    batch->njobs = 0;
+    batch->next  = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5D__chunk_filter_batch_reset() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_prefetch
+ *
+ * Purpose:     Reads ahead of the chunks just read from a dataset, once
+ *              the last chunks read have been a constant stride apart in
+ *              linear chunk order.  The next chunks along the stride that
+ *              exist in the file and aren't cached yet are read, passed
+ *              through the filter pipeline (on several threads if the
+ *              application allows it) and added to the chunk cache,
+ *              where the next read finds them.
+ *
+ *              No more chunks are read ahead than the cache can hold
+ *              next to the chunk last read.  Reading ahead stops early
+ *              if the next chunk along the stride is already cached, as
+ *              it was read ahead by an earlier call.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_prefetch(const H5D_io_info_t *io_info, const H5D_dset_io_info_t *dset_info)
+{
+    const H5D_t            *dset   = dset_info->dset;
+    const H5O_layout_t     *layout = &(dset->shared->layout);
+    H5O_pline_t            *pline  = &(dset->shared->dcpl_cache.pline);
+    H5D_rdcc_t             *rdcc   = &(dset->shared->cache.chunk);
+    hsize_t                *chunk_scaled = dset_info->store->chunk.scaled; /* Chunk coordinates to restore */
+    H5D_chunk_filter_job_t *jobs         = NULL; /* Chunks to read ahead */
+    hsize_t                *scaled       = NULL; /* Scaled coordinates of the chunks to read ahead */
+    size_t                  depth;               /* Number of chunks to read ahead */
+    size_t                  njobs = 0;           /* Number of chunks to read ahead */
+    hsize_t                 idx;                 /* Linear index of chunk */
+    size_t                  u;                   /* Local index variable */
+    herr_t                  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(io_info);
+    HDassert(dset_info);
+    HDassert(rdcc->prefetch_stride > 0);
+    HDassert(layout->u.chunk.size > 0);
+
+    /* Leave room in the cache for the chunk last read */
+    depth = rdcc->nbytes_max / layout->u.chunk.size;
+    depth = MIN(rdcc->prefetch_depth, depth > 0 ? depth - 1 : 0);
+    if (depth == 0 || rdcc->nslots == 0)
+        HGOTO_DONE(SUCCEED)
+
+    if (NULL == (jobs = (H5D_chunk_filter_job_t *)H5MM_calloc(depth * sizeof(H5D_chunk_filter_job_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk read-ahead")
+    if (NULL == (scaled = (hsize_t *)H5MM_calloc(depth * H5O_LAYOUT_NDIMS * sizeof(hsize_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk read-ahead")
+
+    /* Look up the chunks along the stride */
+    for (u = 0, idx = rdcc->prefetch_last + rdcc->prefetch_stride; u < depth && idx < layout->u.chunk.nchunks;
+         u++, idx += rdcc->prefetch_stride) {
+        H5D_chunk_filter_job_t *job        = &jobs[njobs];
+        hsize_t                *job_scaled = &scaled[njobs * H5O_LAYOUT_NDIMS];
+
+        if (H5VM_array_calc_pre(idx, dset->shared->ndims, layout->u.chunk.down_chunks, job_scaled) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't compute chunk coordinates")
+        job_scaled[dset->shared->ndims] = 0;
+
+        if (H5D__chunk_lookup(dset, job_scaled, &job->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Stop if the chunks were already read ahead, skip chunks that
+         * are cached or have no storage */
+        if (UINT_MAX != job->udata.idx_hint) {
+            if (u == 0)
+                break;
+            continue;
+        } /* end if */
+        if (!H5_addr_defined(job->udata.chunk_block.offset))
+            continue;
+
+        /* Unfiltered partial edge chunks are read by H5D__chunk_lock() */
+        if (!(pline->nused && (layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS) &&
+              H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->u.chunk.dim, job_scaled,
+                                               dset->shared->curr_dims))) {
+            H5_CHECKED_ASSIGN(job->nbytes, size_t, job->udata.chunk_block.length, hsize_t);
+            job->buf_alloc = job->nbytes;
+            if (NULL == (job->buf = H5D__chunk_mem_alloc(job->nbytes, pline)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        } /* end if */
+
+        njobs++;
+    } /* end for */
+
+    /* Read the stored bytes of the chunks */
+    if (H5D__chunk_filter_jobs_read(dset, jobs, njobs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+    /* Run the filter pipeline on the chunks read */
+    if (pline->nused && njobs > 0) {
+        unsigned nthreads = 1; /* Number of filter threads requested */
+
+        if (H5CX_get_filter_nthreads(&nthreads) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of filter threads")
+        if (H5D__chunk_filter_jobs(pline, H5Z_FLAG_REVERSE, jobs, njobs, nthreads) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+        H5D__chunk_filter_jobs_retry(pline, jobs, njobs);
+        for (u = 0; u < njobs; u++)
+            if (jobs[u].status < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+    } /* end if */
+
+    /* Add the chunks to the cache */
+    for (u = 0; u < njobs; u++) {
+        void *chunk; /* Pointer to locked chunk buffer */
+
+        dset_info->store->chunk.scaled = &scaled[u * H5O_LAYOUT_NDIMS];
+        chunk =
+            H5D__chunk_lock(io_info, dset_info, &jobs[u].udata, FALSE, FALSE, jobs[u].buf, jobs[u].nbytes);
+        jobs[u].buf = NULL;
+        if (NULL == chunk)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+        if (UINT_MAX != jobs[u].udata.idx_hint) {
+            rdcc->slot[jobs[u].udata.idx_hint]->prefetched = TRUE;
+            rdcc->stats.nprefetches++;
+        } /* end if */
+
+        if (H5D__chunk_unlock(io_info, dset_info, &jobs[u].udata, FALSE, chunk, (uint32_t)0) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+    } /* end for */
+
+done:
+    dset_info->store->chunk.scaled = chunk_scaled;
+
+    if (jobs) {
+        for (u = 0; u < njobs; u++)
+            if (jobs[u].buf)
+                jobs[u].buf = H5D__chunk_mem_xfree(jobs[u].buf, jobs[u].nbytes, pline);
+        H5MM_xfree(jobs);
+    } /* end if */
+    H5MM_xfree(scaled);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_prefetch() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_read
+ *
+ * Purpose:    Read from a chunked dataset.
+ *
+ * Return:    Non-negative on success/Negative on failure
+ *
+ * Programmer:    Raymond Lu
+ *        Thursday, April 10, 2003
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
+{
+    H5SL_node_t             *chunk_node;                  /* Current node in chunk skip list */
+    H5D_io_info_t            nonexistent_io_info;         /* "nonexistent" I/O info object */
+    H5D_dset_io_info_t       nonexistent_dset_info;       /* "nonexistent" I/O dset info object */
+    H5D_dset_io_info_t       ctg_dset_info;               /* Contiguous I/O dset info object */
+    H5D_dset_io_info_t       cpt_dset_info;               /* Compact I/O dset info object */
+    uint32_t                 src_accessed_bytes  = 0;     /* Total accessed size in a chunk */
+    hbool_t                  skip_missing_chunks = FALSE; /* Whether to skip missing chunks */
+    H5S_t                  **chunk_mem_spaces    = NULL;  /* Array of chunk memory spaces */
+    H5S_t                   *chunk_mem_spaces_local[8];   /* Local buffer for chunk_mem_spaces */
+    H5S_t                  **chunk_file_spaces = NULL;    /* Array of chunk file spaces */
+    H5S_t                   *chunk_file_spaces_local[8];  /* Local buffer for chunk_file_spaces */
+    haddr_t                 *chunk_addrs = NULL;          /* Array of chunk addresses */
+    haddr_t                  chunk_addrs_local[8];        /* Local buffer for chunk_addrs */
+    H5D_chunk_filter_batch_t filter_batch;                /* Chunks read & filtered ahead of read loop */
+    herr_t                   ret_value = SUCCEED;         /*return value        */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(io_info);
+    HDassert(dset_info);
+    HDassert(dset_info->buf.vp);
+
+    /* Batching is only set up for the non-selection I/O path */
+    HDmemset(&filter_batch, 0, sizeof(filter_batch));
+
+    /* Set up "nonexistent" I/O info object */
+    H5MM_memcpy(&nonexistent_io_info, io_info, sizeof(nonexistent_io_info));
+    H5MM_memcpy(&nonexistent_dset_info, dset_info, sizeof(nonexistent_dset_info));
+    nonexistent_dset_info.layout_ops = *H5D_LOPS_NONEXISTENT;
+    nonexistent_io_info.dsets_info   = &nonexistent_dset_info;
+    nonexistent_io_info.count        = 1;
+
+    {
+        const H5O_fill_t *fill = &(dset_info->dset->shared->dcpl_cache.fill); /* Fill value info */
+        H5D_fill_value_t  fill_status;                                        /* Fill value status */
+
+        /* Check the fill value status */
+        if (H5P_is_fill_value_defined(fill, &fill_status) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+
+        /* If we are never to return fill values, or if we would return them
+         * but they aren't set, set the flag to skip missing chunks.
+         */
+        if (fill->fill_time == H5D_FILL_TIME_NEVER ||
+            (fill->fill_time == H5D_FILL_TIME_IFSET && fill_status != H5D_FILL_VALUE_USER_DEFINED &&
+             fill_status != H5D_FILL_VALUE_DEFAULT))
+            skip_missing_chunks = TRUE;
+    }
+
+    /* Different blocks depending on whether we're using selection I/O */
+    if (io_info->use_select_io == H5D_SELECTION_IO_MODE_ON) {
+        size_t num_chunks       = 0;
+        size_t element_sizes[2] = {dset_info->type_info.src_type_size, 0};
+        void  *bufs[2]          = {dset_info->buf.vp, NULL};
+
+        /* Only create selection I/O arrays if not performing multi dataset I/O,
+         * otherwise the higher level will handle it */
+        if (H5D_LAYOUT_CB_PERFORM_IO(io_info)) {
+            /* Cache number of chunks */
+            num_chunks = H5D_CHUNK_GET_NODE_COUNT(dset_info);
+
+            /* Allocate arrays of dataspaces and offsets for use with selection I/O,
+             * or point to local buffers */
+            HDassert(sizeof(chunk_mem_spaces_local) / sizeof(chunk_mem_spaces_local[0]) ==
+                     sizeof(chunk_file_spaces_local) / sizeof(chunk_file_spaces_local[0]));
+            HDassert(sizeof(chunk_mem_spaces_local) / sizeof(chunk_mem_spaces_local[0]) ==
+                     sizeof(chunk_addrs_local) / sizeof(chunk_addrs_local[0]));
+            if (num_chunks > (sizeof(chunk_mem_spaces_local) / sizeof(chunk_mem_spaces_local[0]))) {
+                if (NULL == (chunk_mem_spaces = H5MM_malloc(num_chunks * sizeof(H5S_t *))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                "memory allocation failed for memory space list")
+                if (NULL == (chunk_file_spaces = H5MM_malloc(num_chunks * sizeof(H5S_t *))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                "memory allocation failed for file space list")
+                if (NULL == (chunk_addrs = H5MM_malloc(num_chunks * sizeof(haddr_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                "memory allocation failed for chunk address list")
+            } /* end if */
+            else {
+                chunk_mem_spaces  = chunk_mem_spaces_local;
+                chunk_file_spaces = chunk_file_spaces_local;
+                chunk_addrs       = chunk_addrs_local;
+            } /* end else */
+
+            /* Reset num_chunks */
+            num_chunks = 0;
+        } /* end if */
+
+        /* Iterate through nodes in chunk skip list */
+        chunk_node = H5D_CHUNK_GET_FIRST_NODE(dset_info);
+        while (chunk_node) {
+            H5D_piece_info_t *chunk_info; /* Chunk information */
+            H5D_chunk_ud_t    udata;      /* Chunk index pass-through    */
+
+            /* Get the actual chunk information from the skip list node */
+            chunk_info = H5D_CHUNK_GET_NODE_INFO(dset_info, chunk_node);
+
+            /* Get the info for the chunk in the file */
+            if (H5D__chunk_lookup_piece(dset_info->dset, chunk_info, &udata) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+            /* There should be no chunks cached */
+            HDassert(UINT_MAX == udata.idx_hint);
+
+            /* Sanity check */
+            HDassert((H5_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length > 0) ||
+                     (!H5_addr_defined(udata.chunk_block.offset) && udata.chunk_block.length == 0));
+
+            /* Check for non-existent chunk & skip it if appropriate */
+            if (H5_addr_defined(udata.chunk_block.offset)) {
                 /* Add chunk to list for selection I/O, if not performing multi dataset I/O */
                 if (H5D_LAYOUT_CB_PERFORM_IO(io_info)) {
                     chunk_mem_spaces[num_chunks]  = chunk_info->mspace;
@@ -2828,11 +3904,17 @@ H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
 #endif /* H5_HAVE_PARALLEL */
     }  /* end if */
     else {
-        H5D_io_info_t ctg_io_info; /* Contiguous I/O info object */
-        H5D_storage_t ctg_store;   /* Chunk storage information as contiguous dataset */
-        H5D_io_info_t cpt_io_info; /* Compact I/O info object */
-        H5D_storage_t cpt_store;   /* Chunk storage information as compact dataset */
-        hbool_t       cpt_dirty;   /* Temporary placeholder for compact storage "dirty" flag */
+        H5D_io_info_t ctg_io_info;        /* Contiguous I/O info object */
+        H5D_storage_t ctg_store;          /* Chunk storage information as contiguous dataset */
+        H5D_io_info_t cpt_io_info;        /* Compact I/O info object */
+        H5D_storage_t cpt_store;          /* Chunk storage information as compact dataset */
+        hbool_t       cpt_dirty;          /* Temporary placeholder for compact storage "dirty" flag */
+        H5D_rdcc_t   *rdcc       = &(dset_info->dset->shared->cache.chunk); /* Dataset's chunk cache */
+        hbool_t       sequential = FALSE; /* Whether the last chunks read were a constant stride apart */
+
+        /* Check if chunks should be filtered in batches on several threads */
+        if (H5D__chunk_filter_batch_init(dset_info, &filter_batch) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't set up chunk filter batches")
 
         /* Set up contiguous I/O info object */
         H5MM_memcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
@@ -2860,15 +3942,26 @@ H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
         /* Iterate through nodes in chunk skip list */
         chunk_node = H5D_CHUNK_GET_FIRST_NODE(dset_info);
         while (chunk_node) {
-            H5D_piece_info_t *chunk_info; /* Chunk information */
-            H5D_chunk_ud_t    udata;      /* Chunk index pass-through    */
-            htri_t            cacheable;  /* Whether the chunk is cacheable */
+            H5D_piece_info_t       *chunk_info; /* Chunk information */
+            H5D_chunk_ud_t          udata;      /* Chunk index pass-through    */
+            htri_t                  cacheable;  /* Whether the chunk is cacheable */
+            H5D_chunk_filter_job_t *job = NULL; /* Chunk's job in the filter batch, if any */
 
             /* Get the actual chunk information from the skip list node */
             chunk_info = H5D_CHUNK_GET_NODE_INFO(dset_info, chunk_node);
 
+            /* Read & filter the next batch of chunks, if batching */
+            if (filter_batch.nthreads > 0 && chunk_node == filter_batch.end)
+                if (H5D__chunk_filter_batch_fill(dset_info, &filter_batch, chunk_node) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read chunk batch")
+
             /* Get the info for the chunk in the file */
-            if (H5D__chunk_lookup(dset_info->dset, chunk_info->scaled, &udata) < 0)
+            if (filter_batch.next < filter_batch.njobs &&
+                filter_batch.jobs[filter_batch.next].piece_info == chunk_info) {
+                job   = &filter_batch.jobs[filter_batch.next++];
+                udata = job->udata;
+            } /* end if */
+            else if (H5D__chunk_lookup_piece(dset_info->dset, chunk_info, &udata) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
             /* Sanity check */
@@ -2891,14 +3984,30 @@ H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
                 if (cacheable) {
                     /* Load the chunk into cache and lock it. */
 
+                    /* Track the stride between the chunks read, for reading ahead */
+                    if (rdcc->prefetch_depth > 0 && chunk_info->index != rdcc->prefetch_last) {
+                        hsize_t stride = chunk_info->index > rdcc->prefetch_last
+                                             ? chunk_info->index - rdcc->prefetch_last
+                                             : 0; /* No stride before the first chunk */
+
+                        sequential            = (stride > 0 && stride == rdcc->prefetch_stride);
+                        rdcc->prefetch_last   = chunk_info->index;
+                        rdcc->prefetch_stride = stride;
+                    } /* end if */
+
                     /* Compute # of bytes accessed in chunk */
                     H5_CHECK_OVERFLOW(dset_info->type_info.src_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
                     H5_CHECK_OVERFLOW(chunk_info->piece_points, /*From:*/ size_t, /*To:*/ uint32_t);
                     src_accessed_bytes =
                         (uint32_t)chunk_info->piece_points * (uint32_t)dset_info->type_info.src_type_size;
 
-                    /* Lock the chunk into the cache */
-                    if (NULL == (chunk = H5D__chunk_lock(io_info, dset_info, &udata, FALSE, FALSE)))
+                    /* Lock the chunk into the cache, handing over the chunk's
+                     * buffer if it was filtered ahead */
+                    chunk = H5D__chunk_lock(io_info, dset_info, &udata, FALSE, FALSE, job ? job->buf : NULL,
+                                            job ? job->nbytes : (size_t)0);
+                    if (job)
+                        job->buf = NULL;
+                    if (NULL == chunk)
                         HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                     /* Set up the storage buffer information for this chunk */
@@ -2936,7 +4045,11 @@ H5D__chunk_read(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
             /* Advance to next chunk in list */
             chunk_node = H5D_CHUNK_GET_NEXT_NODE(dset_info, chunk_node);
         } /* end while */
-    }     /* end else */
+
+        /* Read ahead of the chunks read, if they follow a pattern */
+        if (sequential && H5D__chunk_prefetch(io_info, dset_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read ahead chunks")
+    } /* end else */
 
 done:
     /* Cleanup on failure */
@@ -2949,6 +4062,13 @@ done:
             chunk_addrs = H5MM_xfree(chunk_addrs);
     } /* end if */
 
+    /* Release the chunk filter batch */
+    if (filter_batch.jobs) {
+        if (H5D__chunk_filter_batch_reset(dset_info->dset, &filter_batch) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "can't release chunk filter batch")
+        filter_batch.jobs = H5MM_xfree(filter_batch.jobs);
+    } /* end if */
+
     /* Make sure we cleaned up */
     HDassert(!chunk_mem_spaces || chunk_mem_spaces == chunk_mem_spaces_local);
     HDassert(!chunk_file_spaces || chunk_file_spaces == chunk_file_spaces_local);
@@ -2987,7 +4107,9 @@ H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
     H5S_t             *chunk_file_spaces_local[8]; /* Local buffer for chunk_file_spaces */
     haddr_t           *chunk_addrs = NULL;         /* Array of chunk addresses */
     haddr_t            chunk_addrs_local[8];       /* Local buffer for chunk_addrs */
-    herr_t             ret_value = SUCCEED;        /* Return value        */
+    H5T_vlen_alloc_info_t vl_alloc_info;           /* VL allocation info of the caller */
+    H5T_vlen_arena_t     *vl_arena  = NULL;        /* Arena for VL data stored inline in chunks */
+    herr_t                ret_value = SUCCEED;     /* Return value        */
 
     FUNC_ENTER_PACKAGE
 
@@ -2996,6 +4118,17 @@ H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
     HDassert(dset_info);
     HDassert(dset_info->buf.cvp);
 
+    /* Copy the VL data written to chunks that store it inline to an arena,
+     * which H5D__chunk_unlock() gathers it from as each chunk is done */
+    if (H5Z_filter_in_pline(&dset_info->dset->shared->dcpl_cache.pline, H5Z_FILTER_VLEN) > 0) {
+        if (H5CX_get_vlen_alloc_info(&vl_alloc_info) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to retrieve VL allocation info")
+        if (NULL == (vl_arena = H5T_vlen_arena_create((size_t)H5D_CHUNK_VLEN_ARENA_BLOCK_SIZE)))
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create VL data arena")
+        if (H5CX_set_vlen_alloc_info(H5T_vlen_arena_alloc, vl_arena, H5T_vlen_arena_free, vl_arena) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set VL allocation info")
+    } /* end if */
+
     /* Set up contiguous I/O info object */
     H5MM_memcpy(&ctg_io_info, io_info, sizeof(ctg_io_info));
     HDmemcpy(&ctg_dset_info, dset_info, sizeof(ctg_dset_info));
@@ -3071,7 +4204,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
             chunk_info = H5D_CHUNK_GET_NODE_INFO(dset_info, chunk_node);
 
             /* Get the info for the chunk in the file */
-            if (H5D__chunk_lookup(dset_info->dset, chunk_info->scaled, &udata) < 0)
+            if (H5D__chunk_lookup_piece(dset_info->dset, chunk_info, &udata) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
             /* There should be no chunks cached */
@@ -3107,7 +4240,8 @@ H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
                     entire_chunk = FALSE;
 
                 /* Lock the chunk into the cache */
-                if (NULL == (chunk = H5D__chunk_lock(io_info, dset_info, &udata, entire_chunk, FALSE)))
+                if (NULL == (chunk = H5D__chunk_lock(io_info, dset_info, &udata, entire_chunk, FALSE, NULL,
+                                                     (size_t)0)))
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                 /* Set up the storage buffer information for this chunk */
@@ -3232,7 +4366,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
             chunk_info = H5D_CHUNK_GET_NODE_INFO(dset_info, chunk_node);
 
             /* Look up the chunk */
-            if (H5D__chunk_lookup(dset_info->dset, chunk_info->scaled, &udata) < 0)
+            if (H5D__chunk_lookup_piece(dset_info->dset, chunk_info, &udata) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
 
             /* Sanity check */
@@ -3264,7 +4398,8 @@ H5D__chunk_write(H5D_io_info_t *io_info, H5D_dset_io_info_t *dset_info)
                     entire_chunk = FALSE;
 
                 /* Lock the chunk into the cache */
-                if (NULL == (chunk = H5D__chunk_lock(io_info, dset_info, &udata, entire_chunk, FALSE)))
+                if (NULL == (chunk = H5D__chunk_lock(io_info, dset_info, &udata, entire_chunk, FALSE, NULL,
+                                                     (size_t)0)))
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
 
                 /* Set up the storage buffer information for this chunk */
@@ -3346,6 +4481,16 @@ done:
             chunk_addrs = H5MM_xfree(chunk_addrs);
     } /* end if */
 
+    /* Restore the caller's VL allocation info and release the VL data the
+     * chunks have gathered */
+    if (vl_arena) {
+        if (H5CX_set_vlen_alloc_info(vl_alloc_info.alloc_func, vl_alloc_info.alloc_info,
+                                     vl_alloc_info.free_func, vl_alloc_info.free_info) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't reset VL allocation info")
+        if (H5T_vlen_arena_close(vl_arena) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't close VL data arena")
+    } /* end if */
+
     /* Make sure we cleaned up */
     HDassert(!chunk_mem_spaces || chunk_mem_spaces == chunk_mem_spaces_local);
     HDassert(!chunk_file_spaces || chunk_file_spaces == chunk_file_spaces_local);
@@ -3372,6 +4517,7 @@ H5D__chunk_flush(H5D_t *dset)
 {
     H5D_rdcc_t     *rdcc = &(dset->shared->cache.chunk);
     H5D_rdcc_ent_t *ent, *next;
+    unsigned        nthreads  = 1;       /* Number of filter threads requested */
     unsigned        nerrors   = 0;       /* Count of any errors encountered when flushing chunks */
     herr_t          ret_value = SUCCEED; /* Return value */
 
@@ -3380,12 +4526,31 @@ H5D__chunk_flush(H5D_t *dset)
     /* Sanity check */
     HDassert(dset);
 
-    /* Loop over all entries in the chunk cache */
-    for (ent = rdcc->head; ent; ent = next) {
-        next = ent->next;
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+    if (dset->shared->dcpl_cache.pline.nused && H5CX_get_filter_nthreads(&nthreads) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of filter threads")
+
+    /* Flush the dirty chunks in batches, if they should be filtered on several threads */
+    if (dset->shared->dcpl_cache.pline.nused && nthreads > 1 && rdcc->nused > 1) {
+        H5D_rdcc_ent_t **ents;      /* Entries in the chunk cache */
+        size_t           nents = 0; /* Number of entries in the chunk cache */
+
+        if (NULL == (ents = (H5D_rdcc_ent_t **)H5MM_malloc((size_t)rdcc->nused * sizeof(H5D_rdcc_ent_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk cache entries")
+        for (ent = rdcc->head; ent; ent = ent->next)
+            ents[nents++] = ent;
+        HDassert(nents == (size_t)rdcc->nused);
+
+        if (H5D__chunk_flush_entries(dset, ents, nents, FALSE, nthreads) < 0)
             nerrors++;
-    } /* end for */
+        H5MM_xfree(ents);
+    } /* end if */
+    else
+        /* Loop over all entries in the chunk cache */
+        for (ent = rdcc->head; ent; ent = next) {
+            next = ent->next;
+            if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
+                nerrors++;
+        } /* end for */
     if (nerrors)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
 
@@ -3498,6 +4663,16 @@ H5D__chunk_dest(H5D_t *dset)
     /* Release cache structures */
     if (rdcc->slot)
         rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    if (rdcc->file && 0 == --rdcc->file->nrefs) {
+        HDassert(NULL == rdcc->file->head);
+        H5F_SET_RDCC_FILE(dset->oloc.file, NULL);
+        rdcc->file = H5FL_FREE(H5D_rdcc_file_t, rdcc->file);
+    } /* end if */
+    if (rdcc->owner) {
+        if (H5O_loc_free(&rdcc->owner->oloc) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release file")
+        rdcc->owner = (H5D_t *)H5MM_xfree(rdcc->owner);
+    } /* end if */
     HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
 
     /* Compose chunked index info struct */
@@ -3714,9 +4889,12 @@ done:
  * Function:    H5D__chunk_hash_val
  *
  * Purpose:     To calculate an index based on the dataset's scaled
- *              coordinates and sizes of the faster dimensions.
+ *              coordinates and sizes of the faster dimensions.  The bits
+ *              of the value are mixed before it is reduced to a set of the
+ *              hash table, so that strided access patterns spread over all
+ *              of the sets whatever their number.
  *
- * Return:    Hash value index
+ * Return:    Index of the first slot of the chunk's set in the hash table
  *
  * Programmer:    Vailin Choi; Nov 2014
  *
@@ -3745,12 +4923,223 @@ H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
         val ^= scaled[u];
     } /* end for */
 
-    /* Modulo value against the number of array slots */
-    ret = (unsigned)(val % shared->cache.chunk.nslots);
+    /* Mix the bits (the 64-bit finalizer from MurmurHash3) */
+    val ^= val >> 33;
+    val *= (hsize_t)0xff51afd7ed558ccdULL;
+    val ^= val >> 33;
+    val *= (hsize_t)0xc4ceb9fe1a85ec53ULL;
+    val ^= val >> 33;
+
+    /* Modulo value against the number of sets */
+    ret = (unsigned)((val % shared->cache.chunk.nsets) * H5D_CHUNK_CACHE_NWAYS);
 
     FUNC_LEAVE_NOAPI(ret)
 } /* H5D__chunk_hash_val() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_find
+ *
+ * Purpose:     Looks for a chunk in the slots of its set in the chunk
+ *              cache's hash table.
+ *
+ * Return:      Index of the chunk's slot, or UINT_MAX if the chunk is not
+ *              in the cache
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_find(const H5D_shared_t *shared, const hsize_t *scaled)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk); /* Chunk cache */
+    unsigned          first;                         /* First slot of the chunk's set */
+    unsigned          u, v;                          /* Local index variables */
+    unsigned          ret_value = UINT_MAX;          /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Sanity checks */
+    HDassert(rdcc->nslots > 0);
+    HDassert(scaled);
+
+    first = H5D__chunk_hash_val(shared, scaled);
+    for (u = first; u < first + H5D_CHUNK_CACHE_NWAYS; u++) {
+        const H5D_rdcc_ent_t *ent = rdcc->slot[u];
+
+        if (ent) {
+            /* Verify that the cache entry is the correct chunk */
+            for (v = 0; v < shared->ndims; v++)
+                if (scaled[v] != ent->scaled[v])
+                    break;
+            if (v == shared->ndims) {
+                ret_value = u;
+                break;
+            } /* end if */
+        }     /* end if */
+    }         /* end for */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_find() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_hint
+ *
+ * Purpose:     Checks that IDX_HINT, the index of a chunk's slot in the
+ *              chunk cache's hash table, still refers to the chunk.  The
+ *              hash table may have grown since the index was looked up,
+ *              moving the chunk to another slot, so it is looked up again
+ *              if it doesn't.
+ *
+ * Return:      Index of the chunk's slot, or UINT_MAX if the chunk is not
+ *              in the cache
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5D__chunk_cache_hint(const H5D_shared_t *shared, const hsize_t *scaled, unsigned idx_hint)
+{
+    const H5D_rdcc_t *rdcc = &(shared->cache.chunk); /* Chunk cache */
+    unsigned          u;                             /* Local index variable */
+    unsigned          ret_value = idx_hint;          /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (UINT_MAX != idx_hint) {
+        const H5D_rdcc_ent_t *ent = NULL; /* Entry in the hinted slot */
+
+        if (idx_hint < rdcc->nsets * H5D_CHUNK_CACHE_NWAYS)
+            ent = rdcc->slot[idx_hint];
+        if (ent)
+            for (u = 0; u < shared->ndims; u++)
+                if (scaled[u] != ent->scaled[u])
+                    break;
+        if (NULL == ent || u < shared->ndims)
+            ret_value = H5D__chunk_cache_find(shared, scaled);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_hint() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_slot
+ *
+ * Purpose:     Finds a free slot for a chunk in its set of the chunk
+ *              cache's hash table.  If all the slots of the set are in
+ *              use, the hash table is grown if it is at least half full,
+ *              otherwise the least recently used entry of the set that
+ *              isn't locked is evicted to make room.
+ *
+ *              *IDX is set to UINT_MAX if every entry of the set is
+ *              locked.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_slot(const H5D_t *dset, const hsize_t *scaled, unsigned *idx)
+{
+    const H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk); /* Chunk cache */
+    H5D_rdcc_ent_t   *ent;                                  /* Cache entry */
+    unsigned          first;                                /* First slot of the chunk's set */
+    unsigned          u;                                    /* Local index variable */
+    herr_t            ret_value = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(rdcc->nslots > 0);
+    HDassert(!rdcc->tmp_head);
+    HDassert(idx);
+
+    /* Look for a free slot in the set */
+    first = H5D__chunk_hash_val(dset->shared, scaled);
+    for (u = first; u < first + H5D_CHUNK_CACHE_NWAYS; u++)
+        if (NULL == rdcc->slot[u]) {
+            *idx = u;
+            HGOTO_DONE(SUCCEED)
+        } /* end if */
+
+    /* Grow the hash table instead of evicting, if there's room for it to */
+    if (2 * rdcc->nsets <= rdcc->nsets_max &&
+        (size_t)rdcc->nused >= (rdcc->nsets * H5D_CHUNK_CACHE_NWAYS) / 2) {
+        if (H5D__chunk_cache_grow(dset) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTRESIZE, FAIL, "unable to grow chunk cache hash table")
+
+        /* Look again, as the set's entries have been spread over two sets */
+        first = H5D__chunk_hash_val(dset->shared, scaled);
+        for (u = first; u < first + H5D_CHUNK_CACHE_NWAYS; u++)
+            if (NULL == rdcc->slot[u]) {
+                *idx = u;
+                HGOTO_DONE(SUCCEED)
+            } /* end if */
+    }     /* end if */
+
+    /* Find the least recently used entry of the set */
+    ent = NULL;
+    for (u = first; u < first + H5D_CHUNK_CACHE_NWAYS; u++)
+        if (!rdcc->slot[u]->locked && (NULL == ent || rdcc->slot[u]->last_use < ent->last_use))
+            ent = rdcc->slot[u];
+    if (NULL == ent) {
+        *idx = UINT_MAX;
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    *idx = ent->idx;
+    if (H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "unable to preempt chunk from cache")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_slot() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_grow
+ *
+ * Purpose:     Doubles the number of sets in the chunk cache's hash table
+ *              and moves the cached chunks to their new sets.
+ *
+ *              Since the number of sets doubles, the chunks of a set are
+ *              split between two sets and always fit in them.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_grow(const H5D_t *dset)
+{
+    H5D_rdcc_t      *rdcc = &(dset->shared->cache.chunk); /* Chunk cache */
+    H5D_rdcc_ent_t **slot;                                 /* New hash table */
+    H5D_rdcc_ent_t  *ent;                                  /* Cache entry */
+    herr_t           ret_value = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(2 * rdcc->nsets <= rdcc->nsets_max);
+    HDassert(!rdcc->tmp_head);
+
+    if (NULL == (slot = H5FL_SEQ_CALLOC(H5D_rdcc_ent_ptr_t, 2 * rdcc->nsets * H5D_CHUNK_CACHE_NWAYS)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    rdcc->slot  = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    rdcc->slot  = slot;
+    rdcc->nsets = 2 * rdcc->nsets;
+
+    /* Move the entries to their new sets */
+    for (ent = rdcc->head; ent; ent = ent->next) {
+        unsigned first = H5D__chunk_hash_val(dset->shared, ent->scaled); /* First slot of the set */
+        unsigned u;                                                      /* Local index variable */
+
+        for (u = first; rdcc->slot[u]; u++)
+            HDassert(u + 1 < first + H5D_CHUNK_CACHE_NWAYS);
+        rdcc->slot[u] = ent;
+        ent->idx      = u;
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_grow() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_lookup
  *
@@ -3799,26 +5188,11 @@ H5D__chunk_lookup(const H5D_t *dset, const hsize_t *scaled, H5D_chunk_ud_t *udat
     udata->new_unfilt_chunk   = FALSE;
 
     /* Check for chunk in cache */
-    if (dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-        idx = H5D__chunk_hash_val(dset->shared, scaled);
-
-        /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if (ent) {
-            unsigned u; /* Counter */
-
-            /* Speculatively set the 'found' flag */
+    if (dset->shared->cache.chunk.nslots > 0)
+        if (UINT_MAX != (idx = H5D__chunk_cache_find(dset->shared, scaled))) {
+            ent   = dset->shared->cache.chunk.slot[idx];
             found = TRUE;
-
-            /* Verify that the cache entry is the correct chunk */
-            for (u = 0; u < dset->shared->ndims; u++)
-                if (scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
-                    break;
-                } /* end if */
-        }         /* end if */
-    }             /* end if */
+        } /* end if */
 
     /* Retrieve chunk addr */
     if (found) {
@@ -3891,17 +5265,191 @@ H5D__chunk_lookup(const H5D_t *dset, const hsize_t *scaled, H5D_chunk_ud_t *udat
 #endif
                 H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, udata);
         } /* end if */
-    }     /* end else */
+    }     /* end else */
+
+done:
+#ifdef H5_HAVE_PARALLEL
+    /* Re-enable collective metadata reads if we disabled them */
+    if (restore_md_reads_state)
+        H5F_set_coll_metadata_reads(dset->oloc.file, &md_reads_file_flag, &md_reads_context_flag);
+#endif /* H5_HAVE_PARALLEL */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_lookup() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_lookup_batch
+ *
+ * Purpose:     Finds the addresses of the chunks selected for an I/O
+ *              operation in one ordered pass over the chunk index, when
+ *              the selection covers enough of the dataset's chunks for
+ *              that to be cheaper than looking each of them up from the
+ *              root of the index.  The chunks found are marked in their
+ *              piece info, which H5D__chunk_lookup_piece() then uses.
+ *
+ *              Only v1 and v2 B-tree indexes are handled this way: the
+ *              other indexes find a chunk's entry directly from its
+ *              index, and iterating over them costs as much as looking
+ *              up every chunk in the dataset.
+ *
+ *              Chunks that are in the chunk cache when the index is
+ *              walked are left to H5D__chunk_lookup(), since their
+ *              entries in the index may change when they are flushed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_lookup_batch(const H5D_io_info_t H5_ATTR_PARALLEL_USED *io_info, const H5D_dset_io_info_t *dinfo)
+{
+    const H5D_t         *dset = dinfo->dset;
+    H5O_storage_chunk_t *sc   = &(dset->shared->layout.storage.u.chunk);
+    H5D_chk_idx_info_t   idx_info;            /* Chunked index info */
+    H5D_chunk_it_ud6_t   udata;               /* User data for iteration callback */
+    H5SL_node_t         *piece_node;          /* Current node in chunk skip list */
+    size_t               nsel;                /* Number of chunks selected */
+    herr_t               ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dinfo);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+
+    /* Check if the selection is worth a pass over the index */
+    if (sc->idx_type != H5D_CHUNK_IDX_BTREE && sc->idx_type != H5D_CHUNK_IDX_BT2)
+        HGOTO_DONE(SUCCEED)
+    nsel = H5D_CHUNK_GET_NODE_COUNT(dinfo);
+    if (nsel < H5D_CHUNK_LOOKUP_BATCH_MIN ||
+        (hsize_t)nsel * H5D_CHUNK_LOOKUP_BATCH_RATIO < dset->shared->layout.u.chunk.nchunks)
+        HGOTO_DONE(SUCCEED)
+    if (!(sc->ops->is_space_alloc)(sc))
+        HGOTO_DONE(SUCCEED)
+#ifdef H5_HAVE_PARALLEL
+    /* Chunks are looked up separately for parallel I/O */
+    if (io_info->using_mpi_vfd)
+        HGOTO_DONE(SUCCEED)
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Mark the chunks that aren't cached as not allocated, until the
+     * index says otherwise */
+    udata.layout     = &dset->shared->layout.u.chunk;
+    udata.sel_pieces = dinfo->layout_io_info.chunk_map->dset_sel_pieces;
+    udata.nleft      = 0;
+    piece_node       = H5D_CHUNK_GET_FIRST_NODE(dinfo);
+    while (piece_node) {
+        H5D_piece_info_t *piece_info = H5D_CHUNK_GET_NODE_INFO(dinfo, piece_node);
+
+        piece_info->index_valid = dset->shared->cache.chunk.nslots == 0 ||
+                                  UINT_MAX == H5D__chunk_cache_find(dset->shared, piece_info->scaled);
+        if (piece_info->index_valid) {
+            piece_info->faddr       = HADDR_UNDEF;
+            piece_info->nbytes      = 0;
+            piece_info->filter_mask = 0;
+            udata.nleft++;
+        } /* end if */
+
+        piece_node = H5D_CHUNK_GET_NEXT_NODE(dinfo, piece_node);
+    } /* end while */
+
+    /* Compose chunked index info struct */
+    idx_info.f       = dset->oloc.file;
+    idx_info.pline   = &dset->shared->dcpl_cache.pline;
+    idx_info.layout  = &dset->shared->layout.u.chunk;
+    idx_info.storage = sc;
+
+    /* Walk the index in order, picking out the selected chunks */
+    if (udata.nleft > 0 && (sc->ops->iterate)(&idx_info, H5D__chunk_lookup_batch_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to iterate over chunk index")
 
 done:
-#ifdef H5_HAVE_PARALLEL
-    /* Re-enable collective metadata reads if we disabled them */
-    if (restore_md_reads_state)
-        H5F_set_coll_metadata_reads(dset->oloc.file, &md_reads_file_flag, &md_reads_context_flag);
-#endif /* H5_HAVE_PARALLEL */
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_lookup_batch() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_lookup_batch_cb
+ *
+ * Purpose:     Records the address of a chunk in the index in its piece
+ *              info, if the chunk is selected for I/O.  Stops the
+ *              iteration once all the selected chunks have been found.
+ *
+ * Return:      H5_ITER_CONT or H5_ITER_STOP
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_lookup_batch_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_chunk_it_ud6_t *udata = (H5D_chunk_it_ud6_t *)_udata; /* User data for callback */
+    unsigned            ndims = udata->layout->ndims - 1;     /* # of dimensions of dataset */
+    H5D_piece_info_t   *piece_info;                           /* Selected chunk */
+    hsize_t             chunk_index;                          /* Index of chunk in dataset */
+    unsigned            u;                                    /* Local index variable */
+    int                 ret_value = H5_ITER_CONT;             /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Skip chunks outside the dataset's current extent */
+    for (u = 0; u < ndims; u++)
+        if (chunk_rec->scaled[u] >= udata->layout->chunks[u])
+            HGOTO_DONE(H5_ITER_CONT)
+
+    chunk_index = H5VM_array_offset_pre(ndims, udata->layout->down_chunks, chunk_rec->scaled);
+    if (NULL != (piece_info = (H5D_piece_info_t *)H5SL_search(udata->sel_pieces, &chunk_index)) &&
+        piece_info->index_valid) {
+        piece_info->faddr       = chunk_rec->chunk_addr;
+        piece_info->nbytes      = chunk_rec->nbytes;
+        piece_info->filter_mask = chunk_rec->filter_mask;
+        if (--udata->nleft == 0)
+            HGOTO_DONE(H5_ITER_STOP)
+    } /* end if */
 
+done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* H5D__chunk_lookup() */
+} /* end H5D__chunk_lookup_batch_cb() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_lookup_piece
+ *
+ * Purpose:     Looks up a chunk selected for I/O like H5D__chunk_lookup(),
+ *              using the address found by H5D__chunk_lookup_batch() if
+ *              the chunk is not in the cache.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_lookup_piece(const H5D_t *dset, const H5D_piece_info_t *piece_info, H5D_chunk_ud_t *udata)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(piece_info);
+    HDassert(udata);
+
+    if (piece_info->index_valid && (dset->shared->cache.chunk.nslots == 0 ||
+                                    UINT_MAX == H5D__chunk_cache_find(dset->shared, piece_info->scaled))) {
+        udata->common.layout      = &(dset->shared->layout.u.chunk);
+        udata->common.storage     = &(dset->shared->layout.storage.u.chunk);
+        udata->common.scaled      = piece_info->scaled;
+        udata->idx_hint           = UINT_MAX;
+        udata->chunk_block.offset = piece_info->faddr;
+        udata->chunk_block.length = piece_info->nbytes;
+        udata->filter_mask        = piece_info->filter_mask;
+        udata->new_unfilt_chunk   = FALSE;
+        udata->chunk_idx          = 0;
+    } /* end if */
+    else if (H5D__chunk_lookup(dset, piece_info->scaled, udata) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_lookup_piece() */
 
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_flush_entry
@@ -3911,6 +5459,11 @@ done:
  *        the RESET flag is turned on because it results in one fewer
  *        memory copy.
  *
+ *        If JOB is not NULL, the chunk has already been run through
+ *        the filter pipeline along with other chunks (see
+ *        H5D__chunk_flush_entries()) and the filtered buffer in JOB is
+ *        written instead.  This routine takes ownership of that buffer.
+ *
  * Return:    Non-negative on success/Negative on failure
  *
  * Programmer:    Robb Matzke
@@ -3919,9 +5472,10 @@ done:
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
+H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset, H5D_chunk_filter_job_t *job)
 {
     void                *buf                = NULL; /* Temporary buffer        */
+    size_t               nbytes             = 0;    /* Bytes known to be in BUF */
     hbool_t              point_of_no_return = FALSE;
     H5O_storage_chunk_t *sc                 = &(dset->shared->layout.storage.u.chunk);
     herr_t               ret_value          = SUCCEED; /* Return value            */
@@ -3933,6 +5487,7 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
     H5D_CHUNK_STORAGE_INDEX_CHK(sc);
     HDassert(ent);
     HDassert(!ent->locked);
+    HDassert(!job || (ent->dirty && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)));
 
     buf = ent->chunk;
     if (ent->dirty) {
@@ -3954,40 +5509,54 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
         if (dset->shared->dcpl_cache.pline.nused && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
             H5Z_EDC_t err_detect;                       /* Error detection info */
             H5Z_cb_t  filter_cb;                        /* I/O filter callback function */
-            size_t    alloc = udata.chunk_block.length; /* Bytes allocated for BUF    */
-            size_t    nbytes;                           /* Chunk size (in bytes) */
-
-            /* Retrieve filter settings from API context */
-            if (H5CX_get_err_detect(&err_detect) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
-            if (H5CX_get_filter_cb(&filter_cb) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
-
-            if (!reset) {
-                /*
-                 * Copy the chunk to a new buffer before running it through
-                 * the pipeline because we'll want to save the original buffer
-                 * for later.
-                 */
-                if (NULL == (buf = H5MM_malloc(alloc)))
-                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                H5MM_memcpy(buf, ent->chunk, alloc);
+            size_t    alloc = ent->buf_size;            /* Bytes allocated for BUF    */
+
+            if (job) {
+                /* The chunk has already been through the pipeline.  When
+                 * resetting, the entry's buffer may have been handed over
+                 * to it. */
+                buf                = job->buf;
+                nbytes             = job->nbytes;
+                job->buf           = NULL;
+                point_of_no_return = reset && !ent->chunk;
+                if (job->status < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
+                udata.filter_mask = job->udata.filter_mask;
             } /* end if */
             else {
-                /*
-                 * If we are resetting and something goes wrong after this
-                 * point then it's too late to recover because we may have
-                 * destroyed the original data by calling H5Z_pipeline().
-                 * The only safe option is to continue with the reset
-                 * even if we can't write the data to disk.
-                 */
-                point_of_no_return = TRUE;
-                ent->chunk         = NULL;
+                /* Retrieve filter settings from API context */
+                if (H5CX_get_err_detect(&err_detect) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+                if (H5CX_get_filter_cb(&filter_cb) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+                if (!reset) {
+                    /*
+                     * Copy the chunk to a new buffer before running it through
+                     * the pipeline because we'll want to save the original buffer
+                     * for later.
+                     */
+                    if (NULL == (buf = H5Z_buf_malloc(alloc)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                                    "memory allocation failed for pipeline")
+                    H5MM_memcpy(buf, ent->chunk, alloc);
+                } /* end if */
+                else {
+                    /*
+                     * If we are resetting and something goes wrong after this
+                     * point then it's too late to recover because we may have
+                     * destroyed the original data by calling H5Z_pipeline().
+                     * The only safe option is to continue with the reset
+                     * even if we can't write the data to disk.
+                     */
+                    point_of_no_return = TRUE;
+                    ent->chunk         = NULL;
+                } /* end else */
+                nbytes = ent->buf_size;
+                if (H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), err_detect,
+                                 filter_cb, &nbytes, &alloc, &buf) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
             } /* end else */
-            H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
-            if (H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask), err_detect,
-                             filter_cb, &nbytes, &alloc, &buf) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
 #if H5_SIZEOF_SIZE_T > 4
             /* Check for the chunk expanding too much to encode in a 32-bit value */
             if (nbytes > ((size_t)0xffffffff))
@@ -4069,16 +5638,16 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
         if (buf == ent->chunk)
             buf = NULL;
         if (ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                                                         ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)
-                                                              ? NULL
-                                                              : &(dset->shared->dcpl_cache.pline)));
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(
+                ent->chunk, ent->buf_size,
+                ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                                                                     : &(dset->shared->dcpl_cache.pline)));
     } /* end if */
 
 done:
     /* Free the temp buffer only if it's different than the entry chunk */
     if (buf != ent->chunk)
-        H5MM_xfree(buf);
+        H5Z_buf_free(buf, nbytes);
 
     /*
      * If we reached the point of no return then we have no choice but to
@@ -4088,14 +5657,135 @@ done:
      */
     if (ret_value < 0 && point_of_no_return)
         if (ent->chunk)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                                                         ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)
-                                                              ? NULL
-                                                              : &(dset->shared->dcpl_cache.pline)));
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(
+                ent->chunk, ent->buf_size,
+                ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                                                                     : &(dset->shared->dcpl_cache.pline)));
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_flush_entry() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_flush_entries
+ *
+ * Purpose:     Flushes the cache entries in ENTS, in order, evicting them
+ *              from the cache as well if EVICT is TRUE.
+ *
+ *              When NTHREADS is more than one, the dirty entries that
+ *              must be filtered are gathered in batches and
+ *              their pipelines are run at the same time.  File space is
+ *              still allocated and the chunks are written one at a time,
+ *              in the order of the batch.
+ *
+ *              Entries that fail to flush are counted, and the others are
+ *              flushed anyway.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_entries(const H5D_t *dset, H5D_rdcc_ent_t **ents, size_t nents, hbool_t evict,
+                         unsigned nthreads)
+{
+    const H5O_pline_t      *pline     = &(dset->shared->dcpl_cache.pline);
+    H5D_chunk_filter_job_t *jobs      = NULL;    /* Filter jobs for the batch */
+    H5D_rdcc_ent_t        **batch     = NULL;    /* Entries in the batch */
+    size_t                  max_jobs  = 0;       /* Maximum number of entries in a batch */
+    size_t                  njobs     = 0;       /* Number of entries in the batch */
+    unsigned                nerrors   = 0;       /* Count of any errors encountered when flushing chunks */
+    hbool_t                 hand_over = evict;   /* Whether the chunks are handed to the pipeline */
+    size_t                  u, v;                /* Local index variables */
+    herr_t                  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(ents || nents == 0);
+
+    /* Set up batches, if dirty chunks should be filtered on several threads */
+    if (pline->nused && nthreads > 1 && nents > 1) {
+        H5Z_cb_t filter_cb; /* I/O filter callback function */
+
+        /* Chunks that fail on a worker thread are filtered again with the
+         * application's filter callback, so they can't be handed over */
+        if (H5CX_get_filter_cb(&filter_cb) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+        if (filter_cb.func)
+            hand_over = FALSE;
+
+        max_jobs = MIN((size_t)nthreads * H5D_CHUNK_FILTER_BATCH_FACTOR, nents);
+        if (NULL == (jobs = (H5D_chunk_filter_job_t *)H5MM_malloc(max_jobs * sizeof(H5D_chunk_filter_job_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk filter jobs")
+        if (NULL == (batch = (H5D_rdcc_ent_t **)H5MM_malloc(max_jobs * sizeof(H5D_rdcc_ent_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk batch")
+    } /* end if */
+
+    for (u = 0; u < nents; u++) {
+        H5D_rdcc_ent_t *ent = ents[u];
+
+        /* Defer the dirty entries that must be filtered to the batch */
+        if (jobs && ent->dirty && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS))
+            batch[njobs++] = ent;
+        else if (evict) {
+            if (H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+                nerrors++;
+        } /* end else-if */
+        else if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
+            nerrors++;
+
+        /* Flush the batch when it's full, or when there are no more entries */
+        if (njobs > 0 && (njobs == max_jobs || u + 1 == nents)) {
+            /* Hand the chunks to the pipeline, copying them unless they are being evicted */
+            for (v = 0; v < njobs; v++) {
+                H5D_chunk_filter_job_t *job = &jobs[v];
+
+                job->nbytes            = batch[v]->buf_size;
+                job->buf_alloc         = job->nbytes;
+                job->udata.filter_mask = 0;
+                if (hand_over) {
+                    job->buf        = batch[v]->chunk;
+                    batch[v]->chunk = NULL;
+                } /* end if */
+                else if (NULL != (job->buf = H5Z_buf_malloc(job->nbytes)))
+                    H5MM_memcpy(job->buf, batch[v]->chunk, job->nbytes);
+            } /* end for */
+
+            /* Run the filter pipelines.  If that can't start, give the chunks
+             * back so they are filtered one at a time below */
+            if (H5D__chunk_filter_jobs(pline, 0, jobs, njobs, nthreads) < 0)
+                for (v = 0; v < njobs; v++) {
+                    if (hand_over)
+                        batch[v]->chunk = (uint8_t *)jobs[v].buf;
+                    else
+                        H5Z_buf_free(jobs[v].buf, jobs[v].nbytes);
+                    jobs[v].buf = NULL;
+                } /* end for */
+            else
+                H5D__chunk_filter_jobs_retry(pline, jobs, njobs);
+
+            /* Allocate file space for the chunks and write them, in order */
+            for (v = 0; v < njobs; v++) {
+                if (H5D__chunk_flush_entry(dset, batch[v], evict, jobs[v].buf ? &jobs[v] : NULL) < 0)
+                    nerrors++;
+                if (evict && H5D__chunk_cache_evict(dset, batch[v], FALSE) < 0)
+                    nerrors++;
+            } /* end for */
+            njobs = 0;
+        } /* end if */
+    }     /* end for */
+
+    if (nerrors)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+done:
+    H5MM_xfree(batch);
+    H5MM_xfree(jobs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_entries() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_cache_evict
  *
@@ -4121,20 +5811,24 @@ H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush)
     HDassert(dset);
     HDassert(ent);
     HDassert(!ent->locked);
-    HDassert(ent->idx < rdcc->nslots);
+    HDassert(ent->idx < rdcc->nsets * H5D_CHUNK_CACHE_NWAYS);
+
+    /* Count chunks read ahead for nothing */
+    if (ent->prefetched)
+        rdcc->stats.nprefetch_wasted++;
 
     if (flush) {
         /* Flush */
-        if (H5D__chunk_flush_entry(dset, ent, TRUE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, TRUE, NULL) < 0)
             HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
     } /* end if */
     else {
         /* Don't flush, just free chunk */
         if (ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                                                         ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)
-                                                              ? NULL
-                                                              : &(dset->shared->dcpl_cache.pline)));
+            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(
+                ent->chunk, ent->buf_size,
+                ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                                                                     : &(dset->shared->dcpl_cache.pline)));
     } /* end else */
 
     /* Unlink from list */
@@ -4148,6 +5842,20 @@ H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush)
         rdcc->tail = ent->prev;
     ent->prev = ent->next = NULL;
 
+    /* Unlink from the file's list */
+    if (rdcc->file) {
+        if (ent->file_prev)
+            ent->file_prev->file_next = ent->file_next;
+        else
+            rdcc->file->head = ent->file_next;
+        if (ent->file_next)
+            ent->file_next->file_prev = ent->file_prev;
+        else
+            rdcc->file->tail = ent->file_prev;
+        ent->file_prev = ent->file_next = NULL;
+        rdcc->file->nbytes_used -= ent->buf_size;
+    } /* end if */
+
     /* Unlink from temporary list */
     if (ent->tmp_prev) {
         HDassert(rdcc->tmp_head->tmp_next);
@@ -4166,7 +5874,7 @@ H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush)
     /* Remove from cache */
     HDassert(rdcc->slot[ent->idx] != ent);
     ent->idx = UINT_MAX;
-    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
+    rdcc->nbytes_used -= ent->buf_size;
     --rdcc->nused;
 
     /* Free */
@@ -4182,6 +5890,12 @@ H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush)
  *        room for something which is SIZE bytes.  Only unlocked
  *        entries are considered for preemption.
  *
+ *        When dirty chunks should be filtered on several threads, room
+ *        is made for as many chunks as there are threads, so there is
+ *        a batch of chunks to filter together.  The entries to preempt
+ *        are chosen first (and locked meanwhile, so they aren't chosen
+ *        twice), then evicted together with H5D__chunk_flush_entries().
+ *
  * Return:    Non-negative on success/Negative on failure
  *
  * Programmer:    Robb Matzke
@@ -4198,11 +5912,27 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
     int               w[1];                /* Weighting as an interval */
     H5D_rdcc_ent_t   *p[2], *cur;          /* List pointers */
     H5D_rdcc_ent_t   *n[2];                /* List next pointers */
+    H5D_rdcc_ent_t  **victims  = NULL;     /* Entries chosen for preemption, when batching */
+    size_t            nvictims = 0;        /* Number of entries chosen for preemption */
+    size_t            pending  = 0;        /* Bytes of entries chosen for preemption */
+    unsigned          nthreads = 1;        /* Number of filter threads requested */
     int               nerrors   = 0;       /* Accumulated error count during preemptions */
     herr_t            ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_PACKAGE
 
+    if (dset->shared->dcpl_cache.pline.nused && H5CX_get_filter_nthreads(&nthreads) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of filter threads")
+
+    /* Choose all the entries to preempt before evicting any of them, if
+     * dirty chunks should be filtered on several threads */
+    if (dset->shared->dcpl_cache.pline.nused && nthreads > 1 && rdcc->nused > 1)
+        if (NULL ==
+            (victims = (H5D_rdcc_ent_t **)H5MM_malloc((size_t)rdcc->nused * sizeof(H5D_rdcc_ent_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for chunk cache entries")
+    if (victims && size < total / nthreads)
+        size *= nthreads;
+
     /*
      * Preemption is accomplished by having multiple pointers (currently two)
      * slide down the list beginning at the head. Pointer p(N+1) will start
@@ -4217,7 +5947,7 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
     p[0] = rdcc->head;
     p[1] = NULL;
 
-    while ((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
+    while ((p[0] || p[1]) && (rdcc->nbytes_used - pending + size) > total) {
         int i; /* Local index variable */
 
         /* Introduce new pointers */
@@ -4230,7 +5960,7 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
             n[i] = p[i] ? p[i]->next : NULL;
 
         /* Give each method a chance */
-        for (i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
+        for (i = 0; i < nmeth && (rdcc->nbytes_used - pending + size) > total; i++) {
             if (0 == i && p[0] && !p[0]->locked &&
                 ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
                  (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
@@ -4264,7 +5994,12 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
                     if (n[j] == cur)
                         n[j] = cur->next;
                 } /* end for */
-                if (H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
+                if (victims) {
+                    cur->locked         = TRUE;
+                    victims[nvictims++] = cur;
+                    pending += cur->buf_size;
+                } /* end if */
+                else if (H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
                     nerrors++;
             } /* end if */
         }     /* end for */
@@ -4276,13 +6011,142 @@ H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
             w[i] -= 1;
     } /* end while */
 
+    /* Evict the chosen entries */
+    if (victims) {
+        size_t u; /* Local index variable */
+
+        for (u = 0; u < nvictims; u++)
+            victims[u]->locked = FALSE;
+        if (H5D__chunk_flush_entries(dset, victims, nvictims, TRUE, nthreads) < 0)
+            nerrors++;
+    } /* end if */
+
     if (nerrors)
         HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
 
 done:
+    H5MM_xfree(victims);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_cache_prune() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_file_cache_prune
+ *
+ * Purpose:     Prune the chunk cache shared by the datasets of the file
+ *              by preempting the least recently used chunks of the file,
+ *              whichever dataset they belong to, until it has room for
+ *              something which is SIZE bytes.  Only unlocked entries are
+ *              considered for preemption.
+ *
+ *              Locked entries are in use, so they are moved to the most
+ *              recently used end of the file's list as they are passed.
+ *              Only the entries preempted and the locked ones before them
+ *              are visited.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_file_cache_prune(const H5D_t *dset, size_t size)
+{
+    H5D_rdcc_file_t *file_cache = dset->shared->cache.chunk.file; /* File-wide chunk cache */
+    H5D_rdcc_ent_t  *ent, *next;                                   /* Cache entries */
+    H5D_rdcc_ent_t  *last;                                         /* Last entry to consider */
+    int              nerrors   = 0;                                /* Accumulated error count */
+    herr_t           ret_value = SUCCEED;                          /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(file_cache);
+
+    /* Check for room in the cache already */
+    if ((file_cache->nbytes_used + size) <= file_cache->nbytes_max)
+        HGOTO_DONE(SUCCEED)
+
+    last = file_cache->tail;
+    for (ent = file_cache->head; ent && (file_cache->nbytes_used + size) > file_cache->nbytes_max;
+         ent = next) {
+        next = ent->file_next;
+        if (ent->locked) {
+            if (ent != last) {
+                /* Move the entry to the tail of the file's list */
+                next->file_prev = ent->file_prev;
+                if (ent->file_prev)
+                    ent->file_prev->file_next = next;
+                else
+                    file_cache->head = next;
+                ent->file_prev              = file_cache->tail;
+                ent->file_next              = NULL;
+                file_cache->tail->file_next = ent;
+                file_cache->tail            = ent;
+            } /* end if */
+        }     /* end if */
+        else if (H5D__chunk_file_cache_evict(dset, ent) < 0)
+            nerrors++;
+        if (ent == last)
+            break;
+    } /* end for */
+
+    if (nerrors)
+        HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_file_cache_prune() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_file_cache_evict
+ *
+ * Purpose:     Preempts an entry of the file-wide chunk cache, which may
+ *              belong to another dataset than DSET, flushing it to disk
+ *              if necessary.
+ *
+ *              An entry of another dataset is flushed through the dataset
+ *              object kept by that dataset's chunk cache, with the
+ *              address of the dataset's object header as the tag of the
+ *              metadata touched.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_file_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(ent->shared);
+
+    if (ent->shared == dset->shared) {
+        if (H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk from cache")
+    } /* end if */
+    else {
+        const H5D_t *owner = ent->shared->cache.chunk.owner; /* Dataset of the entry */
+
+        HDassert(owner);
+        HDassert(owner->shared == ent->shared);
+
+        H5_BEGIN_TAG(owner->oloc.addr)
+
+        if (H5D__chunk_cache_evict(owner, ent, TRUE) < 0)
+            HGOTO_ERROR_TAG(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk from cache")
+
+        H5_END_TAG
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_file_cache_evict() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_lock
  *
@@ -4301,6 +6165,12 @@ done:
  *        for output functions that are about to overwrite the entire
  *        chunk.
  *
+ *        If LOADED_CHUNK is non-NULL, it is a buffer holding the chunk's
+ *        data that the caller has already read from the file and passed
+ *        through the filter pipeline.  It is used in place of reading
+ *        the chunk, and this function takes ownership of it whether it
+ *        succeeds or fails.  LOADED_NBYTES is the size of its data.
+ *
  * Return:    Success:    Ptr to a file chunk.
  *
  *        Failure:    NULL
@@ -4312,7 +6182,8 @@ done:
  */
 static void *
 H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_dset_io_info_t *dset_info,
-                H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk)
+                H5D_chunk_ud_t *udata, hbool_t relax, hbool_t prev_unfilt_chunk, void *loaded_chunk,
+                size_t loaded_nbytes)
 {
     const H5D_t *dset;      /* Convenience pointer to the dataset */
     H5O_pline_t *pline;     /* I/O pipeline info - always equal to the pline passed to H5D__chunk_mem_alloc */
@@ -4324,6 +6195,7 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
     H5D_rdcc_t         *rdcc;                    /*raw data chunk cache*/
     H5D_rdcc_ent_t     *ent;                     /*cache entry        */
     size_t              chunk_size;              /*size of a chunk    */
+    size_t              buf_size;                /*size of the chunk's data */
     hbool_t             disable_filters = FALSE; /* Whether to disable filters (when adding to cache) */
     void               *chunk           = NULL;  /*the file chunk    */
     void               *ret_value       = NULL;  /* Return value         */
@@ -4338,6 +6210,8 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
     HDassert(dset);
     HDassert(udata);
     HDassert(!(udata->new_unfilt_chunk && prev_unfilt_chunk));
+    HDassert(!loaded_chunk || (UINT_MAX == udata->idx_hint && !relax && !udata->new_unfilt_chunk &&
+                               !prev_unfilt_chunk && H5_addr_defined(udata->chunk_block.offset)));
 
     /* Set convenience pointers */
     pline     = &(dset->shared->dcpl_cache.pline);
@@ -4351,11 +6225,13 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
     /* Get the chunk's size */
     HDassert(layout->u.chunk.size > 0);
     H5_CHECKED_ASSIGN(chunk_size, size_t, layout->u.chunk.size, uint32_t);
+    buf_size = chunk_size;
 
     /* Check if the chunk is in the cache */
+    udata->idx_hint = H5D__chunk_cache_hint(dset->shared, udata->common.scaled, udata->idx_hint);
     if (UINT_MAX != udata->idx_hint) {
         /* Sanity check */
-        HDassert(udata->idx_hint < rdcc->nslots);
+        HDassert(udata->idx_hint < rdcc->nsets * H5D_CHUNK_CACHE_NWAYS);
         HDassert(rdcc->slot[udata->idx_hint]);
 
         /* Get the entry */
@@ -4375,6 +6251,10 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
          * Already in the cache.  Count a hit.
          */
         rdcc->stats.nhits++;
+        if (ent->prefetched) {
+            rdcc->stats.nprefetch_hits++;
+            ent->prefetched = FALSE;
+        } /* end if */
 
         /* Make adjustments if the edge chunk status changed recently */
         if (pline->nused) {
@@ -4399,7 +6279,7 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL,
                                 "memory allocation failed for raw data chunk")
                 H5MM_memcpy(chunk, ent->chunk, chunk_size);
-                ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, old_pline);
+                ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, chunk_size, old_pline);
                 ent->chunk = (uint8_t *)chunk;
                 chunk      = NULL;
 
@@ -4426,7 +6306,7 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
                                 "memory allocation failed for raw data chunk")
                 H5MM_memcpy(chunk, ent->chunk, chunk_size);
 
-                ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, old_pline);
+                ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, chunk_size, old_pline);
                 ent->chunk = (uint8_t *)chunk;
                 chunk      = NULL;
 
@@ -4454,6 +6334,20 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
             ent->next       = ent->next->next;
             ent->prev->next = ent;
         } /* end if */
+        ent->last_use = ++rdcc->use_clock;
+
+        /* Make the chunk the most recently used one of the file */
+        if (rdcc->file && ent->file_next) {
+            ent->file_next->file_prev = ent->file_prev;
+            if (ent->file_prev)
+                ent->file_prev->file_next = ent->file_next;
+            else
+                rdcc->file->head = ent->file_next;
+            ent->file_prev              = rdcc->file->tail;
+            ent->file_next              = NULL;
+            rdcc->file->tail->file_next = ent;
+            rdcc->file->tail            = ent;
+        } /* end if */
     }     /* end if */
     else {
         haddr_t chunk_addr;  /* Address of chunk on disk */
@@ -4515,8 +6409,17 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
              *      or an init if it isn't.
              */
 
+            /* Check if the chunk was already read & filtered by the caller */
+            if (loaded_chunk) {
+                chunk        = loaded_chunk;
+                loaded_chunk = NULL;
+                buf_size     = MAX(chunk_size, loaded_nbytes);
+
+                /* Increment # of cache misses */
+                rdcc->stats.nmisses++;
+            } /* end if */
             /* Check if the chunk exists on disk */
-            if (H5_addr_defined(chunk_addr)) {
+            else if (H5_addr_defined(chunk_addr)) {
                 size_t my_chunk_alloc = chunk_alloc; /* Allocated buffer size */
                 size_t buf_alloc      = chunk_alloc; /* [Re-]allocated buffer size */
 
@@ -4549,13 +6452,16 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
                         void *tmp_chunk = chunk;
 
                         if (NULL == (chunk = H5D__chunk_mem_alloc(my_chunk_alloc, pline))) {
-                            (void)H5D__chunk_mem_xfree(tmp_chunk, old_pline);
+                            (void)H5D__chunk_mem_xfree(tmp_chunk, my_chunk_alloc, old_pline);
                             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL,
                                         "memory allocation failed for raw data chunk")
                         } /* end if */
                         H5MM_memcpy(chunk, tmp_chunk, chunk_size);
-                        (void)H5D__chunk_mem_xfree(tmp_chunk, old_pline);
+                        (void)H5D__chunk_mem_xfree(tmp_chunk, my_chunk_alloc, old_pline);
                     } /* end if */
+
+                    /* (Inline VL data makes a chunk larger than its elements) */
+                    buf_size = MAX(chunk_size, my_chunk_alloc);
                 }     /* end if */
 
                 /* Increment # of cache misses */
@@ -4607,21 +6513,19 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
         }     /* end else */
 
         /* See if the chunk can be cached */
-        if (rdcc->nslots > 0 && chunk_size <= rdcc->nbytes_max) {
-            /* Calculate the index */
-            udata->idx_hint = H5D__chunk_hash_val(dset->shared, udata->common.scaled);
-
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if (!ent || !ent->locked) {
-                /* Preempt enough things from the cache to make room */
-                if (ent) {
-                    if (H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
-                        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
-                } /* end if */
-                if (H5D__chunk_cache_prune(dset, chunk_size) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
-
+        if (rdcc->nslots > 0 && buf_size <= rdcc->nbytes_max) {
+            /* Preempt enough things from the cache to make room */
+            if (H5D__chunk_cache_prune(dset, buf_size) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
+            if (rdcc->file && H5D__chunk_file_cache_prune(dset, buf_size) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from file's cache")
+
+            /* Find a slot for the chunk in the hash table */
+            if (H5D__chunk_cache_slot(dset, udata->common.scaled, &udata->idx_hint) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to find a slot for chunk in cache")
+
+            /* Add the chunk to the cache only if its set is not entirely locked */
+            if (UINT_MAX != udata->idx_hint) {
                 /* Create a new entry */
                 if (NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
@@ -4637,13 +6541,16 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
                 H5MM_memcpy(ent->scaled, udata->common.scaled, sizeof(hsize_t) * layout->u.chunk.ndims);
                 H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
                 H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
-                ent->chunk = (uint8_t *)chunk;
+                ent->chunk    = (uint8_t *)chunk;
+                ent->buf_size = buf_size;
+                chunk         = NULL;
 
                 /* Add it to the cache */
                 HDassert(NULL == rdcc->slot[udata->idx_hint]);
                 rdcc->slot[udata->idx_hint] = ent;
                 ent->idx                    = udata->idx_hint;
-                rdcc->nbytes_used += chunk_size;
+                ent->last_use               = ++rdcc->use_clock;
+                rdcc->nbytes_used += buf_size;
                 rdcc->nused++;
 
                 /* Add it to the linked list */
@@ -4656,6 +6563,19 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
                     rdcc->head = rdcc->tail = ent;
                 ent->tmp_next = NULL;
                 ent->tmp_prev = NULL;
+                ent->shared   = dset->shared;
+
+                /* Add it to the file's linked list */
+                if (rdcc->file) {
+                    if (rdcc->file->tail) {
+                        rdcc->file->tail->file_next = ent;
+                        ent->file_prev              = rdcc->file->tail;
+                        rdcc->file->tail            = ent;
+                    } /* end if */
+                    else
+                        rdcc->file->head = rdcc->file->tail = ent;
+                    rdcc->file->nbytes_used += buf_size;
+                } /* end if */
 
             } /* end if */
             else
@@ -4666,6 +6586,11 @@ H5D__chunk_lock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_ds
             ent = NULL;
     } /* end else */
 
+    /* Point the elements of a chunk holding VL data inline at their sequences */
+    if (H5Z_filter_in_pline(&(dset->shared->dcpl_cache.pline), H5Z_FILTER_VLEN) > 0)
+        if (H5Z_vlen_to_ptrs(&(dset->shared->dcpl_cache.pline), ent ? ent->chunk : chunk) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, NULL, "can't point chunk at its inline VL data")
+
     /* Lock the chunk into the cache */
     if (ent) {
         HDassert(!ent->locked);
@@ -4691,7 +6616,11 @@ done:
     /* Release the chunk allocated, on error */
     if (!ret_value)
         if (chunk)
-            chunk = H5D__chunk_mem_xfree(chunk, pline);
+            chunk = H5D__chunk_mem_xfree(chunk, (size_t)0, pline);
+
+    /* Release the caller's chunk, if it wasn't used */
+    if (loaded_chunk)
+        loaded_chunk = H5D__chunk_mem_xfree(loaded_chunk, (size_t)0, pline);
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__chunk_lock() */
@@ -4723,8 +6652,10 @@ H5D__chunk_unlock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_
                   const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk, uint32_t naccessed)
 {
     const H5O_layout_t *layout; /* Dataset layout */
-    const H5D_rdcc_t   *rdcc;
+    const H5O_pline_t  *pline;  /* I/O pipeline info */
+    H5D_rdcc_t         *rdcc;
     const H5D_t        *dset;                /* Local pointer to the dataset info */
+    hbool_t             vlen_inline;         /* Whether the chunk holds VL data inline */
     herr_t              ret_value = SUCCEED; /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -4735,9 +6666,11 @@ H5D__chunk_unlock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_
     HDassert(udata);
 
     /* Set convenience pointers */
-    layout = &(dset_info->dset->shared->layout);
-    rdcc   = &(dset_info->dset->shared->cache.chunk);
-    dset   = dset_info->dset;
+    layout      = &(dset_info->dset->shared->layout);
+    pline       = &(dset_info->dset->shared->dcpl_cache.pline);
+    rdcc        = &(dset_info->dset->shared->cache.chunk);
+    dset        = dset_info->dset;
+    vlen_inline = (H5Z_filter_in_pline(pline, H5Z_FILTER_VLEN) > 0);
 
     if (UINT_MAX == udata->idx_hint) {
         /*
@@ -4773,29 +6706,44 @@ H5D__chunk_unlock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_
             fake_ent.chunk_idx          = udata->chunk_idx;
             fake_ent.chunk_block.offset = udata->chunk_block.offset;
             fake_ent.chunk_block.length = udata->chunk_block.length;
-            fake_ent.chunk              = (uint8_t *)chunk;
+            fake_ent.buf_size           = (size_t)layout->u.chunk.size;
 
-            if (H5D__chunk_flush_entry(dset, &fake_ent, TRUE) < 0)
+            /* Gather the VL data written to a chunk that stores it inline */
+            if (vlen_inline && !is_unfiltered_edge_chunk) {
+                void *compact; /* Chunk holding its own VL data */
+
+                compact = H5Z_vlen_compact(pline, chunk, fake_ent.buf_size, &fake_ent.buf_size);
+                (void)H5D__chunk_mem_xfree(chunk, (size_t)layout->u.chunk.size, pline);
+                if (NULL == (chunk = compact))
+                    HGOTO_ERROR(H5E_IO, H5E_CANTCOPY, FAIL, "can't gather inline VL data of chunk")
+            } /* end if */
+            fake_ent.chunk = (uint8_t *)chunk;
+
+            if (H5D__chunk_flush_entry(dset, &fake_ent, TRUE, NULL) < 0)
                 HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
         } /* end if */
         else {
             if (chunk)
                 chunk = H5D__chunk_mem_xfree(
-                    chunk, (is_unfiltered_edge_chunk ? NULL : &(dset->shared->dcpl_cache.pline)));
+                    chunk, (size_t)layout->u.chunk.size, (is_unfiltered_edge_chunk ? NULL : pline));
         } /* end else */
     }     /* end if */
     else {
         H5D_rdcc_ent_t *ent; /* Chunk's entry in the cache */
+        unsigned        idx; /* Index of the chunk's slot */
+
+        /* The chunk may have moved if the hash table grew while it was locked */
+        idx = H5D__chunk_cache_hint(dset->shared, udata->common.scaled, udata->idx_hint);
 
         /* Sanity check */
-        HDassert(udata->idx_hint < rdcc->nslots);
-        HDassert(rdcc->slot[udata->idx_hint]);
-        HDassert(rdcc->slot[udata->idx_hint]->chunk == chunk);
+        HDassert(idx < rdcc->nsets * H5D_CHUNK_CACHE_NWAYS);
+        HDassert(rdcc->slot[idx]);
+        HDassert(rdcc->slot[idx]->chunk == chunk);
 
         /*
          * It's in the cache so unlock it.
          */
-        ent = rdcc->slot[udata->idx_hint];
+        ent = rdcc->slot[idx];
         HDassert(ent->locked);
         if (dirty) {
             ent->dirty = TRUE;
@@ -4804,6 +6752,41 @@ H5D__chunk_unlock(const H5D_io_info_t H5_ATTR_NDEBUG_UNUSED *io_info, const H5D_
         else
             ent->rd_count -= MIN(ent->rd_count, naccessed);
         ent->locked = FALSE;
+
+        /* Gather the VL data written to a chunk that stores it inline into
+         * the chunk's own buffer, since the memory it was written to only
+         * lives as long as the write, and charge the cache for the chunk's
+         * new size.  Otherwise the chunk's sequences are in its buffer, so
+         * only their offsets have to be set back. */
+        if (vlen_inline && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
+            if (dirty) {
+                uint8_t *compact;  /* Chunk holding its own VL data */
+                size_t   buf_size; /* Size of the new chunk */
+
+                if (NULL == (compact = (uint8_t *)H5Z_vlen_compact(pline, ent->chunk, ent->buf_size,
+                                                                   &buf_size))) {
+                    /* Don't leave the chunk pointing at memory that's about to be freed */
+                    if (H5D__chunk_cache_evict(dset, ent, FALSE) < 0)
+                        HDONE_ERROR(H5E_IO, H5E_CANTFREE, FAIL, "unable to preempt raw data chunk")
+                    HGOTO_ERROR(H5E_IO, H5E_CANTCOPY, FAIL, "can't gather inline VL data of chunk")
+                } /* end if */
+                (void)H5D__chunk_mem_xfree(ent->chunk, ent->buf_size, pline);
+                ent->chunk = compact;
+
+                rdcc->nbytes_used = rdcc->nbytes_used - ent->buf_size + buf_size;
+                if (rdcc->file)
+                    rdcc->file->nbytes_used = rdcc->file->nbytes_used - ent->buf_size + buf_size;
+                ent->buf_size = buf_size;
+
+                /* Make the cache fit its limits again */
+                if (H5D__chunk_cache_prune(dset, (size_t)0) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk(s) from cache")
+                if (rdcc->file && H5D__chunk_file_cache_prune(dset, (size_t)0) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt chunk(s) from file's cache")
+            } /* end if */
+            else if (H5Z_vlen_to_offsets(pline, ent->chunk, ent->buf_size) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_CANTINIT, FAIL, "can't point chunk at its inline VL data")
+        } /* end if */
     } /* end else */
 
 done:
@@ -4868,7 +6851,7 @@ H5D__chunk_allocated(const H5D_t *dset, hsize_t *nbytes)
     /* Search for cached chunks that haven't been written out */
     for (ent = rdcc->head; ent; ent = ent->next)
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
 
     /* Compose chunked index info struct */
@@ -5353,7 +7336,7 @@ done:
         HDONE_ERROR(H5E_DATASET, H5E_CANTFREE, FAIL, "Can't release fill buffer info")
 
     /* Free the unfiltered fill value buffer */
-    unfilt_fill_buf = H5D__chunk_mem_xfree(unfilt_fill_buf, &def_pline);
+    unfilt_fill_buf = H5D__chunk_mem_xfree(unfilt_fill_buf, orig_chunk_size, &def_pline);
 
 #ifdef H5_HAVE_PARALLEL
     if (using_mpi && chunk_fill_info.chunk_info)
@@ -5503,7 +7486,8 @@ H5D__chunk_update_old_edge_chunks(H5D_t *dset, hsize_t old_dim[])
                 /* Lock the chunk into cache.  H5D__chunk_lock will take care of
                  * updating the chunk to no longer be an edge chunk. */
                 if (NULL ==
-                    (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_dset_info, &chk_udata, FALSE, TRUE)))
+                    (chunk = (void *)H5D__chunk_lock(&chk_io_info, &chk_dset_info, &chk_udata, FALSE, TRUE,
+                                                     NULL, (size_t)0)))
                     HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
                 /* Unlock the chunk */
@@ -5893,7 +7877,9 @@ H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "unable to select hyperslab")
 
     /* Lock the chunk into the cache, to get a pointer to the chunk buffer */
-    if (NULL == (chunk = (void *)H5D__chunk_lock(io_info, udata->dset_info, &chk_udata, FALSE, FALSE)))
+    if (NULL ==
+        (chunk = (void *)H5D__chunk_lock(io_info, udata->dset_info, &chk_udata, FALSE, FALSE, NULL,
+                                         (size_t)0)))
         HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to lock raw data chunk")
 
     /* Fill the selection in the memory buffer */
@@ -6557,7 +8543,7 @@ herr_t
 H5D__chunk_update_cache(H5D_t *dset)
 {
     H5D_rdcc_t     *rdcc = &(dset->shared->cache.chunk); /*raw data chunk cache */
-    H5D_rdcc_ent_t *ent, *next;                          /*cache entry  */
+    H5D_rdcc_ent_t *ent;                                 /*cache entry  */
     H5D_rdcc_ent_t  tmp_head;                            /* Sentinel entry for temporary entry list */
     H5D_rdcc_ent_t *tmp_tail;                            /* Tail pointer for temporary entry list */
     herr_t          ret_value = SUCCEED;                 /* Return value */
@@ -6577,59 +8563,34 @@ H5D__chunk_update_cache(H5D_t *dset)
     rdcc->tmp_head = &tmp_head;
     tmp_tail       = &tmp_head;
 
-    /* Recompute the index for each cached chunk that is in a dataset */
-    for (ent = rdcc->head; ent; ent = next) {
-        unsigned old_idx; /* Previous index number    */
-
-        /* Get the pointer to the next cache entry */
-        next = ent->next;
-
-        /* Compute the index for the chunk entry */
-        old_idx  = ent->idx; /* Save for later */
-        ent->idx = H5D__chunk_hash_val(dset->shared, ent->scaled);
-
-        if (old_idx != ent->idx) {
-            H5D_rdcc_ent_t *old_ent; /* Old cache entry  */
-
-            /* Check if there is already a chunk at this chunk's new location */
-            old_ent = rdcc->slot[ent->idx];
-            if (old_ent != NULL) {
-                HDassert(old_ent->locked == FALSE);
-                HDassert(old_ent->deleted == FALSE);
-
-                /* Insert the old entry into the temporary list, but do not
-                 * evict (yet).  Make sure we do not make any calls to the index
-                 * until all chunks have updated indices! */
-                HDassert(!old_ent->tmp_next);
-                HDassert(!old_ent->tmp_prev);
-                tmp_tail->tmp_next = old_ent;
-                old_ent->tmp_prev  = tmp_tail;
-                tmp_tail           = old_ent;
-            } /* end if */
+    /* Clear the hash table, then put each cached chunk back in a free slot
+     * of its new set.  Chunks that don't fit are put in the temporary list,
+     * to be evicted once all chunks have updated indices.  Make sure we do not
+     * make any calls to the index until then! */
+    if (rdcc->slot)
+        HDmemset(rdcc->slot, 0, rdcc->nsets * H5D_CHUNK_CACHE_NWAYS * sizeof(H5D_rdcc_ent_t *));
+    for (ent = rdcc->head; ent; ent = ent->next) {
+        unsigned first; /* First slot of the chunk's set */
+        unsigned u;     /* Local index variable */
+
+        first = H5D__chunk_hash_val(dset->shared, ent->scaled);
+        for (u = first; u < first + H5D_CHUNK_CACHE_NWAYS; u++)
+            if (NULL == rdcc->slot[u])
+                break;
 
-            /* Insert this chunk into correct location in hash table */
-            rdcc->slot[ent->idx] = ent;
-
-            /* If this chunk was previously on the temporary list and therefore
-             * not in the hash table, remove it from the temporary list.
-             * Otherwise clear the old hash table slot. */
-            if (ent->tmp_prev) {
-                HDassert(tmp_head.tmp_next);
-                HDassert(tmp_tail != &tmp_head);
-                ent->tmp_prev->tmp_next = ent->tmp_next;
-                if (ent->tmp_next) {
-                    ent->tmp_next->tmp_prev = ent->tmp_prev;
-                    ent->tmp_next           = NULL;
-                } /* end if */
-                else {
-                    HDassert(tmp_tail == ent);
-                    tmp_tail = ent->tmp_prev;
-                } /* end else */
-                ent->tmp_prev = NULL;
-            } /* end if */
-            else
-                rdcc->slot[old_idx] = NULL;
+        if (u < first + H5D_CHUNK_CACHE_NWAYS) {
+            /* Insert this chunk into its new location in the hash table */
+            rdcc->slot[u] = ent;
+            ent->idx      = u;
         } /* end if */
+        else {
+            /* Insert the entry into the temporary list, but do not evict (yet) */
+            HDassert(!ent->tmp_next);
+            HDassert(!ent->tmp_prev);
+            tmp_tail->tmp_next = ent;
+            ent->tmp_prev      = tmp_tail;
+            tmp_tail           = ent;
+        } /* end else */
     }     /* end for */
 
     /* tmp_tail is no longer needed, and will be invalidated by
@@ -6673,6 +8634,7 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
     hbool_t             is_vlen     = FALSE;                  /* Whether datatype is variable-length */
     hbool_t             fix_ref     = FALSE; /* Whether to fix up references in the dest. file */
     hbool_t             need_insert = FALSE; /* Whether the chunk needs to be inserted into the index */
+    H5D_rdcc_ent_t     *ent         = NULL;  /* Cache entry */
 
     /* General information about chunk copy */
     void              *bkg      = udata->bkg;      /* Background buffer for datatype conversion */
@@ -6716,6 +8678,19 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTCOPY, H5_ITER_ERROR, "unable to copy dataset elements")
     } /* end if */
 
+    /* See if the written chunk is in the chunk cache, where it is held unfiltered */
+    if (!(udata->chunk_in_cache && udata->chunk)) {
+        H5D_shared_t *shared_fo = (H5D_shared_t *)udata->cpy_info->shared_fo;
+        unsigned      idx; /* Index of chunk in cache, if present */
+
+        if (shared_fo && shared_fo->cache.chunk.nslots > 0)
+            if (UINT_MAX != (idx = H5D__chunk_cache_find(shared_fo, chunk_rec->scaled))) {
+                ent                   = shared_fo->cache.chunk.slot[idx];
+                udata->chunk_in_cache = TRUE;
+                nbytes                = ent->buf_size;
+            } /* end if */
+    }     /* end if */
+
     /* Resize the buf if it is too small to hold the data */
     if (nbytes > buf_size) {
         void *new_buf; /* New buffer for data */
@@ -6746,40 +8721,13 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
         udata->chunk = NULL;
     }
     else {
-        H5D_rdcc_ent_t *ent = NULL; /* Cache entry */
-        unsigned        idx;        /* Index of chunk in cache, if present */
-        unsigned        u;          /* Counter */
-        H5D_shared_t   *shared_fo = (H5D_shared_t *)udata->cpy_info->shared_fo;
-
-        /* See if the written chunk is in the chunk cache */
-        if (shared_fo && shared_fo->cache.chunk.nslots > 0) {
-            /* Determine the chunk's location in the hash table */
-            idx = H5D__chunk_hash_val(shared_fo, chunk_rec->scaled);
-
-            /* Get the chunk cache entry for that location */
-            ent = shared_fo->cache.chunk.slot[idx];
-            if (ent) {
-                /* Speculatively set the 'found' flag */
-                udata->chunk_in_cache = TRUE;
-
-                /* Verify that the cache entry is the correct chunk */
-                for (u = 0; u < shared_fo->ndims; u++)
-                    if (chunk_rec->scaled[u] != ent->scaled[u]) {
-                        udata->chunk_in_cache = FALSE;
-                        break;
-                    } /* end if */
-            }         /* end if */
-        }             /* end if */
-
         if (udata->chunk_in_cache) {
-
             if (NULL == ent)
                 HGOTO_ERROR(H5E_IO, H5E_BADVALUE, H5_ITER_ERROR, "NULL chunk entry pointer")
 
             HDassert(H5_addr_defined(chunk_rec->chunk_addr));
             HDassert(H5_addr_defined(ent->chunk_block.offset));
 
-            H5_CHECKED_ASSIGN(nbytes, size_t, shared_fo->layout.u.chunk.size, uint32_t);
             H5MM_memcpy(buf, ent->chunk, nbytes);
         }
         else {
@@ -6797,6 +8745,20 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
         if (H5Z_pipeline(pline, H5Z_FLAG_REVERSE, &filter_mask, H5Z_NO_EDC, filter_cb, &nbytes, &buf_size,
                          &buf) < 0)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, H5_ITER_ERROR, "data pipeline read failed")
+
+        /* The filters may have grown the buffer, keep the background buffer as large */
+        if (buf_size > udata->buf_size && udata->bkg) {
+            void *new_bkg; /* New background buffer */
+
+            if (NULL == (new_bkg = H5MM_realloc(udata->bkg, buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, H5_ITER_ERROR,
+                            "memory allocation failed for background buffer")
+            udata->bkg = bkg = new_bkg;
+            if (!udata->cpy_info->expand_ref)
+                HDmemset((uint8_t *)udata->bkg + udata->buf_size, 0, (size_t)(buf_size - udata->buf_size));
+        } /* end if */
+        udata->buf      = buf;
+        udata->buf_size = buf_size;
     } /* end if */
 
     /* Perform datatype conversion, if necessary */
@@ -7002,8 +8964,9 @@ H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src, H5O_layout_chunk
     if ((tid_src = H5I_register(H5I_DATATYPE, dt_src, FALSE)) < 0)
         HGOTO_ERROR(H5E_DATATYPE, H5E_CANTREGISTER, FAIL, "unable to register source file datatype")
 
-    /* If there's a VLEN source datatype, set up type conversion information */
-    if (H5T_detect_class(dt_src, H5T_VLEN, FALSE) > 0) {
+    /* If there's a VLEN source datatype, set up type conversion information
+     * (VL data stored inline in the chunks is copied with them) */
+    if (H5T_detect_class(dt_src, H5T_VLEN, FALSE) > 0 && H5Z_filter_in_pline(pline, H5Z_FILTER_VLEN) <= 0) {
         H5T_t   *dt_dst;      /* Destination datatype */
         H5T_t   *dt_mem;      /* Memory datatype */
         size_t   mem_dt_size; /* Memory datatype size */
@@ -7138,13 +9101,13 @@ H5D__chunk_copy(H5F_t *f_src, H5O_storage_chunk_t *storage_src, H5O_layout_chunk
         H5D_chunk_rec_t chunk_rec;
         H5D_shared_t   *shared_fo = (H5D_shared_t *)udata.cpy_info->shared_fo;
 
-        chunk_rec.nbytes      = layout_src->size;
         chunk_rec.filter_mask = 0;
         chunk_rec.chunk_addr  = HADDR_UNDEF;
 
         for (ent = shared_fo->cache.chunk.head; ent; ent = next) {
             if (!H5_addr_defined(ent->chunk_block.offset)) {
                 H5MM_memcpy(chunk_rec.scaled, ent->scaled, sizeof(chunk_rec.scaled));
+                H5_CHECKED_ASSIGN(chunk_rec.nbytes, uint32_t, ent->buf_size, size_t);
                 udata.chunk          = ent->chunk;
                 udata.chunk_in_cache = TRUE;
                 if (H5D__chunk_copy_cb(&chunk_rec, &udata) < 0)
@@ -7423,6 +9386,12 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
         HDfprintf(H5DEBUG(AC), "   %-18s %8u %8u %7s %8d+%-9ld\n", "raw data chunks", rdcc->stats.nhits,
                   rdcc->stats.nmisses, ascii, rdcc->stats.ninits,
                   (long)(rdcc->stats.nflushes) - (long)(rdcc->stats.ninits));
+        if (rdcc->stats.nprefetches > 0)
+            HDfprintf(H5DEBUG(AC), "   %-18s %u read ahead, %u hit, %u wasted\n", "raw data chunks",
+                      rdcc->stats.nprefetches, rdcc->stats.nprefetch_hits, rdcc->stats.nprefetch_wasted);
+        if (rdcc->stats.nplan_hits > 0)
+            HDfprintf(H5DEBUG(AC), "   %-18s %u selection plans reused\n", "raw data chunks",
+                      rdcc->stats.nplan_hits);
     }
 
 done:
@@ -7898,7 +9867,7 @@ H5D__chunk_index_empty(const H5D_t *dset, hbool_t *empty)
     /* Search for cached chunks that haven't been written out */
     for (ent = rdcc->head; ent; ent = ent->next)
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
 
     /* Compose chunked index info struct */
@@ -7990,7 +9959,7 @@ H5D__get_num_chunks(const H5D_t *dset, const H5S_t H5_ATTR_UNUSED *space, hsize_
     /* Search for cached chunks that haven't been written out */
     for (ent = rdcc->head; ent; ent = ent->next)
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
 
     /* Compose chunked index info struct */
@@ -8104,7 +10073,7 @@ H5D__get_chunk_info(const H5D_t *dset, const H5S_t H5_ATTR_UNUSED *space, hsize_
     /* Search for cached chunks that haven't been written out */
     for (ent = rdcc->head; ent; ent = ent->next)
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
 
     /* Compose chunked index info struct */
@@ -8243,7 +10212,7 @@ H5D__get_chunk_info_by_coord(const H5D_t *dset, const hsize_t *offset, unsigned
     /* Search for cached chunks that haven't been written out */
     for (ent = rdcc->head; ent; ent = ent->next)
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
 
     /* Set addr & size for when dset is not written or queried chunk is not found */
@@ -8368,7 +10337,7 @@ H5D__chunk_iter(H5D_t *dset, H5D_chunk_iter_op_t op, void *op_data)
     /* Search for cached chunks that haven't been written out */
     for (ent = rdcc->head; ent; ent = ent->next)
         /* Flush the chunk out to disk, to make certain the size is correct later */
-        if (H5D__chunk_flush_entry(dset, ent, FALSE) < 0)
+        if (H5D__chunk_flush_entry(dset, ent, FALSE, NULL) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "cannot flush indexed storage buffer")
 
     /* Compose chunked index info struct */
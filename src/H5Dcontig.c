@@ -63,9 +63,11 @@ typedef struct H5D_contig_readvv_sieve_ud_t {
 
 /* Callback info for [plain] readvv operation */
 typedef struct H5D_contig_readvv_ud_t {
-    H5F_shared_t  *f_sh;      /* Shared file for dataset */
-    haddr_t        dset_addr; /* Address of dataset */
-    unsigned char *rbuf;      /* Pointer to buffer to fill */
+    H5F_shared_t        *f_sh;        /* Shared file for dataset */
+    haddr_t              dset_addr;   /* Address of dataset */
+    unsigned char       *rbuf;        /* Pointer to buffer to fill */
+    const unsigned char *mapped;      /* File's image in memory, if the driver maps it */
+    haddr_t              mapped_size; /* Size of the file's image in memory */
 } H5D_contig_readvv_ud_t;
 
 /* Callback info for sieve buffer writevv operation */
@@ -1175,9 +1177,12 @@ H5D__contig_readvv_cb(hsize_t dst_off, hsize_t src_off, size_t len, void *_udata
 
     FUNC_ENTER_PACKAGE
 
-    /* Write data */
-    if (H5F_shared_block_read(udata->f_sh, H5FD_MEM_DRAW, (udata->dset_addr + dst_off), len,
-                              (udata->rbuf + src_off)) < 0)
+    /* Copy straight from the file's image in memory when the driver maps
+     * the file, otherwise read the data */
+    if (udata->mapped && (udata->dset_addr + dst_off) + len <= udata->mapped_size)
+        H5MM_memcpy(udata->rbuf + src_off, udata->mapped + udata->dset_addr + dst_off, len);
+    else if (H5F_shared_block_read(udata->f_sh, H5FD_MEM_DRAW, (udata->dset_addr + dst_off), len,
+                                   (udata->rbuf + src_off)) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "block write failed")
 
 done:
@@ -1238,13 +1243,26 @@ H5D__contig_readvv(const H5D_io_info_t *io_info, const H5D_dset_io_info_t *dset_
             HGOTO_ERROR(H5E_DATASET, H5E_CANTOPERATE, FAIL, "can't perform vectorized sieve buffer read")
     } /* end if */
     else {
-        H5D_contig_readvv_ud_t udata; /* User data for H5VM_opvv() operator */
+        H5D_contig_readvv_ud_t udata;         /* User data for H5VM_opvv() operator */
+        H5FD_t                *file_handle;   /* File driver for the dataset's file */
+        const void            *mapped = NULL; /* File's image in memory */
 
         /* Set up user data for H5VM_opvv() */
         udata.f_sh      = io_info->f_sh;
         udata.dset_addr = dset_info->store->contig.dset_addr;
         udata.rbuf      = (unsigned char *)dset_info->buf.vp;
 
+        udata.mapped_size = 0;
+
+        /* Check whether the driver keeps the file mapped into memory */
+        if (H5F_SHARED_HAS_FEATURE(io_info->f_sh, H5FD_FEAT_MAPPED_REGION)) {
+            if (H5F_shared_get_file_driver(io_info->f_sh, &file_handle) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get file handle")
+            if (H5FD_get_mapped_region(file_handle, &mapped, &udata.mapped_size) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get mapped region of file")
+        } /* end if */
+        udata.mapped = (const unsigned char *)mapped;
+
         /* Call generic sequence operation routine */
         if ((ret_value = H5VM_opvv(dset_max_nseq, dset_curr_seq, dset_len_arr, dset_off_arr, mem_max_nseq,
                                    mem_curr_seq, mem_len_arr, mem_off_arr, H5D__contig_readvv_cb, &udata)) <
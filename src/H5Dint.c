@@ -1921,6 +1921,11 @@ H5D_close(H5D_t *dataset)
                         H5FL_FREE(H5D_piece_info_t, dataset->shared->cache.chunk.single_piece_info);
                     dataset->shared->cache.chunk.single_piece_info = NULL;
                 } /* end if */
+
+                /* Check for cached chunk selection plan */
+                if (dataset->shared->cache.chunk.sel_plan)
+                    dataset->shared->cache.chunk.sel_plan =
+                        H5D__chunk_sel_plan_free(dataset->shared->cache.chunk.sel_plan);
                 break;
 
             case H5D_COMPACT:
@@ -2115,6 +2120,11 @@ H5D_mult_refresh_close(hid_t dset_id)
                         H5FL_FREE(H5D_piece_info_t, dataset->shared->cache.chunk.single_piece_info);
                     dataset->shared->cache.chunk.single_piece_info = NULL;
                 } /* end if */
+
+                /* Check for cached chunk selection plan */
+                if (dataset->shared->cache.chunk.sel_plan)
+                    dataset->shared->cache.chunk.sel_plan =
+                        H5D__chunk_sel_plan_free(dataset->shared->cache.chunk.sel_plan);
                 break;
 
             case H5D_COMPACT:
@@ -1364,8 +1364,23 @@ H5D__typeinfo_init_phase3(H5D_io_info_t *io_info)
 
         /* Check if we're doing selection I/O */
         if (io_info->use_select_io == H5D_SELECTION_IO_MODE_ON) {
+            size_t i;
+
             /* Selection I/O, conversion buffers must be large enough for entire I/O (for now) */
 
+            /* Chunks that must go through the chunk cache (e.g. to write the fill value) are still
+             * converted a piece at a time with these buffers, so make them hold at least one element
+             * and set the number of elements converted per piece */
+            io_info->tconv_buf_size = MAX(io_info->tconv_buf_size, io_info->max_tconv_type_size);
+            if (io_info->bkg_buf_size > 0)
+                io_info->bkg_buf_size = MAX(io_info->bkg_buf_size, io_info->max_tconv_type_size);
+            for (i = 0; i < io_info->count; i++) {
+                H5D_type_info_t *type_info = &io_info->dsets_info[i].type_info;
+
+                type_info->request_nelmts =
+                    io_info->tconv_buf_size / MAX(type_info->src_type_size, type_info->dst_type_size);
+            }
+
             /* Allocate global type conversion buffer (if any, could be none if datasets in this
              * I/O have 0 elements selected) */
             /* Allocating large buffers here will blow out all other type conversion buffers
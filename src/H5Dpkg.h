@@ -254,6 +254,9 @@ typedef struct H5D_piece_info_t {
     unsigned mspace_shared;  /* Indicate that the memory space for a chunk is shared and shouldn't be freed */
     hbool_t  in_place_tconv; /* Whether to perform type conversion in-place */
     size_t   buf_off;        /* Buffer offset for in-place type conversion */
+    hbool_t  index_valid;    /* Whether faddr, nbytes & filter_mask hold the chunk's index entry */
+    uint32_t nbytes;         /* Size of chunk in file, if index_valid */
+    unsigned filter_mask;    /* Excluded filters, if index_valid */
     struct H5D_dset_io_info_t *dset_info; /* Pointer to dset_info */
 } H5D_piece_info_t;
 
@@ -463,6 +466,26 @@ typedef struct H5D_chunk_cached_t {
     unsigned filter_mask;              /*excluded filters */
 } H5D_chunk_cached_t;
 
+/* A piece of a cached chunk selection plan */
+typedef struct H5D_sel_plan_piece_t {
+    hsize_t scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of chunk, from the plan's first chunk */
+    hsize_t piece_points;             /* Number of elements selected in piece */
+    H5S_t  *fspace;                   /* Selection in the chunk */
+    H5S_t  *mspace;                   /* Selection in memory, or NULL for the whole memory selection */
+} H5D_sel_plan_piece_t;
+
+/* The chunk selections built for the last hyperslab I/O on a dataset, kept
+ * to be reused for the same selection moved by a whole number of chunks */
+typedef struct H5D_sel_plan_t {
+    H5S_t                *file_space;              /* File selection the plan was built for */
+    H5S_t                *mem_space;               /* Memory selection the plan was built for */
+    hsize_t               start[H5O_LAYOUT_NDIMS]; /* Low bound of the file selection */
+    hsize_t               base[H5O_LAYOUT_NDIMS];  /* Scaled coordinates of the chunk holding the low bound */
+    hsize_t               mem_start[H5S_MAX_RANK]; /* Low bound of the memory selection */
+    size_t                npieces;                 /* Number of pieces */
+    H5D_sel_plan_piece_t *pieces;                  /* Pieces, in chunk index order */
+} H5D_sel_plan_t;
+
 /****************************/
 /* Virtual dataset typedefs */
 /****************************/
@@ -473,20 +496,41 @@ typedef struct H5D_virtual_held_file_t {
     struct H5D_virtual_held_file_t *next; /* Pointer to next node in list */
 } H5D_virtual_held_file_t;
 
-/* The raw data chunk cache */
+/* The raw data chunk cache shared by the datasets of a file */
 struct H5D_rdcc_ent_t; /* Forward declaration of struct used below */
+typedef struct H5D_rdcc_file_t {
+    size_t                 nbytes_max;  /* Maximum cached raw data in bytes, for all the datasets */
+    size_t                 nbytes_used; /* Current cached raw data in bytes, for all the datasets */
+    unsigned               nrefs;       /* Number of datasets sharing the cache */
+    struct H5D_rdcc_ent_t *head;        /* Least recently used entry of the file */
+    struct H5D_rdcc_ent_t *tail;        /* Most recently used entry of the file */
+} H5D_rdcc_file_t;
+
+/* The raw data chunk cache */
 typedef struct H5D_rdcc_t {
     struct {
-        unsigned ninits;   /* Number of chunk creations        */
-        unsigned nhits;    /* Number of cache hits            */
-        unsigned nmisses;  /* Number of cache misses        */
-        unsigned nflushes; /* Number of cache flushes        */
+        unsigned ninits;           /* Number of chunk creations        */
+        unsigned nhits;            /* Number of cache hits            */
+        unsigned nmisses;          /* Number of cache misses        */
+        unsigned nflushes;         /* Number of cache flushes        */
+        unsigned nprefetches;      /* Number of chunks read ahead */
+        unsigned nprefetch_hits;   /* Number of chunks read ahead that were then accessed */
+        unsigned nprefetch_wasted; /* Number of chunks read ahead and evicted unaccessed */
+        unsigned nplan_hits;       /* Number of I/O operations that reused the selection plan */
     } stats;
-    size_t                 nbytes_max; /* Maximum cached raw data in bytes    */
-    size_t                 nslots;     /* Number of chunk slots allocated    */
-    double                 w0;         /* Chunk preemption policy          */
-    struct H5D_rdcc_ent_t *head;       /* Head of doubly linked list        */
-    struct H5D_rdcc_ent_t *tail;       /* Tail of doubly linked list        */
+    size_t                 nbytes_max;      /* Maximum cached raw data in bytes    */
+    size_t                 nslots;          /* Number of chunk slots requested    */
+    size_t                 nsets;           /* Number of sets of slots in the hash table */
+    size_t                 nsets_max;       /* Number of sets the hash table can grow to */
+    double                 w0;              /* Chunk preemption policy          */
+    uint64_t               use_clock;       /* Count of chunk accesses, to find the LRU entry of a set */
+    H5D_rdcc_file_t       *file;            /* Cache shared by the file's datasets, or NULL */
+    H5D_t                 *owner;           /* Dataset to flush its chunks through for other datasets */
+    unsigned               prefetch_depth;  /* Number of chunks to read ahead of sequential reads */
+    hsize_t                prefetch_last;   /* Index of the last chunk read, or HSIZE_UNDEF */
+    hsize_t                prefetch_stride; /* Distance between the last two chunks read, or 0 */
+    struct H5D_rdcc_ent_t *head;            /* Head of doubly linked list        */
+    struct H5D_rdcc_ent_t *tail;            /* Tail of doubly linked list        */
     struct H5D_rdcc_ent_t
         *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table
                       (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
@@ -497,6 +541,7 @@ typedef struct H5D_rdcc_t {
     H5SL_t                 *sel_chunks;        /* Skip list containing information for each chunk selected */
     H5S_t                  *single_space;      /* Dataspace for single element I/O on chunks */
     H5D_piece_info_t       *single_piece_info; /* Pointer to single piece's info */
+    H5D_sel_plan_t         *sel_plan;          /* Chunk selections of the last hyperslab I/O */
 
     /* Cached information about scaled dataspace dimensions */
     hsize_t  scaled_dims[H5S_MAX_RANK];        /* The scaled dim sizes */
@@ -719,7 +764,7 @@ H5_DLL herr_t  H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H
                                      H5F_block_t *new_chunk, hbool_t *need_insert, const hsize_t *scaled);
 H5_DLL void   *H5D__chunk_mem_alloc(size_t size, void *pline);
 H5_DLL void    H5D__chunk_mem_free(void *chk, void *pline);
-H5_DLL void   *H5D__chunk_mem_xfree(void *chk, const void *pline);
+H5_DLL void   *H5D__chunk_mem_xfree(void *chk, size_t size, const void *pline);
 H5_DLL void   *H5D__chunk_mem_realloc(void *chk, size_t size, const H5O_pline_t *pline);
 H5_DLL herr_t  H5D__chunk_update_old_edge_chunks(H5D_t *dset, hsize_t old_dim[]);
 H5_DLL hbool_t H5D__chunk_is_partial_edge_chunk(unsigned dset_ndims, const uint32_t *chunk_dims,
@@ -812,6 +857,9 @@ H5_DLL herr_t H5D__mpio_get_no_coll_cause_strings(char *local_cause, size_t loca
 /* Free a piece (chunk or contiguous dataset data block) info struct */
 H5_DLL herr_t H5D__free_piece_info(void *item, void *key, void *opdata);
 
+/* Free a dataset's cached chunk selection plan */
+H5_DLL H5D_sel_plan_t *H5D__chunk_sel_plan_free(H5D_sel_plan_t *plan);
+
 /* Testing functions */
 #ifdef H5D_TESTING
 H5_DLL herr_t H5D__layout_version_test(hid_t did, unsigned *version);
@@ -820,6 +868,9 @@ H5_DLL herr_t H5D__layout_compact_dirty_test(hid_t did, hbool_t *dirty);
 H5_DLL herr_t H5D__layout_idx_type_test(hid_t did, H5D_chunk_index_t *idx_type);
 H5_DLL herr_t H5D__layout_type_test(hid_t did, H5D_layout_t *layout_type);
 H5_DLL herr_t H5D__current_cache_size_test(hid_t did, size_t *nbytes_used, int *nused);
+H5_DLL herr_t H5D__file_cache_size_test(hid_t did, size_t *nbytes_used, unsigned *nrefs);
+H5_DLL herr_t H5D__sel_plan_hits_test(hid_t did, unsigned *nhits);
+H5_DLL herr_t H5D__chunk_prefetch_test(hid_t did, unsigned *nprefetches, unsigned *nhits, unsigned *nwasted);
 #endif /* H5D_TESTING */
 
 #endif /*H5Dpkg_H*/
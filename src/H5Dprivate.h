@@ -49,6 +49,7 @@
 #define H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME "rdcc_nslots"          /* Size of raw data chunk cache(slots) */
 #define H5D_ACS_DATA_CACHE_BYTE_SIZE_NAME "rdcc_nbytes"          /* Size of raw data chunk cache(bytes) */
 #define H5D_ACS_PREEMPT_READ_CHUNKS_NAME  "rdcc_w0"              /* Preemption read chunks first */
+#define H5D_ACS_CHUNK_PREFETCH_NAME       "chunk_prefetch"       /* Chunk read-ahead depth */
 #define H5D_ACS_VDS_VIEW_NAME             "vds_view"             /* VDS view option */
 #define H5D_ACS_VDS_PRINTF_GAP_NAME       "vds_printf_gap"       /* VDS printf gap size */
 #define H5D_ACS_VDS_PREFIX_NAME           "vds_prefix"           /* VDS file prefix */
@@ -87,6 +88,9 @@
 #define H5D_XFER_SELECTION_IO_MODE_NAME     "selection_io_mode"     /* Selection I/O mode */
 #define H5D_XFER_NO_SELECTION_IO_CAUSE_NAME "no_selection_io_cause" /* Cause for no selection I/O */
 #define H5D_XFER_MODIFY_WRITE_BUF_NAME      "modify_write_buf"      /* Modify write buffers */
+#define H5D_XFER_FILTER_NTHREADS_NAME       "filter_nthreads"       /* # of filter pipeline threads */
+#define H5D_XFER_VECTOR_READ_GAP_NAME       "vector_read_gap"       /* Max. gap when merging reads */
+#define H5D_XFER_VLEN_ARENA_NAME            "vlen_arena"            /* Arena for VL data read */
 #ifdef H5_HAVE_INSTRUMENTED_LIBRARY
 /* Collective chunk instrumentation properties */
 #define H5D_XFER_COLL_CHUNK_LINK_HARD_NAME        "coll_chunk_link_hard"
@@ -1308,6 +1308,10 @@ done:
  *              The optimization is simply moving data to the appropriate
  *              places in the buffer.
  *
+ *              Members which need no conversion but aren't a common prefix
+ *              of both types (H5T_SUBSET_COPY) are copied the same way,
+ *              using the list of copy spans from the conversion path.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Raymond Lu
@@ -1336,7 +1340,8 @@ H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter, const H5D_type_info_
     HDassert(type_info);
     HDassert(type_info->cmpd_subset);
     HDassert(H5T_SUBSET_SRC == type_info->cmpd_subset->subset ||
-             H5T_SUBSET_DST == type_info->cmpd_subset->subset);
+             H5T_SUBSET_DST == type_info->cmpd_subset->subset ||
+             H5T_SUBSET_COPY == type_info->cmpd_subset->subset);
     HDassert(user_buf);
 
     /* Get info from API context */
@@ -1389,13 +1394,26 @@ H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter, const H5D_type_info_
             xubuf       = ubuf + curr_off;
 
             /* Copy the data into the right place. */
-            for (i = 0; i < curr_nelmts; i++) {
-                HDmemmove(xubuf, xdbuf, copy_size);
-
-                /* Update pointers */
-                xdbuf += src_stride;
-                xubuf += dst_stride;
-            } /* end for */
+            if (H5T_SUBSET_COPY == type_info->cmpd_subset->subset) {
+                const H5T_copy_span_t *spans  = type_info->cmpd_subset->spans;
+                size_t                 nspans = type_info->cmpd_subset->nspans;
+
+                for (i = 0; i < curr_nelmts; i++) {
+                    H5T_COPY_SPANS(xubuf, xdbuf, spans, nspans);
+
+                    /* Update pointers */
+                    xdbuf += src_stride;
+                    xubuf += dst_stride;
+                } /* end for */
+            }     /* end if */
+            else
+                for (i = 0; i < curr_nelmts; i++) {
+                    HDmemmove(xubuf, xdbuf, copy_size);
+
+                    /* Update pointers */
+                    xdbuf += src_stride;
+                    xubuf += dst_stride;
+                } /* end for */
         }     /* end for */
 
         /* Decrement number of elements left to process */
@@ -294,3 +294,141 @@ H5D__current_cache_size_test(hid_t did, size_t *nbytes_used, int *nused)
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__current_cache_size_test() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__file_cache_size_test
+ PURPOSE
+    Determine the current size of the chunk cache shared by the datasets of
+    a dataset's file
+ USAGE
+    herr_t H5D__file_cache_size_test(did, nbytes_used, nrefs)
+        hid_t did;              IN: Dataset to query
+        size_t *nbytes_used;    OUT: Bytes cached for all the file's datasets
+        unsigned *nrefs;        OUT: Number of datasets sharing the cache
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Checks the size of the file-wide chunk cache the dataset's chunk cache
+    takes its space from.  Both values are 0 if the dataset doesn't share
+    a file-wide chunk cache.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__file_cache_size_test(hid_t did, size_t *nbytes_used, unsigned *nrefs)
+{
+    H5D_t                 *dset;                /* Pointer to dataset to query */
+    const H5D_rdcc_file_t *file_cache;          /* File-wide chunk cache */
+    herr_t                 ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    if (NULL == (dset = (H5D_t *)H5VL_object_verify(did, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if (dset->shared->layout.type != H5D_CHUNKED)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    file_cache = dset->shared->cache.chunk.file;
+    if (nbytes_used)
+        *nbytes_used = file_cache ? file_cache->nbytes_used : 0;
+    if (nrefs)
+        *nrefs = file_cache ? file_cache->nrefs : 0;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__file_cache_size_test() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__sel_plan_hits_test
+ PURPOSE
+    Determine the number of I/O operations that reused a chunked dataset's
+    selection plan
+ USAGE
+    herr_t H5D__sel_plan_hits_test(did, nhits)
+        hid_t did;              IN: Dataset to query
+        unsigned *nhits;        OUT: Number of I/O operations that reused the plan
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Checks how many reads and writes took their chunk selections from the
+    ones kept from an earlier I/O on the dataset.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__sel_plan_hits_test(hid_t did, unsigned *nhits)
+{
+    H5D_t *dset;                /* Pointer to dataset to query */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    if (NULL == (dset = (H5D_t *)H5VL_object_verify(did, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if (dset->shared->layout.type != H5D_CHUNKED)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    *nhits = dset->shared->cache.chunk.stats.nplan_hits;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__sel_plan_hits_test() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__chunk_prefetch_test
+ PURPOSE
+    Determine how many chunks of a chunked dataset were read ahead, and what
+    became of them
+ USAGE
+    herr_t H5D__chunk_prefetch_test(did, nprefetches, nhits, nwasted)
+        hid_t did;              IN: Dataset to query
+        unsigned *nprefetches;  OUT: Number of chunks read ahead
+        unsigned *nhits;        OUT: Number of chunks read ahead, then accessed
+        unsigned *nwasted;      OUT: Number of chunks read ahead, then evicted
+                                     without being accessed
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Checks the read-ahead counters of the dataset's chunk cache, which are
+    reset when the dataset is opened.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__chunk_prefetch_test(hid_t did, unsigned *nprefetches, unsigned *nhits, unsigned *nwasted)
+{
+    H5D_t *dset;                /* Pointer to dataset to query */
+    herr_t ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    if (NULL == (dset = (H5D_t *)H5VL_object_verify(did, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+    if (dset->shared->layout.type != H5D_CHUNKED)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+    if (nprefetches)
+        *nprefetches = dset->shared->cache.chunk.stats.nprefetches;
+    if (nhits)
+        *nhits = dset->shared->cache.chunk.stats.nprefetch_hits;
+    if (nwasted)
+        *nwasted = dset->shared->cache.chunk.stats.nprefetch_wasted;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_prefetch_test() */
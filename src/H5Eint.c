@@ -910,6 +910,90 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5E__pop() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5E_detach_stack
+ *
+ * Purpose:     Private function to move the errors on the current thread's
+ *              error stack to a new error stack, leaving the thread's
+ *              stack empty.
+ *
+ *              This is for threads the library starts to do work for an
+ *              API call, whose errors must be reported by the thread that
+ *              made the call (see H5E_attach_stack()).  No IDs are
+ *              touched, the new stack takes over the references of the
+ *              thread's stack.
+ *
+ * Return:      Success:    Pointer to the new error stack, or NULL if the
+ *                          thread's error stack is empty
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5E_t *
+H5E_detach_stack(void)
+{
+    H5E_t *estack;           /* Current thread's error stack */
+    H5E_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOERR
+
+    estack = H5E__get_my_stack();
+    if (estack && estack->nused > 0)
+        if (NULL != (ret_value = (H5E_t *)H5MM_malloc(sizeof(H5E_t)))) {
+            H5MM_memcpy(ret_value, estack, sizeof(H5E_t));
+            estack->nused = 0;
+        } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_detach_stack() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5E_attach_stack
+ *
+ * Purpose:     Private function to append the errors of an error stack
+ *              made by H5E_detach_stack() to the current thread's error
+ *              stack, and release it.  Errors that don't fit on the
+ *              current thread's stack are dropped.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5E_attach_stack(H5E_t *estack)
+{
+    H5E_t   *current_stack;       /* Current thread's error stack */
+    unsigned u;                   /* Local index variable */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(estack);
+
+    /* Get a pointer to the current error stack */
+    if (NULL == (current_stack = H5E__get_my_stack())) /*lint !e506 !e774 Make lint 'constant value Boolean'
+                                                          in non-threaded case */
+        HGOTO_ERROR(H5E_ERROR, H5E_CANTGET, FAIL, "can't get current error stack")
+
+    /* Move the errors, which keep their references to the IDs */
+    for (u = 0; u < estack->nused && current_stack->nused < H5E_NSLOTS; u++)
+        current_stack->slot[current_stack->nused++] = estack->slot[u];
+
+    /* Release the errors that didn't fit */
+    if (u < estack->nused) {
+        HDmemmove(&estack->slot[0], &estack->slot[u], (estack->nused - u) * sizeof(H5E_error2_t));
+        estack->nused -= u;
+        if (H5E_clear_stack(estack) < 0)
+            HGOTO_ERROR(H5E_ERROR, H5E_CANTRELEASE, FAIL, "can't release errors")
+    } /* end if */
+
+done:
+    H5MM_xfree(estack);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_attach_stack() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5E_dump_api_stack
  *
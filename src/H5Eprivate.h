@@ -185,5 +185,7 @@ H5_DLL herr_t H5E_printf_stack(H5E_t *estack, const char *file, const char *func
                                hid_t maj_id, hid_t min_id, const char *fmt, ...) H5_ATTR_FORMAT(printf, 8, 9);
 H5_DLL herr_t H5E_clear_stack(H5E_t *estack);
 H5_DLL herr_t H5E_dump_api_stack(hbool_t is_api);
+H5_DLL H5E_t *H5E_detach_stack(void);
+H5_DLL herr_t H5E_attach_stack(H5E_t *estack);
 
 #endif /* H5Eprivate_H */
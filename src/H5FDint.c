@@ -56,6 +56,11 @@
  * space is needed dynamic allocation will be used instead */
 #define H5FD_LOCAL_SEL_ARR_LEN 8
 
+/* Largest span of the file read into a temporary buffer when merging the
+ * pieces of a vector read that are not adjacent in both the file and memory.
+ * Also bounds the temporary buffer memory used by a single vector read. */
+#define H5FD_VECTOR_MERGE_BUF_MAX (4 * 1024 * 1024)
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -87,6 +92,17 @@ typedef struct H5FD_vsrt_tmp_t {
     size_t  index;
 } H5FD_vsrt_tmp_t;
 
+/* A single piece of a vector read, used when merging the pieces of vector
+ * reads into fewer, larger reads from the file.
+ */
+typedef struct H5FD_vec_seg_t {
+    haddr_t    addr;       /* File address of piece */
+    size_t     size;       /* Size of piece */
+    H5FD_mem_t type;       /* Memory type of piece */
+    void      *buf;        /* Destination buffer for piece */
+    size_t     bounce_off; /* Offset of piece in temporary buffer, or SIZE_MAX if read directly */
+} H5FD_vec_seg_t;
+
 /* Information needed for iterating over the registered VFD hid_t IDs.
  * The name or value of the new VFD that is being registered is stored
  * in the name (or value) field and the found_id field is initialized to
@@ -112,6 +128,15 @@ static int    H5FD__get_driver_cb(void *obj, hid_t id, void *_op_data);
 static herr_t H5FD__read_selection_translate(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, uint32_t count,
                                              H5S_t **mem_spaces, H5S_t **file_spaces, haddr_t offsets[],
                                              size_t element_sizes[], void *bufs[] /* out */);
+static herr_t H5FD__read_vector_dispatch(H5FD_t *file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[],
+                                        haddr_t addrs[], size_t sizes[], void *bufs[] /* out */);
+static herr_t H5FD__read_vector_merged(H5FD_t *file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[],
+                                       haddr_t addrs[], size_t sizes[], void *bufs[] /* out */);
+static herr_t H5FD__read_vector_merged_flush(H5FD_t *file, hid_t dxpl_id, uint32_t nops,
+                                             H5FD_mem_t op_types[], haddr_t op_addrs[], size_t op_sizes[],
+                                             void *op_bufs[], const size_t op_bounce_off[], uint8_t *bounce,
+                                             const H5FD_vec_seg_t *segs, size_t nsegs);
+static int    H5FD__vec_seg_cmp(const void *element_1, const void *element_2);
 static herr_t H5FD__write_selection_translate(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, uint32_t count,
                                               H5S_t **mem_spaces, H5S_t **file_spaces, haddr_t offsets[],
                                               size_t element_sizes[], const void *bufs[]);
@@ -326,8 +351,12 @@ done:
  *              Similarly, if i > 0 and types[i] == H5FD_MEM_NOLIST,
  *              presume types[n] = types[i-1] for all n >= i and < count.
  *
+ *              Pieces that are adjacent in the file, or separated by no
+ *              more than the vector read gap set in the DXPL, are merged
+ *              into single reads (see H5FD__read_vector_merged()).
+ *
  *              If the underlying VFD supports vector reads, pass the
- *              call through directly.
+ *              resulting reads through directly.
  *
  *              If it doesn't, convert the vector read into a sequence
  *              of individual reads.
@@ -456,6 +485,53 @@ H5FD_read_vector(H5FD_t *file, uint32_t count, H5FD_mem_t types[], haddr_t addrs
         }
     }
 
+    /* Issue the reads, merging pieces that are close together in the file */
+    if (H5FD__read_vector_merged(file, dxpl_id, count, types, addrs, sizes, bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "vector read request failed")
+
+done:
+    /* undo the base addr offset to the addrs array if necessary */
+    if (addrs_cooked) {
+
+        HDassert(file->base_addr > 0);
+
+        for (i = 0; i < count; i++) {
+
+            addrs[i] -= file->base_addr;
+        }
+    }
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_read_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__read_vector_dispatch
+ *
+ * Purpose:     Passes a vector read to the underlying VFD.  If the VFD
+ *              supports vector reads the call is passed through directly,
+ *              otherwise it is converted into a sequence of individual
+ *              reads.
+ *
+ *              The addresses must already include the file's base
+ *              address.  The sizes and types arrays may be shortened as
+ *              described for H5FD_read_vector().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__read_vector_dispatch(H5FD_t *file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[], haddr_t addrs[],
+                           size_t sizes[], void *bufs[] /* out */)
+{
+    hbool_t    extend_sizes = FALSE;
+    hbool_t    extend_types = FALSE;
+    uint32_t   i;
+    size_t     size      = 0;
+    H5FD_mem_t type      = H5FD_MEM_DEFAULT;
+    herr_t     ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
     /* if the underlying VFD supports vector read, make the call */
     if (file->cls->read_vector) {
 
@@ -468,8 +544,6 @@ H5FD_read_vector(H5FD_t *file, uint32_t count, H5FD_mem_t types[], haddr_t addrs
         /* otherwise, implement the vector read as a sequence of regular
          * read calls.
          */
-        extend_sizes = FALSE;
-        extend_types = FALSE;
         uint32_t no_selection_io_cause;
 
         for (i = 0; i < count; i++) {
@@ -515,18 +589,286 @@ H5FD_read_vector(H5FD_t *file, uint32_t count, H5FD_mem_t types[], haddr_t addrs
     }
 
 done:
-    /* undo the base addr offset to the addrs array if necessary */
-    if (addrs_cooked) {
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__read_vector_dispatch() */
 
-        HDassert(file->base_addr > 0);
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__vec_seg_cmp
+ *
+ * Purpose:     Comparison callback for sorting the pieces of a vector
+ *              read by file address.
+ *
+ * Return:      -1, 0 or 1, as for qsort()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD__vec_seg_cmp(const void *element_1, const void *element_2)
+{
+    const H5FD_vec_seg_t *seg_1     = (const H5FD_vec_seg_t *)element_1;
+    const H5FD_vec_seg_t *seg_2     = (const H5FD_vec_seg_t *)element_2;
+    int                   ret_value = 0; /* Return value */
 
-        for (i = 0; i < count; i++) {
+    FUNC_ENTER_PACKAGE_NOERR
 
-            addrs[i] -= file->base_addr;
+    /* Compare the addresses, then the sizes so the order is deterministic */
+    if (H5_addr_gt(seg_1->addr, seg_2->addr))
+        ret_value = 1;
+    else if (H5_addr_lt(seg_1->addr, seg_2->addr))
+        ret_value = -1;
+    else if (seg_1->size > seg_2->size)
+        ret_value = 1;
+    else if (seg_1->size < seg_2->size)
+        ret_value = -1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__vec_seg_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__read_vector_merged_flush
+ *
+ * Purpose:     Issues the merged reads built up by
+ *              H5FD__read_vector_merged(), then copies the pieces that
+ *              were read into the temporary buffer to their destination
+ *              buffers.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__read_vector_merged_flush(H5FD_t *file, hid_t dxpl_id, uint32_t nops, H5FD_mem_t op_types[],
+                               haddr_t op_addrs[], size_t op_sizes[], void *op_bufs[],
+                               const size_t op_bounce_off[], uint8_t *bounce, const H5FD_vec_seg_t *segs,
+                               size_t nsegs)
+{
+    uint32_t u;
+    size_t   v;
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Point the reads into the temporary buffer at their final location,
+     * now that the buffer won't be reallocated any more
+     */
+    for (u = 0; u < nops; u++)
+        if (op_bounce_off[u] != SIZE_MAX)
+            op_bufs[u] = bounce + op_bounce_off[u];
+
+    /* Issue the reads */
+    if (H5FD__read_vector_dispatch(file, dxpl_id, nops, op_types, op_addrs, op_sizes, op_bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "merged vector read request failed")
+
+    /* Scatter the pieces read into the temporary buffer */
+    for (v = 0; v < nsegs; v++)
+        if (segs[v].bounce_off != SIZE_MAX)
+            H5MM_memcpy(segs[v].buf, bounce + segs[v].bounce_off, segs[v].size);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__read_vector_merged_flush() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__read_vector_merged
+ *
+ * Purpose:     Performs a vector read, merging pieces that are close
+ *              together in the file into fewer, larger reads.
+ *
+ *              The pieces are sorted by address and grouped while they
+ *              have the same memory type and the gap between the end of
+ *              the group and the next piece is no larger than the vector
+ *              read gap in the API context (0 by default).  A group
+ *              whose pieces are also contiguous in memory is read
+ *              directly into the destination buffers.  The same is done
+ *              for a group without gaps or overlaps when the VFD can read
+ *              vectors itself.  Any other group is read into a temporary
+ *              buffer as a single piece, and the pieces are copied out
+ *              of it afterwards.
+ *
+ *              Reads for files with MPI drivers are passed through
+ *              unchanged, since those drivers may depend on the exact
+ *              form of collective requests.
+ *
+ *              The addresses must already include the file's base
+ *              address.  The sizes and types arrays may be shortened as
+ *              described for H5FD_read_vector().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__read_vector_merged(H5FD_t *file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[], haddr_t addrs[],
+                         size_t sizes[], void *bufs[] /* out */)
+{
+    H5FD_vec_seg_t *segs          = NULL;    /* Pieces of the read, sorted by address */
+    H5FD_mem_t     *op_types      = NULL;    /* Types of merged reads */
+    haddr_t        *op_addrs      = NULL;    /* Addresses of merged reads */
+    size_t         *op_sizes      = NULL;    /* Sizes of merged reads */
+    void          **op_bufs       = NULL;    /* Buffers for merged reads */
+    size_t         *op_bounce_off = NULL;    /* Offsets of merged reads in temporary buffer */
+    uint8_t        *bounce        = NULL;    /* Temporary buffer for reads with gaps */
+    size_t          bounce_size   = 0;       /* Size of temporary buffer */
+    size_t          bounce_used   = 0;       /* Bytes of temporary buffer used by pending reads */
+    size_t          gap           = 0;       /* Largest gap to read through */
+    uint32_t        nops          = 0;       /* Number of pending merged reads */
+    size_t          round_start   = 0;       /* First piece of pending merged reads */
+    hbool_t         extend_sizes  = FALSE;   /* Whether remaining sizes repeat the last one */
+    hbool_t         extend_types  = FALSE;   /* Whether remaining types repeat the last one */
+    hbool_t         sorted        = TRUE;    /* Whether pieces are already sorted */
+    size_t          u, v, w;                 /* Local index variables */
+    herr_t          ret_value     = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Pass the read through unchanged if there's nothing to merge */
+    if (count < 2 || (file->feature_flags & H5FD_FEAT_HAS_MPI)) {
+        if (H5FD__read_vector_dispatch(file, dxpl_id, count, types, addrs, sizes, bufs) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "vector read request failed")
+        HGOTO_DONE(SUCCEED)
+    }
+
+    /* Get the largest gap to read through */
+    if (H5CX_get_vector_read_gap(&gap) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTGET, FAIL, "can't get vector read gap")
+
+    /* Build the list of pieces, expanding shortened size and type arrays */
+    if (NULL == (segs = (H5FD_vec_seg_t *)H5MM_malloc(count * sizeof(H5FD_vec_seg_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for piece list")
+    for (u = 0; u < count; u++) {
+        if (!extend_sizes && u > 0 && sizes[u] == 0)
+            extend_sizes = TRUE;
+        if (!extend_types && u > 0 && types[u] == H5FD_MEM_NOLIST)
+            extend_types = TRUE;
+
+        segs[u].addr       = addrs[u];
+        segs[u].size       = extend_sizes ? segs[u - 1].size : sizes[u];
+        segs[u].type       = extend_types ? segs[u - 1].type : types[u];
+        segs[u].buf        = bufs[u];
+        segs[u].bounce_off = SIZE_MAX;
+
+        if (u > 0 && H5_addr_lt(segs[u].addr, segs[u - 1].addr))
+            sorted = FALSE;
+    }
+
+    /* Sort the pieces by address, if necessary */
+    if (!sorted)
+        HDqsort(segs, count, sizeof(H5FD_vec_seg_t), H5FD__vec_seg_cmp);
+
+    /* Allocate the merged read lists */
+    if (NULL == (op_types = (H5FD_mem_t *)H5MM_malloc(count * sizeof(H5FD_mem_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for type list")
+    if (NULL == (op_addrs = (haddr_t *)H5MM_malloc(count * sizeof(haddr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for address list")
+    if (NULL == (op_sizes = (size_t *)H5MM_malloc(count * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for size list")
+    if (NULL == (op_bufs = (void **)H5MM_malloc(count * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for buffer list")
+    if (NULL == (op_bounce_off = (size_t *)H5MM_malloc(count * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for offset list")
+
+    /* Group the pieces into merged reads */
+    u = 0;
+    while (u < count) {
+        haddr_t start    = segs[u].addr;                /* Start of group in file */
+        haddr_t end      = segs[u].addr + segs[u].size; /* End of group in file */
+        hbool_t contig   = TRUE;                        /* Whether contiguous in file and memory */
+        hbool_t adjacent = TRUE;                        /* Whether no gaps or overlaps in file */
+
+        /* Find the end of the group */
+        for (v = u + 1; v < count; v++) {
+            haddr_t seg_end = MAX(end, segs[v].addr + segs[v].size);
+            hbool_t seg_contig;
+
+            if (segs[v].type != segs[u].type)
+                break;
+            if (H5_addr_gt(segs[v].addr, end) && (segs[v].addr - end) > gap)
+                break;
+
+            /* Only groups that go through the temporary buffer are limited in size */
+            seg_contig = contig && H5_addr_eq(segs[v].addr, end) &&
+                         segs[v].buf == (uint8_t *)segs[v - 1].buf + segs[v - 1].size;
+            if (!seg_contig && (seg_end - start) > H5FD_VECTOR_MERGE_BUF_MAX)
+                break;
+
+            if (!H5_addr_eq(segs[v].addr, end))
+                adjacent = FALSE;
+            contig = seg_contig;
+            end    = seg_end;
         }
+
+        if (contig || (adjacent && file->cls->read_vector)) {
+            /* Read the group directly, merging pieces that are contiguous in memory */
+            for (w = u; w < v; w++) {
+                if (w > u && segs[w].buf == (uint8_t *)op_bufs[nops - 1] + op_sizes[nops - 1])
+                    op_sizes[nops - 1] += segs[w].size;
+                else {
+                    op_types[nops]      = segs[w].type;
+                    op_addrs[nops]      = segs[w].addr;
+                    op_sizes[nops]      = segs[w].size;
+                    op_bufs[nops]       = segs[w].buf;
+                    op_bounce_off[nops] = SIZE_MAX;
+                    nops++;
+                }
+            }
+        }
+        else {
+            size_t span = (size_t)(end - start); /* Bytes to read for group */
+
+            /* Issue the pending reads if the temporary buffer would grow too large */
+            if (bounce_used + span > H5FD_VECTOR_MERGE_BUF_MAX) {
+                if (H5FD__read_vector_merged_flush(file, dxpl_id, nops, op_types, op_addrs, op_sizes, op_bufs,
+                                                   op_bounce_off, bounce, segs + round_start,
+                                                   u - round_start) < 0)
+                    HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "merged vector read failed")
+                nops        = 0;
+                bounce_used = 0;
+                round_start = u;
+            }
+
+            /* Grow the temporary buffer, if necessary */
+            if (bounce_used + span > bounce_size) {
+                size_t   new_size = MIN(MAX(bounce_used + span, 2 * bounce_size), H5FD_VECTOR_MERGE_BUF_MAX);
+                uint8_t *new_bounce;
+
+                if (NULL == (new_bounce = (uint8_t *)H5MM_realloc(bounce, new_size)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for read buffer")
+                bounce      = new_bounce;
+                bounce_size = new_size;
+            }
+
+            /* Read the group into the temporary buffer */
+            op_types[nops]      = segs[u].type;
+            op_addrs[nops]      = start;
+            op_sizes[nops]      = span;
+            op_bufs[nops]       = NULL;
+            op_bounce_off[nops] = bounce_used;
+            nops++;
+
+            for (w = u; w < v; w++)
+                segs[w].bounce_off = bounce_used + (size_t)(segs[w].addr - start);
+            bounce_used += span;
+        }
+
+        u = v;
     }
+
+    /* Issue the remaining reads */
+    if (H5FD__read_vector_merged_flush(file, dxpl_id, nops, op_types, op_addrs, op_sizes, op_bufs,
+                                       op_bounce_off, bounce, segs + round_start, count - round_start) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "merged vector read failed")
+
+done:
+    H5MM_xfree(segs);
+    H5MM_xfree(op_types);
+    H5MM_xfree(op_addrs);
+    H5MM_xfree(op_sizes);
+    H5MM_xfree(op_bufs);
+    H5MM_xfree(op_bounce_off);
+    H5MM_xfree(bounce);
+
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5FD_read_vector() */
+} /* end H5FD__read_vector_merged() */
 
 /*-------------------------------------------------------------------------
  * Function:    H5FD_write_vector
@@ -737,9 +1079,11 @@ done:
 /*-------------------------------------------------------------------------
  * Function:    H5FD__read_selection_translate
  *
- * Purpose:     Translates a selection read call to a vector read call if
- *              vector reads are supported, or a series of scalar read
- *              calls otherwise.
+ * Purpose:     Translates a selection read call to a vector read call,
+ *              which is passed to the VFD as a vector read if vector reads
+ *              are supported, or a series of scalar read calls otherwise.
+ *              Sequences that are close together in the file are merged
+ *              into single reads.
  *
  * Return:      Success:    SUCCEED
  *                          All reads have completed successfully, and
@@ -763,7 +1107,6 @@ H5FD__read_selection_translate(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, uin
     uint32_t        i;
     size_t          element_size = 0;
     void           *buf          = NULL;
-    hbool_t         use_vector   = FALSE;
     haddr_t         addrs_local[H5FD_LOCAL_VECTOR_LEN];
     haddr_t        *addrs = addrs_local;
     size_t          sizes_local[H5FD_LOCAL_VECTOR_LEN];
@@ -802,9 +1145,6 @@ H5FD__read_selection_translate(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, uin
     HDassert((element_sizes) || (count == 0));
     HDassert((bufs) || (count == 0));
 
-    /* Check if we're using vector I/O */
-    use_vector = file->cls->read_vector != NULL;
-
     if (count > 0) {
         /* Verify that the first elements of the element_sizes and bufs arrays are
          * valid. */
@@ -907,65 +1247,57 @@ H5FD__read_selection_translate(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, uin
             /* Calculate length of this IO */
             io_len = MIN(file_len[file_seq_i], mem_len[mem_seq_i]);
 
-            /* Check if we're using vector I/O */
-            if (use_vector) {
-                /* Check if we need to extend the arrays */
-                if (vec_arr_nused == vec_arr_nalloc) {
-                    /* Check if we're using the static arrays */
-                    if (addrs == addrs_local) {
-                        HDassert(sizes == sizes_local);
-                        HDassert(vec_bufs == vec_bufs_local);
-
-                        /* Allocate dynamic arrays */
-                        if (NULL == (addrs = H5MM_malloc(sizeof(addrs_local) * 2)))
-                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                        "memory allocation failed for address list")
-                        if (NULL == (sizes = H5MM_malloc(sizeof(sizes_local) * 2)))
-                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                        "memory allocation failed for size list")
-                        if (NULL == (vec_bufs = H5MM_malloc(sizeof(vec_bufs_local) * 2)))
-                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                        "memory allocation failed for buffer list")
-
-                        /* Copy the existing data */
-                        (void)H5MM_memcpy(addrs, addrs_local, sizeof(addrs_local));
-                        (void)H5MM_memcpy(sizes, sizes_local, sizeof(sizes_local));
-                        (void)H5MM_memcpy(vec_bufs, vec_bufs_local, sizeof(vec_bufs_local));
-                    }
-                    else {
-                        void *tmp_ptr;
-
-                        /* Reallocate arrays */
-                        if (NULL == (tmp_ptr = H5MM_realloc(addrs, vec_arr_nalloc * sizeof(*addrs) * 2)))
-                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                        "memory reallocation failed for address list")
-                        addrs = tmp_ptr;
-                        if (NULL == (tmp_ptr = H5MM_realloc(sizes, vec_arr_nalloc * sizeof(*sizes) * 2)))
-                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                        "memory reallocation failed for size list")
-                        sizes = tmp_ptr;
-                        if (NULL ==
-                            (tmp_ptr = H5MM_realloc(vec_bufs, vec_arr_nalloc * sizeof(*vec_bufs) * 2)))
-                            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
-                                        "memory reallocation failed for buffer list")
-                        vec_bufs = tmp_ptr;
-                    }
-
-                    /* Record that we've doubled the array sizes */
-                    vec_arr_nalloc *= 2;
+            /* Check if we need to extend the arrays */
+            if (vec_arr_nused == vec_arr_nalloc) {
+                /* Check if we're using the static arrays */
+                if (addrs == addrs_local) {
+                    HDassert(sizes == sizes_local);
+                    HDassert(vec_bufs == vec_bufs_local);
+
+                    /* Allocate dynamic arrays */
+                    if (NULL == (addrs = H5MM_malloc(sizeof(addrs_local) * 2)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                    "memory allocation failed for address list")
+                    if (NULL == (sizes = H5MM_malloc(sizeof(sizes_local) * 2)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                    "memory allocation failed for size list")
+                    if (NULL == (vec_bufs = H5MM_malloc(sizeof(vec_bufs_local) * 2)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                    "memory allocation failed for buffer list")
+
+                    /* Copy the existing data */
+                    (void)H5MM_memcpy(addrs, addrs_local, sizeof(addrs_local));
+                    (void)H5MM_memcpy(sizes, sizes_local, sizeof(sizes_local));
+                    (void)H5MM_memcpy(vec_bufs, vec_bufs_local, sizeof(vec_bufs_local));
+                }
+                else {
+                    void *tmp_ptr;
+
+                    /* Reallocate arrays */
+                    if (NULL == (tmp_ptr = H5MM_realloc(addrs, vec_arr_nalloc * sizeof(*addrs) * 2)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                    "memory reallocation failed for address list")
+                    addrs = tmp_ptr;
+                    if (NULL == (tmp_ptr = H5MM_realloc(sizes, vec_arr_nalloc * sizeof(*sizes) * 2)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                    "memory reallocation failed for size list")
+                    sizes = tmp_ptr;
+                    if (NULL ==
+                        (tmp_ptr = H5MM_realloc(vec_bufs, vec_arr_nalloc * sizeof(*vec_bufs) * 2)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL,
+                                    "memory reallocation failed for buffer list")
+                    vec_bufs = tmp_ptr;
                 }
 
-                /* Add this segment to vector read list */
-                addrs[vec_arr_nused]    = offsets[i] + file_off[file_seq_i];
-                sizes[vec_arr_nused]    = io_len;
-                vec_bufs[vec_arr_nused] = (void *)((uint8_t *)buf + mem_off[mem_seq_i]);
-                vec_arr_nused++;
+                /* Record that we've doubled the array sizes */
+                vec_arr_nalloc *= 2;
             }
-            else
-                /* Issue scalar read call */
-                if ((file->cls->read)(file, type, dxpl_id, offsets[i] + file_off[file_seq_i], io_len,
-                                      (void *)((uint8_t *)buf + mem_off[mem_seq_i])) < 0)
-                    HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read request failed")
+
+            /* Add this segment to vector read list */
+            addrs[vec_arr_nused]    = offsets[i] + file_off[file_seq_i];
+            sizes[vec_arr_nused]    = io_len;
+            vec_bufs[vec_arr_nused] = (void *)((uint8_t *)buf + mem_off[mem_seq_i]);
+            vec_arr_nused++;
 
             /* Update file sequence */
             if (io_len == file_len[file_seq_i])
@@ -997,21 +1329,10 @@ H5FD__read_selection_translate(H5FD_t *file, H5FD_mem_t type, hid_t dxpl_id, uin
         mem_iter_init = FALSE;
     }
 
-    /* Issue vector read call if appropriate */
-    if (use_vector) {
-        H5_CHECK_OVERFLOW(vec_arr_nused, size_t, uint32_t)
-        if ((file->cls->read_vector)(file, dxpl_id, (uint32_t)vec_arr_nused, types, addrs, sizes, vec_bufs) <
-            0)
-            HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "driver read vector request failed")
-    }
-    else {
-        uint32_t no_selection_io_cause;
-
-        /* Add H5D_SEL_IO_NO_VECTOR_OR_SELECTION_IO_CB to no selection I/O cause */
-        H5CX_get_no_selection_io_cause(&no_selection_io_cause);
-        no_selection_io_cause |= H5D_SEL_IO_NO_VECTOR_OR_SELECTION_IO_CB;
-        H5CX_set_no_selection_io_cause(no_selection_io_cause);
-    }
+    /* Issue the vector read, merging pieces that are close together in the file */
+    H5_CHECK_OVERFLOW(vec_arr_nused, size_t, uint32_t)
+    if (H5FD__read_vector_merged(file, dxpl_id, (uint32_t)vec_arr_nused, types, addrs, sizes, vec_bufs) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_READERROR, FAIL, "vector read request failed")
 
 done:
     /* Terminate and free iterators */
@@ -1027,14 +1348,12 @@ done:
     }
 
     /* Cleanup vector arrays */
-    if (use_vector) {
-        if (addrs != addrs_local)
-            addrs = H5MM_xfree(addrs);
-        if (sizes != sizes_local)
-            sizes = H5MM_xfree(sizes);
-        if (vec_bufs != vec_bufs_local)
-            vec_bufs = H5MM_xfree(vec_bufs);
-    }
+    if (addrs != addrs_local)
+        addrs = H5MM_xfree(addrs);
+    if (sizes != sizes_local)
+        sizes = H5MM_xfree(sizes);
+    if (vec_bufs != vec_bufs_local)
+        vec_bufs = H5MM_xfree(vec_bufs);
 
     /* Make sure we cleaned up */
     HDassert(!addrs || addrs == addrs_local);
@@ -2121,6 +2440,54 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD_get_eof() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_get_mapped_region
+ *
+ * Purpose:     Retrieves the part of the file that the driver keeps mapped
+ *              into memory, so that reads of it can be served by copying
+ *              from memory.  *BASE is set to the memory holding RELATIVE
+ *              address 0 and *SIZE to the number of bytes from there that
+ *              are mapped.  If the driver doesn't map the file, *BASE is
+ *              set to NULL and *SIZE to 0.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5FD_get_mapped_region(H5FD_t *file, const void **base /*out*/, haddr_t *size /*out*/)
+{
+    H5FD_ctl_mapped_region_t  region     = {NULL, 0}; /* Region reported by the driver */
+    H5FD_ctl_mapped_region_t *region_ptr = &region;
+    herr_t                    ret_value  = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(file && file->cls);
+    HDassert(base);
+    HDassert(size);
+
+    /* Only ask drivers that map the file.  The feature flags were queried
+     * when the file was opened. */
+    if (file->feature_flags & H5FD_FEAT_MAPPED_REGION)
+        if (H5FD_ctl(file, H5FD_CTL_GET_MAPPED_REGION_OPCODE, H5FD_CTL_FAIL_IF_UNKNOWN_FLAG, NULL,
+                     (void **)&region_ptr) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_FCNTL, FAIL, "driver mapped region request failed")
+
+    /* Adjust for base address in file (convert to relative address)  */
+    if (region.base && region.size > file->base_addr) {
+        *base = (const unsigned char *)region.base + file->base_addr;
+        *size = region.size - file->base_addr;
+    } /* end if */
+    else {
+        *base = NULL;
+        *size = 0;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_get_mapped_region() */
+
 /*-------------------------------------------------------------------------
  * Function:     H5FD_driver_query
  *
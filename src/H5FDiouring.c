@@ -0,0 +1,1584 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose: The io_uring file driver stores a file like the sec2 driver, but
+ *          transfers data through a Linux io_uring instance.  All pieces of
+ *          a vector request are submitted together, up to the queue depth,
+ *          and their completions are reaped together, so one thread can
+ *          keep many requests in flight.  Optionally, data is staged
+ *          through buffers registered with the ring, and the file is
+ *          opened with O_DIRECT.
+ *
+ *          The ring is driven with the raw io_uring_setup(),
+ *          io_uring_enter() and io_uring_register() system calls, so no
+ *          additional library is needed.
+ */
+
+#include "H5FDdrvr_module.h" /* This source code file is part of the H5FD driver module */
+
+#include "H5private.h"    /* Generic Functions        */
+#include "H5Eprivate.h"   /* Error handling           */
+#include "H5Fprivate.h"   /* File access              */
+#include "H5FDprivate.h"  /* File drivers             */
+#include "H5FDiouring.h"  /* io_uring file driver     */
+#include "H5FLprivate.h"  /* Free Lists               */
+#include "H5Iprivate.h"   /* IDs                      */
+#include "H5MMprivate.h"  /* Memory management        */
+#include "H5Pprivate.h"   /* Property lists           */
+
+#ifdef H5_HAVE_IOURING_VFD
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/* The driver identification number, initialized at runtime */
+static hid_t H5FD_IOURING_g = 0;
+
+/* Whether to ignore file locks when disabled (env var value) */
+static htri_t ignore_disabled_file_locks_s = FAIL;
+
+/* Largest number of bytes transferred by one request to the ring */
+#define H5FD_IOURING_MAX_IO ((size_t)1 << 30)
+
+/* Largest queue depth accepted by H5Pset_fapl_iouring() */
+#define H5FD_IOURING_QUEUE_DEPTH_MAX 4096
+
+/* Round A down and up to a multiple of the O_DIRECT block size */
+#define H5FD_IOURING_ALIGN_DOWN(A) ((A) & ~(haddr_t)(H5FD_IOURING_BLOCK_SIZE - 1))
+#define H5FD_IOURING_ALIGN_UP(A)   H5FD_IOURING_ALIGN_DOWN((A) + (H5FD_IOURING_BLOCK_SIZE - 1))
+
+/* Access to the ring indices shared with the kernel */
+#define H5FD_IOURING_LOAD_ACQUIRE(P)     __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#define H5FD_IOURING_STORE_RELEASE(P, V) __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+
+/* Driver-specific file access properties */
+typedef struct H5FD_iouring_fapl_t {
+    unsigned queue_depth; /* Number of submission queue entries */
+    unsigned flags;       /* H5FD_IOURING_* flags               */
+    size_t   buf_size;    /* Size of each staging buffer        */
+} H5FD_iouring_fapl_t;
+
+/* States of a request slot */
+typedef enum H5FD_iouring_slot_state_t {
+    H5FD_IOURING_SLOT_FREE = 0, /* Not in use                                      */
+    H5FD_IOURING_SLOT_READ,     /* Reading data for the caller                     */
+    H5FD_IOURING_SLOT_RMW_READ, /* Reading the blocks an unaligned write will fill */
+    H5FD_IOURING_SLOT_WRITE     /* Writing data from the caller                    */
+} H5FD_iouring_slot_state_t;
+
+/* One request in flight.  When data is staged, slot i owns staging buffer i,
+ * and the caller's piece is the USER_LEN bytes at USER_OFF in the buffer. */
+typedef struct H5FD_iouring_slot_t {
+    H5FD_iouring_slot_state_t state;    /* What the slot is doing                    */
+    struct iovec              iov;      /* Memory for the request                    */
+    haddr_t                   addr;     /* File address of the request               */
+    size_t                    len;      /* Size of the request                       */
+    size_t                    done;     /* Bytes transferred so far                  */
+    uint8_t                  *user_buf; /* Caller's buffer, when data is staged      */
+    size_t                    user_off; /* Offset of caller's piece in buffer         */
+    size_t                    user_len; /* Size of caller's piece                    */
+} H5FD_iouring_slot_t;
+
+/*
+ * The description of a file belonging to this driver.  The 'eoa' and 'eof'
+ * determine the amount of hdf5 address space in use and the high-water mark
+ * of the file, as for the sec2 driver.  In the O_DIRECT mode, writes are
+ * rounded out to whole blocks, so the underlying file can be longer than
+ * 'eof' until the file is truncated.
+ */
+typedef struct H5FD_iouring_t {
+    H5FD_t              pub; /* public stuff, must be first      */
+    int                 fd;  /* the filesystem file descriptor   */
+    haddr_t             eoa; /* end of allocated region          */
+    haddr_t             eof; /* end of file; current file size   */
+    H5FD_iouring_fapl_t fa;  /* file access properties           */
+    hbool_t             ignore_disabled_file_locks;
+    char                filename[H5FD_MAX_FILENAME_LEN]; /* Copy of file name from open operation */
+    dev_t               device;                          /* file device number   */
+    ino_t               inode;                           /* file i-node number   */
+
+    /* The ring */
+    int                  ring_fd;     /* io_uring file descriptor             */
+    void                *sq_ring;     /* Mapped submission queue ring          */
+    size_t               sq_ring_sz;  /* Size of submission queue ring mapping */
+    void                *cq_ring;     /* Mapped completion queue ring          */
+    size_t               cq_ring_sz;  /* Size of completion queue ring mapping */
+    struct io_uring_sqe *sqes;        /* Mapped submission queue entries       */
+    size_t               sqes_sz;     /* Size of submission queue entries      */
+    unsigned            *sq_tail;     /* Submission queue tail                 */
+    unsigned            *sq_mask;     /* Submission queue index mask           */
+    unsigned            *sq_array;    /* Submission queue index array          */
+    unsigned            *cq_head;     /* Completion queue head                 */
+    unsigned            *cq_tail;     /* Completion queue tail                 */
+    unsigned            *cq_mask;     /* Completion queue index mask           */
+    struct io_uring_cqe *cqes;        /* Completion queue entries              */
+    unsigned             nqueued;     /* Entries queued but not yet submitted  */
+    unsigned             ninflight;   /* Entries queued or submitted           */
+    int                  io_errno;    /* First error seen by a request         */
+    H5FD_iouring_slot_t *slots;       /* Request slots (queue_depth of them)   */
+    unsigned            *free_slots;  /* Stack of free slot indices            */
+    unsigned             nfree_slots; /* Number of free slots                  */
+    uint8_t             *staging;     /* Staging buffers, or NULL              */
+    hbool_t              registered;  /* Staging buffers registered with ring    */
+
+    /* Information from properties set by 'h5repart' tool */
+    hbool_t fam_to_single;
+} H5FD_iouring_t;
+
+/*
+ * These macros check for overflow of various quantities.  These macros
+ * assume that HDoff_t is signed and haddr_t and size_t are unsigned.
+ *
+ * ADDR_OVERFLOW:   Checks whether a file address of type `haddr_t'
+ *                  is too large to be represented by the second argument
+ *                  of the file seek function.
+ *
+ * SIZE_OVERFLOW:   Checks whether a buffer size of type `hsize_t' is too
+ *                  large to be represented by the `size_t' type.
+ *
+ * REGION_OVERFLOW: Checks whether an address and size pair describe data
+ *                  which can be addressed entirely by the second
+ *                  argument of the file seek function.
+ */
+#define MAXADDR          (((haddr_t)1 << (8 * sizeof(HDoff_t) - 1)) - 1)
+#define ADDR_OVERFLOW(A) (HADDR_UNDEF == (A) || ((A) & ~(haddr_t)MAXADDR))
+#define SIZE_OVERFLOW(Z) ((Z) & ~(hsize_t)MAXADDR)
+#define REGION_OVERFLOW(A, Z)                                                                                \
+    (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) || HADDR_UNDEF == (A) + (Z) || (HDoff_t)((A) + (Z)) < (HDoff_t)(A))
+
+/* Prototypes */
+static herr_t  H5FD__iouring_term(void);
+static herr_t  H5FD__iouring_populate_config(unsigned queue_depth, unsigned flags, size_t buf_size,
+                                             H5FD_iouring_fapl_t *fa_out);
+static void   *H5FD__iouring_fapl_get(H5FD_t *file);
+static void   *H5FD__iouring_fapl_copy(const void *_old_fa);
+static herr_t  H5FD__iouring_ring_init(H5FD_iouring_t *file);
+static void    H5FD__iouring_ring_term(H5FD_iouring_t *file);
+static H5FD_t *H5FD__iouring_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr);
+static herr_t  H5FD__iouring_close(H5FD_t *_file);
+static int     H5FD__iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2);
+static herr_t  H5FD__iouring_query(const H5FD_t *_f1, unsigned long *flags);
+static haddr_t H5FD__iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t  H5FD__iouring_set_eoa(H5FD_t *_file, H5FD_mem_t type, haddr_t addr);
+static haddr_t H5FD__iouring_get_eof(const H5FD_t *_file, H5FD_mem_t type);
+static herr_t  H5FD__iouring_get_handle(H5FD_t *_file, hid_t fapl, void **file_handle);
+static void    H5FD__iouring_queue(H5FD_iouring_t *file, unsigned slot_idx);
+static herr_t  H5FD__iouring_wait(H5FD_iouring_t *file, unsigned min_complete);
+static herr_t  H5FD__iouring_vector_io(H5FD_iouring_t *file, hbool_t do_write, uint32_t count,
+                                       haddr_t addrs[], size_t sizes[], H5_flexible_const_ptr_t bufs[]);
+static herr_t  H5FD__iouring_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr, size_t size,
+                                  void *buf);
+static herr_t  H5FD__iouring_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr, size_t size,
+                                   const void *buf);
+static herr_t  H5FD__iouring_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[],
+                                         haddr_t addrs[], size_t sizes[], void *bufs[]);
+static herr_t  H5FD__iouring_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[],
+                                          haddr_t addrs[], size_t sizes[], const void *bufs[]);
+static herr_t  H5FD__iouring_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
+static herr_t  H5FD__iouring_lock(H5FD_t *_file, hbool_t rw);
+static herr_t  H5FD__iouring_unlock(H5FD_t *_file);
+static herr_t  H5FD__iouring_delete(const char *filename, hid_t fapl_id);
+
+static const H5FD_class_t H5FD_iouring_g = {
+    H5FD_CLASS_VERSION,          /* struct version       */
+    H5FD_IOURING_VALUE,          /* value                */
+    "iouring",                   /* name                 */
+    MAXADDR,                     /* maxaddr              */
+    H5F_CLOSE_WEAK,              /* fc_degree            */
+    H5FD__iouring_term,          /* terminate            */
+    NULL,                        /* sb_size              */
+    NULL,                        /* sb_encode            */
+    NULL,                        /* sb_decode            */
+    sizeof(H5FD_iouring_fapl_t), /* fapl_size            */
+    H5FD__iouring_fapl_get,      /* fapl_get             */
+    H5FD__iouring_fapl_copy,     /* fapl_copy            */
+    NULL,                        /* fapl_free            */
+    0,                           /* dxpl_size            */
+    NULL,                        /* dxpl_copy            */
+    NULL,                        /* dxpl_free            */
+    H5FD__iouring_open,          /* open                 */
+    H5FD__iouring_close,         /* close                */
+    H5FD__iouring_cmp,           /* cmp                  */
+    H5FD__iouring_query,         /* query                */
+    NULL,                        /* get_type_map         */
+    NULL,                        /* alloc                */
+    NULL,                        /* free                 */
+    H5FD__iouring_get_eoa,       /* get_eoa              */
+    H5FD__iouring_set_eoa,       /* set_eoa              */
+    H5FD__iouring_get_eof,       /* get_eof              */
+    H5FD__iouring_get_handle,    /* get_handle           */
+    H5FD__iouring_read,          /* read                 */
+    H5FD__iouring_write,         /* write                */
+    H5FD__iouring_read_vector,   /* read_vector          */
+    H5FD__iouring_write_vector,  /* write_vector         */
+    NULL,                        /* read_selection       */
+    NULL,                        /* write_selection      */
+    NULL,                        /* flush                */
+    H5FD__iouring_truncate,      /* truncate             */
+    H5FD__iouring_lock,          /* lock                 */
+    H5FD__iouring_unlock,        /* unlock               */
+    H5FD__iouring_delete,        /* del                  */
+    NULL,                        /* ctl                  */
+    H5FD_FLMAP_DICHOTOMY         /* fl_map               */
+};
+
+/* Declare a free list to manage the H5FD_iouring_t struct */
+H5FL_DEFINE_STATIC(H5FD_iouring_t);
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD_iouring_init
+ *
+ * Purpose:     Initialize this driver by registering the driver with the
+ *              library.
+ *
+ * Return:      Success:    The driver ID for the io_uring driver
+ *              Failure:    H5I_INVALID_HID
+ *
+ *-------------------------------------------------------------------------
+ */
+hid_t
+H5FD_iouring_init(void)
+{
+    char *lock_env_var = NULL;            /* Environment variable pointer */
+    hid_t ret_value    = H5I_INVALID_HID; /* Return value */
+
+    FUNC_ENTER_NOAPI(H5I_INVALID_HID)
+
+    /* Check the use disabled file locks environment variable */
+    lock_env_var = HDgetenv(HDF5_USE_FILE_LOCKING);
+    if (lock_env_var && !HDstrcmp(lock_env_var, "BEST_EFFORT"))
+        ignore_disabled_file_locks_s = TRUE; /* Override: Ignore disabled locks */
+    else if (lock_env_var && (!HDstrcmp(lock_env_var, "TRUE") || !HDstrcmp(lock_env_var, "1")))
+        ignore_disabled_file_locks_s = FALSE; /* Override: Don't ignore disabled locks */
+    else
+        ignore_disabled_file_locks_s = FAIL; /* Environment variable not set, or not set correctly */
+
+    if (H5I_VFL != H5I_get_type(H5FD_IOURING_g)) {
+        H5FD_IOURING_g = H5FD_register(&H5FD_iouring_g, sizeof(H5FD_class_t), FALSE);
+        if (H5I_INVALID_HID == H5FD_IOURING_g)
+            HGOTO_ERROR(H5E_ID, H5E_CANTREGISTER, H5I_INVALID_HID, "unable to register iouring");
+    }
+
+    /* Set return value */
+    ret_value = H5FD_IOURING_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD_iouring_init() */
+
+/*---------------------------------------------------------------------------
+ * Function:    H5FD__iouring_term
+ *
+ * Purpose:     Shut down the VFD
+ *
+ * Returns:     SUCCEED (Can't fail)
+ *
+ *---------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_term(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Reset VFL ID */
+    H5FD_IOURING_g = 0;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD__iouring_term() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_fapl_iouring
+ *
+ * Purpose:     Modify the file access property list to use the
+ *              H5FD_IOURING driver defined in this source file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_fapl_iouring(hid_t fapl_id, unsigned queue_depth, unsigned flags, size_t buf_size)
+{
+    H5P_genplist_t     *plist; /* Property list pointer */
+    H5FD_iouring_fapl_t fa;
+    herr_t              ret_value;
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "iIuIuz", fapl_id, queue_depth, flags, buf_size);
+
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access property list")
+
+    if (H5FD__iouring_populate_config(queue_depth, flags, buf_size, &fa) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTSET, FAIL, "can't initialize driver configuration info")
+
+    ret_value = H5P_set_driver(plist, H5FD_IOURING, &fa, NULL);
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_fapl_iouring() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_fapl_iouring
+ *
+ * Purpose:     Returns information about the io_uring file access
+ *              property list through the function arguments.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_fapl_iouring(hid_t fapl_id, unsigned *queue_depth /*out*/, unsigned *flags /*out*/,
+                    size_t *buf_size /*out*/)
+{
+    H5P_genplist_t            *plist; /* Property list pointer */
+    const H5FD_iouring_fapl_t *fa;
+    herr_t                     ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "ixxx", fapl_id, queue_depth, flags, buf_size);
+
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a file access list")
+    if (H5FD_IOURING != H5P_peek_driver(plist))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "incorrect VFL driver")
+    if (NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_peek_driver_info(plist)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "bad VFL driver info")
+    if (queue_depth)
+        *queue_depth = fa->queue_depth;
+    if (flags)
+        *flags = fa->flags;
+    if (buf_size)
+        *buf_size = fa->buf_size;
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_fapl_iouring() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_populate_config
+ *
+ * Purpose:     Populates a H5FD_iouring_fapl_t structure with the provided
+ *              values, supplying defaults where values are not provided.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_populate_config(unsigned queue_depth, unsigned flags, size_t buf_size,
+                              H5FD_iouring_fapl_t *fa_out)
+{
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(fa_out);
+
+    HDmemset(fa_out, 0, sizeof(H5FD_iouring_fapl_t));
+
+    if (queue_depth > H5FD_IOURING_QUEUE_DEPTH_MAX)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "queue depth must not be larger than %u",
+                    (unsigned)H5FD_IOURING_QUEUE_DEPTH_MAX)
+    if (flags & ~(H5FD_IOURING_DIRECT_IO | H5FD_IOURING_REGISTER_BUFFERS))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "unknown io_uring driver flags")
+
+    fa_out->queue_depth = queue_depth ? queue_depth : H5FD_IOURING_QUEUE_DEPTH_DEF;
+    fa_out->flags       = flags;
+    fa_out->buf_size    = buf_size ? buf_size : H5FD_IOURING_BUF_SIZE_DEF;
+
+    /* Staging buffers are read and written whole blocks at a time in the
+     * O_DIRECT mode */
+    if (fa_out->buf_size % H5FD_IOURING_BLOCK_SIZE != 0 || fa_out->buf_size > H5FD_IOURING_MAX_IO)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL,
+                    "staging buffer size must be a multiple of %u bytes, up to 1 GiB",
+                    (unsigned)H5FD_IOURING_BLOCK_SIZE)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_populate_config() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_fapl_get
+ *
+ * Purpose:     Returns a file access property list which indicates how the
+ *              specified file is being accessed. The return list could be
+ *              used to access another file the same way.
+ *
+ * Return:      Success:    Ptr to new file access property list with all
+ *                          members copied from the file struct.
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD__iouring_fapl_get(H5FD_t *_file)
+{
+    H5FD_iouring_t *file      = (H5FD_iouring_t *)_file;
+    void           *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Set return value */
+    ret_value = H5FD__iouring_fapl_copy(&(file->fa));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_fapl_get() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_fapl_copy
+ *
+ * Purpose:     Copies the io_uring-specific file access properties.
+ *
+ * Return:      Success:    Ptr to a new property list
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5FD__iouring_fapl_copy(const void *_old_fa)
+{
+    const H5FD_iouring_fapl_t *old_fa    = (const H5FD_iouring_fapl_t *)_old_fa;
+    H5FD_iouring_fapl_t       *new_fa    = NULL;
+    void                      *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (NULL == (new_fa = (H5FD_iouring_fapl_t *)H5MM_malloc(sizeof(H5FD_iouring_fapl_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, NULL, "memory allocation failed")
+
+    /* Copy the general information */
+    H5MM_memcpy(new_fa, old_fa, sizeof(H5FD_iouring_fapl_t));
+
+    /* Set return value */
+    ret_value = new_fa;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_fapl_copy() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_ring_init
+ *
+ * Purpose:     Creates the file's io_uring instance, maps its rings, and
+ *              sets up the request slots and staging buffers.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_ring_init(H5FD_iouring_t *file)
+{
+    struct io_uring_params params;
+    unsigned               u;
+    herr_t                 ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file);
+    HDassert(file->ring_fd < 0);
+
+    /* Create the ring */
+    HDmemset(&params, 0, sizeof(params));
+    if ((file->ring_fd = (int)syscall(__NR_io_uring_setup, file->fa.queue_depth, &params)) < 0)
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to create io_uring instance")
+
+    /* Map the submission and completion queue rings, which the kernel may
+     * provide as a single mapping */
+    file->sq_ring_sz = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    file->cq_ring_sz = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        file->sq_ring_sz = file->cq_ring_sz = MAX(file->sq_ring_sz, file->cq_ring_sz);
+    if (MAP_FAILED == (file->sq_ring = mmap(NULL, file->sq_ring_sz, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, file->ring_fd, IORING_OFF_SQ_RING))) {
+        file->sq_ring = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue")
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        file->cq_ring = file->sq_ring;
+    else if (MAP_FAILED == (file->cq_ring = mmap(NULL, file->cq_ring_sz, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE, file->ring_fd,
+                                                 IORING_OFF_CQ_RING))) {
+        file->cq_ring = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring completion queue")
+    }
+    file->sqes_sz = params.sq_entries * sizeof(struct io_uring_sqe);
+    if (MAP_FAILED == (file->sqes = (struct io_uring_sqe *)mmap(NULL, file->sqes_sz, PROT_READ | PROT_WRITE,
+                                                               MAP_SHARED | MAP_POPULATE, file->ring_fd,
+                                                               IORING_OFF_SQES))) {
+        file->sqes = NULL;
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTINIT, FAIL, "unable to map io_uring submission queue entries")
+    }
+
+    file->sq_tail  = (unsigned *)(void *)((uint8_t *)file->sq_ring + params.sq_off.tail);
+    file->sq_mask  = (unsigned *)(void *)((uint8_t *)file->sq_ring + params.sq_off.ring_mask);
+    file->sq_array = (unsigned *)(void *)((uint8_t *)file->sq_ring + params.sq_off.array);
+    file->cq_head  = (unsigned *)(void *)((uint8_t *)file->cq_ring + params.cq_off.head);
+    file->cq_tail  = (unsigned *)(void *)((uint8_t *)file->cq_ring + params.cq_off.tail);
+    file->cq_mask  = (unsigned *)(void *)((uint8_t *)file->cq_ring + params.cq_off.ring_mask);
+    file->cqes     = (struct io_uring_cqe *)(void *)((uint8_t *)file->cq_ring + params.cq_off.cqes);
+
+    /* The kernel rounds the queue depth up to a power of two; keep no more
+     * requests in flight than were asked for */
+    HDassert(params.sq_entries >= file->fa.queue_depth);
+
+    /* Set up the request slots */
+    if (NULL == (file->slots = (H5FD_iouring_slot_t *)H5MM_calloc(file->fa.queue_depth *
+                                                                  sizeof(H5FD_iouring_slot_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "unable to allocate request slots")
+    if (NULL == (file->free_slots = (unsigned *)H5MM_malloc(file->fa.queue_depth * sizeof(unsigned))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "unable to allocate request slots")
+    for (u = 0; u < file->fa.queue_depth; u++)
+        file->free_slots[u] = file->fa.queue_depth - u - 1;
+    file->nfree_slots = file->fa.queue_depth;
+
+    /* Set up the staging buffers, one per slot */
+    if (file->fa.flags & (H5FD_IOURING_DIRECT_IO | H5FD_IOURING_REGISTER_BUFFERS)) {
+        void *staging = NULL;
+
+        /* NOTE: Use HDfree to release this buffer, to be compatible with
+         *       HDposix_memalign.
+         */
+        if (HDposix_memalign(&staging, H5FD_IOURING_BLOCK_SIZE, file->fa.queue_depth * file->fa.buf_size) !=
+            0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "unable to allocate staging buffers")
+        file->staging = (uint8_t *)staging;
+
+        /* Register the buffers with the ring, if requested.  Registration
+         * pins the buffers in memory and can fail because of the limit on
+         * locked memory, in which case the buffers are used unregistered. */
+        if (file->fa.flags & H5FD_IOURING_REGISTER_BUFFERS) {
+            struct iovec *iovs;
+
+            if (NULL == (iovs = (struct iovec *)H5MM_malloc(file->fa.queue_depth * sizeof(struct iovec))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "unable to allocate buffer list")
+            for (u = 0; u < file->fa.queue_depth; u++) {
+                iovs[u].iov_base = file->staging + (size_t)u * file->fa.buf_size;
+                iovs[u].iov_len  = file->fa.buf_size;
+            }
+            file->registered = (0 == syscall(__NR_io_uring_register, file->ring_fd, IORING_REGISTER_BUFFERS,
+                                             iovs, file->fa.queue_depth));
+            H5MM_xfree(iovs);
+        }
+    }
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_ring_init() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_ring_term
+ *
+ * Purpose:     Releases the file's io_uring instance, request slots and
+ *              staging buffers.  No requests may be in flight.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD__iouring_ring_term(H5FD_iouring_t *file)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(file);
+    HDassert(0 == file->ninflight);
+
+    if (file->sqes)
+        munmap(file->sqes, file->sqes_sz);
+    if (file->cq_ring && file->cq_ring != file->sq_ring)
+        munmap(file->cq_ring, file->cq_ring_sz);
+    if (file->sq_ring)
+        munmap(file->sq_ring, file->sq_ring_sz);
+    if (file->ring_fd >= 0)
+        HDclose(file->ring_fd);
+    file->sqes    = NULL;
+    file->cq_ring = NULL;
+    file->sq_ring = NULL;
+    file->ring_fd = -1;
+
+    if (file->staging)
+        HDfree(file->staging);
+    file->staging    = NULL;
+    file->slots      = (H5FD_iouring_slot_t *)H5MM_xfree(file->slots);
+    file->free_slots = (unsigned *)H5MM_xfree(file->free_slots);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD__iouring_ring_term() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_open
+ *
+ * Purpose:     Create and/or opens a file as an HDF5 file.
+ *
+ * Return:      Success:    A pointer to a new file data structure. The
+ *                          public fields will be initialized by the
+ *                          caller, which is always H5FD_open().
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5FD_t *
+H5FD__iouring_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr)
+{
+    H5FD_iouring_t            *file = NULL; /* io_uring VFD info        */
+    int                        fd   = -1;   /* File descriptor          */
+    int                        o_flags;     /* Flags for open() call    */
+    const H5FD_iouring_fapl_t *fa;
+    H5FD_iouring_fapl_t        default_fa;
+    h5_stat_t                  sb;
+    H5P_genplist_t            *plist;            /* Property list pointer */
+    H5FD_t                    *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check on file offsets */
+    HDcompile_assert(sizeof(HDoff_t) >= sizeof(size_t));
+
+    /* Check arguments */
+    if (!name || !*name)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid file name")
+    if (0 == maxaddr || HADDR_UNDEF == maxaddr)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, NULL, "bogus maxaddr")
+    if (ADDR_OVERFLOW(maxaddr))
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, NULL, "bogus maxaddr")
+
+    /* Get the driver specific information */
+    if (NULL == (plist = H5P_object_verify(fapl_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "not a file access property list")
+    if (NULL == (fa = (const H5FD_iouring_fapl_t *)H5P_peek_driver_info(plist))) {
+        if (H5FD__iouring_populate_config(0, 0, 0, &default_fa) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_CANTSET, NULL, "can't initialize driver configuration info")
+        fa = &default_fa;
+    }
+
+    /* Build the open flags */
+    o_flags = (H5F_ACC_RDWR & flags) ? O_RDWR : O_RDONLY;
+    if (H5F_ACC_TRUNC & flags)
+        o_flags |= O_TRUNC;
+    if (H5F_ACC_CREAT & flags)
+        o_flags |= O_CREAT;
+    if (H5F_ACC_EXCL & flags)
+        o_flags |= O_EXCL;
+    if (fa->flags & H5FD_IOURING_DIRECT_IO)
+        o_flags |= O_DIRECT;
+
+    /* Open the file */
+    if ((fd = HDopen(name, o_flags, H5_POSIX_CREATE_MODE_RW)) < 0) {
+        int myerrno = errno;
+        HGOTO_ERROR(
+            H5E_FILE, H5E_CANTOPENFILE, NULL,
+            "unable to open file: name = '%s', errno = %d, error message = '%s', flags = %x, o_flags = %x",
+            name, myerrno, HDstrerror(myerrno), flags, (unsigned)o_flags);
+    } /* end if */
+
+    if (HDfstat(fd, &sb) < 0)
+        HSYS_GOTO_ERROR(H5E_FILE, H5E_BADFILE, NULL, "unable to fstat file")
+
+    /* Create the new file struct */
+    if (NULL == (file = H5FL_CALLOC(H5FD_iouring_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to allocate file struct")
+
+    file->fd = fd;
+    H5_CHECKED_ASSIGN(file->eof, haddr_t, sb.st_size, h5_stat_size_t);
+    file->device  = sb.st_dev;
+    file->inode   = sb.st_ino;
+    file->fa      = *fa;
+    file->ring_fd = -1;
+
+    /* Check the file locking flags in the fapl */
+    if (ignore_disabled_file_locks_s != FAIL)
+        /* The environment variable was set, so use that preferentially */
+        file->ignore_disabled_file_locks = ignore_disabled_file_locks_s;
+    else {
+        /* Use the value in the property list */
+        if (H5P_get(plist, H5F_ACS_IGNORE_DISABLED_FILE_LOCKS_NAME, &file->ignore_disabled_file_locks) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_CANTGET, NULL, "can't get ignore disabled file locks property")
+    }
+
+    /* Retain a copy of the name used to open the file, for possible error reporting */
+    HDstrncpy(file->filename, name, sizeof(file->filename));
+    file->filename[sizeof(file->filename) - 1] = '\0';
+
+    /* Check for non-default FAPL */
+    if (H5P_FILE_ACCESS_DEFAULT != fapl_id) {
+        /* This step is for h5repart tool only. If user wants to change file driver from
+         * family to one that uses single files (sec2, etc.) while using h5repart, this
+         * private property should be set so that in the later step, the library can ignore
+         * the family driver information saved in the superblock.
+         */
+        if (H5P_exist_plist(plist, H5F_ACS_FAMILY_TO_SINGLE_NAME) > 0)
+            if (H5P_get(plist, H5F_ACS_FAMILY_TO_SINGLE_NAME, &file->fam_to_single) < 0)
+                HGOTO_ERROR(H5E_VFL, H5E_CANTGET, NULL, "can't get property of changing family to single")
+    } /* end if */
+
+    /* Set up the ring */
+    if (H5FD__iouring_ring_init(file) < 0)
+        HGOTO_ERROR(H5E_VFL, H5E_CANTINIT, NULL, "unable to set up io_uring instance")
+
+    /* Set return value */
+    ret_value = (H5FD_t *)file;
+
+done:
+    if (NULL == ret_value) {
+        if (file) {
+            H5FD__iouring_ring_term(file);
+            file = H5FL_FREE(H5FD_iouring_t, file);
+        } /* end if */
+        if (fd >= 0)
+            HDclose(fd);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_open() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_close
+ *
+ * Purpose:     Closes an HDF5 file.
+ *
+ * Return:      Success:    SUCCEED
+ *              Failure:    FAIL, file not closed.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_close(H5FD_t *_file)
+{
+    H5FD_iouring_t *file      = (H5FD_iouring_t *)_file;
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity check */
+    HDassert(file);
+
+    /* Release the ring */
+    H5FD__iouring_ring_term(file);
+
+    /* Close the underlying file */
+    if (HDclose(file->fd) < 0)
+        HSYS_GOTO_ERROR(H5E_IO, H5E_CANTCLOSEFILE, FAIL, "unable to close file")
+
+    /* Release the file info */
+    file = H5FL_FREE(H5FD_iouring_t, file);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_close() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_cmp
+ *
+ * Purpose:     Compares two files belonging to this driver using an
+ *              arbitrary (but consistent) ordering.
+ *
+ * Return:      Success:    A value like strcmp()
+ *              Failure:    never fails (arguments were checked by the
+ *                          caller).
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5FD__iouring_cmp(const H5FD_t *_f1, const H5FD_t *_f2)
+{
+    const H5FD_iouring_t *f1        = (const H5FD_iouring_t *)_f1;
+    const H5FD_iouring_t *f2        = (const H5FD_iouring_t *)_f2;
+    int                   ret_value = 0;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5_DEV_T_IS_SCALAR
+    if (f1->device < f2->device)
+        HGOTO_DONE(-1)
+    if (f1->device > f2->device)
+        HGOTO_DONE(1)
+#else  /* H5_DEV_T_IS_SCALAR */
+    /* If dev_t isn't a scalar value on this system, just use memcmp to
+     * determine if the values are the same or not.  The actual return value
+     * shouldn't really matter...
+     */
+    if (HDmemcmp(&(f1->device), &(f2->device), sizeof(dev_t)) < 0)
+        HGOTO_DONE(-1)
+    if (HDmemcmp(&(f1->device), &(f2->device), sizeof(dev_t)) > 0)
+        HGOTO_DONE(1)
+#endif /* H5_DEV_T_IS_SCALAR */
+    if (f1->inode < f2->inode)
+        HGOTO_DONE(-1)
+    if (f1->inode > f2->inode)
+        HGOTO_DONE(1)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_query
+ *
+ * Purpose:     Set the flags that this VFL driver is capable of supporting.
+ *              (listed in H5FDpublic.h)
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_query(const H5FD_t *_file, unsigned long *flags /* out */)
+{
+    const H5FD_iouring_t *file = (const H5FD_iouring_t *)_file; /* io_uring VFD info */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Set the VFL feature flags that this driver supports */
+    if (flags) {
+        *flags = 0;
+        *flags |= H5FD_FEAT_AGGREGATE_METADATA;  /* OK to aggregate metadata allocations  */
+        *flags |= H5FD_FEAT_ACCUMULATE_METADATA; /* OK to accumulate metadata for faster writes */
+        *flags |= H5FD_FEAT_DATA_SIEVE; /* OK to perform data sieving for faster raw data reads & writes    */
+        *flags |= H5FD_FEAT_AGGREGATE_SMALLDATA; /* OK to aggregate "small" raw data allocations */
+        *flags |= H5FD_FEAT_DEFAULT_VFD_COMPATIBLE; /* VFD creates a file which can be opened with the default
+                                                       VFD      */
+
+        /* The file descriptor can only be used like any other when the file
+         * wasn't opened with O_DIRECT */
+        if (file && !(file->fa.flags & H5FD_IOURING_DIRECT_IO))
+            *flags |= H5FD_FEAT_POSIX_COMPAT_HANDLE; /* get_handle callback returns a POSIX file descriptor */
+
+        /* Check for flags that are set by h5repart */
+        if (file && file->fam_to_single)
+            *flags |= H5FD_FEAT_IGNORE_DRVRINFO; /* Ignore the driver info when file is opened (which
+                                                    eliminates it) */
+    }                                            /* end if */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD__iouring_query() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_get_eoa
+ *
+ * Purpose:     Gets the end-of-address marker for the file. The EOA marker
+ *              is the first address past the last byte allocated in the
+ *              format address space.
+ *
+ * Return:      The end-of-address marker.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD__iouring_get_eoa(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_iouring_t *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eoa)
+} /* end H5FD__iouring_get_eoa() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_set_eoa
+ *
+ * Purpose:     Set the end-of-address marker for the file. This function is
+ *              called shortly after an existing HDF5 file is opened in order
+ *              to tell the driver where the end of the HDF5 data is located.
+ *
+ * Return:      SUCCEED (Can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_set_eoa(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, haddr_t addr)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    file->eoa = addr;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5FD__iouring_set_eoa() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_get_eof
+ *
+ * Purpose:     Returns the end-of-file marker, which is the greater of
+ *              either the filesystem end-of-file or the HDF5 end-of-address
+ *              markers.
+ *
+ * Return:      End of file address, the first address past the end of the
+ *              "file", either the filesystem file or the HDF5 file.
+ *
+ *-------------------------------------------------------------------------
+ */
+static haddr_t
+H5FD__iouring_get_eof(const H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type)
+{
+    const H5FD_iouring_t *file = (const H5FD_iouring_t *)_file;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    FUNC_LEAVE_NOAPI(file->eof)
+} /* end H5FD__iouring_get_eof() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_get_handle
+ *
+ * Purpose:     Returns the file handle of the io_uring file driver.
+ *
+ * Returns:     SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_get_handle(H5FD_t *_file, hid_t H5_ATTR_UNUSED fapl, void **file_handle)
+{
+    H5FD_iouring_t *file      = (H5FD_iouring_t *)_file;
+    herr_t          ret_value = SUCCEED;
+
+    FUNC_ENTER_PACKAGE
+
+    if (!file_handle)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "file handle not valid")
+
+    *file_handle = &(file->fd);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_get_handle() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_queue
+ *
+ * Purpose:     Adds a submission queue entry for the remaining part of the
+ *              request in slot SLOT_IDX.  The entry is passed to the
+ *              kernel by the next H5FD__iouring_wait() call.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5FD__iouring_queue(H5FD_iouring_t *file, unsigned slot_idx)
+{
+    H5FD_iouring_slot_t *slot = &file->slots[slot_idx];
+    struct io_uring_sqe *sqe;
+    unsigned             tail;
+    unsigned             idx;
+    hbool_t              do_write;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(slot->state != H5FD_IOURING_SLOT_FREE);
+    HDassert(slot->done < slot->len);
+
+    do_write = (slot->state == H5FD_IOURING_SLOT_WRITE);
+
+    /* Only this thread moves the tail of the submission queue */
+    tail = *file->sq_tail;
+    idx  = tail & *file->sq_mask;
+    sqe  = &file->sqes[idx];
+    HDmemset(sqe, 0, sizeof(*sqe));
+
+    sqe->fd        = file->fd;
+    sqe->off       = (uint64_t)(slot->addr + slot->done);
+    sqe->user_data = (uint64_t)slot_idx;
+    if (file->registered) {
+        sqe->opcode    = (uint8_t)(do_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED);
+        sqe->addr      = (uint64_t)(uintptr_t)((uint8_t *)slot->iov.iov_base + slot->done);
+        sqe->len       = (uint32_t)(slot->len - slot->done);
+        sqe->buf_index = (uint16_t)slot_idx;
+    }
+    else {
+        slot->iov.iov_len = slot->len - slot->done;
+        sqe->opcode       = (uint8_t)(do_write ? IORING_OP_WRITEV : IORING_OP_READV);
+        sqe->addr         = (uint64_t)(uintptr_t)&slot->iov;
+        sqe->len          = 1;
+    }
+
+    file->sq_array[idx] = idx;
+    H5FD_IOURING_STORE_RELEASE(file->sq_tail, tail + 1);
+    file->nqueued++;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5FD__iouring_queue() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_wait
+ *
+ * Purpose:     Submits the queued entries to the kernel, waits until at
+ *              least MIN_COMPLETE requests complete, and processes every
+ *              available completion.  Requests that were only partly
+ *              transferred are queued again.  Reads that reach the end of
+ *              the file fill the rest of the caller's piece with zeros.
+ *              Read-modify-write requests are turned into writes once the
+ *              blocks they fill have been read.
+ *
+ *              Errors reported by the kernel for a request are saved in
+ *              the file's io_errno, so the caller can finish waiting for
+ *              the other requests before failing.
+ *
+ * Return:      SUCCEED/FAIL (only for failures of io_uring_enter())
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_wait(H5FD_iouring_t *file, unsigned min_complete)
+{
+    unsigned ncompleted = 0;
+    herr_t   ret_value  = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(min_complete <= file->ninflight);
+
+    do {
+        unsigned head;
+        unsigned tail;
+        unsigned to_wait;
+
+        /* Submit the queued entries and wait for completions */
+        to_wait = min_complete > ncompleted ? min_complete - ncompleted : 0;
+        if (file->nqueued > 0 || to_wait > 0) {
+            long nsubmitted;
+
+            nsubmitted = syscall(__NR_io_uring_enter, file->ring_fd, file->nqueued, to_wait,
+                                 to_wait > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+            if (nsubmitted < 0) {
+                if (EINTR == errno)
+                    continue;
+                HSYS_GOTO_ERROR(H5E_IO, H5E_SYSERRSTR, FAIL, "io_uring_enter failed")
+            }
+            HDassert((unsigned)nsubmitted <= file->nqueued);
+            file->nqueued -= (unsigned)nsubmitted;
+        }
+
+        /* Process the available completions */
+        head = *file->cq_head;
+        tail = H5FD_IOURING_LOAD_ACQUIRE(file->cq_tail);
+        while (head != tail) {
+            const struct io_uring_cqe *cqe      = &file->cqes[head & *file->cq_mask];
+            unsigned                   slot_idx = (unsigned)cqe->user_data;
+            H5FD_iouring_slot_t       *slot     = &file->slots[slot_idx];
+            int                        res      = cqe->res;
+            hbool_t                    finished = FALSE;
+
+            HDassert(slot_idx < file->fa.queue_depth);
+            HDassert(slot->state != H5FD_IOURING_SLOT_FREE);
+            head++;
+
+            if (res < 0) {
+                /* Retry interrupted requests, and record other errors */
+                if (-EINTR == res || -EAGAIN == res)
+                    H5FD__iouring_queue(file, slot_idx);
+                else {
+                    if (0 == file->io_errno)
+                        file->io_errno = -res;
+                    finished = TRUE;
+                }
+            }
+            else if (slot->state == H5FD_IOURING_SLOT_WRITE) {
+                if (0 == res) {
+                    if (0 == file->io_errno)
+                        file->io_errno = EIO;
+                    finished = TRUE;
+                }
+                else {
+                    slot->done += (size_t)res;
+                    if (slot->done < slot->len)
+                        H5FD__iouring_queue(file, slot_idx);
+                    else
+                        finished = TRUE;
+                }
+            }
+            else {
+                slot->done += (size_t)res;
+
+                /* End of file but not end of format address space.  An
+                 * O_DIRECT read only comes up short at the end of file. */
+                if (slot->done < slot->len &&
+                    (0 == res || (file->fa.flags & H5FD_IOURING_DIRECT_IO))) {
+                    HDmemset((uint8_t *)slot->iov.iov_base + slot->done, 0, slot->len - slot->done);
+                    slot->done = slot->len;
+                }
+
+                if (slot->done < slot->len)
+                    H5FD__iouring_queue(file, slot_idx);
+                else if (slot->state == H5FD_IOURING_SLOT_RMW_READ) {
+                    /* Fill in the caller's data and write the blocks */
+                    H5MM_memcpy((uint8_t *)slot->iov.iov_base + slot->user_off, slot->user_buf,
+                                slot->user_len);
+                    slot->state = H5FD_IOURING_SLOT_WRITE;
+                    slot->done  = 0;
+                    H5FD__iouring_queue(file, slot_idx);
+                }
+                else {
+                    if (slot->user_buf)
+                        H5MM_memcpy(slot->user_buf, (uint8_t *)slot->iov.iov_base + slot->user_off,
+                                    slot->user_len);
+                    finished = TRUE;
+                }
+            }
+
+            if (finished) {
+                slot->state                           = H5FD_IOURING_SLOT_FREE;
+                file->free_slots[file->nfree_slots++] = slot_idx;
+                file->ninflight--;
+                ncompleted++;
+            }
+        }
+        H5FD_IOURING_STORE_RELEASE(file->cq_head, head);
+    } while (ncompleted < min_complete || file->nqueued > 0);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_wait() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_vector_io
+ *
+ * Purpose:     Common implementation of the read, write, read_vector and
+ *              write_vector callbacks.  The requests are split into pieces
+ *              that fit the staging buffers (or 1 GiB, when data isn't
+ *              staged).
+ *              Pieces are queued until all slots are in use, then the
+ *              queued pieces are submitted together and slots are reused
+ *              as their requests complete.
+ *
+ *              In the O_DIRECT mode, each piece is rounded out to whole
+ *              blocks.  Writes of partial blocks read the blocks first.
+ *              A write whose blocks overlap the range of the writes still
+ *              in flight waits for all requests to complete first, so
+ *              that overlapping writes land in the order given and the
+ *              last of several writes to the same location wins.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_vector_io(H5FD_iouring_t *file, hbool_t do_write, uint32_t count, haddr_t addrs[],
+                        size_t sizes[], H5_flexible_const_ptr_t bufs[])
+{
+    hbool_t  direct       = (file->fa.flags & H5FD_IOURING_DIRECT_IO) ? TRUE : FALSE;
+    hbool_t  extend_sizes = FALSE;       /* Whether remaining sizes repeat the last one */
+    size_t   size         = 0;           /* Size of current request */
+    haddr_t  write_lo     = HADDR_UNDEF; /* Start of the writes in flight */
+    haddr_t  write_hi     = 0;           /* End of the writes in flight */
+    uint32_t i;                          /* Local index variable */
+    herr_t   ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file && file->pub.cls);
+    HDassert((addrs) || (count == 0));
+    HDassert((sizes) || (count == 0));
+    HDassert((bufs) || (count == 0));
+    HDassert(0 == file->ninflight);
+
+    if (count == 0)
+        HGOTO_DONE(SUCCEED)
+
+    file->io_errno = 0;
+    for (i = 0; i < count && 0 == file->io_errno; i++) {
+        haddr_t  addr;
+        uint8_t *buf;
+        size_t   left;
+
+        if (!extend_sizes) {
+            if (sizes[i] == 0)
+                extend_sizes = TRUE;
+            else
+                size = sizes[i];
+        } /* end if */
+
+        /* Check for overflow conditions */
+        if (!H5_addr_defined(addrs[i]))
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu",
+                        (unsigned long long)addrs[i])
+        if (REGION_OVERFLOW(addrs[i], size))
+            HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu",
+                        (unsigned long long)addrs[i], (unsigned long long)size)
+
+        addr = addrs[i];
+        buf  = (uint8_t *)bufs[i].vp;
+        left = size;
+        while (left > 0 && 0 == file->io_errno) {
+            H5FD_iouring_slot_t *slot;
+            unsigned             slot_idx;
+            haddr_t              start; /* Start of the request in the file */
+            haddr_t              end;   /* End of the request in the file */
+            size_t               piece; /* Size of the caller's piece */
+
+            /* Work out the extent of the piece and its request */
+            if (file->staging) {
+                start = direct ? H5FD_IOURING_ALIGN_DOWN(addr) : addr;
+                piece = (size_t)MIN((haddr_t)left, start + file->fa.buf_size - addr);
+                end   = direct ? H5FD_IOURING_ALIGN_UP(addr + piece) : addr + piece;
+            }
+            else {
+                start = addr;
+                piece = MIN(left, H5FD_IOURING_MAX_IO);
+                end   = addr + piece;
+            }
+
+            /* Keep overlapping writes in order */
+            if (do_write && start < write_hi && end > write_lo) {
+                if (H5FD__iouring_wait(file, file->ninflight) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "unable to complete writes")
+                write_lo = HADDR_UNDEF;
+                write_hi = 0;
+                if (0 != file->io_errno)
+                    break;
+            }
+
+            /* Get a free slot */
+            if (0 == file->nfree_slots)
+                if (H5FD__iouring_wait(file, 1) < 0)
+                    HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL,
+                                "unable to complete requests")
+            HDassert(file->nfree_slots > 0);
+            slot_idx = file->free_slots[--file->nfree_slots];
+            slot     = &file->slots[slot_idx];
+
+            /* Set up the request */
+            slot->addr = start;
+            slot->len  = (size_t)(end - start);
+            slot->done = 0;
+            if (file->staging) {
+                slot->iov.iov_base = file->staging + (size_t)slot_idx * file->fa.buf_size;
+                slot->user_buf     = buf;
+                slot->user_off     = (size_t)(addr - start);
+                slot->user_len     = piece;
+                if (!do_write)
+                    slot->state = H5FD_IOURING_SLOT_READ;
+                else if (start == addr && end == addr + piece) {
+                    H5MM_memcpy(slot->iov.iov_base, buf, piece);
+                    slot->state = H5FD_IOURING_SLOT_WRITE;
+                }
+                else
+                    slot->state = H5FD_IOURING_SLOT_RMW_READ;
+            }
+            else {
+                slot->iov.iov_base = buf;
+                slot->user_buf     = NULL;
+                slot->state        = do_write ? H5FD_IOURING_SLOT_WRITE : H5FD_IOURING_SLOT_READ;
+            }
+            file->ninflight++;
+            H5FD__iouring_queue(file, slot_idx);
+
+            if (do_write) {
+                write_lo = MIN(write_lo, start);
+                write_hi = MAX(write_hi, end);
+            } /* end if */
+
+            addr += piece;
+            buf += piece;
+            left -= piece;
+        } /* end while */
+
+        /* Update the end of file */
+        if (do_write && addrs[i] + size > file->eof)
+            file->eof = addrs[i] + size;
+    } /* end for */
+
+    /* Wait for the rest of the requests */
+    if (H5FD__iouring_wait(file, file->ninflight) < 0)
+        HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL, "unable to complete requests")
+
+    if (0 != file->io_errno) {
+        int    myerrno = file->io_errno;
+        time_t mytime  = HDtime(NULL);
+
+        HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL,
+                    "file %s failed: time = %s, filename = '%s', file descriptor = %d, errno = %d, "
+                    "error message = '%s'",
+                    do_write ? "write" : "read", HDctime(&mytime), file->filename, file->fd, myerrno,
+                    HDstrerror(myerrno));
+    }
+
+done:
+    /* Don't leave requests in flight on failure */
+    if (ret_value < 0 && file->ninflight > 0)
+        if (H5FD__iouring_wait(file, file->ninflight) < 0)
+            HDONE_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to complete requests")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_vector_io() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_read
+ *
+ * Purpose:     Reads SIZE bytes of data from FILE beginning at address ADDR
+ *              into buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      Success:    SUCCEED. Result is stored in caller-supplied
+ *                          buffer BUF.
+ *              Failure:    FAIL, Contents of buffer BUF are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_read(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id, haddr_t addr,
+                   size_t size, void *buf /*out*/)
+{
+    H5_flexible_const_ptr_t flex_buf;
+    herr_t                  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(buf);
+
+    flex_buf.vp = buf;
+    if (size > 0 && H5FD__iouring_vector_io((H5FD_iouring_t *)_file, FALSE, 1, &addr, &size, &flex_buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_read() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_write
+ *
+ * Purpose:     Writes SIZE bytes of data to FILE beginning at address ADDR
+ *              from buffer BUF according to data transfer properties in
+ *              DXPL_ID.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_write(H5FD_t *_file, H5FD_mem_t H5_ATTR_UNUSED type, hid_t H5_ATTR_UNUSED dxpl_id,
+                    haddr_t addr, size_t size, const void *buf)
+{
+    H5_flexible_const_ptr_t flex_buf;
+    herr_t                  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(buf);
+
+    flex_buf.cvp = buf;
+    if (size > 0 && H5FD__iouring_vector_io((H5FD_iouring_t *)_file, TRUE, 1, &addr, &size, &flex_buf) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_write() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_read_vector
+ *
+ * Purpose:     Performs COUNT reads from FILE at the addresses in ADDRS,
+ *              with the sizes in SIZES, into the buffers in BUFS.  The
+ *              reads are submitted to the ring together.
+ *
+ *              As for H5FDread_vector(), if SIZES[i] or TYPES[i] is 0 or
+ *              H5FD_MEM_NOLIST, the previous value applies to all
+ *              remaining requests.
+ *
+ * Return:      Success:    SUCCEED. Results are stored in the
+ *                          caller-supplied buffers.
+ *              Failure:    FAIL, Contents of the buffers are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_read_vector(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, uint32_t count,
+                          H5FD_mem_t H5_ATTR_UNUSED types[], haddr_t addrs[], size_t sizes[],
+                          void *bufs[] /*out*/)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (H5FD__iouring_vector_io((H5FD_iouring_t *)_file, FALSE, count, addrs, sizes,
+                                (H5_flexible_const_ptr_t *)bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_read_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_write_vector
+ *
+ * Purpose:     Performs COUNT writes to FILE at the addresses in ADDRS,
+ *              with the sizes in SIZES, from the buffers in BUFS.  The
+ *              writes are submitted to the ring together.
+ *
+ *              As for H5FDwrite_vector(), if SIZES[i] or TYPES[i] is 0 or
+ *              H5FD_MEM_NOLIST, the previous value applies to all
+ *              remaining requests.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_write_vector(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, uint32_t count,
+                           H5FD_mem_t H5_ATTR_UNUSED types[], haddr_t addrs[], size_t sizes[],
+                           const void *bufs[])
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (H5FD__iouring_vector_io((H5FD_iouring_t *)_file, TRUE, count, addrs, sizes,
+                                (H5_flexible_const_ptr_t *)bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_write_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_truncate
+ *
+ * Purpose:     Makes sure that the true file size is the same as the
+ *              end-of-address.  In the O_DIRECT mode, this also removes
+ *              the padding that writes of whole blocks add past the end
+ *              of the file.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_truncate(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, hbool_t H5_ATTR_UNUSED closing)
+{
+    H5FD_iouring_t *file      = (H5FD_iouring_t *)_file;
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file);
+
+    /* Extend the file to make sure it's large enough */
+    if (!H5_addr_eq(file->eoa, file->eof) || (file->fa.flags & H5FD_IOURING_DIRECT_IO)) {
+        if (-1 == HDftruncate(file->fd, (HDoff_t)file->eoa))
+            HSYS_GOTO_ERROR(H5E_IO, H5E_SEEKERROR, FAIL, "unable to extend file properly")
+
+        /* Update the eof value */
+        file->eof = file->eoa;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_truncate() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_lock
+ *
+ * Purpose:     To place an advisory lock on a file.
+ *		The lock type to apply depends on the parameter "rw":
+ *			TRUE--opens for write: an exclusive lock
+ *			FALSE--opens for read: a shared lock
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_lock(H5FD_t *_file, hbool_t rw)
+{
+    H5FD_iouring_t *file = (H5FD_iouring_t *)_file; /* VFD file struct          */
+    int             lock_flags;                     /* file locking flags       */
+    herr_t          ret_value = SUCCEED;            /* Return value             */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file);
+
+    /* Set exclusive or shared lock based on rw status */
+    lock_flags = rw ? LOCK_EX : LOCK_SH;
+
+    /* Place a non-blocking lock on the file */
+    if (HDflock(file->fd, lock_flags | LOCK_NB) < 0) {
+        if (file->ignore_disabled_file_locks && ENOSYS == errno) {
+            /* When errno is set to ENOSYS, the file system does not support
+             * locking, so ignore it.
+             */
+            errno = 0;
+        }
+        else
+            HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTLOCKFILE, FAIL, "unable to lock file")
+    }
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_lock() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_unlock
+ *
+ * Purpose:     To remove the existing lock on the file
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_unlock(H5FD_t *_file)
+{
+    H5FD_iouring_t *file      = (H5FD_iouring_t *)_file; /* VFD file struct          */
+    herr_t          ret_value = SUCCEED;                 /* Return value             */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file);
+
+    if (HDflock(file->fd, LOCK_UN) < 0) {
+        if (file->ignore_disabled_file_locks && ENOSYS == errno) {
+            /* When errno is set to ENOSYS, the file system does not support
+             * locking, so ignore it.
+             */
+            errno = 0;
+        }
+        else
+            HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTUNLOCKFILE, FAIL, "unable to unlock file")
+    }
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_unlock() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__iouring_delete
+ *
+ * Purpose:     Delete a file
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__iouring_delete(const char *filename, hid_t H5_ATTR_UNUSED fapl_id)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(filename);
+
+    if (HDremove(filename) < 0)
+        HSYS_GOTO_ERROR(H5E_VFL, H5E_CANTDELETEFILE, FAIL, "unable to delete file")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__iouring_delete() */
+
+#endif /* H5_HAVE_IOURING_VFD */
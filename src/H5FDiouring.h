@@ -0,0 +1,120 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The public header file for the io_uring driver.
+ */
+#ifndef H5FDiouring_H
+#define H5FDiouring_H
+
+#ifdef H5_HAVE_IOURING_VFD
+#define H5FD_IOURING       (H5FDperform_init(H5FD_iouring_init))
+#define H5FD_IOURING_VALUE H5_VFD_IOURING
+#else
+#define H5FD_IOURING       (H5I_INVALID_HID)
+#define H5FD_IOURING_VALUE H5_VFD_INVALID
+#endif /* H5_HAVE_IOURING_VFD */
+
+#ifdef H5_HAVE_IOURING_VFD
+
+/* Flags for H5Pset_fapl_iouring() */
+#define H5FD_IOURING_DIRECT_IO        0x0001u /* Open the file with O_DIRECT                    */
+#define H5FD_IOURING_REGISTER_BUFFERS 0x0002u /* Stage I/O through buffers registered with ring */
+
+/* Default values for the submission queue depth and the staging buffer size.
+ * Application can set these values through the function H5Pset_fapl_iouring. */
+#define H5FD_IOURING_QUEUE_DEPTH_DEF 64
+#define H5FD_IOURING_BUF_SIZE_DEF    (256 * 1024)
+
+/* Alignment of file addresses, sizes and memory for the O_DIRECT mode */
+#define H5FD_IOURING_BLOCK_SIZE 4096
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+H5_DLL hid_t H5FD_iouring_init(void);
+
+/**
+ * \ingroup FAPL
+ *
+ * \brief Sets up use of the io_uring driver
+ *
+ * \fapl_id
+ * \param[in] queue_depth Number of requests the driver keeps in flight
+ * \param[in] flags Bit flags selecting the driver's options
+ * \param[in] buf_size Size of each staging buffer
+ * \returns \herr_t
+ *
+ * \details H5Pset_fapl_iouring() sets the file access property list, \p
+ *          fapl_id, to use the io_uring driver, #H5FD_IOURING.  The driver
+ *          stores the file like the default #H5FD_SEC2 driver, but on Linux
+ *          it transfers the pieces of a vector or selection I/O request by
+ *          submitting them together to an io_uring instance and reaping
+ *          their completions together, so that a single thread keeps up to
+ *          \p queue_depth requests in flight.  Selection I/O, the default
+ *          when this driver is used, and H5Dread_multi() / H5Dwrite_multi()
+ *          pass many pieces to the driver at once.
+ *
+ *          \p queue_depth is the size of the submission queue.  A value of
+ *          0 (zero) means to use the default of 64.
+ *
+ *          \p flags is a bitwise OR of zero or more of:
+ *          - #H5FD_IOURING_REGISTER_BUFFERS: data is staged through \p
+ *            queue_depth buffers that are registered with the ring, so
+ *            the kernel does not map the pages of each request.  If the
+ *            buffers can't be registered, for example because of the
+ *            limit on locked memory, they are used without registration.
+ *          - #H5FD_IOURING_DIRECT_IO: the file is opened with O_DIRECT to
+ *            bypass the system's page cache.  Data is staged through
+ *            buffers aligned to 4 KiB, and requests that don't cover
+ *            whole 4 KiB blocks read the blocks before writing them.
+ *
+ *          \p buf_size is the size of each staging buffer, used when
+ *          either flag is set.  A value of 0 (zero) means to use the
+ *          default of 256 KiB.  It must be a multiple of 4 KiB.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_fapl_iouring(hid_t fapl_id, unsigned queue_depth, unsigned flags, size_t buf_size);
+
+/**
+ * \ingroup FAPL
+ *
+ * \brief Retrieves io_uring driver settings
+ *
+ * \fapl_id
+ * \param[out] queue_depth Number of requests the driver keeps in flight
+ * \param[out] flags Bit flags selecting the driver's options
+ * \param[out] buf_size Size of each staging buffer
+ * \returns \herr_t
+ *
+ * \details H5Pget_fapl_iouring() retrieves the queue depth, flags and
+ *          staging buffer size of the io_uring driver, #H5FD_IOURING, from
+ *          the file access property list \p fapl_id.
+ *
+ *          See H5Pset_fapl_iouring() for a description of these values.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pget_fapl_iouring(hid_t fapl_id, unsigned *queue_depth /*out*/, unsigned *flags /*out*/,
+                                  size_t *buf_size /*out*/);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H5_HAVE_IOURING_VFD */
+
+#endif
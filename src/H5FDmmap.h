@@ -0,0 +1,72 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The public header file for the memory-mapped driver.
+ */
+#ifndef H5FDmmap_H
+#define H5FDmmap_H
+
+#ifdef H5_HAVE_MMAP
+#define H5FD_MMAP       (H5FDperform_init(H5FD_mmap_init))
+#define H5FD_MMAP_VALUE H5_VFD_MMAP
+#else
+#define H5FD_MMAP       (H5I_INVALID_HID)
+#define H5FD_MMAP_VALUE H5_VFD_INVALID
+#endif /* H5_HAVE_MMAP */
+
+#ifdef H5_HAVE_MMAP
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+H5_DLL hid_t H5FD_mmap_init(void);
+
+/**
+ * \ingroup FAPL
+ *
+ * \brief Sets up use of the read-only memory-mapped driver
+ *
+ * \fapl_id
+ * \returns \herr_t
+ *
+ * \details H5Pset_fapl_mmap() sets the file access property list, \p
+ *          fapl_id, to use the memory-mapped driver, #H5FD_MMAP.  The
+ *          driver opens files written by the default #H5FD_SEC2 driver
+ *          read-only and maps them into memory, so that reads of metadata
+ *          and raw data are copied from the system's page cache without a
+ *          system call.  Files can't be created or opened for writing
+ *          with this driver.
+ *
+ *          The driver follows the pattern of the reads it serves: once
+ *          reads run sequentially through the file the kernel is advised
+ *          to read ahead aggressively, once they jump around it is advised
+ *          not to read ahead, and large reads ask for their pages to be
+ *          fetched before they are copied.
+ *
+ *          Contiguous datasets are read straight from the mapping into the
+ *          application's buffer, or the type conversion buffer, without
+ *          passing through the dataset's sieve buffer.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_fapl_mmap(hid_t fapl_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H5_HAVE_MMAP */
+
+#endif
@@ -42,6 +42,8 @@
 #define H5_VFD_SUBFILING ((H5FD_class_value_t)(12))
 #define H5_VFD_IOC       ((H5FD_class_value_t)(13))
 #define H5_VFD_ONION     ((H5FD_class_value_t)(14))
+#define H5_VFD_IOURING   ((H5FD_class_value_t)(15))
+#define H5_VFD_MMAP      ((H5FD_class_value_t)(16))
 
 /* VFD IDs below this value are reserved for library use. */
 #define H5_VFD_RESERVED 256
@@ -166,6 +168,21 @@
  * operations when appropriate.
  */
 #define H5FD_FEAT_MEMMANAGE 0x00010000
+/*
+ * Defining H5FD_FEAT_SELECTION_IO_OPT_IN for a VFL driver means that
+ * the library should not turn on selection I/O by default for the driver,
+ * even though it has vector or selection I/O callbacks.  The callbacks are
+ * only used when the application asks for selection I/O with
+ * H5Pset_selection_io().
+ */
+#define H5FD_FEAT_SELECTION_IO_OPT_IN 0x00020000
+/*
+ * Defining H5FD_FEAT_MAPPED_REGION for a VFL driver means that the
+ * driver's ctl callback answers H5FD_CTL_GET_MAPPED_REGION_OPCODE with the
+ * part of the file it keeps mapped into memory.  The library only asks
+ * drivers with this flag for their mapped region.
+ */
+#define H5FD_FEAT_MAPPED_REGION 0x00040000
 
 /* ctl function definitions: */
 #define H5FD_CTL_OPC_RESERVED 512 /* Opcodes below this value are reserved for library use */
@@ -185,6 +202,7 @@
 #define H5FD_CTL_MEM_FREE                    6
 #define H5FD_CTL_MEM_COPY                    7
 #define H5FD_CTL_GET_MPI_FILE_SYNC_OPCODE    8
+#define H5FD_CTL_GET_MAPPED_REGION_OPCODE    9
 
 /* ctl function flags: */
 
@@ -386,6 +404,16 @@ typedef struct H5FD_ctl_memcpy_args_t {
 } H5FD_ctl_memcpy_args_t;
 //! <!-- [H5FD_ctl_memcpy_args_t_snip] -->
 
+/**
+ * Define structure to hold "ctl get mapped region" results
+ */
+//! <!-- [H5FD_ctl_mapped_region_t_snip] -->
+typedef struct H5FD_ctl_mapped_region_t {
+    const void *base; /**< Start of the file's image in memory, or NULL if the file isn't mapped */
+    haddr_t     size; /**< Number of bytes of the file, from address 0, that are mapped */
+} H5FD_ctl_mapped_region_t;
+//! <!-- [H5FD_ctl_mapped_region_t_snip] -->
+
 /********************/
 /* Public Variables */
 /********************/
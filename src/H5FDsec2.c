@@ -120,6 +120,15 @@ typedef struct H5FD_sec2_t {
 #define REGION_OVERFLOW(A, Z)                                                                                \
     (ADDR_OVERFLOW(A) || SIZE_OVERFLOW(Z) || HADDR_UNDEF == (A) + (Z) || (HDoff_t)((A) + (Z)) < (HDoff_t)(A))
 
+#ifdef H5_HAVE_PREADWRITEV
+/* Largest number of I/O vectors passed to a single preadv() or pwritev() call */
+#if defined(IOV_MAX) && IOV_MAX < 128
+#define H5FD_SEC2_IOV_LEN IOV_MAX
+#else
+#define H5FD_SEC2_IOV_LEN 128
+#endif
+#endif /* H5_HAVE_PREADWRITEV */
+
 /* Prototypes */
 static herr_t  H5FD__sec2_term(void);
 static H5FD_t *H5FD__sec2_open(const char *name, unsigned flags, hid_t fapl_id, haddr_t maxaddr);
@@ -134,6 +143,16 @@ static herr_t  H5FD__sec2_read(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, ha
                                void *buf);
 static herr_t  H5FD__sec2_write(H5FD_t *_file, H5FD_mem_t type, hid_t fapl_id, haddr_t addr, size_t size,
                                 const void *buf);
+#ifdef H5_HAVE_PREADWRITEV
+static herr_t  H5FD__sec2_iov_io(H5FD_sec2_t *file, hbool_t do_write, struct iovec *iov, int niov,
+                                 haddr_t addr, size_t size);
+static herr_t  H5FD__sec2_vector_io(H5FD_sec2_t *file, hbool_t do_write, uint32_t count, H5FD_mem_t types[],
+                                    haddr_t addrs[], size_t sizes[], H5_flexible_const_ptr_t bufs[]);
+static herr_t  H5FD__sec2_read_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[],
+                                      haddr_t addrs[], size_t sizes[], void *bufs[]);
+static herr_t  H5FD__sec2_write_vector(H5FD_t *_file, hid_t dxpl_id, uint32_t count, H5FD_mem_t types[],
+                                       haddr_t addrs[], size_t sizes[], const void *bufs[]);
+#endif /* H5_HAVE_PREADWRITEV */
 static herr_t  H5FD__sec2_truncate(H5FD_t *_file, hid_t dxpl_id, hbool_t closing);
 static herr_t  H5FD__sec2_lock(H5FD_t *_file, hbool_t rw);
 static herr_t  H5FD__sec2_unlock(H5FD_t *_file);
@@ -142,46 +161,51 @@ static herr_t  H5FD__sec2_ctl(H5FD_t *_file, uint64_t op_code, uint64_t flags, c
                               void **output);
 
 static const H5FD_class_t H5FD_sec2_g = {
-    H5FD_CLASS_VERSION,    /* struct version       */
-    H5FD_SEC2_VALUE,       /* value                */
-    "sec2",                /* name                 */
-    MAXADDR,               /* maxaddr              */
-    H5F_CLOSE_WEAK,        /* fc_degree            */
-    H5FD__sec2_term,       /* terminate            */
-    NULL,                  /* sb_size              */
-    NULL,                  /* sb_encode            */
-    NULL,                  /* sb_decode            */
-    0,                     /* fapl_size            */
-    NULL,                  /* fapl_get             */
-    NULL,                  /* fapl_copy            */
-    NULL,                  /* fapl_free            */
-    0,                     /* dxpl_size            */
-    NULL,                  /* dxpl_copy            */
-    NULL,                  /* dxpl_free            */
-    H5FD__sec2_open,       /* open                 */
-    H5FD__sec2_close,      /* close                */
-    H5FD__sec2_cmp,        /* cmp                  */
-    H5FD__sec2_query,      /* query                */
-    NULL,                  /* get_type_map         */
-    NULL,                  /* alloc                */
-    NULL,                  /* free                 */
-    H5FD__sec2_get_eoa,    /* get_eoa              */
-    H5FD__sec2_set_eoa,    /* set_eoa              */
-    H5FD__sec2_get_eof,    /* get_eof              */
-    H5FD__sec2_get_handle, /* get_handle           */
-    H5FD__sec2_read,       /* read                 */
-    H5FD__sec2_write,      /* write                */
-    NULL,                  /* read_vector          */
-    NULL,                  /* write_vector         */
-    NULL,                  /* read_selection       */
-    NULL,                  /* write_selection      */
-    NULL,                  /* flush                */
-    H5FD__sec2_truncate,   /* truncate             */
-    H5FD__sec2_lock,       /* lock                 */
-    H5FD__sec2_unlock,     /* unlock               */
-    H5FD__sec2_delete,     /* del                  */
-    H5FD__sec2_ctl,        /* ctl                  */
-    H5FD_FLMAP_DICHOTOMY   /* fl_map               */
+    H5FD_CLASS_VERSION,      /* struct version       */
+    H5FD_SEC2_VALUE,         /* value                */
+    "sec2",                  /* name                 */
+    MAXADDR,                 /* maxaddr              */
+    H5F_CLOSE_WEAK,          /* fc_degree            */
+    H5FD__sec2_term,         /* terminate            */
+    NULL,                    /* sb_size              */
+    NULL,                    /* sb_encode            */
+    NULL,                    /* sb_decode            */
+    0,                       /* fapl_size            */
+    NULL,                    /* fapl_get             */
+    NULL,                    /* fapl_copy            */
+    NULL,                    /* fapl_free            */
+    0,                       /* dxpl_size            */
+    NULL,                    /* dxpl_copy            */
+    NULL,                    /* dxpl_free            */
+    H5FD__sec2_open,         /* open                 */
+    H5FD__sec2_close,        /* close                */
+    H5FD__sec2_cmp,          /* cmp                  */
+    H5FD__sec2_query,        /* query                */
+    NULL,                    /* get_type_map         */
+    NULL,                    /* alloc                */
+    NULL,                    /* free                 */
+    H5FD__sec2_get_eoa,      /* get_eoa              */
+    H5FD__sec2_set_eoa,      /* set_eoa              */
+    H5FD__sec2_get_eof,      /* get_eof              */
+    H5FD__sec2_get_handle,   /* get_handle           */
+    H5FD__sec2_read,         /* read                 */
+    H5FD__sec2_write,        /* write                */
+#ifdef H5_HAVE_PREADWRITEV
+    H5FD__sec2_read_vector,  /* read_vector          */
+    H5FD__sec2_write_vector, /* write_vector         */
+#else
+    NULL,                    /* read_vector          */
+    NULL,                    /* write_vector         */
+#endif /* H5_HAVE_PREADWRITEV */
+    NULL,                    /* read_selection       */
+    NULL,                    /* write_selection      */
+    NULL,                    /* flush                */
+    H5FD__sec2_truncate,     /* truncate             */
+    H5FD__sec2_lock,         /* lock                 */
+    H5FD__sec2_unlock,       /* unlock               */
+    H5FD__sec2_delete,       /* del                  */
+    H5FD__sec2_ctl,          /* ctl                  */
+    H5FD_FLMAP_DICHOTOMY     /* fl_map               */
 };
 
 /* Declare a free list to manage the H5FD_sec2_t struct */
@@ -551,6 +575,9 @@ H5FD__sec2_query(const H5FD_t *_file, unsigned long *flags /* out */)
             H5FD_FEAT_SUPPORTS_SWMR_IO; /* VFD supports the single-writer/multiple-readers (SWMR) pattern   */
         *flags |= H5FD_FEAT_DEFAULT_VFD_COMPATIBLE; /* VFD creates a file which can be opened with the default
                                                        VFD      */
+#ifdef H5_HAVE_PREADWRITEV
+        *flags |= H5FD_FEAT_SELECTION_IO_OPT_IN; /* Vector I/O is only used when selection I/O is requested */
+#endif /* H5_HAVE_PREADWRITEV */
 
         /* Check for flags that are set by h5repart */
         if (file && file->fam_to_single)
@@ -880,6 +907,268 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5FD__sec2_write() */
 
+#ifdef H5_HAVE_PREADWRITEV
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_iov_io
+ *
+ * Purpose:     Reads or writes a run of requests that are contiguous in
+ *              the file, starting at ADDR, with preadv() or pwritev().
+ *              The NIOV I/O vectors in IOV describe the caller's buffers
+ *              and are consumed as the transfer progresses.  When reading,
+ *              the part of the run past the end of the file is filled
+ *              with zeros.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_iov_io(H5FD_sec2_t *file, hbool_t do_write, struct iovec *iov, int niov, haddr_t addr,
+                  size_t size)
+{
+    HDoff_t offset    = (HDoff_t)addr;
+    herr_t  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file);
+    HDassert(iov);
+    HDassert(niov > 0);
+    HDassert(size <= (size_t)H5_POSIX_MAX_IO_BYTES);
+
+    while (size > 0) {
+        ssize_t nbytes = -1; /* # of bytes actually transferred */
+
+        do {
+            if (do_write)
+                nbytes = HDpwritev(file->fd, iov, niov, offset);
+            else
+                nbytes = HDpreadv(file->fd, iov, niov, offset);
+        } while (-1 == nbytes && EINTR == errno);
+
+        if (-1 == nbytes) { /* error */
+            int    myerrno = errno;
+            time_t mytime  = HDtime(NULL);
+
+            HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL,
+                        "file vector %s failed: time = %s, filename = '%s', file descriptor = %d, "
+                        "errno = %d, error message = '%s', total size = %llu, offset = %llu",
+                        do_write ? "write" : "read", HDctime(&mytime), file->filename, file->fd, myerrno,
+                        HDstrerror(myerrno), (unsigned long long)size, (unsigned long long)offset);
+        } /* end if */
+
+        if (0 == nbytes) {
+            if (do_write)
+                HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write made no progress, offset = %llu",
+                            (unsigned long long)offset)
+
+            /* end of file but not end of format address space */
+            for (; niov > 0; iov++, niov--)
+                HDmemset(iov->iov_base, 0, iov->iov_len);
+            break;
+        } /* end if */
+
+        HDassert((size_t)nbytes <= size);
+        size -= (size_t)nbytes;
+        offset += (HDoff_t)nbytes;
+
+        /* Skip the buffers that were completed and advance into a partially
+         * transferred one */
+        while (niov > 0 && (size_t)nbytes >= iov->iov_len) {
+            nbytes -= (ssize_t)iov->iov_len;
+            iov++;
+            niov--;
+        } /* end while */
+        if (nbytes > 0) {
+            iov->iov_base = (char *)iov->iov_base + nbytes;
+            iov->iov_len -= (size_t)nbytes;
+        } /* end if */
+    }     /* end while */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_iov_io() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_vector_io
+ *
+ * Purpose:     Common implementation of H5FD__sec2_read_vector() and
+ *              H5FD__sec2_write_vector().  The requests are transferred
+ *              in the order given, so that the last of several writes to
+ *              the same location wins, and each run of consecutive
+ *              requests that are contiguous in the file is transferred
+ *              with as few preadv() or pwritev() calls as the system's
+ *              limit on I/O vectors allows.  The library passes the
+ *              pieces of a selection in increasing address order, so
+ *              the runs are usually long.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_vector_io(H5FD_sec2_t *file, hbool_t do_write, uint32_t count, H5FD_mem_t types[],
+                     haddr_t addrs[], size_t sizes[], H5_flexible_const_ptr_t bufs[])
+{
+    struct iovec iov[H5FD_SEC2_IOV_LEN]; /* I/O vectors for a run of requests */
+    hbool_t      extend_sizes = FALSE;   /* Whether remaining sizes repeat the last one */
+    size_t       size         = 0;       /* Size of current request */
+    haddr_t      end          = 0;       /* End of last request transferred */
+    uint32_t     i;                      /* Local index variable */
+    herr_t       ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(file && file->pub.cls);
+    HDassert((types) || (count == 0));
+    HDassert((addrs) || (count == 0));
+    HDassert((sizes) || (count == 0));
+    HDassert((bufs) || (count == 0));
+
+    if (count == 0)
+        HGOTO_DONE(SUCCEED)
+
+    i = 0;
+    while (i < count) {
+        haddr_t run_addr = addrs[i]; /* Start of run in the file */
+        size_t  run_size = 0;        /* Size of run */
+        int     niov     = 0;        /* Number of I/O vectors in run */
+
+        /* Gather requests while they are contiguous in the file */
+        while (i < count && niov < H5FD_SEC2_IOV_LEN) {
+            if (!extend_sizes) {
+                if (sizes[i] == 0)
+                    extend_sizes = TRUE;
+                else
+                    size = sizes[i];
+            } /* end if */
+
+            /* Check for overflow conditions */
+            if (!H5_addr_defined(addrs[i]))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "addr undefined, addr = %llu",
+                            (unsigned long long)addrs[i])
+            if (REGION_OVERFLOW(addrs[i], size))
+                HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "addr overflow, addr = %llu, size = %llu",
+                            (unsigned long long)addrs[i], (unsigned long long)size)
+
+            if (niov > 0 &&
+                (addrs[i] != run_addr + run_size || size > (size_t)H5_POSIX_MAX_IO_BYTES - run_size))
+                break;
+
+            /* Requests too large for a single call are transferred on their own */
+            if (size > (size_t)H5_POSIX_MAX_IO_BYTES) {
+                HDassert(niov == 0);
+                if (do_write) {
+                    if (H5FD__sec2_write((H5FD_t *)file, types[0], H5P_DEFAULT, addrs[i], size,
+                                         bufs[i].cvp) < 0)
+                        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file write failed")
+                }
+                else if (H5FD__sec2_read((H5FD_t *)file, types[0], H5P_DEFAULT, addrs[i], size,
+                                         bufs[i].vp) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file read failed")
+                end = addrs[i] + size;
+                i++;
+                break;
+            } /* end if */
+
+            iov[niov].iov_base = bufs[i].vp;
+            iov[niov].iov_len  = size;
+            niov++;
+            run_size += size;
+            i++;
+        } /* end while */
+
+        if (niov > 0) {
+            if (H5FD__sec2_iov_io(file, do_write, iov, niov, run_addr, run_size) < 0)
+                HGOTO_ERROR(H5E_IO, do_write ? H5E_WRITEERROR : H5E_READERROR, FAIL,
+                            "file vector I/O failed")
+            end = run_addr + run_size;
+            if (do_write && end > file->eof)
+                file->eof = end;
+        } /* end if */
+    }     /* end while */
+
+    /* Update current position */
+    file->pos = end;
+    file->op  = do_write ? OP_WRITE : OP_READ;
+
+done:
+    if (ret_value < 0) {
+        /* Reset last file I/O information */
+        file->pos = HADDR_UNDEF;
+        file->op  = OP_UNKNOWN;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_vector_io() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_read_vector
+ *
+ * Purpose:     Performs COUNT reads from FILE at the addresses in ADDRS,
+ *              with the sizes in SIZES, into the buffers in BUFS.  Reads
+ *              that are contiguous in the file are combined into single
+ *              preadv() calls.
+ *
+ *              As for H5FDread_vector(), if SIZES[i] or TYPES[i] is 0 or
+ *              H5FD_MEM_NOLIST, the previous value applies to all
+ *              remaining requests.
+ *
+ * Return:      Success:    SUCCEED. Results are stored in the
+ *                          caller-supplied buffers.
+ *              Failure:    FAIL, Contents of the buffers are undefined.
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_read_vector(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, uint32_t count, H5FD_mem_t types[],
+                       haddr_t addrs[], size_t sizes[], void *bufs[] /*out*/)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (H5FD__sec2_vector_io((H5FD_sec2_t *)_file, FALSE, count, types, addrs, sizes,
+                             (H5_flexible_const_ptr_t *)bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "file vector read failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_read_vector() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5FD__sec2_write_vector
+ *
+ * Purpose:     Performs COUNT writes to FILE at the addresses in ADDRS,
+ *              with the sizes in SIZES, from the buffers in BUFS.  Writes
+ *              that are contiguous in the file are combined into single
+ *              pwritev() calls.
+ *
+ *              As for H5FDwrite_vector(), if SIZES[i] or TYPES[i] is 0 or
+ *              H5FD_MEM_NOLIST, the previous value applies to all
+ *              remaining requests.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5FD__sec2_write_vector(H5FD_t *_file, hid_t H5_ATTR_UNUSED dxpl_id, uint32_t count, H5FD_mem_t types[],
+                        haddr_t addrs[], size_t sizes[], const void *bufs[])
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (H5FD__sec2_vector_io((H5FD_sec2_t *)_file, TRUE, count, types, addrs, sizes,
+                             (H5_flexible_const_ptr_t *)bufs) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "file vector write failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5FD__sec2_write_vector() */
+#endif /* H5_HAVE_PREADWRITEV */
+
 /*-------------------------------------------------------------------------
  * Function:    H5FD__sec2_truncate
  *
@@ -289,6 +289,7 @@ struct H5F_shared_t {
     size_t   rdcc_nslots;    /* Size of raw data chunk cache (slots)	*/
     size_t   rdcc_nbytes;    /* Size of raw data chunk cache	(bytes)	*/
     double   rdcc_w0;        /* Preempt read chunks first? [0.0..1.0]*/
+    size_t   rdcc_file_nbytes; /* Size of the file-wide raw data chunk cache (bytes) */
     size_t   sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
     hsize_t  threshold;      /* Threshold for alignment		*/
     hsize_t  alignment;      /* Alignment				*/
@@ -301,6 +302,7 @@ struct H5F_shared_t {
     struct H5G_t        *root_grp;          /* Open root group			*/
     H5FO_t              *open_objs;         /* Open objects in file                 */
     H5UC_t              *grp_btree_shared;  /* Ref-counted group B-tree node info   */
+    struct H5D_rdcc_file_t *rdcc_file;      /* Raw data chunk cache shared by the file's datasets */
     hbool_t              use_file_locking;  /* Whether or not to use file locking */
     hbool_t              closing;           /* File is in the process of being closed */
 
@@ -76,6 +76,9 @@ typedef struct H5F_t H5F_t;
 #define H5F_RDCC_NSLOTS(F)               ((F)->shared->rdcc_nslots)
 #define H5F_RDCC_NBYTES(F)               ((F)->shared->rdcc_nbytes)
 #define H5F_RDCC_W0(F)                   ((F)->shared->rdcc_w0)
+#define H5F_RDCC_FILE_NBYTES(F)          ((F)->shared->rdcc_file_nbytes)
+#define H5F_RDCC_FILE(F)                 ((F)->shared->rdcc_file)
+#define H5F_SET_RDCC_FILE(F, C)          ((F)->shared->rdcc_file = (C))
 #define H5F_SIEVE_BUF_SIZE(F)            ((F)->shared->sieve_buf_size)
 #define H5F_GC_REF(F)                    ((F)->shared->gc_ref)
 #define H5F_STORE_MSG_CRT_IDX(F)         ((F)->shared->store_msg_crt_idx)
@@ -139,6 +142,9 @@ typedef struct H5F_t H5F_t;
 #define H5F_RDCC_NSLOTS(F)               (H5F_rdcc_nslots(F))
 #define H5F_RDCC_NBYTES(F)               (H5F_rdcc_nbytes(F))
 #define H5F_RDCC_W0(F)                   (H5F_rdcc_w0(F))
+#define H5F_RDCC_FILE_NBYTES(F)          (H5F_rdcc_file_nbytes(F))
+#define H5F_RDCC_FILE(F)                 (H5F_rdcc_file(F))
+#define H5F_SET_RDCC_FILE(F, C)          (H5F_set_rdcc_file((F), (C)))
 #define H5F_SIEVE_BUF_SIZE(F)            (H5F_sieve_buf_size(F))
 #define H5F_GC_REF(F)                    (H5F_gc_ref(F))
 #define H5F_STORE_MSG_CRT_IDX(F)         (H5F_store_msg_crt_idx(F))
@@ -218,6 +224,8 @@ typedef struct H5F_t H5F_t;
 #define H5F_ACS_DATA_CACHE_NUM_SLOTS_NAME "rdcc_nslots" /* Size of raw data chunk cache(slots) */
 #define H5F_ACS_DATA_CACHE_BYTE_SIZE_NAME "rdcc_nbytes" /* Size of raw data chunk cache(bytes) */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_NAME  "rdcc_w0"     /* Preemption read chunks first */
+#define H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_NAME                                                               \
+    "rdcc_file_nbytes" /* Size of the file-wide raw data chunk cache(bytes) */
 #define H5F_ACS_ALIGN_THRHD_NAME          "threshold"   /* Threshold for alignment */
 #define H5F_ACS_ALIGN_NAME                "align"       /* Alignment */
 #define H5F_ACS_META_BLOCK_SIZE_NAME                                                                         \
@@ -416,6 +424,7 @@ typedef struct H5F_t H5F_t;
 /* Forward declarations (for prototypes & type definitions) */
 struct H5B_class_t;
 struct H5UC_t;
+struct H5D_rdcc_file_t;
 struct H5G_loc_t;
 struct H5O_loc_t;
 struct H5HG_heap_t;
@@ -544,6 +553,9 @@ H5_DLL hbool_t            H5F_get_evict_on_close(const H5F_t *f);
 H5_DLL size_t             H5F_rdcc_nbytes(const H5F_t *f);
 H5_DLL size_t             H5F_rdcc_nslots(const H5F_t *f);
 H5_DLL double             H5F_rdcc_w0(const H5F_t *f);
+H5_DLL size_t             H5F_rdcc_file_nbytes(const H5F_t *f);
+H5_DLL struct H5D_rdcc_file_t *H5F_rdcc_file(const H5F_t *f);
+H5_DLL herr_t             H5F_set_rdcc_file(H5F_t *f, struct H5D_rdcc_file_t *cache);
 H5_DLL size_t             H5F_sieve_buf_size(const H5F_t *f);
 H5_DLL unsigned           H5F_gc_ref(const H5F_t *f);
 H5_DLL hbool_t            H5F_store_msg_crt_idx(const H5F_t *f);
@@ -640,6 +640,50 @@ H5F_rdcc_w0(const H5F_t *f)
     FUNC_LEAVE_NOAPI(f->shared->rdcc_w0)
 } /* end H5F_rdcc_w0() */
 
+/*-------------------------------------------------------------------------
+ * Function: H5F_rdcc_file_nbytes
+ *
+ * Purpose:  Retrieve the size of the raw data chunk cache shared by the
+ *           file's datasets.
+ *
+ * Return:   The file-wide raw data chunk cache's size in bytes, or 0 if
+ *           each dataset has its own cache (can't fail)
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5F_rdcc_file_nbytes(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_file_nbytes)
+} /* end H5F_rdcc_file_nbytes() */
+
+/*-------------------------------------------------------------------------
+ * Function: H5F_rdcc_file
+ *
+ * Purpose:  Retrieve the raw data chunk cache shared by the file's
+ *           datasets.
+ *
+ * Return:   Pointer to the file-wide raw data chunk cache, or NULL if no
+ *           dataset uses it yet (can't fail)
+ *-------------------------------------------------------------------------
+ */
+struct H5D_rdcc_file_t *
+H5F_rdcc_file(const H5F_t *f)
+{
+    /* Use FUNC_ENTER_NOAPI_NOINIT_NOERR here to avoid performance issues */
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(f);
+    HDassert(f->shared);
+
+    FUNC_LEAVE_NOAPI(f->shared->rdcc_file)
+} /* end H5F_rdcc_file() */
+
 /*-------------------------------------------------------------------------
  * Function: H5F_get_base_addr
  *
@@ -1377,6 +1421,7 @@ H5F_get_file_locking(const H5F_t *f)
  * Function: H5F_has_vector_select_io
  *
  * Purpose:  Determine if vector or selection I/O is supported by this file
+ *           and should be used when the application hasn't asked for it
  *
  * Return:   TRUE/FALSE
  *
@@ -1392,7 +1437,9 @@ H5F_has_vector_select_io(const H5F_t *f, hbool_t is_write)
     HDassert(f);
     HDassert(f->shared);
 
-    if (is_write)
+    if (H5F_HAS_FEATURE(f, H5FD_FEAT_SELECTION_IO_OPT_IN))
+        ret_value = FALSE;
+    else if (is_write)
         ret_value = (f->shared->lf->cls->write_vector != NULL || f->shared->lf->cls->write_selection != NULL);
     else
         ret_value = (f->shared->lf->cls->read_vector != NULL || f->shared->lf->cls->read_selection != NULL);
@@ -544,6 +544,99 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* H5HG_insert() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_insert_many
+ *
+ * Purpose:	Inserts NOBJS objects into the global heap, like calling
+ *		H5HG_insert() for each of them, but protecting each
+ *		collection only once for all the objects that go into it.
+ *		When no collection has room for an object, a new collection
+ *		large enough for as many of the remaining objects as fit in
+ *		a collection is created, so the objects are packed together.
+ *
+ *		The heap ID of object U is returned in HOBJS[U].
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_insert_many(H5F_t *f, size_t nobjs, const size_t sizes[], const void *const objs[],
+                 H5HG_t hobjs[] /*out*/)
+{
+    H5HG_heap_t *heap       = NULL;               /* Collection the objects go into */
+    unsigned     heap_flags = H5AC__NO_FLAGS_SET; /* Flags for unprotecting the collection */
+    size_t       remaining  = 0;                  /* Space needed by the objects not inserted yet */
+    size_t       u;                               /* Local index variable */
+    herr_t       ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || (sizes && objs && hobjs));
+
+    if (0 == (H5F_INTENT(f) & H5F_ACC_RDWR))
+        HGOTO_ERROR(H5E_HEAP, H5E_WRITEERROR, FAIL, "no write intent on file")
+
+    for (u = 0; u < nobjs; u++)
+        remaining += H5HG_SIZEOF_OBJHDR(f) + H5HG_ALIGN(sizes[u]);
+
+    for (u = 0; u < nobjs; u++) {
+        size_t need = H5HG_SIZEOF_OBJHDR(f) + H5HG_ALIGN(sizes[u]); /* Space needed for the object */
+        size_t idx;                                                  /* Index of the object */
+
+        HDassert(0 == sizes[u] || objs[u]);
+
+        /* Move on from the current collection once the object doesn't fit */
+        if (heap && heap->obj[0].size < need) {
+            if (H5AC_unprotect(f, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+            heap       = NULL;
+            heap_flags = H5AC__NO_FLAGS_SET;
+        } /* end if */
+
+        if (NULL == heap) {
+            haddr_t addr = HADDR_UNDEF; /* Address of the collection */
+
+            /* Look for a heap in the file's CWFS that has enough space for the object */
+            if (H5F_cwfs_find_free_heap(f, need, &addr) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_NOTFOUND, FAIL, "error trying to locate heap")
+
+            /* Otherwise, create a collection for this and the following objects */
+            if (!H5_addr_defined(addr)) {
+                size_t heap_size = MAX(need, MIN(remaining, H5HG_MAXSIZE - H5HG_SIZEOF_HDR(f)));
+
+                addr = H5HG__create(f, heap_size + H5HG_SIZEOF_HDR(f));
+                if (!H5_addr_defined(addr))
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTINIT, FAIL, "unable to allocate a global heap collection")
+            } /* end if */
+
+            if (NULL == (heap = H5HG__protect(f, addr, H5AC__NO_FLAGS_SET)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+        } /* end if */
+
+        /* Split the free space to make room for the new object */
+        if (0 == (idx = H5HG__alloc(f, heap, sizes[u], &heap_flags)))
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTALLOC, FAIL, "unable to allocate global heap object")
+
+        /* Copy data into the heap */
+        if (sizes[u] > 0)
+            H5MM_memcpy(heap->obj[idx].begin + H5HG_SIZEOF_OBJHDR(f), objs[u], sizes[u]);
+        heap_flags |= H5AC__DIRTIED_FLAG;
+
+        hobjs[u].addr = heap->addr;
+        hobjs[u].idx  = idx;
+        remaining -= need;
+    } /* end for */
+
+done:
+    if (heap && H5AC_unprotect(f, H5AC_GHEAP, heap->addr, heap, heap_flags) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* H5HG_insert_many() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5HG_read
  *
@@ -616,6 +709,75 @@ done:
     FUNC_LEAVE_NOAPI_TAG(ret_value)
 } /* end H5HG_read() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5HG_read_many
+ *
+ * Purpose:	Reads the NOBJS global heap objects in HOBJS, protecting
+ *		each collection once for all the objects in it that are
+ *		adjacent in HOBJS.  OP is called for object U with a pointer
+ *		to the object in the collection, which is only valid during
+ *		the call, and the object's size.  OP must not modify the
+ *		global heap.
+ *
+ *		Sorting HOBJS by address makes the objects of a collection
+ *		adjacent and reads the collections in file order.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5HG_read_many(H5F_t *f, size_t nobjs, const H5HG_t hobjs[], H5HG_read_op_t op, void *op_data)
+{
+    H5HG_heap_t *heap      = NULL;    /* Collection of the current object */
+    size_t       u;                   /* Local index variable */
+    herr_t       ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI_TAG(H5AC__GLOBALHEAP_TAG, FAIL)
+
+    /* Check args */
+    HDassert(f);
+    HDassert(0 == nobjs || hobjs);
+    HDassert(op);
+
+    for (u = 0; u < nobjs; u++) {
+        const H5HG_obj_t *obj; /* Object in the collection */
+
+        /* Move on from the current collection */
+        if (heap && heap->addr != hobjs[u].addr) {
+            /* Advance the heap in the CWFS list, as H5HG_read() does */
+            if (heap->obj[0].begin)
+                if (H5F_cwfs_advance_heap(f, heap, FALSE) < 0)
+                    HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, FAIL, "can't adjust file's CWFS")
+            if (H5AC_unprotect(f, H5AC_GHEAP, heap->addr, heap, H5AC__NO_FLAGS_SET) < 0)
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+            heap = NULL;
+        } /* end if */
+
+        if (NULL == heap)
+            if (NULL == (heap = H5HG__protect(f, hobjs[u].addr, H5AC__READ_ONLY_FLAG)))
+                HGOTO_ERROR(H5E_HEAP, H5E_CANTPROTECT, FAIL, "unable to protect global heap")
+
+        if (hobjs[u].idx >= heap->nused || NULL == heap->obj[hobjs[u].idx].begin)
+            HGOTO_ERROR(H5E_HEAP, H5E_BADVALUE, FAIL, "invalid global heap object ID")
+        obj = &heap->obj[hobjs[u].idx];
+
+        if ((op)(obj->begin + H5HG_SIZEOF_OBJHDR(f), obj->size, u, op_data) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CALLBACK, FAIL, "global heap object callback failed")
+    } /* end for */
+
+    /* Advance the last heap in the CWFS list */
+    if (heap && heap->obj[0].begin)
+        if (H5F_cwfs_advance_heap(f, heap, FALSE) < 0)
+            HGOTO_ERROR(H5E_HEAP, H5E_CANTMODIFY, FAIL, "can't adjust file's CWFS")
+
+done:
+    if (heap && H5AC_unprotect(f, H5AC_GHEAP, heap->addr, heap, H5AC__NO_FLAGS_SET) < 0)
+        HDONE_ERROR(H5E_HEAP, H5E_CANTUNPROTECT, FAIL, "unable to unprotect heap.")
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5HG_read_many() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5HG_link
  *
@@ -25,6 +25,9 @@ typedef struct H5HG_t {
 /* Typedef for heap in memory (defined in H5HGpkg.h) */
 typedef struct H5HG_heap_t H5HG_heap_t;
 
+/* Callback for each object read by H5HG_read_many() */
+typedef herr_t (*H5HG_read_op_t)(const void *obj, size_t obj_size, size_t u, void *op_data);
+
 /*
  * Limit global heap collections to the some reasonable size.  This is
  * fairly arbitrary, but needs to be small enough that no more than H5HG_MAXIDX
@@ -50,6 +53,9 @@ typedef struct H5HG_heap_t H5HG_heap_t;
 /* Main global heap routines */
 H5_DLL herr_t H5HG_insert(H5F_t *f, size_t size, const void *obj, H5HG_t *hobj /*out*/);
 H5_DLL void  *H5HG_read(H5F_t *f, H5HG_t *hobj, void *object, size_t *buf_size /*out*/);
+H5_DLL herr_t H5HG_insert_many(H5F_t *f, size_t nobjs, const size_t sizes[], const void *const objs[],
+                               H5HG_t hobjs[] /*out*/);
+H5_DLL herr_t H5HG_read_many(H5F_t *f, size_t nobjs, const H5HG_t hobjs[], H5HG_read_op_t op, void *op_data);
 H5_DLL int    H5HG_link(H5F_t *f, const H5HG_t *hobj, int adjust);
 H5_DLL herr_t H5HG_get_obj_size(H5F_t *f, H5HG_t *hobj, size_t *obj_size);
 H5_DLL herr_t H5HG_remove(H5F_t *f, H5HG_t *hobj);
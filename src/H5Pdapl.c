@@ -59,6 +59,11 @@
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEF  H5D_CHUNK_CACHE_W0_DEFAULT
 #define H5D_ACS_PREEMPT_READ_CHUNKS_ENC  H5P__encode_double
 #define H5D_ACS_PREEMPT_READ_CHUNKS_DEC  H5P__decode_double
+/* Definitions for chunk read-ahead depth */
+#define H5D_ACS_CHUNK_PREFETCH_SIZE sizeof(unsigned)
+#define H5D_ACS_CHUNK_PREFETCH_DEF  0
+#define H5D_ACS_CHUNK_PREFETCH_ENC  H5P__encode_unsigned
+#define H5D_ACS_CHUNK_PREFETCH_DEC  H5P__decode_unsigned
 /* Definitions for VDS view option */
 #define H5D_ACS_VDS_VIEW_SIZE sizeof(H5D_vds_view_t)
 #define H5D_ACS_VDS_VIEW_DEF  H5D_VDS_LAST_AVAILABLE
@@ -190,9 +195,10 @@ static const char *H5D_def_vds_prefix_g = H5D_ACS_VDS_PREFIX_DEF; /* Default vds
 static herr_t
 H5P__dacc_reg_prop(H5P_genclass_t *pclass)
 {
-    size_t rdcc_nslots = H5D_ACS_DATA_CACHE_NUM_SLOTS_DEF;    /* Default raw data chunk cache # of slots */
-    size_t rdcc_nbytes = H5D_ACS_DATA_CACHE_BYTE_SIZE_DEF;    /* Default raw data chunk cache # of bytes */
-    double rdcc_w0     = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;     /* Default raw data chunk cache dirty ratio */
+    size_t   rdcc_nslots = H5D_ACS_DATA_CACHE_NUM_SLOTS_DEF;  /* Default raw data chunk cache # of slots */
+    size_t   rdcc_nbytes = H5D_ACS_DATA_CACHE_BYTE_SIZE_DEF;  /* Default raw data chunk cache # of bytes */
+    double   rdcc_w0     = H5D_ACS_PREEMPT_READ_CHUNKS_DEF;   /* Default raw data chunk cache dirty ratio */
+    unsigned prefetch    = H5D_ACS_CHUNK_PREFETCH_DEF;        /* Default chunk read-ahead depth */
     H5D_vds_view_t virtual_view = H5D_ACS_VDS_VIEW_DEF;       /* Default VDS view option */
     hsize_t        printf_gap   = H5D_ACS_VDS_PRINTF_GAP_DEF; /* Default VDS printf gap */
     herr_t         ret_value    = SUCCEED;                    /* Return value */
@@ -217,6 +223,12 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
                            H5D_ACS_PREEMPT_READ_CHUNKS_DEC, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the chunk read-ahead depth */
+    if (H5P__register_real(pclass, H5D_ACS_CHUNK_PREFETCH_NAME, H5D_ACS_CHUNK_PREFETCH_SIZE, &prefetch, NULL,
+                           NULL, NULL, H5D_ACS_CHUNK_PREFETCH_ENC, H5D_ACS_CHUNK_PREFETCH_DEC, NULL, NULL,
+                           NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the VDS view option */
     if (H5P__register_real(pclass, H5D_ACS_VDS_VIEW_NAME, H5D_ACS_VDS_VIEW_SIZE, &virtual_view, NULL, NULL,
                            NULL, H5D_ACS_VDS_VIEW_ENC, H5D_ACS_VDS_VIEW_DEC, NULL, NULL, NULL, NULL) < 0)
@@ -850,6 +862,69 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_cache() */
 
+/*-------------------------------------------------------------------------
+ * Function: H5Pset_chunk_prefetch
+ *
+ * Purpose:  Sets the number of chunks to read ahead into the raw data
+ *           chunk cache once the chunks read from a dataset follow a
+ *           sequential or strided pattern.  Zero (the default) disables
+ *           reading ahead.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_prefetch(hid_t dapl_id, unsigned depth)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", dapl_id, depth);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID");
+
+    /* Set value */
+    if (H5P_set(plist, H5D_ACS_CHUNK_PREFETCH_NAME, &depth) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set chunk read-ahead depth");
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_prefetch() */
+
+/*-------------------------------------------------------------------------
+ * Function: H5Pget_chunk_prefetch
+ *
+ * Purpose:  Retrieves the number of chunks to read ahead into the raw
+ *           data chunk cache of sequential or strided reads.
+ *
+ * Return:   Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_prefetch(hid_t dapl_id, unsigned *depth /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", dapl_id, depth);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(dapl_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID");
+
+    /* Get value */
+    if (depth)
+        if (H5P_get(plist, H5D_ACS_CHUNK_PREFETCH_NAME, depth) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk read-ahead depth");
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_prefetch() */
+
 /*-------------------------------------------------------------------------
  * Function:       H5P__encode_chunk_cache_nslots
  *
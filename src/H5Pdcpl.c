@@ -2994,6 +2994,54 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_shuffle() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_vlen_inline
+ *
+ * Purpose:     Sets the inline variable-length data filter,
+ *              H5Z_FILTER_VLEN, which stores the sequences of a chunked
+ *              variable-length dataset in its chunks instead of in the
+ *              global heap.  The filter must come before any other filter
+ *              in the pipeline.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_vlen_inline(hid_t plist_id)
+{
+    H5O_pline_t     pline;
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", plist_id);
+
+    /* Check arguments */
+    if (TRUE != H5P_isa_class(plist_id, H5P_DATASET_CREATE))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset creation property list")
+
+    /* Get the plist structure */
+    if (NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Add the filter, unless it's already there */
+    if (H5P_peek(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+    if (pline.nused > 0 && H5Z_FILTER_VLEN == pline.filter[0].id)
+        HGOTO_DONE(SUCCEED)
+    if (pline.nused > 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL,
+                    "the inline variable-length data filter must be the first filter")
+    if (H5Z_append(&pline, H5Z_FILTER_VLEN, H5Z_FLAG_MANDATORY, (size_t)0, NULL) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add inline vlen filter to pipeline")
+    if (H5P_poke(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_vlen_inline() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_nbit
  *
@@ -182,6 +182,22 @@
 #define H5D_XFER_MODIFY_WRITE_BUF_DEF  FALSE
 #define H5D_XFER_MODIFY_WRITE_BUF_ENC  H5P__dxfr_modify_write_buf_enc
 #define H5D_XFER_MODIFY_WRITE_BUF_DEC  H5P__dxfr_modify_write_buf_dec
+/* Definitions for number of filter pipeline threads property */
+#define H5D_XFER_FILTER_NTHREADS_SIZE sizeof(unsigned)
+#define H5D_XFER_FILTER_NTHREADS_DEF  1
+#define H5D_XFER_FILTER_NTHREADS_ENC  H5P__encode_unsigned
+#define H5D_XFER_FILTER_NTHREADS_DEC  H5P__decode_unsigned
+/* Definitions for vector read gap property */
+#define H5D_XFER_VECTOR_READ_GAP_SIZE sizeof(size_t)
+#define H5D_XFER_VECTOR_READ_GAP_DEF  0
+#define H5D_XFER_VECTOR_READ_GAP_ENC  H5P__encode_size_t
+#define H5D_XFER_VECTOR_READ_GAP_DEC  H5P__decode_size_t
+/* Definitions for VL data arena property */
+#define H5D_XFER_VLEN_ARENA_SIZE  sizeof(H5T_vlen_arena_t *)
+#define H5D_XFER_VLEN_ARENA_DEF   NULL
+#define H5D_XFER_VLEN_ARENA_COPY  H5P__dxfr_vlen_arena_copy
+#define H5D_XFER_VLEN_ARENA_CMP   H5P__dxfr_vlen_arena_cmp
+#define H5D_XFER_VLEN_ARENA_CLOSE H5P__dxfr_vlen_arena_close
 
 /******************/
 /* Local Typedefs */
@@ -226,6 +242,9 @@ static herr_t H5P__dxfr_selection_io_mode_enc(const void *value, void **pp, size
 static herr_t H5P__dxfr_selection_io_mode_dec(const void **pp, void *value);
 static herr_t H5P__dxfr_modify_write_buf_enc(const void *value, void **pp, size_t *size);
 static herr_t H5P__dxfr_modify_write_buf_dec(const void **pp, void *value);
+static herr_t H5P__dxfr_vlen_arena_copy(const char *name, size_t size, void *value);
+static int    H5P__dxfr_vlen_arena_cmp(const void *value1, const void *value2, size_t size);
+static herr_t H5P__dxfr_vlen_arena_close(const char *name, size_t size, void *value);
 
 /*********************/
 /* Package Variables */
@@ -298,6 +317,9 @@ static const H5S_t *H5D_def_dset_io_sel_g =
 static const H5D_selection_io_mode_t H5D_def_selection_io_mode_g     = H5D_XFER_SELECTION_IO_MODE_DEF;
 static const uint32_t                H5D_def_no_selection_io_cause_g = H5D_XFER_NO_SELECTION_IO_CAUSE_DEF;
 static const hbool_t                 H5D_def_modify_write_buf_g      = H5D_XFER_MODIFY_WRITE_BUF_DEF;
+static const unsigned                H5D_def_filter_nthreads_g       = H5D_XFER_FILTER_NTHREADS_DEF;
+static const size_t                  H5D_def_vector_read_gap_g       = H5D_XFER_VECTOR_READ_GAP_DEF;
+static const H5T_vlen_arena_t       *H5D_def_vlen_arena_g            = H5D_XFER_VLEN_ARENA_DEF;
 
 /*-------------------------------------------------------------------------
  * Function:    H5P__dxfr_reg_prop
@@ -480,6 +502,25 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
                            H5D_XFER_MODIFY_WRITE_BUF_DEC, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the number of filter pipeline threads property */
+    if (H5P__register_real(pclass, H5D_XFER_FILTER_NTHREADS_NAME, H5D_XFER_FILTER_NTHREADS_SIZE,
+                           &H5D_def_filter_nthreads_g, NULL, NULL, NULL, H5D_XFER_FILTER_NTHREADS_ENC,
+                           H5D_XFER_FILTER_NTHREADS_DEC, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the vector read gap property */
+    if (H5P__register_real(pclass, H5D_XFER_VECTOR_READ_GAP_NAME, H5D_XFER_VECTOR_READ_GAP_SIZE,
+                           &H5D_def_vector_read_gap_g, NULL, NULL, NULL, H5D_XFER_VECTOR_READ_GAP_ENC,
+                           H5D_XFER_VECTOR_READ_GAP_DEC, NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the VL data arena property */
+    /* (Note: this property should not have an encode/decode callback) */
+    if (H5P__register_real(pclass, H5D_XFER_VLEN_ARENA_NAME, H5D_XFER_VLEN_ARENA_SIZE, &H5D_def_vlen_arena_g,
+                           NULL, NULL, NULL, NULL, NULL, NULL, H5D_XFER_VLEN_ARENA_COPY,
+                           H5D_XFER_VLEN_ARENA_CMP, H5D_XFER_VLEN_ARENA_CLOSE) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dxfr_reg_prop() */
@@ -2297,6 +2338,92 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dxfr_dset_io_hyp_sel_close() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dxfr_vlen_arena_copy
+ *
+ * Purpose:     Shares the VL data arena with the new property list, so
+ *              that VL data read with either list ends up in the same
+ *              arena.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dxfr_vlen_arena_copy(const char H5_ATTR_UNUSED *name, size_t H5_ATTR_UNUSED size, void *value)
+{
+    H5T_vlen_arena_t *arena     = *(H5T_vlen_arena_t **)value; /* Arena for property */
+    herr_t            ret_value = SUCCEED;                     /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (arena && H5T_vlen_arena_incr(arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINC, FAIL, "can't share VL data arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_copy() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dxfr_vlen_arena_cmp
+ *
+ * Purpose:     Compare two VL data arena properties, by their block size.
+ *
+ * Return:      positive if VALUE1 is greater than VALUE2, negative if VALUE2 is
+ *		greater than VALUE1 and zero if VALUE1 and VALUE2 are equal.
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5P__dxfr_vlen_arena_cmp(const void *_arena1, const void *_arena2, size_t H5_ATTR_UNUSED size)
+{
+    const H5T_vlen_arena_t *const *arena1 = (const H5T_vlen_arena_t *const *)_arena1; /* Local alias */
+    const H5T_vlen_arena_t *const *arena2 = (const H5T_vlen_arena_t *const *)_arena2; /* Local alias */
+    size_t                         block_size1, block_size2; /* Block sizes of the arenas */
+    int                            ret_value = 0;            /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(size == sizeof(H5T_vlen_arena_t *));
+
+    /* Compare the block sizes, with no arena counting as a block size of 0 */
+    block_size1 = *arena1 ? H5T_vlen_arena_block_size(*arena1) : 0;
+    block_size2 = *arena2 ? H5T_vlen_arena_block_size(*arena2) : 0;
+    if (block_size1 < block_size2)
+        HGOTO_DONE(-1);
+    if (block_size1 > block_size2)
+        HGOTO_DONE(1);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dxfr_vlen_arena_close
+ *
+ * Purpose:     Drops the property list's reference to its VL data arena,
+ *              releasing the arena and the VL data in it when no other
+ *              property list shares it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dxfr_vlen_arena_close(const char H5_ATTR_UNUSED *name, size_t H5_ATTR_UNUSED size, void *value)
+{
+    H5T_vlen_arena_t *arena     = *(H5T_vlen_arena_t **)value; /* Arena for property */
+    herr_t            ret_value = SUCCEED;                     /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (arena && H5T_vlen_arena_close(arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTCLOSEOBJ, FAIL, "error closing VL data arena")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5P__dxfr_vlen_arena_close() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5P__dxfr_selection_io_mode_enc
  *
@@ -2742,3 +2869,240 @@ H5Pget_modify_write_buf(hid_t plist_id, hbool_t *modify_write_buf /*out*/)
 done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_modify_write_buf() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_filter_nthreads
+ *
+ * Purpose:     Sets the number of threads the library may use to run the
+ *              filter pipeline on the chunks of a filtered dataset during
+ *              a single I/O operation.  A value of 1 (the default) runs
+ *              the filters on the calling thread.
+ *
+ * Return:      Success:    Non-negative
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_filter_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if (plist_id == H5P_DEFAULT)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't set values in default property list")
+    if (nthreads == 0)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be positive")
+
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a dxpl")
+
+    /* Set the number of threads */
+    if (H5P_set(plist, H5D_XFER_FILTER_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_filter_nthreads() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_filter_nthreads
+ *
+ * Purpose:     Retrieves the number of threads the library may use to run
+ *              the filter pipeline on chunks.
+ *
+ * Return:      Success:    Non-negative
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_filter_nthreads(hid_t plist_id, unsigned *nthreads /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Check arguments */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a dxpl")
+
+    /* Get the number of threads */
+    if (nthreads)
+        if (H5P_get(plist, H5D_XFER_FILTER_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_filter_nthreads() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_vector_read_gap
+ *
+ * Purpose:     Sets the largest gap, in bytes, between two pieces of a
+ *              vector or selection read that the library may read through
+ *              (and discard) in order to merge the pieces into a single
+ *              read from the file.  A value of 0 (the default) only merges
+ *              pieces that are adjacent in the file.
+ *
+ * Return:      Success:    Non-negative
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_vector_read_gap(hid_t plist_id, size_t gap)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, gap);
+
+    /* Check arguments */
+    if (plist_id == H5P_DEFAULT)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't set values in default property list")
+
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a dxpl")
+
+    /* Set the gap */
+    if (H5P_set(plist, H5D_XFER_VECTOR_READ_GAP_NAME, &gap) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_vector_read_gap() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_vector_read_gap
+ *
+ * Purpose:     Retrieves the largest gap the library may read through when
+ *              merging the pieces of a vector or selection read.
+ *
+ * Return:      Success:    Non-negative
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_vector_read_gap(hid_t plist_id, size_t *gap /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, gap);
+
+    /* Check arguments */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a dxpl")
+
+    /* Get the gap */
+    if (gap)
+        if (H5P_get(plist, H5D_XFER_VECTOR_READ_GAP_NAME, gap) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_vector_read_gap() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_vlen_arena
+ *
+ * Purpose:     Makes the library allocate the memory for the variable-length
+ *              data read with the dataset transfer property list from an
+ *              arena of BLOCK_SIZE-byte blocks, which H5Treclaim() (or
+ *              closing the property list) releases all at once.  A
+ *              BLOCK_SIZE of 0 removes the arena from the list.
+ *
+ * Return:      Success:    Non-negative
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_vlen_arena(hid_t plist_id, size_t block_size)
+{
+    H5P_genplist_t   *plist;               /* Property list pointer */
+    H5T_vlen_arena_t *old_arena = NULL;    /* Previous arena */
+    H5T_vlen_arena_t *arena     = NULL;    /* New arena */
+    herr_t            ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, block_size);
+
+    /* Check arguments */
+    if (plist_id == H5P_DEFAULT)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't set values in default property list")
+
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a dxpl")
+
+    /* Get the current arena */
+    if (H5P_peek(plist, H5D_XFER_VLEN_ARENA_NAME, &old_arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+    /* Create the new arena */
+    if (block_size > 0)
+        if (NULL == (arena = H5T_vlen_arena_create(block_size)))
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTCREATE, FAIL, "can't create VL data arena")
+
+    /* Update property list (takes ownership of the arena) */
+    if (H5P_poke(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+    arena = NULL;
+
+    /* Release the previous arena */
+    if (old_arena && H5T_vlen_arena_close(old_arena) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTCLOSEOBJ, FAIL, "error closing VL data arena")
+
+done:
+    if (arena && H5T_vlen_arena_close(arena) < 0)
+        HDONE_ERROR(H5E_PLIST, H5E_CANTCLOSEOBJ, FAIL, "error closing VL data arena")
+
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_vlen_arena() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_vlen_arena
+ *
+ * Purpose:     Retrieves the block size of the arena for variable-length
+ *              data set with H5Pset_vlen_arena(), or 0 when the property
+ *              list has no arena.
+ *
+ * Return:      Success:    Non-negative
+ *              Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_vlen_arena(hid_t plist_id, size_t *block_size /*out*/)
+{
+    H5P_genplist_t   *plist;               /* Property list pointer */
+    H5T_vlen_arena_t *arena     = NULL;    /* Arena for property */
+    herr_t            ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, block_size);
+
+    /* Check arguments */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_PLIST, H5E_BADTYPE, FAIL, "not a dxpl")
+
+    /* Get the block size */
+    if (block_size) {
+        if (H5P_peek(plist, H5D_XFER_VLEN_ARENA_NAME, &arena) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+        *block_size = arena ? H5T_vlen_arena_block_size(arena) : 0;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_vlen_arena() */
@@ -53,9 +53,15 @@
 #ifdef H5_HAVE_DIRECT
 #include "H5FDdirect.h"
 #endif
+#ifdef H5_HAVE_IOURING_VFD
+#include "H5FDiouring.h"
+#endif
 #ifdef H5_HAVE_MIRROR_VFD
 #include "H5FDmirror.h"
 #endif
+#ifdef H5_HAVE_MMAP
+#include "H5FDmmap.h"
+#endif
 #ifdef H5_HAVE_LIBHDFS
 #include "H5FDhdfs.h"
 #endif
@@ -98,6 +104,11 @@
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEF  0.75
 #define H5F_ACS_PREEMPT_READ_CHUNKS_ENC  H5P__encode_double
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEC  H5P__decode_double
+/* Definition for size of the file-wide raw data chunk cache(bytes) */
+#define H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_SIZE sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_DEF  0
+#define H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_ENC  H5P__encode_size_t
+#define H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_DEC  H5P__decode_size_t
 /* Definition for threshold for alignment */
 #define H5F_ACS_ALIGN_THRHD_SIZE sizeof(hsize_t)
 #define H5F_ACS_ALIGN_THRHD_DEF  H5F_ALIGN_THRHD_DEF
@@ -463,6 +474,8 @@ static const size_t H5F_def_rdcc_nbytes_g =
     H5F_ACS_DATA_CACHE_BYTE_SIZE_DEF; /* Default raw data chunk cache # of bytes */
 static const double H5F_def_rdcc_w0_g =
     H5F_ACS_PREEMPT_READ_CHUNKS_DEF; /* Default raw data chunk cache dirty ratio */
+static const size_t H5F_def_rdcc_file_nbytes_g =
+    H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_DEF; /* Default file-wide raw data chunk cache # of bytes */
 static const hsize_t H5F_def_threshold_g =
     H5F_ACS_ALIGN_THRHD_DEF;                                  /* Default allocation alignment threshold */
 static const hsize_t H5F_def_alignment_g = H5F_ACS_ALIGN_DEF; /* Default allocation alignment value */
@@ -578,6 +591,13 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
                            H5F_ACS_PREEMPT_READ_CHUNKS_DEC, NULL, NULL, NULL, NULL) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the size of the file-wide raw data chunk cache(bytes) */
+    if (H5P__register_real(pclass, H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_NAME,
+                           H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_SIZE, &H5F_def_rdcc_file_nbytes_g, NULL, NULL,
+                           NULL, H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_ENC, H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_DEC,
+                           NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
     /* Register the threshold for alignment */
     if (H5P__register_real(pclass, H5F_ACS_ALIGN_THRHD_NAME, H5F_ACS_ALIGN_THRHD_SIZE, &H5F_def_threshold_g,
                            NULL, NULL, NULL, H5F_ACS_ALIGN_THRHD_ENC, H5F_ACS_ALIGN_THRHD_DEC, NULL, NULL,
@@ -993,6 +1013,22 @@ H5P__facc_set_def_driver_check_predefined(const char *driver_name, hid_t *driver
             HGOTO_ERROR(H5E_VFL, H5E_UNINITIALIZED, FAIL, "couldn't initialize Direct I/O VFD")
 #else
         HGOTO_ERROR(H5E_VFL, H5E_BADVALUE, FAIL, "Direct I/O VFD is not enabled")
+#endif
+    }
+    else if (!HDstrcmp(driver_name, "iouring")) {
+#ifdef H5_HAVE_IOURING_VFD
+        if ((*driver_id = H5FD_IOURING) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_UNINITIALIZED, FAIL, "couldn't initialize io_uring VFD")
+#else
+        HGOTO_ERROR(H5E_VFL, H5E_BADVALUE, FAIL, "io_uring VFD is not enabled")
+#endif
+    }
+    else if (!HDstrcmp(driver_name, "mmap")) {
+#ifdef H5_HAVE_MMAP
+        if ((*driver_id = H5FD_MMAP) < 0)
+            HGOTO_ERROR(H5E_VFL, H5E_UNINITIALIZED, FAIL, "couldn't initialize memory-mapped VFD")
+#else
+        HGOTO_ERROR(H5E_VFL, H5E_BADVALUE, FAIL, "memory-mapped VFD is not enabled")
 #endif
     }
     else if (!HDstrcmp(driver_name, "mirror")) {
@@ -2287,6 +2323,74 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_cache() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_file_chunk_cache
+ *
+ * Purpose:    Set the size of the raw data chunk cache shared by all the
+ *        datasets of a file.  The chunk caches of the file's datasets
+ *        take their space from this one budget, and the least recently
+ *        used chunks of the file are preempted, whatever their dataset,
+ *        when it is exceeded.  A size of zero (the default) gives each
+ *        dataset its own cache, as set by H5Pset_cache() and
+ *        H5Pset_chunk_cache().
+ *
+ * Return:    Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_file_chunk_cache(hid_t plist_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Set size */
+    if (H5P_set(plist, H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set file-wide data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_file_chunk_cache() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_file_chunk_cache
+ *
+ * Purpose:    Retrieves the size of the raw data chunk cache shared by all
+ *        the datasets of a file.
+ *
+ * Return:    Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_file_chunk_cache(hid_t plist_id, size_t *nbytes /*out*/)
+{
+    H5P_genplist_t *plist;               /* Property list pointer */
+    herr_t          ret_value = SUCCEED; /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if (NULL == (plist = H5P_object_verify(plist_id, H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Get size */
+    if (nbytes)
+        if (H5P_get(plist, H5F_ACS_DATA_CACHE_FILE_BYTE_SIZE_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get file-wide data cache byte size")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_file_chunk_cache() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_mdc_image_config
  *
@@ -1950,6 +1950,10 @@ H5_DLL herr_t H5Pget_attr_phase_change(hid_t plist_id, unsigned *max_compact, un
  *         - #H5Z_FILTER_SHUFFLE     Data shuffling filter
  *         - #H5Z_FILTER_FLETCHER32  Error detection filter, employing the
  *                                     Fletcher32 checksum algorithm
+ *         - #H5Z_FILTER_CRC32C      Error detection filter, employing the
+ *                                     CRC32C checksum algorithm
+ *         - #H5Z_FILTER_VLEN        Storage of variable-length data inline
+ *                                     in the chunks of a dataset
  *         - #H5Z_FILTER_SZIP        Data compression filter, employing the
  *                                     SZIP algorithm
  *         - #H5Z_FILTER_NBIT        Data compression filter, employing the
@@ -2172,6 +2176,16 @@ H5_DLL herr_t H5Pmodify_filter(hid_t plist_id, H5Z_filter_t filter, unsigned int
  *                checksum algorithm</td>
  *           </tr>
  *           <tr>
+ *            <td>#H5Z_FILTER_CRC32C</td>
+ *            <td>Error detection filter, employing the CRC32C
+ *                checksum algorithm</td>
+ *           </tr>
+ *           <tr>
+ *            <td>#H5Z_FILTER_VLEN</td>
+ *            <td>Storage of variable-length data inline in the
+ *                chunks of a dataset</td>
+ *           </tr>
+ *           <tr>
  *            <td>#H5Z_FILTER_SZIP</td>
  *            <td>Data compression filter, employing the SZIP
  *                algorithm</td>
@@ -2455,6 +2469,16 @@ H5_DLL herr_t H5Pset_deflate(hid_t plist_id, unsigned level);
  *                checksum algorithm</td>
  *           </tr>
  *           <tr>
+ *            <td>#H5Z_FILTER_CRC32C</td>
+ *            <td>Error detection filter, employing the CRC32C
+ *                checksum algorithm</td>
+ *           </tr>
+ *           <tr>
+ *            <td>#H5Z_FILTER_VLEN</td>
+ *            <td>Storage of variable-length data inline in the
+ *                chunks of a dataset</td>
+ *           </tr>
+ *           <tr>
  *            <td>#H5Z_FILTER_SZIP</td>
  *            <td>Data compression filter, employing the SZIP
  *                algorithm</td>
@@ -3614,6 +3638,29 @@ H5_DLL herr_t H5Pget_family_offset(hid_t fapl_id, hsize_t *offset);
  *
  */
 H5_DLL herr_t H5Pget_fclose_degree(hid_t fapl_id, H5F_close_degree_t *degree);
+/**
+ * \ingroup FAPL
+ *
+ * \brief Retrieves the size of the raw data chunk cache shared by the
+ *        datasets of a file
+ *
+ * \fapl_id{plist_id}
+ * \param[out] nbytes Total size of the file-wide raw data chunk cache, in
+ *                    bytes
+ *
+ * \return \herr_t
+ *
+ * \details H5Pget_file_chunk_cache() retrieves the size of the raw data
+ *          chunk cache that all the chunked datasets of a file share, as
+ *          set with H5Pset_file_chunk_cache().  A size of \c 0 means that
+ *          each dataset has its own chunk cache.
+ *
+ * \see H5Pset_file_chunk_cache(), H5Pget_cache()
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pget_file_chunk_cache(hid_t plist_id, size_t *nbytes /*out*/);
 /**
  * \ingroup FAPL
  *
@@ -4192,17 +4239,11 @@ H5_DLL herr_t H5Pset_alignment(hid_t fapl_id, hsize_t threshold, hsize_t alignme
  *
  * \fapl_id{plist_id}
  * \param[in] mdc_nelmts No longer used; any value passed is ignored
- * \param[in] rdcc_nslots The number of chunk slots in the raw data chunk
- *                        cache for this dataset. Increasing this value
- *                        reduces the number of cache collisions, but
- *                        slightly increases the memory used. Due to the
- *                        hashing strategy, this value should ideally be a
- *                        prime number. As a rule of thumb, this value
- *                        should be at least 10 times the number of chunks
- *                        that can fit in \p rdcc_nbytes bytes. For
- *                        maximum performance, this value should be set
- *                        approximately 100 times that number of chunks.
- *                        The default value is 521.
+ * \param[in] rdcc_nslots The initial number of chunk slots in the raw data
+ *                        chunk cache for this dataset. The library grows
+ *                        the number of slots as needed, up to room for
+ *                        twice as many chunks as can fit in \p rdcc_nbytes
+ *                        bytes, so this value rarely needs tuning. The default value is 521.
  * \param[in] rdcc_nbytes Total size of the raw data chunk cache in bytes.
  *                        The default size is 1 MB per dataset.
  * \param[in] rdcc_w0     The chunk preemption policy for all datasets.
@@ -4230,15 +4271,16 @@ H5_DLL herr_t H5Pset_alignment(hid_t fapl_id, hsize_t threshold, hsize_t alignme
  *          bytes, and the preemption policy value for all datasets in a file
  *          on the file’s file access property list.
  *
- *          The raw data chunk cache inserts chunks into the cache by first
- *          computing a hash value using the address of a chunk and then by
- *          using that hash value as the chunk’s index into the table of
- *          cached chunks. In other words, the size of this hash table and the
- *          number of possible hash values are determined by the \p rdcc_nslots
- *          parameter. If a different chunk in the cache has the same hash value,
- *          a collision will occur, which will reduce efficiency. If inserting
- *          the chunk into the cache would cause the cache to be too big, then
- *          the cache will be pruned according to the \p rdcc_w0 parameter.
+ *          The raw data chunk cache finds chunks through a hash table made
+ *          of sets of slots. A hash value computed from a chunk's coordinates
+ *          selects a set, and the chunk can be kept in any slot of that set.
+ *          The table starts with \p rdcc_nslots slots and grows as chunks
+ *          are cached, up to twice as many slots as chunks fit in
+ *          \p rdcc_nbytes bytes. Only when every slot of a chunk's set is in
+ *          use and the table can't grow is the least recently used chunk of
+ *          the set evicted to make room. If inserting the chunk into the cache
+ *          would cause the cache to be too big, then the cache will be pruned
+ *          according to the \p rdcc_w0 parameter.
  *
  *          The \p mdc_nelmts parameter is no longer used; any value passed
  *          in that parameter will be ignored.
@@ -4612,6 +4654,43 @@ H5_DLL herr_t H5Pset_family_offset(hid_t fapl_id, hsize_t offset);
  *
  */
 H5_DLL herr_t H5Pset_fclose_degree(hid_t fapl_id, H5F_close_degree_t degree);
+/**
+ * \ingroup FAPL
+ *
+ * \brief Sets the size of a raw data chunk cache shared by the datasets of
+ *        a file
+ *
+ * \fapl_id{plist_id}
+ * \param[in] nbytes Total size of the file-wide raw data chunk cache, in
+ *                   bytes, or \c 0 to give each dataset its own cache
+ *
+ * \return \herr_t
+ *
+ * \details H5Pset_file_chunk_cache() sets one memory budget for the raw
+ *          data chunk caches of all the chunked datasets of a file,
+ *          instead of a fixed budget for each of them.  When the chunks
+ *          cached for the file's datasets exceed \p nbytes, the least
+ *          recently used chunks of the file are preempted, whichever
+ *          dataset they belong to, so that the datasets being accessed
+ *          get the room that idle datasets don't use.
+ *
+ *          The per-dataset limits still apply: a dataset whose cache size
+ *          was set with H5Pset_chunk_cache() never caches more than that
+ *          size.  A dataset whose cache size was left at the default may
+ *          use the whole file-wide cache, and the \p rdcc_nbytes value set
+ *          with H5Pset_cache() is then ignored.  The \p rdcc_nslots and
+ *          \p rdcc_w0 values still apply to each dataset.
+ *
+ *          The default of \c 0 gives each dataset its own cache, as set
+ *          with H5Pset_cache() and H5Pset_chunk_cache().  The file-wide
+ *          cache is not used with parallel HDF5.
+ *
+ * \see H5Pget_file_chunk_cache(), H5Pset_cache(), H5Pset_chunk_cache()
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_file_chunk_cache(hid_t plist_id, size_t nbytes);
 /**
  * \ingroup FAPL
  *
@@ -6478,10 +6557,62 @@ H5_DLL herr_t H5Pset_fill_value(hid_t plist_id, hid_t type_id, const void *value
  *          superior to that achieved by the use of a compression filter
  *          without the shuffle filter.
  *
+ *          The shuffle filter can instead group the bits of each bit
+ *          position of the elements together, which suits integer data
+ *          where only a few low bits vary.  This mode is set with
+ *          H5Pset_filter(), passing #H5Z_FILTER_SHUFFLE with
+ *          #H5Z_SHUFFLE_MAX_NPARMS parameters, of which the parameter at
+ *          index #H5Z_SHUFFLE_PARM_MODE is #H5Z_SHUFFLE_MODE_BIT and the
+ *          first, the datatype size, is set by the library. For example:
+ *          \code
+ *          unsigned cd_values[H5Z_SHUFFLE_MAX_NPARMS] = {0, H5Z_SHUFFLE_MODE_BIT};
+ *          H5Pset_filter(plist_id, H5Z_FILTER_SHUFFLE, H5Z_FLAG_OPTIONAL, H5Z_SHUFFLE_MAX_NPARMS, cd_values);
+ *          \endcode
+ *          The bits of whole groups of 8 elements are shuffled, and any
+ *          elements after the last group are stored as they are. Datasets
+ *          written in this mode can't be read by versions of the library
+ *          before 1.15.0.
+ *
  * \since 1.6.0
  *
  */
 H5_DLL herr_t H5Pset_shuffle(hid_t plist_id);
+/**
+ * \ingroup DCPL
+ *
+ * \brief Sets up the storage of variable-length data inline in the chunks
+ *        of a dataset
+ *
+ * \dcpl_id{plist_id}
+ *
+ * \return \herr_t
+ *
+ * \details H5Pset_vlen_inline() sets the inline variable-length data
+ *          filter, #H5Z_FILTER_VLEN, in the dataset creation property list
+ *          \p plist_id. The filter stores the sequences (or strings) of a
+ *          chunked variable-length dataset in the chunks of the dataset,
+ *          after the elements of each chunk, instead of in the global heap.
+ *          The filters that follow it in the pipeline, such as the deflate
+ *          filter set with H5Pset_deflate(), then compress the sequences
+ *          together with the rest of the chunk, and a chunk is read and
+ *          written with a single I/O operation.
+ *
+ *          The filter must be the first filter of the pipeline, so this
+ *          function must be called before any other filter is set. The
+ *          dataset's datatype must be a variable-length sequence or string
+ *          whose elements don't hold variable-length data or references
+ *          themselves, the dataset can't have a user-defined fill value
+ *          and the #H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS option can't be
+ *          set. Creating a dataset that doesn't meet these requirements
+ *          fails.
+ *
+ *          Datasets written with this filter can't be read by versions of
+ *          the library before 1.15.0.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_vlen_inline(hid_t plist_id);
 /**
  * \ingroup DCPL
  *
@@ -7073,6 +7204,24 @@ H5_DLL herr_t H5Pget_append_flush(hid_t dapl_id, unsigned dims, hsize_t boundary
  */
 H5_DLL herr_t H5Pget_chunk_cache(hid_t dapl_id, size_t *rdcc_nslots /*out*/, size_t *rdcc_nbytes /*out*/,
                                  double *rdcc_w0 /*out*/);
+/**
+ * \ingroup DAPL
+ *
+ * \brief Retrieves the number of chunks read ahead of sequential reads
+ *
+ * \dapl_id
+ * \param[out] depth Number of chunks to read ahead
+ *
+ * \return \herr_t
+ *
+ * \details H5Pget_chunk_prefetch() retrieves the read-ahead depth set
+ *          with H5Pset_chunk_prefetch() on the dataset access property
+ *          list \p dapl_id.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pget_chunk_prefetch(hid_t dapl_id, unsigned *depth /*out*/);
 /**
  * \ingroup DAPL
  *
@@ -7276,16 +7425,11 @@ H5_DLL herr_t H5Pset_append_flush(hid_t dapl_id, unsigned ndims, const hsize_t b
  * \brief Sets the raw data chunk cache parameters
  *
  * \dapl_id
- * \param[in] rdcc_nslots The number of chunk slots in the raw data chunk
- *                        cache for this dataset. Increasing this value
- *                        reduces the number of cache collisions, but
- *                        slightly increases the memory used. Due to the
- *                        hashing strategy, this value should ideally be a
- *                        prime number. As a rule of thumb, this value
- *                        should be at least 10 times the number of chunks
- *                        that can fit in \p rdcc_nbytes bytes. For maximum
- *                        performance, this value should be set
- *                        approximately 100 times that number of chunks.
+ * \param[in] rdcc_nslots The initial number of chunk slots in the raw data
+ *                        chunk cache for this dataset. The library grows
+ *                        the number of slots as needed, up to room for
+ *                        twice as many chunks as can fit in \p rdcc_nbytes
+ *                        bytes, so this value rarely needs tuning.
  *                        The default value is 521. If the value passed is
  *                        #H5D_CHUNK_CACHE_NSLOTS_DEFAULT, then the
  *                        property will not be set on \p dapl_id and the
@@ -7299,7 +7443,9 @@ H5_DLL herr_t H5Pset_append_flush(hid_t dapl_id, unsigned ndims, const hsize_t b
  *                        #H5D_CHUNK_CACHE_NBYTES_DEFAULT, then the
  *                        property will not be set on \p dapl_id and the
  *                        parameter will come from the file access
- *                        property list.
+ *                        property list, or is the size of the file-wide
+ *                        chunk cache set with H5Pset_file_chunk_cache(),
+ *                        if any.
  * \param[in] rdcc_w0     The chunk preemption policy for this dataset.
  *                        This must be between 0 and 1 inclusive and
  *                        indicates the weighting according to which chunks
@@ -7328,16 +7474,17 @@ H5_DLL herr_t H5Pset_append_flush(hid_t dapl_id, unsigned ndims, const hsize_t b
  *          will override the values in the file's file access property
  *          list.
  *
- *          The raw data chunk cache inserts chunks into the cache
- *          by first computing a hash value using the address of a chunk,
- *          then using that hash value as the chunk's index into the table
- *          of cached chunks. The size of this hash table, i.e., and the
- *          number of possible hash values, is determined by the
- *          \p rdcc_nslots parameter. If a different chunk in the cache
- *          has the same hash value, this causes a collision, which
- *          reduces efficiency. If inserting the chunk into cache would
- *          cause the cache to be too big, then the cache is pruned
- *          according to the \p rdcc_w0 parameter.
+ *          The raw data chunk cache finds chunks through a hash table
+ *          made of sets of slots. A hash value computed from a chunk's
+ *          coordinates selects a set, and the chunk can be kept in any
+ *          slot of that set. The table starts with \p rdcc_nslots slots
+ *          and grows as chunks are cached, up to twice as many slots as
+ *          chunks fit in \p rdcc_nbytes bytes. Only when every slot of a
+ *          chunk's set is in use and the table can't grow is the least
+ *          recently used chunk of the set evicted to make room. If
+ *          inserting the chunk into cache would cause the cache to be too
+ *          big, then the cache is pruned according to the \p rdcc_w0
+ *          parameter.
  *
  *      \b Motivation: H5Pset_chunk_cache() is used to adjust the chunk
  *       cache parameters on a per-dataset basis, as opposed to a global
@@ -7390,6 +7537,41 @@ H5_DLL herr_t H5Pset_append_flush(hid_t dapl_id, unsigned ndims, const hsize_t b
  *
  */
 H5_DLL herr_t H5Pset_chunk_cache(hid_t dapl_id, size_t rdcc_nslots, size_t rdcc_nbytes, double rdcc_w0);
+/**
+ * \ingroup DAPL
+ *
+ * \brief Sets the number of chunks read ahead of sequential reads
+ *
+ * \dapl_id
+ * \param[in] depth Number of chunks to read ahead; 0 disables reading
+ *                  ahead
+ *
+ * \return \herr_t
+ *
+ * \details H5Pset_chunk_prefetch() enables reading ahead for a chunked
+ *          dataset.  When the chunks touched by successive H5Dread()
+ *          calls advance through the dataset by a constant stride in
+ *          linear chunk order, the library reads up to \p depth of the
+ *          following chunks, unfilters them, and places them in the raw
+ *          data chunk cache so the next read finds them there.
+ *
+ *          Chunks are only read ahead as far as the raw data chunk cache
+ *          (see H5Pset_chunk_cache()) can hold them next to the chunk
+ *          just read, and chunks that have not been allocated are
+ *          skipped.  When the dataset transfer property list allows more
+ *          than one filter thread (see H5Pset_filter_nthreads()), the
+ *          chunks read ahead are unfiltered concurrently.
+ *
+ *          Reading ahead is done at the end of the H5Dread() call that
+ *          established the pattern; the library does not start
+ *          background threads.
+ *
+ *          The default depth is 0, which disables reading ahead.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_chunk_prefetch(hid_t dapl_id, unsigned depth);
 /**
  * \ingroup DAPL
  *
@@ -8447,6 +8629,204 @@ H5_DLL herr_t H5Pset_modify_write_buf(hid_t plist_id, hbool_t modify_write_buf);
  */
 H5_DLL herr_t H5Pget_modify_write_buf(hid_t plist_id, hbool_t *modify_write_buf);
 
+/**
+ *
+ * \ingroup DXPL
+ *
+ * \brief Sets the number of threads used to run the filter pipeline on chunks
+ *
+ * \dxpl_id{plist_id}
+ * \param[in] nthreads   Maximum number of threads to use, including the
+ *                       calling thread
+ *
+ * \return \herr_t
+ *
+ * \details H5Pset_filter_nthreads() sets the maximum number of threads the
+ *          library may use to run the filter pipeline on the chunks of a
+ *          filtered dataset during a single I/O operation that is passed the
+ *          dataset transfer property list \p plist_id.  The default value is 1,
+ *          which runs all filters on the calling thread.
+ *
+ *          When \p nthreads is greater than 1, H5Dread() first reads the
+ *          stored bytes of the chunks in the selection that are not already in
+ *          the chunk cache, then runs the filter pipeline on those chunks
+ *          concurrently before scattering the data into the application's
+ *          buffer.
+ *
+ *          The value is also used when an H5Dread() or H5Dwrite() call
+ *          evicts dirty chunks from the chunk cache to make room for other
+ *          chunks.  The dirty chunks are compressed concurrently, then file
+ *          space is allocated for them and they are written in order.  Dirty
+ *          chunks flushed by H5Dflush(), H5Fflush() or closing the dataset
+ *          are compressed on the calling thread.
+ *
+ * \note    Threads are only used in thread-safe builds of the library, and
+ *          only for pipelines made up entirely of filters that are built into
+ *          the library.  In all other cases the setting is accepted but the
+ *          filters are run on the calling thread.
+ *
+ * \note    The filter callback set with H5Pset_filter_callback() is only
+ *          called on the calling thread.  A chunk that fails a filter on
+ *          another thread is run through the filter pipeline again on the
+ *          calling thread, with the callback.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_filter_nthreads(hid_t plist_id, unsigned nthreads);
+
+/**
+ *
+ * \ingroup DXPL
+ *
+ * \brief Retrieves the number of threads used to run the filter pipeline on
+ *        chunks
+ *
+ * \dxpl_id{plist_id}
+ * \param[out] nthreads   Maximum number of threads to use, including the
+ *                        calling thread
+ *
+ * \return \herr_t
+ *
+ * \details H5Pget_filter_nthreads() retrieves the maximum number of threads
+ *          the library may use to run the filter pipeline on chunks, as set
+ *          with H5Pset_filter_nthreads(), from the dataset transfer property
+ *          list \p plist_id.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pget_filter_nthreads(hid_t plist_id, unsigned *nthreads);
+
+/**
+ *
+ * \ingroup DXPL
+ *
+ * \brief Sets the largest gap the library may read through when merging
+ *        the pieces of a vector or selection read
+ *
+ * \dxpl_id{plist_id}
+ * \param[in] gap   Largest number of unneeded bytes between two pieces of a
+ *                  read that may be read and discarded in order to merge the
+ *                  pieces into a single read from the file
+ *
+ * \return \herr_t
+ *
+ * \details H5Pset_vector_read_gap() sets the largest gap, in bytes, between
+ *          two pieces of a vector or selection read that the library may
+ *          read through in order to issue the pieces as a single read from
+ *          the file.  Such reads are used by H5Dread() to read the chunks
+ *          of a chunked dataset with selection I/O (see
+ *          H5Pset_selection_io()).  When \p gap is greater than 0,
+ *          H5Dread() also reads the stored bytes of up to 16 filtered
+ *          chunks that are not in the chunk cache at a time with a single
+ *          vector read, before running the filter pipeline on them.
+ *
+ *          The pieces are sorted by file address, and pieces whose gap to
+ *          the previous piece is no larger than \p gap are merged into one
+ *          read into a temporary buffer, from which the bytes of each piece
+ *          are copied to its destination.  The bytes in the gaps are
+ *          discarded.  Pieces that are adjacent both in the file and in
+ *          memory are read directly into the destination buffer.
+ *
+ *          The default value is 0, which only merges pieces that are
+ *          adjacent in the file.  Larger values trade reading unneeded
+ *          bytes for fewer, larger requests, which usually pays off on
+ *          storage with a high per-request cost, such as network or object
+ *          stores.
+ *
+ * \note    Reads are not merged for files opened with a parallel file
+ *          driver.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_vector_read_gap(hid_t plist_id, size_t gap);
+
+/**
+ *
+ * \ingroup DXPL
+ *
+ * \brief Retrieves the largest gap the library may read through when
+ *        merging the pieces of a vector or selection read
+ *
+ * \dxpl_id{plist_id}
+ * \param[out] gap   Largest number of unneeded bytes between two pieces of
+ *                   a read that may be read and discarded
+ *
+ * \return \herr_t
+ *
+ * \details H5Pget_vector_read_gap() retrieves the largest gap set with
+ *          H5Pset_vector_read_gap() from the dataset transfer property list
+ *          \p plist_id.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pget_vector_read_gap(hid_t plist_id, size_t *gap);
+
+/**
+ *
+ * \ingroup DXPL
+ *
+ * \brief Makes reads allocate variable-length data from an arena that is
+ *        released all at once
+ *
+ * \dxpl_id{plist_id}
+ * \param[in] block_size Size, in bytes, of the blocks the arena allocates
+ *                       the variable-length data from, or 0 to remove the
+ *                       arena from the property list
+ *
+ * \return \herr_t
+ *
+ * \details H5Pset_vlen_arena() makes H5Dread() allocate the memory for the
+ *          variable-length data (strings and sequences) it reads with the
+ *          dataset transfer property list \p plist_id from an arena,
+ *          instead of calling an allocation function for each element.
+ *          The arena hands out memory from blocks of \p block_size bytes;
+ *          a sequence or string larger than half a block gets a block of
+ *          its own.
+ *
+ *          The variable-length data of all the reads made with the property
+ *          list accumulate in the arena.  A call to H5Treclaim() with the
+ *          property list releases all of them at once, whatever the
+ *          datatype, dataspace and buffer passed to it, after which the
+ *          arena is reused by the following reads.  Closing the property
+ *          list also releases them.  The data must not be freed in any
+ *          other way.  Copies of the property list made with H5Pcopy()
+ *          share its arena, which is released when the last of them is
+ *          closed.
+ *
+ *          The arena takes precedence over the memory manager set with
+ *          H5Pset_vlen_mem_manager().  Calling H5Pset_vlen_arena() again
+ *          replaces the arena, releasing the data in the previous one.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pset_vlen_arena(hid_t plist_id, size_t block_size);
+
+/**
+ *
+ * \ingroup DXPL
+ *
+ * \brief Retrieves the block size of the arena for variable-length data
+ *
+ * \dxpl_id{plist_id}
+ * \param[out] block_size Size, in bytes, of the arena's blocks, or 0 if
+ *                        the property list has no arena
+ *
+ * \return \herr_t
+ *
+ * \details H5Pget_vlen_arena() retrieves the block size of the arena set
+ *          with H5Pset_vlen_arena() for the dataset transfer property list
+ *          \p plist_id.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Pget_vlen_arena(hid_t plist_id, size_t *block_size);
+
 /**
  * \ingroup LCPL
  *
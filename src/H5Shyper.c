@@ -99,6 +99,13 @@ typedef struct {
     hbool_t  share_selection; /* Whether span trees in dst_space can be shared with proj_space */
 } H5S_hyper_project_intersect_ud_t;
 
+/* Information about a block, for building a span tree from a list of blocks */
+typedef struct H5S_hyper_build_blk_t {
+    hsize_t        low;    /* Low coordinate of the block in the current dimension */
+    hsize_t        high;   /* High coordinate of the block in the current dimension */
+    const hsize_t *coords; /* Start coordinates of the block (end coordinates follow at 'end_off') */
+} H5S_hyper_build_blk_t;
+
 /* Assert that H5S_MAX_RANK is <= 32 so our trick with using a 32 bit bitmap
  * (ps_clean_bitmap) works.  If H5S_MAX_RANK increases either increase the size
  * of ps_clean_bitmap or change the algorithm to use an array. */
@@ -137,6 +144,16 @@ static herr_t  H5S__hyper_add_disjoint_spans(H5S_t *space, H5S_hyper_span_info_t
 static H5S_hyper_span_info_t *H5S__hyper_make_spans(unsigned rank, const hsize_t *start,
                                                     const hsize_t *stride, const hsize_t *count,
                                                     const hsize_t *block);
+static int                    H5S__hyper_cmp_build_blk(const void *_blk1, const void *_blk2);
+static int                    H5S__hyper_cmp_hsize(const void *_val1, const void *_val2);
+static H5S_hyper_span_info_t *H5S__hyper_make_spans_blocklist_helper(unsigned rank, unsigned dim,
+                                                                     size_t nblocks, const hsize_t **blocks,
+                                                                     unsigned end_off);
+static H5S_hyper_span_info_t *H5S__hyper_make_spans_blocklist(unsigned rank, size_t nblocks,
+                                                              const hsize_t *coords, hbool_t points);
+static herr_t H5S__select_hyper_spans(H5S_t *space, H5S_seloper_t op, H5S_hyper_span_info_t *new_spans);
+static herr_t H5S__select_hyper_blocklist(H5S_t *space, H5S_seloper_t op, size_t nblocks,
+                                          const hsize_t *coords, hbool_t points);
 static herr_t                 H5S__hyper_update_diminfo(H5S_t *space, H5S_seloper_t op,
                                                         const H5S_hyper_dim_t *new_hyper_diminfo);
 static herr_t                 H5S__hyper_generate_spans(H5S_t *space);
@@ -4246,6 +4263,7 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
     hsize_t        dims[H5S_MAX_RANK];          /* Dimension sizes */
     hsize_t        start[H5S_MAX_RANK];         /* hyperslab start information */
     hsize_t        block[H5S_MAX_RANK];         /* hyperslab block information */
+    hsize_t       *blocks = NULL;               /* List of irregular hyperslab blocks */
     uint32_t       version;                     /* Version number */
     uint8_t        flags    = 0;                /* Flags */
     uint8_t        enc_size = 0;                /* Encoded size of selection info */
@@ -4413,14 +4431,10 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSET, FAIL, "can't change selection")
     } /* end if */
     else {
-        const hsize_t *stride;            /* Hyperslab stride information */
-        const hsize_t *count;             /* Hyperslab count information */
-        hsize_t        end[H5S_MAX_RANK]; /* Hyperslab end information */
-        hsize_t       *tstart;            /* Temporary hyperslab pointers */
-        hsize_t       *tend;              /* Temporary hyperslab pointers */
-        hsize_t       *tblock;            /* Temporary hyperslab pointers */
-        size_t         num_elem;          /* Number of elements in selection */
-        unsigned       v;                 /* Local counting variable */
+        hsize_t *tstart;   /* Temporary hyperslab pointers */
+        hsize_t *tend;     /* Temporary hyperslab pointers */
+        size_t   num_elem; /* Number of elements in selection */
+        unsigned v;        /* Local counting variable */
 
         /* Decode the number of blocks */
         switch (enc_size) {
@@ -4450,11 +4464,21 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
                 break;
         } /* end switch */
 
-        /* Set the count & stride for all blocks */
-        stride = count = H5S_hyper_ones_g;
+        /* Allocate the list of blocks */
+        if (num_elem > SIZE_MAX / (2 * rank * sizeof(hsize_t)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_BADVALUE, FAIL, "too many selection blocks")
+        if (H5_IS_KNOWN_BUFFER_OVERFLOW(skip, pp, num_elem * 2 * rank * enc_size, p_end))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_OVERFLOW, FAIL,
+                        "buffer overflow while decoding selection coordinates")
+        if (num_elem > 0 && NULL == (blocks = (hsize_t *)H5MM_malloc(num_elem * 2 * rank * sizeof(hsize_t))))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, FAIL, "can't allocate block list")
 
         /* Retrieve the coordinates from the buffer */
         for (u = 0; u < num_elem; u++) {
+            /* Point to the block's starting and ending points in the list */
+            tstart = blocks + (u * 2 * rank);
+            tend   = tstart + rank;
+
             /* Decode the starting and ending points */
             switch (enc_size) {
                 case H5S_SELECT_INFO_ENC_SIZE_2:
@@ -4462,10 +4486,10 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
                         HGOTO_ERROR(H5E_DATASPACE, H5E_OVERFLOW, FAIL,
                                     "buffer overflow while decoding selection coordinates")
 
-                    for (tstart = start, v = 0; v < rank; v++, tstart++)
-                        UINT16DECODE(pp, *tstart);
-                    for (tend = end, v = 0; v < rank; v++, tend++)
-                        UINT16DECODE(pp, *tend);
+                    for (v = 0; v < rank; v++)
+                        UINT16DECODE(pp, tstart[v]);
+                    for (v = 0; v < rank; v++)
+                        UINT16DECODE(pp, tend[v]);
                     break;
 
                 case H5S_SELECT_INFO_ENC_SIZE_4:
@@ -4473,10 +4497,10 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
                         HGOTO_ERROR(H5E_DATASPACE, H5E_OVERFLOW, FAIL,
                                     "buffer overflow while decoding selection coordinates")
 
-                    for (tstart = start, v = 0; v < rank; v++, tstart++)
-                        UINT32DECODE(pp, *tstart);
-                    for (tend = end, v = 0; v < rank; v++, tend++)
-                        UINT32DECODE(pp, *tend);
+                    for (v = 0; v < rank; v++)
+                        UINT32DECODE(pp, tstart[v]);
+                    for (v = 0; v < rank; v++)
+                        UINT32DECODE(pp, tend[v]);
                     break;
 
                 case H5S_SELECT_INFO_ENC_SIZE_8:
@@ -4484,10 +4508,10 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
                         HGOTO_ERROR(H5E_DATASPACE, H5E_OVERFLOW, FAIL,
                                     "buffer overflow while decoding selection coordinates")
 
-                    for (tstart = start, v = 0; v < rank; v++, tstart++)
-                        UINT64DECODE(pp, *tstart);
-                    for (tend = end, v = 0; v < rank; v++, tend++)
-                        UINT64DECODE(pp, *tend);
+                    for (v = 0; v < rank; v++)
+                        UINT64DECODE(pp, tstart[v]);
+                    for (v = 0; v < rank; v++)
+                        UINT64DECODE(pp, tend[v]);
                     break;
 
                 default:
@@ -4495,17 +4519,12 @@ H5S__hyper_deserialize(H5S_t **space, const uint8_t **p, const size_t p_size, hb
                                 "unknown offset info size for hyperslab")
                     break;
             } /* end switch */
+        }     /* end for */
 
-            /* Change the ending points into blocks */
-            for (tblock = block, tstart = start, tend = end, v = 0; v < rank; v++, tstart++, tend++, tblock++)
-                *tblock = (*tend - *tstart) + 1;
-
-            /* Select or add the hyperslab to the current selection */
-            if ((ret_value = H5S_select_hyperslab(tmp_space, (u == 0 ? H5S_SELECT_SET : H5S_SELECT_OR), start,
-                                                  stride, count, block)) < 0)
-                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSET, FAIL, "can't change selection")
-        } /* end for */
-    }     /* end else */
+        /* Select the union of the blocks */
+        if ((ret_value = H5S__select_hyper_blocklist(tmp_space, H5S_SELECT_SET, num_elem, blocks, FALSE)) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSET, FAIL, "can't change selection")
+    } /* end else */
 
     /* Update decoding pointer */
     *p = pp;
@@ -4519,6 +4538,7 @@ done:
     if (!*space && tmp_space)
         if (H5S_close(tmp_space) < 0)
             HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "can't close dataspace")
+    H5MM_xfree(blocks);
 
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S__hyper_deserialize() */
@@ -8748,6 +8768,316 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5S__hyper_make_spans() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5S__hyper_cmp_build_blk
+ *
+ * Purpose:     Compare two blocks by their coordinates in the dimension
+ *              the span tree is being built for, for qsort.
+ *
+ * Return:      -1, 0 or 1 when the first block is before, at the same
+ *              place or after the second one
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5S__hyper_cmp_build_blk(const void *_blk1, const void *_blk2)
+{
+    const H5S_hyper_build_blk_t *blk1      = (const H5S_hyper_build_blk_t *)_blk1;
+    const H5S_hyper_build_blk_t *blk2      = (const H5S_hyper_build_blk_t *)_blk2;
+    int                          ret_value = 0; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (blk1->low < blk2->low)
+        ret_value = -1;
+    else if (blk1->low > blk2->low)
+        ret_value = 1;
+    else if (blk1->high < blk2->high)
+        ret_value = -1;
+    else if (blk1->high > blk2->high)
+        ret_value = 1;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_cmp_build_blk() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5S__hyper_cmp_hsize
+ *
+ * Purpose:     Compare two hsize_t values, for qsort.
+ *
+ * Return:      -1, 0 or 1 when the first value is less than, equal to or
+ *              greater than the second one
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5S__hyper_cmp_hsize(const void *_val1, const void *_val2)
+{
+    hsize_t val1 = *(const hsize_t *)_val1;
+    hsize_t val2 = *(const hsize_t *)_val2;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    FUNC_LEAVE_NOAPI((val1 > val2) - (val1 < val2))
+} /* end H5S__hyper_cmp_hsize() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_make_spans_blocklist_helper
+ PURPOSE
+    Helper routine to create a span tree from a list of blocks
+ USAGE
+    H5S_hyper_span_info_t *H5S__hyper_make_spans_blocklist_helper(rank, dim, nblocks, blocks, end_off)
+        unsigned rank;          IN: # of dimensions of the space
+        unsigned dim;           IN: Dimension to create the spans of
+        size_t nblocks;         IN: Number of blocks
+        const hsize_t **blocks; IN: Start coordinates of each block
+        unsigned end_off;       IN: Offset of the end coordinates of a
+                                    block from its start coordinates
+ RETURNS
+    Pointer to new span tree on success, NULL on failure
+ DESCRIPTION
+    Creates the spans of dimension DIM, and of the dimensions below it, that
+    cover the union of the blocks.  The blocks may overlap and be in any
+    order.  The blocks are sorted by their coordinates in this dimension,
+    which is then cut into the intervals where the same set of blocks is
+    selected.  The spans of the dimension below are built for each interval
+    from the blocks selected in it, and adjacent intervals with the same
+    spans below are merged.  Non-adjacent intervals with the same spans
+    below share them.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    The fastest changing dimension only needs the union of the sorted
+    intervals.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static H5S_hyper_span_info_t *
+H5S__hyper_make_spans_blocklist_helper(unsigned rank, unsigned dim, size_t nblocks, const hsize_t **blocks,
+                                       unsigned end_off)
+{
+    H5S_hyper_build_blk_t *blks      = NULL; /* Blocks, sorted in this dimension */
+    hsize_t               *bounds    = NULL; /* Boundaries of the intervals in this dimension */
+    const hsize_t        **active    = NULL; /* Blocks selected in the current interval */
+    H5S_hyper_span_info_t *down      = NULL; /* Spans in the next dimension down */
+    H5S_hyper_span_info_t *span_info = NULL; /* New span info for this dimension */
+    H5S_hyper_span_t      *span;             /* New span */
+    unsigned               ndims = rank - dim; /* # of dimensions of the new span tree */
+    size_t                 u;                  /* Local index variable */
+    H5S_hyper_span_info_t *ret_value = NULL;   /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(dim < rank);
+    HDassert(nblocks > 0);
+    HDassert(blocks);
+
+    /* Sort the blocks by their coordinates in this dimension */
+    if (NULL == (blks = (H5S_hyper_build_blk_t *)H5MM_malloc(nblocks * sizeof(H5S_hyper_build_blk_t))))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate block list")
+    for (u = 0; u < nblocks; u++) {
+        blks[u].low    = blocks[u][dim];
+        blks[u].high   = blocks[u][end_off + dim];
+        blks[u].coords = blocks[u];
+    } /* end for */
+    HDqsort(blks, nblocks, sizeof(H5S_hyper_build_blk_t), H5S__hyper_cmp_build_blk);
+
+    /* Allocate a span info node */
+    if (NULL == (span_info = H5S__hyper_new_span_info(ndims)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate hyperslab span info")
+    span_info->count = 1;
+
+    if (ndims == 1) {
+        /* Merge the overlapping & adjacent intervals */
+        for (u = 0; u < nblocks; u++) {
+            if (span_info->tail && blks[u].low <= span_info->tail->high + 1) {
+                if (blks[u].high > span_info->tail->high)
+                    span_info->tail->high = blks[u].high;
+            } /* end if */
+            else {
+                if (NULL == (span = H5S__hyper_new_span(blks[u].low, blks[u].high, NULL, NULL)))
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate hyperslab span")
+                if (span_info->tail)
+                    span_info->tail->next = span;
+                else
+                    span_info->head = span;
+                span_info->tail = span;
+            } /* end else */
+        }     /* end for */
+    }         /* end if */
+    else {
+        size_t nbounds = 0; /* Number of interval boundaries */
+        size_t nactive = 0; /* Number of blocks selected in the current interval */
+        size_t next    = 0; /* Next block to start being selected */
+        size_t v, w;        /* Local index variables */
+
+        /* Collect the boundaries of the intervals */
+        if (NULL == (bounds = (hsize_t *)H5MM_malloc(2 * nblocks * sizeof(hsize_t))))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate interval boundaries")
+        for (u = 0; u < nblocks; u++) {
+            bounds[2 * u]     = blks[u].low;
+            bounds[2 * u + 1] = blks[u].high + 1;
+        } /* end for */
+        HDqsort(bounds, 2 * nblocks, sizeof(hsize_t), H5S__hyper_cmp_hsize);
+        for (u = 0; u < 2 * nblocks; u++)
+            if (0 == nbounds || bounds[u] != bounds[nbounds - 1])
+                bounds[nbounds++] = bounds[u];
+
+        if (NULL == (active = (const hsize_t **)H5MM_malloc(nblocks * sizeof(const hsize_t *))))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate block list")
+
+        /* Sweep over the intervals */
+        for (u = 0; u + 1 < nbounds; u++) {
+            hsize_t low  = bounds[u];
+            hsize_t high = bounds[u + 1] - 1;
+
+            /* Drop the blocks ending before this interval, and add the ones
+             * starting at it */
+            for (v = w = 0; v < nactive; v++)
+                if (active[v][end_off + dim] >= low)
+                    active[w++] = active[v];
+            nactive = w;
+            while (next < nblocks && blks[next].low == low)
+                active[nactive++] = blks[next++].coords;
+
+            /* Skip gaps between blocks */
+            if (0 == nactive)
+                continue;
+
+            /* Build the spans in the next dimension down */
+            if (NULL ==
+                (down = H5S__hyper_make_spans_blocklist_helper(rank, dim + 1, nactive, active, end_off)))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, NULL, "can't create hyperslab information")
+
+            /* Extend the last span or share its spans below, if they're the same */
+            if (span_info->tail && H5S__hyper_cmp_spans(span_info->tail->down, down)) {
+                if (H5S__hyper_free_span_info(down) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTFREE, NULL, "unable to free span info")
+                down = NULL;
+
+                if (span_info->tail->high + 1 == low) {
+                    span_info->tail->high = high;
+                    continue;
+                } /* end if */
+
+                if (NULL == (span = H5S__hyper_new_span(low, high, span_info->tail->down, NULL)))
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate hyperslab span")
+            } /* end if */
+            else {
+                if (NULL == (span = H5S__hyper_new_span(low, high, NULL, NULL)))
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate hyperslab span")
+                span->down = down;
+                down       = NULL;
+            } /* end else */
+
+            /* Append the span */
+            if (span_info->tail)
+                span_info->tail->next = span;
+            else
+                span_info->head = span;
+            span_info->tail = span;
+        } /* end for */
+    }     /* end else */
+    HDassert(span_info->head);
+
+    /* Set the bounds of the new span tree */
+    span_info->low_bounds[0]  = span_info->head->low;
+    span_info->high_bounds[0] = span_info->tail->high;
+    if (ndims > 1) {
+        unsigned d; /* Local index variable */
+
+        H5MM_memcpy(&span_info->low_bounds[1], span_info->head->down->low_bounds,
+                    (ndims - 1) * sizeof(hsize_t));
+        H5MM_memcpy(&span_info->high_bounds[1], span_info->head->down->high_bounds,
+                    (ndims - 1) * sizeof(hsize_t));
+        for (span = span_info->head->next; span; span = span->next)
+            for (d = 1; d < ndims; d++) {
+                span_info->low_bounds[d]  = MIN(span_info->low_bounds[d], span->down->low_bounds[d - 1]);
+                span_info->high_bounds[d] = MAX(span_info->high_bounds[d], span->down->high_bounds[d - 1]);
+            } /* end for */
+    }         /* end if */
+
+    /* Success */
+    ret_value = span_info;
+    span_info = NULL;
+
+done:
+    if (down)
+        if (H5S__hyper_free_span_info(down) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, NULL, "unable to free span info")
+    if (span_info)
+        if (H5S__hyper_free_span_info(span_info) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, NULL, "unable to free span info")
+    H5MM_xfree(active);
+    H5MM_xfree(bounds);
+    H5MM_xfree(blks);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_make_spans_blocklist_helper() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5S__hyper_make_spans_blocklist
+ PURPOSE
+    Create a span tree from a list of blocks or points
+ USAGE
+    H5S_hyper_span_info_t *H5S__hyper_make_spans_blocklist(rank, nblocks, coords, points)
+        unsigned rank;          IN: # of dimensions of the space
+        size_t nblocks;         IN: Number of blocks or points
+        const hsize_t *coords;  IN: Coordinates of the blocks or points
+        hbool_t points;         IN: Whether COORDS holds points instead of
+                                    blocks
+ RETURNS
+    Pointer to new span tree on success, NULL on failure
+ DESCRIPTION
+    Generates a new span tree selecting the union of a list of blocks, in
+    one pass over the blocks.  The blocks are given in the format of
+    H5Sget_select_hyper_blocklist(), the start coordinates of each block
+    followed by the coordinates of its opposite corner.  Points are given
+    in the format of H5Sselect_elements(), and are blocks of one element.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+static H5S_hyper_span_info_t *
+H5S__hyper_make_spans_blocklist(unsigned rank, size_t nblocks, const hsize_t *coords, hbool_t points)
+{
+    const hsize_t        **blocks   = NULL;                       /* Start coordinates of each block */
+    unsigned               end_off  = points ? 0 : rank;          /* Offset of end coordinates */
+    size_t                 blk_size = points ? rank : 2 * rank;   /* # of coordinates of each block */
+    size_t                 u;                                     /* Local index variable */
+    unsigned               v;                                     /* Local index variable */
+    H5S_hyper_span_info_t *ret_value = NULL;                      /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(rank > 0);
+    HDassert(nblocks > 0);
+    HDassert(coords);
+
+    /* Check the blocks and point to each one */
+    if (NULL == (blocks = (const hsize_t **)H5MM_malloc(nblocks * sizeof(const hsize_t *))))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, NULL, "can't allocate block list")
+    for (u = 0; u < nblocks; u++) {
+        blocks[u] = coords + (u * blk_size);
+        for (v = 0; v < rank; v++)
+            if (blocks[u][v] > blocks[u][end_off + v] || blocks[u][end_off + v] >= H5S_UNLIMITED)
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, NULL, "invalid block coordinates")
+    } /* end for */
+
+    /* Build the span tree */
+    if (NULL == (ret_value = H5S__hyper_make_spans_blocklist_helper(rank, 0, nblocks, blocks, end_off)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, NULL, "can't create hyperslab information")
+
+done:
+    H5MM_xfree(blocks);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__hyper_make_spans_blocklist() */
+
 /*--------------------------------------------------------------------------
  NAME
     H5S__hyper_update_diminfo
@@ -10374,6 +10704,340 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Sselect_hyperslab() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5S__select_hyper_spans
+ *
+ * Purpose:     Combine a span tree with the current selection of a
+ *              dataspace, as H5S_select_hyperslab() does for the span tree
+ *              of a regular hyperslab.  The span tree is owned by this
+ *              routine, even on failure.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S__select_hyper_spans(H5S_t *space, H5S_seloper_t op, H5S_hyper_span_info_t *new_spans)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(space);
+    HDassert(new_spans);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+
+    /* Check for operating on unlimited selection */
+    if ((H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS) &&
+        (space->select.sel_info.hslab->unlim_dim >= 0) && (op != H5S_SELECT_SET)) {
+        /* Check for invalid operation */
+        if (!((op == H5S_SELECT_AND) || (op == H5S_SELECT_NOTA)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_UNSUPPORTED, FAIL, "unsupported operation on unlimited selection")
+        HDassert(space->select.sel_info.hslab->diminfo_valid);
+
+        /* Clip unlimited selection to include new selection */
+        if (H5S_hyper_clip_unlim(space,
+                                 new_spans->high_bounds[space->select.sel_info.hslab->unlim_dim] + 1) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, FAIL, "failed to clip unlimited selection")
+    } /* end if */
+
+    /* Fixup operation for non-hyperslab selections */
+    switch (H5S_GET_SELECT_TYPE(space)) {
+        case H5S_SEL_NONE: /* No elements selected in dataspace */
+            switch (op) {
+                case H5S_SELECT_SET:
+                    break;
+
+                case H5S_SELECT_OR:
+                case H5S_SELECT_XOR:
+                case H5S_SELECT_NOTA:
+                    op = H5S_SELECT_SET; /* Maps to "set" operation when applied to "none" selection */
+                    break;
+
+                case H5S_SELECT_AND:
+                case H5S_SELECT_NOTB:
+                    HGOTO_DONE(SUCCEED); /* Selection stays "none" */
+
+                case H5S_SELECT_NOOP:
+                case H5S_SELECT_APPEND:
+                case H5S_SELECT_PREPEND:
+                case H5S_SELECT_INVALID:
+                default:
+                    HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+            } /* end switch */
+            break;
+
+        case H5S_SEL_ALL: /* All elements selected in dataspace */
+            switch (op) {
+                case H5S_SELECT_SET:
+                    break;
+
+                case H5S_SELECT_OR:
+                    HGOTO_DONE(SUCCEED); /* Selection stays "all" */
+
+                case H5S_SELECT_AND:
+                    op = H5S_SELECT_SET; /* Maps to "set" operation when applied to "all" selection */
+                    break;
+
+                case H5S_SELECT_XOR:
+                case H5S_SELECT_NOTB:
+                    /* Convert current "all" selection to "real" hyperslab selection */
+                    if (H5S_select_hyperslab(space, H5S_SELECT_SET, H5S_hyper_zeros_g, H5S_hyper_ones_g,
+                                             H5S_hyper_ones_g, space->extent.size) < 0)
+                        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't convert selection")
+                    break;
+
+                case H5S_SELECT_NOTA:
+                    /* Convert to "none" selection */
+                    if (H5S_select_none(space) < 0)
+                        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSELECT, FAIL, "can't convert selection")
+                    HGOTO_DONE(SUCCEED);
+
+                case H5S_SELECT_NOOP:
+                case H5S_SELECT_APPEND:
+                case H5S_SELECT_PREPEND:
+                case H5S_SELECT_INVALID:
+                default:
+                    HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+            } /* end switch */
+            break;
+
+        case H5S_SEL_HYPERSLABS:
+            /* Hyperslab operation on hyperslab selection, OK */
+            break;
+
+        case H5S_SEL_POINTS:          /* Can't combine hyperslab operations and point selections currently */
+            if (op == H5S_SELECT_SET) /* Allow only "set" operation to proceed */
+                break;
+            /* FALLTHROUGH (to error) */
+            H5_ATTR_FALLTHROUGH
+
+        case H5S_SEL_ERROR:
+        case H5S_SEL_N:
+        default:
+            HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+    } /* end switch */
+
+    if (op == H5S_SELECT_SET) {
+        /* Remove current selection */
+        if (H5S_SELECT_RELEASE(space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTDELETE, FAIL, "can't release selection")
+
+        /* Allocate space for the hyperslab selection information */
+        if (NULL == (space->select.sel_info.hslab = H5FL_MALLOC(H5S_hyper_sel_t)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTALLOC, FAIL, "can't allocate hyperslab info")
+
+        /* Set the selection to the new span tree */
+        space->select.sel_info.hslab->span_lst      = new_spans;
+        space->select.sel_info.hslab->unlim_dim     = -1;
+        space->select.num_elem                      = H5S__hyper_spans_nelem(new_spans);
+        space->select.type                          = H5S_sel_hyper;
+        new_spans                                   = NULL;
+
+        /* Recover the regular hyperslab information, if the blocks form one */
+        H5S__hyper_rebuild(space);
+    } /* end if */
+    else {
+        hbool_t new_spans_owned = FALSE;
+        hbool_t updated_spans   = FALSE;
+
+        /* Sanity check */
+        HDassert(H5S_GET_SELECT_TYPE(space) == H5S_SEL_HYPERSLABS);
+
+        /* Check if there's no hyperslab span information currently */
+        if (NULL == space->select.sel_info.hslab->span_lst)
+            if (H5S__hyper_generate_spans(space) < 0)
+                HGOTO_ERROR(H5E_DATASPACE, H5E_UNINITIALIZED, FAIL, "dataspace does not have span tree")
+
+        /* Generate new spans for space */
+        if (H5S__fill_in_new_space(space, op, new_spans, TRUE, &new_spans_owned, &updated_spans, &space) < 0)
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSELECT, FAIL, "can't generate the specified hyperslab")
+        if (new_spans_owned)
+            new_spans = NULL;
+
+        /* The regular hyperslab information has to be rebuilt, if needed */
+        if (updated_spans)
+            space->select.sel_info.hslab->diminfo_valid = H5S_DIMINFO_VALID_NO;
+    } /* end else */
+
+done:
+    if (new_spans)
+        if (H5S__hyper_free_span_info(new_spans) < 0)
+            HDONE_ERROR(H5E_DATASPACE, H5E_CANTFREE, FAIL, "unable to free span info")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__select_hyper_spans() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5S__select_hyper_blocklist
+ *
+ * Purpose:     Internal version of H5Sselect_hyper_blocklist() and
+ *              H5Sselect_hyper_pointlist().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5S__select_hyper_blocklist(H5S_t *space, H5S_seloper_t op, size_t nblocks, const hsize_t *coords,
+                            hbool_t points)
+{
+    H5S_hyper_span_info_t *new_spans = NULL;    /* Span tree for the blocks */
+    herr_t                 ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    HDassert(space);
+    HDassert(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID);
+
+    /* An empty list of blocks acts as a zero-sized hyperslab */
+    if (0 == nblocks) {
+        switch (op) {
+            case H5S_SELECT_SET:
+            case H5S_SELECT_AND:
+            case H5S_SELECT_NOTA:
+                if (H5S_select_none(space) < 0)
+                    HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSELECT, FAIL, "can't convert selection")
+                break;
+
+            case H5S_SELECT_OR:
+            case H5S_SELECT_XOR:
+            case H5S_SELECT_NOTB:
+                break; /* Selection stays same */
+
+            case H5S_SELECT_NOOP:
+            case H5S_SELECT_APPEND:
+            case H5S_SELECT_PREPEND:
+            case H5S_SELECT_INVALID:
+            default:
+                HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+        } /* end switch */
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Build the span tree for the blocks */
+    if (NULL == (new_spans = H5S__hyper_make_spans_blocklist(space->extent.rank, nblocks, coords, points)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't create hyperslab information")
+
+    /* Combine it with the current selection */
+    if (H5S__select_hyper_spans(space, op, new_spans) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTSELECT, FAIL, "unable to set hyperslab selection")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S__select_hyper_blocklist() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5Sselect_hyper_blocklist
+ PURPOSE
+    Specify a list of blocks to combine with the current hyperslab selection
+ USAGE
+    herr_t H5Sselect_hyper_blocklist(dsid, op, numblocks, buf)
+        hid_t dsid;             IN: Dataspace ID of selection to modify
+        H5S_seloper_t op;       IN: Operation to perform on current selection
+        hsize_t numblocks;      IN: Number of blocks in list
+        const hsize_t *buf;     IN: List of blocks
+ RETURNS
+    Non-negative on success/Negative on failure
+ DESCRIPTION
+    Combines the union of a list of blocks with the current selection for a
+    dataspace, as H5Sselect_hyperslab() does for a single hyperslab.  The
+    list of blocks is in the format returned by
+    H5Sget_select_hyper_blocklist(): the "start" coordinate of each block
+    immediately followed by its "opposite" corner coordinate.  The blocks
+    may overlap and be in any order.  The span tree for the blocks is built
+    in one pass, after sorting them.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5Sselect_hyper_blocklist(hid_t space_id, H5S_seloper_t op, hsize_t numblocks, const hsize_t buf[])
+{
+    H5S_t *space;               /* Dataspace to modify selection of */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "iSsh*h", space_id, op, numblocks, buf);
+
+    /* Check args */
+    if (NULL == (space = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+    if (H5S_SCALAR == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_SCALAR space")
+    if (H5S_NULL == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_NULL space")
+    if (numblocks > 0 && buf == NULL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "block list not specified")
+    if (numblocks > ((hsize_t)SIZE_MAX / (2 * sizeof(hsize_t) * space->extent.rank)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "too many blocks")
+    if (!(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID))
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+
+    if (H5S__select_hyper_blocklist(space, op, (size_t)numblocks, buf, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to set hyperslab selection")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Sselect_hyper_blocklist() */
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5Sselect_hyper_pointlist
+ PURPOSE
+    Specify a list of points to combine with the current hyperslab selection
+ USAGE
+    herr_t H5Sselect_hyper_pointlist(dsid, op, num_elem, coord)
+        hid_t dsid;             IN: Dataspace ID of selection to modify
+        H5S_seloper_t op;       IN: Operation to perform on current selection
+        size_t num_elem;        IN: Number of points in list
+        const hsize_t *coord;   IN: List of points
+ RETURNS
+    Non-negative on success/Negative on failure
+ DESCRIPTION
+    Combines a list of points with the current selection for a dataspace,
+    as H5Sselect_hyperslab() does for a single hyperslab.  The list of
+    points is in the format used by H5Sselect_elements().  Unlike a point
+    selection, the points are sorted and merged into the blocks of a
+    hyperslab selection, so duplicate points are selected once and I/O
+    visits the points in C order.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5Sselect_hyper_pointlist(hid_t space_id, H5S_seloper_t op, size_t num_elem, const hsize_t coord[])
+{
+    H5S_t *space;               /* Dataspace to modify selection of */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE4("e", "iSsz*h", space_id, op, num_elem, coord);
+
+    /* Check args */
+    if (NULL == (space = (H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+    if (H5S_SCALAR == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_SCALAR space")
+    if (H5S_NULL == H5S_GET_EXTENT_TYPE(space))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "hyperslab doesn't support H5S_NULL space")
+    if (num_elem > 0 && coord == NULL)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "point list not specified")
+    if (!(op > H5S_SELECT_NOOP && op < H5S_SELECT_INVALID))
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "invalid selection operation")
+
+    if (H5S__select_hyper_blocklist(space, op, num_elem, coord, TRUE) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINIT, FAIL, "unable to set hyperslab selection")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Sselect_hyper_pointlist() */
+
 /*--------------------------------------------------------------------------
  NAME
     H5S_combine_hyperslab
@@ -10751,8 +11415,10 @@ H5S__combine_select(H5S_t *space1, H5S_seloper_t op, H5S_t *space2)
             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCLIP, NULL, "can't clip hyperslab information")
     } /* end else */
 
-    /* Set unlim_dim */
-    new_space->select.sel_info.hslab->unlim_dim = -1;
+    /* Set unlim_dim, if the result is still a hyperslab selection */
+    /* (Combining can leave nothing selected) */
+    if (H5S_GET_SELECT_TYPE(new_space) == H5S_SEL_HYPERSLABS)
+        new_space->select.sel_info.hslab->unlim_dim = -1;
 
     /* Set return value */
     ret_value = new_space;
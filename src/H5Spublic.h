@@ -1206,6 +1206,70 @@ H5_DLL herr_t H5Sselect_elements(hid_t space_id, H5S_seloper_t op, size_t num_el
  */
 H5_DLL herr_t H5Sselect_hyperslab(hid_t space_id, H5S_seloper_t op, const hsize_t start[],
                                   const hsize_t stride[], const hsize_t count[], const hsize_t block[]);
+/**
+ * \ingroup H5S
+ *
+ * \brief Selects a list of blocks to add to the current selected region
+ *
+ * \space_id
+ * \param[in] op         Operation to perform on current selection
+ * \param[in] numblocks  Number of blocks in the list
+ * \param[in] buf        List of blocks
+ *
+ * \return \herr_t
+ *
+ * \details H5Sselect_hyper_blocklist() combines the union of a list of
+ *          blocks with the current selected region for the dataspace
+ *          specified by \p space_id, as H5Sselect_hyperslab() does for a
+ *          single hyperslab. The selection operators are the same as for
+ *          H5Sselect_hyperslab().
+ *
+ *          The list of blocks in \p buf has the format returned by
+ *          H5Sget_select_hyper_blocklist(): the "start" coordinate of each
+ *          block, immediately followed by the coordinate of its "opposite"
+ *          corner. The blocks may overlap and be in any order.
+ *
+ *          The blocks are sorted and merged into a hyperslab selection in
+ *          one pass. This is much faster than selecting each block with a
+ *          call to H5Sselect_hyperslab() and #H5S_SELECT_OR, whose cost
+ *          grows with the number of blocks already selected.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Sselect_hyper_blocklist(hid_t space_id, H5S_seloper_t op, hsize_t numblocks,
+                                        const hsize_t buf[]);
+/**
+ * \ingroup H5S
+ *
+ * \brief Selects a list of points to add to the current selected region
+ *        as a hyperslab
+ *
+ * \space_id
+ * \param[in] op        Operation to perform on current selection
+ * \param[in] num_elem  Number of points in the list
+ * \param[in] coord     List of points
+ *
+ * \return \herr_t
+ *
+ * \details H5Sselect_hyper_pointlist() combines a list of points with the
+ *          current selected region for the dataspace specified by
+ *          \p space_id, as H5Sselect_hyperslab() does for a single
+ *          hyperslab. The selection operators are the same as for
+ *          H5Sselect_hyperslab().
+ *
+ *          The list of points in \p coord has the format used by
+ *          H5Sselect_elements(). Unlike H5Sselect_elements(), the points
+ *          are sorted and merged into the blocks of a hyperslab selection.
+ *          Duplicate points are selected once, and I/O visits the points in
+ *          C order instead of the order of the list. Reading many scattered
+ *          points this way moves adjacent points together.
+ *
+ * \since 1.15.0
+ *
+ */
+H5_DLL herr_t H5Sselect_hyper_pointlist(hid_t space_id, H5S_seloper_t op, size_t num_elem,
+                                        const hsize_t coord[]);
 /*--------------------------------------------------------------------------*/
 /**\ingroup H5S
  *
@@ -48,6 +48,16 @@
 
 #define H5T_ENCODE_VERSION 0
 
+/* Number of entries in the conversion path lookup cache (must be a power of two) */
+#define H5T_PATH_CACHE_SIZE 64
+
+/* Fold a value into a datatype fingerprint (FNV-1a style) */
+#define H5T_FP_MIX(H, V) ((H) = ((H) ^ (uint64_t)(V)) * (uint64_t)0x100000001b3ULL)
+
+/* Map a (source, destination) fingerprint pair to a path cache slot */
+#define H5T_PATH_CACHE_SLOT(S, D)                                                                            \
+    ((size_t)(((S) ^ ((D) * (uint64_t)0x9e3779b97f4a7c15ULL)) >> 32) & (H5T_PATH_CACHE_SIZE - 1))
+
 /*
  * Type initialization macros
  *
@@ -337,6 +347,13 @@
 /* Typedef for recursive const-correct datatype copying routines */
 typedef H5T_t *(*H5T_copy_func_t)(H5T_t *old_dt);
 
+/* Entry in the conversion path lookup cache */
+typedef struct H5T_path_cache_t {
+    uint64_t    src_fp; /* Fingerprint of the path's source type      */
+    uint64_t    dst_fp; /* Fingerprint of the path's destination type */
+    H5T_path_t *path;   /* Cached path, or NULL for an empty slot     */
+} H5T_path_cache_t;
+
 /********************/
 /* Local Prototypes */
 /********************/
@@ -349,6 +366,8 @@ static herr_t H5T__set_size(H5T_t *dt, size_t size);
 static herr_t H5T__close_cb(H5T_t *dt, void **request);
 static H5T_path_t *H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
                                        H5T_conv_func_t *conv);
+static uint64_t    H5T__fingerprint(const H5T_t *dt);
+static void        H5T__path_cache_reset(void);
 static hbool_t     H5T__detect_vlen_ref(const H5T_t *dt);
 static H5T_t      *H5T__initiate_copy(const H5T_t *old_dt);
 static H5T_t      *H5T__copy_transient(H5T_t *old_dt);
@@ -567,6 +586,14 @@ static struct {
     H5T_soft_t  *soft;   /*unsorted array of soft conversions    */
 } H5T_g;
 
+/*
+ * Direct-mapped cache in front of the path database, keyed by the
+ * fingerprints of the source and destination types.  Entries point into the
+ * path table and are dropped whenever a path is replaced or removed.  Like
+ * the path table itself, it is protected by the library's global lock.
+ */
+static H5T_path_cache_t H5T_path_cache_g[H5T_PATH_CACHE_SIZE];
+
 /* Declare the free list for H5T_path_t's */
 H5FL_DEFINE_STATIC(H5T_path_t);
 
@@ -1029,6 +1056,7 @@ H5T_init(void)
     status |= H5T__register_int(H5T_PERS_SOFT, "ibo(opt)", fixedpt, fixedpt, H5T__conv_order_opt);
     status |= H5T__register_int(H5T_PERS_SOFT, "fbo", floatpt, floatpt, H5T__conv_order);
     status |= H5T__register_int(H5T_PERS_SOFT, "fbo(opt)", floatpt, floatpt, H5T__conv_order_opt);
+    status |= H5T__register_int(H5T_PERS_SOFT, "f_f(ieee)", floatpt, floatpt, H5T__conv_f_f_ieee);
     status |= H5T__register_int(H5T_PERS_SOFT, "struct(no-opt)", compound, compound, H5T__conv_struct);
     status |= H5T__register_int(H5T_PERS_SOFT, "struct(opt)", compound, compound, H5T__conv_struct_opt);
     status |= H5T__register_int(H5T_PERS_SOFT, "enum", enum_type, enum_type, H5T__conv_enum);
@@ -1531,6 +1559,7 @@ H5T_top_term_package(void)
         } /* end for */
 
         /* Clear conversion tables */
+        H5T__path_cache_reset();
         H5T_g.path   = (H5T_path_t **)H5MM_xfree(H5T_g.path);
         H5T_g.npaths = 0;
         H5T_g.apaths = 0;
@@ -2657,6 +2686,9 @@ H5T__register(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst, H5T_con
     }     /* end else */
 
 done:
+    /* Paths may have been replaced, so drop any cached lookups */
+    H5T__path_cache_reset();
+
     if (ret_value < 0) {
         if (new_path) {
             if (new_path->src)
@@ -2829,6 +2861,9 @@ H5T__unregister(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst, H5T_c
         }                          /* end else */
     }                              /* end for */
 
+    /* Drop cached lookups, which may refer to removed paths */
+    H5T__path_cache_reset();
+
     FUNC_LEAVE_NOAPI(SUCCEED)
 } /* end H5T__unregister() */
 
@@ -4999,16 +5034,18 @@ done:
 static H5T_path_t *
 H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_conv_func_t *conv)
 {
-    int         lt, rt;                   /* left and right edges */
-    int         md;                       /* middle */
-    int         cmp;                      /* comparison result  */
-    int         old_npaths;               /* Previous number of paths in table */
-    H5T_path_t *table  = NULL;            /* path existing in the table */
-    H5T_path_t *path   = NULL;            /* new path */
-    hid_t       src_id = -1, dst_id = -1; /* src and dst type identifiers */
-    int         i;                        /* counter */
-    int         nprint    = 0;            /* lines of output printed */
-    H5T_path_t *ret_value = NULL;         /* Return value */
+    int               lt, rt;                   /* left and right edges */
+    int               md;                       /* middle */
+    int               cmp;                      /* comparison result  */
+    int               old_npaths;               /* Previous number of paths in table */
+    uint64_t          src_fp, dst_fp;           /* fingerprints of src and dst types */
+    H5T_path_cache_t *slot;                     /* path cache slot for the type pair */
+    H5T_path_t       *table  = NULL;            /* path existing in the table */
+    H5T_path_t       *path   = NULL;            /* new path */
+    hid_t             src_id = -1, dst_id = -1; /* src and dst type identifiers */
+    int               i;                        /* counter */
+    int               nprint    = 0;            /* lines of output printed */
+    H5T_path_t       *ret_value = NULL;         /* Return value */
 
     FUNC_ENTER_PACKAGE
 
@@ -5044,6 +5081,21 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
         H5T_g.npaths           = 1;
     } /* end if */
 
+    /* Fingerprint both types.  Types which compare equal have equal
+     * fingerprints, so a mismatch rules out the no-op path and selects
+     * the path cache slot without any full datatype comparisons.
+     */
+    src_fp = H5T__fingerprint(src);
+    dst_fp = H5T__fingerprint(dst);
+    slot   = &H5T_path_cache_g[H5T_PATH_CACHE_SLOT(src_fp, dst_fp)];
+
+    /* When only looking up a path, check the path cache first.  A hit still
+     * has to compare equal, since different types may share a fingerprint.
+     */
+    if (!conv->u.app_func && slot->path && slot->src_fp == src_fp && slot->dst_fp == dst_fp &&
+        0 == H5T_cmp(src, slot->path->src, FALSE) && 0 == H5T_cmp(dst, slot->path->dst, FALSE))
+        HGOTO_DONE(slot->path);
+
     /* Find the conversion path.  If source and destination types are equal
      * then use entry[0], otherwise do a binary search over the
      * remaining entries.
@@ -5052,7 +5104,7 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
      * Only allow the no-op conversion to occur if no "force conversion" flags
      * are set
      */
-    if (src->shared->force_conv == FALSE && dst->shared->force_conv == FALSE &&
+    if (src->shared->force_conv == FALSE && dst->shared->force_conv == FALSE && src_fp == dst_fp &&
         0 == H5T_cmp(src, dst, TRUE)) {
         table = H5T_g.path[0];
         cmp   = 0;
@@ -5243,6 +5295,9 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
         table          = H5FL_FREE(H5T_path_t, table);
         table          = path;
         H5T_g.path[md] = path;
+
+        /* The replaced path may still be cached */
+        H5T__path_cache_reset();
     } /* end if */
     else if (path != table) {
         HDassert(cmp);
@@ -5271,6 +5326,17 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_co
     if (H5T_COMPOUND == H5T_get_class(src, TRUE) && H5T_COMPOUND == H5T_get_class(dst, TRUE))
         path->are_compounds = TRUE;
 
+    /* Remember the path for later lookups of the same type pair.  The no-op
+     * path is found without a table search, so it isn't cached, and neither
+     * are paths set up while registering a conversion function, since those
+     * bypass the no-op check.
+     */
+    if (!conv->u.app_func && path != H5T_g.path[0]) {
+        slot->src_fp = src_fp;
+        slot->dst_fp = dst_fp;
+        slot->path   = path;
+    } /* end if */
+
     /* Set return value */
     ret_value = path;
 
@@ -5290,6 +5356,113 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__path_find_real() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__fingerprint
+ *
+ * Purpose:     Computes a fingerprint of a datatype for the conversion path
+ *              cache.  Only properties which H5T_cmp() compares in both its
+ *              exact and "superset" modes are folded in, so any two types
+ *              which compare equal have the same fingerprint.  Compound
+ *              members are combined independently of their order, since
+ *              H5T_cmp() matches them by name.
+ *
+ * Return:      The fingerprint (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static uint64_t
+H5T__fingerprint(const H5T_t *dt)
+{
+    const H5T_shared_t *sh;
+    unsigned            u;
+    uint64_t            ret_value = (uint64_t)0xcbf29ce484222325ULL; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(dt);
+    HDassert(dt->shared);
+
+    sh = dt->shared;
+    H5T_FP_MIX(ret_value, sh->type);
+    H5T_FP_MIX(ret_value, sh->size);
+    if (sh->parent)
+        H5T_FP_MIX(ret_value, H5T__fingerprint(sh->parent));
+
+    switch (sh->type) {
+        case H5T_COMPOUND: {
+            uint64_t membs_fp = 0;
+
+            H5T_FP_MIX(ret_value, sh->u.compnd.nmembs);
+            for (u = 0; u < sh->u.compnd.nmembs; u++) {
+                const H5T_cmemb_t *memb    = &sh->u.compnd.memb[u];
+                uint64_t           memb_fp = (uint64_t)0xcbf29ce484222325ULL;
+
+                H5T_FP_MIX(memb_fp, H5_hash_string(memb->name));
+                H5T_FP_MIX(memb_fp, memb->offset);
+                H5T_FP_MIX(memb_fp, memb->size);
+                H5T_FP_MIX(memb_fp, H5T__fingerprint(memb->type));
+                membs_fp += memb_fp;
+            } /* end for */
+            H5T_FP_MIX(ret_value, membs_fp);
+        } break;
+
+        case H5T_VLEN:
+            H5T_FP_MIX(ret_value, sh->u.vlen.type);
+            H5T_FP_MIX(ret_value, sh->u.vlen.loc);
+            H5T_FP_MIX(ret_value, (uintptr_t)sh->u.vlen.file);
+            break;
+
+        case H5T_ARRAY:
+            H5T_FP_MIX(ret_value, sh->u.array.ndims);
+            for (u = 0; u < sh->u.array.ndims; u++)
+                H5T_FP_MIX(ret_value, sh->u.array.dim[u]);
+            break;
+
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_TIME:
+        case H5T_STRING:
+        case H5T_BITFIELD:
+        case H5T_REFERENCE:
+            H5T_FP_MIX(ret_value, sh->u.atomic.order);
+            H5T_FP_MIX(ret_value, sh->u.atomic.prec);
+            H5T_FP_MIX(ret_value, sh->u.atomic.offset);
+            break;
+
+        /* Enumeration members are left out, as "superset" comparisons
+         * allow the destination to have more of them.
+         */
+        case H5T_ENUM:
+        case H5T_OPAQUE:
+        case H5T_NO_CLASS:
+        case H5T_NCLASSES:
+        default:
+            break;
+    } /* end switch */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__fingerprint() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_cache_reset
+ *
+ * Purpose:     Empties the conversion path cache.  Called whenever paths
+ *              are replaced or removed from the path table.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__path_cache_reset(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDmemset(H5T_path_cache_g, 0, sizeof(H5T_path_cache_g));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__path_cache_reset() */
+
 /*-------------------------------------------------------------------------
  * Function:  H5T_path_noop
  *
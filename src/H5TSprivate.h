@@ -57,6 +57,7 @@ typedef INIT_ONCE        H5TS_once_t;
 #define H5TS_mutex_init(mutex)                  InitializeCriticalSection(mutex)
 #define H5TS_mutex_lock_simple(mutex)           EnterCriticalSection(mutex)
 #define H5TS_mutex_unlock_simple(mutex)         LeaveCriticalSection(mutex)
+#define H5TS_mutex_destroy(mutex)               DeleteCriticalSection(mutex)
 
 /* Functions called from DllMain */
 H5_DLL BOOL CALLBACK H5TS_win32_process_enter(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContex);
@@ -103,6 +104,7 @@ typedef pthread_once_t  H5TS_once_t;
 #define H5TS_mutex_init(mutex)                  pthread_mutex_init(mutex, NULL)
 #define H5TS_mutex_lock_simple(mutex)           pthread_mutex_lock(mutex)
 #define H5TS_mutex_unlock_simple(mutex)         pthread_mutex_unlock(mutex)
+#define H5TS_mutex_destroy(mutex)               pthread_mutex_destroy(mutex)
 
 /* Pthread-only routines */
 H5_DLL uint64_t H5TS_thread_id(void);
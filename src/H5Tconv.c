@@ -33,6 +33,15 @@
 #include "H5Pprivate.h"  /* Property lists            */
 #include "H5Tpkg.h"      /* Datatypes                */
 
+/* The vector byte swapping paths need the "target" function attribute of GCC
+ * or Clang, so they can be built without enabling the instructions for the
+ * whole library */
+#if (defined(__x86_64__) || defined(__i386__)) &&                                                            \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 6))
+#define H5T_CONV_HAVE_X86
+#include <immintrin.h>
+#endif
+
 /****************/
 /* Local Macros */
 /****************/
@@ -817,7 +826,12 @@
                         } /* end else */                                                                     \
                                                                                                              \
                         /* Perform loop over elements to convert */                                          \
-                        if (s_mv && d_mv) {                                                                  \
+                        if (!cb_struct.func && !s_mv && !d_mv && s_stride == (ssize_t)sizeof(ST) &&          \
+                            d_stride == (ssize_t)sizeof(DT)) {                                               \
+                            /* Contiguous elements without an exception callback */                          \
+                            H5T_CONV_LOOP_BLOCK(GUTS, STYPE, DTYPE, ST, DT, D_MIN, D_MAX)                    \
+                        }                                                                                    \
+                        else if (s_mv && d_mv) {                                                             \
                             /* Alignment is required for both source and dest */                             \
                             s = &src_aligned;                                                                \
                             H5T_CONV_LOOP_OUTER(PRE_SALIGN, PRE_DALIGN, POST_SALIGN, POST_DALIGN, GUTS,      \
@@ -986,6 +1000,33 @@ done:
         dst         = (DT *)dst_buf;                                                                         \
     }
 
+/* Size of the blocks of source elements converted by H5T_CONV_LOOP_BLOCK, in bytes */
+#define H5T_CONV_BLOCK_SIZE 2048
+
+/* The loop of the type conversion macro for contiguous, aligned elements when no
+ * exception callback is set.  Each block of source elements is copied aside
+ * first, so the core no longer reads through the pointer it writes, and the
+ * compiler can vectorize it (including the saturating comparisons of the
+ * narrowing conversions).  Copying the block before converting it is also what
+ * makes this safe in place, as the destination elements of a block never extend
+ * past its source elements in a forward pass, and don't overlap the source at
+ * all in the "safe" part of a backward pass.
+ */
+#define H5T_CONV_LOOP_BLOCK(GUTS, STYPE, DTYPE, ST, DT, D_MIN, D_MAX)                                        \
+    {                                                                                                        \
+        ST     src_block[H5T_CONV_BLOCK_SIZE / sizeof(ST)]; /*copy of a block of source elements */          \
+        size_t block_nelmts;                                /*number of elements in the block */             \
+        size_t u;                                           /*local index variable */                        \
+                                                                                                             \
+        for (elmtno = 0; elmtno < safe; elmtno += block_nelmts) {                                            \
+            block_nelmts = MIN(safe - elmtno, NELMTS(src_block));                                            \
+            H5MM_memcpy(src_block, src + elmtno, block_nelmts * sizeof(ST));                                 \
+            for (u = 0; u < block_nelmts; u++)                                                               \
+                H5T_CONV_LOOP_GUTS(H5_GLUE(GUTS, _NOEX), STYPE, DTYPE, &src_block[u], &dst[elmtno + u], ST,  \
+                                   DT, D_MIN, D_MAX)                                                         \
+        }                                                                                                    \
+    }
+
 /* Macro to call the actual "guts" of the type conversion, or call the "no exception" guts */
 #ifdef H5_WANT_DCONV_EXCEPTION
 #define H5T_CONV_LOOP_GUTS(GUTS, STYPE, DTYPE, S, D, ST, DT, D_MIN, D_MAX)                                   \
@@ -1051,6 +1092,21 @@ done:
 /* Minimum size of variable-length conversion buffer */
 #define H5T_VLEN_MIN_CONF_BUF_SIZE 4096
 
+/* Number of elements converted at a time by H5T__conv_f_f_ieee() */
+#define H5T_CONV_IEEE_BLOCK 256
+
+/* Reverse the bytes of a 32 or 64-bit value */
+#define H5T_CONV_BSWAP32(X)                                                                                  \
+    ((((X)&0x000000ffU) << 24) | (((X)&0x0000ff00U) << 8) | (((X)&0x00ff0000U) >> 8) |                     \
+     (((X)&0xff000000U) >> 24))
+#define H5T_CONV_BSWAP64(X)                                                                                  \
+    (((uint64_t)H5T_CONV_BSWAP32((uint32_t)(X)) << 32) | (uint64_t)H5T_CONV_BSWAP32((uint32_t)((X) >> 32)))
+
+/* Instruction set extensions used by the byte swapping paths, checked on first use */
+#define H5T_CONV_X86_SSSE3 0x01
+#define H5T_CONV_X86_AVX2  0x02
+#define H5T_CONV_X86_INIT  0x80
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -1072,6 +1128,38 @@ typedef struct H5T_enum_struct_t {
     int     *src2dst; /*map from src to dst index         */
 } H5T_enum_struct_t;
 
+/* Layout of an IEEE 754 single or double precision value in the elements
+ * of a datatype, for H5T__conv_f_f_ieee() */
+typedef struct H5T_conv_ieee_t {
+    size_t  size;    /*size of the elements, in bytes     */
+    size_t  width;   /*size of the value: 4 or 8 bytes    */
+    size_t  pos;     /*offset of the value's bytes        */
+    hbool_t swap;    /*value isn't in native byte order   */
+    uint8_t lo_pad;  /*padding bytes before the value     */
+    uint8_t hi_pad;  /*padding bytes after the value      */
+} H5T_conv_ieee_t;
+
+/* State for converting a whole buffer of VL sequences at once, in
+ * H5T__conv_vlen_read_many() and H5T__conv_vlen_write_many() */
+typedef struct H5T_conv_vlen_batch_t {
+    H5T_t                 *src, *dst;       /*source & destination VL datatypes   */
+    H5T_path_t            *tpath;           /*conversion path for base elements   */
+    hid_t                  tsrc_id;         /*ID of source base type              */
+    hid_t                  tdst_id;         /*ID of destination base type         */
+    hbool_t                noop_conv;       /*base elements don't need converting */
+    size_t                 src_base_size;   /*size of source base type            */
+    size_t                 dst_base_size;   /*size of destination base type       */
+    H5T_vlen_alloc_info_t *vl_alloc_info;   /*VL allocation info                  */
+    uint8_t               *s, *d, *b;       /*source, dest & background buffers   */
+    size_t                 s_stride;        /*source stride                       */
+    size_t                 d_stride;        /*destination stride                  */
+    size_t                 b_stride;        /*background stride                   */
+    void                 **conv_buf;        /*temporary conversion buffer         */
+    size_t                *conv_buf_size;   /*size of conversion buffer in bytes  */
+    void                 **tmp_buf;         /*temporary background buffer         */
+    size_t                *tmp_buf_size;    /*size of temporary bkg buffer        */
+} H5T_conv_vlen_batch_t;
+
 /* Conversion data for the hardware conversion functions */
 typedef struct H5T_conv_hw_t {
     size_t s_aligned; /*number source elements aligned     */
@@ -1087,6 +1175,19 @@ typedef struct H5T_conv_hw_t {
 /********************/
 
 static herr_t H5T__reverse_order(uint8_t *rev, uint8_t *s, size_t size, H5T_order_t order);
+static hbool_t H5T__conv_ieee_layout(const H5T_t *dt, H5T_conv_ieee_t *layout);
+static void    H5T__conv_ieee_load(const uint8_t *buf, size_t stride, const H5T_conv_ieee_t *layout,
+                                   size_t nelmts, uint64_t *bits);
+static void    H5T__conv_ieee_store(uint8_t *buf, size_t stride, const H5T_conv_ieee_t *layout, size_t nelmts,
+                                    const uint64_t *bits);
+static herr_t  H5T__conv_vlen_read_many_cb(size_t u, const void *seq, size_t seq_len, void *_batch);
+static herr_t  H5T__conv_vlen_read_many(H5T_conv_vlen_batch_t *batch, size_t nelmts);
+static herr_t  H5T__conv_vlen_write_many(H5T_conv_vlen_batch_t *batch, size_t nelmts);
+#ifdef H5T_CONV_HAVE_X86
+static unsigned H5T__conv_x86_features(void);
+static size_t   H5T__conv_order_swap_ssse3(uint8_t *buf, size_t nbytes, const uint8_t *mask);
+static size_t   H5T__conv_order_swap_avx2(uint8_t *buf, size_t nbytes, const uint8_t *mask);
+#endif /* H5T_CONV_HAVE_X86 */
 
 /*********************/
 /* Public Variables */
@@ -1113,6 +1214,19 @@ H5FL_BLK_DEFINE_STATIC(array_seq);
 /* Declare a free list to manage pieces of reference data */
 H5FL_BLK_DEFINE_STATIC(ref_seq);
 
+#ifdef H5T_CONV_HAVE_X86
+/* Instruction set extensions supported by the CPU (H5T_CONV_X86_*) */
+static unsigned H5T_conv_x86_g = 0;
+
+/* Byte shuffle masks reversing the bytes of each 2, 4, 8 and 16-byte element
+ * of a 16-byte vector, indexed by log2(size) - 1 */
+static const uint8_t H5T_conv_swap_mask_g[4][16] = {
+    {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+    {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+    {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8},
+    {15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0}};
+#endif /* H5T_CONV_HAVE_X86 */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_noop
  *
@@ -1155,6 +1269,113 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_noop() */
 
+#ifdef H5T_CONV_HAVE_X86
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_x86_features
+ *
+ * Purpose:     Check which instruction set extensions used by the byte
+ *              swapping paths are supported by the CPU, on the first call.
+ *
+ * Return:      Bitmask of H5T_CONV_X86_* flags (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5T__conv_x86_features(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (!(H5T_conv_x86_g & H5T_CONV_X86_INIT)) {
+        unsigned features = H5T_CONV_X86_INIT;
+
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("ssse3"))
+            features |= H5T_CONV_X86_SSSE3;
+        if (__builtin_cpu_supports("avx2"))
+            features |= H5T_CONV_X86_AVX2;
+
+        H5T_conv_x86_g = features;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(H5T_conv_x86_g)
+} /* end H5T__conv_x86_features() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_order_swap_ssse3
+ *
+ * Purpose:     Reverse the bytes of the elements in the first NBYTES bytes
+ *              of BUF, 16 bytes at a time, with the SSSE3 byte shuffle and
+ *              the shuffle MASK for the element size.
+ *
+ * Return:      Number of bytes swapped, a multiple of 16 (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static __attribute__((target("ssse3"))) size_t
+H5T__conv_order_swap_ssse3(uint8_t *buf, size_t nbytes, const uint8_t *mask)
+{
+    const __m128i vmask = _mm_loadu_si128((const __m128i *)(const void *)mask);
+    size_t        u;
+
+    for (u = 0; u + 64 <= nbytes; u += 64) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)(const void *)(buf + u));
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(const void *)(buf + u + 16));
+        __m128i v2 = _mm_loadu_si128((const __m128i *)(const void *)(buf + u + 32));
+        __m128i v3 = _mm_loadu_si128((const __m128i *)(const void *)(buf + u + 48));
+
+        _mm_storeu_si128((__m128i *)(void *)(buf + u), _mm_shuffle_epi8(v0, vmask));
+        _mm_storeu_si128((__m128i *)(void *)(buf + u + 16), _mm_shuffle_epi8(v1, vmask));
+        _mm_storeu_si128((__m128i *)(void *)(buf + u + 32), _mm_shuffle_epi8(v2, vmask));
+        _mm_storeu_si128((__m128i *)(void *)(buf + u + 48), _mm_shuffle_epi8(v3, vmask));
+    } /* end for */
+    for (/*void*/; u + 16 <= nbytes; u += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(buf + u));
+
+        _mm_storeu_si128((__m128i *)(void *)(buf + u), _mm_shuffle_epi8(v, vmask));
+    } /* end for */
+
+    return u;
+} /* end H5T__conv_order_swap_ssse3() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_order_swap_avx2
+ *
+ * Purpose:     Reverse the bytes of the elements in the first NBYTES bytes
+ *              of BUF, 32 bytes at a time, with the AVX2 byte shuffle and
+ *              the shuffle MASK for the element size, which is applied to
+ *              each 16-byte half of the vectors.
+ *
+ * Return:      Number of bytes swapped, a multiple of 32 (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static __attribute__((target("avx2"))) size_t
+H5T__conv_order_swap_avx2(uint8_t *buf, size_t nbytes, const uint8_t *mask)
+{
+    const __m256i vmask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(const void *)mask));
+    size_t        u;
+
+    for (u = 0; u + 128 <= nbytes; u += 128) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i *)(const void *)(buf + u));
+        __m256i v1 = _mm256_loadu_si256((const __m256i *)(const void *)(buf + u + 32));
+        __m256i v2 = _mm256_loadu_si256((const __m256i *)(const void *)(buf + u + 64));
+        __m256i v3 = _mm256_loadu_si256((const __m256i *)(const void *)(buf + u + 96));
+
+        _mm256_storeu_si256((__m256i *)(void *)(buf + u), _mm256_shuffle_epi8(v0, vmask));
+        _mm256_storeu_si256((__m256i *)(void *)(buf + u + 32), _mm256_shuffle_epi8(v1, vmask));
+        _mm256_storeu_si256((__m256i *)(void *)(buf + u + 64), _mm256_shuffle_epi8(v2, vmask));
+        _mm256_storeu_si256((__m256i *)(void *)(buf + u + 96), _mm256_shuffle_epi8(v3, vmask));
+    } /* end for */
+    for (/*void*/; u + 32 <= nbytes; u += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(buf + u));
+
+        _mm256_storeu_si256((__m256i *)(void *)(buf + u), _mm256_shuffle_epi8(v, vmask));
+    } /* end for */
+
+    return u;
+} /* end H5T__conv_order_swap_avx2() */
+#endif /* H5T_CONV_HAVE_X86 */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_order_opt
  *
@@ -1261,6 +1482,38 @@ H5T__conv_order_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmt
             } /* end if */
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+
+#ifdef H5T_CONV_HAVE_X86
+            /* Swap as many contiguous elements as possible with the vector instructions */
+            if (buf_stride == src->shared->size && src->shared->size > 1) {
+                unsigned       features = H5T__conv_x86_features();
+                const uint8_t *mask;
+                size_t         nbytes = 0;
+
+                switch (src->shared->size) {
+                    case 2:
+                        mask = H5T_conv_swap_mask_g[0];
+                        break;
+                    case 4:
+                        mask = H5T_conv_swap_mask_g[1];
+                        break;
+                    case 8:
+                        mask = H5T_conv_swap_mask_g[2];
+                        break;
+                    default:
+                        mask = H5T_conv_swap_mask_g[3];
+                        break;
+                } /* end switch */
+
+                if (features & H5T_CONV_X86_AVX2)
+                    nbytes = H5T__conv_order_swap_avx2(buf, nelmts * buf_stride, mask);
+                else if (features & H5T_CONV_X86_SSSE3)
+                    nbytes = H5T__conv_order_swap_ssse3(buf, nelmts * buf_stride, mask);
+                buf += nbytes;
+                nelmts -= nbytes / buf_stride;
+            } /* end if */
+#endif /* H5T_CONV_HAVE_X86 */
+
             switch (src->shared->size) {
                 case 1:
                     /*no-op*/
@@ -1947,6 +2200,7 @@ H5T__conv_struct_free(H5T_conv_struct_t *priv)
     H5MM_xfree(src_memb_id);
     H5MM_xfree(dst_memb_id);
     H5MM_xfree(priv->memb_path);
+    H5MM_xfree(priv->subset_info.spans);
 
     FUNC_LEAVE_NOAPI((H5T_conv_struct_t *)H5MM_xfree(priv))
 } /* end H5T__conv_struct_free() */
@@ -1990,6 +2244,15 @@ H5T__conv_struct_free(H5T_conv_struct_t *priv)
  *              The optimization is simply moving data to the appropriate
  *              places in the buffer.
  *
+ *              Source members which need no conversion are compiled into
+ *              a list of copy spans, merging members which are adjacent in
+ *              both types into a single span.  The conversion functions
+ *              copy these with one pass over the elements instead of one
+ *              pass per member.  When no member needs converting at all,
+ *              the subset flag is set to H5T_SUBSET_COPY so that
+ *              H5D__compound_opt_read() can copy the spans straight into
+ *              the application's buffer.
+ *
  * Return:    Non-negative on success/Negative on failure
  *
  * Programmer:    Robb Matzke
@@ -2003,6 +2266,7 @@ H5T__conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
     H5T_conv_struct_t *priv    = (H5T_conv_struct_t *)(cdata->priv);
     int               *src2dst = NULL;
     unsigned           src_nmembs, dst_nmembs;
+    hbool_t            all_copy = TRUE; /* Whether no member needs conversion */
     unsigned           i, j;
     herr_t             ret_value = SUCCEED; /* Return value */
 
@@ -2094,6 +2358,39 @@ H5T__conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
         }     /* end if */
     }         /* end for */
 
+    /* Compile the copy spans for the members which need no conversion */
+    priv->subset_info.spans  = (H5T_copy_span_t *)H5MM_xfree(priv->subset_info.spans);
+    priv->subset_info.nspans = 0;
+    if (src_nmembs > 0 && NULL == (priv->subset_info.spans =
+                                       (H5T_copy_span_t *)H5MM_malloc(src_nmembs * sizeof(H5T_copy_span_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+    for (i = 0; i < src_nmembs; i++) {
+        const H5T_cmemb_t *src_memb, *dst_memb;
+        H5T_copy_span_t   *span;
+
+        if (src2dst[i] < 0)
+            continue;
+        if (!priv->memb_path[i]->is_noop) {
+            all_copy = FALSE;
+            continue;
+        } /* end if */
+        src_memb = &src->shared->u.compnd.memb[i];
+        dst_memb = &dst->shared->u.compnd.memb[src2dst[i]];
+        HDassert(src_memb->size == dst_memb->size);
+
+        /* Extend the previous span if this member follows it in both types */
+        span = priv->subset_info.spans + priv->subset_info.nspans;
+        if (priv->subset_info.nspans > 0 && span[-1].src_off + span[-1].len == src_memb->offset &&
+            span[-1].dst_off + span[-1].len == dst_memb->offset)
+            span[-1].len += src_memb->size;
+        else {
+            span->src_off = src_memb->offset;
+            span->dst_off = dst_memb->offset;
+            span->len     = src_memb->size;
+            priv->subset_info.nspans++;
+        } /* end else */
+    }     /* end for */
+
     /* The compound conversion functions need a background buffer */
     cdata->need_bkg = H5T_BKG_YES;
 
@@ -2145,6 +2442,10 @@ H5T__conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
         ;
     }
 
+    /* Members which are only copied, but not as a common prefix of both types */
+    if (H5T_SUBSET_FALSE == priv->subset_info.subset && all_copy)
+        priv->subset_info.subset = H5T_SUBSET_COPY;
+
     cdata->recalc = FALSE;
 
 done:
@@ -2310,6 +2611,12 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
 
             /* Conversion loop... */
             for (elmtno = 0; elmtno < nelmts; elmtno++) {
+                /*
+                 * Copy the members which need no conversion straight to the
+                 * background buffer, before any other member is moved.
+                 */
+                H5T_COPY_SPANS(xbkg, xbuf, priv->subset_info.spans, priv->subset_info.nspans);
+
                 /*
                  * For each source member which will be present in the
                  * destination, convert the member to the destination type unless
@@ -2319,8 +2626,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                  * right side.
                  */
                 for (u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if (src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if (src2dst[u] < 0 || priv->memb_path[u]->is_noop)
+                        continue; /*subsetting, or copied above*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2349,8 +2656,8 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                  */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for (i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if (src2dst[i] < 0)
-                        continue; /*subsetting*/
+                    if (src2dst[i] < 0 || priv->memb_path[i]->is_noop)
+                        continue; /*subsetting, or copied above*/
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
 
@@ -2382,13 +2689,16 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
 
             /*
              * Copy the background buffer back into the in-place conversion
-             * buffer.
+             * buffer, all at once if both are packed.
              */
-            for (xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
-                HDmemmove(xbuf, xbkg, dst->shared->size);
-                xbuf += buf_stride ? buf_stride : dst->shared->size;
-                xbkg += bkg_delta;
-            } /* end for */
+            if ((!buf_stride || buf_stride == dst->shared->size) && (size_t)bkg_delta == dst->shared->size)
+                HDmemmove(buf, bkg, nelmts * dst->shared->size);
+            else
+                for (xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                    HDmemmove(xbuf, xbkg, dst->shared->size);
+                    xbuf += buf_stride ? buf_stride : dst->shared->size;
+                    xbkg += bkg_delta;
+                } /* end for */
             break;
 
         default:
@@ -2587,6 +2897,23 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
                 } /* end for */
             }     /* end if */
             else {
+                /*
+                 * Copy the members which need no conversion to the bkg buffer,
+                 * all of them in a single pass through the elements, before
+                 * any member is moved.
+                 */
+                if (priv->subset_info.nspans > 0) {
+                    xbuf = buf;
+                    xbkg = bkg;
+                    for (elmtno = 0; elmtno < nelmts; elmtno++) {
+                        H5T_COPY_SPANS(xbkg, xbuf, priv->subset_info.spans, priv->subset_info.nspans);
+
+                        /* Update pointers */
+                        xbuf += buf_stride;
+                        xbkg += bkg_stride;
+                    } /* end for */
+                }     /* end if */
+
                 /*
                  * For each member where the destination is not larger than the
                  * source, stride through all the elements converting only that member
@@ -2595,8 +2922,8 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
                  * left as possible in the buffer.
                  */
                 for (u = 0, offset = 0; u < src->shared->u.compnd.nmembs; u++) {
-                    if (src2dst[u] < 0)
-                        continue; /*subsetting*/
+                    if (src2dst[u] < 0 || priv->memb_path[u]->is_noop)
+                        continue; /*subsetting, or copied above*/
                     src_memb = src->shared->u.compnd.memb + u;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[u];
 
@@ -2631,7 +2958,7 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
                  */
                 H5_CHECK_OVERFLOW(src->shared->u.compnd.nmembs, size_t, int);
                 for (i = (int)src->shared->u.compnd.nmembs - 1; i >= 0; --i) {
-                    if (src2dst[i] < 0)
+                    if (src2dst[i] < 0 || priv->memb_path[i]->is_noop)
                         continue;
                     src_memb = src->shared->u.compnd.memb + i;
                     dst_memb = dst->shared->u.compnd.memb + src2dst[i];
@@ -2657,12 +2984,15 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelm
             if (no_stride)
                 buf_stride = dst->shared->size;
 
-            /* Move background buffer into result buffer */
-            for (xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
-                HDmemmove(xbuf, xbkg, dst->shared->size);
-                xbuf += buf_stride;
-                xbkg += bkg_stride;
-            } /* end for */
+            /* Move background buffer into result buffer, all at once if both are packed */
+            if (buf_stride == dst->shared->size && bkg_stride == dst->shared->size)
+                HDmemmove(buf, bkg, nelmts * dst->shared->size);
+            else
+                for (xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                    HDmemmove(xbuf, xbkg, dst->shared->size);
+                    xbuf += buf_stride;
+                    xbkg += bkg_stride;
+                } /* end for */
             break;
 
         default:
@@ -3094,6 +3424,253 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_enum_numeric() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_vlen_read_many_cb
+ *
+ * Purpose:     H5T__vlen_disk_read_many() callback, which converts
+ *              sequence U of the batch to the destination datatype and
+ *              stores it in the destination buffer.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_vlen_read_many_cb(size_t u, const void *seq, size_t seq_len, void *_batch)
+{
+    H5T_conv_vlen_batch_t *batch     = (H5T_conv_vlen_batch_t *)_batch; /* Conversion state */
+    uint8_t               *d         = batch->d + u * batch->d_stride;  /* Destination element */
+    uint8_t               *b         = NULL;                            /* Background element */
+    void                  *seq_buf;                                     /* Sequence to store */
+    herr_t                 ret_value = SUCCEED;                         /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (batch->b)
+        b = batch->b + u * batch->b_stride;
+
+    /* Write "nil" sequence to destination location */
+    if (NULL == seq) {
+        if ((*(batch->dst->shared->u.vlen.cls->setnull))(batch->dst->shared->u.vlen.file, d, b) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't set VL data to 'nil'")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* The sequence is copied straight out of the global heap when its
+     * elements don't need converting */
+    if (batch->noop_conv) {
+        /* The VL class write callbacks for memory only read from the sequence */
+        H5_GCC_CLANG_DIAG_OFF("cast-qual")
+        seq_buf = (void *)seq;
+        H5_GCC_CLANG_DIAG_ON("cast-qual")
+    } /* end if */
+    else {
+        size_t src_size = seq_len * batch->src_base_size; /* Source size in bytes */
+        size_t dst_size = seq_len * batch->dst_base_size; /* Destination size in bytes */
+
+        /* Check if conversion buffer is large enough, resize if necessary */
+        if (!*batch->conv_buf || *batch->conv_buf_size < MAX(src_size, dst_size)) {
+            *batch->conv_buf_size = ((MAX(src_size, dst_size) / H5T_VLEN_MIN_CONF_BUF_SIZE) + 1) *
+                                    H5T_VLEN_MIN_CONF_BUF_SIZE;
+            if (NULL == (*batch->conv_buf =
+                             H5FL_BLK_REALLOC(vlen_seq, *batch->conv_buf, *batch->conv_buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+            HDmemset(*batch->conv_buf, 0, *batch->conv_buf_size);
+        } /* end if */
+
+        /* Check if temporary buffer is large enough, resize if necessary */
+        /* (Chain off the conversion buffer size) */
+        if (*batch->tmp_buf && *batch->tmp_buf_size < *batch->conv_buf_size) {
+            *batch->tmp_buf_size = *batch->conv_buf_size;
+            if (NULL == (*batch->tmp_buf = H5FL_BLK_REALLOC(vlen_seq, *batch->tmp_buf, *batch->tmp_buf_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for type conversion")
+            HDmemset(*batch->tmp_buf, 0, *batch->tmp_buf_size);
+        } /* end if */
+
+        /* Convert VL sequence */
+        H5MM_memcpy(*batch->conv_buf, seq, src_size);
+        if (H5T_convert(batch->tpath, batch->tsrc_id, batch->tdst_id, seq_len, (size_t)0, (size_t)0,
+                        *batch->conv_buf, *batch->tmp_buf) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "datatype conversion failed")
+        seq_buf = *batch->conv_buf;
+    } /* end else */
+
+    /* Write sequence to destination location */
+    if ((*(batch->dst->shared->u.vlen.cls->write))(batch->dst->shared->u.vlen.file, batch->vl_alloc_info, d,
+                                                    seq_buf, b, seq_len, batch->dst_base_size) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_vlen_read_many_cb() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_vlen_read_many
+ *
+ * Purpose:     Converts NELMTS VL sequences stored in the global heap of a
+ *              native file to VL sequences in memory, reading the heap
+ *              collections they are in once each, in address order,
+ *              instead of once per sequence.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_vlen_read_many(H5T_conv_vlen_batch_t *batch, size_t nelmts)
+{
+    const void **vls = NULL;          /* Disk information of each sequence */
+    size_t       u;                   /* Local index variable */
+    herr_t       ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (NULL == (vls = (const void **)H5MM_malloc(nelmts * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL sequences")
+    for (u = 0; u < nelmts; u++)
+        vls[u] = batch->s + u * batch->s_stride;
+
+    /* The disk information of all the sequences is decoded before any of
+     * them is stored, so the source and destination elements may overlap */
+    if (H5T__vlen_disk_read_many(batch->src->shared->u.vlen.file, nelmts, vls, batch->src_base_size,
+                                 H5T__conv_vlen_read_many_cb, batch) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+
+done:
+    H5MM_xfree(vls);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_vlen_read_many() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_vlen_write_many
+ *
+ * Purpose:     Converts NELMTS VL sequences in memory to VL sequences
+ *              stored in the global heap of a native file, packing all
+ *              of them into heap collections at once instead of inserting
+ *              them one at a time.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__conv_vlen_write_many(H5T_conv_vlen_batch_t *batch, size_t nelmts)
+{
+    H5T_t       *src      = batch->src;                                   /* Source datatype */
+    H5T_t       *dst      = batch->dst;                                   /* Destination datatype */
+    size_t       max_base = MAX(batch->src_base_size, batch->dst_base_size); /* Larger base size */
+    size_t      *idx      = NULL;    /* Element index of each non-"nil" sequence */
+    size_t      *seq_lens = NULL;    /* Length of each non-"nil" sequence */
+    const void **seqs     = NULL;    /* Data of each non-"nil" sequence */
+    void       **vls      = NULL;    /* Destination of each non-"nil" sequence */
+    hbool_t     *is_nil   = NULL;    /* Whether each element is "nil" */
+    uint8_t     *seq_data = NULL;    /* Converted data of all the sequences */
+    size_t       seq_data_size = 0;  /* Size of the converted data */
+    size_t       nseq          = 0;  /* Number of non-"nil" sequences */
+    size_t       u;                  /* Local index variable */
+    herr_t       ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (NULL == (is_nil = (hbool_t *)H5MM_malloc(nelmts * sizeof(hbool_t))) ||
+        NULL == (idx = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))) ||
+        NULL == (seq_lens = (size_t *)H5MM_malloc(nelmts * sizeof(size_t))) ||
+        NULL == (seqs = (const void **)H5MM_malloc(nelmts * sizeof(void *))) ||
+        NULL == (vls = (void **)H5MM_malloc(nelmts * sizeof(void *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL sequences")
+
+    /* Find the lengths of the sequences */
+    for (u = 0; u < nelmts; u++) {
+        uint8_t *s = batch->s + u * batch->s_stride; /* Source element */
+
+        /* Check for "nil" source sequence */
+        if ((*(src->shared->u.vlen.cls->isnull))(src->shared->u.vlen.file, s, &is_nil[u]) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't check if VL data is 'nil'")
+        if (is_nil[u])
+            continue;
+
+        /* Get length of element sequences */
+        if ((*(src->shared->u.vlen.cls->getlen))(src->shared->u.vlen.file, s, &seq_lens[nseq]) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "bad sequence length")
+        idx[nseq] = u;
+        vls[nseq] = batch->d + u * batch->d_stride;
+        if (!batch->noop_conv)
+            seq_data_size += seq_lens[nseq] * max_base;
+        nseq++;
+    } /* end for */
+
+    /* Gather the sequences, converting them when needed */
+    if (seq_data_size > 0)
+        if (NULL == (seq_data = (uint8_t *)H5MM_calloc(seq_data_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for type conversion")
+    seq_data_size = 0;
+    for (u = 0; u < nseq; u++) {
+        uint8_t *s = batch->s + idx[u] * batch->s_stride; /* Source element */
+
+        if (batch->noop_conv) {
+            /* Get direct pointer to sequence */
+            if (NULL == (seqs[u] = (*(src->shared->u.vlen.cls->getptr))(s)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid source pointer")
+        } /* end if */
+        else {
+            uint8_t *conv = seq_data + seq_data_size; /* Sequence's part of the converted data */
+
+            /* Read in VL sequence */
+            if (seq_lens[u] > 0) {
+                if ((*(src->shared->u.vlen.cls->read))(src->shared->u.vlen.file, s, conv,
+                                                       seq_lens[u] * batch->src_base_size) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+
+                /* Check if temporary buffer is large enough, resize if necessary */
+                if (*batch->tmp_buf && *batch->tmp_buf_size < seq_lens[u] * max_base) {
+                    *batch->tmp_buf_size = seq_lens[u] * max_base;
+                    if (NULL ==
+                        (*batch->tmp_buf = H5FL_BLK_REALLOC(vlen_seq, *batch->tmp_buf, *batch->tmp_buf_size)))
+                        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                                    "memory allocation failed for type conversion")
+                    HDmemset(*batch->tmp_buf, 0, *batch->tmp_buf_size);
+                } /* end if */
+
+                /* Convert VL sequence */
+                if (H5T_convert(batch->tpath, batch->tsrc_id, batch->tdst_id, seq_lens[u], (size_t)0,
+                                (size_t)0, conv, *batch->tmp_buf) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "datatype conversion failed")
+            } /* end if */
+            seqs[u] = conv;
+            seq_data_size += seq_lens[u] * max_base;
+        } /* end else */
+
+        /* Free heap object for old data */
+        if (batch->b)
+            if ((*(dst->shared->u.vlen.cls->del))(dst->shared->u.vlen.file,
+                                                  batch->b + idx[u] * batch->b_stride) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTREMOVE, FAIL, "unable to remove background heap object")
+    } /* end for */
+
+    /* All the source elements have been read, so the destination elements
+     * can be written now, even where they overlap the source elements */
+    if (H5T__vlen_disk_write_many(dst->shared->u.vlen.file, nseq, vls, seqs, seq_lens,
+                                  batch->dst_base_size) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+    for (u = 0; u < nelmts; u++)
+        if (is_nil[u])
+            if ((*(dst->shared->u.vlen.cls->setnull))(dst->shared->u.vlen.file,
+                                                      batch->d + u * batch->d_stride,
+                                                      batch->b ? batch->b + u * batch->b_stride : NULL) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't set VL data to 'nil'")
+
+done:
+    H5MM_xfree(seq_data);
+    H5MM_xfree(vls);
+    H5MM_xfree(seqs);
+    H5MM_xfree(seq_lens);
+    H5MM_xfree(idx);
+    H5MM_xfree(is_nil);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_vlen_write_many() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_vlen
  *
@@ -3126,6 +3703,7 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
     H5T_path_t           *tpath         = NULL;       /* Type conversion path             */
     hbool_t               noop_conv     = FALSE;      /* Flag to indicate a noop conversion */
     hbool_t               write_to_file = FALSE;      /* Flag to indicate writing to file */
+    hbool_t               direct_src    = FALSE;      /* Flag to use the source sequences in place */
     htri_t                parent_is_vlen;             /* Flag to indicate parent is vlen datatype */
     size_t                bg_seq_len = 0;             /* The number of elements in the background sequence */
     hid_t                 tsrc_id = -1, tdst_id = -1; /*temporary type atoms         */
@@ -3143,6 +3721,8 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
     void                 *tmp_buf       = NULL;         /*temporary background buffer          */
     size_t                tmp_buf_size  = 0;            /*size of temporary bkg buffer         */
     hbool_t               nested        = FALSE;        /*flag of nested VL case             */
+    hbool_t               read_many     = FALSE;        /*flag to read all sequences at once  */
+    hbool_t               write_many    = FALSE;        /*flag to write all sequences at once */
     size_t                elmtno;                       /*element number counter         */
     herr_t                ret_value = SUCCEED;          /* Return value */
 
@@ -3262,10 +3842,67 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
             if (dst->shared->u.vlen.file != NULL)
                 write_to_file = TRUE;
 
+            /* Use the source sequences where they are when they don't need
+             * converting and are in memory, or inline in a chunk in memory */
+            if (noop_conv && (write_to_file || (H5T_LOC_DISK == src->shared->u.vlen.loc &&
+                                                src->shared->u.vlen.cls->getptr)))
+                direct_src = TRUE;
+
             /* Set the flag for nested VL case */
             if (write_to_file && parent_is_vlen && bkg != NULL)
                 nested = TRUE;
 
+            /* Convert all the sequences at once when they are read from or
+             * written to the global heap of a native file, so that each heap
+             * collection is accessed once instead of once per sequence.
+             * Sequences of VL data or references, whose conversion accesses
+             * the file itself, are still converted one at a time. */
+            if (nelmts > 1 && !parent_is_vlen) {
+                htri_t parent_is_ref; /* Flag to indicate parent contains references */
+
+                if ((parent_is_ref = H5T_detect_class(dst->shared->parent, H5T_REFERENCE, FALSE)) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_SYSTEM, FAIL, "internal error when detecting reference class")
+                if (!parent_is_ref) {
+                    if (H5T_LOC_MEMORY == dst->shared->u.vlen.loc && H5T__vlen_disk_is_native(src))
+                        read_many = TRUE;
+                    else if (H5T_LOC_MEMORY == src->shared->u.vlen.loc && H5T__vlen_disk_is_native(dst))
+                        write_many = TRUE;
+                } /* end if */
+            }     /* end if */
+            if (read_many || write_many) {
+                H5T_conv_vlen_batch_t batch; /* Conversion state for the whole buffer */
+
+                batch.src           = src;
+                batch.dst           = dst;
+                batch.tpath         = tpath;
+                batch.tsrc_id       = tsrc_id;
+                batch.tdst_id       = tdst_id;
+                batch.noop_conv     = noop_conv;
+                batch.src_base_size = src_base_size;
+                batch.dst_base_size = dst_base_size;
+                batch.vl_alloc_info = &vl_alloc_info;
+                batch.s             = (uint8_t *)buf;
+                batch.d             = (uint8_t *)buf;
+                batch.b             = (uint8_t *)bkg;
+                batch.s_stride      = (size_t)s_stride;
+                batch.d_stride      = (size_t)d_stride;
+                batch.b_stride      = (size_t)b_stride;
+                batch.conv_buf      = &conv_buf;
+                batch.conv_buf_size = &conv_buf_size;
+                batch.tmp_buf       = &tmp_buf;
+                batch.tmp_buf_size  = &tmp_buf_size;
+
+                if (read_many) {
+                    if (H5T__conv_vlen_read_many(&batch, nelmts) < 0)
+                        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+                } /* end if */
+                else if (H5T__conv_vlen_write_many(&batch, nelmts) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "can't write VL data")
+
+                /* No elements are left to convert */
+                nelmts = 0;
+            } /* end if */
+
             /* The outer loop of the type conversion macro, controlling which */
             /* direction the buffer is walked */
             while (nelmts > 0) {
@@ -3329,7 +3966,7 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
 
                         /* If we are reading from memory and there is no conversion, just get the pointer to
                          * sequence */
-                        if (write_to_file && noop_conv) {
+                        if (direct_src) {
                             /* Get direct pointer to sequence */
                             if (NULL == (conv_buf = (*(src->shared->u.vlen.cls->getptr))(s)))
                                 HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid source pointer")
@@ -3469,7 +4106,7 @@ H5T__conv_vlen(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, si
 
 done:
     /* If the conversion buffer doesn't need to be freed, reset its pointer */
-    if (write_to_file && noop_conv)
+    if (direct_src)
         conv_buf = NULL;
     /* Release the conversion buffer (always allocated, except on errors) */
     if (conv_buf)
@@ -4870,6 +5507,340 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__conv_f_f() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_ieee_layout
+ *
+ * Purpose:     Check whether the elements of the floating-point datatype DT
+ *              hold an IEEE 754 single or double precision value, in big or
+ *              little-endian byte order, possibly with whole bytes of zero
+ *              or one padding around it, and describe where in LAYOUT.
+ *
+ * Return:      TRUE if DT has such a layout, FALSE otherwise (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5T__conv_ieee_layout(const H5T_t *dt, H5T_conv_ieee_t *layout)
+{
+    const H5T_atomic_t *atomic = &dt->shared->u.atomic;
+    size_t              off;               /*byte offset of the value, from the least significant byte */
+    hbool_t             ret_value = FALSE; /*return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (H5T_FLOAT != dt->shared->type)
+        HGOTO_DONE(FALSE)
+    if (H5T_ORDER_LE != atomic->order && H5T_ORDER_BE != atomic->order)
+        HGOTO_DONE(FALSE)
+    if (atomic->offset % 8 || (atomic->prec != 32 && atomic->prec != 64) ||
+        atomic->offset + atomic->prec > 8 * dt->shared->size)
+        HGOTO_DONE(FALSE)
+
+    /* The fields must be exactly those of an IEEE value, covering the precision */
+    if (atomic->u.f.norm != H5T_NORM_IMPLIED || atomic->u.f.mpos != atomic->offset ||
+        atomic->u.f.sign != atomic->offset + atomic->prec - 1)
+        HGOTO_DONE(FALSE)
+    if (atomic->prec == 32 && (atomic->u.f.epos != atomic->offset + 23 || atomic->u.f.esize != 8 ||
+                               atomic->u.f.ebias != 127 || atomic->u.f.msize != 23))
+        HGOTO_DONE(FALSE)
+    if (atomic->prec == 64 && (atomic->u.f.epos != atomic->offset + 52 || atomic->u.f.esize != 11 ||
+                               atomic->u.f.ebias != 1023 || atomic->u.f.msize != 52))
+        HGOTO_DONE(FALSE)
+
+    /* Padding must be all zeros or all ones, if there is any */
+    if (atomic->offset > 0 && H5T_PAD_ZERO != atomic->lsb_pad && H5T_PAD_ONE != atomic->lsb_pad)
+        HGOTO_DONE(FALSE)
+    if (atomic->offset + atomic->prec < 8 * dt->shared->size && H5T_PAD_ZERO != atomic->msb_pad &&
+        H5T_PAD_ONE != atomic->msb_pad)
+        HGOTO_DONE(FALSE)
+
+    layout->size  = dt->shared->size;
+    layout->width = atomic->prec / 8;
+    layout->swap  = (hbool_t)(atomic->order != H5T_native_order_g);
+    off           = atomic->offset / 8;
+    if (H5T_ORDER_LE == atomic->order) {
+        layout->pos    = off;
+        layout->lo_pad = (uint8_t)(H5T_PAD_ONE == atomic->lsb_pad ? 0xff : 0);
+        layout->hi_pad = (uint8_t)(H5T_PAD_ONE == atomic->msb_pad ? 0xff : 0);
+    } /* end if */
+    else {
+        layout->pos    = dt->shared->size - (off + layout->width);
+        layout->lo_pad = (uint8_t)(H5T_PAD_ONE == atomic->msb_pad ? 0xff : 0);
+        layout->hi_pad = (uint8_t)(H5T_PAD_ONE == atomic->lsb_pad ? 0xff : 0);
+    } /* end else */
+
+    ret_value = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_ieee_layout() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_ieee_load
+ *
+ * Purpose:     Copy the IEEE values of NELMTS elements of BUF, STRIDE bytes
+ *              apart, to BITS, in native byte order.  Single precision
+ *              values are zero-extended.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__conv_ieee_load(const uint8_t *buf, size_t stride, const H5T_conv_ieee_t *layout, size_t nelmts,
+                    uint64_t *bits)
+{
+    size_t u;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    buf += layout->pos;
+    if (4 == layout->width) {
+        uint32_t w;
+
+        if (layout->swap)
+            for (u = 0; u < nelmts; u++, buf += stride) {
+                HDmemcpy(&w, buf, sizeof(w));
+                bits[u] = H5T_CONV_BSWAP32(w);
+            } /* end for */
+        else
+            for (u = 0; u < nelmts; u++, buf += stride) {
+                HDmemcpy(&w, buf, sizeof(w));
+                bits[u] = w;
+            } /* end for */
+    }         /* end if */
+    else {
+        uint64_t w;
+
+        if (layout->swap)
+            for (u = 0; u < nelmts; u++, buf += stride) {
+                HDmemcpy(&w, buf, sizeof(w));
+                bits[u] = H5T_CONV_BSWAP64(w);
+            } /* end for */
+        else
+            for (u = 0; u < nelmts; u++, buf += stride)
+                HDmemcpy(&bits[u], buf, sizeof(w));
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__conv_ieee_load() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_ieee_store
+ *
+ * Purpose:     Copy the IEEE values in BITS, in native byte order, to
+ *              NELMTS elements of BUF, STRIDE bytes apart, and set the
+ *              padding of the elements.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__conv_ieee_store(uint8_t *buf, size_t stride, const H5T_conv_ieee_t *layout, size_t nelmts,
+                     const uint64_t *bits)
+{
+    size_t hi_size = layout->size - (layout->pos + layout->width); /*bytes of padding after the value */
+    size_t u;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (4 == layout->width) {
+        uint8_t *p = buf + layout->pos;
+        uint32_t w;
+
+        if (layout->swap)
+            for (u = 0; u < nelmts; u++, p += stride) {
+                w = (uint32_t)bits[u];
+                w = H5T_CONV_BSWAP32(w);
+                HDmemcpy(p, &w, sizeof(w));
+            } /* end for */
+        else
+            for (u = 0; u < nelmts; u++, p += stride) {
+                w = (uint32_t)bits[u];
+                HDmemcpy(p, &w, sizeof(w));
+            } /* end for */
+    }         /* end if */
+    else {
+        uint8_t *p = buf + layout->pos;
+        uint64_t w;
+
+        if (layout->swap)
+            for (u = 0; u < nelmts; u++, p += stride) {
+                w = H5T_CONV_BSWAP64(bits[u]);
+                HDmemcpy(p, &w, sizeof(w));
+            } /* end for */
+        else
+            for (u = 0; u < nelmts; u++, p += stride)
+                HDmemcpy(p, &bits[u], sizeof(w));
+    } /* end else */
+
+    /* Set the padding */
+    if (layout->pos > 0 || hi_size > 0)
+        for (u = 0; u < nelmts; u++, buf += stride) {
+            HDmemset(buf, layout->lo_pad, layout->pos);
+            HDmemset(buf + layout->pos + layout->width, layout->hi_pad, hi_size);
+        } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__conv_ieee_store() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__conv_f_f_ieee
+ *
+ * Purpose:     Convert between IEEE 754 single and double precision values
+ *              that aren't both native, e.g. with a different byte order
+ *              or padding, with the hardware conversions between the native
+ *              types.  Values are converted a block at a time: they're
+ *              loaded into native byte order, converted and stored with the
+ *              destination's byte order and padding, which is much faster
+ *              than H5T__conv_f_f() working bit by bit.  The results are
+ *              those of converting the native types with the hard
+ *              conversion functions.
+ *
+ *              Conversions with an exception callback are passed on to
+ *              H5T__conv_f_f(), which reports the exceptions.
+ *
+ * Note:        This is a soft conversion function, recognizing the layouts
+ *              it can convert when the conversion path is initialized.  It
+ *              leaves conversions which only change the byte order of the
+ *              values to H5T__conv_order_opt().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_f_f_ieee(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, size_t buf_stride,
+                   size_t bkg_stride, void *_buf, void *bkg)
+{
+    uint8_t        *buf    = (uint8_t *)_buf;
+    H5T_t          *src    = NULL;
+    H5T_t          *dst    = NULL;
+    H5T_t          *native = NULL;                /*native float or double datatype */
+    H5T_conv_ieee_t src_layout;                   /*layout of the source values */
+    H5T_conv_ieee_t dst_layout;                   /*layout of the destination values */
+    H5T_conv_ieee_t native_layout;                /*layout of a native type */
+    H5T_conv_cb_t   cb_struct;                    /*conversion callback structure */
+    uint64_t        bits[H5T_CONV_IEEE_BLOCK];    /*values of a block of elements */
+    size_t          s_stride, d_stride;           /*source and destination strides */
+    hbool_t         backward;                     /*walk the buffer from the end? */
+    size_t          nconv;                        /*number of elements converted */
+    size_t          n;                            /*number of elements in a block */
+    size_t          u;                            /*local index variable */
+    herr_t          ret_value = SUCCEED;          /*return value */
+
+    FUNC_ENTER_PACKAGE
+
+    switch (cdata->command) {
+        case H5T_CONV_INIT:
+            if (NULL == (src = (H5T_t *)H5I_object(src_id)) || NULL == (dst = (H5T_t *)H5I_object(dst_id)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+            if (!H5T__conv_ieee_layout(src, &src_layout) || !H5T__conv_ieee_layout(dst, &dst_layout))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "conversion not supported")
+
+            /* Leave plain byte order conversions to H5T__conv_order_opt() */
+            if (src_layout.size == src_layout.width && dst_layout.size == dst_layout.width &&
+                src_layout.width == dst_layout.width)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "conversion not supported")
+
+            /* The native float and double types must be the IEEE types, without padding */
+            if (NULL == (native = (H5T_t *)H5I_object(H5T_NATIVE_FLOAT_g)) ||
+                !H5T__conv_ieee_layout(native, &native_layout) || native_layout.size != 4 ||
+                native_layout.width != 4 || native_layout.swap)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "conversion not supported")
+            if (NULL == (native = (H5T_t *)H5I_object(H5T_NATIVE_DOUBLE_g)) ||
+                !H5T__conv_ieee_layout(native, &native_layout) || native_layout.size != 8 ||
+                native_layout.width != 8 || native_layout.swap)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "conversion not supported")
+
+            cdata->need_bkg = H5T_BKG_NO;
+            break;
+
+        case H5T_CONV_CONV:
+            if (NULL == (src = (H5T_t *)H5I_object(src_id)) || NULL == (dst = (H5T_t *)H5I_object(dst_id)))
+                HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+            /* Get conversion exception callback property */
+            if (H5CX_get_dt_conv_cb(&cb_struct) < 0)
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "unable to get conversion exception callback")
+
+            /* Let the general conversion report the exceptions */
+            if (cb_struct.func) {
+                if (H5T__conv_f_f(src_id, dst_id, cdata, nelmts, buf_stride, bkg_stride, _buf, bkg) < 0)
+                    HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCONVERT, FAIL, "datatype conversion failed")
+                break;
+            } /* end if */
+
+            if (!H5T__conv_ieee_layout(src, &src_layout) || !H5T__conv_ieee_layout(dst, &dst_layout))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "conversion not supported")
+
+            /* Walk the buffer backward when the destination elements are
+             * larger, so each block's source elements are read before they're
+             * overwritten, as in the hard conversions */
+            if (buf_stride) {
+                s_stride = d_stride = buf_stride;
+                backward            = FALSE;
+            } /* end if */
+            else {
+                s_stride = src_layout.size;
+                d_stride = dst_layout.size;
+                backward = (hbool_t)(d_stride > s_stride);
+            } /* end else */
+
+            for (nconv = 0; nconv < nelmts; nconv += n) {
+                size_t start;
+
+                n     = MIN(nelmts - nconv, H5T_CONV_IEEE_BLOCK);
+                start = backward ? nelmts - (nconv + n) : nconv;
+
+                H5T__conv_ieee_load(buf + start * s_stride, s_stride, &src_layout, n, bits);
+                if (4 == src_layout.width && 8 == dst_layout.width)
+                    for (u = 0; u < n; u++) {
+                        uint32_t w = (uint32_t)bits[u];
+                        float    f;
+                        double   d;
+
+                        HDmemcpy(&f, &w, sizeof(f));
+                        d = (double)f;
+                        HDmemcpy(&bits[u], &d, sizeof(d));
+                    } /* end for */
+                else if (8 == src_layout.width && 4 == dst_layout.width) {
+                    const float pos_inf = H5T_NATIVE_FLOAT_POS_INF_g;
+                    const float neg_inf = H5T_NATIVE_FLOAT_NEG_INF_g;
+
+                    for (u = 0; u < n; u++) {
+                        uint32_t w;
+                        double   d;
+                        float    f;
+
+                        /* Same as H5T_CONV_Ff_NOEX_CORE */
+                        HDmemcpy(&d, &bits[u], sizeof(d));
+                        if (d > (double)FLT_MAX)
+                            f = pos_inf;
+                        else if (d < (double)-FLT_MAX)
+                            f = neg_inf;
+                        else
+                            f = (float)d;
+                        HDmemcpy(&w, &f, sizeof(w));
+                        bits[u] = w;
+                    } /* end for */
+                }     /* end if */
+                H5T__conv_ieee_store(buf + start * d_stride, d_stride, &dst_layout, n, bits);
+            } /* end for */
+            break;
+
+        case H5T_CONV_FREE:
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "unknown conversion command")
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_f_f_ieee() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__conv_s_s
  *
@@ -9524,7 +10495,21 @@ H5T_reclaim(hid_t type_id, H5S_t *space, void *buf)
     dset_op.op_type  = H5S_SEL_ITER_OP_LIB;
     dset_op.u.lib_op = H5T_reclaim_cb;
 
-    ret_value = H5S_select_iterate(buf, type, space, &dset_op, &vl_alloc_info);
+    /* VL data in an arena is released with the whole arena, so the buffer
+     * only needs to be walked to reclaim the references in it */
+    if (vl_alloc_info.alloc_func == H5T_vlen_arena_alloc) {
+        htri_t has_ref; /* Whether the datatype contains references */
+
+        if ((has_ref = H5T_detect_class(type, H5T_REFERENCE, FALSE)) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTGET, FAIL, "can't detect references in datatype")
+        if (has_ref && H5S_select_iterate(buf, type, space, &dset_op, &vl_alloc_info) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTFREE, FAIL, "can't reclaim references")
+        if (H5T_vlen_arena_release((H5T_vlen_arena_t *)vl_alloc_info.alloc_info) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTFREE, FAIL, "can't release VL data arena")
+        ret_value = SUCCEED;
+    } /* end if */
+    else
+        ret_value = H5S_select_iterate(buf, type, space, &dset_op, &vl_alloc_info);
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
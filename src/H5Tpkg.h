@@ -285,6 +285,9 @@ typedef herr_t (*H5T_vlen_write_func_t)(H5VL_object_t *file, const H5T_vlen_allo
                                         void *_vl, void *buf, void *_bg, size_t seq_len, size_t base_size);
 typedef herr_t (*H5T_vlen_delete_func_t)(H5VL_object_t *file, void *_vl);
 
+/* Callback for each sequence read by H5T__vlen_disk_read_many() */
+typedef herr_t (*H5T_vlen_read_op_t)(size_t u, const void *seq, size_t seq_len, void *op_data);
+
 /* VL datatype callbacks */
 typedef struct H5T_vlen_class_t {
     H5T_vlen_getlen_func_t  getlen;  /* Function to get VL sequence size (in element units, not bytes) */
@@ -506,6 +509,8 @@ H5_DLL herr_t H5T__conv_i_i(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size
                             size_t bkg_stride, void *_buf, void *bkg);
 H5_DLL herr_t H5T__conv_f_f(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, size_t buf_stride,
                             size_t bkg_stride, void *_buf, void *bkg);
+H5_DLL herr_t H5T__conv_f_f_ieee(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
+                                 size_t buf_stride, size_t bkg_stride, void *_buf, void *bkg);
 H5_DLL herr_t H5T__conv_f_i(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, size_t buf_stride,
                             size_t bkg_stride, void *_buf, void *bkg);
 H5_DLL herr_t H5T__conv_i_f(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts, size_t buf_stride,
@@ -846,9 +851,14 @@ H5_DLL hbool_t  H5T__bit_dec(uint8_t *buf, size_t start, size_t size);
 H5_DLL void     H5T__bit_neg(uint8_t *buf, size_t start, size_t size);
 
 /* VL functions */
-H5_DLL H5T_t *H5T__vlen_create(const H5T_t *base);
-H5_DLL herr_t H5T__vlen_reclaim(void *elem, const H5T_t *dt, H5T_vlen_alloc_info_t *alloc_info);
-H5_DLL htri_t H5T__vlen_set_loc(H5T_t *dt, H5VL_object_t *file, H5T_loc_t loc);
+H5_DLL H5T_t  *H5T__vlen_create(const H5T_t *base);
+H5_DLL herr_t  H5T__vlen_reclaim(void *elem, const H5T_t *dt, H5T_vlen_alloc_info_t *alloc_info);
+H5_DLL htri_t  H5T__vlen_set_loc(H5T_t *dt, H5VL_object_t *file, H5T_loc_t loc);
+H5_DLL hbool_t H5T__vlen_disk_is_native(const H5T_t *dt);
+H5_DLL herr_t  H5T__vlen_disk_read_many(H5VL_object_t *file, size_t nseq, const void *const vls[],
+                                        size_t base_size, H5T_vlen_read_op_t op, void *op_data);
+H5_DLL herr_t  H5T__vlen_disk_write_many(H5VL_object_t *file, size_t nseq, void *const vls[],
+                                         const void *const seqs[], const size_t seq_lens[], size_t base_size);
 
 /* Array functions */
 H5_DLL H5T_t *H5T__array_create(H5T_t *base, unsigned ndims, const hsize_t dim[/* ndims */]);
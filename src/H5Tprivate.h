@@ -76,6 +76,9 @@ typedef struct {
     void           *free_info;  /* Free information */
 } H5T_vlen_alloc_info_t;
 
+/* Arena holding the VL data read with a dataset transfer property list */
+typedef struct H5T_vlen_arena_t H5T_vlen_arena_t;
+
 /* Structure for conversion callback property */
 typedef struct H5T_conv_cb_t {
     H5T_conv_except_func_t func;
@@ -91,12 +94,47 @@ typedef enum {
     H5T_SUBSET_FALSE    = 0,  /* Source and destination aren't subset of each other */
     H5T_SUBSET_SRC,           /* Source is the subset of dest and no conversion is needed */
     H5T_SUBSET_DST,           /* Dest is the subset of source and no conversion is needed */
+    H5T_SUBSET_COPY,          /* No conversion is needed, but members move: use the copy spans */
     H5T_SUBSET_CAP            /* Must be the last value */
 } H5T_subset_t;
 
+/* A run of bytes which a compound conversion copies unchanged */
+typedef struct H5T_copy_span_t {
+    size_t src_off; /* Offset of the run in a source element */
+    size_t dst_off; /* Offset of the run in a destination element */
+    size_t len;     /* Length of the run, in bytes */
+} H5T_copy_span_t;
+
+/* Copy the spans of one element from SRC to DST.  Spans of the common member
+ * sizes are copied with fixed-size copies, which the compiler inlines.
+ */
+#define H5T_COPY_SPANS(DST, SRC, SPANS, NSPANS)                                                              \
+    do {                                                                                                     \
+        const H5T_copy_span_t *_span = (SPANS);                                                              \
+        size_t                 _n;                                                                           \
+                                                                                                             \
+        for (_n = 0; _n < (NSPANS); _n++, _span++)                                                           \
+            switch (_span->len) {                                                                            \
+                case 4:                                                                                      \
+                    HDmemcpy((DST) + _span->dst_off, (SRC) + _span->src_off, 4);                             \
+                    break;                                                                                   \
+                case 8:                                                                                      \
+                    HDmemcpy((DST) + _span->dst_off, (SRC) + _span->src_off, 8);                             \
+                    break;                                                                                   \
+                case 16:                                                                                     \
+                    HDmemcpy((DST) + _span->dst_off, (SRC) + _span->src_off, 16);                            \
+                    break;                                                                                   \
+                default:                                                                                     \
+                    HDmemcpy((DST) + _span->dst_off, (SRC) + _span->src_off, _span->len);                    \
+                    break;                                                                                   \
+            }                                                                                                \
+    } while (0)
+
 typedef struct H5T_subset_info_t {
-    H5T_subset_t subset;    /* See above */
-    size_t       copy_size; /* Size in bytes, to copy for each element */
+    H5T_subset_t     subset;    /* See above */
+    size_t           copy_size; /* Size in bytes, to copy for each element */
+    size_t           nspans;    /* Number of copy spans for each element */
+    H5T_copy_span_t *spans;     /* Members copied without conversion, merged into runs */
 } H5T_subset_info_t;
 
 /* Forward declarations for prototype arguments */
@@ -138,12 +176,20 @@ H5_DLL herr_t H5T_convert(H5T_path_t *tpath, hid_t src_id, hid_t dst_id, size_t
 H5_DLL herr_t H5T_reclaim(hid_t type_id, struct H5S_t *space, void *buf);
 H5_DLL herr_t H5T_reclaim_cb(void *elem, const H5T_t *dt, unsigned ndim, const hsize_t *point, void *op_data);
 H5_DLL herr_t H5T_vlen_reclaim_elmt(void *elem, H5T_t *dt);
+H5_DLL H5T_vlen_arena_t *H5T_vlen_arena_create(size_t block_size);
+H5_DLL herr_t            H5T_vlen_arena_incr(H5T_vlen_arena_t *arena);
+H5_DLL herr_t            H5T_vlen_arena_close(H5T_vlen_arena_t *arena);
+H5_DLL herr_t            H5T_vlen_arena_release(H5T_vlen_arena_t *arena);
+H5_DLL size_t            H5T_vlen_arena_block_size(const H5T_vlen_arena_t *arena);
+H5_DLL void             *H5T_vlen_arena_alloc(size_t size, void *arena);
+H5_DLL void              H5T_vlen_arena_free(void *mem, void *arena);
 H5_DLL htri_t H5T_set_loc(H5T_t *dt, H5VL_object_t *file, H5T_loc_t loc);
 H5_DLL htri_t H5T_is_sensible(const H5T_t *dt);
 H5_DLL uint32_t       H5T_hash(H5F_t *file, const H5T_t *dt);
 H5_DLL herr_t         H5T_set_version(H5F_t *f, H5T_t *dt);
 H5_DLL herr_t         H5T_patch_file(H5T_t *dt, H5F_t *f);
 H5_DLL herr_t         H5T_patch_vlen_file(H5T_t *dt, H5VL_object_t *file);
+H5_DLL herr_t         H5T_set_vlen_inline(H5T_t *dt);
 H5_DLL herr_t         H5T_own_vol_obj(H5T_t *dt, H5VL_object_t *vol_obj);
 H5_DLL htri_t         H5T_is_variable_str(const H5T_t *dt);
 H5_DLL H5T_t         *H5T_construct_datatype(H5VL_object_t *dt_obj);
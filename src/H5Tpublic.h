@@ -2730,6 +2730,11 @@ H5_DLL herr_t H5Tconvert(hid_t src_id, hid_t dst_id, size_t nelmts, void *buf, v
  *          allocation and/or free methods for the variable-length data in the
  *          buffer.
  *
+ *          If \p plist_id has an arena for variable-length data (see
+ *          H5Pset_vlen_arena()), H5Treclaim() releases all the
+ *          variable-length data in the arena at once, including the data of
+ *          other buffers read with \p plist_id.
+ *
  * \since 1.12.0
  *
  */
@@ -29,6 +29,8 @@
 #include "H5CXprivate.h" /* API Contexts         */
 #include "H5Eprivate.h"  /* Error handling       */
 #include "H5Fpkg.h"      /* File                 */
+#include "H5FLprivate.h" /* Free Lists           */
+#include "H5HGprivate.h" /* Global Heaps         */
 #include "H5Iprivate.h"  /* IDs                  */
 #include "H5MMprivate.h" /* Memory management    */
 #include "H5Tpkg.h"      /* Datatypes            */
@@ -38,10 +40,43 @@
 /* Local Macros */
 /****************/
 
+/* Largest alignment the VL arena gives an allocation */
+#define H5T_VLEN_ARENA_MAX_ALIGN 16
+
 /******************/
 /* Local Typedefs */
 /******************/
 
+/* A block of memory that VL arena allocations are carved from */
+typedef struct H5T_vlen_arena_block_t {
+    struct H5T_vlen_arena_block_t *next; /* Next (older) block in the arena */
+    uint8_t                       *base; /* First byte of the block's memory */
+    size_t                         size; /* Size of the block's memory */
+    size_t                         used; /* Bytes of the block's memory handed out */
+} H5T_vlen_arena_block_t;
+
+/* A disk-based VL sequence read by H5T__vlen_disk_read_many() */
+typedef struct H5T_vlen_disk_seq_t {
+    H5HG_t hobj;    /* Global heap ID of the sequence */
+    size_t seq_len; /* Number of elements in the sequence */
+    size_t u;       /* Index of the sequence in the batch */
+} H5T_vlen_disk_seq_t;
+
+/* User data for reading the sequences of a batch from the global heap */
+typedef struct H5T_vlen_read_many_ud_t {
+    const H5T_vlen_disk_seq_t *seqs;      /* Sequences, sorted by heap ID */
+    size_t                     base_size; /* Size of the sequences' base type */
+    H5T_vlen_read_op_t         op;        /* Callback for each sequence */
+    void                      *op_data;   /* Callback's user data */
+} H5T_vlen_read_many_ud_t;
+
+/* Arena for the VL data read with a dataset transfer property list */
+struct H5T_vlen_arena_t {
+    size_t                  block_size; /* Size of the arena's regular blocks */
+    unsigned                rc;         /* Number of property lists sharing the arena */
+    H5T_vlen_arena_block_t *head;       /* Block allocations are currently carved from */
+};
+
 /********************/
 /* Package Typedefs */
 /********************/
@@ -77,6 +112,18 @@ static herr_t H5T__vlen_disk_write(H5VL_object_t *file, const H5T_vlen_alloc_inf
                                    void *_buf, void *_bg, size_t seq_len, size_t base_size);
 static herr_t H5T__vlen_disk_delete(H5VL_object_t *file, void *_vl);
 
+/* Chunk-based VL sequence (and string) callbacks */
+static void  *H5T__vlen_chunk_getptr(void *_vl);
+static herr_t H5T__vlen_chunk_isnull(const H5VL_object_t *file, void *_vl, hbool_t *isnull);
+static herr_t H5T__vlen_chunk_setnull(H5VL_object_t *file, void *_vl, void *_bg);
+static herr_t H5T__vlen_chunk_read(H5VL_object_t *file, void *_vl, void *_buf, size_t len);
+static herr_t H5T__vlen_chunk_write(H5VL_object_t *file, const H5T_vlen_alloc_info_t *vl_alloc_info, void *_vl,
+                                    void *_buf, void *_bg, size_t seq_len, size_t base_size);
+
+/* Batched disk-based VL sequence helpers */
+static int    H5T__vlen_disk_seq_cmp(const void *_seq1, const void *_seq2);
+static herr_t H5T__vlen_disk_read_many_cb(const void *obj, size_t obj_size, size_t u, void *_udata);
+
 /*********************/
 /* Public Variables */
 /*********************/
@@ -93,6 +140,9 @@ static herr_t H5T__vlen_disk_delete(H5VL_object_t *file, void *_vl);
 /* Local Variables */
 /*******************/
 
+/* Declare a free list to manage the H5T_vlen_arena_t struct */
+H5FL_DEFINE_STATIC(H5T_vlen_arena_t);
+
 /* Class for VL sequences in memory */
 static const H5T_vlen_class_t H5T_vlen_mem_seq_g = {
     H5T__vlen_mem_seq_getlen,  /* 'getlen' */
@@ -126,6 +176,18 @@ static const H5T_vlen_class_t H5T_vlen_disk_g = {
     H5T__vlen_disk_delete   /* 'delete' */
 };
 
+/* Class for VL strings and sequences stored inline in the chunks of a
+ * dataset, while the chunk is in memory (see H5Zvlen.c) */
+static const H5T_vlen_class_t H5T_vlen_chunk_g = {
+    H5T__vlen_disk_getlen,   /* 'getlen' */
+    H5T__vlen_chunk_getptr,  /* 'getptr' */
+    H5T__vlen_chunk_isnull,  /* 'isnull' */
+    H5T__vlen_chunk_setnull, /* 'setnull' */
+    H5T__vlen_chunk_read,    /* 'read' */
+    H5T__vlen_chunk_write,   /* 'write' */
+    NULL                     /* 'delete' */
+};
+
 /*-------------------------------------------------------------------------
  * Function:	H5Tvlen_create
  *
@@ -989,6 +1051,427 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5T__vlen_disk_delete() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_chunk_getptr
+ *
+ * Purpose:     Retrieves the pointer to the sequence of a VL element
+ *              stored inline in a chunk.  The chunk code turns the offsets
+ *              of the sequences in the chunk into pointers while the chunk
+ *              is locked for I/O, which is when the element is accessed.
+ *
+ * Return:      Pointer to the sequence (NULL for a "nil" element)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5T__vlen_chunk_getptr(void *_vl)
+{
+    void *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Check parameters */
+    HDassert(_vl);
+
+    /* The pointer follows the length of the sequence */
+    H5MM_memcpy(&ret_value, (uint8_t *)_vl + 4, sizeof(void *));
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_chunk_getptr() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_chunk_isnull
+ *
+ * Purpose:     Checks if a VL element stored inline in a chunk is "nil"
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_chunk_isnull(const H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, hbool_t *isnull)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Check parameters */
+    HDassert(_vl);
+    HDassert(isnull);
+
+    *isnull = (NULL == H5T__vlen_chunk_getptr(_vl));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_chunk_isnull() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_chunk_setnull
+ *
+ * Purpose:     Sets a VL element stored inline in a chunk to the "nil"
+ *              value.  The memory of the old sequence belongs to the
+ *              chunk, so nothing is freed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_chunk_setnull(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void H5_ATTR_UNUSED *_bg)
+{
+    uint8_t *vl  = (uint8_t *)_vl; /* Pointer to the element */
+    void    *seq = NULL;           /* "Nil" sequence */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Check parameters */
+    HDassert(vl);
+
+    /* Set the length and the pointer of the sequence */
+    UINT32ENCODE(vl, 0);
+    H5MM_memcpy(vl, &seq, sizeof(void *));
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_chunk_setnull() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_chunk_read
+ *
+ * Purpose:     Reads a VL element stored inline in a chunk into a buffer
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_chunk_read(H5VL_object_t H5_ATTR_UNUSED *file, void *_vl, void *buf, size_t len)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Check parameters */
+    HDassert(_vl);
+    HDassert(buf);
+
+    if (len > 0)
+        H5MM_memcpy(buf, H5T__vlen_chunk_getptr(_vl), len);
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T__vlen_chunk_read() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_chunk_write
+ *
+ * Purpose:     Writes a VL element stored inline in a chunk from a
+ *              buffer.  The sequence is copied into memory from the VL
+ *              allocation routine, which the chunk code sets to an arena
+ *              that lives until the chunk has gathered its sequences.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_chunk_write(H5VL_object_t H5_ATTR_UNUSED *file, const H5T_vlen_alloc_info_t *vl_alloc_info,
+                      void *_vl, void *buf, void H5_ATTR_UNUSED *_bg, size_t seq_len, size_t base_size)
+{
+    uint8_t *vl = (uint8_t *)_vl; /* Pointer to the element */
+    void    *seq;                 /* Copy of the sequence */
+    size_t   len;                 /* Size of the sequence */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check parameters */
+    HDassert(vl);
+    HDassert(seq_len == 0 || buf);
+    HDassert(vl_alloc_info);
+
+    if (seq_len > (size_t)UINT32_MAX)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_OVERFLOW, FAIL, "VL sequence is too long")
+
+    /* Copy the sequence (allocating a byte for empty sequences, so they aren't "nil") */
+    len = seq_len * base_size;
+    if (NULL != vl_alloc_info->alloc_func)
+        seq = (*vl_alloc_info->alloc_func)(MAX(len, 1), vl_alloc_info->alloc_info);
+    else
+        seq = H5MM_malloc(MAX(len, 1));
+    if (NULL == seq)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL data")
+    if (len > 0)
+        H5MM_memcpy(seq, buf, len);
+
+    /* Set the length and the pointer of the sequence */
+    UINT32ENCODE(vl, seq_len);
+    H5MM_memcpy(vl, &seq, sizeof(void *));
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_chunk_write() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_set_vlen_inline
+ *
+ * Purpose:     Makes a disk-based VL datatype access its sequences inline
+ *              in the chunks of a dataset, for datasets that use the
+ *              inline variable-length data filter.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_set_vlen_inline(H5T_t *dt)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check parameters */
+    HDassert(dt);
+
+    if (H5T_VLEN != dt->shared->type || H5T_LOC_DISK != dt->shared->u.vlen.loc)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_BADTYPE, FAIL, "not a disk-based VL datatype")
+    if (dt->shared->size < 4 + sizeof(void *))
+        HGOTO_ERROR(H5E_DATATYPE, H5E_BADSIZE, FAIL, "VL datatype is too small to hold a pointer")
+
+    dt->shared->u.vlen.cls = &H5T_vlen_chunk_g;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_set_vlen_inline() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_disk_is_native
+ *
+ * Purpose:     Checks if a VL datatype describes sequences stored in the
+ *              global heap of a file that is accessed directly through the
+ *              native VOL connector, so that batches of them can be read
+ *              and written with H5T__vlen_disk_read_many() and
+ *              H5T__vlen_disk_write_many().
+ *
+ * Return:      TRUE/FALSE (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5T__vlen_disk_is_native(const H5T_t *dt)
+{
+    const H5VL_object_t *file;              /* VOL object for the file */
+    hbool_t              ret_value = FALSE; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(dt);
+    HDassert(H5T_VLEN == dt->shared->type);
+
+    file = dt->shared->u.vlen.file;
+    if (H5T_LOC_DISK == dt->shared->u.vlen.loc && &H5T_vlen_disk_g == dt->shared->u.vlen.cls && file &&
+        H5_VOL_NATIVE == file->connector->cls->value)
+        ret_value = TRUE;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_is_native() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_disk_seq_cmp
+ *
+ * Purpose:     Compares two disk-based VL sequences by their global heap
+ *              ID, for sorting with HDqsort.  "Nil" sequences sort first.
+ *
+ * Return:      -1, 0 or 1, like strcmp
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5T__vlen_disk_seq_cmp(const void *_seq1, const void *_seq2)
+{
+    const H5T_vlen_disk_seq_t *seq1 = (const H5T_vlen_disk_seq_t *)_seq1; /* First sequence */
+    const H5T_vlen_disk_seq_t *seq2 = (const H5T_vlen_disk_seq_t *)_seq2; /* Second sequence */
+
+    if (seq1->hobj.addr != seq2->hobj.addr)
+        return (seq1->hobj.addr < seq2->hobj.addr ? -1 : 1);
+    if (seq1->hobj.idx != seq2->hobj.idx)
+        return (seq1->hobj.idx < seq2->hobj.idx ? -1 : 1);
+    return 0;
+} /* end H5T__vlen_disk_seq_cmp() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_disk_read_many_cb
+ *
+ * Purpose:     H5HG_read_many() callback, which passes the sequence read
+ *              from the global heap on to the caller's callback.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5T__vlen_disk_read_many_cb(const void *obj, size_t obj_size, size_t u, void *_udata)
+{
+    H5T_vlen_read_many_ud_t   *udata     = (H5T_vlen_read_many_ud_t *)_udata; /* User data */
+    const H5T_vlen_disk_seq_t *seq       = &udata->seqs[u];                   /* Sequence read */
+    herr_t                     ret_value = SUCCEED;                           /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Verify the size is correct */
+    if (obj_size != seq->seq_len * udata->base_size)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CANTDECODE, FAIL, "Expected global heap object size does not match")
+
+    if ((udata->op)(seq->u, obj, seq->seq_len, udata->op_data) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_CALLBACK, FAIL, "VL sequence callback failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_read_many_cb() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_disk_read_many
+ *
+ * Purpose:     Reads a batch of NSEQ disk-based VL sequences, whose disk
+ *              information is at VLS[U], from a file accessed through the
+ *              native VOL connector.
+ *
+ *              The heap IDs of all the sequences are decoded before
+ *              anything else, so OP may overwrite the sequences' disk
+ *              information.  The sequences are then read from the global
+ *              heap in address order, each collection being accessed once,
+ *              and OP is called for each of them, with a pointer to its
+ *              data, which is only valid during the call.  OP is called
+ *              with a NULL pointer for "nil" sequences.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__vlen_disk_read_many(H5VL_object_t *file, size_t nseq, const void *const vls[], size_t base_size,
+                         H5T_vlen_read_op_t op, void *op_data)
+{
+    H5F_t                  *f;                   /* File for the global heap */
+    H5T_vlen_disk_seq_t    *seqs  = NULL;        /* Sequences to read */
+    H5HG_t                 *hobjs = NULL;        /* Global heap IDs of the sequences, in order */
+    H5T_vlen_read_many_ud_t udata;               /* User data for the global heap callback */
+    size_t                  nnil = 0;            /* Number of "nil" sequences */
+    size_t                  u;                   /* Local index variable */
+    herr_t                  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check parameters */
+    HDassert(file);
+    HDassert(nseq == 0 || vls);
+    HDassert(op);
+
+    if (0 == nseq)
+        HGOTO_DONE(SUCCEED)
+
+    /* Retrieve file from VOL object */
+    if (NULL == (f = (H5F_t *)H5VL_object_data(file)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid VOL object")
+
+    if (NULL == (seqs = (H5T_vlen_disk_seq_t *)H5MM_malloc(nseq * sizeof(H5T_vlen_disk_seq_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL sequences")
+    if (NULL == (hobjs = (H5HG_t *)H5MM_malloc(nseq * sizeof(H5HG_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL heap IDs")
+
+    /* Decode the length and heap ID of each sequence */
+    for (u = 0; u < nseq; u++) {
+        const uint8_t *p = (const uint8_t *)vls[u]; /* Pointer into the sequence's disk information */
+
+        UINT32DECODE(p, seqs[u].seq_len);
+        H5F_addr_decode(f, &p, &seqs[u].hobj.addr);
+        UINT32DECODE(p, seqs[u].hobj.idx);
+        seqs[u].u = u;
+        if (0 == seqs[u].hobj.addr)
+            nnil++;
+    } /* end for */
+
+    /* Sort the sequences by heap ID, which puts the "nil" sequences first
+     * and groups the others by collection */
+    HDqsort(seqs, nseq, sizeof(H5T_vlen_disk_seq_t), H5T__vlen_disk_seq_cmp);
+
+    for (u = 0; u < nnil; u++)
+        if ((op)(seqs[u].u, NULL, (size_t)0, op_data) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CALLBACK, FAIL, "VL sequence callback failed")
+
+    /* Read the other sequences, one collection at a time */
+    for (u = nnil; u < nseq; u++)
+        hobjs[u - nnil] = seqs[u].hobj;
+    udata.seqs      = seqs + nnil;
+    udata.base_size = base_size;
+    udata.op        = op;
+    udata.op_data   = op_data;
+    if (H5HG_read_many(f, nseq - nnil, hobjs, H5T__vlen_disk_read_many_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_READERROR, FAIL, "can't read VL data")
+
+done:
+    H5MM_xfree(hobjs);
+    H5MM_xfree(seqs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_read_many() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__vlen_disk_write_many
+ *
+ * Purpose:     Writes a batch of NSEQ VL sequences to the global heap of a
+ *              file accessed through the native VOL connector, packing
+ *              them into as few collections as possible.  Sequence U has
+ *              SEQ_LENS[U] elements of BASE_SIZE bytes at SEQS[U], and its
+ *              disk information is encoded at VLS[U].
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__vlen_disk_write_many(H5VL_object_t *file, size_t nseq, void *const vls[], const void *const seqs[],
+                          const size_t seq_lens[], size_t base_size)
+{
+    H5F_t  *f;                   /* File for the global heap */
+    H5HG_t *hobjs = NULL;        /* Global heap IDs of the sequences */
+    size_t *sizes = NULL;        /* Sizes of the sequences, in bytes */
+    size_t  u;                   /* Local index variable */
+    herr_t  ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check parameters */
+    HDassert(file);
+    HDassert(nseq == 0 || (vls && seqs && seq_lens));
+
+    if (0 == nseq)
+        HGOTO_DONE(SUCCEED)
+
+    /* Retrieve file from VOL object */
+    if (NULL == (f = (H5F_t *)H5VL_object_data(file)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid VOL object")
+
+    if (NULL == (hobjs = (H5HG_t *)H5MM_malloc(nseq * sizeof(H5HG_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL heap IDs")
+    if (NULL == (sizes = (size_t *)H5MM_malloc(nseq * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, FAIL, "memory allocation failed for VL sizes")
+    for (u = 0; u < nseq; u++)
+        sizes[u] = seq_lens[u] * base_size;
+
+    /* Store the sequences */
+    if (H5HG_insert_many(f, nseq, sizes, seqs, hobjs) < 0)
+        HGOTO_ERROR(H5E_DATATYPE, H5E_WRITEERROR, FAIL, "unable to write VL data")
+
+    /* Encode the length and heap ID of each sequence */
+    for (u = 0; u < nseq; u++) {
+        uint8_t *p = (uint8_t *)vls[u]; /* Pointer into the sequence's disk information */
+
+        UINT32ENCODE(p, seq_lens[u]);
+        H5F_addr_encode(f, &p, hobjs[u].addr);
+        UINT32ENCODE(p, hobjs[u].idx);
+    } /* end for */
+
+done:
+    H5MM_xfree(sizes);
+    H5MM_xfree(hobjs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__vlen_disk_write_many() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5T__vlen_reclaim
  *
@@ -1151,3 +1634,233 @@ H5T_vlen_reclaim_elmt(void *elem, H5T_t *dt)
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5T_vlen_reclaim_elmt() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_create
+ *
+ * Purpose:     Creates an arena for the VL data read with a dataset
+ *              transfer property list.  The arena hands out memory from
+ *              blocks of BLOCK_SIZE bytes (larger requests get a block of
+ *              their own) and releases all of it at once.
+ *
+ * Return:      Success:    Pointer to the new arena
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+H5T_vlen_arena_t *
+H5T_vlen_arena_create(size_t block_size)
+{
+    H5T_vlen_arena_t *arena     = NULL; /* New arena */
+    H5T_vlen_arena_t *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(block_size > 0);
+
+    if (NULL == (arena = H5FL_MALLOC(H5T_vlen_arena_t)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_CANTALLOC, NULL, "memory allocation failed for VL arena")
+    arena->block_size = block_size;
+    arena->rc         = 1;
+    arena->head       = NULL;
+
+    ret_value = arena;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_create() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_incr
+ *
+ * Purpose:     Adds a reference to an arena, for another property list
+ *              that shares it.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_incr(H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+    HDassert(arena->rc > 0);
+
+    arena->rc++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_incr() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_close
+ *
+ * Purpose:     Removes a reference to an arena, releasing the arena and
+ *              all the memory it handed out when the last one is removed.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_close(H5T_vlen_arena_t *arena)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(arena);
+    HDassert(arena->rc > 0);
+
+    if (--arena->rc == 0) {
+        if (H5T_vlen_arena_release(arena) < 0)
+            HGOTO_ERROR(H5E_DATATYPE, H5E_CANTFREE, FAIL, "can't release VL arena memory")
+        arena = H5FL_FREE(H5T_vlen_arena_t, arena);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_close() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_release
+ *
+ * Purpose:     Releases all the memory an arena has handed out, leaving
+ *              the arena empty and ready for reuse.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T_vlen_arena_release(H5T_vlen_arena_t *arena)
+{
+    H5T_vlen_arena_block_t *block; /* Block to release */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    while (NULL != (block = arena->head)) {
+        arena->head = block->next;
+        H5MM_xfree(block);
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5T_vlen_arena_release() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_block_size
+ *
+ * Purpose:     Retrieves the size of an arena's regular blocks.
+ *
+ * Return:      Size of the arena's blocks (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5T_vlen_arena_block_size(const H5T_vlen_arena_t *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    FUNC_LEAVE_NOAPI(arena->block_size)
+} /* end H5T_vlen_arena_block_size() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_alloc
+ *
+ * Purpose:     VL allocation callback which carves SIZE bytes out of the
+ *              arena in _ARENA.
+ *
+ *              The memory is aligned to the largest power of two that
+ *              divides SIZE (up to H5T_VLEN_ARENA_MAX_ALIGN), which is
+ *              enough for any sequence of SIZE bytes of a datatype whose
+ *              alignment divides its size, while still packing strings
+ *              tightly.
+ *
+ * Return:      Success:    Pointer to the memory
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5T_vlen_arena_alloc(size_t size, void *_arena)
+{
+    H5T_vlen_arena_t       *arena     = (H5T_vlen_arena_t *)_arena; /* Arena to allocate from */
+    H5T_vlen_arena_block_t *block     = arena->head;                /* Block to allocate from */
+    size_t                  align;                                  /* Alignment of the memory */
+    size_t                  pad       = 0;                          /* Padding to align the memory */
+    void                   *ret_value = NULL;                       /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(arena);
+
+    /* Always hand out distinct memory */
+    if (size == 0)
+        size = 1;
+    align = size & (~size + 1);
+    if (align > H5T_VLEN_ARENA_MAX_ALIGN)
+        align = H5T_VLEN_ARENA_MAX_ALIGN;
+
+    /* Carve the memory out of the current block, if it fits */
+    if (block) {
+        pad = (size_t)(-(uintptr_t)(block->base + block->used)) & (align - 1);
+        if (block->size - block->used < pad + size)
+            block = NULL;
+    } /* end if */
+
+    /* Start a new block otherwise */
+    if (NULL == block) {
+        size_t block_size = arena->block_size; /* Size of the new block's memory */
+
+        /* Requests larger than half a block get a block of their own, so
+         * the current block remains in use for the requests that follow */
+        if (size > block_size / 2)
+            block_size = size;
+        if (NULL == (block = (H5T_vlen_arena_block_t *)H5MM_malloc(sizeof(H5T_vlen_arena_block_t) +
+                                                                     block_size + H5T_VLEN_ARENA_MAX_ALIGN)))
+            HGOTO_DONE(NULL)
+        block->base = (uint8_t *)(block + 1);
+        block->size = block_size + H5T_VLEN_ARENA_MAX_ALIGN;
+        block->used = 0;
+        pad         = (size_t)(-(uintptr_t)block->base) & (align - 1);
+
+        if (block_size == arena->block_size || NULL == arena->head) {
+            block->next = arena->head;
+            arena->head = block;
+        } /* end if */
+        else {
+            block->next       = arena->head->next;
+            arena->head->next = block;
+        } /* end else */
+    }     /* end if */
+
+    ret_value = block->base + block->used + pad;
+    block->used += pad + size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T_vlen_arena_alloc() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T_vlen_arena_free
+ *
+ * Purpose:     VL free callback for memory from an arena, which does
+ *              nothing: the memory is released with the rest of the
+ *              arena's memory by H5T_vlen_arena_release().
+ *
+ * Return:      none
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5T_vlen_arena_free(void H5_ATTR_UNUSED *mem, void H5_ATTR_UNUSED *arena)
+{
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T_vlen_arena_free() */
@@ -88,11 +88,18 @@ H5Z_init(void)
     if (H5_TERM_GLOBAL)
         HGOTO_DONE(SUCCEED)
 
+    /* Pool of filter buffers */
+    H5Z__buf_init();
+
     /* Internal filters */
     if (H5Z_register(H5Z_SHUFFLE) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register shuffle filter")
     if (H5Z_register(H5Z_FLETCHER32) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register fletcher32 filter")
+    if (H5Z_register(H5Z_CRC32C) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register crc32c filter")
+    if (H5Z_register(H5Z_VLEN) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register vlen filter")
     if (H5Z_register(H5Z_NBIT) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register nbit filter")
     if (H5Z_register(H5Z_SCALEOFFSET) < 0)
@@ -100,6 +107,7 @@ H5Z_init(void)
 
         /* External filters */
 #ifdef H5_HAVE_FILTER_DEFLATE
+    H5Z__deflate_init();
     if (H5Z_register(H5Z_DEFLATE) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register deflate filter")
 #endif /* H5_HAVE_FILTER_DEFLATE */
@@ -188,6 +196,14 @@ next:
     }         /* end if */
 #endif        /* H5Z_DEBUG */
 
+#ifdef H5_HAVE_FILTER_DEFLATE
+    /* Release the idle streams of the deflate filter */
+    n += H5Z__deflate_term();
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    /* Release the idle filter buffers */
+    n += H5Z__buf_term();
+
     /* Free the table of filters */
     if (H5Z_table_g) {
         H5Z_table_g = (H5Z_class2_t *)H5MM_xfree(H5Z_table_g);
@@ -988,7 +1004,8 @@ done:
  *      When the filters are optional (i.e., H5Z_FLAG_OPTIONAL is provided,)
  *      if any of the following conditions is met, the filters will be ignored:
  *          - dataspace is either H5S_NULL or H5S_SCALAR
- *          - datatype is variable-length (string or non-string)
+ *          - datatype is variable-length (string or non-string), unless
+ *            the first filter stores the variable-length data inline
  *      However, if any of these conditions exists and a filter is not
  *      optional, the function will produce an error.
  *
@@ -1021,8 +1038,10 @@ H5Z_ignore_filters(hid_t dcpl_id, const H5T_t *type, const H5S_t *space)
     type_class  = H5T_get_class(type, FALSE);
 
     /* These conditions are not suitable for filters */
-    bad_for_filters = (H5S_NULL == space_class || H5S_SCALAR == space_class || H5T_VLEN == type_class ||
-                       (H5T_STRING == type_class && TRUE == H5T_is_variable_str(type)));
+    bad_for_filters =
+        (H5S_NULL == space_class || H5S_SCALAR == space_class ||
+         ((H5T_VLEN == type_class || (H5T_STRING == type_class && TRUE == H5T_is_variable_str(type))) &&
+          !(pline.nused > 0 && H5Z_FILTER_VLEN == pline.filter[0].id)));
 
     /* When these conditions occur, if there are required filters in pline,
        then report a failure, otherwise, set flag that they can be ignored */
@@ -1564,6 +1583,62 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z_all_filters_avail() */
 
+/*-------------------------------------------------------------------------
+ * Function: H5Z_pipeline_thread_safe
+ *
+ * Purpose:  Check whether the filters in a pipeline may be run on several
+ *           buffers at once from different threads.  This is only known
+ *           to be the case for the filters built into the library, so any
+ *           pipeline that contains an application-defined or plugin
+ *           filter (or a built-in filter ID that has been re-registered
+ *           by the application) is reported as not thread-safe.
+ *
+ * Return:   TRUE/FALSE
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5Z_pipeline_thread_safe(const H5O_pline_t *pline)
+{
+    size_t  u;                /* Local index variable */
+    hbool_t ret_value = TRUE; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOERR
+
+    /* Check args */
+    HDassert(pline);
+
+#ifdef H5Z_DEBUG
+    /* The per-filter statistics are not protected against concurrent updates */
+    HGOTO_DONE(FALSE)
+#endif /* H5Z_DEBUG */
+
+    for (u = 0; u < pline->nused; u++) {
+        const H5Z_class2_t *fclass; /* Registered class for filter */
+        int                 fclass_idx;
+
+        /* Filters that would need to be loaded dynamically are not safe */
+        if ((fclass_idx = H5Z__find_idx(pline->filter[u].id)) < 0)
+            HGOTO_DONE(FALSE)
+        fclass = &H5Z_table_g[fclass_idx];
+
+        /* Compare against the library's own filter callbacks */
+        if (fclass->filter != H5Z_SHUFFLE->filter && fclass->filter != H5Z_FLETCHER32->filter &&
+            fclass->filter != H5Z_CRC32C->filter && fclass->filter != H5Z_NBIT->filter &&
+            fclass->filter != H5Z_SCALEOFFSET->filter && fclass->filter != H5Z_VLEN->filter
+#ifdef H5_HAVE_FILTER_DEFLATE
+            && fclass->filter != H5Z_DEFLATE->filter
+#endif /* H5_HAVE_FILTER_DEFLATE */
+#ifdef H5_HAVE_FILTER_SZIP
+            && fclass->filter != H5Z_SZIP->filter
+#endif /* H5_HAVE_FILTER_SZIP */
+        )
+            HGOTO_DONE(FALSE)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_thread_safe() */
+
 /*-------------------------------------------------------------------------
  * Function: H5Z_delete
  *
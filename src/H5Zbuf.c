@@ -0,0 +1,453 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     A pool of the buffers that chunks pass through on their way
+ *              through the filter pipeline: the buffers the chunk cache
+ *              reads filtered chunks into and keeps decoded chunks in, and
+ *              the output buffers of the library's filters.
+ *
+ *              The buffers are allocated with H5MM_malloc() and have no
+ *              header, so they can be passed to third-party filters,
+ *              which may release or reallocate them.  Whoever releases a
+ *              buffer to the pool gives a size the buffer is known to
+ *              hold, which is all the pool knows of it.  Idle buffers are
+ *              kept in size classes, four to each power of two, and
+ *              remember their sizes while they are idle, so that a
+ *              request is served from its own class by a buffer known to
+ *              be large enough, or from the next class up.
+ *
+ *              The pool is shared by the whole process.  It holds at most
+ *              H5Z_BUF_POOL_LIMIT bytes, classes no buffer is taken from
+ *              are emptied over time, and H5garbage_collect() empties the
+ *              pool.
+ */
+
+/****************/
+/* Module Setup */
+/****************/
+
+#include "H5Zmodule.h" /* This source code file is part of the H5Z module */
+
+/***********/
+/* Headers */
+/***********/
+#include "H5private.h"   /* Generic Functions                        */
+#include "H5Eprivate.h"  /* Error handling                           */
+#include "H5Iprivate.h"  /* IDs                                      */
+#include "H5MMprivate.h" /* Memory management                        */
+#include "H5VMprivate.h" /* Vectors and arrays                       */
+#include "H5Zpkg.h"      /* Data filters                             */
+
+/****************/
+/* Local Macros */
+/****************/
+
+/* Smallest buffer kept in the pool (a power of two), smaller ones are
+ * left to malloc() */
+#define H5Z_BUF_POOL_MIN_LOG2 12
+#define H5Z_BUF_POOL_MIN      ((size_t)1 << H5Z_BUF_POOL_MIN_LOG2)
+
+/* Number of size classes, from H5Z_BUF_POOL_MIN to H5Z_BUF_POOL_LIMIT */
+#define H5Z_BUF_POOL_NCLASSES (4 * (H5Z_BUF_POOL_LIMIT_LOG2 - H5Z_BUF_POOL_MIN_LOG2 + 1))
+
+/* Most idle buffers of a class looked at for one large enough */
+#define H5Z_BUF_POOL_SCAN 8
+
+/* Number of buffers taken from or given to the pool between the times the
+ * classes no buffer was taken from since the last time are emptied by half */
+#define H5Z_BUF_POOL_DECAY 1024
+
+#ifdef H5_HAVE_THREADSAFE
+#define H5Z_BUF_POOL_LOCK   H5TS_mutex_lock_simple(&H5Z_buf_pool_mutex_g)
+#define H5Z_BUF_POOL_UNLOCK H5TS_mutex_unlock_simple(&H5Z_buf_pool_mutex_g)
+#else
+#define H5Z_BUF_POOL_LOCK
+#define H5Z_BUF_POOL_UNLOCK
+#endif /* H5_HAVE_THREADSAFE */
+
+/******************/
+/* Local Typedefs */
+/******************/
+
+/* Header written at the start of an idle buffer */
+typedef struct H5Z_buf_idle_t {
+    struct H5Z_buf_idle_t *next; /* Next idle buffer in the class */
+    size_t                 size; /* Size the buffer is known to hold */
+} H5Z_buf_idle_t;
+
+/* Idle buffers of a size class */
+typedef struct H5Z_buf_class_t {
+    H5Z_buf_idle_t *head;  /* Idle buffers, most recently released first */
+    size_t          nbufs; /* Number of idle buffers */
+    uint64_t        tick;  /* Operation of the pool a buffer was last taken by */
+    hbool_t         taken; /* Whether a buffer was taken since the last decay */
+} H5Z_buf_class_t;
+
+/********************/
+/* Local Prototypes */
+/********************/
+
+static unsigned H5Z__buf_class(size_t size);
+static size_t   H5Z__buf_class_release(H5Z_buf_class_t *cls, size_t nbufs);
+static void     H5Z__buf_pool_decay(void);
+
+/*********************/
+/* Package Variables */
+/*********************/
+
+/*****************************/
+/* Library Private Variables */
+/*****************************/
+
+/*******************/
+/* Local Variables */
+/*******************/
+
+/* The pool */
+static H5Z_buf_class_t H5Z_buf_pool_g[H5Z_BUF_POOL_NCLASSES];
+static size_t          H5Z_buf_pool_nbytes_g = 0; /* Bytes the idle buffers are known to hold */
+static uint64_t        H5Z_buf_pool_tick_g   = 0; /* Operations of the pool so far */
+
+#ifdef H5_HAVE_THREADSAFE
+/* Lock for the pool, initialized when the library first sets up its filters */
+static H5TS_mutex_simple_t H5Z_buf_pool_mutex_g;
+static hbool_t             H5Z_buf_pool_mutex_init_g = FALSE;
+#endif /* H5_HAVE_THREADSAFE */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__buf_init
+ *
+ * Purpose:     Set up the pool of filter buffers.
+ *
+ * Note:        Called when the library sets up its filters, before any
+ *              filter can run on another thread.
+ *
+ * Return:      none
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__buf_init(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5_HAVE_THREADSAFE
+    if (!H5Z_buf_pool_mutex_init_g) {
+        (void)H5TS_mutex_init(&H5Z_buf_pool_mutex_g);
+        H5Z_buf_pool_mutex_init_g = TRUE;
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__buf_init() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__buf_term
+ *
+ * Purpose:     Release the idle buffers in the pool, and the lock for the
+ *              pool.
+ *
+ * Note:        Called when the library shuts down its filters, after all
+ *              the files are closed, so no filter can be running.
+ *
+ * Return:      Number of buffers released (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+H5Z__buf_term(void)
+{
+    unsigned u;     /* Local index variable */
+    int      n = 0; /* Number of buffers released */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    for (u = 0; u < H5Z_BUF_POOL_NCLASSES; u++)
+        n += (int)H5Z__buf_class_release(&H5Z_buf_pool_g[u], H5Z_buf_pool_g[u].nbufs);
+
+#ifdef H5_HAVE_THREADSAFE
+    if (H5Z_buf_pool_mutex_init_g) {
+        (void)H5TS_mutex_destroy(&H5Z_buf_pool_mutex_g);
+        H5Z_buf_pool_mutex_init_g = FALSE;
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI(n)
+} /* end H5Z__buf_term() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__buf_class
+ *
+ * Purpose:     Compute the size class of buffers of SIZE bytes, which must
+ *              be between H5Z_BUF_POOL_MIN and H5Z_BUF_POOL_LIMIT.  Each
+ *              power of two is split into four classes, so any buffer in a
+ *              class is large enough for any request of the class below.
+ *
+ * Return:      Index of the class (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5Z__buf_class(size_t size)
+{
+    unsigned log2; /* Log2 of the size, rounded down */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    log2 = H5VM_log2_gen((uint64_t)size);
+
+    FUNC_LEAVE_NOAPI((log2 - H5Z_BUF_POOL_MIN_LOG2) * 4 + (unsigned)((size >> (log2 - 2)) & 3))
+} /* end H5Z__buf_class() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__buf_class_release
+ *
+ * Purpose:     Release up to NBUFS idle buffers from CLS.  The pool must
+ *              be locked.
+ *
+ * Return:      Number of buffers released (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__buf_class_release(H5Z_buf_class_t *cls, size_t nbufs)
+{
+    size_t n = 0; /* Number of buffers released */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    while (n < nbufs && cls->head) {
+        H5Z_buf_idle_t *idle = cls->head;
+
+        cls->head = idle->next;
+        H5Z_buf_pool_nbytes_g -= idle->size;
+        H5MM_xfree(idle);
+        n++;
+    } /* end while */
+    cls->nbufs -= n;
+
+    FUNC_LEAVE_NOAPI(n)
+} /* end H5Z__buf_class_release() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__buf_pool_decay
+ *
+ * Purpose:     Release half the idle buffers of each class no buffer was
+ *              taken from since the last call, so that buffers the
+ *              application no longer needs go back to the system.  The
+ *              pool must be locked.
+ *
+ * Return:      none
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__buf_pool_decay(void)
+{
+    unsigned u; /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    for (u = 0; u < H5Z_BUF_POOL_NCLASSES; u++) {
+        H5Z_buf_class_t *cls = &H5Z_buf_pool_g[u];
+
+        if (!cls->taken)
+            (void)H5Z__buf_class_release(cls, (cls->nbufs + 1) / 2);
+        cls->taken = FALSE;
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__buf_pool_decay() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_buf_malloc
+ *
+ * Purpose:     Allocate a buffer of at least SIZE bytes for a chunk or the
+ *              output of a filter, reusing an idle buffer of the pool if
+ *              there's one of about the right size.
+ *
+ *              The buffer can be released with H5Z_buf_free(), or with
+ *              H5MM_xfree(), and reallocated with H5MM_realloc().
+ *
+ * Return:      Success:    Pointer to the buffer
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z_buf_malloc(size_t size)
+{
+    void *ret_value = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI_NOERR
+
+    if (size >= H5Z_BUF_POOL_MIN && size <= H5Z_BUF_POOL_LIMIT) {
+        unsigned         c = H5Z__buf_class(size); /* Class of the request */
+        H5Z_buf_class_t *cls;                      /* Class the buffer is taken from */
+        H5Z_buf_idle_t **link = NULL;              /* Link to the buffer taken */
+        H5Z_buf_idle_t **curr;                     /* Link to the buffer looked at */
+        unsigned         u;                        /* Local index variable */
+
+        H5Z_BUF_POOL_LOCK;
+
+        /* Look for the smallest buffer large enough among the most recently
+         * released ones of the request's class, so buffers of the sizes of
+         * other requests in the class are left to them, or else take any
+         * buffer of the class above */
+        cls = &H5Z_buf_pool_g[c];
+        for (curr = &cls->head, u = 0; *curr && u < H5Z_BUF_POOL_SCAN; curr = &(*curr)->next, u++)
+            if ((*curr)->size >= size && (!link || (*curr)->size < (*link)->size)) {
+                link = curr;
+                if ((*link)->size == size)
+                    break;
+            } /* end if */
+        if (!link && c + 1 < H5Z_BUF_POOL_NCLASSES && H5Z_buf_pool_g[c + 1].head) {
+            cls  = &H5Z_buf_pool_g[c + 1];
+            link = &cls->head;
+        } /* end if */
+
+        if (link) {
+            H5Z_buf_idle_t *idle = *link;
+
+            *link = idle->next;
+            cls->nbufs--;
+            cls->tick  = H5Z_buf_pool_tick_g;
+            cls->taken = TRUE;
+            H5Z_buf_pool_nbytes_g -= idle->size;
+            ret_value = idle;
+        } /* end if */
+
+        if (0 == (++H5Z_buf_pool_tick_g % H5Z_BUF_POOL_DECAY))
+            H5Z__buf_pool_decay();
+
+        H5Z_BUF_POOL_UNLOCK;
+    } /* end if */
+
+    if (!ret_value)
+        ret_value = H5MM_malloc(size);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_buf_malloc() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_buf_free
+ *
+ * Purpose:     Release a buffer allocated with H5MM_malloc() or
+ *              H5Z_buf_malloc() and known to hold at least SIZE bytes
+ *              to the pool, or to the system if SIZE is too small to be
+ *              worth keeping (0 if the size of the buffer isn't known) or
+ *              too large for the pool.  Buffers of the classes least
+ *              recently taken from are released to keep the pool under
+ *              its limit.
+ *
+ * Return:      NULL (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z_buf_free(void *buf, size_t size)
+{
+    FUNC_ENTER_NOAPI_NOERR
+
+    if (buf && size >= H5Z_BUF_POOL_MIN && size <= H5Z_BUF_POOL_LIMIT) {
+        H5Z_buf_class_t *cls  = &H5Z_buf_pool_g[H5Z__buf_class(size)]; /* Class to put the buffer in */
+        H5Z_buf_idle_t  *idle = (H5Z_buf_idle_t *)buf;                 /* The buffer, while idle */
+        unsigned         u;                                            /* Local index variable */
+
+        H5Z_BUF_POOL_LOCK;
+
+        /* Make room under the limit, from the least recently used classes */
+        while (H5Z_buf_pool_nbytes_g + size > H5Z_BUF_POOL_LIMIT) {
+            H5Z_buf_class_t *oldest = NULL; /* Least recently used class */
+
+            for (u = 0; u < H5Z_BUF_POOL_NCLASSES; u++)
+                if (H5Z_buf_pool_g[u].nbufs > 0 && (!oldest || H5Z_buf_pool_g[u].tick < oldest->tick))
+                    oldest = &H5Z_buf_pool_g[u];
+            if (!oldest)
+                break;
+            (void)H5Z__buf_class_release(oldest, 1);
+        } /* end while */
+
+        idle->next = cls->head;
+        idle->size = size;
+        cls->head  = idle;
+        cls->nbufs++;
+        H5Z_buf_pool_nbytes_g += size;
+        buf = NULL;
+
+        if (0 == (++H5Z_buf_pool_tick_g % H5Z_BUF_POOL_DECAY))
+            H5Z__buf_pool_decay();
+
+        H5Z_BUF_POOL_UNLOCK;
+    } /* end if */
+
+    H5MM_xfree(buf);
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* end H5Z_buf_free() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_buf_garbage_coll
+ *
+ * Purpose:     Release all the idle buffers in the pool to the system.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_buf_garbage_coll(void)
+{
+    unsigned u; /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOERR
+
+    H5Z_BUF_POOL_LOCK;
+    for (u = 0; u < H5Z_BUF_POOL_NCLASSES; u++) {
+        (void)H5Z__buf_class_release(&H5Z_buf_pool_g[u], H5Z_buf_pool_g[u].nbufs);
+        H5Z_buf_pool_g[u].tick  = 0;
+        H5Z_buf_pool_g[u].taken = FALSE;
+    } /* end for */
+    H5Z_buf_pool_tick_g = 0;
+    H5Z_BUF_POOL_UNLOCK;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5Z_buf_garbage_coll() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__buf_pool_info
+ *
+ * Purpose:     Retrieve the number of idle buffers in the pool and the
+ *              number of bytes they are known to hold, for testing.
+ *
+ * Return:      none
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__buf_pool_info(size_t *nbufs, size_t *nbytes)
+{
+    unsigned u; /* Local index variable */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    H5Z_BUF_POOL_LOCK;
+    if (nbufs)
+        for (*nbufs = 0, u = 0; u < H5Z_BUF_POOL_NCLASSES; u++)
+            *nbufs += H5Z_buf_pool_g[u].nbufs;
+    if (nbytes)
+        *nbytes = H5Z_buf_pool_nbytes_g;
+    H5Z_BUF_POOL_UNLOCK;
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__buf_pool_info() */
@@ -49,12 +49,229 @@ const H5Z_class2_t H5Z_DEFLATE[1] = {{
 
 #define H5Z_DEFLATE_SIZE_ADJUST(s) (HDceil(((double)(s)) * 1.001) + 12)
 
+/* Largest number of idle streams of each kind kept for reuse */
+#define H5Z_DEFLATE_POOL_MAX 8
+
+/* Level of the inflate streams in the pool */
+#define H5Z_DEFLATE_INFLATE_LEVEL (-1)
+
+/* A zlib stream kept for reuse between calls of the filter */
+typedef struct H5Z_deflate_strm_t {
+    z_stream                   z_strm; /* zlib stream, reset and ready for use */
+    int                        level;  /* Compression level, or H5Z_DEFLATE_INFLATE_LEVEL */
+    double                     ratio;  /* Expansion of the last buffer inflated with the stream */
+    size_t                     last;   /* Size of the last buffer inflated with the stream */
+    struct H5Z_deflate_strm_t *next;   /* Next idle stream in the pool */
+} H5Z_deflate_strm_t;
+
+/* Idle streams, kept so that the state of zlib, which for deflate streams
+ * is several hundred KiB, isn't allocated and initialized for every chunk.
+ * Streams are taken from the pool for a call of the filter, so threads
+ * filtering chunks at the same time each have their own. */
+static H5Z_deflate_strm_t *H5Z_deflate_pool_g[2] = {NULL, NULL}; /* [0]: inflate, [1]: deflate */
+static unsigned            H5Z_deflate_npool_g[2] = {0, 0};
+
+#ifdef H5_HAVE_THREADSAFE
+/* Lock for the pool, initialized when the library first registers the filter */
+static H5TS_mutex_simple_t H5Z_deflate_pool_mutex_g;
+static hbool_t             H5Z_deflate_pool_mutex_init_g = FALSE;
+
+#define H5Z_DEFLATE_POOL_LOCK   H5TS_mutex_lock_simple(&H5Z_deflate_pool_mutex_g)
+#define H5Z_DEFLATE_POOL_UNLOCK H5TS_mutex_unlock_simple(&H5Z_deflate_pool_mutex_g)
+#else
+#define H5Z_DEFLATE_POOL_LOCK
+#define H5Z_DEFLATE_POOL_UNLOCK
+#endif /* H5_HAVE_THREADSAFE */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_init
+ *
+ * Purpose:	Set up the pool of deflate filter streams.
+ *
+ * Note:        Called when the library registers its filters, before any
+ *              filter can run on another thread.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__deflate_init(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+#ifdef H5_HAVE_THREADSAFE
+    if (!H5Z_deflate_pool_mutex_init_g) {
+        (void)H5TS_mutex_init(&H5Z_deflate_pool_mutex_g);
+        H5Z_deflate_pool_mutex_init_g = TRUE;
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__deflate_init() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_term
+ *
+ * Purpose:	Release the idle streams of the deflate filter, and the
+ *              lock for the pool.
+ *
+ * Note:        Called when the library shuts down its filters, after all
+ *              the files are closed, so no filter can be running.
+ *
+ * Return:	Number of streams released (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+H5Z__deflate_term(void)
+{
+    unsigned u;     /* Local index variable */
+    int      n = 0; /* Number of streams released */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    for (u = 0; u < 2; u++)
+        while (H5Z_deflate_pool_g[u]) {
+            H5Z_deflate_strm_t *strm = H5Z_deflate_pool_g[u];
+
+            H5Z_deflate_pool_g[u] = strm->next;
+            if (H5Z_DEFLATE_INFLATE_LEVEL == strm->level)
+                (void)inflateEnd(&strm->z_strm);
+            else
+                (void)deflateEnd(&strm->z_strm);
+            H5MM_xfree(strm);
+            n++;
+        } /* end while */
+    H5Z_deflate_npool_g[0] = H5Z_deflate_npool_g[1] = 0;
+
+#ifdef H5_HAVE_THREADSAFE
+    if (H5Z_deflate_pool_mutex_init_g) {
+        (void)H5TS_mutex_destroy(&H5Z_deflate_pool_mutex_g);
+        H5Z_deflate_pool_mutex_init_g = FALSE;
+    } /* end if */
+#endif /* H5_HAVE_THREADSAFE */
+
+    FUNC_LEAVE_NOAPI(n)
+} /* end H5Z__deflate_term() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_strm_get
+ *
+ * Purpose:	Take an idle inflate stream, or deflate stream of
+ *              compression level LEVEL, from the pool, or create one if
+ *              there's none.
+ *
+ * Return:	Success: Stream ready for use
+ *		Failure: NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_deflate_strm_t *
+H5Z__deflate_strm_get(int level)
+{
+    unsigned            kind      = (H5Z_DEFLATE_INFLATE_LEVEL != level); /* Index of the pool */
+    H5Z_deflate_strm_t *strm      = NULL;                                 /* Stream */
+    H5Z_deflate_strm_t *ret_value = NULL;                                 /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Look for an idle stream at the right level */
+    H5Z_DEFLATE_POOL_LOCK;
+    {
+        H5Z_deflate_strm_t **prev = &H5Z_deflate_pool_g[kind];
+
+        while (*prev && (*prev)->level != level)
+            prev = &(*prev)->next;
+        if (*prev) {
+            strm  = *prev;
+            *prev = strm->next;
+            H5Z_deflate_npool_g[kind]--;
+        } /* end if */
+    }
+    H5Z_DEFLATE_POOL_UNLOCK;
+
+    /* Create a new stream */
+    if (!strm) {
+        int status; /* Status from zlib operation */
+
+        if (NULL == (strm = (H5Z_deflate_strm_t *)H5MM_calloc(sizeof(H5Z_deflate_strm_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for deflate stream")
+        strm->level = level;
+        if (H5Z_DEFLATE_INFLATE_LEVEL == level)
+            status = inflateInit(&strm->z_strm);
+        else
+            status = deflateInit(&strm->z_strm, level);
+        if (Z_OK != status) {
+            H5MM_xfree(strm);
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "deflateInit() or inflateInit() failed")
+        } /* end if */
+    }     /* end if */
+
+    ret_value = strm;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__deflate_strm_get() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_strm_put
+ *
+ * Purpose:	Reset a stream and return it to the pool, or release it if
+ *              the pool is full or the stream can't be reset.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__deflate_strm_put(H5Z_deflate_strm_t *strm)
+{
+    unsigned kind = (H5Z_DEFLATE_INFLATE_LEVEL != strm->level); /* Index of the pool */
+    int      status;                                            /* Status from zlib operation */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (kind)
+        status = deflateReset(&strm->z_strm);
+    else
+        status = inflateReset(&strm->z_strm);
+
+    if (Z_OK == status) {
+        H5Z_DEFLATE_POOL_LOCK;
+        if (H5Z_deflate_npool_g[kind] < H5Z_DEFLATE_POOL_MAX) {
+            strm->next               = H5Z_deflate_pool_g[kind];
+            H5Z_deflate_pool_g[kind] = strm;
+            H5Z_deflate_npool_g[kind]++;
+            strm = NULL;
+        } /* end if */
+        H5Z_DEFLATE_POOL_UNLOCK;
+    } /* end if */
+
+    if (strm) {
+        if (kind)
+            (void)deflateEnd(&strm->z_strm);
+        else
+            (void)inflateEnd(&strm->z_strm);
+        H5MM_xfree(strm);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__deflate_strm_put() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5Z__filter_deflate
  *
  * Purpose:	Implement an I/O filter around the 'deflate' algorithm in
  *              libz
  *
+ * Note:        The zlib streams are reused from call to call (see
+ *              H5Z__deflate_strm_get()).  The output buffer for inflating
+ *              is sized from the expansion of the last buffer inflated
+ *              with the stream, limited to that buffer's inflated size, so
+ *              reading chunks of the same size through the filter usually
+ *              allocates the buffer once, at the right size.
+ *
  * Return:	Success: Size of buffer filtered
  *		Failure: 0
  *
@@ -67,9 +284,10 @@ static size_t
 H5Z__filter_deflate(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], size_t nbytes,
                     size_t *buf_size, void **buf)
 {
-    void  *outbuf = NULL; /* Pointer to new buffer */
-    int    status;        /* Status from zlib operation */
-    size_t ret_value = 0; /* Return value */
+    H5Z_deflate_strm_t *strm   = NULL; /* Reusable zlib stream */
+    void               *outbuf = NULL; /* Pointer to new buffer */
+    int                 status;        /* Status from zlib operation */
+    size_t              ret_value = 0; /* Return value */
 
     FUNC_ENTER_PACKAGE
 
@@ -84,70 +302,76 @@ H5Z__filter_deflate(unsigned flags, size_t cd_nelmts, const unsigned cd_values[]
 
     if (flags & H5Z_FLAG_REVERSE) {
         /* Input; uncompress */
-        z_stream z_strm;             /* zlib parameters */
-        size_t   nalloc = *buf_size; /* Number of bytes for output (compressed) buffer */
+        z_stream *z_strm;             /* zlib parameters */
+        size_t    nalloc = *buf_size; /* Number of bytes for output (compressed) buffer */
+
+        if (NULL == (strm = H5Z__deflate_strm_get(H5Z_DEFLATE_INFLATE_LEVEL)))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateInit() failed")
+        z_strm = &strm->z_strm;
+
+        /* Guess the size of the output from the last buffer inflated */
+        if (strm->last > 0) {
+            double guess = (double)nbytes * strm->ratio * 1.125;
+
+            if (guess > (double)strm->last)
+                guess = (double)strm->last;
+            if (guess > (double)nalloc)
+                nalloc = (size_t)guess;
+        } /* end if */
 
         /* Allocate space for the compressed buffer */
-        if (NULL == (outbuf = H5MM_malloc(nalloc)))
+        if (NULL == (outbuf = H5Z_buf_malloc(nalloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
 
         /* Set the uncompression parameters */
-        HDmemset(&z_strm, 0, sizeof(z_strm));
-        z_strm.next_in = (Bytef *)*buf;
-        H5_CHECKED_ASSIGN(z_strm.avail_in, unsigned, nbytes, size_t);
-        z_strm.next_out = (Bytef *)outbuf;
-        H5_CHECKED_ASSIGN(z_strm.avail_out, unsigned, nalloc, size_t);
-
-        /* Initialize the uncompression routines */
-        if (Z_OK != inflateInit(&z_strm))
-            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflateInit() failed")
+        z_strm->next_in = (Bytef *)*buf;
+        H5_CHECKED_ASSIGN(z_strm->avail_in, unsigned, nbytes, size_t);
+        z_strm->next_out = (Bytef *)outbuf;
+        H5_CHECKED_ASSIGN(z_strm->avail_out, unsigned, nalloc, size_t);
 
         /* Loop to uncompress the buffer */
         do {
             /* Uncompress some data */
-            status = inflate(&z_strm, Z_SYNC_FLUSH);
+            status = inflate(z_strm, Z_SYNC_FLUSH);
 
             /* Check if we are done uncompressing data */
             if (Z_STREAM_END == status)
                 break; /*done*/
 
             /* Check for error */
-            if (Z_OK != status) {
-                (void)inflateEnd(&z_strm);
+            if (Z_OK != status)
                 HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "inflate() failed")
-            }
             else {
                 /* If we're not done and just ran out of buffer space, get more */
-                if (0 == z_strm.avail_out) {
+                if (0 == z_strm->avail_out) {
                     void *new_outbuf; /* Pointer to new output buffer */
 
                     /* Allocate a buffer twice as big */
                     nalloc *= 2;
-                    if (NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc))) {
-                        (void)inflateEnd(&z_strm);
+                    if (NULL == (new_outbuf = H5MM_realloc(outbuf, nalloc)))
                         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0,
                                     "memory allocation failed for deflate uncompression")
-                    } /* end if */
                     outbuf = new_outbuf;
 
                     /* Update pointers to buffer for next set of uncompressed data */
-                    z_strm.next_out  = (unsigned char *)outbuf + z_strm.total_out;
-                    z_strm.avail_out = (uInt)(nalloc - z_strm.total_out);
+                    z_strm->next_out  = (unsigned char *)outbuf + z_strm->total_out;
+                    z_strm->avail_out = (uInt)(nalloc - z_strm->total_out);
                 } /* end if */
             }     /* end else */
         } while (status == Z_OK);
 
+        /* Remember the expansion, for the next buffer inflated with the stream */
+        strm->last  = (size_t)z_strm->total_out;
+        strm->ratio = (double)z_strm->total_out / (double)nbytes;
+
         /* Free the input buffer */
-        H5MM_xfree(*buf);
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
         *buf      = outbuf;
         outbuf    = NULL;
         *buf_size = nalloc;
-        ret_value = z_strm.total_out;
-
-        /* Finish uncompressing the stream */
-        (void)inflateEnd(&z_strm);
+        ret_value = z_strm->total_out;
     } /* end if */
     else {
         /*
@@ -155,44 +379,51 @@ H5Z__filter_deflate(unsigned flags, size_t cd_nelmts, const unsigned cd_values[]
          * input.  The library doesn't provide in-place compression, so we
          * must allocate a separate buffer for the result.
          */
-        const Bytef *z_src = (const Bytef *)(*buf);
-        Bytef       *z_dst; /*destination buffer		*/
-        uLongf       z_dst_nbytes = (uLongf)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
-        uLong        z_src_nbytes = (uLong)nbytes;
-        int          aggression; /* Compression aggression setting */
+        size_t    z_dst_nbytes = (size_t)H5Z_DEFLATE_SIZE_ADJUST(nbytes); /* Size of output buffer */
+        z_stream *z_strm;     /* zlib parameters */
+        int       aggression; /* Compression aggression setting */
 
         /* Set the compression aggression level */
         H5_CHECKED_ASSIGN(aggression, int, cd_values[0], unsigned);
 
+        if (NULL == (strm = H5Z__deflate_strm_get(aggression)))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "deflateInit() failed")
+        z_strm = &strm->z_strm;
+
         /* Allocate output (compressed) buffer */
-        if (NULL == (outbuf = H5MM_malloc(z_dst_nbytes)))
+        if (NULL == (outbuf = H5Z_buf_malloc(z_dst_nbytes)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate deflate destination buffer")
-        z_dst = (Bytef *)outbuf;
 
         /* Perform compression from the source to the destination buffer */
-        status = compress2(z_dst, &z_dst_nbytes, z_src, z_src_nbytes, aggression);
+        z_strm->next_in = (Bytef *)*buf;
+        H5_CHECKED_ASSIGN(z_strm->avail_in, unsigned, nbytes, size_t);
+        z_strm->next_out = (Bytef *)outbuf;
+        H5_CHECKED_ASSIGN(z_strm->avail_out, unsigned, z_dst_nbytes, size_t);
+        status = deflate(z_strm, Z_FINISH);
 
         /* Check for various zlib errors */
-        if (Z_BUF_ERROR == status)
+        if (Z_OK == status || Z_BUF_ERROR == status)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "overflow")
         else if (Z_MEM_ERROR == status)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "deflate memory error")
-        else if (Z_OK != status)
+        else if (Z_STREAM_END != status)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "other deflate error")
         /* Successfully uncompressed the buffer */
         else {
             /* Free the input buffer */
-            H5MM_xfree(*buf);
+            H5Z_buf_free(*buf, *buf_size);
 
             /* Set return values */
             *buf      = outbuf;
             outbuf    = NULL;
             *buf_size = nbytes;
-            ret_value = z_dst_nbytes;
+            ret_value = z_strm->total_out;
         } /* end else */
     }     /* end else */
 
 done:
+    if (strm)
+        H5Z__deflate_strm_put(strm);
     if (outbuf)
         H5MM_xfree(outbuf);
     FUNC_LEAVE_NOAPI(ret_value)
@@ -121,7 +121,7 @@ H5Z__filter_fletcher32(unsigned flags, size_t H5_ATTR_UNUSED cd_nelmts,
         /* Compute checksum (can't fail) */
         fletcher = H5_checksum_fletcher32(src, nbytes);
 
-        if (NULL == (outbuf = H5MM_malloc(nbytes + FLETCHER_LEN)))
+        if (NULL == (outbuf = H5Z_buf_malloc(nbytes + FLETCHER_LEN)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0,
                         "unable to allocate Fletcher32 checksum destination buffer")
 
@@ -135,7 +135,7 @@ H5Z__filter_fletcher32(unsigned flags, size_t H5_ATTR_UNUSED cd_nelmts,
         UINT32ENCODE(dst, fletcher);
 
         /* Free input buffer */
-        H5MM_xfree(*buf);
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
         *buf_size = nbytes + FLETCHER_LEN;
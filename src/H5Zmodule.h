@@ -98,6 +98,10 @@
  *           filter</td></tr>
  *   <tr><td>#H5Z_FILTER_FLETCHER32</td><td>The Fletcher32 checksum,
  *           or error checking, filter</td></tr>
+ *   <tr><td>#H5Z_FILTER_CRC32C</td><td>The CRC32C checksum,
+ *           or error checking, filter</td></tr>
+ *   <tr><td>#H5Z_FILTER_VLEN</td><td>The inline variable-length
+ *           data filter</td></tr>
  * </table>
  * Custom filters that have been registered with the library will have
  * additional unique identifiers.
@@ -115,6 +119,8 @@
  * \ingroup H5ZPRE
  * \defgroup SZIP Szip Filter
  * \ingroup H5ZPRE
+ * \defgroup VLEN Inline Variable-Length Data Filter
+ * \ingroup H5ZPRE
  *
  */
 
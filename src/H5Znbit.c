@@ -977,7 +977,7 @@ H5Z__filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
         size_out = d_nelmts * (size_t)cd_values[4]; /* cd_values[4] stores datatype size */
 
         /* allocate memory space for decompressed buffer */
-        if (NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if (NULL == (outbuf = (unsigned char *)H5Z_buf_malloc(size_out)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit decompression")
 
         /* decompress the buffer */
@@ -991,7 +991,7 @@ H5Z__filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
         size_out = nbytes;
 
         /* allocate memory space for compressed buffer */
-        if (NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if (NULL == (outbuf = (unsigned char *)H5Z_buf_malloc(size_out)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit compression")
 
         /* compress the buffer, size_out will be changed */
@@ -999,7 +999,7 @@ H5Z__filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
     } /* end else */
 
     /* free the input buffer */
-    H5MM_xfree(*buf);
+    H5Z_buf_free(*buf, *buf_size);
 
     /* set return values */
     *buf      = outbuf;
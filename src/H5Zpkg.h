@@ -30,6 +30,12 @@ H5_DLLVAR const H5Z_class2_t H5Z_SHUFFLE[1];
 /* Fletcher32 filter */
 H5_DLLVAR const H5Z_class2_t H5Z_FLETCHER32[1];
 
+/* CRC32C filter */
+H5_DLLVAR const H5Z_class2_t H5Z_CRC32C[1];
+
+/* Inline variable-length data filter */
+H5_DLLVAR const H5Z_class2_t H5Z_VLEN[1];
+
 /* n-bit filter */
 H5_DLLVAR H5Z_class2_t H5Z_NBIT[1];
 
@@ -50,7 +56,39 @@ H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
 H5_DLLVAR H5Z_class2_t H5Z_SZIP[1];
 #endif /* H5_HAVE_FILTER_SZIP */
 
+/* Instruction sets with kernels for the shuffle filter */
+typedef enum H5Z_shuffle_isa_t {
+    H5Z_SHUFFLE_ISA_SCALAR = 0, /* Portable byte loops                  */
+    H5Z_SHUFFLE_ISA_SSE2,       /* x86 SSE2, 128-bit vectors            */
+    H5Z_SHUFFLE_ISA_AVX2,       /* x86 AVX2, 256-bit vectors            */
+    H5Z_SHUFFLE_ISA_AVX512,     /* x86 AVX-512 (F and BW), 512-bit      */
+    H5Z_SHUFFLE_ISA_NTYPES      /* Number of instruction sets (sentinel) */
+} H5Z_shuffle_isa_t;
+
 /* Package internal routines */
 H5_DLL herr_t H5Z__unregister(H5Z_filter_t filter_id);
 
+/* Most bytes of idle buffers kept in the pool of filter buffers, which is
+ * also the largest buffer kept (a power of two) */
+#define H5Z_BUF_POOL_LIMIT_LOG2 25
+#define H5Z_BUF_POOL_LIMIT      ((size_t)1 << H5Z_BUF_POOL_LIMIT_LOG2)
+
+/* Pool of filter buffers */
+H5_DLL void H5Z__buf_init(void);
+H5_DLL int  H5Z__buf_term(void);
+H5_DLL void H5Z__buf_pool_info(size_t *nbufs, size_t *nbytes);
+
+/* Pool of reusable streams of the deflate filter */
+#ifdef H5_HAVE_FILTER_DEFLATE
+H5_DLL void H5Z__deflate_init(void);
+H5_DLL int  H5Z__deflate_term(void);
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+/* Shuffle filter kernels, also used by the tests and the benchmark */
+H5_DLL H5Z_shuffle_isa_t H5Z__shuffle_best_isa(void);
+H5_DLL herr_t H5Z__shuffle_bytes(H5Z_shuffle_isa_t isa, hbool_t reverse, unsigned elmt_size, size_t nelmts,
+                                 const void *src, void *dest);
+H5_DLL herr_t H5Z__bitshuffle_bytes(H5Z_shuffle_isa_t isa, hbool_t reverse, unsigned elmt_size, size_t nelmts,
+                                    const void *src, void *dest);
+
 #endif /* H5Zpkg_H */
@@ -36,6 +36,11 @@ typedef struct H5Z_filter_info_t H5Z_filter_info_t;
 #define H5_SZIP_MSB_OPTION_MASK 16
 #define H5_SZIP_RAW_OPTION_MASK 128
 
+/* Parameters of the inline variable-length data filter, set by the library */
+#define H5Z_VLEN_PARM_ELEM_SIZE 0 /* Size of an element of the dataset */
+#define H5Z_VLEN_PARM_BASE_SIZE 1 /* Size of an element of the sequences */
+#define H5Z_VLEN_PARM_NELMTS    2 /* Number of elements in a chunk */
+
 /* Common # of 'client data values' for filters */
 /* (avoids dynamic memory allocation in most cases) */
 #define H5Z_COMMON_CD_VALUES 4
@@ -87,10 +92,22 @@ H5_DLL htri_t             H5Z_ignore_filters(hid_t dcpl_id, const H5T_t *type, c
 H5_DLL H5Z_filter_info_t *H5Z_filter_info(const struct H5O_pline_t *pline, H5Z_filter_t filter);
 H5_DLL htri_t             H5Z_filter_in_pline(const struct H5O_pline_t *pline, H5Z_filter_t filter);
 H5_DLL htri_t             H5Z_all_filters_avail(const struct H5O_pline_t *pline);
+H5_DLL hbool_t            H5Z_pipeline_thread_safe(const struct H5O_pline_t *pline);
 H5_DLL htri_t             H5Z_filter_avail(H5Z_filter_t id);
 H5_DLL herr_t             H5Z_delete(struct H5O_pline_t *pline, H5Z_filter_t filter);
 H5_DLL herr_t             H5Z_get_filter_info(H5Z_filter_t filter, unsigned int *filter_config_flags);
 
+/* Pool of buffers for chunks and the outputs of filters */
+H5_DLL void  *H5Z_buf_malloc(size_t size);
+H5_DLL void  *H5Z_buf_free(void *buf, size_t size);
+H5_DLL herr_t H5Z_buf_garbage_coll(void);
+
+/* Inline variable-length data */
+H5_DLL void  *H5Z_vlen_compact(const struct H5O_pline_t *pline, const void *chunk, size_t nbytes,
+                              size_t *out_nbytes);
+H5_DLL herr_t H5Z_vlen_to_ptrs(const struct H5O_pline_t *pline, void *chunk);
+H5_DLL herr_t H5Z_vlen_to_offsets(const struct H5O_pline_t *pline, void *chunk, size_t nbytes);
+
 /* Data Transform Functions */
 typedef struct H5Z_data_xform_t H5Z_data_xform_t; /* Defined in H5Ztrans.c */
 
@@ -67,6 +67,22 @@ typedef int H5Z_filter_t;
  * maximum filter id
  */
 #define H5Z_FILTER_MAX 65535
+/**
+ * CRC32C checksum of EDC
+ *
+ * \note This filter is built into the library but, unlike the filters
+ *       above, takes its identifier from the range for third-party filters,
+ *       so the identifiers reserved for library use stay free.  Its name is
+ *       stored in the file with it.
+ */
+#define H5Z_FILTER_CRC32C 32300
+/**
+ * inline variable-length data
+ *
+ * \note Like #H5Z_FILTER_CRC32C, this filter is built into the library but
+ *       takes its identifier from the range for third-party filters.
+ */
+#define H5Z_FILTER_VLEN 32301
 
 /* General macros */
 /**
@@ -141,6 +157,27 @@ typedef int H5Z_filter_t;
  * Total number of parameters for the shuffle filter
  */
 #define H5Z_SHUFFLE_TOTAL_NPARMS 1
+/**
+ * \ingroup SHUFFLE
+ * Number of parameters of the shuffle filter with the optional mode parameter
+ */
+#define H5Z_SHUFFLE_MAX_NPARMS 2
+/**
+ * \ingroup SHUFFLE
+ * "User" parameter for the shuffle mode.  The parameter before it is the
+ * datatype size, which the library sets when the dataset is created.
+ */
+#define H5Z_SHUFFLE_PARM_MODE 1
+/**
+ * \ingroup SHUFFLE
+ * Shuffle mode that groups the bytes of each byte position (default)
+ */
+#define H5Z_SHUFFLE_MODE_BYTE 0
+/**
+ * \ingroup SHUFFLE
+ * Shuffle mode that groups the bits of each bit position
+ */
+#define H5Z_SHUFFLE_MODE_BIT 1
 
 /* Macros for the szip filter */
 /**
@@ -188,6 +225,19 @@ typedef int H5Z_filter_t;
  */
 #define H5Z_SCALEOFFSET_USER_NPARMS 2
 
+/* Macros for the inline variable-length data filter */
+/**
+ * \ingroup VLEN
+ * Number of parameters that users can set for the inline variable-length
+ * data filter
+ */
+#define H5Z_VLEN_USER_NPARMS 0
+/**
+ * \ingroup VLEN
+ * Total number of parameters for the inline variable-length data filter
+ */
+#define H5Z_VLEN_TOTAL_NPARMS 3
+
 /* Special parameters for ScaleOffset filter*/
 /**
  * \ingroup SCALEOFFSET */
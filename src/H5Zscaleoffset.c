@@ -1247,7 +1247,7 @@ H5Z__filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_valu
         size_out = d_nelmts * (size_t)p.size;
 
         /* allocate memory space for decompressed buffer */
-        if (NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if (NULL == (outbuf = (unsigned char *)H5Z_buf_malloc(size_out)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0,
                         "memory allocation failed for scaleoffset decompression")
 
@@ -1255,7 +1255,7 @@ H5Z__filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_valu
         if (minbits == p.size * 8) {
             H5MM_memcpy(outbuf, (unsigned char *)(*buf) + buf_offset, size_out);
             /* free the original buffer */
-            H5MM_xfree(*buf);
+            H5Z_buf_free(*buf, *buf_size);
 
             /* convert to dataset datatype endianness order if needed */
             if (need_convert)
@@ -1328,7 +1328,7 @@ H5Z__filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_valu
         size_out  = buf_offset + nbytes * p.minbits / (p.size * 8) + 1; /* may be 1 larger */
 
         /* allocate memory space for compressed buffer */
-        if (NULL == (outbuf = (unsigned char *)H5MM_malloc(size_out)))
+        if (NULL == (outbuf = (unsigned char *)H5Z_buf_malloc(size_out)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for scaleoffset compression")
 
         /* store minbits and minval in the front of output compressed buffer
@@ -1355,7 +1355,7 @@ H5Z__filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_valu
         if (minbits == p.size * 8) {
             H5MM_memcpy(outbuf + buf_offset, *buf, nbytes);
             /* free the original buffer */
-            H5MM_xfree(*buf);
+            H5Z_buf_free(*buf, *buf_size);
 
             *buf      = outbuf;
             outbuf    = NULL;
@@ -1374,7 +1374,7 @@ H5Z__filter_scaleoffset(unsigned flags, size_t cd_nelmts, const unsigned cd_valu
     }
 
     /* free the input buffer */
-    H5MM_xfree(*buf);
+    H5Z_buf_free(*buf, *buf_size);
 
     /* set return values */
     *buf      = outbuf;
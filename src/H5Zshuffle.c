@@ -20,6 +20,15 @@
 #include "H5Tprivate.h"  /* Datatypes         			*/
 #include "H5Zpkg.h"      /* Data filters				*/
 
+/* The vector kernels need the "target" function attribute of GCC or Clang,
+ * so they can be built without enabling the instructions for the whole
+ * library */
+#if (defined(__x86_64__) || defined(__i386__)) &&                                                            \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 6))
+#define H5Z_SHUFFLE_HAVE_X86
+#include <immintrin.h>
+#endif
+
 /* Local function prototypes */
 static herr_t H5Z__set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static size_t H5Z__filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], size_t nbytes,
@@ -38,7 +47,11 @@ const H5Z_class2_t H5Z_SHUFFLE[1] = {{
 }};
 
 /* Local macros */
-#define H5Z_SHUFFLE_PARM_SIZE 0 /* "Local" parameter for shuffling size */
+#define H5Z_SHUFFLE_PARM_SIZE    0  /* "Local" parameter for shuffling size */
+#define H5Z_SHUFFLE_VEC_MAX_SIZE 16 /* Largest element size with vector kernels */
+
+/* Widest instruction set supported by the CPU, checked on first use */
+static H5Z_shuffle_isa_t H5Z_shuffle_isa_g = H5Z_SHUFFLE_ISA_NTYPES;
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z__set_local_shuffle
@@ -60,8 +73,9 @@ H5Z__set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t H5_ATTR_UNUSED space_
     H5P_genplist_t *dcpl_plist;                          /* Property list pointer */
     const H5T_t    *type;                                /* Datatype */
     unsigned        flags;                               /* Filter flags */
-    size_t          cd_nelmts = H5Z_SHUFFLE_USER_NPARMS; /* Number of filter parameters */
-    unsigned        cd_values[H5Z_SHUFFLE_TOTAL_NPARMS]; /* Filter parameters */
+    size_t          cd_nelmts = H5Z_SHUFFLE_MAX_NPARMS;  /* Number of filter parameters */
+    unsigned        cd_values[H5Z_SHUFFLE_MAX_NPARMS];   /* Filter parameters */
+    unsigned        mode = H5Z_SHUFFLE_MODE_BYTE;        /* Shuffle mode */
     herr_t          ret_value = SUCCEED;                 /* Return value */
 
     FUNC_ENTER_PACKAGE
@@ -79,12 +93,25 @@ H5Z__set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t H5_ATTR_UNUSED space_
                              NULL) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get shuffle parameters")
 
+    /* Get the mode, if the application set one */
+    if (cd_nelmts > H5Z_SHUFFLE_MAX_NPARMS)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "too many shuffle parameters")
+    if (cd_nelmts > H5Z_SHUFFLE_PARM_MODE)
+        mode = cd_values[H5Z_SHUFFLE_PARM_MODE];
+    if (mode != H5Z_SHUFFLE_MODE_BYTE && mode != H5Z_SHUFFLE_MODE_BIT)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid shuffle mode")
+
     /* Set "local" parameter for this dataset */
     if ((cd_values[H5Z_SHUFFLE_PARM_SIZE] = (unsigned)H5T_get_size(type)) == 0)
         HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype size")
 
-    /* Modify the filter's parameters for this dataset */
-    if (H5P_modify_filter(dcpl_plist, H5Z_FILTER_SHUFFLE, flags, (size_t)H5Z_SHUFFLE_TOTAL_NPARMS,
+    /* Modify the filter's parameters for this dataset.  The byte mode is
+     * stored without a mode parameter, so older versions of the library can
+     * read the data. */
+    cd_values[H5Z_SHUFFLE_PARM_MODE] = mode;
+    if (H5P_modify_filter(dcpl_plist, H5Z_FILTER_SHUFFLE, flags,
+                          (size_t)(mode == H5Z_SHUFFLE_MODE_BYTE ? H5Z_SHUFFLE_TOTAL_NPARMS
+                                                                 : H5Z_SHUFFLE_MAX_NPARMS),
                           cd_values) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTSET, FAIL, "can't set local shuffle parameters")
 
@@ -92,6 +119,811 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z__set_local_shuffle() */
 
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_scalar
+ *
+ * Purpose:	Shuffle the bytes of elements FIRST through NELMTS-1 of
+ *              SRC into DEST, one byte position at a time.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__shuffle_scalar(unsigned char *dest, const unsigned char *src, unsigned bytesoftype, size_t nelmts,
+                    size_t first)
+{
+    const unsigned char *_src  = NULL; /* Alias for source buffer */
+    unsigned char       *_dest = NULL; /* Alias for destination buffer */
+    size_t               count;        /* Number of elements to shuffle */
+    unsigned             i;            /* Local index variable */
+#ifdef NO_DUFFS_DEVICE
+    size_t j; /* Local index variable */
+#endif        /* NO_DUFFS_DEVICE */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Duff's device always moves at least one byte */
+    if (first < nelmts) {
+        count = nelmts - first;
+
+        for (i = 0; i < bytesoftype; i++) {
+            _src  = src + (first * bytesoftype) + i;
+            _dest = dest + ((size_t)i * nelmts) + first;
+#define DUFF_GUTS                                                                                            \
+    *_dest++ = *_src;                                                                                        \
+    _src += bytesoftype;
+#ifdef NO_DUFFS_DEVICE
+            j = count;
+            while (j > 0) {
+                DUFF_GUTS;
+
+                j--;
+            } /* end for */
+#else         /* NO_DUFFS_DEVICE */
+            {
+                size_t duffs_index; /* Counting index for Duff's device */
+
+                duffs_index = (count + 7) / 8;
+                switch (count % 8) {
+                    default:
+                        HDassert(0 && "This Should never be executed!");
+                        break;
+                    case 0:
+                        do {
+                            DUFF_GUTS
+                            /* FALLTHROUGH */
+                            H5_ATTR_FALLTHROUGH
+                            case 7:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 6:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 5:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 4:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 3:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 2:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 1:
+                                DUFF_GUTS
+                        } while (--duffs_index > 0);
+                } /* end switch */
+            }
+#endif        /* NO_DUFFS_DEVICE */
+#undef DUFF_GUTS
+        } /* end for */
+    }     /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__shuffle_scalar() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__unshuffle_scalar
+ *
+ * Purpose:	Unshuffle the bytes of elements FIRST through NELMTS-1 of
+ *              SRC into DEST, one byte position at a time.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__unshuffle_scalar(unsigned char *dest, const unsigned char *src, unsigned bytesoftype, size_t nelmts,
+                      size_t first)
+{
+    const unsigned char *_src  = NULL; /* Alias for source buffer */
+    unsigned char       *_dest = NULL; /* Alias for destination buffer */
+    size_t               count;        /* Number of elements to unshuffle */
+    unsigned             i;            /* Local index variable */
+#ifdef NO_DUFFS_DEVICE
+    size_t j; /* Local index variable */
+#endif        /* NO_DUFFS_DEVICE */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    /* Duff's device always moves at least one byte */
+    if (first < nelmts) {
+        count = nelmts - first;
+
+        for (i = 0; i < bytesoftype; i++) {
+            _src  = src + ((size_t)i * nelmts) + first;
+            _dest = dest + (first * bytesoftype) + i;
+#define DUFF_GUTS                                                                                            \
+    *_dest = *_src++;                                                                                        \
+    _dest += bytesoftype;
+#ifdef NO_DUFFS_DEVICE
+            j = count;
+            while (j > 0) {
+                DUFF_GUTS;
+
+                j--;
+            } /* end for */
+#else         /* NO_DUFFS_DEVICE */
+            {
+                size_t duffs_index; /* Counting index for Duff's device */
+
+                duffs_index = (count + 7) / 8;
+                switch (count % 8) {
+                    default:
+                        HDassert(0 && "This Should never be executed!");
+                        break;
+                    case 0:
+                        do {
+                            DUFF_GUTS
+                            /* FALLTHROUGH */
+                            H5_ATTR_FALLTHROUGH
+                            case 7:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 6:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 5:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 4:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 3:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 2:
+                                DUFF_GUTS
+                                /* FALLTHROUGH */
+                                H5_ATTR_FALLTHROUGH
+                            case 1:
+                                DUFF_GUTS
+                        } while (--duffs_index > 0);
+                } /* end switch */
+            }
+#endif        /* NO_DUFFS_DEVICE */
+#undef DUFF_GUTS
+        } /* end for */
+    }     /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__unshuffle_scalar() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_plane_scalar
+ *
+ * Purpose:	Shuffle (or unshuffle, if REVERSE is set) the bits of the
+ *              bytes FIRST through NBYTES-1 of the byte plane SRC into
+ *              DEST.  NBYTES and FIRST are multiples of 8.
+ *
+ *              The shuffled plane holds 8 bit planes of NBYTES/8 bytes.
+ *              Bit J of byte G of bit plane K is bit K of byte 8*G+J of
+ *              the byte plane, so each group of 8 bytes is an 8x8 bit
+ *              matrix that is transposed, which is its own inverse.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__bitshuffle_plane_scalar(unsigned char *dest, const unsigned char *src, size_t nbytes, size_t first,
+                             hbool_t reverse)
+{
+    size_t   ngroups = nbytes / 8; /* Number of bytes in each bit plane */
+    size_t   g;                    /* Local index variables */
+    unsigned j;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    for (g = first / 8; g < ngroups; g++) {
+        uint64_t x = 0; /* Bit matrix, row J in byte J */
+        uint64_t t;     /* Swapped bits */
+
+        /* Gather the 8x8 bit matrix */
+        for (j = 0; j < 8; j++)
+            x |= (uint64_t)(reverse ? src[(j * ngroups) + g] : src[(8 * g) + j]) << (8 * j);
+
+        /* Transpose it, swapping 1x1, 2x2 and 4x4 blocks */
+        t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+        x = x ^ t ^ (t << 28);
+
+        /* Scatter the rows of the transposed matrix */
+        for (j = 0; j < 8; j++) {
+            if (reverse)
+                dest[(8 * g) + j] = (unsigned char)(x >> (8 * j));
+            else
+                dest[(j * ngroups) + g] = (unsigned char)(x >> (8 * j));
+        } /* end for */
+    }     /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__bitshuffle_plane_scalar() */
+
+#ifdef H5Z_SHUFFLE_HAVE_X86
+
+/*
+ * The vector kernels transpose blocks of W elements, where W is the width of
+ * a vector register in bytes, so that each block of an element of size S is
+ * held in S registers.  Each round splits every group of N registers into the
+ * N/2 registers with the even bytes of the group and the N/2 registers with
+ * the odd bytes, so after log2(S) rounds each register holds one byte position
+ * of the W elements.  The byte position in register J is the bit-reversal of J,
+ * given by H5Z_shuffle_pos_g.  Unshuffling runs the rounds backward,
+ * interleaving the bytes of the registers again.
+ *
+ * The instructions of each kernel are enabled with the "target" attribute, so
+ * the rest of the library is built for the baseline instruction set and the
+ * kernel is only called when the CPU supports it.
+ */
+
+/* Byte position held by each register after the rounds, indexed by log2(S) */
+static const unsigned char H5Z_shuffle_pos_g[5][H5Z_SHUFFLE_VEC_MAX_SIZE] = {
+    {0},
+    {0, 1},
+    {0, 2, 1, 3},
+    {0, 4, 2, 6, 1, 5, 3, 7},
+    {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15}};
+
+/* Attributes of the inlined primitives of a kernel, and of its block routines.
+ * The block routines are only forced inline when optimizing, where the copies
+ * for each element size are unrolled; unoptimized builds would otherwise
+ * spill every copy to the stack. */
+#define H5Z_SHUFFLE_INLINE(TARGET) static inline __attribute__((always_inline, target(TARGET)))
+
+/* Unroll the rounds completely, so the registers of a block aren't kept in an
+ * array in memory */
+#if defined(__clang__)
+#define H5Z_SHUFFLE_UNROLL _Pragma("unroll")
+#elif __GNUC__ >= 8
+#define H5Z_SHUFFLE_UNROLL _Pragma("GCC unroll 16")
+#else
+#define H5Z_SHUFFLE_UNROLL
+#endif
+#ifdef __OPTIMIZE__
+#define H5Z_SHUFFLE_BLOCK(TARGET) H5Z_SHUFFLE_INLINE(TARGET)
+#else
+#define H5Z_SHUFFLE_BLOCK(TARGET) static __attribute__((target(TARGET)))
+#endif
+
+/* SSE2 primitives */
+H5Z_SHUFFLE_INLINE("sse2") __m128i H5Z__shuffle_even_sse2(__m128i a, __m128i b)
+{
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+
+    return _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+}
+H5Z_SHUFFLE_INLINE("sse2") __m128i H5Z__shuffle_odd_sse2(__m128i a, __m128i b)
+{
+    return _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+}
+H5Z_SHUFFLE_INLINE("sse2") __m128i H5Z__shuffle_ilo_sse2(__m128i even, __m128i odd)
+{
+    return _mm_unpacklo_epi8(even, odd);
+}
+H5Z_SHUFFLE_INLINE("sse2") __m128i H5Z__shuffle_ihi_sse2(__m128i even, __m128i odd)
+{
+    return _mm_unpackhi_epi8(even, odd);
+}
+#define H5Z_SHUFFLE_LOAD_sse2(P)     _mm_loadu_si128((const __m128i *)(const void *)(P))
+#define H5Z_SHUFFLE_STORE_sse2(P, V) _mm_storeu_si128((__m128i *)(void *)(P), V)
+
+/* AVX2 primitives.  The packing and unpacking instructions work within each
+ * 128-bit lane, so the 64-bit pieces of their results are put back in order. */
+H5Z_SHUFFLE_INLINE("avx2") __m256i H5Z__shuffle_even_avx2(__m256i a, __m256i b)
+{
+    const __m256i mask = _mm256_set1_epi16(0x00FF);
+
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask)),
+                                    0xD8);
+}
+H5Z_SHUFFLE_INLINE("avx2") __m256i H5Z__shuffle_odd_avx2(__m256i a, __m256i b)
+{
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8)),
+                                    0xD8);
+}
+H5Z_SHUFFLE_INLINE("avx2") __m256i H5Z__shuffle_ilo_avx2(__m256i even, __m256i odd)
+{
+    return _mm256_permute2x128_si256(_mm256_unpacklo_epi8(even, odd), _mm256_unpackhi_epi8(even, odd), 0x20);
+}
+H5Z_SHUFFLE_INLINE("avx2") __m256i H5Z__shuffle_ihi_avx2(__m256i even, __m256i odd)
+{
+    return _mm256_permute2x128_si256(_mm256_unpacklo_epi8(even, odd), _mm256_unpackhi_epi8(even, odd), 0x31);
+}
+#define H5Z_SHUFFLE_LOAD_avx2(P)     _mm256_loadu_si256((const __m256i *)(const void *)(P))
+#define H5Z_SHUFFLE_STORE_avx2(P, V) _mm256_storeu_si256((__m256i *)(void *)(P), V)
+
+/* AVX-512 primitives, with the same fix-ups as AVX2 over four lanes.  The
+ * zero-masked permute with a full mask avoids a false "may be used
+ * uninitialized" warning from GCC's header for the unmasked one. */
+H5Z_SHUFFLE_INLINE("avx512f,avx512bw") __m512i H5Z__shuffle_even_avx512(__m512i a, __m512i b)
+{
+    const __m512i mask = _mm512_set1_epi16(0x00FF);
+
+    return _mm512_maskz_permutexvar_epi64(
+        0xFF, _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0),
+        _mm512_packus_epi16(_mm512_and_si512(a, mask), _mm512_and_si512(b, mask)));
+}
+H5Z_SHUFFLE_INLINE("avx512f,avx512bw") __m512i H5Z__shuffle_odd_avx512(__m512i a, __m512i b)
+{
+    return _mm512_maskz_permutexvar_epi64(
+        0xFF, _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0),
+        _mm512_packus_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8)));
+}
+H5Z_SHUFFLE_INLINE("avx512f,avx512bw") __m512i H5Z__shuffle_ilo_avx512(__m512i even, __m512i odd)
+{
+    return _mm512_permutex2var_epi64(_mm512_unpacklo_epi8(even, odd),
+                                     _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0),
+                                     _mm512_unpackhi_epi8(even, odd));
+}
+H5Z_SHUFFLE_INLINE("avx512f,avx512bw") __m512i H5Z__shuffle_ihi_avx512(__m512i even, __m512i odd)
+{
+    return _mm512_permutex2var_epi64(_mm512_unpacklo_epi8(even, odd),
+                                     _mm512_set_epi64(15, 14, 7, 6, 13, 12, 5, 4),
+                                     _mm512_unpackhi_epi8(even, odd));
+}
+#define H5Z_SHUFFLE_LOAD_avx512(P)     _mm512_loadu_si512((const void *)(P))
+#define H5Z_SHUFFLE_STORE_avx512(P, V) _mm512_storeu_si512((void *)(P), V)
+
+/* Define the shuffle and unshuffle kernels for an instruction set.  The block
+ * routines are inlined into a switch on the element size, so the rounds are
+ * unrolled and the registers of a block stay in registers.  The kernels
+ * return the number of elements they handled, which is zero for element sizes
+ * without a vector kernel. */
+#define H5Z_SHUFFLE_KERNELS(ISA, TARGET, VEC, WIDTH)                                                         \
+    H5Z_SHUFFLE_BLOCK(TARGET) void H5Z__shuffle_blocks_##ISA(unsigned char *dest, const unsigned char *src,  \
+                                                             unsigned size, unsigned lg, size_t nelmts,      \
+                                                             size_t nblocks, VEC *v, VEC *t)                 \
+    {                                                                                                        \
+        size_t   b;                                                                                          \
+        unsigned n, s, j;                                                                                    \
+                                                                                                             \
+        for (b = 0; b < nblocks; b++) {                                                                      \
+            H5Z_SHUFFLE_UNROLL                                                                               \
+            for (j = 0; j < size; j++)                                                                       \
+                v[j] = H5Z_SHUFFLE_LOAD_##ISA(src + ((b * size) + j) * (WIDTH));                             \
+            H5Z_SHUFFLE_UNROLL                                                                               \
+            for (n = size; n > 1; n /= 2)                                                                    \
+                H5Z_SHUFFLE_UNROLL                                                                           \
+                for (s = 0; s < size; s += n) {                                                              \
+                    H5Z_SHUFFLE_UNROLL                                                                       \
+                    for (j = 0; j < n / 2; j++) {                                                            \
+                        t[j]         = H5Z__shuffle_even_##ISA(v[s + 2 * j], v[s + 2 * j + 1]);              \
+                        t[n / 2 + j] = H5Z__shuffle_odd_##ISA(v[s + 2 * j], v[s + 2 * j + 1]);               \
+                    }                                                                                        \
+                    H5Z_SHUFFLE_UNROLL                                                                       \
+                    for (j = 0; j < n; j++)                                                                  \
+                        v[s + j] = t[j];                                                                     \
+                }                                                                                            \
+            H5Z_SHUFFLE_UNROLL                                                                               \
+            for (j = 0; j < size; j++)                                                                       \
+                H5Z_SHUFFLE_STORE_##ISA(dest + (H5Z_shuffle_pos_g[lg][j] * nelmts) + (b * (WIDTH)), v[j]);   \
+        }                                                                                                    \
+    }                                                                                                        \
+                                                                                                             \
+    H5Z_SHUFFLE_BLOCK(TARGET) void H5Z__unshuffle_blocks_##ISA(                                              \
+        unsigned char *dest, const unsigned char *src, unsigned size, unsigned lg, size_t nelmts,            \
+        size_t nblocks, VEC *v, VEC *t)                                                                      \
+    {                                                                                                        \
+        size_t   b;                                                                                          \
+        unsigned n, s, j;                                                                                    \
+                                                                                                             \
+        for (b = 0; b < nblocks; b++) {                                                                      \
+            H5Z_SHUFFLE_UNROLL                                                                               \
+            for (j = 0; j < size; j++)                                                                       \
+                v[j] = H5Z_SHUFFLE_LOAD_##ISA(src + (H5Z_shuffle_pos_g[lg][j] * nelmts) + (b * (WIDTH)));    \
+            H5Z_SHUFFLE_UNROLL                                                                               \
+            for (n = 2; n <= size; n *= 2)                                                                   \
+                H5Z_SHUFFLE_UNROLL                                                                           \
+                for (s = 0; s < size; s += n) {                                                              \
+                    H5Z_SHUFFLE_UNROLL                                                                       \
+                    for (j = 0; j < n / 2; j++) {                                                            \
+                        t[2 * j]     = H5Z__shuffle_ilo_##ISA(v[s + j], v[s + n / 2 + j]);                   \
+                        t[2 * j + 1] = H5Z__shuffle_ihi_##ISA(v[s + j], v[s + n / 2 + j]);                   \
+                    }                                                                                        \
+                    H5Z_SHUFFLE_UNROLL                                                                       \
+                    for (j = 0; j < n; j++)                                                                  \
+                        v[s + j] = t[j];                                                                     \
+                }                                                                                            \
+            H5Z_SHUFFLE_UNROLL                                                                               \
+            for (j = 0; j < size; j++)                                                                       \
+                H5Z_SHUFFLE_STORE_##ISA(dest + ((b * size) + j) * (WIDTH), v[j]);                            \
+        }                                                                                                    \
+    }                                                                                                        \
+                                                                                                             \
+    static __attribute__((target(TARGET))) size_t H5Z__shuffle_##ISA(                                        \
+        unsigned char *dest, const unsigned char *src, unsigned size, size_t nelmts, hbool_t reverse)        \
+    {                                                                                                        \
+        VEC    v[H5Z_SHUFFLE_VEC_MAX_SIZE];  /* Registers of a block */                                      \
+        VEC    t[H5Z_SHUFFLE_VEC_MAX_SIZE];  /* Registers of a round */                                      \
+        size_t nblocks = nelmts / (WIDTH);   /* Number of whole blocks */                                    \
+                                                                                                             \
+        switch (size) {                                                                                      \
+            case 2:                                                                                          \
+                if (reverse)                                                                                 \
+                    H5Z__unshuffle_blocks_##ISA(dest, src, 2, 1, nelmts, nblocks, v, t);                     \
+                else                                                                                         \
+                    H5Z__shuffle_blocks_##ISA(dest, src, 2, 1, nelmts, nblocks, v, t);                       \
+                break;                                                                                       \
+            case 4:                                                                                          \
+                if (reverse)                                                                                 \
+                    H5Z__unshuffle_blocks_##ISA(dest, src, 4, 2, nelmts, nblocks, v, t);                     \
+                else                                                                                         \
+                    H5Z__shuffle_blocks_##ISA(dest, src, 4, 2, nelmts, nblocks, v, t);                       \
+                break;                                                                                       \
+            case 8:                                                                                          \
+                if (reverse)                                                                                 \
+                    H5Z__unshuffle_blocks_##ISA(dest, src, 8, 3, nelmts, nblocks, v, t);                     \
+                else                                                                                         \
+                    H5Z__shuffle_blocks_##ISA(dest, src, 8, 3, nelmts, nblocks, v, t);                       \
+                break;                                                                                       \
+            case 16:                                                                                         \
+                if (reverse)                                                                                 \
+                    H5Z__unshuffle_blocks_##ISA(dest, src, 16, 4, nelmts, nblocks, v, t);                    \
+                else                                                                                         \
+                    H5Z__shuffle_blocks_##ISA(dest, src, 16, 4, nelmts, nblocks, v, t);                      \
+                break;                                                                                       \
+            default:                                                                                         \
+                return 0;                                                                                    \
+        }                                                                                                    \
+                                                                                                             \
+        return nblocks * (WIDTH);                                                                            \
+    }
+
+H5Z_SHUFFLE_KERNELS(sse2, "sse2", __m128i, 16)
+H5Z_SHUFFLE_KERNELS(avx2, "avx2", __m256i, 32)
+H5Z_SHUFFLE_KERNELS(avx512, "avx512f,avx512bw", __m512i, 64)
+
+/*
+ * The vector bit shuffle kernels take one vector of bytes of a byte plane at
+ * a time.  Shuffling collects one bit of every byte into a mask with the
+ * byte "movemask" (or AVX-512 "test") instructions, which gives the bytes of
+ * that bit plane for all the groups of 8 bytes in the vector.  Unshuffling
+ * spreads each bit of those bytes back into a byte of the vector and
+ * accumulates the bits of the eight bit planes.  The kernels return the
+ * number of bytes they handled, a multiple of the vector width.
+ */
+
+static __attribute__((target("sse2"))) size_t
+H5Z__bitshuffle_plane_sse2(unsigned char *dest, const unsigned char *src, size_t nbytes, hbool_t reverse)
+{
+    size_t   ngroups = nbytes / 8;
+    size_t   end     = nbytes - (nbytes % 16);
+    size_t   p;
+    unsigned k;
+
+    if (reverse) {
+        /* Bit J of each byte selects byte J of each group of 8 bytes */
+        const __m128i bits = _mm_set1_epi64x((long long)0x8040201008040201ULL);
+
+        for (p = 0; p < end; p += 16) {
+            __m128i v = _mm_setzero_si128();
+
+            for (k = 0; k < 8; k++) {
+                const unsigned char *b = src + (k * ngroups) + (p / 8);
+                __m128i              m = _mm_set_epi64x((long long)(0x0101010101010101ULL * b[1]),
+                                                        (long long)(0x0101010101010101ULL * b[0]));
+
+                m = _mm_cmpeq_epi8(_mm_and_si128(m, bits), bits);
+                v = _mm_or_si128(v, _mm_and_si128(m, _mm_set1_epi8((char)(1 << k))));
+            } /* end for */
+            H5Z_SHUFFLE_STORE_sse2(dest + p, v);
+        } /* end for */
+    }     /* end if */
+    else
+        for (p = 0; p < end; p += 16) {
+            __m128i v = H5Z_SHUFFLE_LOAD_sse2(src + p);
+
+            /* The sign bits come out first, so go from bit 7 down */
+            for (k = 8; k-- > 0;) {
+                unsigned mask = (unsigned)_mm_movemask_epi8(v);
+
+                dest[(k * ngroups) + (p / 8)]     = (unsigned char)mask;
+                dest[(k * ngroups) + (p / 8) + 1] = (unsigned char)(mask >> 8);
+                v                                 = _mm_add_epi8(v, v);
+            } /* end for */
+        }     /* end for */
+
+    return end;
+}
+
+static __attribute__((target("avx2"))) size_t
+H5Z__bitshuffle_plane_avx2(unsigned char *dest, const unsigned char *src, size_t nbytes, hbool_t reverse)
+{
+    size_t   ngroups = nbytes / 8;
+    size_t   end     = nbytes - (nbytes % 32);
+    size_t   p;
+    unsigned k;
+
+    if (reverse) {
+        const __m256i bits = _mm256_set1_epi64x((long long)0x8040201008040201ULL);
+
+        for (p = 0; p < end; p += 32) {
+            __m256i v = _mm256_setzero_si256();
+
+            for (k = 0; k < 8; k++) {
+                const unsigned char *b = src + (k * ngroups) + (p / 8);
+                __m256i              m = _mm256_set_epi64x((long long)(0x0101010101010101ULL * b[3]),
+                                                           (long long)(0x0101010101010101ULL * b[2]),
+                                                           (long long)(0x0101010101010101ULL * b[1]),
+                                                           (long long)(0x0101010101010101ULL * b[0]));
+
+                m = _mm256_cmpeq_epi8(_mm256_and_si256(m, bits), bits);
+                v = _mm256_or_si256(v, _mm256_and_si256(m, _mm256_set1_epi8((char)(1 << k))));
+            } /* end for */
+            H5Z_SHUFFLE_STORE_avx2(dest + p, v);
+        } /* end for */
+    }     /* end if */
+    else
+        for (p = 0; p < end; p += 32) {
+            __m256i v = H5Z_SHUFFLE_LOAD_avx2(src + p);
+
+            for (k = 8; k-- > 0;) {
+                uint32_t mask = (uint32_t)_mm256_movemask_epi8(v);
+
+                HDmemcpy(dest + (k * ngroups) + (p / 8), &mask, sizeof(mask));
+                v = _mm256_add_epi8(v, v);
+            } /* end for */
+        }     /* end for */
+
+    return end;
+}
+
+static __attribute__((target("avx512f,avx512bw"))) size_t
+H5Z__bitshuffle_plane_avx512(unsigned char *dest, const unsigned char *src, size_t nbytes, hbool_t reverse)
+{
+    size_t   ngroups = nbytes / 8;
+    size_t   end     = nbytes - (nbytes % 64);
+    size_t   p;
+    unsigned k;
+
+    if (reverse)
+        for (p = 0; p < end; p += 64) {
+            __m512i v = _mm512_setzero_si512();
+
+            for (k = 0; k < 8; k++) {
+                __mmask64 mask;
+
+                HDmemcpy(&mask, src + (k * ngroups) + (p / 8), sizeof(mask));
+                v = _mm512_or_si512(v, _mm512_maskz_mov_epi8(mask, _mm512_set1_epi8((char)(1 << k))));
+            } /* end for */
+            H5Z_SHUFFLE_STORE_avx512(dest + p, v);
+        } /* end for */
+    else
+        for (p = 0; p < end; p += 64) {
+            __m512i v = H5Z_SHUFFLE_LOAD_avx512(src + p);
+
+            for (k = 0; k < 8; k++) {
+                __mmask64 mask = _mm512_test_epi8_mask(v, _mm512_set1_epi8((char)(1 << k)));
+
+                HDmemcpy(dest + (k * ngroups) + (p / 8), &mask, sizeof(mask));
+            } /* end for */
+        }     /* end for */
+
+    return end;
+}
+
+#endif /* H5Z_SHUFFLE_HAVE_X86 */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_best_isa
+ *
+ * Purpose:	Determine the widest instruction set with shuffle kernels
+ *              that the CPU supports.  The CPU is checked on the first
+ *              call only.
+ *
+ * Return:	The instruction set (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5Z_shuffle_isa_t
+H5Z__shuffle_best_isa(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (H5Z_shuffle_isa_g == H5Z_SHUFFLE_ISA_NTYPES) {
+        H5Z_shuffle_isa_t isa = H5Z_SHUFFLE_ISA_SCALAR;
+
+#ifdef H5Z_SHUFFLE_HAVE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            isa = H5Z_SHUFFLE_ISA_AVX512;
+        else if (__builtin_cpu_supports("avx2"))
+            isa = H5Z_SHUFFLE_ISA_AVX2;
+        else if (__builtin_cpu_supports("sse2"))
+            isa = H5Z_SHUFFLE_ISA_SSE2;
+#endif /* H5Z_SHUFFLE_HAVE_X86 */
+
+        H5Z_shuffle_isa_g = isa;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(H5Z_shuffle_isa_g)
+} /* end H5Z__shuffle_best_isa() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_bytes
+ *
+ * Purpose:	Shuffle (or unshuffle, if REVERSE is set) the NELMTS
+ *              elements of ELMT_SIZE bytes in SRC into DEST, using the
+ *              kernels of the instruction set ISA.  Element sizes of 2, 4,
+ *              8 and 16 bytes are shuffled with vector instructions, up to
+ *              the last partial vector of elements, and the rest with the
+ *              scalar loops.
+ *
+ *              The buffers must not overlap.  Any bytes after the last
+ *              whole element are left to the caller.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z__shuffle_bytes(H5Z_shuffle_isa_t isa, hbool_t reverse, unsigned elmt_size, size_t nelmts,
+                   const void *src, void *dest)
+{
+    const unsigned char *_src      = (const unsigned char *)src; /* Alias for source buffer */
+    unsigned char       *_dest     = (unsigned char *)dest;      /* Alias for destination buffer */
+    size_t               first     = 0;                          /* First element left to the scalar loops */
+    herr_t               ret_value = SUCCEED;                    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(src);
+    HDassert(dest);
+    HDassert(elmt_size > 0);
+
+    if (isa > H5Z__shuffle_best_isa())
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "instruction set not supported by CPU")
+
+    switch (isa) {
+#ifdef H5Z_SHUFFLE_HAVE_X86
+        case H5Z_SHUFFLE_ISA_AVX512:
+            first = H5Z__shuffle_avx512(_dest, _src, elmt_size, nelmts, reverse);
+            break;
+
+        case H5Z_SHUFFLE_ISA_AVX2:
+            first = H5Z__shuffle_avx2(_dest, _src, elmt_size, nelmts, reverse);
+            break;
+
+        case H5Z_SHUFFLE_ISA_SSE2:
+            first = H5Z__shuffle_sse2(_dest, _src, elmt_size, nelmts, reverse);
+            break;
+#endif /* H5Z_SHUFFLE_HAVE_X86 */
+
+        case H5Z_SHUFFLE_ISA_SCALAR:
+        default:
+            break;
+    } /* end switch */
+
+    /* Shuffle the elements after the last whole vector */
+    if (reverse)
+        H5Z__unshuffle_scalar(_dest, _src, elmt_size, nelmts, first);
+    else
+        H5Z__shuffle_scalar(_dest, _src, elmt_size, nelmts, first);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__shuffle_bytes() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_bytes
+ *
+ * Purpose:	Shuffle (or unshuffle, if REVERSE is set) the bits of the
+ *              NELMTS elements of ELMT_SIZE bytes in SRC into DEST, using
+ *              the kernels of the instruction set ISA.
+ *
+ *              The elements of whole groups of 8 are byte shuffled, and
+ *              then each of the ELMT_SIZE byte planes is split into 8 bit
+ *              planes (see H5Z__bitshuffle_plane_scalar).  The elements
+ *              after the last whole group are copied as they are.
+ *
+ *              The buffers must not overlap.  Any bytes after the last
+ *              whole element are left to the caller.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z__bitshuffle_bytes(H5Z_shuffle_isa_t isa, hbool_t reverse, unsigned elmt_size, size_t nelmts,
+                      const void *src, void *dest)
+{
+    const unsigned char *_src         = (const unsigned char *)src; /* Alias for source buffer */
+    unsigned char       *_dest        = (unsigned char *)dest;      /* Alias for destination buffer */
+    unsigned char       *tmp          = NULL;    /* Byte planes, for elements larger than a byte */
+    size_t               nplane_bytes = 0;       /* Number of bytes in each byte plane */
+    unsigned             u;                      /* Local index variable */
+    herr_t               ret_value    = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(src);
+    HDassert(dest);
+    HDassert(elmt_size > 0);
+
+    if (isa > H5Z__shuffle_best_isa())
+        HGOTO_ERROR(H5E_ARGS, H5E_UNSUPPORTED, FAIL, "instruction set not supported by CPU")
+
+    /* Each byte plane holds one byte of each element of the whole groups */
+    nplane_bytes = nelmts - (nelmts % 8);
+
+    if (nplane_bytes > 0) {
+        const unsigned char *planes_in;  /* Byte planes to shuffle bits of */
+        unsigned char       *planes_out; /* Byte planes with unshuffled bits */
+
+        /* Single bytes are their own byte plane */
+        if (elmt_size > 1) {
+            if (NULL == (tmp = (unsigned char *)H5Z_buf_malloc(nplane_bytes * elmt_size)))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for bitshuffle buffer")
+
+            if (!reverse)
+                if (H5Z__shuffle_bytes(isa, FALSE, elmt_size, nplane_bytes, _src, tmp) < 0)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "can't shuffle bytes")
+        } /* end if */
+        planes_in  = (reverse || elmt_size == 1) ? _src : tmp;
+        planes_out = (reverse && elmt_size > 1) ? tmp : _dest;
+
+        for (u = 0; u < elmt_size; u++) {
+            const unsigned char *plane_in  = planes_in + (u * nplane_bytes);
+            unsigned char       *plane_out = planes_out + (u * nplane_bytes);
+            size_t               first     = 0; /* First byte left to the scalar loop */
+
+            switch (isa) {
+#ifdef H5Z_SHUFFLE_HAVE_X86
+                case H5Z_SHUFFLE_ISA_AVX512:
+                    first = H5Z__bitshuffle_plane_avx512(plane_out, plane_in, nplane_bytes, reverse);
+                    break;
+
+                case H5Z_SHUFFLE_ISA_AVX2:
+                    first = H5Z__bitshuffle_plane_avx2(plane_out, plane_in, nplane_bytes, reverse);
+                    break;
+
+                case H5Z_SHUFFLE_ISA_SSE2:
+                    first = H5Z__bitshuffle_plane_sse2(plane_out, plane_in, nplane_bytes, reverse);
+                    break;
+#endif /* H5Z_SHUFFLE_HAVE_X86 */
+
+                case H5Z_SHUFFLE_ISA_SCALAR:
+                default:
+                    break;
+            } /* end switch */
+
+            H5Z__bitshuffle_plane_scalar(plane_out, plane_in, nplane_bytes, first, reverse);
+        } /* end for */
+
+        if (reverse && elmt_size > 1)
+            if (H5Z__shuffle_bytes(isa, TRUE, elmt_size, nplane_bytes, tmp, _dest) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "can't unshuffle bytes")
+    } /* end if */
+
+    /* Copy the elements after the last whole group */
+    if (nplane_bytes < nelmts)
+        H5MM_memcpy(_dest + (nplane_bytes * elmt_size), _src + (nplane_bytes * elmt_size),
+                    (nelmts - nplane_bytes) * elmt_size);
+
+done:
+    H5Z_buf_free(tmp, nplane_bytes * elmt_size);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__bitshuffle_bytes() */
+
 /*-------------------------------------------------------------------------
  * Function:	H5Z__filter_shuffle
  *
@@ -102,6 +934,12 @@ done:
  *              Usually, the bytes in each byte position are more related to
  *              each other and putting them together will increase compression.
  *
+ *              In the bit mode, the bits in a bit-position for each
+ *              element are put together instead, for groups of 8 elements.
+ *
+ *              The bytes are moved with the widest vector kernels that
+ *              the CPU supports.
+ *
  * Return:	Success: Size of buffer filtered
  *		Failure: 0
  *
@@ -114,193 +952,71 @@ static size_t
 H5Z__filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], size_t nbytes,
                     size_t *buf_size, void **buf)
 {
-    void          *dest  = NULL;  /* Buffer to deposit [un]shuffled bytes into */
-    unsigned char *_src  = NULL;  /* Alias for source buffer */
-    unsigned char *_dest = NULL;  /* Alias for destination buffer */
-    unsigned       bytesoftype;   /* Number of bytes per element */
-    size_t         numofelements; /* Number of elements in buffer */
-    size_t         i;             /* Local index variables */
-#ifdef NO_DUFFS_DEVICE
-    size_t j;             /* Local index variable */
-#endif                    /* NO_DUFFS_DEVICE */
-    size_t leftover;      /* Extra bytes at end of buffer */
-    size_t ret_value = 0; /* Return value */
+    void    *dest = NULL;   /* Buffer to deposit [un]shuffled bytes into */
+    unsigned bytesoftype;   /* Number of bytes per element */
+    unsigned mode;          /* Byte or bit shuffle */
+    size_t   numofelements; /* Number of elements in buffer */
+    size_t   leftover;      /* Extra bytes at end of buffer */
+    size_t   ret_value = 0; /* Return value */
 
     FUNC_ENTER_PACKAGE
 
     /* Check arguments */
-    if (cd_nelmts != H5Z_SHUFFLE_TOTAL_NPARMS || cd_values[H5Z_SHUFFLE_PARM_SIZE] == 0)
+    if ((cd_nelmts != H5Z_SHUFFLE_TOTAL_NPARMS && cd_nelmts != H5Z_SHUFFLE_MAX_NPARMS) ||
+        cd_values[H5Z_SHUFFLE_PARM_SIZE] == 0)
         HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid shuffle parameters")
 
     /* Get the number of bytes per element from the parameter block */
     bytesoftype = cd_values[H5Z_SHUFFLE_PARM_SIZE];
 
+    /* Get the mode, which is only stored for the bit mode */
+    mode = (cd_nelmts > H5Z_SHUFFLE_PARM_MODE) ? cd_values[H5Z_SHUFFLE_PARM_MODE] : H5Z_SHUFFLE_MODE_BYTE;
+    if (mode != H5Z_SHUFFLE_MODE_BYTE && mode != H5Z_SHUFFLE_MODE_BIT)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid shuffle mode")
+
     /* Compute the number of elements in buffer */
     numofelements = nbytes / bytesoftype;
 
-    /* Don't do anything for 1-byte elements, or "fractional" elements */
-    if (bytesoftype > 1 && numofelements > 1) {
+    /* Don't do anything for 1-byte elements, or "fractional" elements, when
+     * shuffling bytes, or for less than a group of elements when shuffling bits */
+    if (mode == H5Z_SHUFFLE_MODE_BIT ? numofelements >= 8 : (bytesoftype > 1 && numofelements > 1)) {
         /* Compute the leftover bytes if there are any */
         leftover = nbytes % bytesoftype;
 
         /* Allocate the destination buffer */
-        if (NULL == (dest = H5MM_malloc(nbytes)))
+        if (NULL == (dest = H5Z_buf_malloc(nbytes)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for shuffle buffer")
 
-        if (flags & H5Z_FLAG_REVERSE) {
-            /* Get the pointer to the source buffer */
-            _src = (unsigned char *)(*buf);
-
-            /* Input; unshuffle */
-            for (i = 0; i < bytesoftype; i++) {
-                _dest = ((unsigned char *)dest) + i;
-#define DUFF_GUTS                                                                                            \
-    *_dest = *_src++;                                                                                        \
-    _dest += bytesoftype;
-#ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while (j > 0) {
-                    DUFF_GUTS;
-
-                    j--;
-                } /* end for */
-#else             /* NO_DUFFS_DEVICE */
-                {
-                    size_t duffs_index; /* Counting index for Duff's device */
-
-                    duffs_index = (numofelements + 7) / 8;
-                    switch (numofelements % 8) {
-                        default:
-                            HDassert(0 && "This Should never be executed!");
-                            break;
-                        case 0:
-                            do {
-                                DUFF_GUTS
-                                /* FALLTHROUGH */
-                                H5_ATTR_FALLTHROUGH
-                                case 7:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 6:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 5:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 4:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 3:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 2:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 1:
-                                    DUFF_GUTS
-                            } while (--duffs_index > 0);
-                    } /* end switch */
-                }
-#endif            /* NO_DUFFS_DEVICE */
-#undef DUFF_GUTS
-            } /* end for */
-
-            /* Add leftover to the end of data */
-            if (leftover > 0) {
-                /* Adjust back to end of shuffled bytes */
-                _dest -= (bytesoftype - 1); /*lint !e794 _dest is initialized */
-                H5MM_memcpy((void *)_dest, (void *)_src, leftover);
-            }
+        /* Input; unshuffle, or output; shuffle */
+        if (mode == H5Z_SHUFFLE_MODE_BIT) {
+            if (H5Z__bitshuffle_bytes(H5Z__shuffle_best_isa(), (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0),
+                                      bytesoftype, numofelements, *buf, dest) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "can't shuffle bits of data")
         } /* end if */
-        else {
-            /* Get the pointer to the destination buffer */
-            _dest = (unsigned char *)dest;
-
-            /* Output; shuffle */
-            for (i = 0; i < bytesoftype; i++) {
-                _src = ((unsigned char *)(*buf)) + i;
-#define DUFF_GUTS                                                                                            \
-    *_dest++ = *_src;                                                                                        \
-    _src += bytesoftype;
-#ifdef NO_DUFFS_DEVICE
-                j = numofelements;
-                while (j > 0) {
-                    DUFF_GUTS;
-
-                    j--;
-                } /* end for */
-#else             /* NO_DUFFS_DEVICE */
-                {
-                    size_t duffs_index; /* Counting index for Duff's device */
-
-                    duffs_index = (numofelements + 7) / 8;
-                    switch (numofelements % 8) {
-                        default:
-                            HDassert(0 && "This Should never be executed!");
-                            break;
-                        case 0:
-                            do {
-                                DUFF_GUTS
-                                /* FALLTHROUGH */
-                                H5_ATTR_FALLTHROUGH
-                                case 7:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 6:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 5:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 4:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 3:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 2:
-                                    DUFF_GUTS
-                                    /* FALLTHROUGH */
-                                    H5_ATTR_FALLTHROUGH
-                                case 1:
-                                    DUFF_GUTS
-                            } while (--duffs_index > 0);
-                    } /* end switch */
-                }
-#endif            /* NO_DUFFS_DEVICE */
-#undef DUFF_GUTS
-            } /* end for */
+        else if (H5Z__shuffle_bytes(H5Z__shuffle_best_isa(), (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0),
+                                    bytesoftype, numofelements, *buf, dest) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "can't shuffle data")
 
-            /* Add leftover to the end of data */
-            if (leftover > 0) {
-                /* Adjust back to end of shuffled bytes */
-                _src -= (bytesoftype - 1); /*lint !e794 _src is initialized */
-                H5MM_memcpy((void *)_dest, (void *)_src, leftover);
-            }
-        } /* end else */
+        /* Add leftover to the end of data */
+        if (leftover > 0)
+            H5MM_memcpy((unsigned char *)dest + (nbytes - leftover),
+                        (unsigned char *)(*buf) + (nbytes - leftover), leftover);
 
         /* Free the input buffer */
-        H5MM_xfree(*buf);
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set the buffer information to return */
         *buf      = dest;
         *buf_size = nbytes;
-    } /* end else */
+        dest      = NULL;
+    } /* end if */
 
     /* Set the return value */
     ret_value = nbytes;
 
 done:
+    if (dest)
+        H5MM_xfree(dest);
+
     FUNC_LEAVE_NOAPI(ret_value)
 }
@@ -300,7 +300,7 @@ H5Z__filter_szip(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
         H5_CHECKED_ASSIGN(nalloc, size_t, stored_nalloc, uint32_t);
 
         /* Allocate space for the uncompressed buffer */
-        if (NULL == (outbuf = (unsigned char *)H5MM_malloc(nalloc)))
+        if (NULL == (outbuf = (unsigned char *)H5Z_buf_malloc(nalloc)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for szip decompression")
 
         /* Decompress the buffer */
@@ -310,7 +310,7 @@ H5Z__filter_szip(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
         HDassert(size_out == nalloc);
 
         /* Free the input buffer */
-        H5MM_xfree(*buf);
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
         *buf      = outbuf;
@@ -323,7 +323,7 @@ H5Z__filter_szip(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
         unsigned char *dst = NULL; /* Temporary pointer to new output buffer */
 
         /* Allocate space for the compressed buffer & header (assume data won't get bigger) */
-        if (NULL == (dst = outbuf = (unsigned char *)H5MM_malloc(nbytes + 4)))
+        if (NULL == (dst = outbuf = (unsigned char *)H5Z_buf_malloc(nbytes + 4)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate szip destination buffer")
 
         /* Encode the uncompressed length */
@@ -337,7 +337,7 @@ H5Z__filter_szip(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], s
         HDassert(size_out <= nbytes);
 
         /* Free the input buffer */
-        H5MM_xfree(*buf);
+        H5Z_buf_free(*buf, *buf_size);
 
         /* Set return values */
         *buf      = outbuf;
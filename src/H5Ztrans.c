@@ -53,10 +53,28 @@ typedef struct H5Z_node {
     H5Z_num_val      value;
 } H5Z_node;
 
+/* Instructions of a compiled transform */
+typedef enum {
+    H5Z_XFORM_OP_LOAD,       /* Push a copy of the data onto the register stack */
+    H5Z_XFORM_OP_DATA_CONST, /* Replace the top register with (top OP value) */
+    H5Z_XFORM_OP_CONST_DATA, /* Replace the top register with (value OP top) */
+    H5Z_XFORM_OP_DATA_DATA   /* Pop the top register and replace the next with (next OP top) */
+} H5Z_xform_opcode_t;
+
+/* An instruction of a compiled transform */
+typedef struct H5Z_xform_instr_t {
+    H5Z_xform_opcode_t code;  /* What the instruction does */
+    H5Z_token_type     op;    /* Arithmetic operation: PLUS, MINUS, MULT or DIVIDE */
+    double             value; /* Constant operand, for DATA_CONST and CONST_DATA */
+} H5Z_xform_instr_t;
+
 struct H5Z_data_xform_t {
-    char            *xform_exp;
-    H5Z_node        *parse_root;
-    H5Z_datval_ptrs *dat_val_pointers;
+    char              *xform_exp;
+    H5Z_node          *parse_root;
+    H5Z_datval_ptrs   *dat_val_pointers;
+    H5Z_xform_instr_t *prog;       /* Parse tree compiled to a stack program (NULL if not compiled) */
+    size_t             prog_len;   /* Number of instructions in the program */
+    unsigned           prog_depth; /* Most registers the program uses at once */
 };
 
 typedef struct result {
@@ -95,6 +113,12 @@ static void      *H5Z__xform_parse(const char *expression, H5Z_datval_ptrs *dat_
 static void      *H5Z__xform_copy_tree(H5Z_node *tree, H5Z_datval_ptrs *dat_val_pointers,
                                        H5Z_datval_ptrs *new_dat_val_pointers);
 static void       H5Z__xform_reduce_tree(H5Z_node *tree);
+static size_t     H5Z__xform_count_nodes(const H5Z_node *tree);
+static hbool_t    H5Z__xform_compile_node(const H5Z_node *tree, H5Z_data_xform_t *data_xform_prop,
+                                          unsigned *depth);
+static herr_t     H5Z__xform_compile(H5Z_data_xform_t *data_xform_prop);
+static herr_t     H5Z__xform_eval_prog(const H5Z_data_xform_t *data_xform_prop, void *array,
+                                       size_t array_size, hid_t array_type);
 
 /* PGCC (11.8-0) has trouble with the command *p++ = *p OP tree_val. It increments P first before
  * doing the operation.  So I break down the command into two lines:
@@ -304,6 +328,90 @@ static void       H5Z__xform_reduce_tree(H5Z_node *tree);
         }                                                                                                    \
     }
 
+/* Number of elements a compiled transform is run on at a time, small enough for the registers of most
+ * programs to stay in the L1 cache between instructions */
+#define H5Z_XFORM_BLOCK 512
+
+/* Run the instruction INSTR, whose operation is OP, on N values of TYPE in the registers REGL and REGR.
+ * Like H5Z_XFORM_DO_OP1, each result is converted to TYPE, and operations with a constant are done in
+ * double precision. */
+#define H5Z_XFORM_EXEC_OP(INSTR, TYPE, OP, REGL, REGR, N)                                                    \
+    {                                                                                                        \
+        size_t u;                                                                                            \
+                                                                                                             \
+        if ((INSTR)->code == H5Z_XFORM_OP_DATA_CONST) {                                                      \
+            double tree_val = (INSTR)->value;                                                                \
+                                                                                                             \
+            for (u = 0; u < (N); u++)                                                                        \
+                (REGL)[u] = (TYPE)((double)(REGL)[u] OP tree_val);                                           \
+        }                                                                                                    \
+        else if ((INSTR)->code == H5Z_XFORM_OP_CONST_DATA) {                                                 \
+            double tree_val = (INSTR)->value;                                                                \
+                                                                                                             \
+            for (u = 0; u < (N); u++)                                                                        \
+                (REGL)[u] = (TYPE)(tree_val OP(double)(REGL)[u]);                                            \
+        }                                                                                                    \
+        else                                                                                                 \
+            for (u = 0; u < (N); u++)                                                                        \
+                (REGL)[u] = (TYPE)((REGL)[u] OP(REGR)[u]);                                                   \
+    }
+
+/* Run a compiled transform on the ARRAY_SIZE values of TYPE in ARRAY, H5Z_XFORM_BLOCK values at a time.
+ * REGS holds the registers, or is NULL if the program has a single register, which is then the block of
+ * the array itself. */
+#define H5Z_XFORM_RUN_PROG(TYPE)                                                                             \
+    {                                                                                                        \
+        TYPE  *data = (TYPE *)array;                                                                         \
+        TYPE  *reg  = (TYPE *)regs;                                                                          \
+        size_t start, n, v;                                                                                  \
+                                                                                                             \
+        for (start = 0; start < array_size; start += n) {                                                    \
+            unsigned top = 0;                                                                                \
+                                                                                                             \
+            n = MIN(H5Z_XFORM_BLOCK, array_size - start);                                                    \
+            for (v = 0; v < prog_len; v++) {                                                                 \
+                const H5Z_xform_instr_t *instr = &prog[v];                                                   \
+                TYPE                    *regl, *regr;                                                        \
+                                                                                                             \
+                if (instr->code == H5Z_XFORM_OP_LOAD) {                                                      \
+                    if (reg)                                                                                 \
+                        H5MM_memcpy(reg + top * H5Z_XFORM_BLOCK, data + start, n * sizeof(TYPE));            \
+                    top++;                                                                                   \
+                    continue;                                                                                \
+                }                                                                                            \
+                if (instr->code == H5Z_XFORM_OP_DATA_DATA)                                                   \
+                    top--;                                                                                   \
+                regl = reg ? reg + (top - 1) * H5Z_XFORM_BLOCK : data + start;                               \
+                regr = reg ? reg + top * H5Z_XFORM_BLOCK : NULL;                                             \
+                switch (instr->op) {                                                                         \
+                    case H5Z_XFORM_PLUS:                                                                     \
+                        H5Z_XFORM_EXEC_OP(instr, TYPE, +, regl, regr, n)                                     \
+                        break;                                                                               \
+                    case H5Z_XFORM_MINUS:                                                                    \
+                        H5Z_XFORM_EXEC_OP(instr, TYPE, -, regl, regr, n)                                     \
+                        break;                                                                               \
+                    case H5Z_XFORM_MULT:                                                                     \
+                        H5Z_XFORM_EXEC_OP(instr, TYPE, *, regl, regr, n)                                     \
+                        break;                                                                               \
+                    case H5Z_XFORM_DIVIDE:                                                                   \
+                        H5Z_XFORM_EXEC_OP(instr, TYPE, /, regl, regr, n)                                     \
+                        break;                                                                               \
+                    case H5Z_XFORM_ERROR:                                                                    \
+                    case H5Z_XFORM_INTEGER:                                                                  \
+                    case H5Z_XFORM_FLOAT:                                                                    \
+                    case H5Z_XFORM_SYMBOL:                                                                   \
+                    case H5Z_XFORM_LPAREN:                                                                   \
+                    case H5Z_XFORM_RPAREN:                                                                   \
+                    case H5Z_XFORM_END:                                                                      \
+                    default:                                                                                 \
+                        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid transform program")               \
+                }                                                                                            \
+            }                                                                                                \
+            if (reg)                                                                                         \
+                H5MM_memcpy(data + start, reg, n * sizeof(TYPE));                                            \
+        }                                                                                                    \
+    }
+
 /*
  *  Programmer: Bill Wendling
  *              25. August 2003
@@ -999,6 +1107,11 @@ H5Z_xform_eval(H5Z_data_xform_t *data_xform_prop, void *array, size_t array_size
             H5Z_XFORM_DO_OP5(long double, array_size)
 
     } /* end if */
+    /* Otherwise, run the compiled transform, if there's one */
+    else if (data_xform_prop->prog) {
+        if (H5Z__xform_eval_prog(data_xform_prop, array, array_size, array_type) < 0)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "error while performing data transform")
+    } /* end else-if */
     /* Otherwise, do the full data transform */
     else {
         /* Optimization for linear transform: */
@@ -1146,6 +1259,75 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z__xform_eval_full() */
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__xform_eval_prog
+ *
+ * Purpose:     Applies the compiled form of a transform to array, a block
+ *              of elements at a time, so that the intermediate results
+ *              stay in the cache and the loops of each instruction can be
+ *              vectorized.  The results are the same as those of
+ *              H5Z__xform_eval_full().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__xform_eval_prog(const H5Z_data_xform_t *data_xform_prop, void *array, size_t array_size,
+                     hid_t array_type)
+{
+    const H5Z_xform_instr_t *prog     = data_xform_prop->prog;     /* The program */
+    size_t                   prog_len = data_xform_prop->prog_len; /* Number of instructions */
+    void                    *regs     = NULL;                      /* Registers of the program */
+    herr_t                   ret_value = SUCCEED;                  /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(prog);
+
+    /* A program with more than one register can't work in the array itself,
+     * which every load copies from */
+    if (data_xform_prop->prog_depth > 1)
+        if (NULL == (regs = H5MM_malloc(data_xform_prop->prog_depth * H5Z_XFORM_BLOCK *
+                                        H5T_get_size((H5T_t *)H5I_object(array_type)))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL,
+                        "Ran out of memory trying to allocate space for data in data transform")
+
+    if (array_type == H5T_NATIVE_SCHAR)
+        H5Z_XFORM_RUN_PROG(signed char)
+    else if (array_type == H5T_NATIVE_UCHAR)
+        H5Z_XFORM_RUN_PROG(unsigned char)
+    else if (array_type == H5T_NATIVE_SHORT)
+        H5Z_XFORM_RUN_PROG(short)
+    else if (array_type == H5T_NATIVE_USHORT)
+        H5Z_XFORM_RUN_PROG(unsigned short)
+    else if (array_type == H5T_NATIVE_INT)
+        H5Z_XFORM_RUN_PROG(int)
+    else if (array_type == H5T_NATIVE_UINT)
+        H5Z_XFORM_RUN_PROG(unsigned int)
+    else if (array_type == H5T_NATIVE_LONG)
+        H5Z_XFORM_RUN_PROG(long)
+    else if (array_type == H5T_NATIVE_ULONG)
+        H5Z_XFORM_RUN_PROG(unsigned long)
+    else if (array_type == H5T_NATIVE_LLONG)
+        H5Z_XFORM_RUN_PROG(long long)
+    else if (array_type == H5T_NATIVE_ULLONG)
+        H5Z_XFORM_RUN_PROG(unsigned long long)
+    else if (array_type == H5T_NATIVE_FLOAT)
+        H5Z_XFORM_RUN_PROG(float)
+    else if (array_type == H5T_NATIVE_DOUBLE)
+        H5Z_XFORM_RUN_PROG(double)
+    else if (array_type == H5T_NATIVE_LDOUBLE)
+        H5Z_XFORM_RUN_PROG(long double)
+    else
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "Cannot perform data transform on this type.")
+
+done:
+    H5MM_xfree(regs);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__xform_eval_prog() */
+
 /*-------------------------------------------------------------------------
  * Function:    H5Z_find_type
  *
@@ -1432,6 +1614,158 @@ H5Z__do_op(H5Z_node *tree)
     FUNC_LEAVE_NOAPI_VOID
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__xform_count_nodes
+ *
+ * Purpose:     Counts the nodes of a parse tree.
+ *
+ * Return:      Number of nodes (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__xform_count_nodes(const H5Z_node *tree)
+{
+    size_t ret_value = 0; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (tree)
+        ret_value = 1 + H5Z__xform_count_nodes(tree->lchild) + H5Z__xform_count_nodes(tree->rchild);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__xform_count_nodes() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__xform_compile_node
+ *
+ * Purpose:     Appends the instructions that leave the value of the parse
+ *              tree rooted at tree in a new register to the program of
+ *              data_xform_prop.  Constant operands are folded into the
+ *              instruction of their operation, and an operation with no
+ *              left operand (-x or +x) gets 0 as its left operand, as in
+ *              H5Z_XFORM_DO_OP1.  depth is the number of registers in use,
+ *              and is incremented.
+ *
+ * Return:      TRUE if the tree could be compiled, FALSE if it has an
+ *              operation with two constant operands, which the reduction
+ *              of the tree should have folded
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5Z__xform_compile_node(const H5Z_node *tree, H5Z_data_xform_t *data_xform_prop, unsigned *depth)
+{
+    H5Z_xform_instr_t *instr;             /* Instruction appended */
+    const H5Z_node    *lchild, *rchild;   /* Operands */
+    hbool_t            lconst, rconst;    /* Whether the operands are constants */
+    hbool_t            ret_value = FALSE; /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (tree->type == H5Z_XFORM_SYMBOL) {
+        instr       = &data_xform_prop->prog[data_xform_prop->prog_len++];
+        instr->code  = H5Z_XFORM_OP_LOAD;
+        instr->op    = H5Z_XFORM_SYMBOL;
+        instr->value = 0;
+        if (++(*depth) > data_xform_prop->prog_depth)
+            data_xform_prop->prog_depth = *depth;
+        HGOTO_DONE(TRUE)
+    } /* end if */
+
+    if (tree->type != H5Z_XFORM_PLUS && tree->type != H5Z_XFORM_MINUS && tree->type != H5Z_XFORM_MULT &&
+        tree->type != H5Z_XFORM_DIVIDE)
+        HGOTO_DONE(FALSE)
+
+    lchild = tree->lchild;
+    rchild = tree->rchild;
+    lconst = !lchild || lchild->type == H5Z_XFORM_INTEGER || lchild->type == H5Z_XFORM_FLOAT;
+    rconst = !rchild || rchild->type == H5Z_XFORM_INTEGER || rchild->type == H5Z_XFORM_FLOAT;
+    if (lconst && rconst)
+        HGOTO_DONE(FALSE)
+
+    /* Operands that aren't constants leave their values in registers */
+    if (!lconst && !H5Z__xform_compile_node(lchild, data_xform_prop, depth))
+        HGOTO_DONE(FALSE)
+    if (!rconst && !H5Z__xform_compile_node(rchild, data_xform_prop, depth))
+        HGOTO_DONE(FALSE)
+
+    instr     = &data_xform_prop->prog[data_xform_prop->prog_len++];
+    instr->op = tree->type;
+    if (lconst) {
+        instr->code = H5Z_XFORM_OP_CONST_DATA;
+        if (!lchild)
+            instr->value = 0;
+        else
+            instr->value =
+                (lchild->type == H5Z_XFORM_INTEGER ? (double)lchild->value.int_val : lchild->value.float_val);
+    } /* end if */
+    else if (rconst) {
+        instr->code = H5Z_XFORM_OP_DATA_CONST;
+        instr->value =
+            (rchild->type == H5Z_XFORM_INTEGER ? (double)rchild->value.int_val : rchild->value.float_val);
+    } /* end else-if */
+    else {
+        instr->code  = H5Z_XFORM_OP_DATA_DATA;
+        instr->value = 0;
+        (*depth)--;
+    } /* end else */
+
+    ret_value = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__xform_compile_node() */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__xform_compile
+ *
+ * Purpose:     Compiles the parse tree of a transform to a program for a
+ *              stack of registers, each holding a block of the data, so
+ *              the tree doesn't have to be walked, nor copies of the
+ *              whole buffer made, every time the transform is applied.
+ *              Transforms that are a constant, and the (unexpected) trees
+ *              that can't be compiled, are left without a program and are
+ *              applied by walking the tree.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__xform_compile(H5Z_data_xform_t *data_xform_prop)
+{
+    unsigned depth     = 0;       /* Registers in use */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    HDassert(data_xform_prop);
+    HDassert(data_xform_prop->parse_root);
+    HDassert(NULL == data_xform_prop->prog);
+
+    if (data_xform_prop->parse_root->type == H5Z_XFORM_INTEGER ||
+        data_xform_prop->parse_root->type == H5Z_XFORM_FLOAT)
+        HGOTO_DONE(SUCCEED)
+
+    /* Each node gives at most one instruction */
+    if (NULL == (data_xform_prop->prog = (H5Z_xform_instr_t *)H5MM_malloc(
+                     H5Z__xform_count_nodes(data_xform_prop->parse_root) * sizeof(H5Z_xform_instr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate memory for data transform program")
+    data_xform_prop->prog_len   = 0;
+    data_xform_prop->prog_depth = 0;
+
+    if (!H5Z__xform_compile_node(data_xform_prop->parse_root, data_xform_prop, &depth)) {
+        data_xform_prop->prog     = (H5Z_xform_instr_t *)H5MM_xfree(data_xform_prop->prog);
+        data_xform_prop->prog_len = 0;
+    } /* end if */
+    else
+        HDassert(depth == 1);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__xform_compile() */
+
 /*-------------------------------------------------------------------------
  * Function: H5Z_xform_create
  *
@@ -1512,6 +1846,10 @@ H5Z_xform_create(const char *expr)
         HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL,
                     "error copying the parse tree, did not find correct number of \"variables\"")
 
+    /* Compile the parse tree */
+    if (H5Z__xform_compile(data_xform_prop) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, NULL, "unable to compile data transform")
+
     /* Assign return value */
     ret_value = data_xform_prop;
 
@@ -1527,6 +1865,7 @@ done:
                 H5MM_xfree(data_xform_prop->dat_val_pointers->ptr_dat_val);
             if (data_xform_prop->dat_val_pointers)
                 H5MM_xfree(data_xform_prop->dat_val_pointers);
+            H5MM_xfree(data_xform_prop->prog);
             H5MM_xfree(data_xform_prop);
         } /* end if */
     }     /* end if */
@@ -1568,6 +1907,9 @@ H5Z_xform_destroy(H5Z_data_xform_t *data_xform_prop)
         /* Free the data storage struct */
         H5MM_xfree(data_xform_prop->dat_val_pointers);
 
+        /* Free the compiled transform */
+        H5MM_xfree(data_xform_prop->prog);
+
         /* Free the node */
         H5MM_xfree(data_xform_prop);
     } /* end if */
@@ -1647,6 +1989,10 @@ H5Z_xform_copy(H5Z_data_xform_t **data_xform_prop)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL,
                         "error copying the parse tree, did not find correct number of \"variables\"")
 
+        /* Compile the new parse tree */
+        if (H5Z__xform_compile(new_data_xform_prop) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to compile data transform")
+
         /* Copy new information on top of old information */
         *data_xform_prop = new_data_xform_prop;
     } /* end if */
@@ -1659,6 +2005,7 @@ done:
                 H5Z__xform_destroy_parse_tree(new_data_xform_prop->parse_root);
             if (new_data_xform_prop->xform_exp)
                 H5MM_xfree(new_data_xform_prop->xform_exp);
+            H5MM_xfree(new_data_xform_prop->prog);
             H5MM_xfree(new_data_xform_prop);
         } /* end if */
     }     /* end if */
@@ -0,0 +1,680 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     The inline variable-length data filter.  It stores the
+ *              sequences of a chunk of a variable-length dataset in the
+ *              chunk itself, after the elements, instead of in the global
+ *              heap, so that the filters after it compress them with the
+ *              rest of the chunk.
+ *
+ *              In memory, an element of the chunk holds the length of its
+ *              sequence (4 bytes, little-endian) followed by the offset of
+ *              the sequence from the start of the chunk, which is 0 for a
+ *              nil element (sequences follow the elements, so no sequence
+ *              is at offset 0).  A decoded chunk holds its sequences after
+ *              its elements, so it can be copied or moved as a whole.
+ *
+ *              While a chunk is locked for I/O, its offsets are turned into
+ *              pointers for the datatype conversion routines (see
+ *              H5Z_vlen_to_ptrs).  The sequences written to a chunk are
+ *              pointed to where the conversion put them until the chunk is
+ *              unlocked and H5Z_vlen_compact gathers them into a new buffer.
+ *
+ *              In the file, an element holds the length of its sequence,
+ *              a byte that is 1 for a non-nil element and zero padding.
+ *              The sequences follow the elements, in element order.
+ */
+
+#include "H5Zmodule.h" /* This source code file is part of the H5Z module */
+
+#include "H5private.h"   /* Generic Functions			*/
+#include "H5Dprivate.h"  /* Datasets                             */
+#include "H5Eprivate.h"  /* Error handling		  	*/
+#include "H5Iprivate.h"  /* IDs			  		*/
+#include "H5MMprivate.h" /* Memory management			*/
+#include "H5Oprivate.h"  /* Object headers		  	*/
+#include "H5Pprivate.h"  /* Property lists                       */
+#include "H5Sprivate.h"  /* Dataspaces                           */
+#include "H5Tprivate.h"  /* Datatypes         			*/
+#include "H5Zpkg.h"      /* Data filters				*/
+
+/* Offset of the "non-nil" flag of an encoded element */
+#define H5Z_VLEN_FLAG_OFFSET 4
+
+/* Offset of the sequence's offset or pointer in an element */
+#define H5Z_VLEN_SEQ_OFFSET 4
+
+/* Smallest element that can hold a length and a pointer (or an offset) */
+#define H5Z_VLEN_MIN_ELEM_SIZE (H5Z_VLEN_SEQ_OFFSET + sizeof(void *))
+
+/* Local function prototypes */
+static htri_t H5Z__can_apply_vlen(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static herr_t H5Z__set_local_vlen(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static size_t H5Z__filter_vlen(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], size_t nbytes,
+                               size_t *buf_size, void **buf);
+static herr_t H5Z__vlen_get_parms(size_t cd_nelmts, const unsigned cd_values[], size_t *elem_size,
+                                  size_t *base_size, size_t *nelmts);
+static herr_t H5Z__vlen_get_pline_parms(const H5O_pline_t *pline, size_t *elem_size, size_t *base_size,
+                                        size_t *nelmts);
+static void  *H5Z__vlen_encode(const void *chunk, size_t chunk_nbytes, hbool_t offsets, size_t elem_size,
+                               size_t base_size, size_t nelmts, size_t *nbytes);
+static herr_t H5Z__vlen_decode(void *buf, size_t nbytes, size_t elem_size, size_t base_size, size_t nelmts);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_VLEN[1] = {{
+    H5Z_CLASS_T_VERS,    /* H5Z_class_t version */
+    H5Z_FILTER_VLEN,     /* Filter id number		*/
+    1,                   /* encoder_present flag (set to true) */
+    1,                   /* decoder_present flag (set to true) */
+    "vlen",              /* Filter name for debugging	*/
+    H5Z__can_apply_vlen, /* The "can apply" callback     */
+    H5Z__set_local_vlen, /* The "set local" callback     */
+    H5Z__filter_vlen,    /* The actual filter function	*/
+}};
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__can_apply_vlen
+ *
+ * Purpose:	Check the parameters for the inline variable-length data
+ *              filter for validity and whether they fit a particular
+ *              dataset.
+ *
+ *              The dataset must be a variable-length sequence (or string)
+ *              of a type without any variable-length data or references
+ *              of its own, the filter must be the first, mandatory filter
+ *              of the pipeline, filters must not be skipped for partial
+ *              edge chunks and the fill value must not be user-defined.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5Z__can_apply_vlen(hid_t dcpl_id, hid_t type_id, hid_t H5_ATTR_UNUSED space_id)
+{
+    H5P_genplist_t  *dcpl_plist;       /* Property list pointer */
+    const H5T_t     *type;             /* Datatype */
+    H5T_t           *super = NULL;     /* Base type of the sequences */
+    H5O_pline_t      pline;            /* I/O pipeline */
+    H5O_layout_t     layout;           /* Dataset layout */
+    H5O_fill_t       fill;             /* Fill value */
+    H5D_fill_value_t fill_status;      /* Whether the fill value is defined */
+    htri_t           ret_value = TRUE; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Get datatype */
+    if (NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+    /* The sequences must be at the top level of the datatype */
+    if (H5T_get_class(type, TRUE) != H5T_VLEN)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FALSE, "datatype is not variable-length")
+    if (H5T_get_size(type) < H5Z_VLEN_MIN_ELEM_SIZE)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FALSE, "variable-length datatype is too small")
+
+    /* The sequences must not hold variable-length data or references themselves */
+    if (NULL == (super = H5T_get_super(type)))
+        HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "can't get base type of variable-length datatype")
+    if (H5T_detect_class(super, H5T_VLEN, FALSE) || H5T_detect_class(super, H5T_REFERENCE, FALSE))
+        HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FALSE,
+                    "base type of variable-length datatype holds variable-length data or references")
+
+    /* Get the plist structure */
+    if (NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* The filter must see the elements before any other filter does */
+    if (H5P_peek(dcpl_plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't retrieve pipeline filter")
+    if (0 == pline.nused || H5Z_FILTER_VLEN != pline.filter[0].id)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FALSE,
+                    "the inline variable-length data filter must be the first filter")
+    if (pline.filter[0].flags & H5Z_FLAG_OPTIONAL)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FALSE,
+                    "the inline variable-length data filter can't be optional")
+
+    /* Every chunk must go through the filter */
+    if (H5P_peek(dcpl_plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't retrieve layout")
+    if (H5D_CHUNKED == layout.type &&
+        (layout.u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS))
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FALSE,
+                    "the inline variable-length data filter can't skip partial edge chunks")
+
+    /* A user-defined fill value would live in the global heap */
+    if (H5P_peek(dcpl_plist, H5D_CRT_FILL_VALUE_NAME, &fill) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't retrieve fill value")
+    if (H5P_is_fill_value_defined(&fill, &fill_status) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+    if (H5D_FILL_VALUE_USER_DEFINED == fill_status)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FALSE,
+                    "the inline variable-length data filter can't store a user-defined fill value")
+
+done:
+    if (super)
+        if (H5T_close_real(super) < 0)
+            HDONE_ERROR(H5E_PLINE, H5E_CLOSEERROR, FAIL, "unable to close base datatype")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__can_apply_vlen() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__set_local_vlen
+ *
+ * Purpose:	Set the sizes of the elements and of the sequences and the
+ *              number of elements in a chunk, for the inline
+ *              variable-length data filter.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__set_local_vlen(hid_t dcpl_id, hid_t type_id, hid_t space_id)
+{
+    H5P_genplist_t *dcpl_plist;                         /* Property list pointer */
+    const H5T_t    *type;                               /* Datatype */
+    H5T_t          *super = NULL;                       /* Base type of the sequences */
+    const H5S_t    *ds;                                 /* Dataspace */
+    unsigned        flags;                              /* Filter flags */
+    size_t          cd_nelmts = H5Z_VLEN_USER_NPARMS;   /* Number of filter parameters */
+    unsigned        cd_values[H5Z_VLEN_TOTAL_NPARMS];   /* Filter parameters */
+    size_t          elem_size;                          /* Size of an element */
+    size_t          base_size;                          /* Size of an element of a sequence */
+    hssize_t        npoints;                            /* Number of points in the dataspace */
+    herr_t          ret_value = SUCCEED;                /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Get the plist structure */
+    if (NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ID, H5E_BADID, FAIL, "can't find object for ID")
+
+    /* Get datatype */
+    if (NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+    if (NULL == (super = H5T_get_super(type)))
+        HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "can't get base type of variable-length datatype")
+
+    /* Get the filter's current parameters */
+    if (H5P_get_filter_by_id(dcpl_plist, H5Z_FILTER_VLEN, &flags, &cd_nelmts, cd_values, (size_t)0, NULL,
+                             NULL) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get inline variable-length data parameters")
+
+    /* Get dataspace */
+    if (NULL == (ds = (const H5S_t *)H5I_object_verify(space_id, H5I_DATASPACE)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataspace")
+
+    /* Get total number of elements in the chunk */
+    if ((npoints = H5S_GET_EXTENT_NPOINTS(ds)) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "unable to get number of points in the dataspace")
+    HDassert(npoints);
+
+    /* Set the "local" parameters */
+    elem_size = H5T_get_size(type);
+    base_size = H5T_get_size(super);
+    H5_CHECK_OVERFLOW(elem_size, size_t, unsigned);
+    H5_CHECK_OVERFLOW(base_size, size_t, unsigned);
+    H5_CHECK_OVERFLOW(npoints, hssize_t, unsigned);
+    cd_values[H5Z_VLEN_PARM_ELEM_SIZE] = (unsigned)elem_size;
+    cd_values[H5Z_VLEN_PARM_BASE_SIZE] = (unsigned)base_size;
+    cd_values[H5Z_VLEN_PARM_NELMTS]    = (unsigned)npoints;
+
+    /* Modify the filter's parameters for this dataset */
+    if (H5P_modify_filter(dcpl_plist, H5Z_FILTER_VLEN, flags, (size_t)H5Z_VLEN_TOTAL_NPARMS, cd_values) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTSET, FAIL, "can't set local inline variable-length data parameters")
+
+done:
+    if (super)
+        if (H5T_close_real(super) < 0)
+            HDONE_ERROR(H5E_PLINE, H5E_CLOSEERROR, FAIL, "unable to close base datatype")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__set_local_vlen() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__vlen_get_parms
+ *
+ * Purpose:	Check and unpack the parameters of the inline
+ *              variable-length data filter.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__vlen_get_parms(size_t cd_nelmts, const unsigned cd_values[], size_t *elem_size, size_t *base_size,
+                    size_t *nelmts)
+{
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* An offset must fit where the pointer of an element goes */
+    HDcompile_assert(sizeof(size_t) <= sizeof(void *));
+
+    if (cd_nelmts != H5Z_VLEN_TOTAL_NPARMS)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid number of inline variable-length data parameters")
+
+    *elem_size = (size_t)cd_values[H5Z_VLEN_PARM_ELEM_SIZE];
+    *base_size = (size_t)cd_values[H5Z_VLEN_PARM_BASE_SIZE];
+    *nelmts    = (size_t)cd_values[H5Z_VLEN_PARM_NELMTS];
+    if (*elem_size < H5Z_VLEN_MIN_ELEM_SIZE || 0 == *base_size || 0 == *nelmts)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid inline variable-length data parameters")
+    if (*nelmts > ((size_t)-1) / *elem_size)
+        HGOTO_ERROR(H5E_ARGS, H5E_OVERFLOW, FAIL, "inline variable-length data chunk is too large")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__vlen_get_parms() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__vlen_get_pline_parms
+ *
+ * Purpose:	Check and unpack the parameters of the inline
+ *              variable-length data filter of a pipeline.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__vlen_get_pline_parms(const H5O_pline_t *pline, size_t *elem_size, size_t *base_size, size_t *nelmts)
+{
+    const H5Z_filter_info_t *filter;              /* Parameters of the filter */
+    herr_t                   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (NULL == (filter = H5Z_filter_info(pline, H5Z_FILTER_VLEN)))
+        HGOTO_ERROR(H5E_PLINE, H5E_NOTFOUND, FAIL, "inline variable-length data filter isn't in pipeline")
+    if (H5Z__vlen_get_parms(filter->cd_nelmts, filter->cd_values, elem_size, base_size, nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid inline variable-length data parameters")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__vlen_get_pline_parms() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__vlen_encode
+ *
+ * Purpose:	Encode the elements of a chunk and append their sequences
+ *              into a new buffer, allocated with H5Z_buf_malloc.
+ *
+ *              If OFFSETS is set, the elements hold the offsets of their
+ *              sequences in the CHUNK_NBYTES bytes of the chunk, else they
+ *              hold pointers to them.
+ *
+ * Return:	Success: Pointer to the new buffer, whose size is
+ *                       returned in NBYTES
+ *		Failure: NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5Z__vlen_encode(const void *chunk, size_t chunk_nbytes, hbool_t offsets, size_t elem_size,
+                 size_t base_size, size_t nelmts, size_t *nbytes)
+{
+    const uint8_t *src;                 /* Pointer to an element of the chunk */
+    uint8_t       *dst;                 /* Pointer to an encoded element */
+    uint8_t       *payload;             /* Pointer to the next encoded sequence */
+    size_t         elems_size;          /* Size of the elements */
+    size_t         total_size = 0;      /* Size of the encoded chunk */
+    size_t         u;                   /* Local index variable */
+    void          *outbuf    = NULL;    /* Encoded chunk */
+    void          *ret_value = NULL;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Add up the sizes of the sequences */
+    elems_size = nelmts * elem_size;
+    total_size = elems_size;
+    if (offsets && chunk_nbytes < elems_size)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, NULL, "inline variable-length data chunk is too short")
+    for (u = 0, src = (const uint8_t *)chunk; u < nelmts; u++, src += elem_size) {
+        const uint8_t *p = src;
+        uint32_t       seq_len;
+        size_t         seq_size;
+
+        UINT32DECODE(p, seq_len);
+        if ((size_t)seq_len > ((size_t)-1) / base_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_OVERFLOW, NULL, "variable-length sequence is too large")
+        seq_size = (size_t)seq_len * base_size;
+        if (seq_size > ((size_t)-1) - total_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_OVERFLOW, NULL, "inline variable-length data chunk is too large")
+        total_size += seq_size;
+
+        /* The sequences of a chunk holding offsets must be in the chunk */
+        if (offsets) {
+            size_t off;
+
+            H5MM_memcpy(&off, p, sizeof(size_t));
+            if (0 == off ? seq_len > 0
+                         : (off < elems_size || off > chunk_nbytes || seq_size > chunk_nbytes - off))
+                HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, NULL,
+                            "inline variable-length sequence is past its chunk")
+        } /* end if */
+    }     /* end for */
+
+    if (NULL == (outbuf = H5Z_buf_malloc(total_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for inline vlen buffer")
+
+    /* Encode the elements and append their sequences */
+    payload = (uint8_t *)outbuf + elems_size;
+    for (u = 0, src = (const uint8_t *)chunk, dst = (uint8_t *)outbuf; u < nelmts;
+         u++, src += elem_size, dst += elem_size) {
+        const uint8_t *p = src;
+        uint32_t       seq_len;
+        const void    *seq;
+        size_t         seq_size;
+
+        UINT32DECODE(p, seq_len);
+        if (offsets) {
+            size_t off;
+
+            H5MM_memcpy(&off, p, sizeof(size_t));
+            seq = off ? (const uint8_t *)chunk + off : NULL;
+        } /* end if */
+        else
+            H5MM_memcpy(&seq, p, sizeof(void *));
+        seq_size = (size_t)seq_len * base_size;
+
+        H5MM_memcpy(dst, src, (size_t)4);
+        dst[H5Z_VLEN_FLAG_OFFSET] = (uint8_t)(NULL != seq);
+        HDmemset(dst + H5Z_VLEN_FLAG_OFFSET + 1, 0, elem_size - (H5Z_VLEN_FLAG_OFFSET + 1));
+
+        if (seq_size > 0) {
+            if (NULL == seq)
+                HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, NULL, "nil variable-length sequence has a length")
+            H5MM_memcpy(payload, seq, seq_size);
+            payload += seq_size;
+        } /* end if */
+    }     /* end for */
+
+    /* Set return values */
+    *nbytes   = total_size;
+    ret_value = outbuf;
+    outbuf    = NULL;
+
+done:
+    if (outbuf)
+        H5Z_buf_free(outbuf, total_size);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__vlen_encode() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__vlen_decode
+ *
+ * Purpose:	Decode the elements of an encoded chunk in place, setting
+ *              them to the offsets of their sequences in the same buffer.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__vlen_decode(void *buf, size_t nbytes, size_t elem_size, size_t base_size, size_t nelmts)
+{
+    uint8_t *elem;                /* Pointer to an element */
+    size_t   payload;             /* Offset of the next sequence */
+    size_t   remaining;           /* Number of bytes of sequences left */
+    size_t   u;                   /* Local index variable */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (nbytes < nelmts * elem_size)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "inline variable-length data chunk is too short")
+
+    payload   = nelmts * elem_size;
+    remaining = nbytes - nelmts * elem_size;
+    for (u = 0, elem = (uint8_t *)buf; u < nelmts; u++, elem += elem_size) {
+        const uint8_t *p = elem;
+        uint32_t       seq_len;
+        size_t         off = 0;
+        size_t         seq_size;
+
+        UINT32DECODE(p, seq_len);
+        if ((size_t)seq_len > remaining / base_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "inline variable-length sequence is past its chunk")
+        seq_size = (size_t)seq_len * base_size;
+
+        if (elem[H5Z_VLEN_FLAG_OFFSET]) {
+            off = payload;
+            payload += seq_size;
+            remaining -= seq_size;
+        } /* end if */
+        else if (seq_len > 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "nil variable-length sequence has a length")
+
+        /* Set the offset of the element's sequence (this overwrites the flag) */
+        H5MM_memcpy(elem + H5Z_VLEN_SEQ_OFFSET, &off, sizeof(size_t));
+    } /* end for */
+
+    if (remaining > 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "inline variable-length data chunk is too long")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__vlen_decode() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__filter_vlen
+ *
+ * Purpose:	Implement an I/O filter that stores variable-length
+ *              sequences inline in their chunk
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__filter_vlen(unsigned flags, size_t cd_nelmts, const unsigned cd_values[], size_t nbytes,
+                 size_t *buf_size, void **buf)
+{
+    size_t elem_size;     /* Size of an element */
+    size_t base_size;     /* Size of an element of a sequence */
+    size_t nelmts;        /* Number of elements in the chunk */
+    size_t ret_value = 0; /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    if (H5Z__vlen_get_parms(cd_nelmts, cd_values, &elem_size, &base_size, &nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, 0, "invalid inline variable-length data parameters")
+
+    if (flags & H5Z_FLAG_REVERSE) { /* Read */
+        /* (Re-use the input buffer, the sequences stay where they are) */
+        if (H5Z__vlen_decode(*buf, nbytes, elem_size, base_size, nelmts) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_READERROR, 0, "can't decode inline variable-length data")
+
+        ret_value = nbytes;
+    }
+    else { /* Write */
+        void  *outbuf;
+        size_t out_nbytes;
+
+        /* (The elements hold the offsets of their sequences in the buffer) */
+        if (NULL ==
+            (outbuf = H5Z__vlen_encode(*buf, nbytes, TRUE, elem_size, base_size, nelmts, &out_nbytes)))
+            HGOTO_ERROR(H5E_PLINE, H5E_WRITEERROR, 0, "can't encode inline variable-length data")
+
+        /* Free input buffer */
+        H5Z_buf_free(*buf, *buf_size);
+
+        /* Set return values */
+        *buf_size = out_nbytes;
+        *buf      = outbuf;
+        ret_value = out_nbytes;
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__filter_vlen() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_vlen_compact
+ *
+ * Purpose:	Gather the sequences of a chunk of a dataset using the
+ *              inline variable-length data filter, whose elements point
+ *              at their sequences, into a new buffer that holds the
+ *              chunk's elements, set to the offsets of their copies of
+ *              the sequences.  This lets the chunk outlive the memory
+ *              that its sequences were written from.
+ *
+ * Return:	Success: Pointer to the new chunk, allocated with
+ *                       H5Z_buf_malloc, whose size is returned in
+ *                       OUT_NBYTES
+ *		Failure: NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z_vlen_compact(const H5O_pline_t *pline, const void *chunk, size_t nbytes, size_t *out_nbytes)
+{
+    size_t elem_size;         /* Size of an element */
+    size_t base_size;         /* Size of an element of a sequence */
+    size_t nelmts;            /* Number of elements in the chunk */
+    size_t new_nbytes = 0;    /* Size of the new chunk */
+    void  *outbuf     = NULL; /* New chunk */
+    void  *ret_value  = NULL; /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(pline);
+    HDassert(chunk);
+    HDassert(out_nbytes);
+
+    if (H5Z__vlen_get_pline_parms(pline, &elem_size, &base_size, &nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, NULL, "invalid inline variable-length data parameters")
+    if (nbytes < nelmts * elem_size)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, NULL, "chunk is smaller than its elements")
+
+    if (NULL ==
+        (outbuf = H5Z__vlen_encode(chunk, nbytes, FALSE, elem_size, base_size, nelmts, &new_nbytes)))
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTCOPY, NULL, "can't encode inline variable-length data")
+    if (H5Z__vlen_decode(outbuf, new_nbytes, elem_size, base_size, nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTCOPY, NULL, "can't decode inline variable-length data")
+
+    *out_nbytes = new_nbytes;
+    ret_value   = outbuf;
+    outbuf      = NULL;
+
+done:
+    if (outbuf)
+        H5Z_buf_free(outbuf, new_nbytes);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_vlen_compact() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_vlen_to_ptrs
+ *
+ * Purpose:	Turn the offsets of the sequences held by the elements of a
+ *              chunk of a dataset using the inline variable-length data
+ *              filter into pointers, for the datatype conversion routines.
+ *              The chunk must not move until H5Z_vlen_to_offsets or
+ *              H5Z_vlen_compact is called on it.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_vlen_to_ptrs(const H5O_pline_t *pline, void *chunk)
+{
+    uint8_t *elem;                /* Pointer to an element */
+    size_t   elem_size;           /* Size of an element */
+    size_t   base_size;           /* Size of an element of a sequence */
+    size_t   nelmts;              /* Number of elements in the chunk */
+    size_t   u;                   /* Local index variable */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(pline);
+    HDassert(chunk);
+
+    if (H5Z__vlen_get_pline_parms(pline, &elem_size, &base_size, &nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid inline variable-length data parameters")
+
+    for (u = 0, elem = (uint8_t *)chunk; u < nelmts; u++, elem += elem_size) {
+        size_t off;
+        void  *seq;
+
+        H5MM_memcpy(&off, elem + H5Z_VLEN_SEQ_OFFSET, sizeof(size_t));
+        seq = off ? (uint8_t *)chunk + off : NULL;
+        H5MM_memcpy(elem + H5Z_VLEN_SEQ_OFFSET, &seq, sizeof(void *));
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_vlen_to_ptrs() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z_vlen_to_offsets
+ *
+ * Purpose:	Turn the pointers to the sequences held by the elements of
+ *              a chunk of a dataset using the inline variable-length data
+ *              filter back into offsets, once the chunk is unlocked.  The
+ *              sequences must all be in the NBYTES bytes of the chunk,
+ *              i.e. the chunk must not have been written to.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_vlen_to_offsets(const H5O_pline_t *pline, void *chunk, size_t nbytes)
+{
+    uint8_t *elem;                /* Pointer to an element */
+    size_t   elem_size;           /* Size of an element */
+    size_t   base_size;           /* Size of an element of a sequence */
+    size_t   nelmts;              /* Number of elements in the chunk */
+    size_t   u;                   /* Local index variable */
+    herr_t   ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(pline);
+    HDassert(chunk);
+
+    if (H5Z__vlen_get_pline_parms(pline, &elem_size, &base_size, &nelmts) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "invalid inline variable-length data parameters")
+
+    for (u = 0, elem = (uint8_t *)chunk; u < nelmts; u++, elem += elem_size) {
+        uint8_t *seq;
+        size_t   off = 0;
+
+        H5MM_memcpy(&seq, elem + H5Z_VLEN_SEQ_OFFSET, sizeof(void *));
+        if (seq) {
+            if (seq < (uint8_t *)chunk || seq > (uint8_t *)chunk + nbytes)
+                HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL,
+                            "inline variable-length sequence is outside its chunk")
+            off = (size_t)(seq - (uint8_t *)chunk);
+        } /* end if */
+        H5MM_memcpy(elem + H5Z_VLEN_SEQ_OFFSET, &off, sizeof(size_t));
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_vlen_to_offsets() */
@@ -31,6 +31,15 @@
 /***********/
 #include "H5private.h" /* Generic Functions			*/
 
+/* The vector and CRC32C instruction paths need the "target" function
+ * attribute of GCC or Clang, so they can be built without enabling the
+ * instructions for the whole library */
+#if (defined(__x86_64__) || defined(__i386__)) &&                                                            \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 6))
+#define H5_CHECKSUM_HAVE_X86
+#include <immintrin.h>
+#endif
+
 /****************/
 /* Local Macros */
 /****************/
@@ -39,6 +48,20 @@
 /* (same as the IEEE 802.3 (Ethernet) quotient) */
 #define H5_CRC_QUOTIENT 0x04C11DB7
 
+/* Largest number of vectors summed by the vector Fletcher32 paths before
+ * their 32-bit lanes are reduced (the second sums of 256 vectors can't
+ * overflow) */
+#define H5_FLETCHER32_VEC_BLOCK 256
+
+/* Smallest number of 16-bit words worth summing with the vector paths */
+#define H5_FLETCHER32_VEC_MIN 64
+
+/* Instruction set extensions used by the checksums, checked on first use */
+#define H5_CHECKSUM_X86_SSE2  0x01
+#define H5_CHECKSUM_X86_AVX2  0x02
+#define H5_CHECKSUM_X86_SSE42 0x04
+#define H5_CHECKSUM_X86_INIT  0x80
+
 /******************/
 /* Local Typedefs */
 /******************/
@@ -69,6 +92,247 @@ static uint32_t H5_crc_table[256];
 /* Flag: has the table been computed? */
 static hbool_t H5_crc_table_computed = FALSE;
 
+/* Table of CRC32C (Castagnoli, reflected polynomial 0x82F63B78) remainders of
+ * all 8-bit messages.  Unlike the table above it's constant, so it can be
+ * shared between threads without being computed first. */
+static const uint32_t H5_crc32c_table[256] = {
+    0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C,
+    0x26A1E7E8, 0xD4CA64EB, 0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B,
+    0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24, 0x105EC76F, 0xE235446C,
+    0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+    0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC,
+    0xBC267848, 0x4E4DFB4B, 0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A,
+    0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35, 0xAA64D611, 0x580F5512,
+    0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+    0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD,
+    0x1642AE59, 0xE4292D5A, 0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A,
+    0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595, 0x417B1DBC, 0xB3109EBF,
+    0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+    0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F,
+    0xED03A29B, 0x1F682198, 0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927,
+    0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38, 0xDBFC821C, 0x2997011F,
+    0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+    0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E,
+    0x4767748A, 0xB50CF789, 0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859,
+    0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46, 0x7198540D, 0x83F3D70E,
+    0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+    0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE,
+    0xDDE0EB2A, 0x2F8B6829, 0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C,
+    0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93, 0x082F63B7, 0xFA44E0B4,
+    0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+    0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B,
+    0xB4091BFF, 0x466298FC, 0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C,
+    0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033, 0xA24BB5A6, 0x502036A5,
+    0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+    0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975,
+    0x0E330A81, 0xFC588982, 0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D,
+    0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622, 0x38CC2A06, 0xCAA7A905,
+    0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+    0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8,
+    0xE52CC12C, 0x1747422F, 0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF,
+    0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0, 0xD3D3E1AB, 0x21B862A8,
+    0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+    0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78,
+    0x7FAB5E8C, 0x8DC0DD8F, 0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE,
+    0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1, 0x69E9F0D5, 0x9B8273D6,
+    0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+    0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69,
+    0xD5CF889D, 0x27A40B9E, 0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E,
+    0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351
+};
+
+#ifdef H5_CHECKSUM_HAVE_X86
+/* Instruction set extensions supported by the CPU (H5_CHECKSUM_X86_*) */
+static unsigned H5_checksum_x86_g = 0;
+#endif /* H5_CHECKSUM_HAVE_X86 */
+
+#ifdef H5_CHECKSUM_HAVE_X86
+
+/*-------------------------------------------------------------------------
+ * Function:	H5__checksum_x86_features
+ *
+ * Purpose:	Check which instruction set extensions used by the checksums
+ *              are supported by the CPU, on the first call.
+ *
+ * Return:	Bitmask of H5_CHECKSUM_X86_* flags (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5__checksum_x86_features(void)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (!(H5_checksum_x86_g & H5_CHECKSUM_X86_INIT)) {
+        unsigned features = H5_CHECKSUM_X86_INIT;
+
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse2"))
+            features |= H5_CHECKSUM_X86_SSE2;
+        if (__builtin_cpu_supports("avx2"))
+            features |= H5_CHECKSUM_X86_AVX2;
+        if (__builtin_cpu_supports("sse4.2"))
+            features |= H5_CHECKSUM_X86_SSE42;
+
+        H5_checksum_x86_g = features;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(H5_checksum_x86_g)
+} /* end H5__checksum_x86_features() */
+
+/*
+ * The vector Fletcher32 paths sum the big-endian 16-bit words of the buffer in
+ * the 32-bit lanes of two sets of registers: lane P of the first sums holds
+ * the sum of word P of every vector, and lane P of the second sums adds up the
+ * first sums before each vector, so after N vectors of W words each it holds
+ * the sum of (N - 1 - I) times word P of vector I.  The contribution of the
+ * words to the scalar second sum, where word J is added (N * W - J) times, is
+ * then W times the second sums plus (W - P) times the first sums of lane P.
+ *
+ * The sums of each block of vectors are reduced modulo 65535, which is what
+ * the scalar algorithm's folds compute, apart from the representation of zero
+ * (see H5_checksum_fletcher32).
+ */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5__checksum_fletcher32_reduce
+ *
+ * Purpose:	Add the lanes of the sums of a block of NWORDS words to the
+ *              running sums SUM1 and SUM2, which are kept modulo 65535, and
+ *              set NONZERO if any word of the block is nonzero.  WEIGHT
+ *              holds (W - P) for the word P summed in each lane.
+ *
+ * Return:	none
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5__checksum_fletcher32_reduce(const uint32_t *vs1, const uint32_t *vs2, const uint8_t *weight,
+                               unsigned nlanes, size_t nwords, uint32_t *sum1, uint32_t *sum2,
+                               hbool_t *nonzero)
+{
+    uint64_t s1 = 0, s2 = 0;
+    unsigned u;
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    for (u = 0; u < nlanes; u++) {
+        s1 += vs1[u];
+        s2 += ((uint64_t)nlanes * vs2[u]) + ((uint64_t)weight[u] * vs1[u]);
+    } /* end for */
+
+    if (s1)
+        *nonzero = TRUE;
+    *sum2 = (uint32_t)((*sum2 + ((uint64_t)nwords * *sum1) + s2) % 65535);
+    *sum1 = (uint32_t)((*sum1 + s1) % 65535);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5__checksum_fletcher32_reduce() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5__checksum_fletcher32_sse2
+ *
+ * Purpose:	Sum the whole vectors of the first NWORDS 16-bit words of
+ *              DATA with SSE2 instructions.
+ *
+ * Return:	Number of words summed (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static __attribute__((target("sse2"))) size_t
+H5__checksum_fletcher32_sse2(const uint8_t *data, size_t nwords, uint32_t *sum1, uint32_t *sum2,
+                             hbool_t *nonzero)
+{
+    static const uint8_t weight[8] = {8, 7, 6, 5, 4, 3, 2, 1};
+    const __m128i        zero      = _mm_setzero_si128();
+    size_t               nvecs     = nwords / 8;
+
+    while (nvecs) {
+        size_t   n      = MIN(nvecs, H5_FLETCHER32_VEC_BLOCK);
+        __m128i  vs1_lo = zero, vs1_hi = zero;
+        __m128i  vs2_lo = zero, vs2_hi = zero;
+        uint32_t vs1[8], vs2[8];
+        size_t   u;
+
+        for (u = 0; u < n; u++) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(const void *)data);
+
+            /* Swap the bytes of the big-endian words */
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+
+            vs2_lo = _mm_add_epi32(vs2_lo, vs1_lo);
+            vs2_hi = _mm_add_epi32(vs2_hi, vs1_hi);
+            vs1_lo = _mm_add_epi32(vs1_lo, _mm_unpacklo_epi16(x, zero));
+            vs1_hi = _mm_add_epi32(vs1_hi, _mm_unpackhi_epi16(x, zero));
+            data += 16;
+        } /* end for */
+
+        _mm_storeu_si128((__m128i *)(void *)vs1, vs1_lo);
+        _mm_storeu_si128((__m128i *)(void *)(vs1 + 4), vs1_hi);
+        _mm_storeu_si128((__m128i *)(void *)vs2, vs2_lo);
+        _mm_storeu_si128((__m128i *)(void *)(vs2 + 4), vs2_hi);
+        H5__checksum_fletcher32_reduce(vs1, vs2, weight, 8, n * 8, sum1, sum2, nonzero);
+
+        nvecs -= n;
+    } /* end while */
+
+    return nwords - (nwords % 8);
+} /* end H5__checksum_fletcher32_sse2() */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5__checksum_fletcher32_avx2
+ *
+ * Purpose:	Sum the whole vectors of the first NWORDS 16-bit words of
+ *              DATA with AVX2 instructions.
+ *
+ * Return:	Number of words summed (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static __attribute__((target("avx2"))) size_t
+H5__checksum_fletcher32_avx2(const uint8_t *data, size_t nwords, uint32_t *sum1, uint32_t *sum2,
+                             hbool_t *nonzero)
+{
+    /* The unpacks work within each 128-bit half, so the low lanes hold words
+     * 0-3 and 8-11 of a vector and the high lanes words 4-7 and 12-15 */
+    static const uint8_t weight[16] = {16, 15, 14, 13, 8, 7, 6, 5, 12, 11, 10, 9, 4, 3, 2, 1};
+    const __m256i        zero       = _mm256_setzero_si256();
+    size_t               nvecs      = nwords / 16;
+
+    while (nvecs) {
+        size_t   n      = MIN(nvecs, H5_FLETCHER32_VEC_BLOCK);
+        __m256i  vs1_lo = zero, vs1_hi = zero;
+        __m256i  vs2_lo = zero, vs2_hi = zero;
+        uint32_t vs1[16], vs2[16];
+        size_t   u;
+
+        for (u = 0; u < n; u++) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(const void *)data);
+
+            /* Swap the bytes of the big-endian words */
+            x = _mm256_or_si256(_mm256_slli_epi16(x, 8), _mm256_srli_epi16(x, 8));
+
+            vs2_lo = _mm256_add_epi32(vs2_lo, vs1_lo);
+            vs2_hi = _mm256_add_epi32(vs2_hi, vs1_hi);
+            vs1_lo = _mm256_add_epi32(vs1_lo, _mm256_unpacklo_epi16(x, zero));
+            vs1_hi = _mm256_add_epi32(vs1_hi, _mm256_unpackhi_epi16(x, zero));
+            data += 32;
+        } /* end for */
+
+        _mm256_storeu_si256((__m256i *)(void *)vs1, vs1_lo);
+        _mm256_storeu_si256((__m256i *)(void *)(vs1 + 8), vs1_hi);
+        _mm256_storeu_si256((__m256i *)(void *)vs2, vs2_lo);
+        _mm256_storeu_si256((__m256i *)(void *)(vs2 + 8), vs2_hi);
+        H5__checksum_fletcher32_reduce(vs1, vs2, weight, 16, n * 16, sum1, sum2, nonzero);
+
+        nvecs -= n;
+    } /* end while */
+
+    return nwords - (nwords % 16);
+} /* end H5__checksum_fletcher32_avx2() */
+
+#endif /* H5_CHECKSUM_HAVE_X86 */
+
 /*-------------------------------------------------------------------------
  * Function:	H5_checksum_fletcher32
  *
@@ -89,6 +353,10 @@ static hbool_t H5_crc_table_computed = FALSE;
  *              0xffff (for backward compatibility reasons with earlier
  *              HDF5 fletcher32 I/O filter routine, mostly).
  *
+ * Note #4:     On x86 CPUs with SSE2 or AVX2 the words of longer buffers are
+ *              summed in vector registers, giving the same result as the
+ *              scalar algorithm.
+ *
  * Return:	32-bit fletcher checksum of input buffer (can't fail)
  *
  * Programmer:	Quincey Koziol
@@ -109,6 +377,33 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     HDassert(_data);
     HDassert(_len > 0);
 
+#ifdef H5_CHECKSUM_HAVE_X86
+    /* Sum as many words as possible with the vector instructions */
+    if (len >= H5_FLETCHER32_VEC_MIN) {
+        unsigned features = H5__checksum_x86_features();
+        uint32_t vsum1 = 0, vsum2 = 0;
+        hbool_t  nonzero = FALSE;
+        size_t   nwords  = 0;
+
+        if (features & H5_CHECKSUM_X86_AVX2)
+            nwords = H5__checksum_fletcher32_avx2(data, len, &vsum1, &vsum2, &nonzero);
+        else if (features & H5_CHECKSUM_X86_SSE2)
+            nwords = H5__checksum_fletcher32_sse2(data, len, &vsum1, &vsum2, &nonzero);
+        data += 2 * nwords;
+        len -= nwords;
+
+        /* Continue from the sums modulo 65535.  The result of the folds
+         * below only depends on the sums modulo 65535 and on whether they
+         * are zero, which they are only if every word so far was, so a zero
+         * remainder of nonzero sums is continued from as 0xffff.  The sums
+         * below can't overflow from these values. */
+        if (nonzero) {
+            sum1 = vsum1 ? vsum1 : 0xffff;
+            sum2 = vsum2 ? vsum2 : 0xffff;
+        } /* end if */
+    }     /* end if */
+#endif /* H5_CHECKSUM_HAVE_X86 */
+
     /* Compute checksum for pairs of bytes */
     /* (the magic "360" value is the largest number of sums that can be
      *  performed without numeric overflow)
@@ -238,6 +533,89 @@ H5_checksum_crc(const void *_data, size_t len)
                      0xffffffffL)
 } /* end H5_checksum_crc() */
 
+#ifdef H5_CHECKSUM_HAVE_X86
+/*-------------------------------------------------------------------------
+ * Function:	H5__checksum_crc32c_sse42
+ *
+ * Purpose:	Update a running CRC32C with the bytes buf[0..len-1], with
+ *              the SSE4.2 CRC32 instruction.
+ *
+ * Return:	Updated CRC (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static __attribute__((target("sse4.2"))) uint32_t
+H5__checksum_crc32c_sse42(uint32_t crc, const uint8_t *buf, size_t len)
+{
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+
+    while (len >= 8) {
+        uint64_t w;
+
+        HDmemcpy(&w, buf, sizeof(w));
+        crc64 = _mm_crc32_u64(crc64, w);
+        buf += 8;
+        len -= 8;
+    } /* end while */
+    crc = (uint32_t)crc64;
+#else
+    while (len >= 4) {
+        uint32_t w;
+
+        HDmemcpy(&w, buf, sizeof(w));
+        crc = _mm_crc32_u32(crc, w);
+        buf += 4;
+        len -= 4;
+    } /* end while */
+#endif
+    while (len--)
+        crc = _mm_crc32_u8(crc, *buf++);
+
+    return crc;
+} /* end H5__checksum_crc32c_sse42() */
+#endif /* H5_CHECKSUM_HAVE_X86 */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_crc32c
+ *
+ * Purpose:	Compute the CRC32C (Castagnoli) checksum of a buffer, as
+ *              used by iSCSI, SCTP and ext4.
+ *
+ * Note:        On x86 CPUs with SSE4.2 the checksum is computed with the
+ *              CRC32 instruction, otherwise a byte at a time from a table.
+ *
+ * Return:	32-bit CRC32C checksum of input buffer (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+uint32_t
+H5_checksum_crc32c(const void *_data, size_t len)
+{
+    const uint8_t *data = (const uint8_t *)_data; /* Pointer to the data to be summed */
+    uint32_t       crc  = 0xffffffff;              /* Running CRC */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Sanity check */
+    HDassert(_data);
+    HDassert(len > 0);
+
+#ifdef H5_CHECKSUM_HAVE_X86
+    if (H5__checksum_x86_features() & H5_CHECKSUM_X86_SSE42)
+        crc = H5__checksum_crc32c_sse42(crc, data, len);
+    else
+#endif /* H5_CHECKSUM_HAVE_X86 */
+    {
+        size_t n; /* Local index variable */
+
+        for (n = 0; n < len; n++)
+            crc = H5_crc32c_table[(crc ^ data[n]) & 0xff] ^ (crc >> 8);
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(crc ^ 0xffffffff)
+} /* end H5_checksum_crc32c() */
+
 /*
 -------------------------------------------------------------------------------
 H5_lookup3_mix -- mix 3 32-bit values reversibly.
@@ -392,6 +770,16 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
 
     /*--------------- all but the last block: affect some 32 bits of (a,b,c) */
     while (length > 12) {
+#if !defined(H5_WORDS_BIGENDIAN) && !defined(WORDS_BIGENDIAN)
+        /* The words of the key are little-endian, as on this machine (the
+         * configure and CMake builds name the byte order macro differently) */
+        uint32_t w[3];
+
+        HDmemcpy(w, k, sizeof(w));
+        a += w[0];
+        b += w[1];
+        c += w[2];
+#else
         a += k[0];
         a += ((uint32_t)k[1]) << 8;
         a += ((uint32_t)k[2]) << 16;
@@ -404,6 +792,7 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
         c += ((uint32_t)k[9]) << 8;
         c += ((uint32_t)k[10]) << 16;
         c += ((uint32_t)k[11]) << 24;
+#endif /* !defined(H5_WORDS_BIGENDIAN) && !defined(WORDS_BIGENDIAN) */
         H5_lookup3_mix(a, b, c);
         length -= 12;
         k += 12;
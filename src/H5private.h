@@ -63,6 +63,14 @@
 #include <sys/stat.h>
 #endif
 
+/*
+ * preadv() and pwritev() in sys/uio.h are used by the sec2 driver for vector
+ * I/O.
+ */
+#ifdef H5_HAVE_PREADWRITEV
+#include <sys/uio.h>
+#endif
+
 /*
  * flock() in sys/file.h is used for the implementation of file locking.
  */
@@ -967,6 +975,9 @@ H5_DLL H5_ATTR_CONST int Nflock(int fd, int operation);
 #ifndef HDpread
 #define HDpread(F, B, C, O) pread(F, B, C, O)
 #endif
+#ifndef HDpreadv
+#define HDpreadv(F, V, C, O) preadv(F, V, C, O)
+#endif
 #ifndef HDprintf
 #define HDprintf printf /*varargs*/
 #endif
@@ -982,6 +993,9 @@ H5_DLL H5_ATTR_CONST int Nflock(int fd, int operation);
 #ifndef HDpwrite
 #define HDpwrite(F, B, C, O) pwrite(F, B, C, O)
 #endif
+#ifndef HDpwritev
+#define HDpwritev(F, V, C, O) pwritev(F, V, C, O)
+#endif
 #ifndef HDqsort
 #define HDqsort(M, N, Z, F) qsort(M, N, Z, F)
 #endif
@@ -2189,6 +2203,7 @@ H5_DLL int H5Z_term_package(void);
 /* Checksum functions */
 H5_DLL uint32_t H5_checksum_fletcher32(const void *data, size_t len);
 H5_DLL uint32_t H5_checksum_crc(const void *data, size_t len);
+H5_DLL uint32_t H5_checksum_crc32c(const void *data, size_t len);
 H5_DLL uint32_t H5_checksum_lookup3(const void *data, size_t len, uint32_t initval);
 H5_DLL uint32_t H5_checksum_metadata(const void *data, size_t len, uint32_t initval);
 H5_DLL uint32_t H5_hash_string(const char *str);
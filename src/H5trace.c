@@ -1120,6 +1120,16 @@ H5_trace_args(H5RS_str_t *rs, const char *type, va_list ap)
                                     H5RS_acat(rs, "H5_VFD_ROS3");
                                     break;
 #endif
+#ifdef H5_HAVE_IOURING_VFD
+                                case H5_VFD_IOURING:
+                                    H5RS_acat(rs, "H5_VFD_IOURING");
+                                    break;
+#endif
+#ifdef H5_HAVE_MMAP
+                                case H5_VFD_MMAP:
+                                    H5RS_acat(rs, "H5_VFD_MMAP");
+                                    break;
+#endif
 #ifdef H5_HAVE_SUBFILING_VFD
                                 case H5_VFD_SUBFILING:
                                     H5RS_acat(rs, "H5_VFD_SUBFILING");
@@ -3889,6 +3899,10 @@ H5_trace_args(H5RS_str_t *rs, const char *type, va_list ap)
                                 H5RS_acat(rs, "H5Z_FILTER_NBIT");
                             else if (H5Z_FILTER_SCALEOFFSET == id)
                                 H5RS_acat(rs, "H5Z_FILTER_SCALEOFFSET");
+                            else if (H5Z_FILTER_CRC32C == id)
+                                H5RS_acat(rs, "H5Z_FILTER_CRC32C");
+                            else if (H5Z_FILTER_VLEN == id)
+                                H5RS_acat(rs, "H5Z_FILTER_VLEN");
                             else
                                 H5RS_asprintf_cat(rs, "%ld", (long)id);
                         } /* end block */
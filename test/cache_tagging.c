@@ -2672,6 +2672,7 @@ check_dataset_write_tags(void)
     int verbose = FALSE;         /* verbose file output */
 #endif                           /* NDEBUG */
     hid_t   dcpl       = -1;     /* dataset creation pl */
+    hid_t   dapl       = -1;     /* dataset access pl */
     hsize_t cdims[2]   = {1, 1}; /* chunk dimensions */
     int     fillval    = 0;
     hid_t   fapl       = -1; /* File access prop list */
@@ -2740,7 +2741,17 @@ check_dataset_write_tags(void)
         TEST_ERROR;
     if ((fid = H5Fopen(FILENAME, H5F_ACC_RDWR, H5P_DEFAULT)) < 0)
         TEST_ERROR;
-    if ((did = H5Dopen2(fid, DATASETNAME, H5P_DEFAULT)) < 0)
+
+    /* Disable the chunk cache, so that every chunk written is inserted into
+     * the chunk index during the write, whatever the cache's replacement
+     * policy */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        TEST_ERROR;
+    if (H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, 0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        TEST_ERROR;
+    if ((did = H5Dopen2(fid, DATASETNAME, dapl)) < 0)
+        TEST_ERROR;
+    if (H5Pclose(dapl) < 0)
         TEST_ERROR;
 
     /* Evict as much as we can from the cache so we can track full tag path */
@@ -2773,8 +2784,8 @@ check_dataset_write_tags(void)
         dump_cache(fid);
 #endif /* NDEBUG */ /* end debugging functions */
 
-    /* Verify 10 b-tree nodes belonging to dataset  */
-    for (i = 0; i < 10; i++)
+    /* Verify 19 b-tree nodes belonging to dataset  */
+    for (i = 0; i < 19; i++)
         if (verify_tag(fid, H5AC_BT_ID, d_tag) < 0)
             TEST_ERROR;
 
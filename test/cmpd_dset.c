@@ -2189,6 +2189,152 @@ error:
     return 1;
 } /* test_ooo_order */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_copy_spans
+ *
+ * Purpose:     Reads subsets of the members of a dataset in an order
+ *              different from the one in the file, which the library does
+ *              with the copy spans of the compound conversion.  Checks
+ *              that members needing no conversion, merged spans, members
+ *              needing conversion and members which aren't in the file
+ *              are all handled correctly.
+ *
+ * Return:      Success:    0
+ *
+ *              Failure:    1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define COPY_SPANS_NELMTS 1000
+static unsigned
+test_copy_spans(char *filename, hid_t fapl_id)
+{
+    typedef struct {
+        int    a, b;
+        double c;
+        int    d, e;
+    } file_t;
+    typedef struct {
+        int       e;
+        long long x;
+        int       b;
+        float     c;
+        int       a;
+    } mix_t;
+    typedef struct {
+        int pad;
+        int d, e;
+    } tail_t;
+    file_t *orig  = NULL;
+    mix_t  *mix   = NULL;
+    tail_t *tail  = NULL;
+    hid_t   file  = H5I_INVALID_HID, dset = H5I_INVALID_HID, space = H5I_INVALID_HID;
+    hid_t   ftype = H5I_INVALID_HID, mtype = H5I_INVALID_HID, ttype = H5I_INVALID_HID;
+    hsize_t dim   = COPY_SPANS_NELMTS;
+    hsize_t start = 0, stride = 2, count = COPY_SPANS_NELMTS / 2;
+    size_t  u;
+
+    TESTING("member subset reads with copy spans");
+
+    if (NULL == (orig = (file_t *)HDmalloc(sizeof(file_t) * COPY_SPANS_NELMTS)) ||
+        NULL == (mix = (mix_t *)HDmalloc(sizeof(mix_t) * COPY_SPANS_NELMTS)) ||
+        NULL == (tail = (tail_t *)HDmalloc(sizeof(tail_t) * COPY_SPANS_NELMTS)))
+        TEST_ERROR;
+    for (u = 0; u < COPY_SPANS_NELMTS; u++) {
+        orig[u].a = (int)u;
+        orig[u].b = (int)u * 2 + 1;
+        orig[u].c = (double)u / 8.0;
+        orig[u].d = (int)u * 3 + 2;
+        orig[u].e = (int)u * 5 + 3;
+    } /* end for */
+
+    /* Create the dataset with all five members */
+    if ((ftype = H5Tcreate(H5T_COMPOUND, sizeof(file_t))) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(ftype, "a", HOFFSET(file_t, a), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(ftype, "b", HOFFSET(file_t, b), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(ftype, "c", HOFFSET(file_t, c), H5T_NATIVE_DOUBLE) < 0 ||
+        H5Tinsert(ftype, "d", HOFFSET(file_t, d), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(ftype, "e", HOFFSET(file_t, e), H5T_NATIVE_INT) < 0)
+        TEST_ERROR;
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id)) < 0)
+        TEST_ERROR;
+    if ((space = H5Screate_simple(1, &dim, NULL)) < 0)
+        TEST_ERROR;
+    if ((dset = H5Dcreate2(file, "copy_spans", ftype, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Dwrite(dset, ftype, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+        TEST_ERROR;
+
+    /* Read members in a different order, one of them converted, together
+     * with a member which isn't in the file and must be left alone */
+    if ((mtype = H5Tcreate(H5T_COMPOUND, sizeof(mix_t))) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(mtype, "e", HOFFSET(mix_t, e), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(mtype, "x", HOFFSET(mix_t, x), H5T_NATIVE_LLONG) < 0 ||
+        H5Tinsert(mtype, "b", HOFFSET(mix_t, b), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(mtype, "c", HOFFSET(mix_t, c), H5T_NATIVE_FLOAT) < 0 ||
+        H5Tinsert(mtype, "a", HOFFSET(mix_t, a), H5T_NATIVE_INT) < 0)
+        TEST_ERROR;
+    HDmemset(mix, 0, sizeof(mix_t) * COPY_SPANS_NELMTS);
+    for (u = 0; u < COPY_SPANS_NELMTS; u++)
+        mix[u].x = -(long long)u;
+    if (H5Dread(dset, mtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, mix) < 0)
+        TEST_ERROR;
+    for (u = 0; u < COPY_SPANS_NELMTS; u++)
+        if (mix[u].a != orig[u].a || mix[u].b != orig[u].b || mix[u].e != orig[u].e ||
+            !H5_FLT_ABS_EQUAL(mix[u].c, (float)orig[u].c) || mix[u].x != -(long long)u)
+            FAIL_PUTS_ERROR("    incorrect values for reordered members");
+
+    /* Read two members which are adjacent in both types, but not a prefix of
+     * either, into every other element of the buffer */
+    if ((ttype = H5Tcreate(H5T_COMPOUND, sizeof(tail_t))) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(ttype, "d", HOFFSET(tail_t, d), H5T_NATIVE_INT) < 0 ||
+        H5Tinsert(ttype, "e", HOFFSET(tail_t, e), H5T_NATIVE_INT) < 0)
+        TEST_ERROR;
+    for (u = 0; u < COPY_SPANS_NELMTS; u++)
+        tail[u].pad = tail[u].d = tail[u].e = -1;
+    if (H5Sselect_hyperslab(space, H5S_SELECT_SET, &start, &stride, &count, NULL) < 0)
+        TEST_ERROR;
+    if (H5Dread(dset, ttype, space, space, H5P_DEFAULT, tail) < 0)
+        TEST_ERROR;
+    for (u = 0; u < COPY_SPANS_NELMTS; u++) {
+        int d = (u % 2) ? -1 : orig[u].d;
+        int e = (u % 2) ? -1 : orig[u].e;
+
+        if (tail[u].pad != -1 || tail[u].d != d || tail[u].e != e)
+            FAIL_PUTS_ERROR("    incorrect values for adjacent members");
+    } /* end for */
+
+    if (H5Dclose(dset) < 0 || H5Sclose(space) < 0 || H5Fclose(file) < 0)
+        TEST_ERROR;
+    if (H5Tclose(ftype) < 0 || H5Tclose(mtype) < 0 || H5Tclose(ttype) < 0)
+        TEST_ERROR;
+    HDfree(orig);
+    HDfree(mix);
+    HDfree(tail);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dset);
+        H5Sclose(space);
+        H5Fclose(file);
+        H5Tclose(ftype);
+        H5Tclose(mtype);
+        H5Tclose(ttype);
+    }
+    H5E_END_TRY
+    HDfree(orig);
+    HDfree(mix);
+    HDfree(tail);
+    return 1;
+} /* test_copy_spans */
+
 /*-------------------------------------------------------------------------
  * Function:    main
  *
@@ -2245,6 +2391,9 @@ main(int argc, char *argv[])
     HDputs("Testing compound member ordering:");
     nerrors += test_ooo_order(fname, fapl_id);
 
+    HDputs("Testing member subset reads with copy spans:");
+    nerrors += test_copy_spans(fname, fapl_id);
+
     /* Verify symbol table messages are cached */
     nerrors += (h5_verify_cached_stabs(FILENAME, fapl_id) < 0 ? 1 : 0);
 
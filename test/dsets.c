@@ -84,6 +84,14 @@ static const char *FILENAME[] = {"dataset",             /* 0 */
                                  "alloc_0sized",        /* 26 */
                                  "h5s_block",           /* 27 */
                                  "h5s_plist",           /* 28 */
+                                 "filter_nthreads",     /* 29 */
+                                 "chunk_cache_sets",    /* 30 */
+                                 "file_chunk_cache",    /* 31 */
+                                 "chunk_prefetch",      /* 32 */
+                                 "chunk_lookup_batch",  /* 33 */
+                                 "vector_read_gap",     /* 34 */
+                                 "sel_plan",            /* 35 */
+                                 "nthreads_flush",      /* 36 */
                                  NULL};
 
 #define OHMIN_FILENAME_A "ohdr_min_a"
@@ -111,6 +119,12 @@ static const char *FILENAME[] = {"dataset",             /* 0 */
 #define DSET_FLETCHER32_NAME   "fletcher32"
 #define DSET_FLETCHER32_NAME_2 "fletcher32_2"
 #define DSET_FLETCHER32_NAME_3 "fletcher32_3"
+#define DSET_CRC32C_NAME       "crc32c"
+#define DSET_CRC32C_NAME_2     "crc32c_2"
+#define DSET_CRC32C_NAME_3     "crc32c_3"
+#define DSET_DEFLATE_STRM_NAME   "deflate_streams"
+#define DSET_DEFLATE_STRM_NAME_2 "deflate_streams_2"
+#define DSET_BUF_POOL_NAME       "buffer_pool"
 #ifdef H5_HAVE_FILTER_DEFLATE
 #define DSET_SHUF_DEF_FLET_NAME   "shuffle+deflate+fletcher32"
 #define DSET_SHUF_DEF_FLET_NAME_2 "shuffle+deflate+fletcher32_2"
@@ -133,6 +147,9 @@ static const char *FILENAME[] = {"dataset",             /* 0 */
 #define DSET_SET_LOCAL_NAME            "set_local"
 #define DSET_SET_LOCAL_NAME_2          "set_local_2"
 #define DSET_ONEBYTE_SHUF_NAME         "onebyte_shuffle"
+#define DSET_BITSHUF_NAME              "bitshuffle"
+#define DSET_BITSHUF_NAME_2            "bitshuffle_2"
+#define DSET_BITSHUF_NAME_3            "bitshuffle_3"
 #define DSET_NBIT_INT_NAME             "nbit_int"
 #define DSET_NBIT_FLOAT_NAME           "nbit_float"
 #define DSET_NBIT_DOUBLE_NAME          "nbit_double"
@@ -1861,7 +1878,7 @@ static H5Z_cb_return_t
 filter_cb_cont(H5Z_filter_t filter, void H5_ATTR_UNUSED *buf, size_t H5_ATTR_UNUSED buf_size,
                void H5_ATTR_UNUSED *op_data)
 {
-    if (H5Z_FILTER_FLETCHER32 == filter)
+    if (H5Z_FILTER_FLETCHER32 == filter || H5Z_FILTER_CRC32C == filter)
         return H5Z_CB_CONT;
     else
         return H5Z_CB_FAIL;
@@ -1879,7 +1896,7 @@ static H5Z_cb_return_t
 filter_cb_fail(H5Z_filter_t filter, void H5_ATTR_UNUSED *buf, size_t H5_ATTR_UNUSED buf_size,
                void H5_ATTR_UNUSED *op_data)
 {
-    if (H5Z_FILTER_FLETCHER32 == filter)
+    if (H5Z_FILTER_FLETCHER32 == filter || H5Z_FILTER_CRC32C == filter)
         return H5Z_CB_FAIL;
     else
         return H5Z_CB_CONT;
@@ -2436,6 +2453,13 @@ test_get_filter_info(void)
         ((flags & H5Z_FILTER_CONFIG_DECODE_ENABLED) == 0))
         TEST_ERROR;
 
+    if (H5Zget_filter_info(H5Z_FILTER_CRC32C, &flags) < 0)
+        TEST_ERROR;
+
+    if (((flags & H5Z_FILTER_CONFIG_ENCODE_ENABLED) == 0) ||
+        ((flags & H5Z_FILTER_CONFIG_DECODE_ENABLED) == 0))
+        TEST_ERROR;
+
     if (H5Zget_filter_info(H5Z_FILTER_SHUFFLE, &flags) < 0)
         TEST_ERROR;
 
@@ -2502,6 +2526,7 @@ test_filters(hid_t file)
     hsize_t       null_size; /* Size of dataset with null filter */
 
     hsize_t  fletcher32_size; /* Size of dataset with Fletcher32 checksum */
+    hsize_t  crc32c_size;     /* Size of dataset with CRC32C checksum */
     unsigned data_corrupt[3]; /* position and length of data to be corrupted */
 
 #ifdef H5_HAVE_FILTER_DEFLATE
@@ -2598,6 +2623,46 @@ test_filters(hid_t file)
         goto error;
     } /* end if */
 
+    /* Clean up objects used for this test */
+    if (H5Pclose(dc) < 0)
+        goto error;
+
+    /*----------------------------------------------------------
+     * STEP 1a: Test CRC32C Checksum by itself.
+     *----------------------------------------------------------
+     */
+    HDputs("Testing CRC32C checksum(enabled for read)");
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
+        goto error;
+    if (H5Pset_filter(dc, H5Z_FILTER_CRC32C, 0, (size_t)0, NULL) < 0)
+        goto error;
+
+    /* Enable checksum during read */
+    if (test_filter_internal(file, DSET_CRC32C_NAME, dc, ENABLE_FLETCHER32, DATA_NOT_CORRUPTED,
+                             &crc32c_size) < 0)
+        goto error;
+    if (crc32c_size <= null_size) {
+        H5_FAILED();
+        HDputs("    Size after checksumming is incorrect.");
+        goto error;
+    } /* end if */
+
+    /* Disable checksum during read */
+    HDputs("Testing CRC32C checksum(disabled for read)");
+    if (test_filter_internal(file, DSET_CRC32C_NAME_2, dc, DISABLE_FLETCHER32, DATA_NOT_CORRUPTED,
+                             &crc32c_size) < 0)
+        goto error;
+
+    /* Try to corrupt data and see if checksum fails */
+    HDputs("Testing CRC32C checksum(when data is corrupted)");
+    if (H5Pset_filter(dc, H5Z_FILTER_CORRUPT, 0, (size_t)3, data_corrupt) < 0)
+        goto error;
+    if (test_filter_internal(file, DSET_CRC32C_NAME_3, dc, DISABLE_FLETCHER32, DATA_CORRUPTED,
+                             &crc32c_size) < 0)
+        goto error;
+
     /* Clean up objects used for this test */
     if (H5Pclose(dc) < 0)
         goto error;
@@ -3177,419 +3242,690 @@ error:
 } /* end test_onebyte_shuffle() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_int
+ * Function:  test_shuffle_kernels
  *
- * Purpose:     Tests the integer datatype for nbit filter
+ * Purpose:   Tests that the vector kernels of the shuffle filter that the
+ *            CPU supports give the same bytes as the scalar loops, for the
+ *            element sizes they handle and others, and for numbers of
+ *            elements that do and don't fill whole vectors.
  *
- * Return:      Success:        0
- *              Failure:        -1
+ * Return:    Success:    0
+ *            Failure:    -1
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_int(hid_t file)
+test_shuffle_kernels(void)
 {
-    hid_t        dataset, datatype, mem_datatype, space, dc;
-    hsize_t      size[2]       = {2, 5};
-    hsize_t      chunk_size[2] = {2, 5};
-    int          orig_data[2][5];
-    int          new_data[2][5];
-    unsigned int mask;
-    size_t       precision, offset;
-    double       power;
-    size_t       i, j;
+    const unsigned    elmt_sizes[] = {2, 3, 4, 5, 8, 12, 16, 17};
+    const size_t      nelmts[]     = {2, 15, 16, 17, 63, 64, 65, 127, 129, 1000, 4099};
+    const size_t      max_nbytes   = 17 * 4099;
+    unsigned char    *orig         = NULL;
+    unsigned char    *expected     = NULL;
+    unsigned char    *shuffled     = NULL;
+    unsigned char    *unshuffled   = NULL;
+    H5Z_shuffle_isa_t best_isa;
+    int               isa;
+    size_t            u, v, w;
 
-    HDputs("Testing nbit filter");
-    TESTING("    nbit int (setup)");
+    TESTING("shuffle filter vector kernels");
 
-    /* Define dataset datatype (integer), and set precision, offset */
-    datatype  = H5Tcopy(H5T_NATIVE_INT);
-    precision = 17; /* precision includes sign bit */
-    if (H5Tset_precision(datatype, precision) < 0)
-        goto error;
-    offset = 4;
-    if (H5Tset_offset(datatype, offset) < 0)
-        goto error;
+    if (NULL == (orig = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
+    if (NULL == (expected = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
+    if (NULL == (shuffled = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
+    if (NULL == (unshuffled = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
 
-    /* Copy to memory datatype before setting order */
-    mem_datatype = H5Tcopy(datatype);
+    for (u = 0; u < max_nbytes; u++)
+        orig[u] = (unsigned char)HDrandom();
 
-    /* Set order of dataset datatype */
-    if (H5Tset_order(datatype, H5T_ORDER_BE) < 0)
-        goto error;
+    best_isa = H5Z__shuffle_best_isa();
 
-    /* Create the data space */
-    if ((space = H5Screate_simple(2, size, NULL)) < 0)
-        goto error;
+    for (u = 0; u < NELMTS(elmt_sizes); u++)
+        for (v = 0; v < NELMTS(nelmts); v++) {
+            size_t nbytes = elmt_sizes[u] * nelmts[v];
 
-    /* Use nbit filter  */
-    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        goto error;
-    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
-        goto error;
-    if (H5Pset_nbit(dc) < 0)
-        goto error;
+            /* Shuffle with the scalar loops, by hand */
+            for (w = 0; w < nbytes; w++)
+                expected[(w % elmt_sizes[u]) * nelmts[v] + (w / elmt_sizes[u])] = orig[w];
 
-    /* Create the dataset */
-    if ((dataset = H5Dcreate2(file, DSET_NBIT_INT_NAME, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
-        goto error;
+            for (isa = H5Z_SHUFFLE_ISA_SCALAR; isa <= (int)best_isa; isa++) {
+                HDmemset(shuffled, 0, nbytes);
+                HDmemset(unshuffled, 0, nbytes);
 
-    /* Initialize data, assuming size of long long >= size of int */
-    for (i = 0; i < (size_t)size[0]; i++)
-        for (j = 0; j < (size_t)size[1]; j++) {
-            power           = HDpow(2.0, (double)(precision - 1));
-            orig_data[i][j] = (int)(((long long)HDrandom() % (long long)power) << offset);
+                if (H5Z__shuffle_bytes((H5Z_shuffle_isa_t)isa, FALSE, elmt_sizes[u], nelmts[v], orig,
+                                       shuffled) < 0)
+                    TEST_ERROR;
+                if (HDmemcmp(shuffled, expected, nbytes) != 0) {
+                    H5_FAILED();
+                    HDprintf("    Wrong shuffle, instruction set %d, %u-byte elements, %zu elements\n", isa,
+                             elmt_sizes[u], nelmts[v]);
+                    goto error;
+                }
 
-            /* even-numbered values are negative */
-            if ((i * size[1] + j + 1) % 2 == 0)
-                orig_data[i][j] = -orig_data[i][j];
+                if (H5Z__shuffle_bytes((H5Z_shuffle_isa_t)isa, TRUE, elmt_sizes[u], nelmts[v], shuffled,
+                                       unshuffled) < 0)
+                    TEST_ERROR;
+                if (HDmemcmp(unshuffled, orig, nbytes) != 0) {
+                    H5_FAILED();
+                    HDprintf("    Wrong unshuffle, instruction set %d, %u-byte elements, %zu elements\n",
+                             isa, elmt_sizes[u], nelmts[v]);
+                    goto error;
+                }
+            }
         }
 
-    PASSED();
+    /* An instruction set that the CPU doesn't support should fail */
+    if (best_isa < H5Z_SHUFFLE_ISA_AVX512) {
+        herr_t ret;
 
-    /*----------------------------------------------------------------------
-     * STEP 1: Test nbit by setting up a chunked dataset and writing
-     * to it.
-     *----------------------------------------------------------------------
-     */
-    TESTING("    nbit int (write)");
+        H5E_BEGIN_TRY
+        {
+            ret = H5Z__shuffle_bytes((H5Z_shuffle_isa_t)((int)best_isa + 1), FALSE, 4, 16, orig, shuffled);
+        }
+        H5E_END_TRY;
+        if (ret >= 0)
+            TEST_ERROR;
+    }
+
+    HDfree(orig);
+    HDfree(expected);
+    HDfree(shuffled);
+    HDfree(unshuffled);
 
-    if (H5Dwrite(dataset, mem_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
-        goto error;
     PASSED();
 
-    /*----------------------------------------------------------------------
-     * STEP 2: Try to read the data we just wrote.
-     *----------------------------------------------------------------------
-     */
-    TESTING("    nbit int (read)");
+    return SUCCEED;
 
-    /* Read the dataset back */
-    if (H5Dread(dataset, mem_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
-        goto error;
+error:
+    HDfree(orig);
+    HDfree(expected);
+    HDfree(shuffled);
+    HDfree(unshuffled);
 
-    /* Check that the values read are the same as the values written
-     * Use mask for checking the significant bits, ignoring the padding bits
-     */
-    mask = ~((unsigned)~0 << (precision + offset)) & ((unsigned)~0 << offset);
-    for (i = 0; i < (size_t)size[0]; i++) {
-        for (j = 0; j < (size_t)size[1]; j++) {
-            if (((unsigned)new_data[i][j] & mask) != ((unsigned)orig_data[i][j] & mask)) {
+    return FAIL;
+} /* end test_shuffle_kernels() */
+
+/*-------------------------------------------------------------------------
+ * Function:  test_bitshuffle
+ *
+ * Purpose:   Tests the bit mode of the shuffle filter on integer data with
+ *            few active bits, alone and followed by deflate, with chunks
+ *            that don't hold a whole number of groups of 8 elements.
+ *
+ * Return:    Success:    0
+ *            Failure:    -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_bitshuffle(hid_t file)
+{
+    hid_t         dataset = H5I_INVALID_HID, space = H5I_INVALID_HID, dc = H5I_INVALID_HID;
+    hid_t         dcpl2   = H5I_INVALID_HID;
+    const hsize_t size[2]       = {10, 36};
+    const hsize_t chunk_size[2] = {5, 15};
+    int           orig_data[10][36];
+    int           new_data[10][36];
+    unsigned char orig_bytes[10][36];
+    unsigned char new_bytes[10][36];
+    unsigned      cd_values[H5Z_SHUFFLE_MAX_NPARMS] = {0, H5Z_SHUFFLE_MODE_BIT};
+    unsigned      filter_config;
+    size_t        cd_nelmts;
+    size_t        i, j;
+
+    TESTING("bit shuffling");
+
+    for (i = 0; i < 10; i++)
+        for (j = 0; j < 36; j++) {
+            orig_data[i][j]  = (int)(HDrandom() % 37) - 18;
+            orig_bytes[i][j] = (unsigned char)HDrandom();
+        }
+
+    if ((space = H5Screate_simple(2, size, NULL)) < 0)
+        TEST_ERROR;
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR;
+    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
+        TEST_ERROR;
+    if (H5Pset_filter(dc, H5Z_FILTER_SHUFFLE, H5Z_FLAG_OPTIONAL, (size_t)H5Z_SHUFFLE_MAX_NPARMS, cd_values) <
+        0)
+        TEST_ERROR;
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if (H5Pset_deflate(dc, 6) < 0)
+        TEST_ERROR;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    /* Integers, with the mode recorded after the datatype size */
+    if ((dataset = H5Dcreate2(file, DSET_BITSHUF_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, dc, H5P_DEFAULT)) <
+        0)
+        TEST_ERROR;
+    if (H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+        TEST_ERROR;
+    if ((dcpl2 = H5Dget_create_plist(dataset)) < 0)
+        TEST_ERROR;
+    cd_nelmts = H5Z_SHUFFLE_MAX_NPARMS;
+    if (H5Pget_filter_by_id2(dcpl2, H5Z_FILTER_SHUFFLE, NULL, &cd_nelmts, cd_values, 0, NULL,
+                             &filter_config) < 0)
+        TEST_ERROR;
+    if (cd_nelmts != H5Z_SHUFFLE_MAX_NPARMS || cd_values[0] != sizeof(int) ||
+        cd_values[H5Z_SHUFFLE_PARM_MODE] != H5Z_SHUFFLE_MODE_BIT)
+        TEST_ERROR;
+    if (H5Dclose(dataset) < 0)
+        TEST_ERROR;
+
+    /* The dataset's own creation property list makes another bit shuffled dataset */
+    if ((dataset = H5Dcreate2(file, DSET_BITSHUF_NAME_2, H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dcpl2,
+                              H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Dwrite(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_bytes) < 0)
+        TEST_ERROR;
+    if (H5Dclose(dataset) < 0)
+        TEST_ERROR;
+
+    /* Read the data back */
+    if ((dataset = H5Dopen2(file, DSET_BITSHUF_NAME, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+        TEST_ERROR;
+    if (H5Dclose(dataset) < 0)
+        TEST_ERROR;
+    if ((dataset = H5Dopen2(file, DSET_BITSHUF_NAME_2, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Dread(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_bytes) < 0)
+        TEST_ERROR;
+    if (H5Dclose(dataset) < 0)
+        TEST_ERROR;
+
+    for (i = 0; i < 10; i++)
+        for (j = 0; j < 36; j++)
+            if (new_data[i][j] != orig_data[i][j] || new_bytes[i][j] != orig_bytes[i][j]) {
                 H5_FAILED();
                 HDprintf("    Read different values than written.\n");
                 HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
                 goto error;
             }
-        }
+
+    /* An unknown mode should fail when the dataset is created */
+    cd_values[0]                     = 0;
+    cd_values[H5Z_SHUFFLE_PARM_MODE] = 2;
+    if (H5Pmodify_filter(dc, H5Z_FILTER_SHUFFLE, H5Z_FLAG_OPTIONAL, (size_t)H5Z_SHUFFLE_MAX_NPARMS,
+                         cd_values) < 0)
+        TEST_ERROR;
+    H5E_BEGIN_TRY
+    {
+        dataset = H5Dcreate2(file, DSET_BITSHUF_NAME_3, H5T_NATIVE_INT, space, H5P_DEFAULT, dc, H5P_DEFAULT);
     }
+    H5E_END_TRY;
+    if (dataset >= 0)
+        FAIL_PUTS_ERROR("    Dataset creation with an invalid shuffle mode succeeded.");
 
-    /*----------------------------------------------------------------------
-     * Cleanup
-     *----------------------------------------------------------------------
-     */
-    if (H5Tclose(datatype) < 0)
-        goto error;
-    if (H5Tclose(mem_datatype) < 0)
-        goto error;
+    if (H5Pclose(dcpl2) < 0)
+        TEST_ERROR;
     if (H5Pclose(dc) < 0)
-        goto error;
+        TEST_ERROR;
     if (H5Sclose(space) < 0)
-        goto error;
-    if (H5Dclose(dataset) < 0)
-        goto error;
+        TEST_ERROR;
 
     PASSED();
 
     return SUCCEED;
 
 error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dataset);
+        H5Pclose(dcpl2);
+        H5Pclose(dc);
+        H5Sclose(space);
+    }
+    H5E_END_TRY;
+
     return FAIL;
-} /* end test_nbit_int() */
+} /* end test_bitshuffle() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_float
+ * Function:  test_deflate_streams
  *
- * Purpose:     Tests the float datatype of nbit filter
+ * Purpose:   Tests that the deflate filter's reused zlib streams give the
+ *            right data when chunks of different sizes, compression levels
+ *            and compression ratios are written and read in turn, so the
+ *            output buffer sizes guessed from earlier chunks are too large
+ *            or too small.
  *
- * Return:      Success:        0
- *              Failure:        -1
+ * Return:    Success:    0
+ *            Failure:    -1
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_float(hid_t file)
+test_deflate_streams(hid_t file)
 {
-    hid_t         dataset, datatype, space, dc;
-    const hsize_t size[2]       = {2, 5};
-    const hsize_t chunk_size[2] = {2, 5};
-    /* orig_data[] are initialized to be within the range that can be represented by
-     * dataset datatype (no precision loss during datatype conversion)
-     */
-    float  orig_data[2][5] = {{188384.0F, 19.103516F, -1.0831790e9F, -84.242188F, 5.2045898F},
-                             {-49140.0F, 2350.25F, -3.2110596e-1F, 6.4998865e-5F, -0.0F}};
-    float  new_data[2][5];
-    size_t precision, offset;
-    size_t i, j;
+#ifdef H5_HAVE_FILTER_DEFLATE
+    const char    *names[2]      = {DSET_DEFLATE_STRM_NAME, DSET_DEFLATE_STRM_NAME_2};
+    const hsize_t  chunk_size[2] = {4096, 65536};
+    const hsize_t  nchunks[2]    = {6, 3};
+    const int      levels[2]     = {1, 9};
+    hid_t          dataset[2]    = {H5I_INVALID_HID, H5I_INVALID_HID};
+    hid_t          space = H5I_INVALID_HID, dc = H5I_INVALID_HID, dapl = H5I_INVALID_HID;
+    unsigned char *orig[2]       = {NULL, NULL};
+    unsigned char *data          = NULL;
+    hsize_t        dims[1];
+    unsigned       pass;
+    size_t         u, v;
 
-    TESTING("    nbit float (setup)");
+    TESTING("deflate filter stream reuse");
 
-    /* Define user-defined single-precision floating-point type for dataset */
-    datatype = H5Tcopy(H5T_IEEE_F32BE);
-    if (H5Tset_fields(datatype, (size_t)26, (size_t)20, (size_t)6, (size_t)7, (size_t)13) < 0)
-        FAIL_STACK_ERROR;
-    offset = 7;
-    if (H5Tset_offset(datatype, offset) < 0)
-        FAIL_STACK_ERROR;
-    precision = 20;
-    if (H5Tset_precision(datatype, precision) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_size(datatype, (size_t)4) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_ebias(datatype, (size_t)31) < 0)
-        FAIL_STACK_ERROR;
+    /* Keep the chunks out of the cache, so every read goes through the filter */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        TEST_ERROR;
+    if (H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, 0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        TEST_ERROR;
 
-    /* Create the data space */
-    if ((space = H5Screate_simple(2, size, NULL)) < 0)
-        FAIL_STACK_ERROR;
-
-    /* Use nbit filter  */
-    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_nbit(dc) < 0)
-        FAIL_STACK_ERROR;
+    for (u = 0; u < 2; u++) {
+        size_t nbytes = (size_t)(chunk_size[u] * nchunks[u]);
 
-    /* Create the dataset */
-    if ((dataset = H5Dcreate2(file, DSET_NBIT_FLOAT_NAME, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
-        FAIL_STACK_ERROR;
-    PASSED();
+        /* Chunks of zeros, random bytes and small random numbers, which
+         * compress very well, not at all and somewhat */
+        if (NULL == (orig[u] = (unsigned char *)HDmalloc(nbytes)))
+            TEST_ERROR;
+        for (v = 0; v < nbytes; v++)
+            switch ((v / chunk_size[u]) % 3) {
+                case 0:
+                    orig[u][v] = 0;
+                    break;
+                case 1:
+                    orig[u][v] = (unsigned char)HDrandom();
+                    break;
+                default:
+                    orig[u][v] = (unsigned char)(HDrandom() % 4);
+                    break;
+            } /* end switch */
+
+        dims[0] = chunk_size[u] * nchunks[u];
+        if ((space = H5Screate_simple(1, dims, NULL)) < 0)
+            TEST_ERROR;
+        if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+            TEST_ERROR;
+        if (H5Pset_chunk(dc, 1, &chunk_size[u]) < 0)
+            TEST_ERROR;
+        if (H5Pset_deflate(dc, (unsigned)levels[u]) < 0)
+            TEST_ERROR;
+        if ((dataset[u] = H5Dcreate2(file, names[u], H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dc, dapl)) < 0)
+            TEST_ERROR;
+        if (H5Pclose(dc) < 0)
+            TEST_ERROR;
+        if (H5Sclose(space) < 0)
+            TEST_ERROR;
+    } /* end for */
 
-    /*----------------------------------------------------------------------
-     * STEP 1: Test nbit by setting up a chunked dataset and writing
-     * to it.
-     *----------------------------------------------------------------------
-     */
-    TESTING("    nbit float (write)");
+    /* Write both datasets, then read them back in turn, twice */
+    for (u = 0; u < 2; u++)
+        if (H5Dwrite(dataset[u], H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig[u]) < 0)
+            TEST_ERROR;
+    if (NULL == (data = (unsigned char *)HDmalloc((size_t)(chunk_size[1] * nchunks[1]))))
+        TEST_ERROR;
+    for (pass = 0; pass < 4; pass++) {
+        u = pass % 2;
+        HDmemset(data, 0xff, (size_t)(chunk_size[u] * nchunks[u]));
+        if (H5Dread(dataset[u], H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+            TEST_ERROR;
+        if (HDmemcmp(data, orig[u], (size_t)(chunk_size[u] * nchunks[u])) != 0) {
+            H5_FAILED();
+            HDprintf("    Read different values than written from dataset '%s'\n", names[u]);
+            goto error;
+        } /* end if */
+    }     /* end for */
 
-    if (H5Dwrite(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
-        FAIL_STACK_ERROR;
+    for (u = 0; u < 2; u++) {
+        if (H5Dclose(dataset[u]) < 0)
+            TEST_ERROR;
+        HDfree(orig[u]);
+    } /* end for */
+    HDfree(data);
+    if (H5Pclose(dapl) < 0)
+        TEST_ERROR;
 
     PASSED();
 
-    /*----------------------------------------------------------------------
-     * STEP 2: Try to read the data we just wrote.
-     *----------------------------------------------------------------------
-     */
-    TESTING("    nbit float (read)");
-
-    /* Read the dataset back */
-    if (H5Dread(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
-        FAIL_STACK_ERROR;
+    return SUCCEED;
 
-    /* Check that the values read are the same as the values written
-     * Assume size of int = size of float
-     */
-    for (i = 0; i < (size_t)size[0]; i++) {
-        for (j = 0; j < (size_t)size[1]; j++) {
-            if (HDisnan(orig_data[i][j]))
-                continue; /* skip if value is NaN */
-            if (!H5_FLT_ABS_EQUAL(new_data[i][j], orig_data[i][j])) {
-                H5_FAILED();
-                HDprintf("    Read different values than written.\n");
-                HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
-                goto error;
-            }
+error:
+    H5E_BEGIN_TRY
+    {
+        for (u = 0; u < 2; u++) {
+            H5Dclose(dataset[u]);
+            HDfree(orig[u]);
         }
+        H5Pclose(dc);
+        H5Pclose(dapl);
+        H5Sclose(space);
     }
+    H5E_END_TRY;
+    HDfree(data);
 
-    /*----------------------------------------------------------------------
-     * Cleanup
-     *----------------------------------------------------------------------
-     */
-    if (H5Tclose(datatype) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pclose(dc) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Sclose(space) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Dclose(dataset) < 0)
-        FAIL_STACK_ERROR;
+    return FAIL;
+#else  /* H5_HAVE_FILTER_DEFLATE */
+    (void)file; /* Silence compiler */
 
-    PASSED();
+    TESTING("deflate filter stream reuse");
+    SKIPPED();
+    HDputs("    Deflate filter not enabled");
 
     return SUCCEED;
-
-error:
-    return FAIL;
-} /* end test_nbit_float() */
+#endif /* H5_HAVE_FILTER_DEFLATE */
+} /* end test_deflate_streams() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_double
+ * Function:  test_filter_buffer_pool
  *
- * Purpose:     Tests the double datatype of nbit filter
+ * Purpose:   Tests the pool of filter buffers: that idle buffers are
+ *            reused for requests of about their size, that small
+ *            buffers aren't kept, that the pool stays under its limit
+ *            and that H5garbage_collect() empties it.  Then reads a
+ *            filtered dataset chunk by chunk and checks that the chunk
+ *            buffers go back to the pool.
+ *
+ * Return:    Success:    0
+ *            Failure:    -1
  *
- * Return:      Success:        0
- *              Failure:        -1
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_double(hid_t file)
+test_filter_buffer_pool(hid_t file)
 {
-    /* assume unsigned int and float has the same number of bytes */
-    hid_t         dataset, datatype, space, dc;
-    const hsize_t size[2]       = {2, 5};
-    const hsize_t chunk_size[2] = {2, 5};
-    /* orig_data[] are initialized to be within the range that can be represented by
-     * dataset datatype (no precision loss during datatype conversion)
-     */
-    double orig_data[2][5] = {{(double)1.6081706885101836e+60L, -255.32099170994480,
-                               (double)1.2677579992621376e-61L, 64568.289448797700,
-                               (double)-1.0619721778839084e-75L},
-                              {(double)2.1499497833454840e+56L, 6.6562295504670740e-3, -1.5747263393432150,
-                               1.0711093225222612, -9.8971679387636870e-1}};
-    double new_data[2][5];
-    size_t precision, offset;
-    size_t i, j;
-
-    TESTING("    nbit double (setup)");
-
-    /* Define user-defined doule-precision floating-point type for dataset */
-    datatype = H5Tcopy(H5T_IEEE_F64BE);
-    if (H5Tset_fields(datatype, (size_t)55, (size_t)46, (size_t)9, (size_t)5, (size_t)41) < 0)
-        FAIL_STACK_ERROR;
-    offset = 5;
-    if (H5Tset_offset(datatype, offset) < 0)
-        FAIL_STACK_ERROR;
-    precision = 51;
-    if (H5Tset_precision(datatype, precision) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_size(datatype, (size_t)8) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_ebias(datatype, (size_t)255) < 0)
-        FAIL_STACK_ERROR;
-
-    /* Create the data space */
-    if ((space = H5Screate_simple(2, size, NULL)) < 0)
-        FAIL_STACK_ERROR;
+    const hsize_t chunk_size = 16384;
+    const size_t  nbig       = 48;
+    hid_t         dataset    = H5I_INVALID_HID;
+    hid_t         space = H5I_INVALID_HID, dc = H5I_INVALID_HID, dapl = H5I_INVALID_HID;
+    void         *big[48];
+    void         *buf1 = NULL, *buf2 = NULL;
+    int          *orig = NULL;
+    int          *data = NULL;
+    hsize_t       dims[1];
+    size_t        nbufs, nbytes;
+    size_t        u;
 
-    /* Use nbit filter  */
-    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_nbit(dc) < 0)
-        FAIL_STACK_ERROR;
+    TESTING("filter buffer pool");
 
-    /* Create the dataset */
-    if ((dataset = H5Dcreate2(file, DSET_NBIT_DOUBLE_NAME, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) <
-        0)
-        FAIL_STACK_ERROR;
+    HDmemset(big, 0, sizeof(big));
 
-    PASSED();
+    /* Start from an empty pool */
+    if (H5garbage_collect() < 0)
+        TEST_ERROR;
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 0 || nbytes != 0)
+        TEST_ERROR;
 
-    /*----------------------------------------------------------------------
-     * STEP 1: Test nbit by setting up a chunked dataset and writing
-     * to it.
-     *----------------------------------------------------------------------
-     */
-    TESTING("    nbit double (write)");
+    /* An idle buffer serves a request a bit smaller, but not one much smaller */
+    if (NULL == (buf1 = H5Z_buf_malloc(65536)))
+        TEST_ERROR;
+    buf1 = H5Z_buf_free(buf1, 65536);
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 1 || nbytes != 65536)
+        TEST_ERROR;
+    if (NULL == (buf1 = H5Z_buf_malloc(60000)))
+        TEST_ERROR;
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 0 || nbytes != 0)
+        TEST_ERROR;
+    buf1 = H5Z_buf_free(buf1, 65536);
+    if (NULL == (buf2 = H5Z_buf_malloc(40000)))
+        TEST_ERROR;
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 1 || nbytes != 65536)
+        TEST_ERROR;
+    buf2 = H5Z_buf_free(buf2, 40000);
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 2 || nbytes != 65536 + 40000)
+        TEST_ERROR;
 
-    if (H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
-        FAIL_STACK_ERROR;
-    PASSED();
+    /* Small buffers go straight back to the system */
+    if (NULL == (buf1 = H5Z_buf_malloc(100)))
+        TEST_ERROR;
+    buf1 = H5Z_buf_free(buf1, 100);
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 2)
+        TEST_ERROR;
 
-    /*----------------------------------------------------------------------
-     * STEP 2: Try to read the data we just wrote.
-     *----------------------------------------------------------------------
-     */
-    TESTING("    nbit double (read)");
+    /* The pool doesn't grow past its limit */
+    for (u = 0; u < nbig; u++)
+        if (NULL == (big[u] = H5Z_buf_malloc(1024 * 1024)))
+            TEST_ERROR;
+    for (u = 0; u < nbig; u++)
+        big[u] = H5Z_buf_free(big[u], 1024 * 1024);
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbytes > H5Z_BUF_POOL_LIMIT || nbufs < 2)
+        TEST_ERROR;
 
-    /* Read the dataset back */
-    if (H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
-        FAIL_STACK_ERROR;
+    /* Garbage collection empties it */
+    if (H5garbage_collect() < 0)
+        TEST_ERROR;
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs != 0 || nbytes != 0)
+        TEST_ERROR;
 
-    /* Check that the values read are the same as the values written
-     * Assume size of long long = size of double
-     */
-    for (i = 0; i < (size_t)size[0]; i++) {
-        for (j = 0; j < (size_t)size[1]; j++) {
-            if (HDisnan(orig_data[i][j]))
-                continue; /* skip if value is NaN */
-            if (!H5_DBL_ABS_EQUAL(new_data[i][j], orig_data[i][j])) {
-                H5_FAILED();
-                HDprintf("    Read different values than written.\n");
-                HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
-                goto error;
-            }
-        }
-    }
+    /* Write and read a filtered dataset, keeping the chunks out of the
+     * cache so that every chunk goes through the filters */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        TEST_ERROR;
+    if (H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, 0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        TEST_ERROR;
+    dims[0] = chunk_size * 8;
+    if (NULL == (orig = (int *)HDmalloc((size_t)dims[0] * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (data = (int *)HDmalloc((size_t)dims[0] * sizeof(int))))
+        TEST_ERROR;
+    for (u = 0; u < (size_t)dims[0]; u++)
+        orig[u] = (int)HDrandom();
+    if ((space = H5Screate_simple(1, dims, NULL)) < 0)
+        TEST_ERROR;
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR;
+    if (H5Pset_chunk(dc, 1, &chunk_size) < 0)
+        TEST_ERROR;
+    if (H5Pset_shuffle(dc) < 0)
+        TEST_ERROR;
+    if (H5Pset_fletcher32(dc) < 0)
+        TEST_ERROR;
+    if ((dataset = H5Dcreate2(file, DSET_BUF_POOL_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, dc, dapl)) < 0)
+        TEST_ERROR;
+    if (H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+        TEST_ERROR;
+    HDmemset(data, 0, (size_t)dims[0] * sizeof(int));
+    if (H5Dread(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) < 0)
+        TEST_ERROR;
+    if (HDmemcmp(data, orig, (size_t)dims[0] * sizeof(int)) != 0) {
+        H5_FAILED();
+        HDprintf("    Read different values than written\n");
+        goto error;
+    } /* end if */
+    H5Z__buf_pool_info(&nbufs, &nbytes);
+    if (nbufs == 0 || nbytes < chunk_size * sizeof(int))
+        TEST_ERROR;
 
-    /*----------------------------------------------------------------------
-     * Cleanup
-     *----------------------------------------------------------------------
-     */
-    if (H5Tclose(datatype) < 0)
-        FAIL_STACK_ERROR;
+    if (H5Dclose(dataset) < 0)
+        TEST_ERROR;
     if (H5Pclose(dc) < 0)
-        FAIL_STACK_ERROR;
+        TEST_ERROR;
+    if (H5Pclose(dapl) < 0)
+        TEST_ERROR;
     if (H5Sclose(space) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Dclose(dataset) < 0)
-        FAIL_STACK_ERROR;
+        TEST_ERROR;
+    HDfree(orig);
+    HDfree(data);
 
     PASSED();
 
     return SUCCEED;
 
 error:
+    for (u = 0; u < nbig; u++)
+        H5Z_buf_free(big[u], 0);
+    H5Z_buf_free(buf1, 0);
+    H5Z_buf_free(buf2, 0);
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dataset);
+        H5Pclose(dc);
+        H5Pclose(dapl);
+        H5Sclose(space);
+    }
+    H5E_END_TRY;
+    HDfree(orig);
+    HDfree(data);
+
     return FAIL;
-} /* end test_nbit_double() */
+} /* end test_filter_buffer_pool() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_array
+ * Function:  test_bitshuffle_kernels
  *
- * Purpose:     Tests the simple version array datatype for nbit filter
+ * Purpose:   Tests the bit shuffle kernels that the CPU supports against
+ *            a bit-by-bit reference, for element sizes of one byte and
+ *            more, and for numbers of elements that do and don't fill
+ *            whole groups of 8 and whole vectors.
  *
- * Return:      Success:        0
- *              Failure:        -1
+ * Return:    Success:    0
+ *            Failure:    -1
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_array(hid_t file)
+test_bitshuffle_kernels(void)
 {
-    hid_t         dataset, base_datatype, array_datatype, space, dc;
-    hid_t         mem_base_datatype, mem_array_datatype;
-    const hsize_t size[2]       = {2, 5};
-    const hsize_t adims[2]      = {3, 2};
-    const hsize_t chunk_size[2] = {2, 5};
-    unsigned int  orig_data[2][5][3][2];
-    unsigned int  new_data[2][5][3][2];
-    size_t        precision, offset;
-    double        power;
-    size_t        i, j, m, n;
+    const unsigned    elmt_sizes[] = {1, 2, 3, 4, 8, 16};
+    const size_t      nelmts[]     = {8, 9, 16, 64, 72, 127, 128, 520, 1000, 4099};
+    const size_t      max_nbytes   = 16 * 4099;
+    unsigned char    *orig         = NULL;
+    unsigned char    *expected     = NULL;
+    unsigned char    *shuffled     = NULL;
+    unsigned char    *unshuffled   = NULL;
+    H5Z_shuffle_isa_t best_isa;
+    int               isa;
+    size_t            u, v, w;
 
-    TESTING("    nbit array (setup)");
+    TESTING("bit shuffle filter kernels");
 
-    /* Define dataset array datatype's base datatype and set precision, offset */
-    base_datatype = H5Tcopy(H5T_NATIVE_UINT);
-    precision     = 22;
-    if (H5Tset_precision(base_datatype, precision) < 0)
-        goto error;
-    offset = 7;
-    if (H5Tset_offset(base_datatype, offset) < 0)
-        goto error;
+    if (NULL == (orig = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
+    if (NULL == (expected = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
+    if (NULL == (shuffled = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
+    if (NULL == (unshuffled = (unsigned char *)HDmalloc(max_nbytes)))
+        TEST_ERROR;
 
-    /* Copy to memory array datatype's base datatype before setting order */
-    mem_base_datatype = H5Tcopy(base_datatype);
+    for (u = 0; u < max_nbytes; u++)
+        orig[u] = (unsigned char)HDrandom();
 
-    /* Set order of dataset array datatype's base datatype */
-    if (H5Tset_order(base_datatype, H5T_ORDER_BE) < 0)
+    best_isa = H5Z__shuffle_best_isa();
+
+    for (u = 0; u < NELMTS(elmt_sizes); u++)
+        for (v = 0; v < NELMTS(nelmts); v++) {
+            size_t size   = elmt_sizes[u];
+            size_t nbytes = size * nelmts[v];
+            size_t ngroup = nelmts[v] / 8; /* Bytes in each bit plane */
+
+            /* Bit K of byte B of element E goes to bit E%8 of byte E/8 of
+             * bit plane 8*B+K; the elements after the last group of 8 are
+             * copied */
+            HDmemset(expected, 0, nbytes);
+            for (w = 0; w < ngroup * 8 * size; w++) {
+                size_t   elmt = w / size;
+                size_t   byte = w % size;
+                unsigned k;
+
+                for (k = 0; k < 8; k++)
+                    if (orig[w] & (1 << k))
+                        expected[((8 * byte + k) * ngroup) + (elmt / 8)] |= (unsigned char)(1 << (elmt % 8));
+            }
+            HDmemcpy(expected + (ngroup * 8 * size), orig + (ngroup * 8 * size),
+                     nbytes - (ngroup * 8 * size));
+
+            for (isa = H5Z_SHUFFLE_ISA_SCALAR; isa <= (int)best_isa; isa++) {
+                HDmemset(shuffled, 0, nbytes);
+                HDmemset(unshuffled, 0, nbytes);
+
+                if (H5Z__bitshuffle_bytes((H5Z_shuffle_isa_t)isa, FALSE, elmt_sizes[u], nelmts[v], orig,
+                                          shuffled) < 0)
+                    TEST_ERROR;
+                if (HDmemcmp(shuffled, expected, nbytes) != 0) {
+                    H5_FAILED();
+                    HDprintf("    Wrong bit shuffle, instruction set %d, %u-byte elements, %zu elements\n",
+                             isa, elmt_sizes[u], nelmts[v]);
+                    goto error;
+                }
+
+                if (H5Z__bitshuffle_bytes((H5Z_shuffle_isa_t)isa, TRUE, elmt_sizes[u], nelmts[v], shuffled,
+                                          unshuffled) < 0)
+                    TEST_ERROR;
+                if (HDmemcmp(unshuffled, orig, nbytes) != 0) {
+                    H5_FAILED();
+                    HDprintf("    Wrong bit unshuffle, instruction set %d, %u-byte elements, %zu elements\n",
+                             isa, elmt_sizes[u], nelmts[v]);
+                    goto error;
+                }
+            }
+        }
+
+    HDfree(orig);
+    HDfree(expected);
+    HDfree(shuffled);
+    HDfree(unshuffled);
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    HDfree(orig);
+    HDfree(expected);
+    HDfree(shuffled);
+    HDfree(unshuffled);
+
+    return FAIL;
+} /* end test_bitshuffle_kernels() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_int
+ *
+ * Purpose:     Tests the integer datatype for nbit filter
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_int(hid_t file)
+{
+    hid_t        dataset, datatype, mem_datatype, space, dc;
+    hsize_t      size[2]       = {2, 5};
+    hsize_t      chunk_size[2] = {2, 5};
+    int          orig_data[2][5];
+    int          new_data[2][5];
+    unsigned int mask;
+    size_t       precision, offset;
+    double       power;
+    size_t       i, j;
+
+    HDputs("Testing nbit filter");
+    TESTING("    nbit int (setup)");
+
+    /* Define dataset datatype (integer), and set precision, offset */
+    datatype  = H5Tcopy(H5T_NATIVE_INT);
+    precision = 17; /* precision includes sign bit */
+    if (H5Tset_precision(datatype, precision) < 0)
+        goto error;
+    offset = 4;
+    if (H5Tset_offset(datatype, offset) < 0)
         goto error;
 
-    /* Create dataset array datatype */
-    array_datatype = H5Tarray_create2(base_datatype, 2, adims);
+    /* Copy to memory datatype before setting order */
+    mem_datatype = H5Tcopy(datatype);
 
-    /* Create memory array datatype */
-    mem_array_datatype = H5Tarray_create2(mem_base_datatype, 2, adims);
+    /* Set order of dataset datatype */
+    if (H5Tset_order(datatype, H5T_ORDER_BE) < 0)
+        goto error;
 
     /* Create the data space */
     if ((space = H5Screate_simple(2, size, NULL)) < 0)
@@ -3604,19 +3940,20 @@ test_nbit_array(hid_t file)
         goto error;
 
     /* Create the dataset */
-    if ((dataset =
-             H5Dcreate2(file, DSET_NBIT_ARRAY_NAME, array_datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+    if ((dataset = H5Dcreate2(file, DSET_NBIT_INT_NAME, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
         goto error;
 
-    /* Initialize data, assuming size of long long >= size of unsigned int */
+    /* Initialize data, assuming size of long long >= size of int */
     for (i = 0; i < (size_t)size[0]; i++)
-        for (j = 0; j < (size_t)size[1]; j++)
-            for (m = 0; m < (size_t)adims[0]; m++)
-                for (n = 0; n < (size_t)adims[1]; n++) {
-                    power = HDpow(2.0, (double)precision);
-                    orig_data[i][j][m][n] =
-                        (unsigned int)(((long long)HDrandom() % (long long)power) << offset);
-                } /* end for */
+        for (j = 0; j < (size_t)size[1]; j++) {
+            power           = HDpow(2.0, (double)(precision - 1));
+            orig_data[i][j] = (int)(((long long)HDrandom() % (long long)power) << offset);
+
+            /* even-numbered values are negative */
+            if ((i * size[1] + j + 1) % 2 == 0)
+                orig_data[i][j] = -orig_data[i][j];
+        }
+
     PASSED();
 
     /*----------------------------------------------------------------------
@@ -3624,49 +3961,44 @@ test_nbit_array(hid_t file)
      * to it.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit array (write)");
+    TESTING("    nbit int (write)");
 
-    if (H5Dwrite(dataset, mem_array_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+    if (H5Dwrite(dataset, mem_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
         goto error;
-
     PASSED();
 
     /*----------------------------------------------------------------------
      * STEP 2: Try to read the data we just wrote.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit array (read)");
+    TESTING("    nbit int (read)");
 
     /* Read the dataset back */
-    if (H5Dread(dataset, mem_array_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+    if (H5Dread(dataset, mem_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
         goto error;
 
     /* Check that the values read are the same as the values written
+     * Use mask for checking the significant bits, ignoring the padding bits
      */
-    for (i = 0; i < (size_t)size[0]; i++)
-        for (j = 0; j < (size_t)size[1]; j++)
-            for (m = 0; m < (size_t)adims[0]; m++)
-                for (n = 0; n < (size_t)adims[1]; n++) {
-                    if (new_data[i][j][m][n] != orig_data[i][j][m][n]) {
-                        H5_FAILED();
-                        HDprintf("    Read different values than written.\n");
-                        HDprintf("    At index %lu,%lu,%lu,%lu\n", (unsigned long)i, (unsigned long)j,
-                                 (unsigned long)m, (unsigned long)n);
-                        goto error;
-                    }
-                }
+    mask = ~((unsigned)~0 << (precision + offset)) & ((unsigned)~0 << offset);
+    for (i = 0; i < (size_t)size[0]; i++) {
+        for (j = 0; j < (size_t)size[1]; j++) {
+            if (((unsigned)new_data[i][j] & mask) != ((unsigned)orig_data[i][j] & mask)) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
+                goto error;
+            }
+        }
+    }
 
     /*----------------------------------------------------------------------
      * Cleanup
      *----------------------------------------------------------------------
      */
-    if (H5Tclose(array_datatype) < 0)
-        goto error;
-    if (H5Tclose(base_datatype) < 0)
-        goto error;
-    if (H5Tclose(mem_array_datatype) < 0)
+    if (H5Tclose(datatype) < 0)
         goto error;
-    if (H5Tclose(mem_base_datatype) < 0)
+    if (H5Tclose(mem_datatype) < 0)
         goto error;
     if (H5Pclose(dc) < 0)
         goto error;
@@ -3681,112 +4013,168 @@ test_nbit_array(hid_t file)
 
 error:
     return FAIL;
-} /* end test_nbit_array() */
+} /* end test_nbit_int() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_compound
+ * Function:    test_nbit_float
  *
- * Purpose:     Tests a simple version of compound datatype of nbit filter
+ * Purpose:     Tests the float datatype of nbit filter
  *
  * Return:      Success:        0
- *
  *              Failure:        -1
- *
- * Programmer:  Xiaowen Wu
- *              Tuesday, Jan. 18th, 2005
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_compound(hid_t file)
+test_nbit_float(hid_t file)
 {
-    typedef struct { /* Struct with atomic fields */
-        int   i;
-        char  c;
-        short s;
-        float f;
-    } atomic;
-    hid_t         i_tid, c_tid, s_tid, f_tid;
-    hid_t         cmpd_tid;     /* atomic compound datatype */
-    hid_t         mem_cmpd_tid; /* memory atomic compound datatype */
-    size_t        precision[3] = {15, 7, 10};
-    size_t        offset[3]    = {9, 0, 3};
-    hid_t         dataset, space, dc;
-    const hsize_t size[2]         = {2, 5};
-    const hsize_t chunk_size[2]   = {2, 5};
-    const float   float_val[2][5] = {{188384.0F, 19.103516F, -1.0831790e9F, -84.242188F, 5.2045898F},
-                                   {-49140.0F, 2350.25F, -3.2110596e-1F, 6.4998865e-5F, -0.0F}};
-    atomic        orig_data[2][5];
-    atomic        new_data[2][5];
-    unsigned int  i_mask, s_mask, c_mask;
-    double        power;
-    size_t        i, j;
+    hid_t         dataset, datatype, space, dc;
+    const hsize_t size[2]       = {2, 5};
+    const hsize_t chunk_size[2] = {2, 5};
+    /* orig_data[] are initialized to be within the range that can be represented by
+     * dataset datatype (no precision loss during datatype conversion)
+     */
+    float  orig_data[2][5] = {{188384.0F, 19.103516F, -1.0831790e9F, -84.242188F, 5.2045898F},
+                             {-49140.0F, 2350.25F, -3.2110596e-1F, 6.4998865e-5F, -0.0F}};
+    float  new_data[2][5];
+    size_t precision, offset;
+    size_t i, j;
 
-    TESTING("    nbit compound (setup)");
+    TESTING("    nbit float (setup)");
 
-    /* Define datatypes of members of compound datatype */
-    if ((i_tid = H5Tcopy(H5T_NATIVE_INT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((c_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0)
-        FAIL_STACK_ERROR;
-    if ((s_tid = H5Tcopy(H5T_NATIVE_SHORT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((f_tid = H5Tcopy(H5T_IEEE_F32BE)) < 0)
+    /* Define user-defined single-precision floating-point type for dataset */
+    datatype = H5Tcopy(H5T_IEEE_F32BE);
+    if (H5Tset_fields(datatype, (size_t)26, (size_t)20, (size_t)6, (size_t)7, (size_t)13) < 0)
         FAIL_STACK_ERROR;
-
-    /* Set precision and offset etc. */
-    if (H5Tset_precision(i_tid, precision[0]) < 0)
+    offset = 7;
+    if (H5Tset_offset(datatype, offset) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tset_offset(i_tid, offset[0]) < 0)
+    precision = 20;
+    if (H5Tset_precision(datatype, precision) < 0)
         FAIL_STACK_ERROR;
-
-    if (H5Tset_precision(c_tid, precision[1]) < 0)
+    if (H5Tset_size(datatype, (size_t)4) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tset_offset(c_tid, offset[1]) < 0)
+    if (H5Tset_ebias(datatype, (size_t)31) < 0)
         FAIL_STACK_ERROR;
 
-    if (H5Tset_precision(s_tid, precision[2]) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_offset(s_tid, offset[2]) < 0)
+    /* Create the data space */
+    if ((space = H5Screate_simple(2, size, NULL)) < 0)
         FAIL_STACK_ERROR;
 
-    if (H5Tset_fields(f_tid, (size_t)26, (size_t)20, (size_t)6, (size_t)7, (size_t)13) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_offset(f_tid, (size_t)7) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_precision(f_tid, (size_t)20) < 0)
+    /* Use nbit filter  */
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tset_size(f_tid, (size_t)4) < 0)
+    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tset_ebias(f_tid, (size_t)31) < 0)
+    if (H5Pset_nbit(dc) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create a memory compound datatype before setting the order */
-    if ((mem_cmpd_tid = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid, "i", HOFFSET(atomic, i), i_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid, "c", HOFFSET(atomic, c), c_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid, "s", HOFFSET(atomic, s), s_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid, "f", HOFFSET(atomic, f), H5T_NATIVE_FLOAT) < 0)
+    /* Create the dataset */
+    if ((dataset = H5Dcreate2(file, DSET_NBIT_FLOAT_NAME, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
+    PASSED();
 
-    /* Create a dataset compound datatype and insert some atomic types */
-    if ((cmpd_tid = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid, "i", HOFFSET(atomic, i), i_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid, "c", HOFFSET(atomic, c), c_tid) < 0)
+    /*----------------------------------------------------------------------
+     * STEP 1: Test nbit by setting up a chunked dataset and writing
+     * to it.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit float (write)");
+
+    if (H5Dwrite(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid, "s", HOFFSET(atomic, s), s_tid) < 0)
+
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 2: Try to read the data we just wrote.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit float (read)");
+
+    /* Read the dataset back */
+    if (H5Dread(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid, "f", HOFFSET(atomic, f), f_tid) < 0)
+
+    /* Check that the values read are the same as the values written
+     * Assume size of int = size of float
+     */
+    for (i = 0; i < (size_t)size[0]; i++) {
+        for (j = 0; j < (size_t)size[1]; j++) {
+            if (HDisnan(orig_data[i][j]))
+                continue; /* skip if value is NaN */
+            if (!H5_FLT_ABS_EQUAL(new_data[i][j], orig_data[i][j])) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
+                goto error;
+            }
+        }
+    }
+
+    /*----------------------------------------------------------------------
+     * Cleanup
+     *----------------------------------------------------------------------
+     */
+    if (H5Tclose(datatype) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dc) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(space) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(dataset) < 0)
         FAIL_STACK_ERROR;
 
-    /* Set order of dataset compound datatype */
-    if (H5Tset_order(cmpd_tid, H5T_ORDER_BE) < 0)
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    return FAIL;
+} /* end test_nbit_float() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_double
+ *
+ * Purpose:     Tests the double datatype of nbit filter
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_double(hid_t file)
+{
+    /* assume unsigned int and float has the same number of bytes */
+    hid_t         dataset, datatype, space, dc;
+    const hsize_t size[2]       = {2, 5};
+    const hsize_t chunk_size[2] = {2, 5};
+    /* orig_data[] are initialized to be within the range that can be represented by
+     * dataset datatype (no precision loss during datatype conversion)
+     */
+    double orig_data[2][5] = {{(double)1.6081706885101836e+60L, -255.32099170994480,
+                               (double)1.2677579992621376e-61L, 64568.289448797700,
+                               (double)-1.0619721778839084e-75L},
+                              {(double)2.1499497833454840e+56L, 6.6562295504670740e-3, -1.5747263393432150,
+                               1.0711093225222612, -9.8971679387636870e-1}};
+    double new_data[2][5];
+    size_t precision, offset;
+    size_t i, j;
+
+    TESTING("    nbit double (setup)");
+
+    /* Define user-defined doule-precision floating-point type for dataset */
+    datatype = H5Tcopy(H5T_IEEE_F64BE);
+    if (H5Tset_fields(datatype, (size_t)55, (size_t)46, (size_t)9, (size_t)5, (size_t)41) < 0)
+        FAIL_STACK_ERROR;
+    offset = 5;
+    if (H5Tset_offset(datatype, offset) < 0)
+        FAIL_STACK_ERROR;
+    precision = 51;
+    if (H5Tset_precision(datatype, precision) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_size(datatype, (size_t)8) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_ebias(datatype, (size_t)255) < 0)
         FAIL_STACK_ERROR;
 
     /* Create the data space */
@@ -3802,28 +4190,10 @@ test_nbit_compound(hid_t file)
         FAIL_STACK_ERROR;
 
     /* Create the dataset */
-    if ((dataset = H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME, cmpd_tid, space, H5P_DEFAULT, dc, H5P_DEFAULT)) <
+    if ((dataset = H5Dcreate2(file, DSET_NBIT_DOUBLE_NAME, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) <
         0)
         FAIL_STACK_ERROR;
 
-    /* Initialize data, assuming size of long long >= size of member datatypes */
-    for (i = 0; i < (size_t)size[0]; i++)
-        for (j = 0; j < (size_t)size[1]; j++) {
-            power             = HDpow(2.0, (double)(precision[0] - 1));
-            orig_data[i][j].i = (int)(((long long)HDrandom() % (long long)power) << offset[0]);
-            power             = HDpow(2.0, (double)(precision[1] - 1));
-            orig_data[i][j].c = (char)(((long long)HDrandom() % (long long)power) << offset[1]);
-            power             = HDpow(2.0, (double)(precision[2] - 1));
-            orig_data[i][j].s = (short)(((long long)HDrandom() % (long long)power) << offset[2]);
-            orig_data[i][j].f = float_val[i][j];
-
-            /* some even-numbered integer values are negative */
-            if ((i * size[1] + j + 1) % 2 == 0) {
-                orig_data[i][j].i = -orig_data[i][j].i;
-                orig_data[i][j].s = (short)-orig_data[i][j].s;
-            }
-        }
-
     PASSED();
 
     /*----------------------------------------------------------------------
@@ -3831,9 +4201,9 @@ test_nbit_compound(hid_t file)
      * to it.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit compound (write)");
+    TESTING("    nbit double (write)");
 
-    if (H5Dwrite(dataset, mem_cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+    if (H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
         FAIL_STACK_ERROR;
     PASSED();
 
@@ -3841,24 +4211,20 @@ test_nbit_compound(hid_t file)
      * STEP 2: Try to read the data we just wrote.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit compound (read)");
+    TESTING("    nbit double (read)");
 
     /* Read the dataset back */
-    if (H5Dread(dataset, mem_cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+    if (H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
         FAIL_STACK_ERROR;
 
     /* Check that the values read are the same as the values written
-     * Use mask for checking the significant bits, ignoring the padding bits
+     * Assume size of long long = size of double
      */
-    i_mask = ~((unsigned)~0 << (precision[0] + offset[0])) & ((unsigned)~0 << offset[0]);
-    c_mask = ~((unsigned)~0 << (precision[1] + offset[1])) & ((unsigned)~0 << offset[1]);
-    s_mask = ~((unsigned)~0 << (precision[2] + offset[2])) & ((unsigned)~0 << offset[2]);
-    for (i = 0; i < size[0]; i++) {
-        for (j = 0; j < size[1]; j++) {
-            if (((unsigned)new_data[i][j].i & i_mask) != ((unsigned)orig_data[i][j].i & i_mask) ||
-                ((unsigned)new_data[i][j].c & c_mask) != ((unsigned)orig_data[i][j].c & c_mask) ||
-                ((unsigned)new_data[i][j].s & s_mask) != ((unsigned)orig_data[i][j].s & s_mask) ||
-                (!HDisnan(orig_data[i][j].f) && !H5_FLT_ABS_EQUAL(new_data[i][j].f, orig_data[i][j].f))) {
+    for (i = 0; i < (size_t)size[0]; i++) {
+        for (j = 0; j < (size_t)size[1]; j++) {
+            if (HDisnan(orig_data[i][j]))
+                continue; /* skip if value is NaN */
+            if (!H5_DBL_ABS_EQUAL(new_data[i][j], orig_data[i][j])) {
                 H5_FAILED();
                 HDprintf("    Read different values than written.\n");
                 HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
@@ -3871,17 +4237,7 @@ test_nbit_compound(hid_t file)
      * Cleanup
      *----------------------------------------------------------------------
      */
-    if (H5Tclose(i_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(c_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(s_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(f_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(cmpd_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(mem_cmpd_tid) < 0)
+    if (H5Tclose(datatype) < 0)
         FAIL_STACK_ERROR;
     if (H5Pclose(dc) < 0)
         FAIL_STACK_ERROR;
@@ -3896,179 +4252,251 @@ test_nbit_compound(hid_t file)
 
 error:
     return FAIL;
-} /* end test_nbit_compound() */
+} /* end test_nbit_double() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_compound_2
+ * Function:    test_nbit_array
  *
- * Purpose:     Tests a complex version of compound datatype of nbit filter
+ * Purpose:     Tests the simple version array datatype for nbit filter
  *
  * Return:      Success:        0
- *
  *              Failure:        -1
- *
- * Programmer:  Xiaowen Wu
- *              Tuesday, Jan. 18th, 2005
- *
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_compound_2(hid_t file)
+test_nbit_array(hid_t file)
 {
-    typedef struct { /* Struct with atomic fields */
-        int   i;
-        char  c;
-        short s;
-        float f;
-    } atomic;
-
-    typedef struct { /* Struct with complex fields */
-        atomic       a;
-        unsigned int v;
-        char         b[2][2];
-        atomic       d[2][2];
-    } complex;
-
-    hid_t         i_tid, c_tid, s_tid, f_tid, v_tid;
-    hid_t         cmpd_tid1;           /* atomic compound datatype */
-    hid_t         cmpd_tid2;           /* complex compound datatype */
-    hid_t         mem_cmpd_tid1;       /* memory atomic compound datatype */
-    hid_t         mem_cmpd_tid2;       /* memory complex compound datatype */
-    hid_t         base_tid;            /* simple array datatype's base datatype */
-    hid_t         array_tid;           /* simple array datatype */
-    hid_t         array_cmplx_tid;     /* complex array datatype */
-    hid_t         mem_array_cmplx_tid; /* memory complex array datatype */
-    const hsize_t array_dims[2] = {2, 2};
-    size_t        precision[5]  = {31, 8, 10, 23, 8};
-    size_t        offset[5]     = {1, 0, 3, 5, 0};
-    hid_t         dataset, space, dc;
-    const hsize_t size[2]         = {2, 5};
-    const hsize_t chunk_size[2]   = {2, 5};
-    const float   float_val[2][5] = {{188384.0F, 19.103516F, -1.0831790e9F, -84.242188F, 5.2045898F},
-                                   {-49140.0F, 2350.25F, -3.2110596e-1F, 6.4998865e-5F, -0.0F}};
-    complex       orig_data[2][5];
-    complex       new_data[2][5];
-    unsigned int  i_mask, s_mask, c_mask, b_mask;
+    hid_t         dataset, base_datatype, array_datatype, space, dc;
+    hid_t         mem_base_datatype, mem_array_datatype;
+    const hsize_t size[2]       = {2, 5};
+    const hsize_t adims[2]      = {3, 2};
+    const hsize_t chunk_size[2] = {2, 5};
+    unsigned int  orig_data[2][5][3][2];
+    unsigned int  new_data[2][5][3][2];
+    size_t        precision, offset;
     double        power;
-    size_t        i, j, m, n, b_failed, d_failed;
+    size_t        i, j, m, n;
 
-    TESTING("    nbit compound complex (setup)");
+    TESTING("    nbit array (setup)");
 
-    /* Define datatypes of members of compound datatype */
-    if ((i_tid = H5Tcopy(H5T_NATIVE_INT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((c_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0)
-        FAIL_STACK_ERROR;
-    if ((s_tid = H5Tcopy(H5T_NATIVE_SHORT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((v_tid = H5Tcopy(H5T_NATIVE_UINT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((f_tid = H5Tcopy(H5T_IEEE_F32BE)) < 0)
-        FAIL_STACK_ERROR;
+    /* Define dataset array datatype's base datatype and set precision, offset */
+    base_datatype = H5Tcopy(H5T_NATIVE_UINT);
+    precision     = 22;
+    if (H5Tset_precision(base_datatype, precision) < 0)
+        goto error;
+    offset = 7;
+    if (H5Tset_offset(base_datatype, offset) < 0)
+        goto error;
 
-    /* Set precision and offset etc. of atomic compound datatype members */
-    if (H5Tset_precision(i_tid, precision[0]) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_offset(i_tid, offset[0]) < 0)
-        FAIL_STACK_ERROR;
+    /* Copy to memory array datatype's base datatype before setting order */
+    mem_base_datatype = H5Tcopy(base_datatype);
 
-    if (H5Tset_precision(c_tid, precision[1]) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_offset(c_tid, offset[1]) < 0)
-        FAIL_STACK_ERROR;
+    /* Set order of dataset array datatype's base datatype */
+    if (H5Tset_order(base_datatype, H5T_ORDER_BE) < 0)
+        goto error;
 
-    if (H5Tset_precision(s_tid, precision[2]) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_offset(s_tid, offset[2]) < 0)
-        FAIL_STACK_ERROR;
+    /* Create dataset array datatype */
+    array_datatype = H5Tarray_create2(base_datatype, 2, adims);
 
-    if (H5Tset_fields(f_tid, (size_t)26, (size_t)20, (size_t)6, (size_t)7, (size_t)13) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_offset(f_tid, (size_t)7) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_precision(f_tid, (size_t)20) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_size(f_tid, (size_t)4) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_ebias(f_tid, (size_t)31) < 0)
-        FAIL_STACK_ERROR;
+    /* Create memory array datatype */
+    mem_array_datatype = H5Tarray_create2(mem_base_datatype, 2, adims);
 
-    /* Create a memory atomic compound datatype before setting the order */
-    if ((mem_cmpd_tid1 = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid1, "i", HOFFSET(atomic, i), i_tid) < 0)
+    /* Create the data space */
+    if ((space = H5Screate_simple(2, size, NULL)) < 0)
+        goto error;
+
+    /* Use nbit filter  */
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
+        goto error;
+    if (H5Pset_nbit(dc) < 0)
+        goto error;
+
+    /* Create the dataset */
+    if ((dataset =
+             H5Dcreate2(file, DSET_NBIT_ARRAY_NAME, array_datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+        goto error;
+
+    /* Initialize data, assuming size of long long >= size of unsigned int */
+    for (i = 0; i < (size_t)size[0]; i++)
+        for (j = 0; j < (size_t)size[1]; j++)
+            for (m = 0; m < (size_t)adims[0]; m++)
+                for (n = 0; n < (size_t)adims[1]; n++) {
+                    power = HDpow(2.0, (double)precision);
+                    orig_data[i][j][m][n] =
+                        (unsigned int)(((long long)HDrandom() % (long long)power) << offset);
+                } /* end for */
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 1: Test nbit by setting up a chunked dataset and writing
+     * to it.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit array (write)");
+
+    if (H5Dwrite(dataset, mem_array_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+        goto error;
+
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 2: Try to read the data we just wrote.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit array (read)");
+
+    /* Read the dataset back */
+    if (H5Dread(dataset, mem_array_datatype, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+        goto error;
+
+    /* Check that the values read are the same as the values written
+     */
+    for (i = 0; i < (size_t)size[0]; i++)
+        for (j = 0; j < (size_t)size[1]; j++)
+            for (m = 0; m < (size_t)adims[0]; m++)
+                for (n = 0; n < (size_t)adims[1]; n++) {
+                    if (new_data[i][j][m][n] != orig_data[i][j][m][n]) {
+                        H5_FAILED();
+                        HDprintf("    Read different values than written.\n");
+                        HDprintf("    At index %lu,%lu,%lu,%lu\n", (unsigned long)i, (unsigned long)j,
+                                 (unsigned long)m, (unsigned long)n);
+                        goto error;
+                    }
+                }
+
+    /*----------------------------------------------------------------------
+     * Cleanup
+     *----------------------------------------------------------------------
+     */
+    if (H5Tclose(array_datatype) < 0)
+        goto error;
+    if (H5Tclose(base_datatype) < 0)
+        goto error;
+    if (H5Tclose(mem_array_datatype) < 0)
+        goto error;
+    if (H5Tclose(mem_base_datatype) < 0)
+        goto error;
+    if (H5Pclose(dc) < 0)
+        goto error;
+    if (H5Sclose(space) < 0)
+        goto error;
+    if (H5Dclose(dataset) < 0)
+        goto error;
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    return FAIL;
+} /* end test_nbit_array() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_compound
+ *
+ * Purpose:     Tests a simple version of compound datatype of nbit filter
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        -1
+ *
+ * Programmer:  Xiaowen Wu
+ *              Tuesday, Jan. 18th, 2005
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_compound(hid_t file)
+{
+    typedef struct { /* Struct with atomic fields */
+        int   i;
+        char  c;
+        short s;
+        float f;
+    } atomic;
+    hid_t         i_tid, c_tid, s_tid, f_tid;
+    hid_t         cmpd_tid;     /* atomic compound datatype */
+    hid_t         mem_cmpd_tid; /* memory atomic compound datatype */
+    size_t        precision[3] = {15, 7, 10};
+    size_t        offset[3]    = {9, 0, 3};
+    hid_t         dataset, space, dc;
+    const hsize_t size[2]         = {2, 5};
+    const hsize_t chunk_size[2]   = {2, 5};
+    const float   float_val[2][5] = {{188384.0F, 19.103516F, -1.0831790e9F, -84.242188F, 5.2045898F},
+                                   {-49140.0F, 2350.25F, -3.2110596e-1F, 6.4998865e-5F, -0.0F}};
+    atomic        orig_data[2][5];
+    atomic        new_data[2][5];
+    unsigned int  i_mask, s_mask, c_mask;
+    double        power;
+    size_t        i, j;
+
+    TESTING("    nbit compound (setup)");
+
+    /* Define datatypes of members of compound datatype */
+    if ((i_tid = H5Tcopy(H5T_NATIVE_INT)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid1, "c", HOFFSET(atomic, c), c_tid) < 0)
+    if ((c_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid1, "s", HOFFSET(atomic, s), s_tid) < 0)
+    if ((s_tid = H5Tcopy(H5T_NATIVE_SHORT)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid1, "f", HOFFSET(atomic, f), H5T_NATIVE_FLOAT) < 0)
+    if ((f_tid = H5Tcopy(H5T_IEEE_F32BE)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create a dataset atomic compound datatype and insert some atomic types */
-    if ((cmpd_tid1 = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid1, "i", HOFFSET(atomic, i), i_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid1, "c", HOFFSET(atomic, c), c_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid1, "s", HOFFSET(atomic, s), s_tid) < 0)
+    /* Set precision and offset etc. */
+    if (H5Tset_precision(i_tid, precision[0]) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid1, "f", HOFFSET(atomic, f), f_tid) < 0)
+    if (H5Tset_offset(i_tid, offset[0]) < 0)
         FAIL_STACK_ERROR;
 
-    /* Set order of dataset compound datatype */
-    if (H5Tset_order(cmpd_tid1, H5T_ORDER_BE) < 0)
+    if (H5Tset_precision(c_tid, precision[1]) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(c_tid, offset[1]) < 0)
         FAIL_STACK_ERROR;
 
-    /* Set precision and offset of the other data member */
-    if (H5Tset_precision(v_tid, precision[3]) < 0)
+    if (H5Tset_precision(s_tid, precision[2]) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tset_offset(v_tid, offset[3]) < 0)
+    if (H5Tset_offset(s_tid, offset[2]) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create the simple array datatype */
-    if ((base_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tset_precision(base_tid, precision[4]) < 0)
+    if (H5Tset_fields(f_tid, (size_t)26, (size_t)20, (size_t)6, (size_t)7, (size_t)13) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tset_offset(base_tid, offset[4]) < 0)
+    if (H5Tset_offset(f_tid, (size_t)7) < 0)
         FAIL_STACK_ERROR;
-    if ((array_tid = H5Tarray_create2(base_tid, 2, array_dims)) < 0)
+    if (H5Tset_precision(f_tid, (size_t)20) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create the complex memory and dataset array datatype */
-    if ((array_cmplx_tid = H5Tarray_create2(cmpd_tid1, 2, array_dims)) < 0)
+    if (H5Tset_size(f_tid, (size_t)4) < 0)
         FAIL_STACK_ERROR;
-    if ((mem_array_cmplx_tid = H5Tarray_create2(mem_cmpd_tid1, 2, array_dims)) < 0)
+    if (H5Tset_ebias(f_tid, (size_t)31) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create a memory complex compound datatype before setting the order */
-    if ((mem_cmpd_tid2 = H5Tcreate(H5T_COMPOUND, sizeof(complex))) < 0)
+    /* Create a memory compound datatype before setting the order */
+    if ((mem_cmpd_tid = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid2, "a", HOFFSET(complex, a), mem_cmpd_tid1) < 0)
+    if (H5Tinsert(mem_cmpd_tid, "i", HOFFSET(atomic, i), i_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid2, "v", HOFFSET(complex, v), v_tid) < 0)
+    if (H5Tinsert(mem_cmpd_tid, "c", HOFFSET(atomic, c), c_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid2, "b", HOFFSET(complex, b), array_tid) < 0)
+    if (H5Tinsert(mem_cmpd_tid, "s", HOFFSET(atomic, s), s_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(mem_cmpd_tid2, "d", HOFFSET(complex, d), mem_array_cmplx_tid) < 0)
+    if (H5Tinsert(mem_cmpd_tid, "f", HOFFSET(atomic, f), H5T_NATIVE_FLOAT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Set order of dataset other complex compound member datatype */
-    if (H5Tset_order(v_tid, H5T_ORDER_BE) < 0)
+    /* Create a dataset compound datatype and insert some atomic types */
+    if ((cmpd_tid = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create a dataset complex compound datatype and insert members */
-    if ((cmpd_tid2 = H5Tcreate(H5T_COMPOUND, sizeof(complex))) < 0)
+    if (H5Tinsert(cmpd_tid, "i", HOFFSET(atomic, i), i_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid2, "a", HOFFSET(complex, a), cmpd_tid1) < 0)
+    if (H5Tinsert(cmpd_tid, "c", HOFFSET(atomic, c), c_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid2, "v", HOFFSET(complex, v), v_tid) < 0)
+    if (H5Tinsert(cmpd_tid, "s", HOFFSET(atomic, s), s_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid2, "b", HOFFSET(complex, b), array_tid) < 0)
+    if (H5Tinsert(cmpd_tid, "f", HOFFSET(atomic, f), f_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tinsert(cmpd_tid2, "d", HOFFSET(complex, d), array_cmplx_tid) < 0)
+
+    /* Set order of dataset compound datatype */
+    if (H5Tset_order(cmpd_tid, H5T_ORDER_BE) < 0)
         FAIL_STACK_ERROR;
 
     /* Create the data space */
@@ -4084,55 +4512,38 @@ test_nbit_compound_2(hid_t file)
         FAIL_STACK_ERROR;
 
     /* Create the dataset */
-    if ((dataset =
-             H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME_2, cmpd_tid2, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+    if ((dataset = H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME, cmpd_tid, space, H5P_DEFAULT, dc, H5P_DEFAULT)) <
+        0)
         FAIL_STACK_ERROR;
 
     /* Initialize data, assuming size of long long >= size of member datatypes */
     for (i = 0; i < (size_t)size[0]; i++)
         for (j = 0; j < (size_t)size[1]; j++) {
-            power               = HDpow(2.0, (double)(precision[0] - 1));
-            orig_data[i][j].a.i = (int)(((long long)HDrandom() % (long long)power) << offset[0]);
-            power               = HDpow(2.0, (double)(precision[1] - 1));
-            orig_data[i][j].a.c = (char)(((long long)HDrandom() % (long long)power) << offset[1]);
-            power               = HDpow(2.0, (double)(precision[2] - 1));
-            orig_data[i][j].a.s = (short)(-(((long long)HDrandom() % (long long)power) << offset[2]));
-            orig_data[i][j].a.f = float_val[i][j];
+            power             = HDpow(2.0, (double)(precision[0] - 1));
+            orig_data[i][j].i = (int)(((long long)HDrandom() % (long long)power) << offset[0]);
+            power             = HDpow(2.0, (double)(precision[1] - 1));
+            orig_data[i][j].c = (char)(((long long)HDrandom() % (long long)power) << offset[1]);
+            power             = HDpow(2.0, (double)(precision[2] - 1));
+            orig_data[i][j].s = (short)(((long long)HDrandom() % (long long)power) << offset[2]);
+            orig_data[i][j].f = float_val[i][j];
 
-            power             = HDpow(2.0, (double)precision[3]);
-            orig_data[i][j].v = (unsigned int)(((long long)HDrandom() % (long long)power) << offset[3]);
+            /* some even-numbered integer values are negative */
+            if ((i * size[1] + j + 1) % 2 == 0) {
+                orig_data[i][j].i = -orig_data[i][j].i;
+                orig_data[i][j].s = (short)-orig_data[i][j].s;
+            }
+        }
 
-            for (m = 0; m < (size_t)array_dims[0]; m++)
-                for (n = 0; n < (size_t)array_dims[1]; n++) {
-                    power                   = HDpow(2.0, (double)(precision[4] - 1));
-                    orig_data[i][j].b[m][n] = (char)(((long long)HDrandom() % (long long)power) << offset[4]);
-                } /* end for */
-
-            for (m = 0; m < (size_t)array_dims[0]; m++)
-                for (n = 0; n < (size_t)array_dims[1]; n++) {
-                    power = HDpow(2.0, (double)(precision[0] - 1));
-                    orig_data[i][j].d[m][n].i =
-                        (int)(-(((long long)HDrandom() % (long long)power) << offset[0]));
-                    power = HDpow(2.0, (double)(precision[1] - 1));
-                    orig_data[i][j].d[m][n].c =
-                        (char)(((long long)HDrandom() % (long long)power) << offset[1]);
-                    power = HDpow(2.0, (double)(precision[2] - 1));
-                    orig_data[i][j].d[m][n].s =
-                        (short)(((long long)HDrandom() % (long long)power) << offset[2]);
-                    orig_data[i][j].d[m][n].f = float_val[i][j];
-                } /* end for */
-        }         /* end for */
-
-    PASSED();
+    PASSED();
 
     /*----------------------------------------------------------------------
      * STEP 1: Test nbit by setting up a chunked dataset and writing
      * to it.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit compound complex (write)");
+    TESTING("    nbit compound (write)");
 
-    if (H5Dwrite(dataset, mem_cmpd_tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+    if (H5Dwrite(dataset, mem_cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
         FAIL_STACK_ERROR;
     PASSED();
 
@@ -4140,63 +4551,24 @@ test_nbit_compound_2(hid_t file)
      * STEP 2: Try to read the data we just wrote.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit compound complex (read)");
+    TESTING("    nbit compound (read)");
 
     /* Read the dataset back */
-    if (H5Dread(dataset, mem_cmpd_tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+    if (H5Dread(dataset, mem_cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
         FAIL_STACK_ERROR;
 
     /* Check that the values read are the same as the values written
      * Use mask for checking the significant bits, ignoring the padding bits
      */
-    /* The original code
-     *   i_mask = ~((unsigned)~0 << (precision[0] + offset[0])) & ((unsigned)~0 << offset[0]);
-     * left shift a 32-bit integer for 32-bit.  The result is undefined by C language.  A user
-     * discovered it using clang compiler with -fcatch-undefined-behavior option (see Issue 7674
-     * in Jira).  So I changed it in a funny way as below to avoid it. SLU - 2011/8/11
-     */
-    if (sizeof(unsigned) > 4)
-        i_mask = ~((unsigned)~0 << (precision[0] + offset[0])) & ((unsigned)~0 << offset[0]);
-    else {
-        i_mask = 0xffffffff;
-        i_mask = i_mask & ((unsigned)~0 << offset[0]);
-    }
+    i_mask = ~((unsigned)~0 << (precision[0] + offset[0])) & ((unsigned)~0 << offset[0]);
     c_mask = ~((unsigned)~0 << (precision[1] + offset[1])) & ((unsigned)~0 << offset[1]);
     s_mask = ~((unsigned)~0 << (precision[2] + offset[2])) & ((unsigned)~0 << offset[2]);
-    b_mask = ~((unsigned)~0 << (precision[4] + offset[4])) & ((unsigned)~0 << offset[4]);
-    for (i = 0; i < (size_t)size[0]; i++) {
-        for (j = 0; j < (size_t)size[1]; j++) {
-            b_failed = 0;
-            d_failed = 0;
-
-            for (m = 0; m < (size_t)array_dims[0]; m++)
-                for (n = 0; n < (size_t)array_dims[1]; n++)
-                    if (((unsigned)new_data[i][j].b[m][n] & b_mask) !=
-                        ((unsigned)orig_data[i][j].b[m][n] & b_mask)) {
-                        b_failed = 1;
-                        goto out;
-                    }
-
-            for (m = 0; m < (size_t)array_dims[0]; m++)
-                for (n = 0; n < (size_t)array_dims[1]; n++)
-                    if (((unsigned)new_data[i][j].d[m][n].i & i_mask) !=
-                            ((unsigned)orig_data[i][j].d[m][n].i & i_mask) ||
-                        ((unsigned)new_data[i][j].d[m][n].c & c_mask) !=
-                            ((unsigned)orig_data[i][j].d[m][n].c & c_mask) ||
-                        ((unsigned)new_data[i][j].d[m][n].s & s_mask) !=
-                            ((unsigned)orig_data[i][j].d[m][n].s & s_mask) ||
-                        (!HDisnan(new_data[i][j].d[m][n].f) &&
-                         !H5_FLT_ABS_EQUAL(new_data[i][j].d[m][n].f, new_data[i][j].d[m][n].f))) {
-                        d_failed = 1;
-                        goto out;
-                    }
-
-out:
-            if (((unsigned)new_data[i][j].a.i & i_mask) != ((unsigned)orig_data[i][j].a.i & i_mask) ||
-                ((unsigned)new_data[i][j].a.c & c_mask) != ((unsigned)orig_data[i][j].a.c & c_mask) ||
-                ((unsigned)new_data[i][j].a.s & s_mask) != ((unsigned)orig_data[i][j].a.s & s_mask) ||
-                (!HDisnan(new_data[i][j].a.f) && !H5_FLT_ABS_EQUAL(new_data[i][j].a.f, new_data[i][j].a.f)) ||
-                new_data[i][j].v != orig_data[i][j].v || b_failed || d_failed) {
+    for (i = 0; i < size[0]; i++) {
+        for (j = 0; j < size[1]; j++) {
+            if (((unsigned)new_data[i][j].i & i_mask) != ((unsigned)orig_data[i][j].i & i_mask) ||
+                ((unsigned)new_data[i][j].c & c_mask) != ((unsigned)orig_data[i][j].c & c_mask) ||
+                ((unsigned)new_data[i][j].s & s_mask) != ((unsigned)orig_data[i][j].s & s_mask) ||
+                (!HDisnan(orig_data[i][j].f) && !H5_FLT_ABS_EQUAL(new_data[i][j].f, orig_data[i][j].f))) {
                 H5_FAILED();
                 HDprintf("    Read different values than written.\n");
                 HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
@@ -4217,23 +4589,9 @@ out:
         FAIL_STACK_ERROR;
     if (H5Tclose(f_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tclose(v_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(cmpd_tid2) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(cmpd_tid1) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(mem_cmpd_tid2) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(mem_cmpd_tid1) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(array_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(base_tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(array_cmplx_tid) < 0)
+    if (H5Tclose(cmpd_tid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tclose(mem_array_cmplx_tid) < 0)
+    if (H5Tclose(mem_cmpd_tid) < 0)
         FAIL_STACK_ERROR;
     if (H5Pclose(dc) < 0)
         FAIL_STACK_ERROR;
@@ -4248,123 +4606,232 @@ out:
 
 error:
     return FAIL;
-} /* end test_nbit_compound_2() */
+} /* end test_nbit_compound() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_compound_3
+ * Function:    test_nbit_compound_2
  *
- * Purpose:     Tests no-op datatypes in compound datatype for nbit filter
+ * Purpose:     Tests a complex version of compound datatype of nbit filter
  *
  * Return:      Success:        0
  *
  *              Failure:        -1
  *
  * Programmer:  Xiaowen Wu
- *              Thursday, Mar. 31th, 2005
+ *              Tuesday, Jan. 18th, 2005
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_nbit_compound_3(hid_t file)
+test_nbit_compound_2(hid_t file)
 {
-    typedef struct {           /* Struct with some no-op type fields */
-        int           i;       /* integer field, NOT a no-op type */
-        char          str[30]; /* fixed-length string, no-op type */
-        char         *vl_str;  /* varible-length string, no-op type */
-        hvl_t         v;       /* VL datatype field, no-op type */
-        hobj_ref_t    r;       /* Object reference field, no-op type */
-        unsigned char o[5];    /* Opaque field, no-op type */
+    typedef struct { /* Struct with atomic fields */
+        int   i;
+        char  c;
+        short s;
+        float f;
     } atomic;
-    hid_t         i_tid, str_tid, vl_str_tid, v_tid, o_tid;
-    hid_t         cmpd_tid; /* atomic compound datatype */
-    hid_t         dataset, space, dc, obj_ref_dataset = -1;
-    const hsize_t size[1]       = {5};
-    const hsize_t chunk_size[1] = {5};
-    atomic        orig_data[5];
-    atomic        new_data[5];
+
+    typedef struct { /* Struct with complex fields */
+        atomic       a;
+        unsigned int v;
+        char         b[2][2];
+        atomic       d[2][2];
+    } complex;
+
+    hid_t         i_tid, c_tid, s_tid, f_tid, v_tid;
+    hid_t         cmpd_tid1;           /* atomic compound datatype */
+    hid_t         cmpd_tid2;           /* complex compound datatype */
+    hid_t         mem_cmpd_tid1;       /* memory atomic compound datatype */
+    hid_t         mem_cmpd_tid2;       /* memory complex compound datatype */
+    hid_t         base_tid;            /* simple array datatype's base datatype */
+    hid_t         array_tid;           /* simple array datatype */
+    hid_t         array_cmplx_tid;     /* complex array datatype */
+    hid_t         mem_array_cmplx_tid; /* memory complex array datatype */
+    const hsize_t array_dims[2] = {2, 2};
+    size_t        precision[5]  = {31, 8, 10, 23, 8};
+    size_t        offset[5]     = {1, 0, 3, 5, 0};
+    hid_t         dataset, space, dc;
+    const hsize_t size[2]         = {2, 5};
+    const hsize_t chunk_size[2]   = {2, 5};
+    const float   float_val[2][5] = {{188384.0F, 19.103516F, -1.0831790e9F, -84.242188F, 5.2045898F},
+                                   {-49140.0F, 2350.25F, -3.2110596e-1F, 6.4998865e-5F, -0.0F}};
+    complex       orig_data[2][5];
+    complex       new_data[2][5];
+    unsigned int  i_mask, s_mask, c_mask, b_mask;
     double        power;
-    size_t        i, k, j;
+    size_t        i, j, m, n, b_failed, d_failed;
 
-    TESTING("    nbit compound with no-op type (setup)");
+    TESTING("    nbit compound complex (setup)");
 
     /* Define datatypes of members of compound datatype */
-    i_tid = H5Tcopy(H5T_NATIVE_INT);
-    if (H5Tset_precision(i_tid, (size_t)17) < 0)
-        goto error;
+    if ((i_tid = H5Tcopy(H5T_NATIVE_INT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((c_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0)
+        FAIL_STACK_ERROR;
+    if ((s_tid = H5Tcopy(H5T_NATIVE_SHORT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((v_tid = H5Tcopy(H5T_NATIVE_UINT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((f_tid = H5Tcopy(H5T_IEEE_F32BE)) < 0)
+        FAIL_STACK_ERROR;
 
-    str_tid = H5Tcopy(H5T_C_S1);
-    if (H5Tset_size(str_tid, (size_t)30) < 0)
-        goto error;
+    /* Set precision and offset etc. of atomic compound datatype members */
+    if (H5Tset_precision(i_tid, precision[0]) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(i_tid, offset[0]) < 0)
+        FAIL_STACK_ERROR;
 
-    vl_str_tid = H5Tcopy(H5T_C_S1);
-    if (H5Tset_size(vl_str_tid, H5T_VARIABLE) < 0)
-        goto error;
+    if (H5Tset_precision(c_tid, precision[1]) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(c_tid, offset[1]) < 0)
+        FAIL_STACK_ERROR;
 
-    if ((v_tid = H5Tvlen_create(H5T_NATIVE_UINT)) < 0)
-        goto error;
+    if (H5Tset_precision(s_tid, precision[2]) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(s_tid, offset[2]) < 0)
+        FAIL_STACK_ERROR;
 
-    if ((o_tid = H5Tcreate(H5T_OPAQUE, (size_t)5)) < 0)
-        goto error;
-    if (H5Tset_tag(o_tid, "testing opaque field") < 0)
-        goto error;
+    if (H5Tset_fields(f_tid, (size_t)26, (size_t)20, (size_t)6, (size_t)7, (size_t)13) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(f_tid, (size_t)7) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_precision(f_tid, (size_t)20) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_size(f_tid, (size_t)4) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_ebias(f_tid, (size_t)31) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Create a dataset compound datatype and insert some atomic types */
-    cmpd_tid = H5Tcreate(H5T_COMPOUND, sizeof(atomic));
-    if (H5Tinsert(cmpd_tid, "i", HOFFSET(atomic, i), i_tid) < 0)
-        goto error;
-    if (H5Tinsert(cmpd_tid, "str", HOFFSET(atomic, str), str_tid) < 0)
-        goto error;
-    if (H5Tinsert(cmpd_tid, "vl_str", HOFFSET(atomic, vl_str), vl_str_tid) < 0)
-        goto error;
-    if (H5Tinsert(cmpd_tid, "v", HOFFSET(atomic, v), v_tid) < 0)
-        goto error;
-    if (H5Tinsert(cmpd_tid, "r", HOFFSET(atomic, r), H5T_STD_REF_OBJ) < 0)
-        goto error;
-    if (H5Tinsert(cmpd_tid, "o", HOFFSET(atomic, o), o_tid) < 0)
-        goto error;
+    /* Create a memory atomic compound datatype before setting the order */
+    if ((mem_cmpd_tid1 = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid1, "i", HOFFSET(atomic, i), i_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid1, "c", HOFFSET(atomic, c), c_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid1, "s", HOFFSET(atomic, s), s_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid1, "f", HOFFSET(atomic, f), H5T_NATIVE_FLOAT) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Create the data space */
-    if ((space = H5Screate_simple(1, size, NULL)) < 0)
-        goto error;
+    /* Create a dataset atomic compound datatype and insert some atomic types */
+    if ((cmpd_tid1 = H5Tcreate(H5T_COMPOUND, sizeof(atomic))) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid1, "i", HOFFSET(atomic, i), i_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid1, "c", HOFFSET(atomic, c), c_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid1, "s", HOFFSET(atomic, s), s_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid1, "f", HOFFSET(atomic, f), f_tid) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Use nbit filter  */
-    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        goto error;
-    if (H5Pset_chunk(dc, 1, chunk_size) < 0)
-        goto error;
-    if (H5Pset_nbit(dc) < 0)
-        goto error;
+    /* Set order of dataset compound datatype */
+    if (H5Tset_order(cmpd_tid1, H5T_ORDER_BE) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Create the dataset */
-    if ((dataset =
-             H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME_3, cmpd_tid, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
-        goto error;
+    /* Set precision and offset of the other data member */
+    if (H5Tset_precision(v_tid, precision[3]) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(v_tid, offset[3]) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Create the dataset object reference points to */
-    if ((obj_ref_dataset = H5Dcreate2(file, "nbit_obj_ref", H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT,
-                                      H5P_DEFAULT)) < 0)
-        goto error;
+    /* Create the simple array datatype */
+    if ((base_tid = H5Tcopy(H5T_NATIVE_CHAR)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_precision(base_tid, precision[4]) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tset_offset(base_tid, offset[4]) < 0)
+        FAIL_STACK_ERROR;
+    if ((array_tid = H5Tarray_create2(base_tid, 2, array_dims)) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Initialize data */
-    for (i = 0; i < (size_t)size[0]; i++) {
-        power = HDpow(2.0, 17.0 - 1.0);
-        HDmemset(&orig_data[i], 0, sizeof(orig_data[i]));
-        orig_data[i].i = (int)(HDrandom() % (long)power);
-        HDstrcpy(orig_data[i].str, "fixed-length C string");
-        orig_data[i].vl_str = HDstrdup("variable-length C string");
+    /* Create the complex memory and dataset array datatype */
+    if ((array_cmplx_tid = H5Tarray_create2(cmpd_tid1, 2, array_dims)) < 0)
+        FAIL_STACK_ERROR;
+    if ((mem_array_cmplx_tid = H5Tarray_create2(mem_cmpd_tid1, 2, array_dims)) < 0)
+        FAIL_STACK_ERROR;
 
-        orig_data[i].v.p   = HDmalloc((size_t)(i + 1) * sizeof(unsigned int));
-        orig_data[i].v.len = (size_t)i + 1;
-        for (k = 0; k < (i + 1); k++)
-            ((unsigned int *)orig_data[i].v.p)[k] = (unsigned int)(i * 100 + k);
+    /* Create a memory complex compound datatype before setting the order */
+    if ((mem_cmpd_tid2 = H5Tcreate(H5T_COMPOUND, sizeof(complex))) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid2, "a", HOFFSET(complex, a), mem_cmpd_tid1) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid2, "v", HOFFSET(complex, v), v_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid2, "b", HOFFSET(complex, b), array_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(mem_cmpd_tid2, "d", HOFFSET(complex, d), mem_array_cmplx_tid) < 0)
+        FAIL_STACK_ERROR;
 
-        /* Create reference to the dataset "nbit_obj_ref" */
-        if (H5Rcreate(&orig_data[i].r, file, "nbit_obj_ref", H5R_OBJECT, (hid_t)-1) < 0)
-            goto error;
+    /* Set order of dataset other complex compound member datatype */
+    if (H5Tset_order(v_tid, H5T_ORDER_BE) < 0)
+        FAIL_STACK_ERROR;
 
-        for (j = 0; j < 5; j++)
-            orig_data[i].o[j] = (unsigned char)(i + j);
-    }
+    /* Create a dataset complex compound datatype and insert members */
+    if ((cmpd_tid2 = H5Tcreate(H5T_COMPOUND, sizeof(complex))) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid2, "a", HOFFSET(complex, a), cmpd_tid1) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid2, "v", HOFFSET(complex, v), v_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid2, "b", HOFFSET(complex, b), array_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tinsert(cmpd_tid2, "d", HOFFSET(complex, d), array_cmplx_tid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create the data space */
+    if ((space = H5Screate_simple(2, size, NULL)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Use nbit filter  */
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dc, 2, chunk_size) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_nbit(dc) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create the dataset */
+    if ((dataset =
+             H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME_2, cmpd_tid2, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Initialize data, assuming size of long long >= size of member datatypes */
+    for (i = 0; i < (size_t)size[0]; i++)
+        for (j = 0; j < (size_t)size[1]; j++) {
+            power               = HDpow(2.0, (double)(precision[0] - 1));
+            orig_data[i][j].a.i = (int)(((long long)HDrandom() % (long long)power) << offset[0]);
+            power               = HDpow(2.0, (double)(precision[1] - 1));
+            orig_data[i][j].a.c = (char)(((long long)HDrandom() % (long long)power) << offset[1]);
+            power               = HDpow(2.0, (double)(precision[2] - 1));
+            orig_data[i][j].a.s = (short)(-(((long long)HDrandom() % (long long)power) << offset[2]));
+            orig_data[i][j].a.f = float_val[i][j];
+
+            power             = HDpow(2.0, (double)precision[3]);
+            orig_data[i][j].v = (unsigned int)(((long long)HDrandom() % (long long)power) << offset[3]);
+
+            for (m = 0; m < (size_t)array_dims[0]; m++)
+                for (n = 0; n < (size_t)array_dims[1]; n++) {
+                    power                   = HDpow(2.0, (double)(precision[4] - 1));
+                    orig_data[i][j].b[m][n] = (char)(((long long)HDrandom() % (long long)power) << offset[4]);
+                } /* end for */
+
+            for (m = 0; m < (size_t)array_dims[0]; m++)
+                for (n = 0; n < (size_t)array_dims[1]; n++) {
+                    power = HDpow(2.0, (double)(precision[0] - 1));
+                    orig_data[i][j].d[m][n].i =
+                        (int)(-(((long long)HDrandom() % (long long)power) << offset[0]));
+                    power = HDpow(2.0, (double)(precision[1] - 1));
+                    orig_data[i][j].d[m][n].c =
+                        (char)(((long long)HDrandom() % (long long)power) << offset[1]);
+                    power = HDpow(2.0, (double)(precision[2] - 1));
+                    orig_data[i][j].d[m][n].s =
+                        (short)(((long long)HDrandom() % (long long)power) << offset[2]);
+                    orig_data[i][j].d[m][n].f = float_val[i][j];
+                } /* end for */
+        }         /* end for */
 
     PASSED();
 
@@ -4373,78 +4840,117 @@ test_nbit_compound_3(hid_t file)
      * to it.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit compound with no-op type (write)");
+    TESTING("    nbit compound complex (write)");
 
-    if (H5Dwrite(dataset, cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
-        goto error;
+    if (H5Dwrite(dataset, mem_cmpd_tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+        FAIL_STACK_ERROR;
     PASSED();
 
     /*----------------------------------------------------------------------
      * STEP 2: Try to read the data we just wrote.
      *----------------------------------------------------------------------
      */
-    TESTING("    nbit compound with no-op type (read)");
+    TESTING("    nbit compound complex (read)");
 
     /* Read the dataset back */
-    if (H5Dread(dataset, cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
-        goto error;
+    if (H5Dread(dataset, mem_cmpd_tid2, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Check that the values read are the same as the values written */
+    /* Check that the values read are the same as the values written
+     * Use mask for checking the significant bits, ignoring the padding bits
+     */
+    /* The original code
+     *   i_mask = ~((unsigned)~0 << (precision[0] + offset[0])) & ((unsigned)~0 << offset[0]);
+     * left shift a 32-bit integer for 32-bit.  The result is undefined by C language.  A user
+     * discovered it using clang compiler with -fcatch-undefined-behavior option (see Issue 7674
+     * in Jira).  So I changed it in a funny way as below to avoid it. SLU - 2011/8/11
+     */
+    if (sizeof(unsigned) > 4)
+        i_mask = ~((unsigned)~0 << (precision[0] + offset[0])) & ((unsigned)~0 << offset[0]);
+    else {
+        i_mask = 0xffffffff;
+        i_mask = i_mask & ((unsigned)~0 << offset[0]);
+    }
+    c_mask = ~((unsigned)~0 << (precision[1] + offset[1])) & ((unsigned)~0 << offset[1]);
+    s_mask = ~((unsigned)~0 << (precision[2] + offset[2])) & ((unsigned)~0 << offset[2]);
+    b_mask = ~((unsigned)~0 << (precision[4] + offset[4])) & ((unsigned)~0 << offset[4]);
     for (i = 0; i < (size_t)size[0]; i++) {
-        if (new_data[i].i != orig_data[i].i || HDstrcmp(new_data[i].str, orig_data[i].str) != 0 ||
-            HDstrcmp(new_data[i].vl_str, orig_data[i].vl_str) != 0 ||
-            new_data[i].v.len != orig_data[i].v.len || new_data[i].r != orig_data[i].r) {
-            H5_FAILED();
-            HDprintf("    Read different values than written.\n");
-            HDprintf("    At index %lu\n", (unsigned long)i);
-            goto error;
-        }
+        for (j = 0; j < (size_t)size[1]; j++) {
+            b_failed = 0;
+            d_failed = 0;
 
-        for (k = 0; k < i + 1; k++)
-            if (((unsigned int *)orig_data[i].v.p)[k] != ((unsigned int *)new_data[i].v.p)[k]) {
-                H5_FAILED();
-                HDprintf("    Read different values than written.\n");
-                HDprintf("    At index %lu\n", (unsigned long)i);
-                goto error;
-            }
+            for (m = 0; m < (size_t)array_dims[0]; m++)
+                for (n = 0; n < (size_t)array_dims[1]; n++)
+                    if (((unsigned)new_data[i][j].b[m][n] & b_mask) !=
+                        ((unsigned)orig_data[i][j].b[m][n] & b_mask)) {
+                        b_failed = 1;
+                        goto out;
+                    }
 
-        for (j = 0; j < 5; j++)
-            if (orig_data[i].o[j] != new_data[i].o[j]) {
+            for (m = 0; m < (size_t)array_dims[0]; m++)
+                for (n = 0; n < (size_t)array_dims[1]; n++)
+                    if (((unsigned)new_data[i][j].d[m][n].i & i_mask) !=
+                            ((unsigned)orig_data[i][j].d[m][n].i & i_mask) ||
+                        ((unsigned)new_data[i][j].d[m][n].c & c_mask) !=
+                            ((unsigned)orig_data[i][j].d[m][n].c & c_mask) ||
+                        ((unsigned)new_data[i][j].d[m][n].s & s_mask) !=
+                            ((unsigned)orig_data[i][j].d[m][n].s & s_mask) ||
+                        (!HDisnan(new_data[i][j].d[m][n].f) &&
+                         !H5_FLT_ABS_EQUAL(new_data[i][j].d[m][n].f, new_data[i][j].d[m][n].f))) {
+                        d_failed = 1;
+                        goto out;
+                    }
+
+out:
+            if (((unsigned)new_data[i][j].a.i & i_mask) != ((unsigned)orig_data[i][j].a.i & i_mask) ||
+                ((unsigned)new_data[i][j].a.c & c_mask) != ((unsigned)orig_data[i][j].a.c & c_mask) ||
+                ((unsigned)new_data[i][j].a.s & s_mask) != ((unsigned)orig_data[i][j].a.s & s_mask) ||
+                (!HDisnan(new_data[i][j].a.f) && !H5_FLT_ABS_EQUAL(new_data[i][j].a.f, new_data[i][j].a.f)) ||
+                new_data[i][j].v != orig_data[i][j].v || b_failed || d_failed) {
                 H5_FAILED();
                 HDprintf("    Read different values than written.\n");
-                HDprintf("    At index %lu\n", (unsigned long)i);
+                HDprintf("    At index %lu,%lu\n", (unsigned long)i, (unsigned long)j);
                 goto error;
             }
+        }
     }
 
     /*----------------------------------------------------------------------
      * Cleanup
      *----------------------------------------------------------------------
      */
-    if (H5Treclaim(cmpd_tid, space, H5P_DEFAULT, new_data) < 0)
-        goto error;
-    if (H5Treclaim(cmpd_tid, space, H5P_DEFAULT, orig_data) < 0)
-        goto error;
     if (H5Tclose(i_tid) < 0)
-        goto error;
-    if (H5Tclose(str_tid) < 0)
-        goto error;
-    if (H5Tclose(vl_str_tid) < 0)
-        goto error;
+        FAIL_STACK_ERROR;
+    if (H5Tclose(c_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(s_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(f_tid) < 0)
+        FAIL_STACK_ERROR;
     if (H5Tclose(v_tid) < 0)
-        goto error;
-    if (H5Tclose(o_tid) < 0)
-        goto error;
-    if (H5Tclose(cmpd_tid) < 0)
-        goto error;
+        FAIL_STACK_ERROR;
+    if (H5Tclose(cmpd_tid2) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(cmpd_tid1) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(mem_cmpd_tid2) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(mem_cmpd_tid1) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(array_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(base_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(array_cmplx_tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(mem_array_cmplx_tid) < 0)
+        FAIL_STACK_ERROR;
     if (H5Pclose(dc) < 0)
-        goto error;
+        FAIL_STACK_ERROR;
     if (H5Sclose(space) < 0)
-        goto error;
-    if (H5Dclose(obj_ref_dataset) < 0)
-        goto error;
+        FAIL_STACK_ERROR;
     if (H5Dclose(dataset) < 0)
-        goto error;
+        FAIL_STACK_ERROR;
 
     PASSED();
 
@@ -4452,19 +4958,223 @@ test_nbit_compound_3(hid_t file)
 
 error:
     return FAIL;
-} /* end test_nbit_compound_3() */
+} /* end test_nbit_compound_2() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_nbit_int_size
+ * Function:    test_nbit_compound_3
  *
- * Purpose:     Tests the correct size of the integer datatype for nbit filter
+ * Purpose:     Tests no-op datatypes in compound datatype for nbit filter
  *
  * Return:      Success:        0
  *
  *              Failure:        -1
  *
- * Programmer:  Raymond Lu
- *              19 November 2010
+ * Programmer:  Xiaowen Wu
+ *              Thursday, Mar. 31th, 2005
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_compound_3(hid_t file)
+{
+    typedef struct {           /* Struct with some no-op type fields */
+        int           i;       /* integer field, NOT a no-op type */
+        char          str[30]; /* fixed-length string, no-op type */
+        char         *vl_str;  /* varible-length string, no-op type */
+        hvl_t         v;       /* VL datatype field, no-op type */
+        hobj_ref_t    r;       /* Object reference field, no-op type */
+        unsigned char o[5];    /* Opaque field, no-op type */
+    } atomic;
+    hid_t         i_tid, str_tid, vl_str_tid, v_tid, o_tid;
+    hid_t         cmpd_tid; /* atomic compound datatype */
+    hid_t         dataset, space, dc, obj_ref_dataset = -1;
+    const hsize_t size[1]       = {5};
+    const hsize_t chunk_size[1] = {5};
+    atomic        orig_data[5];
+    atomic        new_data[5];
+    double        power;
+    size_t        i, k, j;
+
+    TESTING("    nbit compound with no-op type (setup)");
+
+    /* Define datatypes of members of compound datatype */
+    i_tid = H5Tcopy(H5T_NATIVE_INT);
+    if (H5Tset_precision(i_tid, (size_t)17) < 0)
+        goto error;
+
+    str_tid = H5Tcopy(H5T_C_S1);
+    if (H5Tset_size(str_tid, (size_t)30) < 0)
+        goto error;
+
+    vl_str_tid = H5Tcopy(H5T_C_S1);
+    if (H5Tset_size(vl_str_tid, H5T_VARIABLE) < 0)
+        goto error;
+
+    if ((v_tid = H5Tvlen_create(H5T_NATIVE_UINT)) < 0)
+        goto error;
+
+    if ((o_tid = H5Tcreate(H5T_OPAQUE, (size_t)5)) < 0)
+        goto error;
+    if (H5Tset_tag(o_tid, "testing opaque field") < 0)
+        goto error;
+
+    /* Create a dataset compound datatype and insert some atomic types */
+    cmpd_tid = H5Tcreate(H5T_COMPOUND, sizeof(atomic));
+    if (H5Tinsert(cmpd_tid, "i", HOFFSET(atomic, i), i_tid) < 0)
+        goto error;
+    if (H5Tinsert(cmpd_tid, "str", HOFFSET(atomic, str), str_tid) < 0)
+        goto error;
+    if (H5Tinsert(cmpd_tid, "vl_str", HOFFSET(atomic, vl_str), vl_str_tid) < 0)
+        goto error;
+    if (H5Tinsert(cmpd_tid, "v", HOFFSET(atomic, v), v_tid) < 0)
+        goto error;
+    if (H5Tinsert(cmpd_tid, "r", HOFFSET(atomic, r), H5T_STD_REF_OBJ) < 0)
+        goto error;
+    if (H5Tinsert(cmpd_tid, "o", HOFFSET(atomic, o), o_tid) < 0)
+        goto error;
+
+    /* Create the data space */
+    if ((space = H5Screate_simple(1, size, NULL)) < 0)
+        goto error;
+
+    /* Use nbit filter  */
+    if ((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        goto error;
+    if (H5Pset_chunk(dc, 1, chunk_size) < 0)
+        goto error;
+    if (H5Pset_nbit(dc) < 0)
+        goto error;
+
+    /* Create the dataset */
+    if ((dataset =
+             H5Dcreate2(file, DSET_NBIT_COMPOUND_NAME_3, cmpd_tid, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+        goto error;
+
+    /* Create the dataset object reference points to */
+    if ((obj_ref_dataset = H5Dcreate2(file, "nbit_obj_ref", H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT,
+                                      H5P_DEFAULT)) < 0)
+        goto error;
+
+    /* Initialize data */
+    for (i = 0; i < (size_t)size[0]; i++) {
+        power = HDpow(2.0, 17.0 - 1.0);
+        HDmemset(&orig_data[i], 0, sizeof(orig_data[i]));
+        orig_data[i].i = (int)(HDrandom() % (long)power);
+        HDstrcpy(orig_data[i].str, "fixed-length C string");
+        orig_data[i].vl_str = HDstrdup("variable-length C string");
+
+        orig_data[i].v.p   = HDmalloc((size_t)(i + 1) * sizeof(unsigned int));
+        orig_data[i].v.len = (size_t)i + 1;
+        for (k = 0; k < (i + 1); k++)
+            ((unsigned int *)orig_data[i].v.p)[k] = (unsigned int)(i * 100 + k);
+
+        /* Create reference to the dataset "nbit_obj_ref" */
+        if (H5Rcreate(&orig_data[i].r, file, "nbit_obj_ref", H5R_OBJECT, (hid_t)-1) < 0)
+            goto error;
+
+        for (j = 0; j < 5; j++)
+            orig_data[i].o[j] = (unsigned char)(i + j);
+    }
+
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 1: Test nbit by setting up a chunked dataset and writing
+     * to it.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit compound with no-op type (write)");
+
+    if (H5Dwrite(dataset, cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig_data) < 0)
+        goto error;
+    PASSED();
+
+    /*----------------------------------------------------------------------
+     * STEP 2: Try to read the data we just wrote.
+     *----------------------------------------------------------------------
+     */
+    TESTING("    nbit compound with no-op type (read)");
+
+    /* Read the dataset back */
+    if (H5Dread(dataset, cmpd_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+        goto error;
+
+    /* Check that the values read are the same as the values written */
+    for (i = 0; i < (size_t)size[0]; i++) {
+        if (new_data[i].i != orig_data[i].i || HDstrcmp(new_data[i].str, orig_data[i].str) != 0 ||
+            HDstrcmp(new_data[i].vl_str, orig_data[i].vl_str) != 0 ||
+            new_data[i].v.len != orig_data[i].v.len || new_data[i].r != orig_data[i].r) {
+            H5_FAILED();
+            HDprintf("    Read different values than written.\n");
+            HDprintf("    At index %lu\n", (unsigned long)i);
+            goto error;
+        }
+
+        for (k = 0; k < i + 1; k++)
+            if (((unsigned int *)orig_data[i].v.p)[k] != ((unsigned int *)new_data[i].v.p)[k]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %lu\n", (unsigned long)i);
+                goto error;
+            }
+
+        for (j = 0; j < 5; j++)
+            if (orig_data[i].o[j] != new_data[i].o[j]) {
+                H5_FAILED();
+                HDprintf("    Read different values than written.\n");
+                HDprintf("    At index %lu\n", (unsigned long)i);
+                goto error;
+            }
+    }
+
+    /*----------------------------------------------------------------------
+     * Cleanup
+     *----------------------------------------------------------------------
+     */
+    if (H5Treclaim(cmpd_tid, space, H5P_DEFAULT, new_data) < 0)
+        goto error;
+    if (H5Treclaim(cmpd_tid, space, H5P_DEFAULT, orig_data) < 0)
+        goto error;
+    if (H5Tclose(i_tid) < 0)
+        goto error;
+    if (H5Tclose(str_tid) < 0)
+        goto error;
+    if (H5Tclose(vl_str_tid) < 0)
+        goto error;
+    if (H5Tclose(v_tid) < 0)
+        goto error;
+    if (H5Tclose(o_tid) < 0)
+        goto error;
+    if (H5Tclose(cmpd_tid) < 0)
+        goto error;
+    if (H5Pclose(dc) < 0)
+        goto error;
+    if (H5Sclose(space) < 0)
+        goto error;
+    if (H5Dclose(obj_ref_dataset) < 0)
+        goto error;
+    if (H5Dclose(dataset) < 0)
+        goto error;
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    return FAIL;
+} /* end test_nbit_compound_3() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_int_size
+ *
+ * Purpose:     Tests the correct size of the integer datatype for nbit filter
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        -1
+ *
+ * Programmer:  Raymond Lu
+ *              19 November 2010
  *
  *-------------------------------------------------------------------------
  */
@@ -12101,144 +12811,1003 @@ test_swmr_non_latest(const char *env_h5_driver, hid_t fapl)
     /* Read from the dataset and verify data read is correct */
     if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data) < 0)
         FAIL_STACK_ERROR;
-    if (data != 100)
+    if (data != 100)
+        TEST_ERROR;
+
+    /* Close the dataset */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create a group in the file */
+    if ((gid = H5Gcreate2(fid, "group", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create a chunked dataset in the group: this will use v2 B-tree chunk indexing */
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+
+    chunk_dims2[0] = chunk_dims2[1] = 10;
+    if (H5Pset_chunk(dcpl, 2, chunk_dims2) < 0)
+        FAIL_STACK_ERROR;
+
+    dims2[0] = dims2[1] = 1;
+    max_dims2[0] = max_dims2[1] = H5S_UNLIMITED;
+    if ((sid = H5Screate_simple(2, dims2, max_dims2)) < 0)
+        FAIL_STACK_ERROR;
+
+    if ((did = H5Dcreate2(gid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the dataset's indexing type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_BT2)
+        FAIL_PUTS_ERROR("created dataset not indexed by v2 B-tree");
+
+    /* Closing */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Gclose(gid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the file again */
+    if ((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the group */
+    if ((gid = H5Gopen2(fid, "group", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the dataset in the group */
+    if ((did = H5Dopen2(gid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the dataset's indexing type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_BT2)
+        FAIL_PUTS_ERROR("created dataset not indexed by v2 B-tree");
+
+    /* Closing */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Gclose(gid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Reopen the file with SWMR-write */
+    if ((fid = H5Fopen(filename, H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the dataset in the file */
+    if ((did = H5Dopen2(fid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the dataset's indexing type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_EARRAY)
+        FAIL_PUTS_ERROR("created dataset not indexed by extensible array");
+
+    /* Close the dataset */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the group */
+    if ((gid = H5Gopen2(fid, "group", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the dataset in the group */
+    if ((did = H5Dopen2(gid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the dataset's indexing type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_BT2)
+        FAIL_PUTS_ERROR("created dataset not indexed by v2 B-tree");
+
+    /* Write to the dataset in the group */
+    data = 99;
+    if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Closing */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Gclose(gid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the file again with SWMR read access */
+    if ((fid = H5Fopen(filename, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    if ((gid = H5Gopen2(fid, "group", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the dataset */
+    if ((did = H5Dopen2(gid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Read from the dataset and verify data read is correct */
+    data = 0;
+    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data) < 0)
+        FAIL_STACK_ERROR;
+    if (data != 99)
+        TEST_ERROR;
+
+    /* Closing */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Gclose(gid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(sid);
+        H5Gclose(gid);
+        H5Fclose(fid);
+    }
+    H5E_END_TRY
+    return FAIL;
+} /* test_swmr_non_latest() */
+
+/*-------------------------------------------------------------------------
+ * Function: test_earray_hdr_fd
+ *
+ * Purpose: Tests that extensible array header flush dependencies
+ *          are created and torn down correctly when used as a
+ *          chunk index.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_earray_hdr_fd(const char *env_h5_driver, hid_t fapl)
+{
+    char              filename[FILENAME_BUF_SIZE];
+    hid_t             fid  = -1;
+    hid_t             sid  = -1;
+    hid_t             did  = -1;
+    hid_t             tid  = -1;
+    hid_t             dcpl = -1;
+    hid_t             msid = -1;
+    H5D_chunk_index_t idx_type;
+    const hsize_t     shape[1]    = {8};
+    const hsize_t     maxshape[1] = {H5S_UNLIMITED};
+    const hsize_t     chunk[1]    = {8};
+    const int         buffer[8]   = {0, 1, 2, 3, 4, 5, 6, 7};
+    H5O_info2_t       info;
+
+    TESTING("Extensible array chunk index header flush dependencies handled correctly");
+
+    /* Skip this test if SWMR I/O is not supported for the VFD specified
+     * by the environment variable.
+     */
+    if (!H5FD__supports_swmr_test(env_h5_driver)) {
+        SKIPPED();
+        HDputs("    Test skipped due to VFD not supporting SWMR I/O.");
+        return SUCCEED;
+    }
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
+        FAIL_STACK_ERROR;
+
+    h5_fixname(FILENAME[19], fapl, filename, sizeof(filename));
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create a dataset with one unlimited dimension */
+    if ((sid = H5Screate_simple(1, shape, maxshape)) < 0)
+        FAIL_STACK_ERROR;
+    if ((tid = H5Tcopy(H5T_NATIVE_INT32)) < 0)
+        FAIL_STACK_ERROR;
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dcpl, 1, chunk) < 0)
+        FAIL_STACK_ERROR;
+    if ((did = H5Dcreate2(fid, DSET_EARRAY_HDR_FD, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the chunk index type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_EARRAY)
+        FAIL_PUTS_ERROR("should be using extensible array as index");
+
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+
+    if (H5Fstart_swmr_write(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Write data to the dataset */
+    if ((did = H5Dopen2(fid, DSET_EARRAY_HDR_FD, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((tid = H5Dget_type(did)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(tid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* The second call triggered a bug in the library (JIRA issue: SWMR-95) */
+    if (H5Oget_info_by_name3(fid, DSET_EARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Oget_info_by_name3(fid, DSET_EARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    if (H5Pclose(fapl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(fapl);
+        H5Fclose(fid);
+        H5Dclose(did);
+        H5Pclose(dcpl);
+        H5Tclose(tid);
+        H5Sclose(sid);
+        H5Sclose(msid);
+    }
+    H5E_END_TRY
+    return FAIL;
+} /* test_earray_hdr_fd() */
+
+/*-------------------------------------------------------------------------
+ * Function: test_farray_hdr_fd
+ *
+ * Purpose: Tests that fixed array header flush dependencies
+ *          are created and torn down correctly when used as a
+ *          chunk index.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_farray_hdr_fd(const char *env_h5_driver, hid_t fapl)
+{
+    char              filename[FILENAME_BUF_SIZE];
+    hid_t             fid  = -1;
+    hid_t             sid  = -1;
+    hid_t             did  = -1;
+    hid_t             tid  = -1;
+    hid_t             dcpl = -1;
+    hid_t             msid = -1;
+    H5D_chunk_index_t idx_type;
+    const hsize_t     shape[1]    = {8};
+    const hsize_t     maxshape[1] = {64};
+    const hsize_t     chunk[1]    = {8};
+    const int         buffer[8]   = {0, 1, 2, 3, 4, 5, 6, 7};
+    H5O_info2_t       info;
+
+    TESTING("Fixed array chunk index header flush dependencies handled correctly");
+
+    /* Skip this test if SWMR I/O is not supported for the VFD specified
+     * by the environment variable.
+     */
+    if (!H5FD__supports_swmr_test(env_h5_driver)) {
+        SKIPPED();
+        HDputs("    Test skipped due to VFD not supporting SWMR I/O.");
+        return SUCCEED;
+    }
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
+        FAIL_STACK_ERROR;
+
+    h5_fixname(FILENAME[20], fapl, filename, sizeof(filename));
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create a chunked dataset with fixed dimensions */
+    if ((sid = H5Screate_simple(1, shape, maxshape)) < 0)
+        FAIL_STACK_ERROR;
+    if ((tid = H5Tcopy(H5T_NATIVE_INT32)) < 0)
+        FAIL_STACK_ERROR;
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dcpl, 1, chunk) < 0)
+        FAIL_STACK_ERROR;
+    if ((did = H5Dcreate2(fid, DSET_FARRAY_HDR_FD, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the chunk index type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_FARRAY)
+        FAIL_PUTS_ERROR("should be using fixed array as index");
+
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+
+    if (H5Fstart_swmr_write(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Write data to the dataset */
+    if ((did = H5Dopen2(fid, DSET_FARRAY_HDR_FD, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((tid = H5Dget_type(did)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(tid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* The second call triggered a bug in the library (JIRA issue: SWMR-95) */
+    if (H5Oget_info_by_name3(fid, DSET_FARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Oget_info_by_name3(fid, DSET_FARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    if (H5Pclose(fapl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(fapl);
+        H5Fclose(fid);
+        H5Dclose(did);
+        H5Pclose(dcpl);
+        H5Tclose(tid);
+        H5Sclose(sid);
+        H5Sclose(msid);
+    }
+    H5E_END_TRY
+    return FAIL;
+} /* end test_farray_hdr_fd() */
+
+/*-------------------------------------------------------------------------
+ * Function: test_bt2_hdr_fd
+ *
+ * Purpose: Tests that version 2 B-tree header flush dependencies
+ *          are created and torn down correctly when used as a
+ *          chunk index.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_bt2_hdr_fd(const char *env_h5_driver, hid_t fapl)
+{
+    char              filename[FILENAME_BUF_SIZE];
+    hid_t             fid  = -1;
+    hid_t             sid  = -1;
+    hid_t             did  = -1;
+    hid_t             tid  = -1;
+    hid_t             dcpl = -1;
+    hid_t             msid = -1;
+    H5D_chunk_index_t idx_type;
+    const hsize_t     shape[2]     = {8, 8};
+    const hsize_t     maxshape[2]  = {H5S_UNLIMITED, H5S_UNLIMITED};
+    const hsize_t     chunk[2]     = {8, 8};
+    const int         buffer[8][8] = {{0, 1, 2, 3, 4, 5, 6, 7},         {8, 9, 10, 11, 12, 13, 14, 15},
+                              {16, 17, 18, 19, 20, 21, 22, 23}, {24, 25, 26, 27, 28, 29, 30, 31},
+                              {32, 33, 34, 35, 36, 37, 38, 39}, {40, 41, 42, 43, 44, 45, 46, 47},
+                              {48, 49, 50, 51, 52, 53, 54, 55}, {56, 57, 58, 59, 60, 61, 62, 63}};
+    H5O_info2_t       info;
+
+    TESTING("Version 2 B-tree chunk index header flush dependencies handled correctly");
+
+    /* Initialize struct */
+    HDmemset(&info, 0, sizeof(info));
+
+    /* Skip this test if SWMR I/O is not supported for the VFD specified
+     * by the environment variable.
+     */
+    if (!H5FD__supports_swmr_test(env_h5_driver)) {
+        SKIPPED();
+        HDputs("    Test skipped due to VFD not supporting SWMR I/O.");
+        return SUCCEED;
+    }
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
+        FAIL_STACK_ERROR;
+
+    h5_fixname(FILENAME[21], fapl, filename, sizeof(filename));
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create a chunked dataset with fixed dimensions */
+    if ((sid = H5Screate_simple(2, shape, maxshape)) < 0)
+        FAIL_STACK_ERROR;
+    if ((tid = H5Tcopy(H5T_NATIVE_INT32)) < 0)
+        FAIL_STACK_ERROR;
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dcpl, 2, chunk) < 0)
+        FAIL_STACK_ERROR;
+    if ((did = H5Dcreate2(fid, DSET_BT2_HDR_FD, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Verify the chunk index type */
+    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+        FAIL_STACK_ERROR;
+    if (idx_type != H5D_CHUNK_IDX_BT2)
+        FAIL_PUTS_ERROR("should be using fixed array as index");
+
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(tid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+
+    if (H5Fstart_swmr_write(fid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Write data to the dataset */
+    if ((did = H5Dopen2(fid, DSET_BT2_HDR_FD, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((tid = H5Dget_type(did)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Tclose(tid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* The second call triggered a bug in the library (JIRA issue: SWMR-95) */
+    if (H5Oget_info_by_name3(fid, DSET_BT2_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Oget_info_by_name3(fid, DSET_BT2_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    if (H5Pclose(fapl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(fapl);
+        H5Fclose(fid);
+        H5Dclose(did);
+        H5Pclose(dcpl);
+        H5Tclose(tid);
+        H5Sclose(sid);
+        H5Sclose(msid);
+    }
+    H5E_END_TRY
+    return FAIL;
+} /* end test_bt2_hdr_fd() */
+
+/*-------------------------------------------------------------------------
+ * Function: test_storage_size
+ *
+ * Purpose:     Tests results from querying the storage size of a dataset,
+ *              before/after extending the dimensions.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ * Programmer:  Quincey Koziol
+ *              Monday, April 11, 2016
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_storage_size(hid_t fapl)
+{
+    char    filename[FILENAME_BUF_SIZE];
+    hid_t   fid  = -1;             /* File ID */
+    hid_t   dcpl = -1, dcpl2 = -1; /* Dataset creation property list IDs */
+    hid_t   sid  = -1;             /* Dataspace ID */
+    hid_t   dsid = -1;             /* Dataset ID */
+    hsize_t dims[2], max_dims[2];  /* Dataset dimensions */
+    hsize_t new_dims[2];           /* New dataset dimensions */
+    hsize_t chunk_dims[2];         /* Chunk dimensions */
+    int     wdata[STORAGE_SIZE_DIM1][STORAGE_SIZE_DIM2];
+    hsize_t ssize; /* Dataset storage size */
+
+    TESTING("querying storage size");
+
+    h5_fixname(FILENAME[22], fapl, filename, sizeof filename);
+
+    /* Create file */
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create dataset creation property list */
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Set chunk size */
+    chunk_dims[0] = STORAGE_SIZE_CHUNK_DIM1;
+    chunk_dims[1] = STORAGE_SIZE_CHUNK_DIM2;
+    if (H5Pset_chunk(dcpl, 2, chunk_dims) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Copy the DCPL, and set it to early allocation */
+    if ((dcpl2 = H5Pcopy(dcpl)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_alloc_time(dcpl2, H5D_ALLOC_TIME_EARLY) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create 2D dataspace, with max dims same as current dimensions */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = STORAGE_SIZE_DIM1;
+    max_dims[1] = STORAGE_SIZE_DIM2;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create chunked dataset */
+    if ((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
+
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset", fid, "dset_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset_copy", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create 2D dataspace with max dims > current dims (but not unlimited) */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = STORAGE_SIZE_MAX_DIM1;
+    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create chunked dataset */
+    if ((dsid = H5Dcreate2(fid, "dset2", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
+
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Extend dataset's dimensions */
+    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
+    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
+    if (H5Dset_extent(dsid, new_dims) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset2", fid, "dset2_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset2_copy", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create 2D dataspace with max dims > current dims (but not unlimited) */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = STORAGE_SIZE_MAX_DIM1;
+    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create chunked dataset, w/early allocation */
+    if ((dsid = H5Dcreate2(fid, "dset2a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
+
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Extend dataset's dimensions */
+    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
+    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
+    if (H5Dset_extent(dsid, new_dims) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset2a", fid, "dset2a_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset2a_copy", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create 2D dataspace with max dims > current dims (and 1 unlimited dim) */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = H5S_UNLIMITED;
+    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create chunked dataset */
+    if ((dsid = H5Dcreate2(fid, "dset3", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
+
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Extend dataset's dimensions */
+    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
+    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
+    if (H5Dset_extent(dsid, new_dims) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset3", fid, "dset3_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset3_copy", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create 2D dataspace with max dims > current dims (and 1 unlimited dim) */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = H5S_UNLIMITED;
+    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Create chunked dataset, w/early allocation */
+    if ((dsid = H5Dcreate2(fid, "dset3a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
+
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+        FAIL_STACK_ERROR;
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
+        FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
         TEST_ERROR;
 
-    /* Close the dataset */
-    if (H5Dclose(did) < 0)
+    /* Extend dataset's dimensions */
+    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
+    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
+    if (H5Dset_extent(dsid, new_dims) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create a group in the file */
-    if ((gid = H5Gcreate2(fid, "group", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
+    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
 
-    /* Create a chunked dataset in the group: this will use v2 B-tree chunk indexing */
-    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
         FAIL_STACK_ERROR;
-
-    chunk_dims2[0] = chunk_dims2[1] = 10;
-    if (H5Pset_chunk(dcpl, 2, chunk_dims2) < 0)
+    if (H5Dclose(dsid) < 0)
         FAIL_STACK_ERROR;
 
-    dims2[0] = dims2[1] = 1;
-    max_dims2[0] = max_dims2[1] = H5S_UNLIMITED;
-    if ((sid = H5Screate_simple(2, dims2, max_dims2)) < 0)
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset3a", fid, "dset3a_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
         FAIL_STACK_ERROR;
 
-    if ((did = H5Dcreate2(gid, DSET_CHUNKED_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset3a_copy", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Verify the dataset's indexing type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_BT2)
-        FAIL_PUTS_ERROR("created dataset not indexed by v2 B-tree");
+    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
 
-    /* Closing */
-    if (H5Dclose(did) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Sclose(sid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Gclose(gid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pclose(dcpl) < 0)
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Fclose(fid) < 0)
+
+    /* Create 2D dataspace with max dims > current dims (and 2 unlimited dims) */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = H5S_UNLIMITED;
+    max_dims[1] = H5S_UNLIMITED;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the file again */
-    if ((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+    /* Create chunked dataset */
+    if ((dsid = H5Dcreate2(fid, "dset4", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the group */
-    if ((gid = H5Gopen2(fid, "group", H5P_DEFAULT)) < 0)
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
+
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the dataset in the group */
-    if ((did = H5Dopen2(gid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
 
-    /* Verify the dataset's indexing type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+    /* Extend dataset's dimensions */
+    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
+    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
+    if (H5Dset_extent(dsid, new_dims) < 0)
         FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_BT2)
-        FAIL_PUTS_ERROR("created dataset not indexed by v2 B-tree");
 
-    /* Closing */
-    if (H5Dclose(did) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
-    if (H5Gclose(gid) < 0)
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Fclose(fid) < 0)
+    if (H5Dclose(dsid) < 0)
         FAIL_STACK_ERROR;
 
-    /* Reopen the file with SWMR-write */
-    if ((fid = H5Fopen(filename, H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE, fapl)) < 0)
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset4", fid, "dset4_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the dataset in the file */
-    if ((did = H5Dopen2(fid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset4_copy", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Verify the dataset's indexing type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_EARRAY)
-        FAIL_PUTS_ERROR("created dataset not indexed by extensible array");
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
 
-    /* Close the dataset */
-    if (H5Dclose(did) < 0)
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the group */
-    if ((gid = H5Gopen2(fid, "group", H5P_DEFAULT)) < 0)
+    /* Create 2D dataspace with max dims > current dims (and 2 unlimited dims) */
+    dims[0]     = STORAGE_SIZE_DIM1;
+    dims[1]     = STORAGE_SIZE_DIM2;
+    max_dims[0] = H5S_UNLIMITED;
+    max_dims[1] = H5S_UNLIMITED;
+    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the dataset in the group */
-    if ((did = H5Dopen2(gid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+    /* Create chunked dataset, w/early allocation */
+    if ((dsid = H5Dcreate2(fid, "dset4a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Verify the dataset's indexing type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
-        FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_BT2)
-        FAIL_PUTS_ERROR("created dataset not indexed by v2 B-tree");
+    /* Initialize buffer to zeroes */
+    HDmemset(wdata, 0, sizeof(wdata));
 
-    /* Write to the dataset in the group */
-    data = 99;
-    if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data) < 0)
+    /* write elements to dataset */
+    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
         FAIL_STACK_ERROR;
 
-    /* Closing */
-    if (H5Dclose(did) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
-    if (H5Gclose(gid) < 0)
+    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
+
+    /* Extend dataset's dimensions */
+    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
+    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
+    if (H5Dset_extent(dsid, new_dims) < 0)
         FAIL_STACK_ERROR;
-    if (H5Fclose(fid) < 0)
+
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
+    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
+        TEST_ERROR;
 
-    /* Open the file again with SWMR read access */
-    if ((fid = H5Fopen(filename, H5F_ACC_RDONLY | H5F_ACC_SWMR_READ, fapl)) < 0)
+    /* Close dataset & dataspace */
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(dsid) < 0)
         FAIL_STACK_ERROR;
 
-    if ((gid = H5Gopen2(fid, "group", H5P_DEFAULT)) < 0)
+    /* Copy the dataset */
+    if (H5Ocopy(fid, "dset4a", fid, "dset4a_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the dataset */
-    if ((did = H5Dopen2(gid, DSET_CHUNKED_NAME, H5P_DEFAULT)) < 0)
+    /* Open the copied dataset */
+    if ((dsid = H5Dopen2(fid, "dset4a_copy", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Read from the dataset and verify data read is correct */
-    data = 0;
-    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data) < 0)
+    /* Get the storage size */
+    if (0 == (ssize = H5Dget_storage_size(dsid)))
         FAIL_STACK_ERROR;
-    if (data != 99)
+    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
         TEST_ERROR;
 
-    /* Closing */
-    if (H5Dclose(did) < 0)
+    /* Close copied dataset */
+    if (H5Dclose(dsid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Gclose(gid) < 0)
+
+    /* Close rest */
+    if (H5Pclose(dcpl) < 0)
         FAIL_STACK_ERROR;
     if (H5Fclose(fid) < 0)
         FAIL_STACK_ERROR;
@@ -12251,114 +13820,90 @@ error:
     H5E_BEGIN_TRY
     {
         H5Pclose(dcpl);
-        H5Dclose(did);
+        H5Pclose(dcpl2);
+        H5Dclose(dsid);
         H5Sclose(sid);
-        H5Gclose(gid);
         H5Fclose(fid);
     }
     H5E_END_TRY
     return FAIL;
-} /* test_swmr_non_latest() */
+} /* end test_storage_size() */
 
 /*-------------------------------------------------------------------------
- * Function: test_earray_hdr_fd
+ * Function:    test_power2up
  *
- * Purpose: Tests that extensible array header flush dependencies
- *          are created and torn down correctly when used as a
- *          chunk index.
+ * Purpose:     Tests that the H5VM_power2up(n) function does not result in an
+ *              infinite loop when input n exceeds 2^63. (HDFFV-10217)
+ *              H5VM_power2up() is used to calculate the next power of 2 for
+ *              a dataset's scaled dimension sizes.
  *
  * Return:      Success: 0
  *              Failure: -1
  *
+ * Programmer:  Vailin Choi; June 2017
+ *
  *-------------------------------------------------------------------------
  */
 static herr_t
-test_earray_hdr_fd(const char *env_h5_driver, hid_t fapl)
+test_power2up(hid_t fapl)
 {
-    char              filename[FILENAME_BUF_SIZE];
-    hid_t             fid  = -1;
-    hid_t             sid  = -1;
-    hid_t             did  = -1;
-    hid_t             tid  = -1;
-    hid_t             dcpl = -1;
-    hid_t             msid = -1;
-    H5D_chunk_index_t idx_type;
-    const hsize_t     shape[1]    = {8};
-    const hsize_t     maxshape[1] = {H5S_UNLIMITED};
-    const hsize_t     chunk[1]    = {8};
-    const int         buffer[8]   = {0, 1, 2, 3, 4, 5, 6, 7};
-    H5O_info2_t       info;
-
-    TESTING("Extensible array chunk index header flush dependencies handled correctly");
+    char    filename[FILENAME_BUF_SIZE];
+    hid_t   fid  = -1;     /* File ID */
+    hid_t   dcpl = -1;     /* Dataset creation property list */
+    hid_t   sid  = -1;     /* Dataspace ID */
+    hid_t   did  = -1;     /* Dataset ID */
+    hsize_t dims[2];       /* Dataset dimension sizes */
+    hsize_t max_dims[2];   /* Maximum dimension sizes */
+    hsize_t chunk_dims[2]; /* Chunk dimensions */
+    hsize_t ext_dims[2];   /* Extended dimension sizes */
+    herr_t  status;        /* Error status */
 
-    /* Skip this test if SWMR I/O is not supported for the VFD specified
-     * by the environment variable.
-     */
-    if (!H5FD__supports_swmr_test(env_h5_driver)) {
-        SKIPPED();
-        HDputs("    Test skipped due to VFD not supporting SWMR I/O.");
-        return SUCCEED;
-    }
+    TESTING("the next power of 2");
 
-    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
-        FAIL_STACK_ERROR;
+    h5_fixname(FILENAME[24], fapl, filename, sizeof filename);
 
-    h5_fixname(FILENAME[19], fapl, filename, sizeof(filename));
+    /* Create file */
     if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create a dataset with one unlimited dimension */
-    if ((sid = H5Screate_simple(1, shape, maxshape)) < 0)
-        FAIL_STACK_ERROR;
-    if ((tid = H5Tcopy(H5T_NATIVE_INT32)) < 0)
-        FAIL_STACK_ERROR;
-    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_chunk(dcpl, 1, chunk) < 0)
-        FAIL_STACK_ERROR;
-    if ((did = H5Dcreate2(fid, DSET_EARRAY_HDR_FD, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
-        FAIL_STACK_ERROR;
-
-    /* Verify the chunk index type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
-        FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_EARRAY)
-        FAIL_PUTS_ERROR("should be using extensible array as index");
+    /* Set dims[1] to ((2^63) -1) */
+    dims[0]     = 0;
+    dims[1]     = ((hsize_t)1 << ((sizeof(hsize_t) * CHAR_BIT) - 1)) - 1;
+    max_dims[0] = max_dims[1] = H5S_UNLIMITED;
+    sid                       = H5Screate_simple(2, dims, max_dims);
 
-    if (H5Dclose(did) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pclose(dcpl) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Sclose(sid) < 0)
-        FAIL_STACK_ERROR;
+    /* Create dataset creation property list */
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR;
 
-    if (H5Fstart_swmr_write(fid) < 0)
-        FAIL_STACK_ERROR;
+    /* Set chunk size */
+    chunk_dims[0] = chunk_dims[1] = 1;
+    if (H5Pset_chunk(dcpl, 2, chunk_dims) < 0)
+        TEST_ERROR;
 
-    /* Write data to the dataset */
-    if ((did = H5Dopen2(fid, DSET_EARRAY_HDR_FD, H5P_DEFAULT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((tid = H5Dget_type(did)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Dwrite(did, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Dclose(did) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(tid) < 0)
-        FAIL_STACK_ERROR;
+    /* Create chunked dataset */
+    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT64, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
 
-    /* The second call triggered a bug in the library (JIRA issue: SWMR-95) */
-    if (H5Oget_info_by_name3(fid, DSET_EARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Oget_info_by_name3(fid, DSET_EARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
-        FAIL_STACK_ERROR;
+    ext_dims[0] = 1;
+    ext_dims[1] = dims[1] + 5;
 
-    if (H5Pclose(fapl) < 0)
-        FAIL_STACK_ERROR;
+    /* Extend to (2^63)+ */
+    H5E_BEGIN_TRY
+    {
+        status = H5Dset_extent(did, ext_dims);
+    }
+    H5E_END_TRY
+    if (status >= 0)
+        TEST_ERROR;
+
+    /* Closing */
+    if (H5Dclose(did) < 0)
+        TEST_ERROR;
+    if (H5Sclose(sid) < 0)
+        TEST_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        TEST_ERROR;
     if (H5Fclose(fid) < 0)
         TEST_ERROR;
 
@@ -12369,119 +13914,199 @@ test_earray_hdr_fd(const char *env_h5_driver, hid_t fapl)
 error:
     H5E_BEGIN_TRY
     {
-        H5Pclose(fapl);
-        H5Fclose(fid);
-        H5Dclose(did);
         H5Pclose(dcpl);
-        H5Tclose(tid);
+        H5Dclose(did);
         H5Sclose(sid);
-        H5Sclose(msid);
+        H5Pclose(dcpl);
+        H5Fclose(fid);
     }
     H5E_END_TRY
     return FAIL;
-} /* test_earray_hdr_fd() */
+} /* end test_power2up() */
 
 /*-------------------------------------------------------------------------
- * Function: test_farray_hdr_fd
+ * Function:    test_filter_nthreads
  *
- * Purpose: Tests that fixed array header flush dependencies
- *          are created and torn down correctly when used as a
- *          chunk index.
+ * Purpose:     Tests writing and reading filtered chunked datasets with
+ *              the filter pipeline run on several threads
+ *              (H5Pset_filter_nthreads), with small and large chunk caches,
+ *              and with partial edge chunks that are stored unfiltered.
  *
  * Return:      Success: 0
  *              Failure: -1
  *
  *-------------------------------------------------------------------------
  */
+#define FILTER_NTHREADS_DIM   205
+#define FILTER_NTHREADS_CHUNK 20
 static herr_t
-test_farray_hdr_fd(const char *env_h5_driver, hid_t fapl)
+test_filter_nthreads(hid_t fapl)
 {
-    char              filename[FILENAME_BUF_SIZE];
-    hid_t             fid  = -1;
-    hid_t             sid  = -1;
-    hid_t             did  = -1;
-    hid_t             tid  = -1;
-    hid_t             dcpl = -1;
-    hid_t             msid = -1;
-    H5D_chunk_index_t idx_type;
-    const hsize_t     shape[1]    = {8};
-    const hsize_t     maxshape[1] = {64};
-    const hsize_t     chunk[1]    = {8};
-    const int         buffer[8]   = {0, 1, 2, 3, 4, 5, 6, 7};
-    H5O_info2_t       info;
-
-    TESTING("Fixed array chunk index header flush dependencies handled correctly");
-
-    /* Skip this test if SWMR I/O is not supported for the VFD specified
-     * by the environment variable.
-     */
-    if (!H5FD__supports_swmr_test(env_h5_driver)) {
-        SKIPPED();
-        HDputs("    Test skipped due to VFD not supporting SWMR I/O.");
-        return SUCCEED;
+    char     filename[FILENAME_BUF_SIZE];
+    hid_t    fid  = -1;                     /* File ID */
+    hid_t    dcpl = -1;                     /* Dataset creation property list ID */
+    hid_t    dapl = -1;                     /* Dataset access property list ID */
+    hid_t    dxpl = -1;                     /* Dataset transfer property list ID */
+    hid_t    sid  = -1;                     /* Dataspace ID */
+    hid_t    mid  = -1;                     /* Memory dataspace ID */
+    hid_t    did  = -1;                     /* Dataset ID */
+    hsize_t  dims[2]  = {FILTER_NTHREADS_DIM, FILTER_NTHREADS_DIM};
+    hsize_t  cdims[2] = {FILTER_NTHREADS_CHUNK, FILTER_NTHREADS_CHUNK};
+    hsize_t  start[2], count[2];            /* Hyperslab selection */
+    int     *wbuf = NULL;                   /* Write buffer */
+    int     *rbuf = NULL;                   /* Read buffer */
+    unsigned nthreads;                      /* Number of filter threads */
+    unsigned partial;                       /* Partial edge chunk and chunk cache options */
+    unsigned cache;                         /* Whether the chunk cache is enabled */
+    size_t   cache_nbytes;                  /* Size of the chunk cache for writing */
+    size_t   i, j;                          /* Local index variables */
+    herr_t   status;                        /* Error status */
+
+    TESTING("filtering chunks on several threads");
+
+    h5_fixname(FILENAME[29], fapl, filename, sizeof filename);
+
+    if (NULL == (wbuf = (int *)HDmalloc(FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (rbuf = (int *)HDmalloc(FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM * sizeof(int))))
+        TEST_ERROR;
+    for (i = 0; i < FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM; i++)
+        wbuf[i] = (int)(i % 1000);
+
+    /* Check the property */
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pget_filter_nthreads(dxpl, &nthreads) < 0)
+        FAIL_STACK_ERROR;
+    if (nthreads != 1)
+        FAIL_PUTS_ERROR("    Wrong default number of filter threads.");
+    H5E_BEGIN_TRY
+    {
+        status = H5Pset_filter_nthreads(dxpl, 0);
     }
-
-    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+    H5E_END_TRY
+    if (status >= 0)
+        FAIL_PUTS_ERROR("    Zero filter threads should be rejected.");
+    if (H5Pset_filter_nthreads(dxpl, 4) < 0)
         FAIL_STACK_ERROR;
-    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
+    if (H5Pget_filter_nthreads(dxpl, &nthreads) < 0)
         FAIL_STACK_ERROR;
+    if (nthreads != 4)
+        FAIL_PUTS_ERROR("    Wrong number of filter threads.");
 
-    h5_fixname(FILENAME[20], fapl, filename, sizeof(filename));
     if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create a chunked dataset with fixed dimensions */
-    if ((sid = H5Screate_simple(1, shape, maxshape)) < 0)
-        FAIL_STACK_ERROR;
-    if ((tid = H5Tcopy(H5T_NATIVE_INT32)) < 0)
-        FAIL_STACK_ERROR;
-    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_chunk(dcpl, 1, chunk) < 0)
-        FAIL_STACK_ERROR;
-    if ((did = H5Dcreate2(fid, DSET_FARRAY_HDR_FD, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+    if ((sid = H5Screate_simple(2, dims, NULL)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Verify the chunk index type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
-        FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_FARRAY)
-        FAIL_PUTS_ERROR("should be using fixed array as index");
+    for (partial = 0; partial < 4; partial++) {
+        char dset_name[32];
 
-    if (H5Dclose(did) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pclose(dcpl) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(tid) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Sclose(sid) < 0)
-        FAIL_STACK_ERROR;
+        /* Create a dataset with several filters */
+        if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Pset_chunk(dcpl, 2, cdims) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Pset_shuffle(dcpl) < 0)
+            FAIL_STACK_ERROR;
+#ifdef H5_HAVE_FILTER_DEFLATE
+        if (H5Pset_deflate(dcpl, 6) < 0)
+            FAIL_STACK_ERROR;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+        if (H5Pset_fletcher32(dcpl) < 0)
+            FAIL_STACK_ERROR;
+        if ((partial & 1) && H5Pset_chunk_opts(dcpl, H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS) < 0)
+            FAIL_STACK_ERROR;
 
-    if (H5Fstart_swmr_write(fid) < 0)
-        FAIL_STACK_ERROR;
+        /* Write the dataset with the filters run on several threads, either
+         * when the chunks are evicted from a small chunk cache or when they
+         * are flushed from a large one */
+        if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+            FAIL_STACK_ERROR;
+        if (partial & 2)
+            cache_nbytes = (size_t)(1024 * 1024);
+        else
+            cache_nbytes = (size_t)(5 * FILTER_NTHREADS_CHUNK * FILTER_NTHREADS_CHUNK) * sizeof(int);
+        if (H5Pset_chunk_cache(dapl, (size_t)521, cache_nbytes, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+            FAIL_STACK_ERROR;
 
-    /* Write data to the dataset */
-    if ((did = H5Dopen2(fid, DSET_FARRAY_HDR_FD, H5P_DEFAULT)) < 0)
-        FAIL_STACK_ERROR;
-    if ((tid = H5Dget_type(did)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Dwrite(did, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Dclose(did) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Tclose(tid) < 0)
-        FAIL_STACK_ERROR;
+        HDsnprintf(dset_name, sizeof(dset_name), "dset_%u", partial);
+        if ((did = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dclose(did) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Pclose(dapl) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Pclose(dcpl) < 0)
+            FAIL_STACK_ERROR;
 
-    /* The second call triggered a bug in the library (JIRA issue: SWMR-95) */
-    if (H5Oget_info_by_name3(fid, DSET_FARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Oget_info_by_name3(fid, DSET_FARRAY_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
-        FAIL_STACK_ERROR;
+        for (cache = 0; cache < 2; cache++) {
+            /* Open the dataset with the chunk cache disabled or enabled */
+            if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+                FAIL_STACK_ERROR;
+            if (H5Pset_chunk_cache(dapl, (size_t)521, cache ? (size_t)(1024 * 1024) : (size_t)0,
+                                   H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+                FAIL_STACK_ERROR;
+            if ((did = H5Dopen2(fid, dset_name, dapl)) < 0)
+                FAIL_STACK_ERROR;
 
-    if (H5Pclose(fapl) < 0)
+            /* Read the whole dataset */
+            HDmemset(rbuf, 0, FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM * sizeof(int));
+            if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+                FAIL_STACK_ERROR;
+            for (i = 0; i < FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM; i++)
+                if (rbuf[i] != wbuf[i])
+                    FAIL_PUTS_ERROR("    Wrong data read for whole dataset.");
+
+            /* Read it again, to use chunks in the cache */
+            HDmemset(rbuf, 0, FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM * sizeof(int));
+            if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0)
+                FAIL_STACK_ERROR;
+            for (i = 0; i < FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM; i++)
+                if (rbuf[i] != wbuf[i])
+                    FAIL_PUTS_ERROR("    Wrong data read for whole dataset from cache.");
+
+            /* Read a hyperslab that crosses chunk boundaries and partial edge chunks */
+            start[0] = 7;
+            start[1] = 13;
+            count[0] = FILTER_NTHREADS_DIM - start[0];
+            count[1] = FILTER_NTHREADS_DIM - start[1] - 3;
+            if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+                FAIL_STACK_ERROR;
+            if ((mid = H5Screate_simple(2, count, NULL)) < 0)
+                FAIL_STACK_ERROR;
+            HDmemset(rbuf, 0, FILTER_NTHREADS_DIM * FILTER_NTHREADS_DIM * sizeof(int));
+            if (H5Dread(did, H5T_NATIVE_INT, mid, sid, dxpl, rbuf) < 0)
+                FAIL_STACK_ERROR;
+            for (i = 0; i < count[0]; i++)
+                for (j = 0; j < count[1]; j++)
+                    if (rbuf[i * count[1] + j] !=
+                        wbuf[(start[0] + i) * FILTER_NTHREADS_DIM + start[1] + j])
+                        FAIL_PUTS_ERROR("    Wrong data read for hyperslab.");
+            if (H5Sclose(mid) < 0)
+                FAIL_STACK_ERROR;
+            if (H5Sselect_all(sid) < 0)
+                FAIL_STACK_ERROR;
+
+            if (H5Dclose(did) < 0)
+                FAIL_STACK_ERROR;
+            if (H5Pclose(dapl) < 0)
+                FAIL_STACK_ERROR;
+        } /* end for */
+    }     /* end for */
+
+    /* Closing */
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dxpl) < 0)
         FAIL_STACK_ERROR;
     if (H5Fclose(fid) < 0)
-        TEST_ERROR;
+        FAIL_STACK_ERROR;
+
+    HDfree(wbuf);
+    HDfree(rbuf);
 
     PASSED();
 
@@ -12490,125 +14115,182 @@ test_farray_hdr_fd(const char *env_h5_driver, hid_t fapl)
 error:
     H5E_BEGIN_TRY
     {
-        H5Pclose(fapl);
-        H5Fclose(fid);
-        H5Dclose(did);
         H5Pclose(dcpl);
-        H5Tclose(tid);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Dclose(did);
+        H5Sclose(mid);
         H5Sclose(sid);
-        H5Sclose(msid);
+        H5Fclose(fid);
     }
     H5E_END_TRY
+    HDfree(wbuf);
+    HDfree(rbuf);
     return FAIL;
-} /* end test_farray_hdr_fd() */
+} /* end test_filter_nthreads() */
 
 /*-------------------------------------------------------------------------
- * Function: test_bt2_hdr_fd
+ * Function:    test_filter_nthreads_flush
  *
- * Purpose: Tests that version 2 B-tree header flush dependencies
- *          are created and torn down correctly when used as a
- *          chunk index.
+ * Purpose:     Tests that dirty chunks evicted from the chunk cache by
+ *              writes that run the filter pipeline on several threads
+ *              (H5Pset_filter_nthreads), and then flushed, are stored
+ *              with the right data, size and filter mask.
  *
  * Return:      Success: 0
  *              Failure: -1
  *
  *-------------------------------------------------------------------------
  */
+#define FILTER_NTHREADS_FLUSH_DIM   70
+#define FILTER_NTHREADS_FLUSH_CHUNK 16
 static herr_t
-test_bt2_hdr_fd(const char *env_h5_driver, hid_t fapl)
+test_filter_nthreads_flush(hid_t fapl)
 {
-    char              filename[FILENAME_BUF_SIZE];
-    hid_t             fid  = -1;
-    hid_t             sid  = -1;
-    hid_t             did  = -1;
-    hid_t             tid  = -1;
-    hid_t             dcpl = -1;
-    hid_t             msid = -1;
-    H5D_chunk_index_t idx_type;
-    const hsize_t     shape[2]     = {8, 8};
-    const hsize_t     maxshape[2]  = {H5S_UNLIMITED, H5S_UNLIMITED};
-    const hsize_t     chunk[2]     = {8, 8};
-    const int         buffer[8][8] = {{0, 1, 2, 3, 4, 5, 6, 7},         {8, 9, 10, 11, 12, 13, 14, 15},
-                              {16, 17, 18, 19, 20, 21, 22, 23}, {24, 25, 26, 27, 28, 29, 30, 31},
-                              {32, 33, 34, 35, 36, 37, 38, 39}, {40, 41, 42, 43, 44, 45, 46, 47},
-                              {48, 49, 50, 51, 52, 53, 54, 55}, {56, 57, 58, 59, 60, 61, 62, 63}};
-    H5O_info2_t       info;
-
-    TESTING("Version 2 B-tree chunk index header flush dependencies handled correctly");
-
-    /* Initialize struct */
-    HDmemset(&info, 0, sizeof(info));
-
-    /* Skip this test if SWMR I/O is not supported for the VFD specified
-     * by the environment variable.
-     */
-    if (!H5FD__supports_swmr_test(env_h5_driver)) {
-        SKIPPED();
-        HDputs("    Test skipped due to VFD not supporting SWMR I/O.");
-        return SUCCEED;
-    }
-
-    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
-        FAIL_STACK_ERROR;
-    if (H5Pset_libver_bounds(fapl, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0)
-        FAIL_STACK_ERROR;
+    char     filename[FILENAME_BUF_SIZE];
+    hid_t    fid  = -1; /* File ID */
+    hid_t    dcpl = -1; /* Dataset creation property list ID */
+    hid_t    dapl = -1; /* Dataset access property list ID */
+    hid_t    dxpl = -1; /* Dataset transfer property list ID */
+    hid_t    sid  = -1; /* Dataspace ID */
+    hid_t    mid  = -1; /* Memory dataspace ID */
+    hid_t    did  = -1; /* Dataset ID */
+    hsize_t  dims[2]  = {FILTER_NTHREADS_FLUSH_DIM, FILTER_NTHREADS_FLUSH_DIM};
+    hsize_t  cdims[2] = {FILTER_NTHREADS_FLUSH_CHUNK, FILTER_NTHREADS_FLUSH_CHUNK};
+    hsize_t  start[2], count[2];  /* Hyperslab selection */
+    hsize_t  offset[2];           /* Chunk offset */
+    hsize_t  nchunks;             /* Number of chunks in the file */
+    hsize_t  chunk_size;          /* Size of a stored chunk */
+    haddr_t  chunk_addr;          /* Address of a stored chunk */
+    unsigned filter_mask;         /* Filter mask of a stored chunk */
+    hbool_t  edge;                /* Whether a chunk is a partial edge chunk */
+    int     *wbuf = NULL;         /* Write buffer */
+    int     *rbuf = NULL;         /* Read buffer */
+    size_t   i, j;                /* Local index variables */
+
+    TESTING("flushing chunks filtered on several threads");
+
+    h5_fixname(FILENAME[36], fapl, filename, sizeof filename);
+
+    if (NULL == (wbuf = (int *)HDmalloc(FILTER_NTHREADS_FLUSH_DIM * FILTER_NTHREADS_FLUSH_DIM * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (rbuf = (int *)HDmalloc(FILTER_NTHREADS_FLUSH_DIM * FILTER_NTHREADS_FLUSH_DIM * sizeof(int))))
+        TEST_ERROR;
+    for (i = 0; i < FILTER_NTHREADS_FLUSH_DIM * FILTER_NTHREADS_FLUSH_DIM; i++)
+        wbuf[i] = (int)(i % 1000);
 
-    h5_fixname(FILENAME[21], fapl, filename, sizeof(filename));
     if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
+    if ((sid = H5Screate_simple(2, dims, NULL)) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Create a chunked dataset with fixed dimensions */
-    if ((sid = H5Screate_simple(2, shape, maxshape)) < 0)
+    /* Create a dataset with several filters, whose partial edge chunks are
+     * stored unfiltered */
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
         FAIL_STACK_ERROR;
-    if ((tid = H5Tcopy(H5T_NATIVE_INT32)) < 0)
+    if (H5Pset_chunk(dcpl, 2, cdims) < 0)
         FAIL_STACK_ERROR;
-    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+    if (H5Pset_shuffle(dcpl) < 0)
         FAIL_STACK_ERROR;
-    if (H5Pset_chunk(dcpl, 2, chunk) < 0)
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if (H5Pset_deflate(dcpl, 6) < 0)
         FAIL_STACK_ERROR;
-    if ((did = H5Dcreate2(fid, DSET_BT2_HDR_FD, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if (H5Pset_fletcher32(dcpl) < 0)
         FAIL_STACK_ERROR;
-
-    /* Verify the chunk index type */
-    if (H5D__layout_idx_type_test(did, &idx_type) < 0)
+    if (H5Pset_chunk_opts(dcpl, H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS) < 0)
         FAIL_STACK_ERROR;
-    if (idx_type != H5D_CHUNK_IDX_BT2)
-        FAIL_PUTS_ERROR("should be using fixed array as index");
 
-    if (H5Dclose(did) < 0)
+    /* The chunk cache holds six chunks, so writing the dataset evicts dirty
+     * chunks in batches */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Pclose(dcpl) < 0)
+    if (H5Pset_chunk_cache(dapl, (size_t)521,
+                           (size_t)(6 * FILTER_NTHREADS_FLUSH_CHUNK * FILTER_NTHREADS_FLUSH_CHUNK) * sizeof(int),
+                           H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tclose(tid) < 0)
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Sclose(sid) < 0)
+    if (H5Pset_filter_nthreads(dxpl, 4) < 0)
         FAIL_STACK_ERROR;
 
-    if (H5Fstart_swmr_write(fid) < 0)
+    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dflush(did) < 0)
         FAIL_STACK_ERROR;
 
-    /* Write data to the dataset */
-    if ((did = H5Dopen2(fid, DSET_BT2_HDR_FD, H5P_DEFAULT)) < 0)
+    /* Dirty several chunks again, across chunk boundaries and partial edge
+     * chunks, and flush them */
+    start[0] = 5;
+    start[1] = 9;
+    count[0] = FILTER_NTHREADS_FLUSH_DIM - start[0];
+    count[1] = 3 * FILTER_NTHREADS_FLUSH_CHUNK;
+    for (i = 0; i < count[0]; i++)
+        for (j = 0; j < count[1]; j++)
+            wbuf[(start[0] + i) * FILTER_NTHREADS_FLUSH_DIM + start[1] + j] = -(int)(i * count[1] + j);
+    if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
         FAIL_STACK_ERROR;
-    if ((tid = H5Dget_type(did)) < 0)
+    if ((mid = H5Screate_simple(2, count, NULL)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dwrite(did, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) < 0)
+    for (i = 0; i < count[0]; i++)
+        for (j = 0; j < count[1]; j++)
+            rbuf[i * count[1] + j] = wbuf[(start[0] + i) * FILTER_NTHREADS_FLUSH_DIM + start[1] + j];
+    if (H5Dwrite(did, H5T_NATIVE_INT, mid, sid, dxpl, rbuf) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(did) < 0)
+    if (H5Sclose(mid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Tclose(tid) < 0)
+    if (H5Sselect_all(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dflush(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
 
-    /* The second call triggered a bug in the library (JIRA issue: SWMR-95) */
-    if (H5Oget_info_by_name3(fid, DSET_BT2_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+    /* Check the data */
+    if ((did = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Oget_info_by_name3(fid, DSET_BT2_HDR_FD, &info, H5O_INFO_BASIC, H5P_DEFAULT) < 0)
+    HDmemset(rbuf, 0, FILTER_NTHREADS_FLUSH_DIM * FILTER_NTHREADS_FLUSH_DIM * sizeof(int));
+    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
         FAIL_STACK_ERROR;
+    for (i = 0; i < FILTER_NTHREADS_FLUSH_DIM * FILTER_NTHREADS_FLUSH_DIM; i++)
+        if (rbuf[i] != wbuf[i])
+            FAIL_PUTS_ERROR("    Wrong data read.");
 
-    if (H5Pclose(fapl) < 0)
+    /* Check that every chunk was stored with all its filters applied, and
+     * the partial edge chunks without any */
+    if (H5Dget_num_chunks(did, sid, &nchunks) < 0)
+        FAIL_STACK_ERROR;
+    if (nchunks != 25)
+        FAIL_PUTS_ERROR("    Wrong number of chunks.");
+    for (i = 0; i < (size_t)nchunks; i++) {
+        if (H5Dget_chunk_info(did, sid, (hsize_t)i, offset, &filter_mask, &chunk_addr, &chunk_size) < 0)
+            FAIL_STACK_ERROR;
+        if (filter_mask != 0)
+            FAIL_PUTS_ERROR("    Wrong filter mask for chunk.");
+        edge = (offset[0] + FILTER_NTHREADS_FLUSH_CHUNK > FILTER_NTHREADS_FLUSH_DIM) ||
+               (offset[1] + FILTER_NTHREADS_FLUSH_CHUNK > FILTER_NTHREADS_FLUSH_DIM);
+        if (edge != (chunk_size == FILTER_NTHREADS_FLUSH_CHUNK * FILTER_NTHREADS_FLUSH_CHUNK * sizeof(int)))
+            FAIL_PUTS_ERROR("    Chunk stored with the wrong filters.");
+    } /* end for */
+
+    /* Closing */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dxpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
         FAIL_STACK_ERROR;
     if (H5Fclose(fid) < 0)
-        TEST_ERROR;
+        FAIL_STACK_ERROR;
+
+    HDfree(wbuf);
+    HDfree(rbuf);
 
     PASSED();
 
@@ -12617,491 +14299,905 @@ test_bt2_hdr_fd(const char *env_h5_driver, hid_t fapl)
 error:
     H5E_BEGIN_TRY
     {
-        H5Pclose(fapl);
-        H5Fclose(fid);
-        H5Dclose(did);
         H5Pclose(dcpl);
-        H5Tclose(tid);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Dclose(did);
+        H5Sclose(mid);
         H5Sclose(sid);
-        H5Sclose(msid);
+        H5Fclose(fid);
     }
     H5E_END_TRY
+    HDfree(wbuf);
+    HDfree(rbuf);
     return FAIL;
-} /* end test_bt2_hdr_fd() */
+} /* end test_filter_nthreads_flush() */
 
 /*-------------------------------------------------------------------------
- * Function: test_storage_size
+ * Function:    test_chunk_cache_sets
  *
- * Purpose:     Tests results from querying the storage size of a dataset,
- *              before/after extending the dimensions.
+ * Purpose:     Tests that chunks don't evict each other from the chunk
+ *              cache when they hash to the same place, as long as the
+ *              cache has room for them, even with a single slot requested.
  *
  * Return:      Success: 0
  *              Failure: -1
  *
- * Programmer:  Quincey Koziol
- *              Monday, April 11, 2016
- *
  *-------------------------------------------------------------------------
  */
+#define CACHE_SETS_NCHUNKS 16
+#define CACHE_SETS_CHUNK   100
 static herr_t
-test_storage_size(hid_t fapl)
+test_chunk_cache_sets(hid_t fapl)
 {
     char    filename[FILENAME_BUF_SIZE];
-    hid_t   fid  = -1;             /* File ID */
-    hid_t   dcpl = -1, dcpl2 = -1; /* Dataset creation property list IDs */
-    hid_t   sid  = -1;             /* Dataspace ID */
-    hid_t   dsid = -1;             /* Dataset ID */
-    hsize_t dims[2], max_dims[2];  /* Dataset dimensions */
-    hsize_t new_dims[2];           /* New dataset dimensions */
-    hsize_t chunk_dims[2];         /* Chunk dimensions */
-    int     wdata[STORAGE_SIZE_DIM1][STORAGE_SIZE_DIM2];
-    hsize_t ssize; /* Dataset storage size */
+    hid_t   fid  = -1; /* File ID */
+    hid_t   dcpl = -1; /* Dataset creation property list ID */
+    hid_t   dapl = -1; /* Dataset access property list ID */
+    hid_t   sid  = -1; /* Dataspace ID */
+    hid_t   mid  = -1; /* Memory dataspace ID */
+    hid_t   did  = -1; /* Dataset ID */
+    hsize_t dim       = CACHE_SETS_NCHUNKS * CACHE_SETS_CHUNK;
+    hsize_t chunk_dim = CACHE_SETS_CHUNK;
+    hsize_t one       = 1;
+    hsize_t offset;      /* Element to write */
+    int     value;       /* Value to write */
+    int    *rbuf = NULL; /* Read buffer */
+    int     pass, i;     /* Local index variables */
 
-    TESTING("querying storage size");
+    TESTING("chunks sharing a chunk cache hash value");
 
-    h5_fixname(FILENAME[22], fapl, filename, sizeof filename);
+    h5_fixname(FILENAME[30], fapl, filename, sizeof filename);
+
+    if (NULL == (rbuf = (int *)HDmalloc((size_t)dim * sizeof(int))))
+        TEST_ERROR;
 
-    /* Create file */
     if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create dataset creation property list */
-    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+    /* Register byte-counting filter */
+    if (H5Zregister(H5Z_COUNT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Set chunk size */
-    chunk_dims[0] = STORAGE_SIZE_CHUNK_DIM1;
-    chunk_dims[1] = STORAGE_SIZE_CHUNK_DIM2;
-    if (H5Pset_chunk(dcpl, 2, chunk_dims) < 0)
+    if ((sid = H5Screate_simple(1, &dim, NULL)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Copy the DCPL, and set it to early allocation */
-    if ((dcpl2 = H5Pcopy(dcpl)) < 0)
+    if ((mid = H5Screate_simple(1, &one, NULL)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Pset_alloc_time(dcpl2, H5D_ALLOC_TIME_EARLY) < 0)
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create 2D dataspace, with max dims same as current dimensions */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = STORAGE_SIZE_DIM1;
-    max_dims[1] = STORAGE_SIZE_DIM2;
-    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+    if (H5Pset_chunk(dcpl, 1, &chunk_dim) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0U, (size_t)0, NULL) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create chunked dataset */
-    if ((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+    /* Ask for a single slot, with room for all the chunks */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk_cache(dapl, (size_t)1, (size_t)dim * sizeof(int), 0.0) < 0)
         FAIL_STACK_ERROR;
 
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
+    /* Reset byte counts */
+    count_nbytes_read    = (size_t)0;
+    count_nbytes_written = (size_t)0;
 
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Write one element to each chunk in turn, twice */
+    for (pass = 0; pass < 2; pass++)
+        for (i = 0; i < CACHE_SETS_NCHUNKS; i++) {
+            offset = (hsize_t)(i * CACHE_SETS_CHUNK + pass);
+            value  = i * 10 + pass;
+            if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &one, NULL) < 0)
+                FAIL_STACK_ERROR;
+            if (H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, &value) < 0)
+                FAIL_STACK_ERROR;
+        } /* end for */
+
+    /* All chunks should still be in the cache */
+    if (count_nbytes_read != (size_t)0 || count_nbytes_written != (size_t)0)
+        FAIL_PUTS_ERROR("    Chunks were evicted from the cache while it had room for them.");
+
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Close dataset & dataspace */
-    if (H5Sclose(sid) < 0)
+    /* Each chunk should have been written once, when the dataset was closed */
+    if (count_nbytes_read != (size_t)0)
+        FAIL_PUTS_ERROR("    Chunks were read back from the file.");
+    if (count_nbytes_written != (size_t)dim * sizeof(int))
+        FAIL_PUTS_ERROR("    Chunks were written more than once.");
+
+    /* Check the data */
+    if ((did = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
         FAIL_STACK_ERROR;
+    for (i = 0; i < CACHE_SETS_NCHUNKS; i++)
+        if (rbuf[i * CACHE_SETS_CHUNK] != i * 10 || rbuf[i * CACHE_SETS_CHUNK + 1] != i * 10 + 1)
+            FAIL_PUTS_ERROR("    Wrong data read.");
 
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset", fid, "dset_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
-
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset_copy", H5P_DEFAULT)) < 0)
+    if (H5Pclose(dapl) < 0)
         FAIL_STACK_ERROR;
-
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if (H5Pclose(dcpl) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
-
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+    if (H5Sclose(mid) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create 2D dataspace with max dims > current dims (but not unlimited) */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = STORAGE_SIZE_MAX_DIM1;
-    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
-    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+    if (H5Sclose(sid) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create chunked dataset */
-    if ((dsid = H5Dcreate2(fid, "dset2", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+    if (H5Fclose(fid) < 0)
         FAIL_STACK_ERROR;
 
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
+    HDfree(rbuf);
 
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
-        FAIL_STACK_ERROR;
+    PASSED();
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
-        FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    return SUCCEED;
 
-    /* Extend dataset's dimensions */
-    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
-    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
-    if (H5Dset_extent(dsid, new_dims) < 0)
-        FAIL_STACK_ERROR;
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    }
+    H5E_END_TRY
+    HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_cache_sets() */
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+/*-------------------------------------------------------------------------
+ * Function:    test_file_chunk_cache
+ *
+ * Purpose:     Tests that the datasets of a file share the file-wide chunk
+ *              cache, and that the least recently used chunks of the file
+ *              are preempted, whichever dataset they belong to.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FILE_CACHE_NCHUNKS 16
+#define FILE_CACHE_CHUNK   100
+#define FILE_CACHE_NCACHED 8
+static herr_t
+test_file_chunk_cache(hid_t fapl)
+{
+    char     filename[FILENAME_BUF_SIZE];
+    hid_t    my_fapl = -1; /* File access property list ID */
+    hid_t    fid     = -1; /* File ID */
+    hid_t    dcpl    = -1; /* Dataset creation property list ID */
+    hid_t    sid     = -1; /* Dataspace ID */
+    hid_t    mid     = -1; /* Memory dataspace ID */
+    hid_t    did_a   = -1; /* Dataset ID */
+    hid_t    did_b   = -1; /* Dataset ID */
+    hsize_t  dim       = FILE_CACHE_NCHUNKS * FILE_CACHE_CHUNK;
+    hsize_t  chunk_dim = FILE_CACHE_CHUNK;
+    hsize_t  one       = 1;
+    size_t   chunk_nbytes = FILE_CACHE_CHUNK * sizeof(int);
+    size_t   nbytes;      /* Size of the file-wide cache */
+    size_t   nbytes_used; /* Bytes used in a chunk cache */
+    int      nused;       /* Number of chunks in a dataset's chunk cache */
+    unsigned nrefs;       /* Number of datasets sharing the file-wide cache */
+    hsize_t  offset;      /* Element to write */
+    int      value;       /* Value to write */
+    int     *rbuf = NULL; /* Read buffer */
+    int      i;           /* Local index variable */
+
+    TESTING("chunk cache shared by the datasets of a file");
+
+    h5_fixname(FILENAME[31], fapl, filename, sizeof filename);
+
+    if (NULL == (rbuf = (int *)HDmalloc((size_t)dim * sizeof(int))))
+        TEST_ERROR;
+
+    /* Set up a file-wide cache with room for a few chunks */
+    if ((my_fapl = H5Pcopy(fapl)) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
-
-    /* Close dataset & dataspace */
-    if (H5Sclose(sid) < 0)
+    if (H5Pget_file_chunk_cache(my_fapl, &nbytes) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if (nbytes != 0)
+        FAIL_PUTS_ERROR("    Wrong default file-wide chunk cache size.");
+    if (H5Pset_file_chunk_cache(my_fapl, FILE_CACHE_NCACHED * chunk_nbytes) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pget_file_chunk_cache(my_fapl, &nbytes) < 0)
         FAIL_STACK_ERROR;
+    if (nbytes != FILE_CACHE_NCACHED * chunk_nbytes)
+        FAIL_PUTS_ERROR("    Wrong file-wide chunk cache size.");
 
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset2", fid, "dset2_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset2_copy", H5P_DEFAULT)) < 0)
+    /* Register byte-counting filter */
+    if (H5Zregister(H5Z_COUNT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if ((sid = H5Screate_simple(1, &dim, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    if ((mid = H5Screate_simple(1, &one, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dcpl, 1, &chunk_dim) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0U, (size_t)0, NULL) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+    /* Reset byte counts */
+    count_nbytes_read    = (size_t)0;
+    count_nbytes_written = (size_t)0;
+
+    if ((did_a = H5Dcreate2(fid, "dset_a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    if ((did_b = H5Dcreate2(fid, "dset_b", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create 2D dataspace with max dims > current dims (but not unlimited) */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = STORAGE_SIZE_MAX_DIM1;
-    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
-    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+    /* Fill the whole file-wide cache with chunks of the first dataset, then
+     * use its first chunk again */
+    for (i = 0; i <= FILE_CACHE_NCACHED; i++) {
+        offset = (hsize_t)((i % FILE_CACHE_NCACHED) * FILE_CACHE_CHUNK);
+        value  = i % FILE_CACHE_NCACHED;
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &one, NULL) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dwrite(did_a, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, &value) < 0)
+            FAIL_STACK_ERROR;
+    } /* end for */
+    if (count_nbytes_written != (size_t)0)
+        FAIL_PUTS_ERROR("    Chunks were evicted from the cache while it had room for them.");
+    if (H5D__current_cache_size_test(did_a, &nbytes_used, &nused) < 0)
+        FAIL_STACK_ERROR;
+    if (nbytes_used != FILE_CACHE_NCACHED * chunk_nbytes || nused != FILE_CACHE_NCACHED)
+        FAIL_PUTS_ERROR("    Wrong chunk cache usage for the first dataset.");
+    if (H5D__file_cache_size_test(did_a, &nbytes_used, &nrefs) < 0)
+        FAIL_STACK_ERROR;
+    if (nbytes_used != FILE_CACHE_NCACHED * chunk_nbytes || nrefs != 2)
+        FAIL_PUTS_ERROR("    Wrong file-wide chunk cache usage.");
+
+    /* Write to a few chunks of the second dataset, which should evict the
+     * least recently used chunks of the first one */
+    for (i = 0; i < FILE_CACHE_NCACHED / 2; i++) {
+        offset = (hsize_t)(i * FILE_CACHE_CHUNK);
+        value  = 100 + i;
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &one, NULL) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dwrite(did_b, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, &value) < 0)
+            FAIL_STACK_ERROR;
+    } /* end for */
+    if (count_nbytes_written != (FILE_CACHE_NCACHED / 2) * chunk_nbytes)
+        FAIL_PUTS_ERROR("    The file-wide chunk cache wasn't shared by the datasets.");
+    if (H5D__current_cache_size_test(did_a, &nbytes_used, &nused) < 0)
+        FAIL_STACK_ERROR;
+    if (nbytes_used != (FILE_CACHE_NCACHED / 2) * chunk_nbytes || nused != FILE_CACHE_NCACHED / 2)
+        FAIL_PUTS_ERROR("    Wrong chunk cache usage for the first dataset.");
+    if (H5D__current_cache_size_test(did_b, &nbytes_used, &nused) < 0)
+        FAIL_STACK_ERROR;
+    if (nbytes_used != (FILE_CACHE_NCACHED / 2) * chunk_nbytes || nused != FILE_CACHE_NCACHED / 2)
+        FAIL_PUTS_ERROR("    Wrong chunk cache usage for the second dataset.");
+    if (H5D__file_cache_size_test(did_b, &nbytes_used, &nrefs) < 0)
         FAIL_STACK_ERROR;
+    if (nbytes_used != FILE_CACHE_NCACHED * chunk_nbytes || nrefs != 2)
+        FAIL_PUTS_ERROR("    Wrong file-wide chunk cache usage.");
 
-    /* Create chunked dataset, w/early allocation */
-    if ((dsid = H5Dcreate2(fid, "dset2a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT)) < 0)
+    /* The first chunk of the first dataset was used recently, and should
+     * still be cached */
+    offset = 0;
+    value  = 0;
+    if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &one, NULL) < 0)
         FAIL_STACK_ERROR;
-
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
-
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+    if (H5Dwrite(did_a, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, &value) < 0)
         FAIL_STACK_ERROR;
+    if (count_nbytes_read != (size_t)0)
+        FAIL_PUTS_ERROR("    The most recently used chunk was evicted.");
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if (H5Dclose(did_a) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
-
-    /* Extend dataset's dimensions */
-    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
-    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
-    if (H5Dset_extent(dsid, new_dims) < 0)
+    if (H5Dclose(did_b) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
-        FAIL_STACK_ERROR;
-    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    /* Each chunk should have been written once */
+    if (count_nbytes_read != (size_t)0)
+        FAIL_PUTS_ERROR("    Chunks were read back from the file.");
+    if (count_nbytes_written != (FILE_CACHE_NCACHED + FILE_CACHE_NCACHED / 2) * chunk_nbytes)
+        FAIL_PUTS_ERROR("    Chunks were written more than once.");
 
-    /* Close dataset & dataspace */
-    if (H5Sclose(sid) < 0)
+    /* Check the data */
+    if ((did_a = H5Dopen2(fid, "dset_a", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if (H5Dread(did_a, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
         FAIL_STACK_ERROR;
-
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset2a", fid, "dset2a_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+    for (i = 0; i < FILE_CACHE_NCACHED; i++)
+        if (rbuf[i * FILE_CACHE_CHUNK] != i)
+            FAIL_PUTS_ERROR("    Wrong data read.");
+    if (H5Dclose(did_a) < 0)
         FAIL_STACK_ERROR;
-
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset2a_copy", H5P_DEFAULT)) < 0)
+    if ((did_b = H5Dopen2(fid, "dset_b", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if (H5Dread(did_b, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
-
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+    for (i = 0; i < FILE_CACHE_NCACHED / 2; i++)
+        if (rbuf[i * FILE_CACHE_CHUNK] != 100 + i)
+            FAIL_PUTS_ERROR("    Wrong data read.");
+    if (H5Dclose(did_b) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create 2D dataspace with max dims > current dims (and 1 unlimited dim) */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = H5S_UNLIMITED;
-    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
-    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+    if (H5Pclose(dcpl) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create chunked dataset */
-    if ((dsid = H5Dcreate2(fid, "dset3", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+    if (H5Sclose(mid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(my_fapl) < 0)
         FAIL_STACK_ERROR;
 
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
+    HDfree(rbuf);
 
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
-        FAIL_STACK_ERROR;
+    PASSED();
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
-        FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    return SUCCEED;
 
-    /* Extend dataset's dimensions */
-    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
-    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
-    if (H5Dset_extent(dsid, new_dims) < 0)
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(dcpl);
+        H5Dclose(did_a);
+        H5Dclose(did_b);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+        H5Pclose(my_fapl);
+    }
+    H5E_END_TRY
+    HDfree(rbuf);
+    return FAIL;
+} /* end test_file_chunk_cache() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_prefetch
+ *
+ * Purpose:     Tests that the chunks following a sequential scan over
+ *              several H5Dread calls are read ahead into the chunk cache,
+ *              that each chunk is still only read once, and that chunks
+ *              read ahead and never used are counted as wasted.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define PREFETCH_NCHUNKS 16
+#define PREFETCH_CHUNK   100
+#define PREFETCH_DEPTH   3
+static herr_t
+test_chunk_prefetch(hid_t fapl)
+{
+    char     filename[FILENAME_BUF_SIZE];
+    hid_t    fid          = -1; /* File ID */
+    hid_t    dcpl         = -1; /* Dataset creation property list ID */
+    hid_t    dapl         = -1; /* Dataset access property list ID */
+    hid_t    sid          = -1; /* Dataspace ID */
+    hid_t    mid          = -1; /* Memory dataspace ID */
+    hid_t    did          = -1; /* Dataset ID */
+    hsize_t  dim          = PREFETCH_NCHUNKS * PREFETCH_CHUNK;
+    hsize_t  chunk_dim    = PREFETCH_CHUNK;
+    size_t   chunk_nbytes = PREFETCH_CHUNK * sizeof(int);
+    hsize_t  offset;                /* Start of chunk to read */
+    unsigned depth;                 /* Read-ahead depth */
+    unsigned nprefetches;           /* Number of chunks read ahead */
+    unsigned nhits;                 /* Number of chunks read ahead, then accessed */
+    unsigned nwasted;               /* Number of chunks read ahead, then evicted unused */
+    int     *buf = NULL;            /* Data buffer */
+    int      rbuf[PREFETCH_CHUNK];  /* Read buffer for a chunk */
+    int      i, j;                  /* Local index variables */
+
+    TESTING("reading ahead of sequential chunk reads");
+
+    h5_fixname(FILENAME[32], fapl, filename, sizeof filename);
+
+    if (NULL == (buf = (int *)HDmalloc((size_t)dim * sizeof(int))))
+        TEST_ERROR;
+    for (i = 0; i < (int)dim; i++)
+        buf[i] = i;
+
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Register byte-counting filter */
+    if (H5Zregister(H5Z_COUNT) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Close dataset & dataspace */
-    if (H5Sclose(sid) < 0)
+    if ((sid = H5Screate_simple(1, &dim, NULL)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if ((mid = H5Screate_simple(1, &chunk_dim, NULL)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset3", fid, "dset3_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset3_copy", H5P_DEFAULT)) < 0)
+    if (H5Pset_chunk(dcpl, 1, &chunk_dim) < 0)
         FAIL_STACK_ERROR;
-
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if (H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0U, (size_t)0, NULL) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create 2D dataspace with max dims > current dims (and 1 unlimited dim) */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = H5S_UNLIMITED;
-    max_dims[1] = STORAGE_SIZE_MAX_DIM2;
-    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+    /* Read ahead into a cache with room for half the chunks */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pget_chunk_prefetch(dapl, &depth) < 0)
+        FAIL_STACK_ERROR;
+    if (depth != 0)
+        FAIL_PUTS_ERROR("    Wrong default read-ahead depth.");
+    if (H5Pset_chunk_prefetch(dapl, PREFETCH_DEPTH) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pget_chunk_prefetch(dapl, &depth) < 0)
+        FAIL_STACK_ERROR;
+    if (depth != PREFETCH_DEPTH)
+        FAIL_PUTS_ERROR("    Wrong read-ahead depth.");
+    if (H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, (PREFETCH_NCHUNKS / 2) * chunk_nbytes,
+                           H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create chunked dataset, w/early allocation */
-    if ((dsid = H5Dcreate2(fid, "dset3a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT)) < 0)
+    if ((did = H5Dopen2(fid, "dset", dapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
+    /* Reset byte counts */
+    count_nbytes_read    = (size_t)0;
+    count_nbytes_written = (size_t)0;
 
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
-        FAIL_STACK_ERROR;
+    /* Read the chunks one at a time, in order */
+    for (i = 0; i < PREFETCH_NCHUNKS; i++) {
+        offset = (hsize_t)(i * PREFETCH_CHUNK);
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &chunk_dim, NULL) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0)
+            FAIL_STACK_ERROR;
+        for (j = 0; j < PREFETCH_CHUNK; j++)
+            if (rbuf[j] != buf[i * PREFETCH_CHUNK + j])
+                FAIL_PUTS_ERROR("    Wrong data read.");
+
+        /* The third chunk read sets the pattern, the chunks after it are
+         * read ahead */
+        if (i == 1 && count_nbytes_read != 2 * chunk_nbytes)
+            FAIL_PUTS_ERROR("    Chunks were read ahead before a pattern was set.");
+        if (i == 2 && count_nbytes_read != (3 + PREFETCH_DEPTH) * chunk_nbytes)
+            FAIL_PUTS_ERROR("    Chunks weren't read ahead of a sequential scan.");
+        if (i == 3 && count_nbytes_read != (3 + PREFETCH_DEPTH) * chunk_nbytes)
+            FAIL_PUTS_ERROR("    Chunk read ahead wasn't found in the cache.");
+    } /* end for */
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Each chunk should have been read once */
+    if (count_nbytes_read != PREFETCH_NCHUNKS * chunk_nbytes)
+        FAIL_PUTS_ERROR("    Chunks were read more than once, or past the end of the dataset.");
+    if (count_nbytes_written != (size_t)0)
+        FAIL_PUTS_ERROR("    Chunks were written.");
+
+    /* Every chunk after the third was read ahead, and then accessed */
+    if (H5D__chunk_prefetch_test(did, &nprefetches, &nhits, &nwasted) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    if (nprefetches != PREFETCH_NCHUNKS - 3 || nhits != nprefetches || nwasted != 0)
+        FAIL_PUTS_ERROR("    Wrong read-ahead counts for a sequential scan.");
 
-    /* Extend dataset's dimensions */
-    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
-    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
-    if (H5Dset_extent(dsid, new_dims) < 0)
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Start a sequential scan, then read backwards from the end of the
+     * dataset until the chunks read ahead are evicted.  Evict in strict
+     * least recently used order, so chunks that were read ahead aren't kept
+     * in favor of chunks that were read completely. */
+    if (H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, (PREFETCH_NCHUNKS / 2) * chunk_nbytes, 0.0) <
+        0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    if ((did = H5Dopen2(fid, "dset", dapl)) < 0)
+        FAIL_STACK_ERROR;
+    for (i = 0; i < 3; i++) {
+        offset = (hsize_t)(i * PREFETCH_CHUNK);
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &chunk_dim, NULL) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0)
+            FAIL_STACK_ERROR;
+    } /* end for */
+    for (i = PREFETCH_NCHUNKS - 1; i >= 3 + PREFETCH_DEPTH; i--) {
+        offset = (hsize_t)(i * PREFETCH_CHUNK);
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, &offset, NULL, &chunk_dim, NULL) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0)
+            FAIL_STACK_ERROR;
+    } /* end for */
+    if (H5D__chunk_prefetch_test(did, &nprefetches, &nhits, &nwasted) < 0)
+        FAIL_STACK_ERROR;
+    if (nprefetches != PREFETCH_DEPTH || nhits != 0 || nwasted != PREFETCH_DEPTH)
+        FAIL_PUTS_ERROR("    Chunks read ahead and evicted unused weren't counted as wasted.");
 
-    /* Close dataset & dataspace */
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(mid) < 0)
+        FAIL_STACK_ERROR;
     if (H5Sclose(sid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if (H5Fclose(fid) < 0)
         FAIL_STACK_ERROR;
 
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset3a", fid, "dset3a_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
-        FAIL_STACK_ERROR;
+    HDfree(buf);
 
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset3a_copy", H5P_DEFAULT)) < 0)
-        FAIL_STACK_ERROR;
+    PASSED();
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
-        FAIL_STACK_ERROR;
-    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    return SUCCEED;
 
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    }
+    H5E_END_TRY
+    HDfree(buf);
+    return FAIL;
+} /* end test_chunk_prefetch() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_lookup_batch
+ *
+ * Purpose:     Tests reading and writing selections over many chunks of a
+ *              dataset with a B-tree chunk index, whose addresses are
+ *              looked up in one pass over the index, with some chunks not
+ *              allocated and some dirty in the chunk cache.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define LOOKUP_BATCH_DIM   64
+#define LOOKUP_BATCH_CHUNK 4
+#define LOOKUP_BATCH_EXT   80
+#define LOOKUP_BATCH_FILL  (-1)
+static herr_t
+test_chunk_lookup_batch(hid_t fapl)
+{
+    char    filename[FILENAME_BUF_SIZE];
+    hid_t   fid  = -1; /* File ID */
+    hid_t   dcpl = -1; /* Dataset creation property list ID */
+    hid_t   sid  = -1; /* Dataspace ID */
+    hid_t   mid  = -1; /* Memory dataspace ID */
+    hid_t   did  = -1; /* Dataset ID */
+    hsize_t dims[2]      = {LOOKUP_BATCH_DIM, LOOKUP_BATCH_DIM};
+    hsize_t max_dims[2]  = {H5S_UNLIMITED, H5S_UNLIMITED};
+    hsize_t chunk_dim[2] = {LOOKUP_BATCH_CHUNK, LOOKUP_BATCH_CHUNK};
+    hsize_t ext_dims[2]  = {LOOKUP_BATCH_DIM, LOOKUP_BATCH_EXT};
+    hsize_t start[2];                        /* Start of hyperslab */
+    int     fill = LOOKUP_BATCH_FILL;        /* Fill value */
+    int     value;                           /* Value to write */
+    int    *wbuf = NULL;                     /* Write buffer */
+    int    *rbuf = NULL;                     /* Read buffer */
+    int     expect;                          /* Expected value */
+    int     i, j;                            /* Local index variables */
+
+    TESTING("looking up the chunks of a selection together");
+
+    h5_fixname(FILENAME[33], fapl, filename, sizeof filename);
+
+    if (NULL == (wbuf = (int *)HDmalloc(LOOKUP_BATCH_DIM * LOOKUP_BATCH_DIM * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (rbuf = (int *)HDmalloc(LOOKUP_BATCH_DIM * LOOKUP_BATCH_EXT * sizeof(int))))
+        TEST_ERROR;
+    for (i = 0; i < LOOKUP_BATCH_DIM * LOOKUP_BATCH_DIM; i++)
+        wbuf[i] = i;
+
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
 
-    /* Create 2D dataspace with max dims > current dims (and 2 unlimited dims) */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = H5S_UNLIMITED;
-    max_dims[1] = H5S_UNLIMITED;
+    /* Two unlimited dimensions give a v2 B-tree index with the latest
+     * format, and a v1 B-tree otherwise */
     if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create chunked dataset */
-    if ((dsid = H5Dcreate2(fid, "dset4", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
-
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
+    if (H5Pset_chunk(dcpl, 2, chunk_dim) < 0)
         FAIL_STACK_ERROR;
-
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if (H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0)
+        FAIL_STACK_ERROR;
+    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Extend dataset's dimensions */
-    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
-    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
-    if (H5Dset_extent(dsid, new_dims) < 0)
+    /* Write every chunk but the ones on every fifth diagonal */
+    if ((mid = H5Screate_simple(2, dims, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sselect_none(sid) < 0)
+        FAIL_STACK_ERROR;
+    for (i = 0; i < LOOKUP_BATCH_DIM / LOOKUP_BATCH_CHUNK; i++)
+        for (j = 0; j < LOOKUP_BATCH_DIM / LOOKUP_BATCH_CHUNK; j++)
+            if ((i + j) % 5 != 0) {
+                start[0] = (hsize_t)(i * LOOKUP_BATCH_CHUNK);
+                start[1] = (hsize_t)(j * LOOKUP_BATCH_CHUNK);
+                if (H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, NULL, chunk_dim, NULL) < 0)
+                    FAIL_STACK_ERROR;
+            } /* end if */
+    if (H5Sselect_copy(mid, sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Reopen the dataset, leave one allocated and one unallocated chunk
+     * dirty in the cache, then read everything */
+    if ((did = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
-
-    /* Close dataset & dataspace */
-    if (H5Sclose(sid) < 0)
+    if (H5Sclose(mid) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if ((mid = H5Screate(H5S_SCALAR)) < 0)
         FAIL_STACK_ERROR;
+    for (i = 0; i < 2; i++) {
+        hsize_t coord[2];
 
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset4", fid, "dset4_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
-        FAIL_STACK_ERROR;
+        /* Chunk (0, 1) is allocated, chunk (0, 0) is not */
+        coord[0] = 1;
+        coord[1] = (hsize_t)((1 - i) * LOOKUP_BATCH_CHUNK + 1);
+        value    = -100 - i;
+        if (H5Sselect_elements(sid, H5S_SELECT_SET, (size_t)1, coord) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, &value) < 0)
+            FAIL_STACK_ERROR;
+    } /* end for */
 
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset4_copy", H5P_DEFAULT)) < 0)
-        FAIL_STACK_ERROR;
+    /* Extend the dataset so some chunks are outside its old extent */
+    if (H5Dset_extent(did, ext_dims) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        FAIL_STACK_ERROR;
+    for (i = 0; i < LOOKUP_BATCH_DIM; i++)
+        for (j = 0; j < LOOKUP_BATCH_EXT; j++) {
+            if (j >= LOOKUP_BATCH_DIM || (i / LOOKUP_BATCH_CHUNK + j / LOOKUP_BATCH_CHUNK) % 5 == 0)
+                expect = LOOKUP_BATCH_FILL;
+            else
+                expect = i * LOOKUP_BATCH_DIM + j;
+            if (i == 1 && j == LOOKUP_BATCH_CHUNK + 1)
+                expect = -100;
+            if (i == 1 && j == 1)
+                expect = -101;
+            if (rbuf[i * LOOKUP_BATCH_EXT + j] != expect)
+                FAIL_PUTS_ERROR("    Wrong data read.");
+        } /* end for */
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Overwrite the whole dataset, then read it back after closing it */
+    for (i = 0; i < LOOKUP_BATCH_DIM * LOOKUP_BATCH_EXT; i++)
+        rbuf[i] = -i;
+    if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
-
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+    if (H5Dclose(did) < 0)
         FAIL_STACK_ERROR;
-
-    /* Create 2D dataspace with max dims > current dims (and 2 unlimited dims) */
-    dims[0]     = STORAGE_SIZE_DIM1;
-    dims[1]     = STORAGE_SIZE_DIM2;
-    max_dims[0] = H5S_UNLIMITED;
-    max_dims[1] = H5S_UNLIMITED;
-    if ((sid = H5Screate_simple(2, dims, max_dims)) < 0)
+    if ((did = H5Dopen2(fid, "dset", H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    HDmemset(rbuf, 0, LOOKUP_BATCH_DIM * LOOKUP_BATCH_EXT * sizeof(int));
+    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
         FAIL_STACK_ERROR;
+    for (i = 0; i < LOOKUP_BATCH_DIM * LOOKUP_BATCH_EXT; i++)
+        if (rbuf[i] != -i)
+            FAIL_PUTS_ERROR("    Wrong data read after overwriting.");
 
-    /* Create chunked dataset, w/early allocation */
-    if ((dsid = H5Dcreate2(fid, "dset4a", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl2, H5P_DEFAULT)) < 0)
+    if (H5Dclose(did) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(mid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Fclose(fid) < 0)
         FAIL_STACK_ERROR;
 
-    /* Initialize buffer to zeroes */
-    HDmemset(wdata, 0, sizeof(wdata));
+    HDfree(wbuf);
+    HDfree(rbuf);
 
-    /* write elements to dataset */
-    if (H5Dwrite(dsid, H5T_NATIVE_INT, sid, sid, H5P_DEFAULT, wdata) < 0)
-        FAIL_STACK_ERROR;
+    PASSED();
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
-        FAIL_STACK_ERROR;
-    if ((sizeof(int) * 6 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
+    return SUCCEED;
 
-    /* Extend dataset's dimensions */
-    new_dims[0] = STORAGE_SIZE_DIM1 * 2;
-    new_dims[1] = STORAGE_SIZE_DIM2 * 2;
-    if (H5Dset_extent(dsid, new_dims) < 0)
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(dcpl);
+        H5Dclose(did);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    }
+    H5E_END_TRY
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_lookup_batch() */
+
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_read_gap
+ *
+ * Purpose:     Tests reading datasets whose chunks are interleaved in the
+ *              file with those of other datasets, with selection I/O and
+ *              with and without a vector read gap (H5Pset_vector_read_gap),
+ *              so that neighboring chunks are read together and the bytes
+ *              between them are thrown away.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define VECTOR_GAP_DIM    32
+#define VECTOR_GAP_CHUNK  4
+#define VECTOR_GAP_NDSETS 3
+static herr_t
+test_vector_read_gap(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    const char *dset_names[VECTOR_GAP_NDSETS] = {"a", "b", "filtered"};
+    hid_t       fid  = -1; /* File ID */
+    hid_t       dcpl = -1; /* Dataset creation property list ID */
+    hid_t       dapl = -1; /* Dataset access property list ID */
+    hid_t       dxpl = -1; /* Dataset transfer property list ID */
+    hid_t       sid  = -1; /* Dataspace ID */
+    hid_t       mid  = -1; /* Memory dataspace ID */
+    hid_t       dids[VECTOR_GAP_NDSETS] = {-1, -1, -1}; /* Dataset IDs */
+    hsize_t     dims[2]      = {VECTOR_GAP_DIM, VECTOR_GAP_DIM};
+    hsize_t     mem_dims[2]  = {VECTOR_GAP_DIM, 2 * VECTOR_GAP_DIM};
+    hsize_t     chunk_dim[2] = {VECTOR_GAP_CHUNK, VECTOR_GAP_DIM};
+    hsize_t     start[2];  /* Start of hyperslab */
+    hsize_t     stride[2]; /* Stride of hyperslab */
+    hsize_t     count[2];  /* Count of hyperslab */
+    size_t      gap;       /* Vector read gap */
+    int        *wbuf = NULL; /* Write buffer */
+    int        *rbuf = NULL; /* Read buffer */
+    int         i, j, k, n;  /* Local index variables */
+    herr_t      status;      /* Generic return value */
+
+    TESTING("reading neighboring chunks together");
+
+    h5_fixname(FILENAME[34], fapl, filename, sizeof filename);
+
+    if (NULL == (wbuf = (int *)HDmalloc(VECTOR_GAP_DIM * VECTOR_GAP_DIM * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (rbuf = (int *)HDmalloc(VECTOR_GAP_DIM * 2 * VECTOR_GAP_DIM * sizeof(int))))
+        TEST_ERROR;
+
+    /* Check the property's default and argument checking */
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pget_vector_read_gap(dxpl, &gap) < 0)
+        FAIL_STACK_ERROR;
+    if (gap != 0)
+        FAIL_PUTS_ERROR("    Wrong default vector read gap.");
+    H5E_BEGIN_TRY
+    {
+        status = H5Pset_vector_read_gap(H5P_DEFAULT, 1);
+    }
+    H5E_END_TRY
+    if (status >= 0)
+        FAIL_PUTS_ERROR("    Set vector read gap on default property list.");
+    if (H5Pset_selection_io(dxpl, H5D_SELECTION_IO_MODE_ON) < 0)
         FAIL_STACK_ERROR;
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Close dataset & dataspace */
-    if (H5Sclose(sid) < 0)
+    /* Disable the chunk cache, so each chunk is allocated in the file when
+     * it is written and the chunks are read with selection I/O */
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
         FAIL_STACK_ERROR;
-    if (H5Dclose(dsid) < 0)
+    if (H5Pset_chunk_cache(dapl, 0, 0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
         FAIL_STACK_ERROR;
 
-    /* Copy the dataset */
-    if (H5Ocopy(fid, "dset4a", fid, "dset4a_copy", H5P_DEFAULT, H5P_DEFAULT) < 0)
+    if ((sid = H5Screate_simple(2, dims, NULL)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Open the copied dataset */
-    if ((dsid = H5Dopen2(fid, "dset4a_copy", H5P_DEFAULT)) < 0)
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dcpl, 2, chunk_dim) < 0)
         FAIL_STACK_ERROR;
+    for (k = 0; k < VECTOR_GAP_NDSETS; k++) {
+        if (k == VECTOR_GAP_NDSETS - 1 && H5Pset_shuffle(dcpl) < 0)
+            FAIL_STACK_ERROR;
+        if ((dids[k] = H5Dcreate2(fid, dset_names[k], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR;
+    } /* end for */
 
-    /* Get the storage size */
-    if (0 == (ssize = H5Dget_storage_size(dsid)))
+    /* Write the chunks of the datasets in turn, so they are interleaved in
+     * the file */
+    count[0] = VECTOR_GAP_CHUNK;
+    count[1] = VECTOR_GAP_DIM;
+    if ((mid = H5Screate_simple(2, count, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    for (i = 0; i < VECTOR_GAP_DIM / VECTOR_GAP_CHUNK; i++)
+        for (k = 0; k < VECTOR_GAP_NDSETS; k++) {
+            for (n = 0; n < VECTOR_GAP_CHUNK * VECTOR_GAP_DIM; n++)
+                wbuf[n] = (k + 1) * 100000 + i * VECTOR_GAP_CHUNK * VECTOR_GAP_DIM + n;
+            start[0] = (hsize_t)(i * VECTOR_GAP_CHUNK);
+            start[1] = 0;
+            if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+                FAIL_STACK_ERROR;
+            if (H5Dwrite(dids[k], H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0)
+                FAIL_STACK_ERROR;
+        } /* end for */
+    if (H5Sclose(mid) < 0)
         FAIL_STACK_ERROR;
-    if ((sizeof(int) * 15 * STORAGE_SIZE_CHUNK_DIM1 * STORAGE_SIZE_CHUNK_DIM2) != ssize)
-        TEST_ERROR;
 
-    /* Close copied dataset */
-    if (H5Dclose(dsid) < 0)
+    /* Read every other row of each dataset into every other column of a
+     * wider buffer, with no gap, a gap that only spans the skipped rows and
+     * a gap that also spans the chunks of the other datasets */
+    if ((mid = H5Screate_simple(2, mem_dims, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    start[0]  = 0;
+    start[1]  = 0;
+    stride[0] = 2;
+    stride[1] = 1;
+    count[0]  = VECTOR_GAP_DIM / 2;
+    count[1]  = VECTOR_GAP_DIM;
+    if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+        FAIL_STACK_ERROR;
+    stride[0] = 1;
+    stride[1] = 2;
+    count[0]  = VECTOR_GAP_DIM / 2;
+    if (H5Sselect_hyperslab(mid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
         FAIL_STACK_ERROR;
+    for (gap = 0; gap <= 4 * VECTOR_GAP_CHUNK * VECTOR_GAP_DIM * sizeof(int);
+         gap += 2 * VECTOR_GAP_CHUNK * VECTOR_GAP_DIM * sizeof(int) - 1) {
+        if (H5Pset_vector_read_gap(dxpl, gap) < 0)
+            FAIL_STACK_ERROR;
 
-    /* Close rest */
+        for (k = 0; k < VECTOR_GAP_NDSETS; k++) {
+            for (n = 0; n < VECTOR_GAP_DIM * 2 * VECTOR_GAP_DIM; n++)
+                rbuf[n] = -1;
+            if (H5Dread(dids[k], H5T_NATIVE_INT, mid, sid, dxpl, rbuf) < 0)
+                FAIL_STACK_ERROR;
+
+            for (i = 0; i < VECTOR_GAP_DIM; i++)
+                for (j = 0; j < 2 * VECTOR_GAP_DIM; j++) {
+                    int expect = -1; /* Expected value */
+
+                    if (i < VECTOR_GAP_DIM / 2 && j % 2 == 0)
+                        expect = (k + 1) * 100000 + 2 * i * VECTOR_GAP_DIM + j / 2;
+                    if (rbuf[i * 2 * VECTOR_GAP_DIM + j] != expect)
+                        FAIL_PUTS_ERROR("    Wrong data read.");
+                } /* end for */
+        }     /* end for */
+    }         /* end for */
+
+    for (k = 0; k < VECTOR_GAP_NDSETS; k++) {
+        if (H5Dclose(dids[k]) < 0)
+            FAIL_STACK_ERROR;
+        dids[k] = -1;
+    } /* end for */
+    if (H5Pclose(dxpl) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Pclose(dapl) < 0)
+        FAIL_STACK_ERROR;
     if (H5Pclose(dcpl) < 0)
         FAIL_STACK_ERROR;
+    if (H5Sclose(mid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
     if (H5Fclose(fid) < 0)
         FAIL_STACK_ERROR;
 
+    HDfree(wbuf);
+    HDfree(rbuf);
+
     PASSED();
 
     return SUCCEED;
@@ -13109,93 +15205,217 @@ test_storage_size(hid_t fapl)
 error:
     H5E_BEGIN_TRY
     {
+        for (k = 0; k < VECTOR_GAP_NDSETS; k++)
+            H5Dclose(dids[k]);
+        H5Pclose(dxpl);
+        H5Pclose(dapl);
         H5Pclose(dcpl);
-        H5Pclose(dcpl2);
-        H5Dclose(dsid);
+        H5Sclose(mid);
         H5Sclose(sid);
         H5Fclose(fid);
     }
     H5E_END_TRY
+    HDfree(wbuf);
+    HDfree(rbuf);
     return FAIL;
-} /* end test_storage_size() */
+} /* end test_vector_read_gap() */
 
 /*-------------------------------------------------------------------------
- * Function:    test_power2up
+ * Function:    test_chunk_sel_plan
  *
- * Purpose:     Tests that the H5VM_power2up(n) function does not result in an
- *              infinite loop when input n exceeds 2^63. (HDFFV-10217)
- *              H5VM_power2up() is used to calculate the next power of 2 for
- *              a dataset's scaled dimension sizes.
+ * Purpose:     Tests reading and writing the same hyperslab selection of a
+ *              chunked dataset at different offsets, so that the chunk
+ *              selections built for one I/O are reused by the next ones
+ *              when the selection moves by whole chunks, and rebuilt when
+ *              it doesn't or the memory selection changes.
  *
  * Return:      Success: 0
  *              Failure: -1
  *
- * Programmer:  Vailin Choi; June 2017
- *
  *-------------------------------------------------------------------------
  */
+#define SEL_PLAN_DIM0  60
+#define SEL_PLAN_DIM1  80
+#define SEL_PLAN_CHUNK 10
+#define SEL_PLAN_NREADS 6
 static herr_t
-test_power2up(hid_t fapl)
+test_chunk_sel_plan(hid_t fapl)
 {
     char    filename[FILENAME_BUF_SIZE];
-    hid_t   fid  = -1;     /* File ID */
-    hid_t   dcpl = -1;     /* Dataset creation property list */
-    hid_t   sid  = -1;     /* Dataspace ID */
-    hid_t   did  = -1;     /* Dataset ID */
-    hsize_t dims[2];       /* Dataset dimension sizes */
-    hsize_t max_dims[2];   /* Maximum dimension sizes */
-    hsize_t chunk_dims[2]; /* Chunk dimensions */
-    hsize_t ext_dims[2];   /* Extended dimension sizes */
-    herr_t  status;        /* Error status */
-
-    TESTING("the next power of 2");
+    hid_t   fid  = -1; /* File ID */
+    hid_t   dcpl = -1; /* Dataset creation property list ID */
+    hid_t   sid  = -1; /* Dataspace ID */
+    hid_t   mid  = -1; /* Memory dataspace ID */
+    hid_t   did  = -1; /* Dataset ID */
+    hsize_t dims[2]      = {SEL_PLAN_DIM0, SEL_PLAN_DIM1};
+    hsize_t chunk_dim[2] = {SEL_PLAN_CHUNK, SEL_PLAN_CHUNK};
+    hsize_t mem_dims[2]  = {7, 10};
+    hsize_t start[2];                /* Start of hyperslab */
+    hsize_t stride[2] = {2, 3};      /* Stride of hyperslab */
+    hsize_t count[2]  = {4, 4};      /* Count of hyperslab */
+    hsize_t block[2];                /* Block of hyperslab */
+    hsize_t mem_npoints = 25;        /* Number of points in the irregular selection */
+    /* Offsets to read at, and the number of reuses of the selections expected after each */
+    const hsize_t read_start[SEL_PLAN_NREADS][2] = {{1, 2}, {11, 2}, {21, 32}, {31, 52}, {5, 7}, {15, 17}};
+    const unsigned read_hits[SEL_PLAN_NREADS]    = {0, 1, 2, 3, 3, 4};
+    unsigned       nhits;            /* Number of I/O operations that reused the selections */
+    int           *wbuf = NULL;      /* Write buffer */
+    int           *rbuf = NULL;      /* Read buffer */
+    int            mbuf[7][10];      /* Memory buffer */
+    int            i, j, n;          /* Local index variables */
+
+    TESTING("reusing chunk selections of moved hyperslabs");
+
+    h5_fixname(FILENAME[35], fapl, filename, sizeof filename);
+
+    if (NULL == (wbuf = (int *)HDmalloc(SEL_PLAN_DIM0 * SEL_PLAN_DIM1 * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (rbuf = (int *)HDmalloc(SEL_PLAN_DIM0 * SEL_PLAN_DIM1 * sizeof(int))))
+        TEST_ERROR;
+    for (n = 0; n < SEL_PLAN_DIM0 * SEL_PLAN_DIM1; n++)
+        wbuf[n] = n;
 
-    h5_fixname(FILENAME[24], fapl, filename, sizeof filename);
-
-    /* Create file */
     if ((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
         FAIL_STACK_ERROR;
-
-    /* Set dims[1] to ((2^63) -1) */
-    dims[0]     = 0;
-    dims[1]     = ((hsize_t)1 << ((sizeof(hsize_t) * CHAR_BIT) - 1)) - 1;
-    max_dims[0] = max_dims[1] = H5S_UNLIMITED;
-    sid                       = H5Screate_simple(2, dims, max_dims);
-
-    /* Create dataset creation property list */
+    if ((sid = H5Screate_simple(2, dims, NULL)) < 0)
+        FAIL_STACK_ERROR;
     if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
-        TEST_ERROR;
+        FAIL_STACK_ERROR;
+    if (H5Pset_chunk(dcpl, 2, chunk_dim) < 0)
+        FAIL_STACK_ERROR;
+    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Set chunk size */
-    chunk_dims[0] = chunk_dims[1] = 1;
-    if (H5Pset_chunk(dcpl, 2, chunk_dims) < 0)
-        TEST_ERROR;
+    /* Read a strided selection, over up to four chunks, into the same
+     * selection of a memory buffer */
+    if ((mid = H5Screate_simple(2, mem_dims, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    start[0] = start[1] = 0;
+    if (H5Sselect_hyperslab(mid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+        FAIL_STACK_ERROR;
+    for (n = 0; n < SEL_PLAN_NREADS; n++) {
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, read_start[n], stride, count, NULL) < 0)
+            FAIL_STACK_ERROR;
+        HDmemset(mbuf, 0, sizeof(mbuf));
+        if (H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, mbuf) < 0)
+            FAIL_STACK_ERROR;
+        for (i = 0; i < (int)mem_dims[0]; i++)
+            for (j = 0; j < (int)mem_dims[1]; j++) {
+                int expect = 0;
 
-    /* Create chunked dataset */
-    if ((did = H5Dcreate2(fid, "dset", H5T_NATIVE_INT64, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
-        TEST_ERROR;
+                if (i % 2 == 0 && j % 3 == 0)
+                    expect = wbuf[((int)read_start[n][0] + i) * SEL_PLAN_DIM1 + (int)read_start[n][1] + j];
+                if (mbuf[i][j] != expect) {
+                    H5_FAILED();
+                    HDprintf("    Read %d at [%d][%d] from offset %d, expected %d\n", mbuf[i][j], i, j, n,
+                             expect);
+                    goto error;
+                } /* end if */
+            }     /* end for */
+        if (H5D__sel_plan_hits_test(did, &nhits) < 0)
+            FAIL_STACK_ERROR;
+        if (nhits != read_hits[n]) {
+            H5_FAILED();
+            HDprintf("    Chunk selections reused %u times after read %d, expected %u\n", nhits, n,
+                     read_hits[n]);
+            goto error;
+        } /* end if */
+    }     /* end for */
+
+    /* Write the selection at two more offsets with the same position in
+     * their chunks, and check the whole dataset */
+    for (i = 0; i < (int)mem_dims[0]; i++)
+        for (j = 0; j < (int)mem_dims[1]; j++)
+            mbuf[i][j] = -(i * 10 + j) - 1;
+    for (n = 0; n < 2; n++) {
+        start[0] = (hsize_t)(25 + 20 * n);
+        start[1] = (hsize_t)(27 + 40 * n);
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+            FAIL_STACK_ERROR;
+        if (H5Dwrite(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, mbuf) < 0)
+            FAIL_STACK_ERROR;
+        for (i = 0; i < (int)mem_dims[0]; i += 2)
+            for (j = 0; j < (int)mem_dims[1]; j += 3)
+                wbuf[((int)start[0] + i) * SEL_PLAN_DIM1 + (int)start[1] + j] = mbuf[i][j];
+    } /* end for */
+    if (H5D__sel_plan_hits_test(did, &nhits) < 0)
+        FAIL_STACK_ERROR;
+    if (nhits != read_hits[SEL_PLAN_NREADS - 1] + 2)
+        FAIL_PUTS_ERROR("    Chunk selections not reused for writes.");
+    if (H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        FAIL_STACK_ERROR;
+    if (HDmemcmp(rbuf, wbuf, SEL_PLAN_DIM0 * SEL_PLAN_DIM1 * sizeof(int)) != 0)
+        FAIL_PUTS_ERROR("    Read different values than written.");
 
-    ext_dims[0] = 1;
-    ext_dims[1] = dims[1] + 5;
+    /* A different memory selection doesn't reuse the chunk selections */
+    if (H5Sselect_all(mid) < 0)
+        FAIL_STACK_ERROR;
+    start[0] = 45;
+    start[1] = 67;
+    block[0] = mem_dims[0];
+    block[1] = mem_dims[1];
+    count[0] = count[1] = 1;
+    if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, block) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, mbuf) < 0)
+        FAIL_STACK_ERROR;
+    if (H5D__sel_plan_hits_test(did, &nhits) < 0)
+        FAIL_STACK_ERROR;
+    if (nhits != read_hits[SEL_PLAN_NREADS - 1] + 2)
+        FAIL_PUTS_ERROR("    Chunk selections reused for a different memory selection.");
+    for (i = 0; i < (int)mem_dims[0]; i++)
+        for (j = 0; j < (int)mem_dims[1]; j++)
+            if (mbuf[i][j] != wbuf[(45 + i) * SEL_PLAN_DIM1 + 67 + j])
+                FAIL_PUTS_ERROR("    Read wrong values for a block.");
+    if (H5Sclose(mid) < 0)
+        FAIL_STACK_ERROR;
 
-    /* Extend to (2^63)+ */
-    H5E_BEGIN_TRY
-    {
-        status = H5Dset_extent(did, ext_dims);
-    }
-    H5E_END_TRY
-    if (status >= 0)
-        TEST_ERROR;
+    /* Read an irregular selection into a 1-D buffer, then move it by some
+     * chunks in each dimension */
+    if ((mid = H5Screate_simple(1, &mem_npoints, NULL)) < 0)
+        FAIL_STACK_ERROR;
+    for (n = 0; n < 2; n++) {
+        start[0] = (hsize_t)(2 + 20 * n);
+        start[1] = (hsize_t)(3 + 30 * n);
+        block[0] = block[1] = 4;
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, block) < 0)
+            FAIL_STACK_ERROR;
+        start[0] += 6;
+        start[1] += 6;
+        block[0] = block[1] = 3;
+        if (H5Sselect_hyperslab(sid, H5S_SELECT_OR, start, NULL, count, block) < 0)
+            FAIL_STACK_ERROR;
+        HDmemset(rbuf, 0, (size_t)mem_npoints * sizeof(int));
+        if (H5Dread(did, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0)
+            FAIL_STACK_ERROR;
+        for (i = 0; i < 4; i++)
+            for (j = 0; j < 4; j++)
+                if (rbuf[i * 4 + j] != wbuf[(2 + 20 * n + i) * SEL_PLAN_DIM1 + 3 + 30 * n + j])
+                    FAIL_PUTS_ERROR("    Read wrong values for an irregular selection.");
+        for (i = 0; i < 3; i++)
+            for (j = 0; j < 3; j++)
+                if (rbuf[16 + i * 3 + j] != wbuf[(8 + 20 * n + i) * SEL_PLAN_DIM1 + 9 + 30 * n + j])
+                    FAIL_PUTS_ERROR("    Read wrong values for an irregular selection.");
+    } /* end for */
+    if (H5D__sel_plan_hits_test(did, &nhits) < 0)
+        FAIL_STACK_ERROR;
+    if (nhits != read_hits[SEL_PLAN_NREADS - 1] + 3)
+        FAIL_PUTS_ERROR("    Chunk selections not reused for an irregular selection.");
 
-    /* Closing */
     if (H5Dclose(did) < 0)
-        TEST_ERROR;
-    if (H5Sclose(sid) < 0)
-        TEST_ERROR;
+        FAIL_STACK_ERROR;
     if (H5Pclose(dcpl) < 0)
-        TEST_ERROR;
+        FAIL_STACK_ERROR;
+    if (H5Sclose(mid) < 0)
+        FAIL_STACK_ERROR;
+    if (H5Sclose(sid) < 0)
+        FAIL_STACK_ERROR;
     if (H5Fclose(fid) < 0)
-        TEST_ERROR;
+        FAIL_STACK_ERROR;
+    HDfree(wbuf);
+    HDfree(rbuf);
 
     PASSED();
 
@@ -13204,15 +15424,17 @@ test_power2up(hid_t fapl)
 error:
     H5E_BEGIN_TRY
     {
-        H5Pclose(dcpl);
         H5Dclose(did);
-        H5Sclose(sid);
         H5Pclose(dcpl);
+        H5Sclose(mid);
+        H5Sclose(sid);
         H5Fclose(fid);
     }
     H5E_END_TRY
+    HDfree(wbuf);
+    HDfree(rbuf);
     return FAIL;
-} /* end test_power2up() */
+} /* end test_chunk_sel_plan() */
 
 /*-------------------------------------------------------------------------
  * Function:    test_scatter
@@ -15725,6 +17947,9 @@ main(void)
                 nerrors += (test_tconv(file) < 0 ? 1 : 0);
                 nerrors += (test_filters(file) < 0 ? 1 : 0);
                 nerrors += (test_onebyte_shuffle(file) < 0 ? 1 : 0);
+                nerrors += (test_bitshuffle(file) < 0 ? 1 : 0);
+                nerrors += (test_deflate_streams(file) < 0 ? 1 : 0);
+                nerrors += (test_filter_buffer_pool(file) < 0 ? 1 : 0);
                 nerrors += (test_nbit_int(file) < 0 ? 1 : 0);
                 nerrors += (test_nbit_float(file) < 0 ? 1 : 0);
                 nerrors += (test_nbit_double(file) < 0 ? 1 : 0);
@@ -15789,6 +18014,14 @@ main(void)
                 nerrors += (test_zero_dim_dset(my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_storage_size(my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_power2up(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_filter_nthreads(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_filter_nthreads_flush(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_chunk_cache_sets(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_file_chunk_cache(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_chunk_prefetch(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_chunk_lookup_batch(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_vector_read_gap(my_fapl) < 0 ? 1 : 0);
+                nerrors += (test_chunk_sel_plan(my_fapl) < 0 ? 1 : 0);
 
                 nerrors += (test_swmr_non_latest(envval, my_fapl) < 0 ? 1 : 0);
                 nerrors += (test_earray_hdr_fd(envval, my_fapl) < 0 ? 1 : 0);
@@ -15814,6 +18047,8 @@ main(void)
     nerrors += (test_gather() < 0 ? 1 : 0);
     nerrors += (test_scatter_error() < 0 ? 1 : 0);
     nerrors += (test_gather_error() < 0 ? 1 : 0);
+    nerrors += (test_shuffle_kernels() < 0 ? 1 : 0);
+    nerrors += (test_bitshuffle_kernels() < 0 ? 1 : 0);
 
     /* Tests version bounds using its own file */
     if (driver_is_default_compatible) {
@@ -95,6 +95,9 @@ typedef enum dtype_t {
 #define TMP_BUF_DIM1 32
 #define TMP_BUF_DIM2 100
 
+/* Number of elements converted by test_conv_contiguous() */
+#define CONTIG_CONV_NELMTS 10007
+
 /* Don't use hardware conversions if set */
 static int without_hardware_g = 0;
 
@@ -4645,6 +4648,277 @@ done:
     return ret_value;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_contiguous
+ *
+ * Purpose:     Tests the block-wise hard integer conversions and the vector
+ *              byte order conversions, which are used for long, contiguous
+ *              buffers without an exception callback.  The buffers are
+ *              converted in place and the number of elements isn't a
+ *              multiple of the block or vector sizes, and the byte order
+ *              conversions start at an odd address, so the leftover
+ *              elements are covered as well.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_contiguous(void)
+{
+    int           *ibuf    = NULL;               /*buffer for the integer conversions */
+    short         *sbuf    = NULL;               /*same buffer, as shorts */
+    unsigned char *buf     = NULL;               /*buffer for the byte order conversions */
+    unsigned char *saved   = NULL;               /*original bytes */
+    hid_t          le_type = H5I_INVALID_HID;    /*little-endian type */
+    hid_t          be_type = H5I_INVALID_HID;    /*big-endian type */
+    const size_t   sizes[] = {2, 4, 8, 16};      /*sizes of the swapped types */
+    size_t         nelmts  = CONTIG_CONV_NELMTS; /*number of elements converted */
+    size_t         u, v, w;
+
+    TESTING("contiguous integer and byte order conversions");
+
+    if (NULL == (ibuf = (int *)HDmalloc(nelmts * sizeof(int))))
+        TEST_ERROR;
+    sbuf = (short *)(void *)ibuf;
+
+    /* Widen shorts to ints */
+    for (u = 0; u < nelmts; u++)
+        sbuf[u] = (short)((int)(u * 7 % 64000) - 32000);
+    if (H5Tconvert(H5T_NATIVE_SHORT, H5T_NATIVE_INT, nelmts, ibuf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    for (u = 0; u < nelmts; u++)
+        if (ibuf[u] != (int)(u * 7 % 64000) - 32000) {
+            H5_FAILED();
+            HDprintf("    short to int element %zu: %d\n", u, ibuf[u]);
+            goto error;
+        } /* end if */
+
+    /* Narrow ints to shorts, with values out of range at both ends */
+    for (u = 0; u < nelmts; u++)
+        ibuf[u] = (int)(u * 13) - 65000;
+    if (H5Tconvert(H5T_NATIVE_INT, H5T_NATIVE_SHORT, nelmts, ibuf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    for (u = 0; u < nelmts; u++) {
+        int expect = (int)(u * 13) - 65000;
+
+        if (expect > SHRT_MAX)
+            expect = SHRT_MAX;
+        else if (expect < SHRT_MIN)
+            expect = SHRT_MIN;
+        if (sbuf[u] != expect) {
+            H5_FAILED();
+            HDprintf("    int to short element %zu: %d, expected %d\n", u, sbuf[u], expect);
+            goto error;
+        } /* end if */
+    }     /* end for */
+
+    /* Swap the bytes of each size of element, from an odd address */
+    if (NULL == (buf = (unsigned char *)HDmalloc(nelmts * 16 + 1)))
+        TEST_ERROR;
+    if (NULL == (saved = (unsigned char *)HDmalloc(nelmts * 16)))
+        TEST_ERROR;
+    for (u = 0; u < nelmts * 16; u++)
+        saved[u] = (unsigned char)HDrandom();
+    for (w = 0; w < NELMTS(sizes); w++) {
+        if ((le_type = H5Tcopy(H5T_STD_U8LE)) < 0)
+            TEST_ERROR;
+        if (H5Tset_size(le_type, sizes[w]) < 0)
+            TEST_ERROR;
+        if ((be_type = H5Tcopy(le_type)) < 0)
+            TEST_ERROR;
+        if (H5Tset_order(be_type, H5T_ORDER_BE) < 0)
+            TEST_ERROR;
+
+        HDmemcpy(buf + 1, saved, nelmts * sizes[w]);
+        if (H5Tconvert(be_type, le_type, nelmts, buf + 1, NULL, H5P_DEFAULT) < 0)
+            TEST_ERROR;
+        for (u = 0; u < nelmts; u++)
+            for (v = 0; v < sizes[w]; v++)
+                if (buf[1 + u * sizes[w] + v] != saved[u * sizes[w] + sizes[w] - (v + 1)]) {
+                    H5_FAILED();
+                    HDprintf("    %zu-byte element %zu: byte %zu not swapped\n", sizes[w], u, v);
+                    goto error;
+                } /* end if */
+
+        if (H5Tclose(le_type) < 0)
+            TEST_ERROR;
+        if (H5Tclose(be_type) < 0)
+            TEST_ERROR;
+    } /* end for */
+
+    HDfree(ibuf);
+    HDfree(buf);
+    HDfree(saved);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(le_type);
+        H5Tclose(be_type);
+    }
+    H5E_END_TRY;
+    HDfree(ibuf);
+    HDfree(buf);
+    HDfree(saved);
+
+    return 1;
+}
+
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_flt_ieee
+ *
+ * Purpose:     Tests the conversions between IEEE single and double
+ *              precision values that aren't both native, i.e. in the other
+ *              byte order or with padding.  Their results must be the same,
+ *              bit for bit, as those of the hard conversions between the
+ *              native types, including for special values, denormalized
+ *              values, values out of range and halfway cases of rounding.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_conv_flt_ieee(void)
+{
+    double      *dvals    = NULL; /*source values */
+    float       *fexpect  = NULL; /*hard conversions of the values to float */
+    double      *dexpect  = NULL; /*hard conversions of those back to double */
+    double      *buf      = NULL; /*conversion buffer */
+    const double special[] = {0.0, -0.0, 1.0, 16777217.0, -16777219.0, 1.0e-40, -1.0e-45, 1.0e-300,
+                              (double)FLT_MAX, (double)FLT_MAX * (1.0 + 1.0e-9), -(double)FLT_MAX * 2.0,
+                              DBL_MAX, -HUGE_VAL, HUGE_VAL};
+    hid_t        pad_type = H5I_INVALID_HID; /*float padded to 8 bytes */
+    size_t       nelmts   = CONTIG_CONV_NELMTS;
+    size_t       u;
+
+    TESTING("IEEE float conversions with other byte orders or padding");
+
+    if (NULL == (dvals = (double *)HDmalloc(nelmts * sizeof(double))))
+        TEST_ERROR;
+    if (NULL == (fexpect = (float *)HDmalloc(nelmts * sizeof(float))))
+        TEST_ERROR;
+    if (NULL == (dexpect = (double *)HDmalloc(nelmts * sizeof(double))))
+        TEST_ERROR;
+    if (NULL == (buf = (double *)HDmalloc(nelmts * sizeof(double))))
+        TEST_ERROR;
+
+    /* Special values first, then random bit patterns, NaNs among them */
+    for (u = 0; u < nelmts; u++) {
+        if (u < NELMTS(special))
+            dvals[u] = special[u];
+        else if (u == NELMTS(special))
+            dvals[u] = HDsqrt(-1.0);
+        else {
+            uint64_t bits =
+                ((uint64_t)HDrandom() << 33) ^ ((uint64_t)HDrandom() << 11) ^ (uint64_t)HDrandom();
+
+            /* Keep most exponents within the range of float */
+            if (u % 4)
+                bits = (bits & ~((uint64_t)0x7ff << 52)) | ((uint64_t)(1023 - 150 + u % 280) << 52);
+            HDmemcpy(&dvals[u], &bits, sizeof(double));
+        } /* end else */
+    }     /* end for */
+
+    /* The expected results, from the hard conversions */
+    HDmemcpy(buf, dvals, nelmts * sizeof(double));
+    if (H5Tconvert(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    HDmemcpy(fexpect, buf, nelmts * sizeof(float));
+    if (H5Tconvert(H5T_NATIVE_FLOAT, H5T_NATIVE_DOUBLE, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    HDmemcpy(dexpect, buf, nelmts * sizeof(double));
+
+    /* Big-endian doubles to native floats, in both byte orders of the machine */
+    HDmemcpy(buf, dvals, nelmts * sizeof(double));
+    if (H5Tconvert(H5T_NATIVE_DOUBLE, H5T_IEEE_F64BE, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (H5Tconvert(H5T_IEEE_F64BE, H5T_NATIVE_FLOAT, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (HDmemcmp(buf, fexpect, nelmts * sizeof(float)) != 0) {
+        H5_FAILED();
+        HDprintf("    big-endian double to float differs from the hard conversion\n");
+        goto error;
+    } /* end if */
+
+    /* Little-endian floats to big-endian doubles and back to native doubles */
+    if (H5Tconvert(H5T_NATIVE_FLOAT, H5T_IEEE_F32LE, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (H5Tconvert(H5T_IEEE_F32LE, H5T_IEEE_F64BE, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (H5Tconvert(H5T_IEEE_F64BE, H5T_NATIVE_DOUBLE, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (HDmemcmp(buf, dexpect, nelmts * sizeof(double)) != 0) {
+        H5_FAILED();
+        HDprintf("    float to big-endian double differs from the hard conversion\n");
+        goto error;
+    } /* end if */
+
+    /* Native floats padded with ones to 8 bytes, and back to native doubles */
+    if ((pad_type = H5Tcopy(H5T_NATIVE_FLOAT)) < 0)
+        TEST_ERROR;
+    if (H5Tset_size(pad_type, (size_t)8) < 0)
+        TEST_ERROR;
+    if (H5Tset_pad(pad_type, H5T_PAD_ZERO, H5T_PAD_ONE) < 0)
+        TEST_ERROR;
+    HDmemcpy(buf, fexpect, nelmts * sizeof(float));
+    if (H5Tconvert(H5T_NATIVE_FLOAT, pad_type, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    for (u = 0; u < nelmts; u++) {
+        const unsigned char *elmt = (const unsigned char *)(buf + u);
+        size_t               val_pos = H5Tget_order(pad_type) == H5T_ORDER_LE ? 0 : 4;
+        size_t               pad_pos = 4 - val_pos;
+
+        if (HDmemcmp(elmt + val_pos, &fexpect[u], sizeof(float)) != 0 || elmt[pad_pos] != 0xff ||
+            elmt[pad_pos + 3] != 0xff) {
+            H5_FAILED();
+            HDprintf("    padded float element %zu is wrong\n", u);
+            goto error;
+        } /* end if */
+    }     /* end for */
+    if (H5Tconvert(pad_type, H5T_NATIVE_DOUBLE, nelmts, buf, NULL, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (HDmemcmp(buf, dexpect, nelmts * sizeof(double)) != 0) {
+        H5_FAILED();
+        HDprintf("    padded float to double differs from the hard conversion\n");
+        goto error;
+    } /* end if */
+
+    if (H5Tclose(pad_type) < 0)
+        TEST_ERROR;
+
+    HDfree(dvals);
+    HDfree(fexpect);
+    HDfree(dexpect);
+    HDfree(buf);
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(pad_type);
+    }
+    H5E_END_TRY;
+    HDfree(dvals);
+    HDfree(fexpect);
+    HDfree(dexpect);
+    HDfree(buf);
+
+    return 1;
+}
+
 /*-------------------------------------------------------------------------
  * Function:    run_integer_tests
  *
@@ -5196,6 +5470,12 @@ main(void)
     /* Test a few special values for hardware float-integer conversions */
     nerrors += (unsigned long)test_particular_fp_integer();
 
+    /* Test long contiguous buffers of hardware and byte order conversions */
+    nerrors += (unsigned long)test_conv_contiguous();
+
+    /* Test the IEEE float conversions between non-native types */
+    nerrors += (unsigned long)test_conv_flt_ieee();
+
     /*----------------------------------------------------------------------
      * Software tests
      *----------------------------------------------------------------------
@@ -16,11 +16,16 @@
 #define COLS      18
 #define FLOAT_TOL 0.0001F
 
+/* Number of elements in the datasets of test_nested(), several blocks of a compiled transform and a
+ * partial one */
+#define NESTED_NELMTS 10000
+
 static int init_test(hid_t file_id);
 static int test_copy(hid_t dxpl_id_c_to_f_copy, hid_t dxpl_id_polynomial_copy);
 static int test_trivial(hid_t dxpl_id_simple);
 static int test_poly(hid_t dxpl_id_polynomial);
 static int test_specials(hid_t file);
+static int test_nested(hid_t file);
 static int test_set(void);
 static int test_getset(hid_t dxpl_id_simple);
 
@@ -399,6 +404,8 @@ main(void)
         TEST_ERROR;
     if (test_specials(file_id) < 0)
         TEST_ERROR;
+    if (test_nested(file_id) < 0)
+        TEST_ERROR;
 
     /* Close the objects we opened/created */
     if (H5Dclose(dset_id_int) < 0)
@@ -778,6 +785,135 @@ error:
     return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_nested
+ *
+ * Purpose:     Checks a transform that uses x several times, in nested
+ *              operations with constants on either side and a unary minus,
+ *              on buffers larger than the blocks a compiled transform is
+ *              evaluated in.  The result of each operation is converted to
+ *              the type of the buffer, as when the parse tree is walked.
+ *
+ * Return:      Success:    0
+ *              Failure:    -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_nested(hid_t file)
+{
+    hid_t       dxpl_id = H5I_INVALID_HID, dset_id = H5I_INVALID_HID, dataspace = H5I_INVALID_HID;
+    hsize_t     dim      = NESTED_NELMTS;
+    int        *int_data = NULL, *int_res = NULL, *int_read = NULL;
+    double     *dbl_data = NULL, *dbl_res = NULL, *dbl_read = NULL;
+    const char *expr     = "(x*x - 3*x)/(2 + x) + -x*0.5 - x*(x + x*x)/1000";
+    size_t      u;
+
+    TESTING("data transform, nested polynomial transform on large buffers");
+
+    if (NULL == (int_data = (int *)HDmalloc(NESTED_NELMTS * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (int_res = (int *)HDmalloc(NESTED_NELMTS * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (int_read = (int *)HDmalloc(NESTED_NELMTS * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (dbl_data = (double *)HDmalloc(NESTED_NELMTS * sizeof(double))))
+        TEST_ERROR;
+    if (NULL == (dbl_res = (double *)HDmalloc(NESTED_NELMTS * sizeof(double))))
+        TEST_ERROR;
+    if (NULL == (dbl_read = (double *)HDmalloc(NESTED_NELMTS * sizeof(double))))
+        TEST_ERROR;
+
+    for (u = 0; u < NESTED_NELMTS; u++) {
+        int    x = (int)(u % 50);
+        double y = (double)u / 7.0;
+        int    t;
+
+        int_data[u] = x;
+        dbl_data[u] = y;
+
+        /* Convert the result of each operation to int */
+        t          = x * x - (int)(3.0 * x);
+        t          = t / (int)(2.0 + x);
+        t          = t + (int)((double)(int)(0.0 - x) * 0.5);
+        int_res[u] = t - (int)((double)(x * (x + x * x)) / 1000.0);
+
+        dbl_res[u] = (y * y - 3 * y) / (2 + y) + -y * 0.5 - y * (y + y * y) / 1000;
+    }
+
+    if ((dataspace = H5Screate_simple(1, &dim, NULL)) < 0)
+        TEST_ERROR;
+    if ((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR;
+    if (H5Pset_data_transform(dxpl_id, expr) < 0)
+        TEST_ERROR;
+
+    /* int */
+    if ((dset_id = H5Dcreate2(file, "/nested_int", H5T_NATIVE_INT, dataspace, H5P_DEFAULT, H5P_DEFAULT,
+                              H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl_id, int_data) < 0)
+        TEST_ERROR;
+    if (H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, int_read) < 0)
+        TEST_ERROR;
+    for (u = 0; u < NESTED_NELMTS; u++)
+        if (int_read[u] != int_res[u]) {
+            H5_FAILED();
+            HDfprintf(stderr, "    ERROR: element %zu is %d, expected %d\n", u, int_read[u], int_res[u]);
+            goto error;
+        }
+    if (H5Dclose(dset_id) < 0)
+        TEST_ERROR;
+
+    /* double */
+    if ((dset_id = H5Dcreate2(file, "/nested_double", H5T_NATIVE_DOUBLE, dataspace, H5P_DEFAULT, H5P_DEFAULT,
+                              H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    if (H5Dwrite(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl_id, dbl_data) < 0)
+        TEST_ERROR;
+    if (H5Dread(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, dbl_read) < 0)
+        TEST_ERROR;
+    for (u = 0; u < NESTED_NELMTS; u++)
+        if (HDfabs(dbl_read[u] - dbl_res[u]) > 1e-9 * MAX(1.0, HDfabs(dbl_res[u]))) {
+            H5_FAILED();
+            HDfprintf(stderr, "    ERROR: element %zu is %g, expected %g\n", u, dbl_read[u], dbl_res[u]);
+            goto error;
+        }
+    if (H5Dclose(dset_id) < 0)
+        TEST_ERROR;
+
+    if (H5Pclose(dxpl_id) < 0)
+        TEST_ERROR;
+    if (H5Sclose(dataspace) < 0)
+        TEST_ERROR;
+
+    HDfree(int_data);
+    HDfree(int_res);
+    HDfree(int_read);
+    HDfree(dbl_data);
+    HDfree(dbl_res);
+    HDfree(dbl_read);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dset_id);
+        H5Pclose(dxpl_id);
+        H5Sclose(dataspace);
+    }
+    H5E_END_TRY
+    HDfree(int_data);
+    HDfree(int_res);
+    HDfree(int_read);
+    HDfree(dbl_data);
+    HDfree(dbl_res);
+    HDfree(dbl_read);
+    return -1;
+}
+
 static int
 test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy)
 {
@@ -5966,6 +5966,139 @@ error:
     return 1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_conv_path_cache
+ *
+ * Purpose:     Tests that repeated conversion path lookups, which are
+ *              answered from the library's path cache, follow changes to the
+ *              registered conversion functions and to the datatypes used.
+ *
+ * Return:      Success:    0
+ *              Failure:    number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define PATH_CACHE_NELMTS 16
+static int
+test_conv_path_cache(void)
+{
+    typedef struct {
+        int    a;
+        double b;
+    } src_t;
+    typedef struct {
+        double b;
+        int    a;
+    } dst_t;
+    typedef struct {
+        double b;
+    } dst2_t;
+    src_t         src[PATH_CACHE_NELMTS];
+    unsigned char buf[PATH_CACHE_NELMTS * sizeof(src_t)];
+    unsigned char bkg[PATH_CACHE_NELMTS * sizeof(src_t)];
+    dst_t         dst;
+    dst2_t        dst2;
+    hid_t         st = H5I_INVALID_HID, dt = H5I_INVALID_HID;
+    int           saved;
+    unsigned      u, pass;
+
+    TESTING("conversion path cache");
+
+    for (u = 0; u < PATH_CACHE_NELMTS; u++) {
+        src[u].a = (int)u * 3 - 7;
+        src[u].b = (double)u / 4.0;
+    } /* end for */
+
+    if ((st = H5Tcreate(H5T_COMPOUND, sizeof(src_t))) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(st, "a", HOFFSET(src_t, a), H5T_NATIVE_INT) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(st, "b", HOFFSET(src_t, b), H5T_NATIVE_DOUBLE) < 0)
+        TEST_ERROR;
+    if ((dt = H5Tcreate(H5T_COMPOUND, sizeof(dst_t))) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(dt, "b", HOFFSET(dst_t, b), H5T_NATIVE_DOUBLE) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(dt, "a", HOFFSET(dst_t, a), H5T_NATIVE_INT) < 0)
+        TEST_ERROR;
+
+    /* Convert several times, so that later lookups hit the cached path */
+    for (pass = 0; pass < 3; pass++) {
+        HDmemcpy(buf, src, sizeof(src));
+        HDmemset(bkg, 0, sizeof(bkg));
+        if (H5Tconvert(st, dt, (size_t)PATH_CACHE_NELMTS, buf, bkg, H5P_DEFAULT) < 0)
+            TEST_ERROR;
+        for (u = 0; u < PATH_CACHE_NELMTS; u++) {
+            HDmemcpy(&dst, buf + u * sizeof(dst_t), sizeof(dst_t));
+            if (dst.a != src[u].a || !H5_DBL_ABS_EQUAL(dst.b, src[u].b)) {
+                H5_FAILED();
+                HDprintf("    pass %u, element %u: got {%g, %d}\n", pass, u, dst.b, dst.a);
+                goto error;
+            } /* end if */
+        }     /* end for */
+    }         /* end for */
+
+    /* A newly registered hard function must replace the cached path */
+    saved = num_opaque_conversions_g;
+    if (H5Tregister(H5T_PERS_HARD, "cache_test", st, dt, convert_opaque) < 0)
+        TEST_ERROR;
+    HDmemcpy(buf, src, sizeof(src));
+    if (H5Tconvert(st, dt, (size_t)PATH_CACHE_NELMTS, buf, bkg, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (num_opaque_conversions_g != saved + 1 || HDmemcmp(buf, src, sizeof(src)) != 0)
+        FAIL_PUTS_ERROR("    registered conversion function was not used");
+
+    /* ... and unregistering it must not leave a stale path behind */
+    if (H5Tunregister(H5T_PERS_HARD, "cache_test", st, dt, convert_opaque) < 0)
+        TEST_ERROR;
+    HDmemcpy(buf, src, sizeof(src));
+    if (H5Tconvert(st, dt, (size_t)PATH_CACHE_NELMTS, buf, bkg, H5P_DEFAULT) < 0)
+        TEST_ERROR;
+    if (num_opaque_conversions_g != saved + 1)
+        FAIL_PUTS_ERROR("    unregistered conversion function was used");
+    for (u = 0; u < PATH_CACHE_NELMTS; u++) {
+        HDmemcpy(&dst, buf + u * sizeof(dst_t), sizeof(dst_t));
+        if (dst.a != src[u].a || !H5_DBL_ABS_EQUAL(dst.b, src[u].b))
+            FAIL_PUTS_ERROR("    wrong value after unregistering conversion function");
+    } /* end for */
+
+    /* A different destination type, likely at the address of the old one */
+    if (H5Tclose(dt) < 0)
+        TEST_ERROR;
+    if ((dt = H5Tcreate(H5T_COMPOUND, sizeof(dst2_t))) < 0)
+        TEST_ERROR;
+    if (H5Tinsert(dt, "b", HOFFSET(dst2_t, b), H5T_NATIVE_DOUBLE) < 0)
+        TEST_ERROR;
+    for (pass = 0; pass < 2; pass++) {
+        HDmemcpy(buf, src, sizeof(src));
+        HDmemset(bkg, 0, sizeof(bkg));
+        if (H5Tconvert(st, dt, (size_t)PATH_CACHE_NELMTS, buf, bkg, H5P_DEFAULT) < 0)
+            TEST_ERROR;
+        for (u = 0; u < PATH_CACHE_NELMTS; u++) {
+            HDmemcpy(&dst2, buf + u * sizeof(dst2_t), sizeof(dst2_t));
+            if (!H5_DBL_ABS_EQUAL(dst2.b, src[u].b))
+                FAIL_PUTS_ERROR("    wrong value for subset destination type");
+        } /* end for */
+    }     /* end for */
+
+    if (H5Tclose(st) < 0)
+        TEST_ERROR;
+    if (H5Tclose(dt) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(st);
+        H5Tclose(dt);
+    }
+    H5E_END_TRY
+    return 1;
+} /* end test_conv_path_cache() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_encode
  *
@@ -8953,6 +9086,7 @@ main(void)
     nerrors += test_conv_bitfield();
     nerrors += test_bitfield_funcs();
     nerrors += test_opaque();
+    nerrors += test_conv_path_cache();
     nerrors += test_set_order();
 
     if (!driver_is_parallel) {
@@ -895,6 +895,9 @@ void
 h5_no_hwconv(void)
 {
     H5Tunregister(H5T_PERS_HARD, NULL, (hid_t)-1, (hid_t)-1, NULL);
+
+    /* The IEEE float conversion uses the hardware conversions too */
+    H5Tunregister(H5T_PERS_SOFT, "f_f(ieee)", (hid_t)-1, (hid_t)-1, NULL);
 }
 
 /*-------------------------------------------------------------------------
@@ -1142,6 +1145,12 @@ h5_get_file_size(const char *filename, hid_t fapl)
 #ifdef H5_HAVE_DIRECT
             driver == H5FD_DIRECT ||
 #endif /* H5_HAVE_DIRECT */
+#ifdef H5_HAVE_IOURING_VFD
+            driver == H5FD_IOURING ||
+#endif /* H5_HAVE_IOURING_VFD */
+#ifdef H5_HAVE_MMAP
+            driver == H5FD_MMAP ||
+#endif /* H5_HAVE_MMAP */
             driver == H5FD_LOG || driver == H5FD_SPLITTER) {
             /* Get the file's statistics */
             if (0 == HDstat(filename, &sb))
@@ -2974,6 +2974,27 @@ test_no_selection_io_cause_mode(const char *filename, hid_t fapl, uint32_t test_
         no_selection_io_cause_read_expected |= H5D_SEL_IO_PAGE_BUFFER;
     }
 
+#ifdef H5_HAVE_PREADWRITEV
+    /* The sec2 driver has vector I/O callbacks.  Selection I/O is still off by default for it, but when it
+     * is turned on the I/O is not broken up at the VFL */
+    if (h5_using_default_driver(NULL)) {
+        no_selection_io_cause_write_expected &= ~(uint32_t)H5D_SEL_IO_NO_VECTOR_OR_SELECTION_IO_CB;
+        no_selection_io_cause_read_expected &= ~(uint32_t)H5D_SEL_IO_NO_VECTOR_OR_SELECTION_IO_CB;
+    }
+#endif
+#ifdef H5_HAVE_IOURING_VFD
+    /* The io_uring driver has vector I/O callbacks, so selection I/O is on by default, the sieve buffer is
+     * never used and the I/O is never broken up at the VFL */
+    if (!h5_using_default_driver(NULL) && !HDstrcmp(HDgetenv(HDF5_DRIVER), "iouring")) {
+        no_selection_io_cause_write_expected &= ~(uint32_t)(H5D_SEL_IO_CONTIGUOUS_SIEVE_BUFFER |
+                                                            H5D_SEL_IO_DEFAULT_OFF |
+                                                            H5D_SEL_IO_NO_VECTOR_OR_SELECTION_IO_CB);
+        no_selection_io_cause_read_expected &= ~(uint32_t)(H5D_SEL_IO_CONTIGUOUS_SIEVE_BUFFER |
+                                                           H5D_SEL_IO_DEFAULT_OFF |
+                                                           H5D_SEL_IO_NO_VECTOR_OR_SELECTION_IO_CB);
+    }
+#endif
+
     /* Create 1d data space */
     dims[0] = DSET_SELECT_DIM;
     if ((sid = H5Screate_simple(1, dims, NULL)) < 0)
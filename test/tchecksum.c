@@ -212,6 +212,283 @@ test_chksum_large(void)
     HDfree(large_buf);
 } /* test_chksum_large() */
 
+/****************************************************************
+**
+**  test_chksum_crc32c(): Checksum buffers with the CRC32C
+**      algorithm, comparing against published check values
+**
+****************************************************************/
+static void
+test_chksum_crc32c(void)
+{
+    uint8_t  buf[32]; /* Buffer to checksum */
+    uint32_t chksum;  /* Checksum value */
+    size_t   u;       /* Local index variable */
+
+    /* The standard check value */
+    chksum = H5_checksum_crc32c("123456789", (size_t)9);
+    VERIFY(chksum, 0xe3069283, "H5_checksum_crc32c");
+
+    /* The test vectors of RFC 3720, section B.4 */
+    HDmemset(buf, 0, sizeof(buf));
+    chksum = H5_checksum_crc32c(buf, sizeof(buf));
+    VERIFY(chksum, 0x8a9136aa, "H5_checksum_crc32c");
+
+    HDmemset(buf, 0xff, sizeof(buf));
+    chksum = H5_checksum_crc32c(buf, sizeof(buf));
+    VERIFY(chksum, 0x62a8ab43, "H5_checksum_crc32c");
+
+    for (u = 0; u < sizeof(buf); u++)
+        buf[u] = (uint8_t)u;
+    chksum = H5_checksum_crc32c(buf, sizeof(buf));
+    VERIFY(chksum, 0x46dd794e, "H5_checksum_crc32c");
+} /* test_chksum_crc32c() */
+
+/****************************************************************
+**
+**  ref_fletcher32(), ref_lookup3(), ref_crc32c(): Reference
+**      versions of the checksums, computed a byte at a time,
+**      which the library's word and vector versions must match.
+**
+****************************************************************/
+static uint32_t
+ref_fletcher32(const uint8_t *data, size_t _len)
+{
+    size_t   len  = _len / 2;
+    uint32_t sum1 = 0, sum2 = 0;
+
+    while (len) {
+        size_t tlen = len > 360 ? 360 : len;
+        len -= tlen;
+        do {
+            sum1 += (uint32_t)(((uint16_t)data[0]) << 8) | ((uint16_t)data[1]);
+            data += 2;
+            sum2 += sum1;
+        } while (--tlen);
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+
+    if (_len % 2) {
+        sum1 += (uint32_t)(((uint16_t)*data) << 8);
+        sum2 += sum1;
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+
+    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+
+    return (sum2 << 16) | sum1;
+} /* ref_fletcher32() */
+
+#define REF_ROT(x, k) (((x) << (k)) ^ ((x) >> (32 - (k))))
+
+static uint32_t
+ref_lookup3(const uint8_t *k, size_t length, uint32_t initval)
+{
+    uint32_t v[3];
+    unsigned i;
+
+    v[0] = v[1] = v[2] = 0xdeadbeef + ((uint32_t)length) + initval;
+
+    while (length > 12) {
+        for (i = 0; i < 12; i++)
+            v[i / 4] += ((uint32_t)k[i]) << (8 * (i % 4));
+
+        /* mix() */
+        v[0] -= v[2], v[0] ^= REF_ROT(v[2], 4), v[2] += v[1];
+        v[1] -= v[0], v[1] ^= REF_ROT(v[0], 6), v[0] += v[2];
+        v[2] -= v[1], v[2] ^= REF_ROT(v[1], 8), v[1] += v[0];
+        v[0] -= v[2], v[0] ^= REF_ROT(v[2], 16), v[2] += v[1];
+        v[1] -= v[0], v[1] ^= REF_ROT(v[0], 19), v[0] += v[2];
+        v[2] -= v[1], v[2] ^= REF_ROT(v[1], 4), v[1] += v[0];
+
+        length -= 12;
+        k += 12;
+    }
+
+    if (length == 0)
+        return v[2];
+    for (i = 0; i < length; i++)
+        v[i / 4] += ((uint32_t)k[i]) << (8 * (i % 4));
+
+    /* final() */
+    v[2] ^= v[1], v[2] -= REF_ROT(v[1], 14);
+    v[0] ^= v[2], v[0] -= REF_ROT(v[2], 11);
+    v[1] ^= v[0], v[1] -= REF_ROT(v[0], 25);
+    v[2] ^= v[1], v[2] -= REF_ROT(v[1], 16);
+    v[0] ^= v[2], v[0] -= REF_ROT(v[2], 4);
+    v[1] ^= v[0], v[1] -= REF_ROT(v[0], 14);
+    v[2] ^= v[1], v[2] -= REF_ROT(v[1], 24);
+
+    return v[2];
+} /* ref_lookup3() */
+
+static uint32_t
+ref_crc32c(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    unsigned k;
+
+    while (len--) {
+        crc ^= *data++;
+        for (k = 0; k < 8; k++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+    }
+
+    return crc ^ 0xffffffff;
+} /* ref_crc32c() */
+
+/****************************************************************
+**
+**  test_chksum_reference(): Compare the checksums of buffers of
+**      many lengths and alignments, and of data which stresses
+**      the reduction of the sums, against the reference versions.
+**
+****************************************************************/
+static void
+test_chksum_reference(void)
+{
+    const size_t lengths[] = {1, 2, 3, 11, 12, 13, 24, 25, 127, 128, 129, 255, 256, 257, 720, 721, 4095,
+                              4096, 4097, 8191, 8192, 8193, 16384, 33000, 65537};
+    uint8_t     *buf;                  /* Buffer for checksum calculations */
+    unsigned     pattern;              /* Kind of data in the buffer */
+    size_t       max_len = 65537 + 32; /* Size of the buffer */
+    size_t       u, v;                 /* Local index variables */
+
+    buf = (uint8_t *)HDmalloc(max_len);
+    CHECK_PTR(buf, "HDmalloc");
+
+    for (pattern = 0; pattern < 4; pattern++) {
+        /* Random, all ones (the largest sums), all zeros, and zeros with
+         * a few ones */
+        for (u = 0; u < max_len; u++)
+            switch (pattern) {
+                case 0:
+                    buf[u] = (uint8_t)HDrandom();
+                    break;
+                case 1:
+                    buf[u] = 0xff;
+                    break;
+                case 2:
+                    buf[u] = 0;
+                    break;
+                default:
+                    buf[u] = (uint8_t)((u % 4099) == 4000 ? 1 : 0);
+                    break;
+            } /* end switch */
+
+        for (u = 0; u < NELMTS(lengths); u++)
+            for (v = 0; v < 32; v += 7) {
+                const uint8_t *data = buf + v;
+                size_t         len  = lengths[u];
+
+                VERIFY(H5_checksum_fletcher32(data, len), ref_fletcher32(data, len),
+                       "H5_checksum_fletcher32");
+                VERIFY(H5_checksum_lookup3(data, len, 0), ref_lookup3(data, len, 0), "H5_checksum_lookup3");
+                VERIFY(H5_checksum_lookup3(data, len, 0x12345678), ref_lookup3(data, len, 0x12345678),
+                       "H5_checksum_lookup3");
+                VERIFY(H5_checksum_crc32c(data, len), ref_crc32c(data, len), "H5_checksum_crc32c");
+            } /* end for */
+    }         /* end for */
+
+    HDfree(buf);
+} /* test_chksum_reference() */
+
+/* Checksums with a common signature, for timing */
+typedef uint32_t (*chksum_func_t)(const void *data, size_t len);
+
+static uint32_t
+lib_fletcher32(const void *data, size_t len)
+{
+    return H5_checksum_fletcher32(data, len);
+}
+static uint32_t
+lib_metadata(const void *data, size_t len)
+{
+    return H5_checksum_metadata(data, len, 0);
+}
+static uint32_t
+lib_crc32c(const void *data, size_t len)
+{
+    return H5_checksum_crc32c(data, len);
+}
+static uint32_t
+ref_fletcher32_func(const void *data, size_t len)
+{
+    return ref_fletcher32((const uint8_t *)data, len);
+}
+static uint32_t
+ref_lookup3_func(const void *data, size_t len)
+{
+    return ref_lookup3((const uint8_t *)data, len, 0);
+}
+static uint32_t
+ref_crc32c_func(const void *data, size_t len)
+{
+    return ref_crc32c((const uint8_t *)data, len);
+}
+
+/****************************************************************
+**
+**  time_chksum(): Time NPASSES checksums of a buffer, returning
+**      the bandwidth in MB/s and the checksum in CHKSUM.
+**
+****************************************************************/
+static double
+time_chksum(chksum_func_t func, const uint8_t *buf, size_t len, unsigned npasses, uint32_t *chksum)
+{
+    /* Call through a volatile pointer so the passes aren't merged */
+    chksum_func_t volatile vfunc = func;
+    uint64_t               start, elapsed;
+    unsigned               u;
+
+    start = H5_now_usec();
+    for (u = 0; u < npasses; u++)
+        *chksum = vfunc(buf, len);
+    elapsed = H5_now_usec() - start;
+
+    return ((double)len * npasses) / (double)(elapsed ? elapsed : 1);
+} /* time_chksum() */
+
+/****************************************************************
+**
+**  test_chksum_speed(): Measure the bandwidth of the checksums
+**      against the reference versions, printed at high
+**      verbosity, and check they agree on a larger buffer.
+**
+****************************************************************/
+static void
+test_chksum_speed(void)
+{
+    const char         *names[]     = {"fletcher32", "lookup3", "crc32c"};
+    const chksum_func_t lib_funcs[] = {lib_fletcher32, lib_metadata, lib_crc32c};
+    const chksum_func_t ref_funcs[] = {ref_fletcher32_func, ref_lookup3_func, ref_crc32c_func};
+    uint8_t            *buf;                   /* Buffer for checksum calculations */
+    size_t              len     = 1024 * 1024; /* Size of the buffer */
+    unsigned            npasses = 4;           /* Number of passes of each checksum */
+    size_t              u;                     /* Local index variable */
+
+    buf = (uint8_t *)HDmalloc(len);
+    CHECK_PTR(buf, "HDmalloc");
+    for (u = 0; u < len; u++)
+        buf[u] = (uint8_t)HDrandom();
+
+    for (u = 0; u < NELMTS(names); u++) {
+        uint32_t lib_chksum = 0, ref_chksum = 0;
+        double   lib_mbps, ref_mbps;
+
+        lib_mbps = time_chksum(lib_funcs[u], buf, len, npasses, &lib_chksum);
+        ref_mbps = time_chksum(ref_funcs[u], buf, len, npasses, &ref_chksum);
+        VERIFY(lib_chksum, ref_chksum, names[u]);
+
+        MESSAGE(7, ("%-10s: library %8.1f MB/s, reference %8.1f MB/s\n", names[u], lib_mbps, ref_mbps));
+    } /* end for */
+
+    HDfree(buf);
+} /* test_chksum_speed() */
+
 /****************************************************************
 **
 **  test_checksum(): Main checksum testing routine.
@@ -229,6 +506,9 @@ test_checksum(void)
     test_chksum_size_three(); /* Test buffer w/only 3 bytes */
     test_chksum_size_four();  /* Test buffer w/only 4 bytes */
     test_chksum_large();      /* Test buffer w/larger # of bytes */
+    test_chksum_crc32c();     /* Test the CRC32C check values */
+    test_chksum_reference();  /* Test against the reference versions */
+    test_chksum_speed();      /* Test the speed of the checksums */
 
 } /* test_checksum() */
 
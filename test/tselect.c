@@ -5677,6 +5677,92 @@ test_select_hyper_valid_combination(void)
     CHECK(ret, FAIL, "H5Sclose");
 } /* test_select_hyper_valid_combination() */
 
+/****************************************************************
+**
+**  test_select_hyper_combine_empty(): Test H5Scombine_select when
+**      the combination of two hyperslab selections selects nothing.
+**
+****************************************************************/
+static void
+test_select_hyper_combine_empty(void)
+{
+    hid_t    sid1, sid2; /* Dataspace IDs */
+    hid_t    tmp_sid;    /* Temporary dataspace ID */
+    hsize_t  dims2D[] = {SPACE9_DIM1, SPACE9_DIM2};
+    hsize_t  start[SPACE9_RANK]; /* Hyperslab start */
+    hsize_t  count[SPACE9_RANK]; /* Hyperslab block count */
+    hsize_t  block[SPACE9_RANK]; /* Hyperslab block size */
+    hssize_t npoints;            /* Number of elements in selection */
+    herr_t   ret;                /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(6, ("Testing Combining Hyperslabs into an Empty Selection\n"));
+
+    /* Create dataspaces with the same irregular hyperslab selection, so that
+     * they have span trees */
+    sid1 = H5Screate_simple(SPACE9_RANK, dims2D, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+    start[0] = 1;
+    start[1] = 1;
+    count[0] = 1;
+    count[1] = 1;
+    block[0] = 2;
+    block[1] = 4;
+    ret      = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, start, NULL, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    start[0] = 5;
+    start[1] = 2;
+    block[0] = 3;
+    block[1] = 1;
+    ret      = H5Sselect_hyperslab(sid1, H5S_SELECT_OR, start, NULL, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    sid2 = H5Scopy(sid1);
+    CHECK(sid2, FAIL, "H5Scopy");
+
+    /* Combinations of the same elements that select nothing */
+    tmp_sid = H5Scombine_select(sid1, H5S_SELECT_XOR, sid2);
+    CHECK(tmp_sid, FAIL, "H5Scombine_select");
+    VERIFY(H5Sget_select_type(tmp_sid), H5S_SEL_NONE, "H5Sget_select_type");
+    npoints = H5Sget_select_npoints(tmp_sid);
+    VERIFY(npoints, 0, "H5Sget_select_npoints");
+    ret = H5Sclose(tmp_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    tmp_sid = H5Scombine_select(sid1, H5S_SELECT_NOTB, sid2);
+    CHECK(tmp_sid, FAIL, "H5Scombine_select");
+    VERIFY(H5Sget_select_type(tmp_sid), H5S_SEL_NONE, "H5Sget_select_type");
+    ret = H5Sclose(tmp_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    tmp_sid = H5Scombine_select(sid1, H5S_SELECT_NOTA, sid2);
+    CHECK(tmp_sid, FAIL, "H5Scombine_select");
+    VERIFY(H5Sget_select_type(tmp_sid), H5S_SEL_NONE, "H5Sget_select_type");
+    ret = H5Sclose(tmp_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    /* Disjoint selections have an empty intersection */
+    start[0] = 0;
+    start[1] = 7;
+    block[0] = 1;
+    block[1] = 1;
+    ret      = H5Sselect_hyperslab(sid2, H5S_SELECT_SET, start, NULL, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    start[0] = 9;
+    ret      = H5Sselect_hyperslab(sid2, H5S_SELECT_OR, start, NULL, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    tmp_sid = H5Scombine_select(sid1, H5S_SELECT_AND, sid2);
+    CHECK(tmp_sid, FAIL, "H5Scombine_select");
+    VERIFY(H5Sget_select_type(tmp_sid), H5S_SEL_NONE, "H5Sget_select_type");
+    ret = H5Sclose(tmp_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    /* Close dataspaces */
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid2);
+    CHECK(ret, FAIL, "H5Sclose");
+} /* test_select_hyper_combine_empty() */
+
 /****************************************************************
 **
 **  test_select_hyper_and_2d(): Test basic H5S (dataspace) selection code.
@@ -15968,6 +16054,204 @@ test_hyper_io_1d(void)
 
 } /* test_hyper_io_1d() */
 
+/****************************************************************
+**
+**  test_select_hyper_blocklist_verify(): Verify that two selections
+**    select the same elements.
+**
+****************************************************************/
+static void
+test_select_hyper_blocklist_verify(hid_t sid1, hid_t sid2, const char *where)
+{
+    hid_t    xor_sid;  /* Dataspace with the elements of only one selection */
+    hssize_t npoints1; /* Number of elements in first selection */
+    hssize_t npoints2; /* Number of elements in second selection */
+    hssize_t nxor;     /* Number of elements in only one selection */
+    herr_t   ret;      /* Generic return value */
+
+    npoints1 = H5Sget_select_npoints(sid1);
+    CHECK(npoints1, FAIL, "H5Sget_select_npoints");
+    npoints2 = H5Sget_select_npoints(sid2);
+    CHECK(npoints2, FAIL, "H5Sget_select_npoints");
+    VERIFY(npoints2, npoints1, where);
+
+    /* Selections of the same elements have an empty 'xor' */
+    if (npoints1 > 0 && H5Sget_select_type(sid1) == H5S_SEL_HYPERSLABS &&
+        H5Sget_select_type(sid2) == H5S_SEL_HYPERSLABS) {
+        xor_sid = H5Scopy(sid1);
+        CHECK(xor_sid, FAIL, "H5Scopy");
+        ret = H5Smodify_select(xor_sid, H5S_SELECT_XOR, sid2);
+        CHECK(ret, FAIL, "H5Smodify_select");
+        nxor = H5Sget_select_npoints(xor_sid);
+        VERIFY(nxor, 0, where);
+        ret = H5Sclose(xor_sid);
+        CHECK(ret, FAIL, "H5Sclose");
+    } /* end if */
+} /* test_select_hyper_blocklist_verify() */
+
+/****************************************************************
+**
+**  test_select_hyper_blocklist(): Test building hyperslab
+**    selections from lists of blocks and points with
+**    H5Sselect_hyper_blocklist() and H5Sselect_hyper_pointlist().
+**
+****************************************************************/
+#define BLOCKLIST_RANK    3
+#define BLOCKLIST_DIM1    20
+#define BLOCKLIST_DIM2    30
+#define BLOCKLIST_DIM3    40
+#define BLOCKLIST_NBLOCKS 300
+#define BLOCKLIST_NPOINTS 1000
+static void
+test_select_hyper_blocklist(void)
+{
+    hsize_t             dims[BLOCKLIST_RANK] = {BLOCKLIST_DIM1, BLOCKLIST_DIM2, BLOCKLIST_DIM3};
+    hsize_t             start[BLOCKLIST_RANK];  /* Hyperslab start */
+    hsize_t             stride[BLOCKLIST_RANK]; /* Hyperslab stride */
+    hsize_t             count[BLOCKLIST_RANK];  /* Hyperslab count */
+    hsize_t             block[BLOCKLIST_RANK];  /* Hyperslab block */
+    hsize_t             ones[BLOCKLIST_RANK] = {1, 1, 1}; /* Hyperslab count of one block */
+    hsize_t            *blocks;                 /* List of blocks */
+    hsize_t            *points;                 /* List of points */
+    hsize_t             row[4][2] = {{5, 3}, {5, 1}, {5, 2}, {5, 2}}; /* Points in a row */
+    hid_t               base_sid;                                     /* Selection to combine with */
+    hid_t               ref_sid;  /* Dataspace with the blocks selected one at a time */
+    hid_t               list_sid; /* Dataspace with the blocks selected as a list */
+    hid_t               op_sid;   /* Dataspace for combining with the blocks one at a time */
+    hid_t               bulk_sid; /* Dataspace for combining with the list of blocks */
+    const H5S_seloper_t ops[]   = {H5S_SELECT_OR, H5S_SELECT_AND, H5S_SELECT_XOR, H5S_SELECT_NOTB,
+                                 H5S_SELECT_NOTA};
+    H5S_sel_type        sel_type; /* Type of selection */
+    hssize_t            npoints;  /* Number of elements selected */
+    hssize_t            nblocks;  /* Number of blocks selected */
+    size_t              u, v;     /* Local index variables */
+    herr_t              ret;      /* Generic return value */
+
+    /* Output message about test being performed */
+    MESSAGE(6, ("Testing Building Hyperslab Selections from Lists of Blocks and Points\n"));
+
+    blocks = (hsize_t *)HDmalloc(BLOCKLIST_NBLOCKS * 2 * BLOCKLIST_RANK * sizeof(hsize_t));
+    CHECK_PTR(blocks, "HDmalloc");
+    points = (hsize_t *)HDmalloc(BLOCKLIST_NPOINTS * BLOCKLIST_RANK * sizeof(hsize_t));
+    CHECK_PTR(points, "HDmalloc");
+
+    /* Generate random, overlapping blocks and points */
+    HDsrandom(BLOCKLIST_NBLOCKS);
+    for (u = 0; u < BLOCKLIST_NBLOCKS; u++)
+        for (v = 0; v < BLOCKLIST_RANK; v++) {
+            blocks[u * 2 * BLOCKLIST_RANK + v] = (hsize_t)HDrandom() % (dims[v] - 4);
+            blocks[u * 2 * BLOCKLIST_RANK + BLOCKLIST_RANK + v] =
+                blocks[u * 2 * BLOCKLIST_RANK + v] + (hsize_t)HDrandom() % 5;
+        } /* end for */
+    for (u = 0; u < BLOCKLIST_NPOINTS; u++)
+        for (v = 0; v < BLOCKLIST_RANK; v++)
+            points[u * BLOCKLIST_RANK + v] = (hsize_t)HDrandom() % (dims[v] / 2);
+
+    ref_sid = H5Screate_simple(BLOCKLIST_RANK, dims, NULL);
+    CHECK(ref_sid, FAIL, "H5Screate_simple");
+    list_sid = H5Screate_simple(BLOCKLIST_RANK, dims, NULL);
+    CHECK(list_sid, FAIL, "H5Screate_simple");
+
+    /* Select the blocks one at a time, and as a list */
+    for (u = 0; u < BLOCKLIST_NBLOCKS; u++) {
+        for (v = 0; v < BLOCKLIST_RANK; v++)
+            block[v] = blocks[u * 2 * BLOCKLIST_RANK + BLOCKLIST_RANK + v] - blocks[u * 2 * BLOCKLIST_RANK + v] + 1;
+        ret = H5Sselect_hyperslab(ref_sid, (u == 0 ? H5S_SELECT_SET : H5S_SELECT_OR),
+                                  &blocks[u * 2 * BLOCKLIST_RANK], NULL, ones, block);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    } /* end for */
+    ret = H5Sselect_hyper_blocklist(list_sid, H5S_SELECT_SET, (hsize_t)BLOCKLIST_NBLOCKS, blocks);
+    CHECK(ret, FAIL, "H5Sselect_hyper_blocklist");
+    test_select_hyper_blocklist_verify(ref_sid, list_sid, "H5Sselect_hyper_blocklist");
+
+    /* Combine the list of blocks with a regular selection, with each operator */
+    base_sid = H5Screate_simple(BLOCKLIST_RANK, dims, NULL);
+    CHECK(base_sid, FAIL, "H5Screate_simple");
+    for (v = 0; v < BLOCKLIST_RANK; v++) {
+        start[v]  = 1;
+        stride[v] = 4;
+        count[v]  = (dims[v] - 1) / 4;
+        block[v]  = 3;
+    } /* end for */
+    ret = H5Sselect_hyperslab(base_sid, H5S_SELECT_SET, start, stride, count, block);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    for (u = 0; u < NELMTS(ops); u++) {
+        op_sid = H5Scopy(base_sid);
+        CHECK(op_sid, FAIL, "H5Scopy");
+        ret = H5Smodify_select(op_sid, ops[u], ref_sid);
+        CHECK(ret, FAIL, "H5Smodify_select");
+
+        bulk_sid = H5Scopy(base_sid);
+        CHECK(bulk_sid, FAIL, "H5Scopy");
+        ret = H5Sselect_hyper_blocklist(bulk_sid, ops[u], (hsize_t)BLOCKLIST_NBLOCKS, blocks);
+        CHECK(ret, FAIL, "H5Sselect_hyper_blocklist");
+
+        test_select_hyper_blocklist_verify(op_sid, bulk_sid, "H5Sselect_hyper_blocklist");
+
+        ret = H5Sclose(op_sid);
+        CHECK(ret, FAIL, "H5Sclose");
+        ret = H5Sclose(bulk_sid);
+        CHECK(ret, FAIL, "H5Sclose");
+    } /* end for */
+
+    /* Select the points one at a time, and as a list */
+    for (u = 0; u < BLOCKLIST_NPOINTS; u++) {
+        ret = H5Sselect_hyperslab(ref_sid, (u == 0 ? H5S_SELECT_SET : H5S_SELECT_OR),
+                                  &points[u * BLOCKLIST_RANK], NULL, ones, NULL);
+        CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    } /* end for */
+    ret = H5Sselect_hyper_pointlist(list_sid, H5S_SELECT_SET, (size_t)BLOCKLIST_NPOINTS, points);
+    CHECK(ret, FAIL, "H5Sselect_hyper_pointlist");
+    test_select_hyper_blocklist_verify(ref_sid, list_sid, "H5Sselect_hyper_pointlist");
+
+    /* Adding the points again doesn't change the selection */
+    ret = H5Sselect_hyper_pointlist(list_sid, H5S_SELECT_OR, (size_t)BLOCKLIST_NPOINTS, points);
+    CHECK(ret, FAIL, "H5Sselect_hyper_pointlist");
+    test_select_hyper_blocklist_verify(ref_sid, list_sid, "H5Sselect_hyper_pointlist");
+
+    /* Adjacent and duplicate points are merged into a regular block */
+    ret = H5Sclose(list_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    list_sid = H5Screate_simple(2, dims, NULL);
+    CHECK(list_sid, FAIL, "H5Screate_simple");
+    ret = H5Sselect_hyper_pointlist(list_sid, H5S_SELECT_SET, (size_t)4, &row[0][0]);
+    CHECK(ret, FAIL, "H5Sselect_hyper_pointlist");
+    npoints = H5Sget_select_npoints(list_sid);
+    VERIFY(npoints, 3, "H5Sget_select_npoints");
+    nblocks = H5Sget_select_hyper_nblocks(list_sid);
+    VERIFY(nblocks, 1, "H5Sget_select_hyper_nblocks");
+    ret = H5Sis_regular_hyperslab(list_sid);
+    VERIFY(ret, TRUE, "H5Sis_regular_hyperslab");
+
+    /* An empty list of blocks selects nothing, or leaves an 'or' unchanged */
+    ret = H5Sselect_hyper_blocklist(list_sid, H5S_SELECT_OR, (hsize_t)0, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyper_blocklist");
+    npoints = H5Sget_select_npoints(list_sid);
+    VERIFY(npoints, 3, "H5Sget_select_npoints");
+    ret = H5Sselect_hyper_blocklist(list_sid, H5S_SELECT_SET, (hsize_t)0, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyper_blocklist");
+    sel_type = H5Sget_select_type(list_sid);
+    VERIFY(sel_type, H5S_SEL_NONE, "H5Sget_select_type");
+
+    /* A block whose end is before its start is invalid */
+    row[1][1] = 0;
+    H5E_BEGIN_TRY
+    {
+        ret = H5Sselect_hyper_blocklist(list_sid, H5S_SELECT_SET, (hsize_t)1, &row[0][0]);
+    }
+    H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Sselect_hyper_blocklist");
+
+    ret = H5Sclose(base_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(list_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(ref_sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    HDfree(points);
+    HDfree(blocks);
+} /* test_select_hyper_blocklist() */
+
 /****************************************************************
 **
 **  test_h5s_set_extent_none:
@@ -16125,6 +16409,7 @@ test_select(void)
     test_select_hyper_union_stagger();     /* Test hyperslab union code for staggered slabs */
     test_select_hyper_union_3d();          /* Test hyperslab union code for 3-D dataset */
     test_select_hyper_valid_combination(); /* Test different input combinations */
+    test_select_hyper_combine_empty();     /* Test combinations that select nothing */
 
     /* The following tests are currently broken with the Direct VFD */
     if (HDstrcmp(env_h5_drvr, "direct") != 0) {
@@ -16241,6 +16526,9 @@ test_select(void)
     /* Test reading of 1-d disjoint file space to 1-d single block memory space */
     test_hyper_io_1d();
 
+    /* Test building selections from lists of blocks and points */
+    test_select_hyper_blocklist();
+
     /* Test H5Sset_extent_none() functionality after we updated it to set
      * the class to H5S_NULL instead of H5S_NO_CLASS.
      */
@@ -110,6 +110,7 @@ main(int argc, char *argv[])
 #endif /* H5_HAVE_PTHREAD_H */
     AddTest("acreate", tts_acreate, cleanup_acreate, "multi-attribute creation", NULL);
     AddTest("attr_vlen", tts_attr_vlen, cleanup_attr_vlen, "multi-file-attribute-vlen read", NULL);
+    AddTest("filter_threads", tts_filter_threads, cleanup_filter_threads, "filter pipeline threads", NULL);
 
 #else /* H5_HAVE_THREADSAFE */
 
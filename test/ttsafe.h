@@ -34,6 +34,7 @@ void tts_error(void);
 void tts_cancel(void);
 void tts_acreate(void);
 void tts_attr_vlen(void);
+void tts_filter_threads(void);
 
 /* Prototypes for the cleanup routines */
 void cleanup_dcreate(void);
@@ -41,6 +42,7 @@ void cleanup_error(void);
 void cleanup_cancel(void);
 void cleanup_acreate(void);
 void cleanup_attr_vlen(void);
+void cleanup_filter_threads(void);
 
 #endif /* H5_HAVE_THREADSAFE */
 #endif /* TTSAFE_H */
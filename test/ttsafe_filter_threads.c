@@ -0,0 +1,203 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/********************************************************************
+ *
+ * Testing for thread safety of running the filter pipeline of chunked
+ * datasets on several threads (see H5Pset_filter_nthreads()).
+ * ------------------------------------------------------------------
+ *
+ * Purpose: Verify that the filters of several chunks can be run on the
+ *          library's own threads while the application's thread holds
+ *          the library lock:
+ *          --Chunks read with several filter threads match the data
+ *            written
+ *          --The application's filter callback is only called on the
+ *            application's thread, so it may call the library, and it
+ *            is called for every chunk that fails its checksum
+ *          --Without a filter callback, the errors raised on the
+ *            library's threads are reported on the application's
+ *            error stack
+ *
+ ********************************************************************/
+
+#include "ttsafe.h"
+
+#ifdef H5_HAVE_THREADSAFE
+
+#define FILENAME       "ttsafe_filter_threads.h5"
+#define DSET_NAME      "filtered"
+#define NUM_THREADS    4
+#define CHUNK_SIZE     256
+#define NUM_CHUNKS     16
+#define DSET_SIZE      (CHUNK_SIZE * NUM_CHUNKS)
+#define FLETCHER32_ERR "data error detected by Fletcher32 checksum"
+
+static H5Z_cb_return_t tts_filter_threads_cb(H5Z_filter_t filter, void *buf, size_t buf_size, void *op_data);
+static herr_t          tts_filter_threads_walk(unsigned n, const H5E_error2_t *err_desc, void *client_data);
+
+/* Filter callback: counts the failures it is called for, calling the
+ * library to check that it runs on the thread that holds the lock */
+static H5Z_cb_return_t
+tts_filter_threads_cb(H5Z_filter_t filter, void H5_ATTR_UNUSED *buf, size_t H5_ATTR_UNUSED buf_size,
+                      void *op_data)
+{
+    unsigned *ncalls = (unsigned *)op_data;
+
+    if (filter == H5Z_FILTER_FLETCHER32 && H5Tget_size(H5T_NATIVE_INT) == sizeof(int))
+        (*ncalls)++;
+
+    return H5Z_CB_CONT;
+} /* end tts_filter_threads_cb() */
+
+/* Error stack walk callback: counts the checksum failures on the stack */
+static herr_t
+tts_filter_threads_walk(unsigned H5_ATTR_UNUSED n, const H5E_error2_t *err_desc, void *client_data)
+{
+    unsigned *nerrors = (unsigned *)client_data;
+
+    if (err_desc->desc && !HDstrcmp(err_desc->desc, FLETCHER32_ERR))
+        (*nerrors)++;
+
+    return 0;
+} /* end tts_filter_threads_walk() */
+
+void
+tts_filter_threads(void)
+{
+    hid_t          fid      = H5I_INVALID_HID; /* File ID */
+    hid_t          sid      = H5I_INVALID_HID; /* Dataspace ID */
+    hid_t          dcpl     = H5I_INVALID_HID; /* Dataset creation property list ID */
+    hid_t          dxpl     = H5I_INVALID_HID; /* Dataset transfer property list ID */
+    hid_t          did      = H5I_INVALID_HID; /* Dataset ID */
+    hsize_t        dims[1]  = {DSET_SIZE};     /* Dataset dimensions */
+    hsize_t        cdims[1] = {CHUNK_SIZE};    /* Chunk dimensions */
+    hsize_t        offset[1];                  /* Chunk offset */
+    int           *wbuf    = NULL;             /* Data written */
+    int           *rbuf    = NULL;             /* Data read */
+    unsigned char *bad     = NULL;             /* Chunk that fails its checksum */
+    size_t         bad_size;                   /* Size of a stored chunk */
+    unsigned       ncalls  = 0;                /* Number of filter callback calls */
+    unsigned       nerrors = 0;                /* Number of checksum errors on the stack */
+    herr_t         ret;                        /* Generic return value */
+    int            i;                          /* Local index variable */
+
+    wbuf = (int *)HDmalloc(DSET_SIZE * sizeof(int));
+    CHECK_PTR(wbuf, "HDmalloc");
+    rbuf = (int *)HDmalloc(DSET_SIZE * sizeof(int));
+    CHECK_PTR(rbuf, "HDmalloc");
+    for (i = 0; i < DSET_SIZE; i++)
+        wbuf[i] = i * 7;
+
+    /* Create a chunked dataset with a checksum */
+    fid = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid, H5I_INVALID_HID, "H5Fcreate");
+    sid = H5Screate_simple(1, dims, NULL);
+    CHECK(sid, H5I_INVALID_HID, "H5Screate_simple");
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(dcpl, H5I_INVALID_HID, "H5Pcreate");
+    ret = H5Pset_chunk(dcpl, 1, cdims);
+    CHECK(ret, FAIL, "H5Pset_chunk");
+    ret = H5Pset_shuffle(dcpl);
+    CHECK(ret, FAIL, "H5Pset_shuffle");
+    ret = H5Pset_fletcher32(dcpl);
+    CHECK(ret, FAIL, "H5Pset_fletcher32");
+    did = H5Dcreate2(fid, DSET_NAME, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    CHECK(did, H5I_INVALID_HID, "H5Dcreate2");
+
+    dxpl = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(dxpl, H5I_INVALID_HID, "H5Pcreate");
+    ret = H5Pset_filter_nthreads(dxpl, NUM_THREADS);
+    CHECK(ret, FAIL, "H5Pset_filter_nthreads");
+
+    ret = H5Dwrite(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf);
+    CHECK(ret, FAIL, "H5Dwrite");
+    ret = H5Dclose(did);
+    CHECK(ret, FAIL, "H5Dclose");
+
+    /* Read the chunks back, filtering them on several threads */
+    did = H5Dopen2(fid, DSET_NAME, H5P_DEFAULT);
+    CHECK(did, H5I_INVALID_HID, "H5Dopen2");
+    ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf);
+    CHECK(ret, FAIL, "H5Dread");
+    for (i = 0; i < DSET_SIZE; i++)
+        if (rbuf[i] != wbuf[i]) {
+            TestErrPrintf("Line %d: wrong value read at %d: %d, expected %d\n", __LINE__, i, rbuf[i],
+                          wbuf[i]);
+            break;
+        } /* end if */
+
+    /* Replace every chunk with bytes that fail the checksum */
+    bad_size = CHUNK_SIZE * sizeof(int) + 4;
+    bad      = (unsigned char *)HDmalloc(bad_size);
+    CHECK_PTR(bad, "HDmalloc");
+    HDmemset(bad, 0xAB, bad_size);
+    for (i = 0; i < NUM_CHUNKS; i++) {
+        offset[0] = (hsize_t)i * CHUNK_SIZE;
+        ret       = H5Dwrite_chunk(did, H5P_DEFAULT, 0, offset, bad_size, bad);
+        CHECK(ret, FAIL, "H5Dwrite_chunk");
+    } /* end for */
+    ret = H5Dclose(did);
+    CHECK(ret, FAIL, "H5Dclose");
+
+    /* Without a filter callback the read fails, with the errors of all the
+     * threads on the error stack */
+    did = H5Dopen2(fid, DSET_NAME, H5P_DEFAULT);
+    CHECK(did, H5I_INVALID_HID, "H5Dopen2");
+    H5E_BEGIN_TRY
+    {
+        ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf);
+    }
+    H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Dread");
+    ret = H5Ewalk2(H5E_DEFAULT, H5E_WALK_DOWNWARD, tts_filter_threads_walk, &nerrors);
+    CHECK(ret, FAIL, "H5Ewalk2");
+    if (nerrors < NUM_THREADS)
+        TestErrPrintf("Line %d: %u checksum errors reported, expected at least %d\n", __LINE__, nerrors,
+                      NUM_THREADS);
+    ret = H5Dclose(did);
+    CHECK(ret, FAIL, "H5Dclose");
+
+    /* With a filter callback that lets the read go on, the callback is
+     * called once for every chunk */
+    ret = H5Pset_filter_callback(dxpl, tts_filter_threads_cb, &ncalls);
+    CHECK(ret, FAIL, "H5Pset_filter_callback");
+    did = H5Dopen2(fid, DSET_NAME, H5P_DEFAULT);
+    CHECK(did, H5I_INVALID_HID, "H5Dopen2");
+    ret = H5Dread(did, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf);
+    CHECK(ret, FAIL, "H5Dread");
+    VERIFY(ncalls, NUM_CHUNKS, "H5Dread");
+
+    /* Close IDs */
+    ret = H5Dclose(did);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Pclose(dxpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Pclose(dcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Sclose(sid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(bad);
+    HDfree(rbuf);
+    HDfree(wbuf);
+} /* end tts_filter_threads() */
+
+void
+cleanup_filter_threads(void)
+{
+    HDunlink(FILENAME);
+}
+
+#endif /*H5_HAVE_THREADSAFE*/
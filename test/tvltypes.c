@@ -18,9 +18,12 @@
  *
  *************************************************************/
 
+#define H5D_FRIEND /*suppress error about including H5Dpkg      */
+#define H5D_TESTING
+
 #include "testhdf5.h"
 
-#include "H5Dprivate.h"
+#include "H5Dpkg.h"
 
 #define FILENAME "tvltypes.h5"
 
@@ -40,6 +43,20 @@
 #define SPACE4_DIM_SMALL 128
 #define SPACE4_DIM_LARGE (H5D_TEMP_BUF_SIZE / 64)
 
+/* 1-D dataset spanning several global heap collections */
+#define SPACE5_RANK    1
+#define SPACE5_DIM1    6000
+#define SPACE5_NPOINTS 1500
+
+/* 1-D chunked dataset storing its VL data inline, with a partial edge chunk,
+ * which is extended later */
+#define SPACE6_RANK    1
+#define SPACE6_DIM1    1000
+#define SPACE6_DIM2    1200
+#define SPACE6_CHUNK   64
+#define SPACE6_NPOINTS 300
+#define SPACE6_CACHE   16384
+
 void *test_vltypes_alloc_custom(size_t size, void *info);
 void  test_vltypes_free_custom(void *mem, void *info);
 
@@ -3215,6 +3232,767 @@ test_vltypes_fill_value(void)
     HDfree(rbuf);
 } /* end test_vltypes_fill_value() */
 
+/****************************************************************
+**
+**  test_vltypes_vlen_arena(): Test reading VL data into an arena
+**      with H5Pset_vlen_arena() and releasing it with H5Treclaim().
+**
+****************************************************************/
+static void
+test_vltypes_vlen_arena(void)
+{
+    typedef struct { /* Struct that the compound type is composed of */
+        int   id;
+        char *name;
+        hvl_t seq;
+    } s1;
+    s1      *wdata;          /* Information to write */
+    s1      *rdata;          /* Information read in */
+    s1      *rdata2;         /* Information read in with copied property list */
+    hid_t    fid1;           /* HDF5 File IDs        */
+    hid_t    dataset;        /* Dataset ID            */
+    hid_t    sid1;           /* Dataspace ID            */
+    hid_t    tid1, tid2;     /* Datatype IDs for VL sequence & string */
+    hid_t    tid3;           /* Datatype ID for compound */
+    hid_t    xfer_pid;       /* Dataset transfer property list ID */
+    hid_t    xfer_pid2;      /* Copy of dataset transfer property list */
+    hsize_t  dims1[] = {SPACE3_DIM1};
+    size_t   block_size;     /* Block size of arena */
+    size_t   mem_used = 0;   /* Memory used by custom allocator */
+    unsigned i, j, k;        /* counting variables */
+    htri_t   equal;          /* Whether property lists are equal */
+    herr_t   ret;            /* Generic return value        */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing VL Data Arena Functionality\n"));
+
+    wdata  = (s1 *)HDmalloc(SPACE3_DIM1 * sizeof(s1));
+    CHECK_PTR(wdata, "HDmalloc");
+    rdata  = (s1 *)HDmalloc(SPACE3_DIM1 * sizeof(s1));
+    CHECK_PTR(rdata, "HDmalloc");
+    rdata2 = (s1 *)HDmalloc(SPACE3_DIM1 * sizeof(s1));
+    CHECK_PTR(rdata2, "HDmalloc");
+
+    /* Allocate and initialize VL data to write, with strings and sequences
+     * both smaller and larger than half an arena block */
+    for (i = 0; i < SPACE3_DIM1; i++) {
+        wdata[i].id   = (int)i;
+        wdata[i].name = (char *)HDmalloc(i * 3 + 2);
+        for (j = 0; j < i * 3 + 1; j++)
+            wdata[i].name[j] = (char)('a' + (i + j) % 26);
+        wdata[i].name[j] = '\0';
+        wdata[i].seq.len = i % 17;
+        wdata[i].seq.p   = wdata[i].seq.len ? HDmalloc(wdata[i].seq.len * sizeof(double)) : NULL;
+        for (j = 0; j < wdata[i].seq.len; j++)
+            ((double *)wdata[i].seq.p)[j] = (double)i + (double)j / 32.0;
+    } /* end for */
+
+    /* Create file */
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE3_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create the VL types and the compound type */
+    tid1 = H5Tvlen_create(H5T_NATIVE_DOUBLE);
+    CHECK(tid1, FAIL, "H5Tvlen_create");
+    tid2 = H5Tcopy(H5T_C_S1);
+    CHECK(tid2, FAIL, "H5Tcopy");
+    ret = H5Tset_size(tid2, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+    tid3 = H5Tcreate(H5T_COMPOUND, sizeof(s1));
+    CHECK(tid3, FAIL, "H5Tcreate");
+    ret = H5Tinsert(tid3, "id", HOFFSET(s1, id), H5T_NATIVE_INT);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid3, "name", HOFFSET(s1, name), tid2);
+    CHECK(ret, FAIL, "H5Tinsert");
+    ret = H5Tinsert(tid3, "seq", HOFFSET(s1, seq), tid1);
+    CHECK(ret, FAIL, "H5Tinsert");
+
+    /* Create a dataset and write the data to it */
+    dataset = H5Dcreate2(fid1, "Dataset1", tid3, sid1, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dataset, FAIL, "H5Dcreate2");
+    ret = H5Dwrite(dataset, tid3, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Create a transfer property list with a custom memory manager */
+    xfer_pid = H5Pcreate(H5P_DATASET_XFER);
+    CHECK(xfer_pid, FAIL, "H5Pcreate");
+    ret = H5Pset_vlen_mem_manager(xfer_pid, test_vltypes_alloc_custom, &mem_used, test_vltypes_free_custom,
+                                  &mem_used);
+    CHECK(ret, FAIL, "H5Pset_vlen_mem_manager");
+
+    /* There's no arena by default */
+    block_size = 1;
+    ret        = H5Pget_vlen_arena(xfer_pid, &block_size);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 0, "H5Pget_vlen_arena");
+
+    /* Give the transfer property list an arena, which takes precedence
+     * over the memory manager */
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)256);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 256, "H5Pget_vlen_arena");
+
+    /* Read the data into the arena, twice (the second time with a copy of
+     * the property list, which shares the arena) and check it */
+    xfer_pid2 = H5Pcopy(xfer_pid);
+    CHECK(xfer_pid2, FAIL, "H5Pcopy");
+    equal = H5Pequal(xfer_pid, xfer_pid2);
+    VERIFY(equal, TRUE, "H5Pequal");
+
+    ret = H5Dread(dataset, tid3, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Dread(dataset, tid3, H5S_ALL, H5S_ALL, xfer_pid2, rdata2);
+    CHECK(ret, FAIL, "H5Dread");
+    VERIFY(mem_used, 0, "H5Dread");
+
+    /* The data read with the copy stays valid after the copy is closed */
+    ret = H5Pclose(xfer_pid2);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    for (k = 0; k < 2; k++) {
+        s1 *buf = k ? rdata2 : rdata; /* Buffer to check */
+
+        for (i = 0; i < SPACE3_DIM1; i++) {
+            if (buf[i].id != wdata[i].id || HDstrcmp(buf[i].name, wdata[i].name) != 0 ||
+                buf[i].seq.len != wdata[i].seq.len) {
+                TestErrPrintf("%d: VL data doesn't match!, i=%u\n", __LINE__, i);
+                continue;
+            } /* end if */
+            if (buf[i].seq.len && ((uintptr_t)buf[i].seq.p % sizeof(double)) != 0)
+                TestErrPrintf("%d: VL sequence not aligned!, i=%u\n", __LINE__, i);
+            for (j = 0; j < buf[i].seq.len; j++)
+                if (!H5_DBL_ABS_EQUAL(((double *)buf[i].seq.p)[j], ((double *)wdata[i].seq.p)[j]))
+                    TestErrPrintf("%d: VL data doesn't match!, i=%u, j=%u\n", __LINE__, i, j);
+        } /* end for */
+    }     /* end for */
+
+    /* Release all the data in the arena at once */
+    ret = H5Treclaim(tid3, sid1, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Treclaim");
+
+    /* The arena is reused by the following reads */
+    ret = H5Dread(dataset, tid3, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    VERIFY(mem_used, 0, "H5Dread");
+    for (i = 0; i < SPACE3_DIM1; i++)
+        if (HDstrcmp(rdata[i].name, wdata[i].name) != 0)
+            TestErrPrintf("%d: VL data doesn't match!, i=%u\n", __LINE__, i);
+
+    /* Removing the arena releases its data and restores the memory manager */
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)0);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+    ret = H5Pget_vlen_arena(xfer_pid, &block_size);
+    CHECK(ret, FAIL, "H5Pget_vlen_arena");
+    VERIFY(block_size, 0, "H5Pget_vlen_arena");
+
+    ret = H5Dread(dataset, tid3, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    if (mem_used == 0)
+        TestErrPrintf("%d: memory manager not used after removing arena\n", __LINE__);
+    ret = H5Treclaim(tid3, sid1, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Treclaim");
+    VERIFY(mem_used, 0, "H5Treclaim");
+
+    /* Read into an arena once more, and leave the data for closing the
+     * property list to release */
+    ret = H5Pset_vlen_arena(xfer_pid, (size_t)4096);
+    CHECK(ret, FAIL, "H5Pset_vlen_arena");
+    ret = H5Dread(dataset, tid3, H5S_ALL, H5S_ALL, xfer_pid, rdata);
+    CHECK(ret, FAIL, "H5Dread");
+    VERIFY(mem_used, 0, "H5Dread");
+
+    /* Close everything */
+    ret = H5Pclose(xfer_pid);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Treclaim(tid3, sid1, H5P_DEFAULT, wdata);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Dclose(dataset);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Tclose(tid3);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid2);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(tid1);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(rdata2);
+    HDfree(rdata);
+    HDfree(wdata);
+} /* end test_vltypes_vlen_arena() */
+
+/****************************************************************
+**
+**  test_vltypes_gheap_batch(): Test reading and writing many
+**      VL sequences and strings at once, which spans several
+**      global heap collections, with and without converting the
+**      sequences' elements.
+**
+****************************************************************/
+static void
+test_vltypes_gheap_batch(void)
+{
+    hvl_t   *wseq;                /* Sequences to write */
+    hvl_t   *rseq;                /* Sequences read in */
+    char   **wstr;                /* Strings to write */
+    char   **rstr;                /* Strings read in */
+    hid_t    fid1;                /* HDF5 File IDs        */
+    hid_t    dset1, dset2;        /* Dataset IDs            */
+    hid_t    sid1;                /* Dataspace ID            */
+    hid_t    msid;                /* Memory dataspace ID */
+    hid_t    mtid, ftid, dtid;    /* Memory, file & double VL sequence datatype IDs */
+    hid_t    stid;                /* VL string datatype ID */
+    hsize_t  dims1[] = {SPACE5_DIM1};
+    hsize_t *coord;               /* Coordinates of the elements to select */
+    unsigned i, j, k;             /* counting variables */
+    herr_t   ret;                 /* Generic return value        */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing Batched Global Heap Access for VL Data\n"));
+
+    wseq = (hvl_t *)HDcalloc(SPACE5_DIM1, sizeof(hvl_t));
+    CHECK_PTR(wseq, "HDcalloc");
+    rseq = (hvl_t *)HDcalloc(SPACE5_DIM1, sizeof(hvl_t));
+    CHECK_PTR(rseq, "HDcalloc");
+    wstr = (char **)HDcalloc(SPACE5_DIM1, sizeof(char *));
+    CHECK_PTR(wstr, "HDcalloc");
+    rstr = (char **)HDcalloc(SPACE5_DIM1, sizeof(char *));
+    CHECK_PTR(rstr, "HDcalloc");
+    coord = (hsize_t *)HDmalloc(SPACE5_NPOINTS * sizeof(hsize_t));
+    CHECK_PTR(coord, "HDmalloc");
+
+    /* Allocate and initialize VL data to write, with some "nil" sequences
+     * and strings, and some empty strings */
+    for (i = 0; i < SPACE5_DIM1; i++) {
+        wseq[i].len = (i % 7 == 3) ? 0 : (i % 23) + 1;
+        wseq[i].p   = wseq[i].len ? HDmalloc(wseq[i].len * sizeof(int)) : NULL;
+        for (j = 0; j < wseq[i].len; j++)
+            ((int *)wseq[i].p)[j] = (int)(i * 100 + j);
+
+        if (i % 11 != 5) {
+            wstr[i] = (char *)HDmalloc((i % 31) + 1);
+            for (j = 0; j < i % 31; j++)
+                wstr[i][j] = (char)('a' + (i + j) % 26);
+            wstr[i][j] = '\0';
+        } /* end if */
+    }     /* end for */
+
+    /* Create file */
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE5_RANK, dims1, NULL);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create the VL types, with a file type whose elements need converting */
+    mtid = H5Tvlen_create(H5T_NATIVE_INT);
+    CHECK(mtid, FAIL, "H5Tvlen_create");
+    ftid = H5Tvlen_create(H5T_STD_I64BE);
+    CHECK(ftid, FAIL, "H5Tvlen_create");
+    dtid = H5Tvlen_create(H5T_NATIVE_DOUBLE);
+    CHECK(dtid, FAIL, "H5Tvlen_create");
+    stid = H5Tcopy(H5T_C_S1);
+    CHECK(stid, FAIL, "H5Tcopy");
+    ret = H5Tset_size(stid, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+
+    /* Create the datasets and write the data to them, twice, so the
+     * second write replaces the sequences of the first */
+    dset1 = H5Dcreate2(fid1, "Sequences", ftid, sid1, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dset1, FAIL, "H5Dcreate2");
+    dset2 = H5Dcreate2(fid1, "Strings", stid, sid1, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(dset2, FAIL, "H5Dcreate2");
+    for (k = 0; k < 2; k++) {
+        ret = H5Dwrite(dset1, mtid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wseq);
+        CHECK(ret, FAIL, "H5Dwrite");
+        ret = H5Dwrite(dset2, stid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wstr);
+        CHECK(ret, FAIL, "H5Dwrite");
+    } /* end for */
+
+    /* Close and reopen the file, so the data is read from the file */
+    ret = H5Dclose(dset1);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Dclose(dset2);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+    fid1 = H5Fopen(FILENAME, H5F_ACC_RDONLY, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fopen");
+    dset1 = H5Dopen2(fid1, "Sequences", H5P_DEFAULT);
+    CHECK(dset1, FAIL, "H5Dopen2");
+    dset2 = H5Dopen2(fid1, "Strings", H5P_DEFAULT);
+    CHECK(dset2, FAIL, "H5Dopen2");
+
+    /* Read the data back and check it */
+    ret = H5Dread(dset1, mtid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Dread(dset2, stid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rstr);
+    CHECK(ret, FAIL, "H5Dread");
+    for (i = 0; i < SPACE5_DIM1; i++) {
+        if (rseq[i].len != wseq[i].len) {
+            TestErrPrintf("%d: VL data length don't match!, i=%u\n", __LINE__, i);
+            continue;
+        } /* end if */
+        for (j = 0; j < rseq[i].len; j++)
+            if (((int *)rseq[i].p)[j] != ((int *)wseq[i].p)[j])
+                TestErrPrintf("%d: VL data doesn't match!, i=%u, j=%u\n", __LINE__, i, j);
+        if ((NULL == wstr[i]) != (NULL == rstr[i]) || (wstr[i] && HDstrcmp(wstr[i], rstr[i]) != 0))
+            TestErrPrintf("%d: VL string doesn't match!, i=%u\n", __LINE__, i);
+    } /* end for */
+    ret = H5Treclaim(mtid, sid1, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Treclaim(stid, sid1, H5P_DEFAULT, rstr);
+    CHECK(ret, FAIL, "H5Treclaim");
+
+    /* Read points in reverse order, so the sequences aren't read in the
+     * order they are stored in the global heap, and convert the elements
+     * to doubles */
+    for (i = 0; i < SPACE5_NPOINTS; i++)
+        coord[i] = (hsize_t)(SPACE5_DIM1 - 1 - i * 3);
+    ret = H5Sselect_elements(sid1, H5S_SELECT_SET, (size_t)SPACE5_NPOINTS, coord);
+    CHECK(ret, FAIL, "H5Sselect_elements");
+    dims1[0] = SPACE5_NPOINTS;
+    msid     = H5Screate_simple(SPACE5_RANK, dims1, NULL);
+    CHECK(msid, FAIL, "H5Screate_simple");
+
+    ret = H5Dread(dset1, dtid, msid, sid1, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Dread(dset2, stid, msid, sid1, H5P_DEFAULT, rstr);
+    CHECK(ret, FAIL, "H5Dread");
+    for (i = 0; i < SPACE5_NPOINTS; i++) {
+        size_t w = (size_t)coord[i]; /* Element written */
+
+        if (rseq[i].len != wseq[w].len) {
+            TestErrPrintf("%d: VL data length don't match!, i=%u\n", __LINE__, i);
+            continue;
+        } /* end if */
+        for (j = 0; j < rseq[i].len; j++)
+            if (!H5_DBL_ABS_EQUAL(((double *)rseq[i].p)[j], (double)((int *)wseq[w].p)[j]))
+                TestErrPrintf("%d: VL data doesn't match!, i=%u, j=%u\n", __LINE__, i, j);
+        if ((NULL == wstr[w]) != (NULL == rstr[i]) || (wstr[w] && HDstrcmp(wstr[w], rstr[i]) != 0))
+            TestErrPrintf("%d: VL string doesn't match!, i=%u\n", __LINE__, i);
+    } /* end for */
+    ret = H5Treclaim(dtid, msid, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Treclaim(stid, msid, H5P_DEFAULT, rstr);
+    CHECK(ret, FAIL, "H5Treclaim");
+
+    /* Close everything */
+    ret = H5Treclaim(mtid, sid1, H5P_DEFAULT, wseq);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Treclaim(stid, sid1, H5P_DEFAULT, wstr);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Dclose(dset1);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Dclose(dset2);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Tclose(stid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(dtid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(ftid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(mtid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Sclose(msid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(coord);
+    HDfree(rstr);
+    HDfree(wstr);
+    HDfree(rseq);
+    HDfree(wseq);
+} /* end test_vltypes_gheap_batch() */
+
+/****************************************************************
+**
+**  test_vltypes_inline_check(): Check the VL sequences and
+**      strings of the elements [START, END) read from datasets
+**      storing their VL data inline in their chunks.
+**
+****************************************************************/
+static void
+test_vltypes_inline_check(hid_t dset1, hid_t dset2, hid_t mtid, hid_t stid, const hvl_t *wseq,
+                          char *const *wstr, unsigned start, unsigned end)
+{
+    hvl_t   *rseq;              /* Sequences read in */
+    char   **rstr;              /* Strings read in */
+    hid_t    fsid, msid;        /* File & memory dataspace IDs */
+    hsize_t  offset[SPACE6_RANK] = {start};
+    hsize_t  count[SPACE6_RANK]  = {end - start};
+    unsigned i, j;              /* counting variables */
+    herr_t   ret;               /* Generic return value        */
+
+    rseq = (hvl_t *)HDcalloc(end - start, sizeof(hvl_t));
+    CHECK_PTR(rseq, "HDcalloc");
+    rstr = (char **)HDcalloc(end - start, sizeof(char *));
+    CHECK_PTR(rstr, "HDcalloc");
+
+    fsid = H5Dget_space(dset1);
+    CHECK(fsid, FAIL, "H5Dget_space");
+    ret = H5Sselect_hyperslab(fsid, H5S_SELECT_SET, offset, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    msid = H5Screate_simple(SPACE6_RANK, count, NULL);
+    CHECK(msid, FAIL, "H5Screate_simple");
+
+    ret = H5Dread(dset1, mtid, msid, fsid, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Dread");
+    ret = H5Dread(dset2, stid, msid, fsid, H5P_DEFAULT, rstr);
+    CHECK(ret, FAIL, "H5Dread");
+    for (i = 0; i < end - start; i++) {
+        const hvl_t *w = &wseq[start + i]; /* Sequence written */
+
+        if (rseq[i].len != w->len) {
+            TestErrPrintf("%d: VL data length don't match!, i=%u\n", __LINE__, start + i);
+            continue;
+        } /* end if */
+        for (j = 0; j < rseq[i].len; j++)
+            if (((int *)rseq[i].p)[j] != ((int *)w->p)[j])
+                TestErrPrintf("%d: VL data doesn't match!, i=%u, j=%u\n", __LINE__, start + i, j);
+        if ((NULL == wstr[start + i]) != (NULL == rstr[i]) ||
+            (wstr[start + i] && HDstrcmp(wstr[start + i], rstr[i]) != 0))
+            TestErrPrintf("%d: VL string doesn't match!, i=%u\n", __LINE__, start + i);
+    } /* end for */
+
+    ret = H5Treclaim(mtid, msid, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Treclaim(stid, msid, H5P_DEFAULT, rstr);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Sclose(msid);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Sclose(fsid);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    HDfree(rstr);
+    HDfree(rseq);
+} /* end test_vltypes_inline_check() */
+
+/****************************************************************
+**
+**  test_vltypes_inline_fill(): Fill the VL sequences and
+**      strings to write to elements [START, END), with some
+**      "nil" and empty ones, varying with ROUND.
+**
+****************************************************************/
+static void
+test_vltypes_inline_fill(hvl_t *wseq, char **wstr, unsigned start, unsigned end, unsigned round)
+{
+    unsigned i, j; /* counting variables */
+
+    for (i = start; i < end; i++) {
+        HDfree(wseq[i].p);
+        wseq[i].len = (i % 7 == 3) ? 0 : ((i + round) % 23) + 1;
+        wseq[i].p   = wseq[i].len ? HDmalloc(wseq[i].len * sizeof(int)) : NULL;
+        for (j = 0; j < wseq[i].len; j++)
+            ((int *)wseq[i].p)[j] = (int)(round * 1000000 + i * 100 + j);
+
+        HDfree(wstr[i]);
+        wstr[i] = NULL;
+        if (i % 11 != 5) {
+            wstr[i] = (char *)HDmalloc(((i + round) % 31) + 1);
+            for (j = 0; j < (i + round) % 31; j++)
+                wstr[i][j] = (char)('a' + (i + j + round) % 26);
+            wstr[i][j] = '\0';
+        } /* end if */
+    }     /* end for */
+} /* end test_vltypes_inline_fill() */
+
+/****************************************************************
+**
+**  test_vltypes_inline(): Test storing VL sequences and strings
+**      inline in the chunks of datasets, with the inline VL data
+**      filter.
+**
+****************************************************************/
+static void
+test_vltypes_inline(void)
+{
+    hvl_t   *wseq;                /* Sequences to write */
+    char   **wstr;                /* Strings to write */
+    hvl_t   *rseq;                /* Sequences read in */
+    hid_t    fid1;                /* HDF5 File IDs        */
+    hid_t    dset1, dset2, dset3; /* Dataset IDs            */
+    hid_t    sid1, msid;          /* Dataspace IDs            */
+    hid_t    dcpl;                /* Dataset creation property list ID */
+    hid_t    dapl;                /* Dataset access property list ID */
+    hid_t    mtid, ftid, dtid;    /* Memory, file & double VL sequence datatype IDs */
+    hid_t    stid;                /* VL string datatype ID */
+    hsize_t  dims1[]    = {SPACE6_DIM1};
+    hsize_t  maxdims1[] = {H5S_UNLIMITED};
+    hsize_t  chunk_dims[] = {SPACE6_CHUNK};
+    hsize_t  offset[SPACE6_RANK];
+    hsize_t  count[SPACE6_RANK];
+    hsize_t  coord[SPACE6_NPOINTS];
+    unsigned flags;               /* Filter flags */
+    size_t   cd_nelmts = 0;       /* Number of filter parameters */
+    H5Z_filter_t filter;          /* Filter ID */
+    size_t   nbytes_used;         /* Bytes in the chunk cache */
+    int      nused;               /* Chunks in the chunk cache */
+    int      fill = 0;            /* Fill value */
+    hid_t    ret_id;              /* Generic ID return value */
+    unsigned i, j;                /* counting variables */
+    herr_t   ret;                 /* Generic return value        */
+
+    /* Output message about test being performed */
+    MESSAGE(5, ("Testing VL Data Stored Inline in Chunks\n"));
+
+    wseq = (hvl_t *)HDcalloc(SPACE6_DIM2, sizeof(hvl_t));
+    CHECK_PTR(wseq, "HDcalloc");
+    wstr = (char **)HDcalloc(SPACE6_DIM2, sizeof(char *));
+    CHECK_PTR(wstr, "HDcalloc");
+    rseq = (hvl_t *)HDcalloc(SPACE6_NPOINTS, sizeof(hvl_t));
+    CHECK_PTR(rseq, "HDcalloc");
+    test_vltypes_inline_fill(wseq, wstr, 0, SPACE6_DIM1, 0);
+
+    /* Create file */
+    fid1 = H5Fcreate(FILENAME, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fcreate");
+
+    /* Create dataspace for datasets */
+    sid1 = H5Screate_simple(SPACE6_RANK, dims1, maxdims1);
+    CHECK(sid1, FAIL, "H5Screate_simple");
+
+    /* Create the VL types, with a file type whose elements need converting */
+    mtid = H5Tvlen_create(H5T_NATIVE_INT);
+    CHECK(mtid, FAIL, "H5Tvlen_create");
+    ftid = H5Tvlen_create(H5T_STD_I64BE);
+    CHECK(ftid, FAIL, "H5Tvlen_create");
+    dtid = H5Tvlen_create(H5T_NATIVE_DOUBLE);
+    CHECK(dtid, FAIL, "H5Tvlen_create");
+    stid = H5Tcopy(H5T_C_S1);
+    CHECK(stid, FAIL, "H5Tcopy");
+    ret = H5Tset_size(stid, H5T_VARIABLE);
+    CHECK(ret, FAIL, "H5Tset_size");
+
+    /* Set up the inline VL data filter, followed by compression */
+    dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    CHECK(dcpl, FAIL, "H5Pcreate");
+    ret = H5Pset_chunk(dcpl, SPACE6_RANK, chunk_dims);
+    CHECK(ret, FAIL, "H5Pset_chunk");
+    ret = H5Pset_vlen_inline(dcpl);
+    CHECK(ret, FAIL, "H5Pset_vlen_inline");
+#ifdef H5_HAVE_FILTER_DEFLATE
+    ret = H5Pset_deflate(dcpl, 6);
+    CHECK(ret, FAIL, "H5Pset_deflate");
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    ret = H5Pset_fletcher32(dcpl);
+    CHECK(ret, FAIL, "H5Pset_fletcher32");
+
+    /* Setting the filter again keeps it first */
+    ret = H5Pset_vlen_inline(dcpl);
+    CHECK(ret, FAIL, "H5Pset_vlen_inline");
+    filter = H5Pget_filter2(dcpl, 0, &flags, &cd_nelmts, NULL, 0, NULL, NULL);
+    VERIFY(filter, H5Z_FILTER_VLEN, "H5Pget_filter2");
+
+    /* Create the datasets and write the data to them */
+    dset1 = H5Dcreate2(fid1, "Inline Sequences", ftid, sid1, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    CHECK(dset1, FAIL, "H5Dcreate2");
+    dset2 = H5Dcreate2(fid1, "Inline Strings", stid, sid1, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    CHECK(dset2, FAIL, "H5Dcreate2");
+    ret = H5Dwrite(dset1, mtid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wseq);
+    CHECK(ret, FAIL, "H5Dwrite");
+    ret = H5Dwrite(dset2, stid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wstr);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Overwrite part of the data, across chunk boundaries, with longer and
+     * shorter sequences */
+    test_vltypes_inline_fill(wseq, wstr, 100, 300, 1);
+    offset[0] = 100;
+    count[0]  = 200;
+    ret       = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, offset, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    ret = H5Dwrite(dset1, mtid, sid1, sid1, H5P_DEFAULT, wseq);
+    CHECK(ret, FAIL, "H5Dwrite");
+    ret = H5Dwrite(dset2, stid, sid1, sid1, H5P_DEFAULT, wstr);
+    CHECK(ret, FAIL, "H5Dwrite");
+
+    /* Check the data while it's in the chunk cache */
+    test_vltypes_inline_check(dset1, dset2, mtid, stid, wseq, wstr, 0, SPACE6_DIM1);
+
+    /* The chunk cache is charged for the sequences in the chunks as well */
+    ret = H5D__current_cache_size_test(dset1, &nbytes_used, &nused);
+    CHECK(ret, FAIL, "H5D__current_cache_size_test");
+    VERIFY(nused, (SPACE6_DIM1 + SPACE6_CHUNK - 1) / SPACE6_CHUNK, "H5D__current_cache_size_test");
+    if (nbytes_used <= (size_t)nused * SPACE6_CHUNK * H5Tget_size(ftid))
+        TestErrPrintf("%d: chunk cache holds %zu bytes, not more than its chunks' elements\n", __LINE__,
+                      nbytes_used);
+
+    /* Close and reopen the file, so the data is read from the file */
+    ret = H5Dclose(dset1);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Dclose(dset2);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+    fid1 = H5Fopen(FILENAME, H5F_ACC_RDWR, H5P_DEFAULT);
+    CHECK(fid1, FAIL, "H5Fopen");
+    dapl = H5Pcreate(H5P_DATASET_ACCESS);
+    CHECK(dapl, FAIL, "H5Pcreate");
+    ret = H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, (size_t)SPACE6_CACHE,
+                             H5D_CHUNK_CACHE_W0_DEFAULT);
+    CHECK(ret, FAIL, "H5Pset_chunk_cache");
+    dset1 = H5Dopen2(fid1, "Inline Sequences", dapl);
+    CHECK(dset1, FAIL, "H5Dopen2");
+    dset2 = H5Dopen2(fid1, "Inline Strings", H5P_DEFAULT);
+    CHECK(dset2, FAIL, "H5Dopen2");
+    test_vltypes_inline_check(dset1, dset2, mtid, stid, wseq, wstr, 0, SPACE6_DIM1);
+
+    /* The chunks read stay within the chunk cache's size, although their
+     * elements alone would all fit */
+    ret = H5D__current_cache_size_test(dset1, &nbytes_used, &nused);
+    CHECK(ret, FAIL, "H5D__current_cache_size_test");
+    if (nbytes_used > SPACE6_CACHE || nused <= 0 ||
+        nused >= (SPACE6_DIM1 + SPACE6_CHUNK - 1) / SPACE6_CHUNK)
+        TestErrPrintf("%d: chunk cache holds %d chunks in %zu bytes\n", __LINE__, nused, nbytes_used);
+    ret = H5Pclose(dapl);
+    CHECK(ret, FAIL, "H5Pclose");
+
+    /* Extend the datasets; the new elements are "nil" until written */
+    dims1[0] = SPACE6_DIM2;
+    ret      = H5Dset_extent(dset1, dims1);
+    CHECK(ret, FAIL, "H5Dset_extent");
+    ret = H5Dset_extent(dset2, dims1);
+    CHECK(ret, FAIL, "H5Dset_extent");
+    test_vltypes_inline_check(dset1, dset2, mtid, stid, wseq, wstr, 0, SPACE6_DIM2);
+
+    /* Write the new elements, and rewrite the old partial edge chunk */
+    test_vltypes_inline_fill(wseq, wstr, 980, SPACE6_DIM2, 2);
+    ret = H5Sset_extent_simple(sid1, SPACE6_RANK, dims1, maxdims1);
+    CHECK(ret, FAIL, "H5Sset_extent_simple");
+    offset[0] = 980;
+    count[0]  = SPACE6_DIM2 - 980;
+    ret       = H5Sselect_hyperslab(sid1, H5S_SELECT_SET, offset, NULL, count, NULL);
+    CHECK(ret, FAIL, "H5Sselect_hyperslab");
+    ret = H5Dwrite(dset1, mtid, sid1, sid1, H5P_DEFAULT, wseq);
+    CHECK(ret, FAIL, "H5Dwrite");
+    ret = H5Dwrite(dset2, stid, sid1, sid1, H5P_DEFAULT, wstr);
+    CHECK(ret, FAIL, "H5Dwrite");
+    ret = H5Fflush(fid1, H5F_SCOPE_GLOBAL);
+    CHECK(ret, FAIL, "H5Fflush");
+    test_vltypes_inline_check(dset1, dset2, mtid, stid, wseq, wstr, 0, SPACE6_DIM2);
+
+    /* Read points in reverse order, converting the elements to doubles */
+    for (i = 0; i < SPACE6_NPOINTS; i++)
+        coord[i] = (hsize_t)(SPACE6_DIM2 - 1 - i * 4);
+    ret = H5Sselect_elements(sid1, H5S_SELECT_SET, (size_t)SPACE6_NPOINTS, coord);
+    CHECK(ret, FAIL, "H5Sselect_elements");
+    count[0] = SPACE6_NPOINTS;
+    msid     = H5Screate_simple(SPACE6_RANK, count, NULL);
+    CHECK(msid, FAIL, "H5Screate_simple");
+    ret = H5Dread(dset1, dtid, msid, sid1, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Dread");
+    for (i = 0; i < SPACE6_NPOINTS; i++) {
+        size_t w = (size_t)coord[i]; /* Element written */
+
+        if (rseq[i].len != wseq[w].len) {
+            TestErrPrintf("%d: VL data length don't match!, i=%u\n", __LINE__, i);
+            continue;
+        } /* end if */
+        for (j = 0; j < rseq[i].len; j++)
+            if (!H5_DBL_ABS_EQUAL(((double *)rseq[i].p)[j], (double)((int *)wseq[w].p)[j]))
+                TestErrPrintf("%d: VL data doesn't match!, i=%u, j=%u\n", __LINE__, i, j);
+    } /* end for */
+    ret = H5Treclaim(dtid, msid, H5P_DEFAULT, rseq);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Sclose(msid);
+    CHECK(ret, FAIL, "H5Sclose");
+
+    /* Copy the datasets, with their VL data */
+    ret = H5Ocopy(fid1, "Inline Sequences", fid1, "Copied Sequences", H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(ret, FAIL, "H5Ocopy");
+    ret = H5Ocopy(fid1, "Inline Strings", fid1, "Copied Strings", H5P_DEFAULT, H5P_DEFAULT);
+    CHECK(ret, FAIL, "H5Ocopy");
+    dset3 = H5Dopen2(fid1, "Copied Sequences", H5P_DEFAULT);
+    CHECK(dset3, FAIL, "H5Dopen2");
+    ret = H5Dclose(dset2);
+    CHECK(ret, FAIL, "H5Dclose");
+    dset2 = H5Dopen2(fid1, "Copied Strings", H5P_DEFAULT);
+    CHECK(dset2, FAIL, "H5Dopen2");
+    test_vltypes_inline_check(dset3, dset2, mtid, stid, wseq, wstr, 0, SPACE6_DIM2);
+    ret = H5Dclose(dset3);
+    CHECK(ret, FAIL, "H5Dclose");
+
+    /* The filter is only for dataset creation property lists, can't follow
+     * other filters, or be used for datasets that aren't variable-length or
+     * have a user-defined fill value */
+    H5E_BEGIN_TRY
+    {
+        ret = H5Pset_vlen_inline(H5P_FILE_ACCESS_DEFAULT);
+    }
+    H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Pset_vlen_inline");
+    ret = H5Premove_filter(dcpl, H5Z_FILTER_ALL);
+    CHECK(ret, FAIL, "H5Premove_filter");
+    ret = H5Pset_fletcher32(dcpl);
+    CHECK(ret, FAIL, "H5Pset_fletcher32");
+    H5E_BEGIN_TRY
+    {
+        ret = H5Pset_vlen_inline(dcpl);
+    }
+    H5E_END_TRY;
+    VERIFY(ret, FAIL, "H5Pset_vlen_inline");
+    ret = H5Premove_filter(dcpl, H5Z_FILTER_ALL);
+    CHECK(ret, FAIL, "H5Premove_filter");
+    ret = H5Pset_vlen_inline(dcpl);
+    CHECK(ret, FAIL, "H5Pset_vlen_inline");
+    H5E_BEGIN_TRY
+    {
+        ret_id = H5Dcreate2(fid1, "Integers", H5T_NATIVE_INT, sid1, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+    VERIFY(ret_id, FAIL, "H5Dcreate2");
+    ret = H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill);
+    CHECK(ret, FAIL, "H5Pset_fill_value");
+    H5E_BEGIN_TRY
+    {
+        ret_id = H5Dcreate2(fid1, "Filled Sequences", ftid, sid1, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+    VERIFY(ret_id, FAIL, "H5Dcreate2");
+
+    /* Close everything */
+    ret = H5Treclaim(mtid, sid1, H5P_DEFAULT, wseq);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Treclaim(stid, sid1, H5P_DEFAULT, wstr);
+    CHECK(ret, FAIL, "H5Treclaim");
+    ret = H5Dclose(dset1);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Dclose(dset2);
+    CHECK(ret, FAIL, "H5Dclose");
+    ret = H5Pclose(dcpl);
+    CHECK(ret, FAIL, "H5Pclose");
+    ret = H5Tclose(stid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(dtid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(ftid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Tclose(mtid);
+    CHECK(ret, FAIL, "H5Tclose");
+    ret = H5Sclose(sid1);
+    CHECK(ret, FAIL, "H5Sclose");
+    ret = H5Fclose(fid1);
+    CHECK(ret, FAIL, "H5Fclose");
+
+    HDfree(rseq);
+    HDfree(wstr);
+    HDfree(wseq);
+} /* end test_vltypes_inline() */
+
 /****************************************************************
 **
 **  test_vltypes(): Main VL datatype testing routine.
@@ -3242,6 +4020,9 @@ test_vltypes(void)
     test_vltypes_compound_vlen_vlen();          /* Test compound datatypes with VL atomic components */
     test_vltypes_compound_vlstr();              /* Test data rewritten of nested VL data */
     test_vltypes_fill_value();                  /* Test fill value for VL data */
+    test_vltypes_vlen_arena();                  /* Test reading VL data into an arena */
+    test_vltypes_gheap_batch();                 /* Test batched global heap access for VL data */
+    test_vltypes_inline();                      /* Test VL data stored inline in chunks */
 } /* test_vltypes() */
 
 /*-------------------------------------------------------------------------
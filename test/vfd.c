@@ -47,6 +47,16 @@
 #define DSET2_DIM  4
 #endif /* H5_HAVE_DIRECT */
 
+/* Macros for memory-mapped VFD */
+#define MMAP_DSET2_NAME "dset2"
+#define MMAP_CHUNK_DIM  64
+
+/* Macros for io_uring VFD */
+#ifdef H5_HAVE_IOURING_VFD
+#define IOURING_QUEUE_DEPTH 8
+#define IOURING_BUF_SIZE    (4 * KB)
+#endif /* H5_HAVE_IOURING_VFD */
+
 static const char *FILENAME[] = {"sec2_file",            /*0*/
                                  "core_file",            /*1*/
                                  "family_file",          /*2*/
@@ -63,6 +73,8 @@ static const char *FILENAME[] = {"sec2_file",            /*0*/
                                  "splitter.log",         /*13*/
                                  "ctl_file",             /*14*/
                                  "ctl_splitter_wo_file", /*15*/
+                                 "iouring_file",         /*16*/
+                                 "mmap_file",            /*17*/
                                  NULL};
 
 #define LOG_FILENAME "log_vfd_out.log"
@@ -234,6 +246,11 @@ test_sec2(void)
         TEST_ERROR;
     if (!(driver_flags & H5FD_FEAT_DEFAULT_VFD_COMPATIBLE))
         TEST_ERROR;
+#ifdef H5_HAVE_PREADWRITEV
+    if (!(driver_flags & H5FD_FEAT_SELECTION_IO_OPT_IN))
+        TEST_ERROR;
+    driver_flags &= ~(unsigned long)H5FD_FEAT_SELECTION_IO_OPT_IN;
+#endif /* H5_HAVE_PREADWRITEV */
     /* Check for extra flags not accounted for above */
     if (driver_flags != (H5FD_FEAT_AGGREGATE_METADATA | H5FD_FEAT_ACCUMULATE_METADATA | H5FD_FEAT_DATA_SIEVE |
                          H5FD_FEAT_AGGREGATE_SMALLDATA | H5FD_FEAT_POSIX_COMPAT_HANDLE |
@@ -916,6 +933,517 @@ error:
 #endif /*H5_HAVE_DIRECT*/
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_iouring
+ *
+ * Purpose:     Tests the file handle interface for the io_uring driver,
+ *              and writes and reads datasets with each of its modes.  The
+ *              small queue depth and staging buffers make the requests
+ *              wrap around the ring and split across buffers.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_iouring(void)
+{
+#ifdef H5_HAVE_IOURING_VFD
+    hid_t    file = -1, fapl = -1, access_fapl = -1;
+    hid_t    dset = -1, space = -1, mspace = -1;
+    char     filename[1024];
+    int     *fhandle = NULL;
+    hsize_t  dims[2], start[2], stride[2], count[2];
+    unsigned queue_depth;
+    unsigned flags;
+    size_t   buf_size;
+    int     *points = NULL, *check = NULL;
+    herr_t   ret;
+    int      mode;
+    int      i, j;
+#endif /* H5_HAVE_IOURING_VFD */
+
+    TESTING("io_uring file driver");
+
+#ifndef H5_HAVE_IOURING_VFD
+    SKIPPED();
+    return 0;
+#else  /* H5_HAVE_IOURING_VFD */
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+
+    /* Check the default property values */
+    if (H5Pset_fapl_iouring(fapl, 0, 0, 0) < 0)
+        TEST_ERROR;
+    if (H5Pget_fapl_iouring(fapl, &queue_depth, &flags, &buf_size) < 0)
+        TEST_ERROR;
+    if (queue_depth != H5FD_IOURING_QUEUE_DEPTH_DEF || flags != 0 || buf_size != H5FD_IOURING_BUF_SIZE_DEF)
+        TEST_ERROR;
+
+    /* Staging buffers must be made of whole blocks, and flags must be known */
+    H5E_BEGIN_TRY
+    {
+        ret = H5Pset_fapl_iouring(fapl, 0, 0, H5FD_IOURING_BLOCK_SIZE + 1);
+    }
+    H5E_END_TRY
+    if (ret >= 0)
+        TEST_ERROR;
+    H5E_BEGIN_TRY
+    {
+        ret = H5Pset_fapl_iouring(fapl, 0, 0x8000u, 0);
+    }
+    H5E_END_TRY
+    if (ret >= 0)
+        TEST_ERROR;
+
+    if (NULL == (points = (int *)HDmalloc(DSET1_DIM1 * DSET1_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (check = (int *)HDmalloc(DSET1_DIM1 * DSET1_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    for (i = 0; i < DSET1_DIM1 * DSET1_DIM2; i++)
+        points[i] = i;
+
+    dims[0] = DSET1_DIM1;
+    dims[1] = DSET1_DIM2;
+    if ((space = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+
+    /* Write and read a dataset with no staging, registered staging
+     * buffers, O_DIRECT, and O_DIRECT with registered buffers */
+    for (mode = 0; mode < 4; mode++) {
+        unsigned mode_flags = 0;
+
+        if (mode & 1)
+            mode_flags |= H5FD_IOURING_REGISTER_BUFFERS;
+        if (mode & 2)
+            mode_flags |= H5FD_IOURING_DIRECT_IO;
+
+        if (H5Pset_fapl_iouring(fapl, IOURING_QUEUE_DEPTH, mode_flags, IOURING_BUF_SIZE) < 0)
+            TEST_ERROR;
+        if (H5Pget_fapl_iouring(fapl, &queue_depth, &flags, &buf_size) < 0)
+            TEST_ERROR;
+        if (queue_depth != IOURING_QUEUE_DEPTH || flags != mode_flags || buf_size != IOURING_BUF_SIZE)
+            TEST_ERROR;
+        h5_fixname(FILENAME[16], fapl, filename, sizeof filename);
+
+        H5E_BEGIN_TRY
+        {
+            file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+        }
+        H5E_END_TRY
+        if (file < 0) {
+            /* The file system may not support O_DIRECT */
+            if (mode_flags & H5FD_IOURING_DIRECT_IO)
+                continue;
+            TEST_ERROR;
+        }
+
+        /* Check that the driver is correct */
+        if ((access_fapl = H5Fget_access_plist(file)) < 0)
+            TEST_ERROR;
+        if (H5FD_IOURING != H5Pget_driver(access_fapl))
+            TEST_ERROR;
+        if (H5Pclose(access_fapl) < 0)
+            TEST_ERROR;
+
+        /* Check file handle API */
+        if (H5Fget_vfd_handle(file, H5P_DEFAULT, (void **)&fhandle) < 0)
+            TEST_ERROR;
+        if (*fhandle < 0)
+            TEST_ERROR;
+
+        /* Write the whole dataset */
+        if ((dset = H5Dcreate2(file, DSET1_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT,
+                               H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if (H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, points) < 0)
+            TEST_ERROR;
+
+        /* Overwrite every other element of one column, which makes many small
+         * pieces that don't line up with blocks */
+        start[0]  = 1;
+        start[1]  = 3;
+        stride[0] = 2;
+        stride[1] = 1;
+        count[0]  = DSET1_DIM1 / 2;
+        count[1]  = 1;
+        dims[0]   = DSET1_DIM1 / 2;
+        if ((mspace = H5Screate_simple(1, dims, NULL)) < 0)
+            TEST_ERROR;
+        if (H5Sselect_hyperslab(space, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+            TEST_ERROR;
+        for (i = 0; i < DSET1_DIM1 / 2; i++)
+            check[i] = -i;
+        if (H5Dwrite(dset, H5T_NATIVE_INT, mspace, space, H5P_DEFAULT, check) < 0)
+            TEST_ERROR;
+        for (i = 0; i < DSET1_DIM1 / 2; i++)
+            points[((2 * i) + 1) * DSET1_DIM2 + 3] = -i;
+        if (H5Sselect_all(space) < 0)
+            TEST_ERROR;
+        if (H5Sclose(mspace) < 0)
+            TEST_ERROR;
+
+        if (H5Dclose(dset) < 0)
+            TEST_ERROR;
+        if (H5Fclose(file) < 0)
+            TEST_ERROR;
+
+        /* Reopen the file and read the data back */
+        if ((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+            TEST_ERROR;
+        if ((dset = H5Dopen2(file, DSET1_NAME, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        HDmemset(check, 0, DSET1_DIM1 * DSET1_DIM2 * sizeof(int));
+        if (H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check) < 0)
+            TEST_ERROR;
+        for (i = 0; i < DSET1_DIM1; i++)
+            for (j = 0; j < DSET1_DIM2; j++)
+                if (points[i * DSET1_DIM2 + j] != check[i * DSET1_DIM2 + j]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written with flags 0x%x.\n", mode_flags);
+                    HDprintf("    At index %d,%d\n", i, j);
+                    TEST_ERROR;
+                } /* end if */
+        if (H5Dclose(dset) < 0)
+            TEST_ERROR;
+        if (H5Fclose(file) < 0)
+            TEST_ERROR;
+
+        /* The file must be usable by the default driver */
+        if ((file = H5Fopen(filename, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        if ((dset = H5Dopen2(file, DSET1_NAME, H5P_DEFAULT)) < 0)
+            TEST_ERROR;
+        HDmemset(check, 0, DSET1_DIM1 * DSET1_DIM2 * sizeof(int));
+        if (H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, check) < 0)
+            TEST_ERROR;
+        if (HDmemcmp(points, check, DSET1_DIM1 * DSET1_DIM2 * sizeof(int)) != 0)
+            TEST_ERROR;
+        if (H5Dclose(dset) < 0)
+            TEST_ERROR;
+        if (H5Fclose(file) < 0)
+            TEST_ERROR;
+
+        h5_delete_test_file(FILENAME[16], fapl);
+    } /* end for */
+
+    if (H5Sclose(space) < 0)
+        TEST_ERROR;
+    if (H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    HDfree(points);
+    HDfree(check);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(fapl);
+        H5Sclose(space);
+        H5Sclose(mspace);
+        H5Dclose(dset);
+        H5Fclose(file);
+    }
+    H5E_END_TRY
+
+    if (points)
+        HDfree(points);
+    if (check)
+        HDfree(check);
+
+    return -1;
+#endif /* H5_HAVE_IOURING_VFD */
+}
+
+/*-------------------------------------------------------------------------
+ * Function:    test_mmap
+ *
+ * Purpose:     Tests the read-only memory-mapped driver.  A file written
+ *              by the default driver is read back through the mapping,
+ *              with and without selection I/O, so that contiguous data is
+ *              copied from the mapping by both the driver's callbacks and
+ *              the dataset layer.  Opening for writing must fail.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_mmap(void)
+{
+#ifdef H5_HAVE_MMAP
+    hid_t                     file = -1, fapl = -1, access_fapl = -1, dcpl = -1, dxpl = -1;
+    hid_t                     dset = -1, space = -1, mspace = -1;
+    H5FD_t                   *lf = NULL;
+    H5FD_ctl_mapped_region_t  region;
+    H5FD_ctl_mapped_region_t *region_ptr = &region;
+    char                      filename[1024];
+    int                      *fhandle = NULL;
+    hsize_t                   dims[2], chunk_dims[2], start[2], stride[2], count[2];
+    h5_stat_size_t            file_size;
+    H5FD_mem_t                types[2]  = {H5FD_MEM_SUPER, H5FD_MEM_NOLIST};
+    haddr_t                   addrs[2]  = {0, 0};
+    size_t                    sizes[2]  = {8, 16};
+    unsigned char             sig[8]    = {0};
+    unsigned char             tail[16]  = {0};
+    void                     *bufs[2]   = {sig, tail};
+    int                      *points    = NULL, *check = NULL;
+    long long                *lcheck    = NULL;
+    unsigned long             driver_flags = 0;
+    hid_t                     ret;
+    int                       use_select_io;
+    int                       i, j;
+#endif /* H5_HAVE_MMAP */
+
+    TESTING("memory-mapped file driver");
+
+#ifndef H5_HAVE_MMAP
+    SKIPPED();
+    return 0;
+#else  /* H5_HAVE_MMAP */
+
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+    if (H5Pset_fapl_mmap(fapl) < 0)
+        TEST_ERROR;
+    h5_fixname(FILENAME[17], fapl, filename, sizeof filename);
+
+    /* The driver can't create files */
+    H5E_BEGIN_TRY
+    {
+        ret = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    }
+    H5E_END_TRY
+    if (ret >= 0)
+        TEST_ERROR;
+
+    if (NULL == (points = (int *)HDmalloc(DSET1_DIM1 * DSET1_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (check = (int *)HDmalloc(DSET1_DIM1 * DSET1_DIM2 * sizeof(int))))
+        TEST_ERROR;
+    if (NULL == (lcheck = (long long *)HDmalloc(DSET1_DIM1 * DSET1_DIM2 * sizeof(long long))))
+        TEST_ERROR;
+    for (i = 0; i < DSET1_DIM1 * DSET1_DIM2; i++)
+        points[i] = i;
+
+    /* Write a contiguous and a chunked dataset with the default driver */
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR;
+    dims[0] = DSET1_DIM1;
+    dims[1] = DSET1_DIM2;
+    if ((space = H5Screate_simple(2, dims, NULL)) < 0)
+        TEST_ERROR;
+    if ((dset = H5Dcreate2(file, DSET1_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) <
+        0)
+        TEST_ERROR;
+    if (H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, points) < 0)
+        TEST_ERROR;
+    if (H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        TEST_ERROR;
+    chunk_dims[0] = MMAP_CHUNK_DIM;
+    chunk_dims[1] = DSET1_DIM2 / 2;
+    if (H5Pset_chunk(dcpl, 2, chunk_dims) < 0)
+        TEST_ERROR;
+    if ((dset = H5Dcreate2(file, MMAP_DSET2_NAME, H5T_NATIVE_INT, space, H5P_DEFAULT, dcpl, H5P_DEFAULT)) <
+        0)
+        TEST_ERROR;
+    if (H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, points) < 0)
+        TEST_ERROR;
+    if (H5Dclose(dset) < 0)
+        TEST_ERROR;
+    if (H5Pclose(dcpl) < 0)
+        TEST_ERROR;
+    if (H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* The driver can't open files for writing */
+    H5E_BEGIN_TRY
+    {
+        ret = H5Fopen(filename, H5F_ACC_RDWR, fapl);
+    }
+    H5E_END_TRY
+    if (ret >= 0)
+        TEST_ERROR;
+
+    if ((file = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0)
+        TEST_ERROR;
+
+    /* Check that the driver is correct */
+    if ((access_fapl = H5Fget_access_plist(file)) < 0)
+        TEST_ERROR;
+    if (H5FD_MMAP != H5Pget_driver(access_fapl))
+        TEST_ERROR;
+    if (H5Pclose(access_fapl) < 0)
+        TEST_ERROR;
+
+    /* Check file handle API */
+    if (H5Fget_vfd_handle(file, H5P_DEFAULT, (void **)&fhandle) < 0)
+        TEST_ERROR;
+    if (*fhandle < 0)
+        TEST_ERROR;
+
+    /* Read the data with selection I/O, which goes through the driver's
+     * vector callback, and without it, which copies contiguous data from
+     * the mapping in the dataset layer */
+    if ((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR;
+    for (use_select_io = 0; use_select_io < 2; use_select_io++) {
+        if (H5Pset_selection_io(dxpl, use_select_io ? H5D_SELECTION_IO_MODE_ON : H5D_SELECTION_IO_MODE_OFF) <
+            0)
+            TEST_ERROR;
+
+        for (j = 0; j < 2; j++) {
+            if ((dset = H5Dopen2(file, j ? MMAP_DSET2_NAME : DSET1_NAME, H5P_DEFAULT)) < 0)
+                TEST_ERROR;
+
+            /* The whole dataset */
+            HDmemset(check, 0, DSET1_DIM1 * DSET1_DIM2 * sizeof(int));
+            if (H5Dread(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, check) < 0)
+                TEST_ERROR;
+            if (HDmemcmp(points, check, DSET1_DIM1 * DSET1_DIM2 * sizeof(int)) != 0)
+                TEST_ERROR;
+
+            /* The whole dataset, converted to another type */
+            HDmemset(lcheck, 0, DSET1_DIM1 * DSET1_DIM2 * sizeof(long long));
+            if (H5Dread(dset, H5T_NATIVE_LLONG, H5S_ALL, H5S_ALL, dxpl, lcheck) < 0)
+                TEST_ERROR;
+            for (i = 0; i < DSET1_DIM1 * DSET1_DIM2; i++)
+                if (lcheck[i] != (long long)points[i])
+                    TEST_ERROR;
+
+            /* Every third element of two columns, which makes many small pieces */
+            start[0]  = 1;
+            start[1]  = 5;
+            stride[0] = 3;
+            stride[1] = 1;
+            count[0]  = DSET1_DIM1 / 3;
+            count[1]  = 2;
+            dims[0]   = count[0] * count[1];
+            if ((mspace = H5Screate_simple(1, dims, NULL)) < 0)
+                TEST_ERROR;
+            if (H5Sselect_hyperslab(space, H5S_SELECT_SET, start, stride, count, NULL) < 0)
+                TEST_ERROR;
+            HDmemset(check, 0, DSET1_DIM1 * DSET1_DIM2 * sizeof(int));
+            if (H5Dread(dset, H5T_NATIVE_INT, mspace, space, dxpl, check) < 0)
+                TEST_ERROR;
+            for (i = 0; i < (int)count[0]; i++)
+                if (check[2 * i] != points[(1 + 3 * i) * DSET1_DIM2 + 5] ||
+                    check[2 * i + 1] != points[(1 + 3 * i) * DSET1_DIM2 + 6]) {
+                    H5_FAILED();
+                    HDprintf("    Read different values than written at row %d.\n", 1 + 3 * i);
+                    TEST_ERROR;
+                } /* end if */
+            if (H5Sselect_all(space) < 0)
+                TEST_ERROR;
+            if (H5Sclose(mspace) < 0)
+                TEST_ERROR;
+
+            if (H5Dclose(dset) < 0)
+                TEST_ERROR;
+        } /* end for */
+    }     /* end for */
+
+    if (H5Pclose(dxpl) < 0)
+        TEST_ERROR;
+    if (H5Fclose(file) < 0)
+        TEST_ERROR;
+
+    /* Check the mapped region and vector reads, including one past the end
+     * of the file, through the driver interface */
+    if ((file_size = h5_get_file_size(filename, fapl)) < 0)
+        TEST_ERROR;
+    if (NULL == (lf = H5FDopen(filename, H5F_ACC_RDONLY, fapl, HADDR_UNDEF)))
+        TEST_ERROR;
+    if (H5FDquery(lf, &driver_flags) < 0)
+        TEST_ERROR;
+    if (!(driver_flags & H5FD_FEAT_MAPPED_REGION))
+        TEST_ERROR;
+    region.base = NULL;
+    region.size = 0;
+    if (H5FDctl(lf, H5FD_CTL_GET_MAPPED_REGION_OPCODE, H5FD_CTL_FAIL_IF_UNKNOWN_FLAG, NULL,
+                (void **)&region_ptr) < 0)
+        TEST_ERROR;
+    if (NULL == region.base || region.size != (haddr_t)file_size)
+        TEST_ERROR;
+    if (HDmemcmp(region.base, "\211HDF\r\n\032\n", 8) != 0)
+        TEST_ERROR;
+
+    addrs[1] = (haddr_t)file_size - 8;
+    if (H5FDset_eoa(lf, H5FD_MEM_SUPER, addrs[1] + sizes[1]) < 0)
+        TEST_ERROR;
+    HDmemset(tail, 0xff, sizeof(tail));
+    if (H5FDread_vector(lf, H5P_DEFAULT, 2, types, addrs, sizes, bufs) < 0)
+        TEST_ERROR;
+    if (HDmemcmp(sig, region.base, 8) != 0)
+        TEST_ERROR;
+    if (HDmemcmp(tail, (const unsigned char *)region.base + addrs[1], 8) != 0)
+        TEST_ERROR;
+    for (i = 8; i < 16; i++)
+        if (tail[i] != 0)
+            TEST_ERROR;
+
+    /* Writes must fail */
+    H5E_BEGIN_TRY
+    {
+        ret = H5FDwrite(lf, H5FD_MEM_SUPER, H5P_DEFAULT, 0, 8, sig);
+    }
+    H5E_END_TRY
+    if (ret >= 0)
+        TEST_ERROR;
+
+    if (H5FDclose(lf) < 0)
+        TEST_ERROR;
+    lf = NULL;
+
+    if (H5Sclose(space) < 0)
+        TEST_ERROR;
+
+    h5_delete_test_file(FILENAME[17], fapl);
+
+    if (H5Pclose(fapl) < 0)
+        TEST_ERROR;
+
+    HDfree(points);
+    HDfree(check);
+    HDfree(lcheck);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(fapl);
+        H5Pclose(dcpl);
+        H5Pclose(dxpl);
+        H5Sclose(space);
+        H5Sclose(mspace);
+        H5Dclose(dset);
+        H5Fclose(file);
+        if (lf)
+            H5FDclose(lf);
+    }
+    H5E_END_TRY
+
+    if (points)
+        HDfree(points);
+    if (check)
+        HDfree(check);
+    if (lcheck)
+        HDfree(lcheck);
+
+    return -1;
+#endif /* H5_HAVE_MMAP */
+}
+
 /*-------------------------------------------------------------------------
  * Function:    test_family_opens
  *
@@ -4607,6 +5135,15 @@ test_vector_io(const char *vfd_name)
 
         h5_fixname(FILENAME[7], fapl_id, filename, sizeof filename);
     }
+#ifdef H5_HAVE_IOURING_VFD
+    else if (HDstrcmp(vfd_name, "iouring") == 0) {
+
+        if (H5Pset_fapl_iouring(fapl_id, IOURING_QUEUE_DEPTH, 0, 0) < 0)
+            TEST_ERROR;
+
+        h5_fixname(FILENAME[16], fapl_id, filename, sizeof filename);
+    }
+#endif /* H5_HAVE_IOURING_VFD */
     else {
 
         HDfprintf(stdout, "un-supported VFD\n");
@@ -4951,6 +5488,148 @@ error:
     return -1;
 } /* end test_vector_io() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_vector_io_eof
+ *
+ * Purpose:     Test vector I/O with requests that are out of address order,
+ *              contiguous in the file, and past the end of the file.  The
+ *              contiguous requests are combined into single system calls
+ *              by drivers that support it, and the parts of the reads past
+ *              the end of the file must be filled with zeros.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define VECTOR_EOF_BLOCK 256
+static herr_t
+test_vector_io_eof(const char *vfd_name)
+{
+    char          test_title[80];
+    char          filename[1024];     /* filename                     */
+    const char   *base_name = NULL;   /* base of filename             */
+    hid_t         fapl_id   = -1;     /* file access property list ID */
+    H5FD_t       *lf        = NULL;   /* VFD struct ptr               */
+    unsigned char wbuf[4 * VECTOR_EOF_BLOCK];
+    unsigned char rbuf[6 * VECTOR_EOF_BLOCK];
+    H5FD_mem_t    types[2] = {H5FD_MEM_DRAW, H5FD_MEM_NOLIST};
+    haddr_t       w_addrs[4]; /* write addresses vector       */
+    size_t        w_sizes[2] = {VECTOR_EOF_BLOCK, 0};
+    const void   *w_bufs[4];  /* write bufs vector            */
+    haddr_t       r_addrs[5]; /* read addresses vector        */
+    size_t        r_sizes[5]; /* read sizes vector            */
+    void         *r_bufs[5];  /* read bufs vector             */
+    size_t        i;          /* index                        */
+
+    HDsnprintf(test_title, sizeof(test_title), "vector I/O past EOF with %s VFD", vfd_name);
+
+    TESTING(test_title);
+
+    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        TEST_ERROR;
+    if (HDstrcmp(vfd_name, "sec2") == 0) {
+        if (H5Pset_fapl_sec2(fapl_id) < 0)
+            TEST_ERROR;
+        base_name = FILENAME[0];
+    }
+    else if (HDstrcmp(vfd_name, "stdio") == 0) {
+        if (H5Pset_fapl_stdio(fapl_id) < 0)
+            TEST_ERROR;
+        base_name = FILENAME[7];
+    }
+#ifdef H5_HAVE_IOURING_VFD
+    else if (HDstrcmp(vfd_name, "iouring") == 0) {
+        /* Registered staging buffers smaller than some requests */
+        if (H5Pset_fapl_iouring(fapl_id, IOURING_QUEUE_DEPTH, H5FD_IOURING_REGISTER_BUFFERS,
+                                IOURING_BUF_SIZE) < 0)
+            TEST_ERROR;
+        base_name = FILENAME[16];
+    }
+    else if (HDstrcmp(vfd_name, "iouring direct") == 0) {
+        /* Every request is unaligned, so writes read the blocks first */
+        if (H5Pset_fapl_iouring(fapl_id, IOURING_QUEUE_DEPTH, H5FD_IOURING_DIRECT_IO, IOURING_BUF_SIZE) < 0)
+            TEST_ERROR;
+        base_name = FILENAME[16];
+    }
+#endif /* H5_HAVE_IOURING_VFD */
+    else {
+        HDfprintf(stdout, "un-supported VFD\n");
+        TEST_ERROR;
+    }
+    h5_fixname(base_name, fapl_id, filename, sizeof(filename));
+
+    H5E_BEGIN_TRY
+    {
+        lf = H5FDopen(filename, H5F_ACC_RDWR | H5F_ACC_CREAT | H5F_ACC_TRUNC, fapl_id, HADDR_UNDEF);
+    }
+    H5E_END_TRY
+    if (NULL == lf) {
+        /* The file system may not support O_DIRECT */
+        if (HDstrstr(vfd_name, "direct")) {
+            H5Pclose(fapl_id);
+            SKIPPED();
+            return 0;
+        }
+        TEST_ERROR;
+    }
+    if (H5FDset_eoa(lf, H5FD_MEM_DRAW, (haddr_t)(8 * VECTOR_EOF_BLOCK)) < 0)
+        TEST_ERROR;
+
+    /* Write four contiguous blocks, out of order */
+    for (i = 0; i < sizeof(wbuf); i++)
+        wbuf[i] = (unsigned char)(i % 251 + 1);
+    for (i = 0; i < 4; i++) {
+        w_addrs[i] = (haddr_t)(((i + 3) % 4) * VECTOR_EOF_BLOCK);
+        w_bufs[i]  = wbuf + w_addrs[i];
+    }
+    if (H5FDwrite_vector(lf, H5P_DEFAULT, 4, types, w_addrs, w_sizes, w_bufs) < 0)
+        TEST_ERROR;
+
+    /* Read them back, out of order, along with a read that starts inside
+     * the file and ends past its end, and one entirely past its end */
+    HDmemset(rbuf, 0xff, sizeof(rbuf));
+    r_addrs[0] = 2 * VECTOR_EOF_BLOCK;
+    r_sizes[0] = VECTOR_EOF_BLOCK;
+    r_bufs[0]  = rbuf + 2 * VECTOR_EOF_BLOCK;
+    r_addrs[1] = 0;
+    r_sizes[1] = 2 * VECTOR_EOF_BLOCK;
+    r_bufs[1]  = rbuf;
+    r_addrs[2] = 3 * VECTOR_EOF_BLOCK;
+    r_sizes[2] = 2 * VECTOR_EOF_BLOCK;
+    r_bufs[2]  = rbuf + 3 * VECTOR_EOF_BLOCK;
+    r_addrs[3] = 6 * VECTOR_EOF_BLOCK;
+    r_sizes[3] = VECTOR_EOF_BLOCK;
+    r_bufs[3]  = rbuf + 5 * VECTOR_EOF_BLOCK;
+    if (H5FDread_vector(lf, H5P_DEFAULT, 4, types, r_addrs, r_sizes, r_bufs) < 0)
+        TEST_ERROR;
+
+    for (i = 0; i < sizeof(rbuf); i++)
+        if (rbuf[i] != (i < sizeof(wbuf) ? wbuf[i] : 0))
+            TEST_ERROR;
+
+    if (H5FDclose(lf) < 0)
+        TEST_ERROR;
+    lf = NULL;
+
+    h5_delete_test_file(base_name, fapl_id);
+
+    if (H5Pclose(fapl_id) < 0)
+        TEST_ERROR;
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(fapl_id);
+        H5FDclose(lf);
+    }
+    H5E_END_TRY
+    return -1;
+} /* end test_vector_io_eof() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_selection_io_write
  *
@@ -5146,6 +5825,15 @@ test_selection_io(const char *vfd_name)
 
         h5_fixname(FILENAME[7], fapl_id, filename, sizeof filename);
     }
+#ifdef H5_HAVE_IOURING_VFD
+    else if (HDstrcmp(vfd_name, "iouring") == 0) {
+
+        if (H5Pset_fapl_iouring(fapl_id, IOURING_QUEUE_DEPTH, 0, 0) < 0)
+            TEST_ERROR;
+
+        h5_fixname(FILENAME[16], fapl_id, filename, sizeof filename);
+    }
+#endif /* H5_HAVE_IOURING_VFD */
     else {
 
         HDfprintf(stdout, "un-supported VFD\n");
@@ -5966,6 +6654,8 @@ main(void)
     nerrors += test_sec2() < 0 ? 1 : 0;
     nerrors += test_core() < 0 ? 1 : 0;
     nerrors += test_direct() < 0 ? 1 : 0;
+    nerrors += test_iouring() < 0 ? 1 : 0;
+    nerrors += test_mmap() < 0 ? 1 : 0;
     nerrors += test_family() < 0 ? 1 : 0;
     nerrors += test_family_compat() < 0 ? 1 : 0;
     nerrors += test_family_member_fapl() < 0 ? 1 : 0;
@@ -5978,8 +6668,16 @@ main(void)
     nerrors += test_splitter() < 0 ? 1 : 0;
     nerrors += test_vector_io("sec2") < 0 ? 1 : 0;
     nerrors += test_vector_io("stdio") < 0 ? 1 : 0;
+    nerrors += test_vector_io_eof("sec2") < 0 ? 1 : 0;
+    nerrors += test_vector_io_eof("stdio") < 0 ? 1 : 0;
     nerrors += test_selection_io("sec2") < 0 ? 1 : 0;
     nerrors += test_selection_io("stdio") < 0 ? 1 : 0;
+#ifdef H5_HAVE_IOURING_VFD
+    nerrors += test_vector_io("iouring") < 0 ? 1 : 0;
+    nerrors += test_vector_io_eof("iouring") < 0 ? 1 : 0;
+    nerrors += test_vector_io_eof("iouring direct") < 0 ? 1 : 0;
+    nerrors += test_selection_io("iouring") < 0 ? 1 : 0;
+#endif /* H5_HAVE_IOURING_VFD */
     nerrors += test_ctl() < 0 ? 1 : 0;
 
     if (nerrors) {
@@ -184,6 +184,25 @@ if (HDF5_TEST_SERIAL)
       DEPENDS "PERFORM_zip_perf_help"
       FIXTURES_REQUIRED clear_perform
   )
+
+  if (HDF5_ENABLE_USING_MEMCHECKER)
+    add_test (NAME PERFORM_shuffle_perf COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR} $<TARGET_FILE:shuffle_perf> -s 1048576 -n 2)
+  else ()
+    add_test (NAME PERFORM_shuffle_perf COMMAND "${CMAKE_COMMAND}"
+        -D "TEST_EMULATOR=${CMAKE_CROSSCOMPILING_EMULATOR}"
+        -D "TEST_PROGRAM=$<TARGET_FILE:shuffle_perf>"
+        -D "TEST_ARGS:STRING=-s;1048576;-n;2"
+        -D "TEST_EXPECT=0"
+        -D "TEST_SKIP_COMPARE=TRUE"
+        -D "TEST_OUTPUT=shuffle_perf.txt"
+        #-D "TEST_REFERENCE=shuffle_perf.out"
+        -D "TEST_FOLDER=${PROJECT_BINARY_DIR}"
+        -P "${HDF_RESOURCES_DIR}/runTest.cmake"
+    )
+  endif ()
+  set_tests_properties (PERFORM_shuffle_perf PROPERTIES
+      FIXTURES_REQUIRED clear_perform
+  )
 endif ()
 
 if (H5_HAVE_PARALLEL AND HDF5_TEST_PARALLEL)
@@ -0,0 +1,179 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:     Measures the bandwidth of the shuffle filter's kernels, in
+ *              the byte and bit modes, for each instruction set the CPU
+ *              supports and each element size with a vector kernel, in both
+ *              directions.
+ */
+
+#define H5Z_FRIEND /*suppress error about including H5Zpkg */
+
+#include "hdf5.h"
+
+#include "H5private.h"
+#include "H5Zpkg.h"
+
+#define SHUFFLE_PERF_BUF_SIZE   (16 * 1024 * 1024) /* Default size of the buffers, in bytes */
+#define SHUFFLE_PERF_ITERATIONS 10                 /* Default number of passes per kernel */
+
+static const char *isa_names[H5Z_SHUFFLE_ISA_NTYPES] = {"scalar", "sse2", "avx2", "avx512"};
+
+/*-------------------------------------------------------------------------
+ * Function:  usage
+ *
+ * Purpose:   Prints the command line options.
+ *
+ * Return:    void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+usage(const char *prog)
+{
+    HDfprintf(stdout, "usage: %s [-h] [-s BYTES] [-n PASSES]\n", prog);
+    HDfprintf(stdout, "    -h          Print this message\n");
+    HDfprintf(stdout, "    -s BYTES    Size of the buffer to shuffle (default %d)\n", SHUFFLE_PERF_BUF_SIZE);
+    HDfprintf(stdout, "    -n PASSES   Number of passes over the buffer per kernel (default %d)\n",
+              SHUFFLE_PERF_ITERATIONS);
+}
+
+/*-------------------------------------------------------------------------
+ * Function:  time_kernel
+ *
+ * Purpose:   Shuffles or unshuffles the bytes (or the bits, if BITS is
+ *            set) of SRC into DEST NPASSES times with the kernels of ISA,
+ *            and returns the bandwidth in GB/s.
+ *
+ * Return:    Success:    Bandwidth, in GB/s
+ *            Failure:    Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static double
+time_kernel(H5Z_shuffle_isa_t isa, hbool_t bits, hbool_t reverse, unsigned elmt_size, size_t nbytes,
+            unsigned npasses, const unsigned char *src, unsigned char *dest)
+{
+    size_t   nelmts = nbytes / elmt_size;
+    uint64_t start, stop;
+    unsigned u;
+
+    /* Warm up the caches and the page tables */
+    if ((bits ? H5Z__bitshuffle_bytes : H5Z__shuffle_bytes)(isa, reverse, elmt_size, nelmts, src, dest) < 0)
+        return -1.0;
+
+    start = H5_now_usec();
+    for (u = 0; u < npasses; u++)
+        if ((bits ? H5Z__bitshuffle_bytes : H5Z__shuffle_bytes)(isa, reverse, elmt_size, nelmts, src, dest) <
+            0)
+            return -1.0;
+    stop = H5_now_usec();
+
+    if (stop == start)
+        stop = start + 1;
+
+    return ((double)(nelmts * elmt_size) * npasses) / ((double)(stop - start) * 1000.0);
+}
+
+/*-------------------------------------------------------------------------
+ * Function:  main
+ *
+ * Purpose:   Prints a table of the bandwidth of each kernel.
+ *
+ * Return:    Success:    EXIT_SUCCESS
+ *            Failure:    EXIT_FAILURE
+ *
+ *-------------------------------------------------------------------------
+ */
+int
+main(int argc, char *argv[])
+{
+    const unsigned    elmt_sizes[] = {2, 4, 8, 16};
+    size_t            nbytes       = SHUFFLE_PERF_BUF_SIZE;
+    unsigned          npasses      = SHUFFLE_PERF_ITERATIONS;
+    unsigned char    *src          = NULL;
+    unsigned char    *dest         = NULL;
+    H5Z_shuffle_isa_t best_isa;
+    int               bits;
+    int               isa;
+    int               i;
+    size_t            u;
+
+    for (i = 1; i < argc; i++) {
+        if (!HDstrcmp(argv[i], "-h")) {
+            usage(argv[0]);
+            HDexit(EXIT_SUCCESS);
+        }
+        else if (!HDstrcmp(argv[i], "-s") && i + 1 < argc)
+            nbytes = (size_t)HDstrtoul(argv[++i], NULL, 0);
+        else if (!HDstrcmp(argv[i], "-n") && i + 1 < argc)
+            npasses = (unsigned)HDstrtoul(argv[++i], NULL, 0);
+        else {
+            usage(argv[0]);
+            HDexit(EXIT_FAILURE);
+        }
+    }
+    if (nbytes < 16 || npasses == 0) {
+        usage(argv[0]);
+        HDexit(EXIT_FAILURE);
+    }
+
+    if (H5open() < 0)
+        goto error;
+
+    if (NULL == (src = (unsigned char *)HDmalloc(nbytes)))
+        goto error;
+    if (NULL == (dest = (unsigned char *)HDmalloc(nbytes)))
+        goto error;
+    for (u = 0; u < nbytes; u++)
+        src[u] = (unsigned char)HDrandom();
+
+    best_isa = H5Z__shuffle_best_isa();
+
+    HDfprintf(stdout, "Shuffle filter kernels, %zu byte buffer, %u passes (GB/s)\n", nbytes, npasses);
+    HDfprintf(stdout, "%-5s %-8s %-10s", "mode", "size", "direction");
+    for (isa = H5Z_SHUFFLE_ISA_SCALAR; isa <= (int)best_isa; isa++)
+        HDfprintf(stdout, " %9s", isa_names[isa]);
+    HDfprintf(stdout, "\n");
+
+    for (bits = 0; bits <= 1; bits++)
+        for (u = 0; u < NELMTS(elmt_sizes); u++) {
+            int reverse;
+
+            for (reverse = 0; reverse <= 1; reverse++) {
+                HDfprintf(stdout, "%-5s %-8u %-10s", bits ? "bit" : "byte", elmt_sizes[u],
+                          reverse ? "unshuffle" : "shuffle");
+                for (isa = H5Z_SHUFFLE_ISA_SCALAR; isa <= (int)best_isa; isa++) {
+                    double gbps;
+
+                    if ((gbps = time_kernel((H5Z_shuffle_isa_t)isa, (hbool_t)bits, (hbool_t)reverse,
+                                            elmt_sizes[u], nbytes, npasses, src, dest)) < 0)
+                        goto error;
+                    HDfprintf(stdout, " %9.2f", gbps);
+                }
+                HDfprintf(stdout, "\n");
+            }
+        }
+
+    HDfree(src);
+    HDfree(dest);
+
+    return EXIT_SUCCESS;
+
+error:
+    HDfprintf(stderr, "shuffle_perf failed\n");
+    HDfree(src);
+    HDfree(dest);
+
+    return EXIT_FAILURE;
+}
@@ -352,6 +352,90 @@ fill_with_random_data(Bytef *src, uLongf src_len)
     }
 }
 
+/*
+ * Function:    do_filter_test
+ * Purpose:     Write and read back FILE_SIZE bytes of SRC through the
+ *              deflate filter of the library, one chunk of SRC_LEN bytes
+ *              at a time, to measure the cost of the filter per chunk.
+ *              The file is kept in memory, so the times are those of the
+ *              filter pipeline.
+ * Returns:     Nothing
+ */
+static void
+do_filter_test(unsigned long file_size, const Bytef *src, uLongf src_len)
+{
+    hsize_t        nchunks = file_size / src_len ? file_size / src_len : 1;
+    hsize_t        dims[1], chunk_dims[1], start[1], count[1];
+    hid_t          fapl = H5I_INVALID_HID, dcpl = H5I_INVALID_HID, dapl = H5I_INVALID_HID;
+    hid_t          file = H5I_INVALID_HID, dset = H5I_INVALID_HID;
+    hid_t          fspace = H5I_INVALID_HID, mspace = H5I_INVALID_HID;
+    struct timeval timer_start, timer_stop;
+    double         total_time;
+    Bytef         *dest;
+    hsize_t        i;
+    int            pass;
+
+    dims[0]       = nchunks * src_len;
+    chunk_dims[0] = src_len;
+    count[0]      = src_len;
+
+    if (NULL == (dest = (Bytef *)HDmalloc(src_len)))
+        error("out of memory");
+
+    /* Keep the file in memory, and the chunks out of the chunk cache, so
+     * each chunk goes through the filter as it's written or read */
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0 || H5Pset_fapl_core(fapl, (size_t)ONE_MB, FALSE) < 0)
+        error("unable to set up file access property list");
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0 || H5Pset_chunk(dcpl, 1, chunk_dims) < 0 ||
+        H5Pset_deflate(dcpl, compress_level == Z_DEFAULT_COMPRESSION ? 6U : (unsigned)compress_level) < 0)
+        error("unable to set up dataset creation property list");
+    if ((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0 ||
+        H5Pset_chunk_cache(dapl, H5D_CHUNK_CACHE_NSLOTS_DEFAULT, 0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        error("unable to set up dataset access property list");
+    if ((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        error("unable to create file");
+    if ((fspace = H5Screate_simple(1, dims, NULL)) < 0 || (mspace = H5Screate_simple(1, count, NULL)) < 0)
+        error("unable to create dataspaces");
+    if ((dset = H5Dcreate2(file, "zip_perf", H5T_NATIVE_UCHAR, fspace, H5P_DEFAULT, dcpl, dapl)) < 0)
+        error("unable to create dataset");
+
+    for (pass = 0; pass < 2; pass++) {
+        HDgettimeofday(&timer_start, NULL);
+        for (i = 0; i < nchunks; i++) {
+            start[0] = i * src_len;
+            if (H5Sselect_hyperslab(fspace, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+                error("unable to select chunk");
+            if (pass == 0) {
+                if (H5Dwrite(dset, H5T_NATIVE_UCHAR, mspace, fspace, H5P_DEFAULT, src) < 0)
+                    error("unable to write chunk");
+            }
+            else if (H5Dread(dset, H5T_NATIVE_UCHAR, mspace, fspace, H5P_DEFAULT, dest) < 0)
+                error("unable to read chunk");
+        }
+        HDgettimeofday(&timer_stop, NULL);
+
+        total_time = ((double)timer_stop.tv_sec + ((double)timer_stop.tv_usec) / (double)MICROSECOND) -
+                     ((double)timer_start.tv_sec + ((double)timer_start.tv_usec) / (double)MICROSECOND);
+
+        HDfprintf(stdout, "\tFilter %s Time: %.2fs (%.1fus per chunk)\n", pass ? "Read" : "Write",
+                  total_time, (total_time * MICROSECOND) / (double)nchunks);
+        HDfprintf(stdout, "\tFilter %s Throughput: %.2fMB/s\n", pass ? "Read" : "Write",
+                  MB_PER_SEC(nchunks * src_len, total_time));
+    }
+
+    if (HDmemcmp(src, dest, src_len) != 0)
+        error("data read through the filter doesn't match");
+
+    H5Dclose(dset);
+    H5Sclose(mspace);
+    H5Sclose(fspace);
+    H5Fclose(file);
+    H5Pclose(dapl);
+    H5Pclose(dcpl);
+    H5Pclose(fapl);
+    HDfree(dest);
+}
+
 static void
 do_write_test(unsigned long file_size, unsigned long min_buf_size, unsigned long max_buf_size)
 {
@@ -452,6 +536,9 @@ do_write_test(unsigned long file_size, unsigned long min_buf_size, unsigned long
         HDfprintf(stdout, "\tCompression Time: %gs\n", compression_time);
 
         HDunlink(filename);
+
+        /* do data write and read through the library's deflate filter */
+        do_filter_test(file_size, src, src_len);
         HDfree(src);
     }
 }